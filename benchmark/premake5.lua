@@ -0,0 +1,19 @@
+if not minko.platform.supports { "windows32", "windows64", "linux32", "linux64", "osx64" } then
+	return
+end
+
+minko.project.application "minko-benchmark"
+
+	removeplatforms { "ios", "android", "html5" }
+
+	files {
+		"src/**.hpp",
+		"src/**.cpp"
+	}
+	includedirs { "src" }
+
+	minko.plugin.enable("sdl")
+	minko.plugin.enable("offscreen")
+
+	configuration { "osx64 or linux32 or linux64" }
+		links { "pthread" }
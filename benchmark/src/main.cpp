@@ -0,0 +1,234 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/Minko.hpp"
+#include "minko/MinkoSDL.hpp"
+#include "minko/MinkoOffscreen.hpp"
+
+#include "minko/benchmark/BenchmarkCanvas.hpp"
+#include "minko/benchmark/BenchmarkReport.hpp"
+#include "minko/benchmark/FrameProfiler.hpp"
+#include "minko/benchmark/SyntheticScenes.hpp"
+
+using namespace minko;
+using namespace minko::benchmark;
+using namespace minko::component;
+
+struct Arguments
+{
+    uint                        numFrames           = 300;
+    uint                        numWarmupFrames     = 30;
+    uint                        size                = 0;
+    uint                        width               = 1280;
+    uint                        height              = 720;
+    std::vector<std::string>    scenes              = SyntheticScenes::names();
+    std::string                 output              = "benchmark.json";
+    std::string                 thresholds;
+    float                       tolerance           = .1f;
+};
+
+static
+void
+usage(const char* executable)
+{
+    std::cerr << "usage: " << executable << " [options]" << std::endl
+        << "  --frames <n>          number of measured frames per scene (default: 300)" << std::endl
+        << "  --warmup <n>          number of frames run before the measure (default: 30)" << std::endl
+        << "  --size <n>            overrides the number of meshes, lights or nodes of each scene" << std::endl
+        << "  --resolution <w>x<h>  size of the offscreen framebuffer (default: 1280x720)" << std::endl
+        << "  --scenes <a,b,...>    scenes to run among:";
+
+    for (const auto& name : SyntheticScenes::names())
+        std::cerr << " " << name;
+
+    std::cerr << std::endl
+        << "  --output <file>       JSON report (default: benchmark.json)" << std::endl
+        << "  --thresholds <file>   fails if a metric exceeds its threshold in file" << std::endl
+        << "  --tolerance <ratio>   relative tolerance on the timing thresholds (default: .1)" << std::endl;
+}
+
+static
+bool
+parseArguments(int argc, char** argv, Arguments& arguments)
+{
+    for (auto i = 1; i < argc; ++i)
+    {
+        auto option = std::string(argv[i]);
+
+        if (i + 1 >= argc)
+            return false;
+
+        auto value = std::string(argv[++i]);
+
+        try
+        {
+            if (option == "--frames")
+                arguments.numFrames = std::stoul(value);
+            else if (option == "--warmup")
+                arguments.numWarmupFrames = std::stoul(value);
+            else if (option == "--size")
+                arguments.size = std::stoul(value);
+            else if (option == "--resolution")
+            {
+                auto separator = value.find('x');
+
+                if (separator == std::string::npos)
+                    return false;
+
+                arguments.width = std::stoul(value.substr(0, separator));
+                arguments.height = std::stoul(value.substr(separator + 1));
+            }
+            else if (option == "--scenes")
+            {
+                std::stringstream stream(value);
+                std::string name;
+
+                arguments.scenes.clear();
+                while (std::getline(stream, name, ','))
+                {
+                    if (!SyntheticScenes::has(name))
+                    {
+                        std::cerr << "unknown scene '" << name << "'" << std::endl;
+
+                        return false;
+                    }
+
+                    arguments.scenes.push_back(name);
+                }
+            }
+            else if (option == "--output")
+                arguments.output = value;
+            else if (option == "--thresholds")
+                arguments.thresholds = value;
+            else if (option == "--tolerance")
+                arguments.tolerance = std::stof(value);
+            else
+                return false;
+        }
+        catch (const std::invalid_argument&)
+        {
+            std::cerr << "invalid value '" << value << "' for " << option << std::endl;
+
+            return false;
+        }
+        catch (const std::out_of_range&)
+        {
+            std::cerr << "out of range value '" << value << "' for " << option << std::endl;
+
+            return false;
+        }
+    }
+
+    return arguments.numFrames != 0;
+}
+
+static
+void
+runScene(const std::string&         name,
+         const Arguments&           arguments,
+         BenchmarkCanvas::Ptr       canvas,
+         BenchmarkReport::Ptr       report)
+{
+    // Frames are driven with a fixed time step so that the animations, and thus the GL calls,
+    // are the same from one run to another.
+    static const float deltaTime = 1000.f / 60.f;
+
+    auto sceneManager = SceneManager::create(canvas);
+    auto assets = sceneManager->assets();
+    auto root = scene::Node::create("root")->addComponent(sceneManager);
+
+    assets->loader()->options()->loadAsynchronously(false);
+    assets->loader()
+        ->queue(SyntheticScenes::EFFECT_BASIC)
+        ->queue(SyntheticScenes::EFFECT_PHONG)
+        ->load();
+
+    auto camera = scene::Node::create("camera")
+        ->addComponent(Renderer::create(0x000000ff))
+        ->addComponent(Transform::create(
+            math::inverse(math::lookAt(math::vec3(0.f, 20.f, 40.f), math::vec3(0.f), math::vec3(0.f, 1.f, 0.f)))
+        ))
+        ->addComponent(Camera::create(math::perspective(.785f, canvas->aspectRatio(), .1f, 1000.f)))
+        ->addComponent(Culling::create(math::Frustum::create(), "worldToScreenMatrix"));
+
+    root->addChild(camera);
+
+    auto update = SyntheticScenes::build(name, sceneManager, root, arguments.size);
+    auto time = 0.f;
+
+    for (auto i = 0u; i < arguments.numWarmupFrames; ++i, time += deltaTime)
+    {
+        update(time);
+        sceneManager->nextFrame(time, deltaTime);
+    }
+
+    auto profiler = FrameProfiler::create(sceneManager);
+
+    canvas->recordingContext()->resetCounters();
+
+    for (auto i = 0u; i < arguments.numFrames; ++i, time += deltaTime)
+    {
+        update(time);
+        sceneManager->nextFrame(time, deltaTime);
+    }
+
+    report->addScene(name, profiler, canvas->recordingContext()->counters());
+
+    std::cout << name << ": "
+        << profiler->averageTime(FrameProfiler::Phase::FRAME) << "ms/frame, "
+        << canvas->recordingContext()->counters().numDrawCalls / arguments.numFrames << " draw calls/frame"
+        << std::endl;
+
+    root->removeChild(camera);
+    root->removeComponent(sceneManager);
+}
+
+int
+main(int argc, char** argv)
+{
+    Arguments arguments;
+
+    if (!parseArguments(argc, argv, arguments))
+    {
+        usage(argv[0]);
+
+        return 2;
+    }
+
+    auto canvas = BenchmarkCanvas::create(
+        Canvas::create("Minko Benchmark", arguments.width, arguments.height, Canvas::HIDDEN)
+    );
+    auto report = BenchmarkReport::create();
+
+    for (const auto& name : arguments.scenes)
+        runScene(name, arguments, canvas, report);
+
+    report->write(arguments.output);
+
+    if (arguments.thresholds.empty())
+        return 0;
+
+    auto regressions = report->compare(arguments.thresholds, arguments.tolerance);
+
+    for (const auto& regression : regressions)
+        std::cerr << "regression: " << regression.scene << "." << regression.metric
+            << " = " << regression.value << " (threshold: " << regression.threshold << ")" << std::endl;
+
+    return regressions.empty() ? 0 : 1;
+}
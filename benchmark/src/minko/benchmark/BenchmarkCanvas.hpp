@@ -0,0 +1,252 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/AbstractCanvas.hpp"
+
+#include "minko/render/RecordingContext.hpp"
+
+namespace minko
+{
+    namespace benchmark
+    {
+        /*
+        ** Forwards to the canvas it wraps but exposes a RecordingContext, so that the SceneManager
+        ** and all the resources it creates go through its counters. Recording is paused: only the
+        ** counters are updated, the calls are not logged.
+        */
+        class BenchmarkCanvas :
+            public AbstractCanvas
+        {
+        public:
+            typedef std::shared_ptr<BenchmarkCanvas>    Ptr;
+
+        private:
+            AbstractCanvas::Ptr             _canvas;
+            render::RecordingContext::Ptr   _context;
+
+        public:
+            inline static
+            Ptr
+            create(AbstractCanvas::Ptr canvas)
+            {
+                return Ptr(new BenchmarkCanvas(canvas));
+            }
+
+            inline
+            AbstractCanvas::Ptr
+            canvas() const
+            {
+                return _canvas;
+            }
+
+            inline
+            render::RecordingContext::Ptr
+            recordingContext() const
+            {
+                return _context;
+            }
+
+            uint
+            x() override
+            {
+                return _canvas->x();
+            }
+
+            uint
+            y() override
+            {
+                return _canvas->y();
+            }
+
+            uint
+            width() override
+            {
+                return _canvas->width();
+            }
+
+            uint
+            height() override
+            {
+                return _canvas->height();
+            }
+
+            float
+            aspectRatio() override
+            {
+                return _canvas->aspectRatio();
+            }
+
+            std::shared_ptr<data::Provider>
+            data() const override
+            {
+                return _canvas->data();
+            }
+
+            std::shared_ptr<render::AbstractContext>
+            context() override
+            {
+                return _context;
+            }
+
+            void
+            swapBuffers() override
+            {
+                _canvas->swapBuffers();
+            }
+
+            std::shared_ptr<input::Mouse>
+            mouse() override
+            {
+                return _canvas->mouse();
+            }
+
+            std::shared_ptr<input::Keyboard>
+            keyboard() override
+            {
+                return _canvas->keyboard();
+            }
+
+            std::shared_ptr<input::Touch>
+            touch() override
+            {
+                return _canvas->touch();
+            }
+
+            std::shared_ptr<input::Joystick>
+            joystick(uint id) override
+            {
+                return _canvas->joystick(id);
+            }
+
+            uint
+            numJoysticks() override
+            {
+                return _canvas->numJoysticks();
+            }
+
+            Signal<AbstractCanvas::Ptr, uint, uint>::Ptr
+            resized() override
+            {
+                return _canvas->resized();
+            }
+
+            Signal<AbstractCanvas::Ptr, std::shared_ptr<input::Joystick>>::Ptr
+            joystickAdded() override
+            {
+                return _canvas->joystickAdded();
+            }
+
+            Signal<AbstractCanvas::Ptr, std::shared_ptr<input::Joystick>>::Ptr
+            joystickRemoved() override
+            {
+                return _canvas->joystickRemoved();
+            }
+
+            Signal<AbstractCanvas::Ptr>::Ptr
+            suspended() override
+            {
+                return _canvas->suspended();
+            }
+
+            Signal<AbstractCanvas::Ptr>::Ptr
+            resumed() override
+            {
+                return _canvas->resumed();
+            }
+
+            Signal<AbstractCanvas::Ptr, float, float, bool>::Ptr
+            enterFrame() override
+            {
+                return _canvas->enterFrame();
+            }
+
+            int
+            getJoystickAxis(std::shared_ptr<input::Joystick> joystick, int axis) override
+            {
+                return _canvas->getJoystickAxis(joystick, axis);
+            }
+
+            std::shared_ptr<async::Worker>
+            getWorker(const std::string& name) override
+            {
+                return _canvas->getWorker(name);
+            }
+
+            float
+            frameDuration() const override
+            {
+                return _canvas->frameDuration();
+            }
+
+            float
+            relativeTime() const override
+            {
+                return _canvas->relativeTime();
+            }
+
+            bool
+            isWorkerRegistered(const std::string& name) override
+            {
+                return _canvas->isWorkerRegistered(name);
+            }
+
+            float
+            framerate() override
+            {
+                return _canvas->framerate();
+            }
+
+            float
+            desiredFramerate() override
+            {
+                return _canvas->desiredFramerate();
+            }
+
+            void
+            desiredFramerate(float desiredFramerate) override
+            {
+                _canvas->desiredFramerate(desiredFramerate);
+            }
+
+            float
+            desiredEventrate() override
+            {
+                return _canvas->desiredEventrate();
+            }
+
+            void
+            desiredEventrate(float desiredEventrate) override
+            {
+                _canvas->desiredEventrate(desiredEventrate);
+            }
+
+        private:
+            explicit
+            BenchmarkCanvas(AbstractCanvas::Ptr canvas) :
+                _canvas(canvas),
+                _context(render::RecordingContext::create(canvas->context()))
+            {
+                _context->recording(false);
+            }
+        };
+    }
+}
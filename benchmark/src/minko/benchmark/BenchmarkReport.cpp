@@ -0,0 +1,142 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/benchmark/BenchmarkReport.hpp"
+
+#include "json/json.h"
+
+using namespace minko;
+using namespace minko::benchmark;
+
+void
+BenchmarkReport::addScene(const std::string&                           name,
+                          FrameProfiler::Ptr                           profiler,
+                          const render::RecordingContext::Counters&    counters)
+{
+    static const auto phases = {
+        FrameProfiler::Phase::FRAME,
+        FrameProfiler::Phase::TRANSFORMS,
+        FrameProfiler::Phase::CULLING,
+        FrameProfiler::Phase::RENDERING
+    };
+
+    auto& metrics = _scenes[name];
+    auto numFrames = std::max(1u, profiler->numFrames());
+
+    if (std::find(_sceneOrder.begin(), _sceneOrder.end(), name) == _sceneOrder.end())
+        _sceneOrder.push_back(name);
+
+    for (auto phase : phases)
+    {
+        const auto& phaseName = FrameProfiler::phaseName(phase);
+
+        metrics[phaseName + "TimeAverage"] = profiler->averageTime(phase);
+        metrics[phaseName + "TimePercentile95"] = profiler->percentileTime(phase, .95f);
+    }
+
+    metrics["callsPerFrame"] = double(counters.numCommands) / numFrames;
+    metrics["drawCallsPerFrame"] = double(counters.numDrawCalls) / numFrames;
+    metrics["trianglesPerFrame"] = double(counters.numTriangles) / numFrames;
+    metrics["programChangesPerFrame"] = double(counters.numProgramChanges) / numFrames;
+    metrics["redundantProgramChangesPerFrame"] = double(counters.numRedundantProgramChanges) / numFrames;
+    metrics["textureBindsPerFrame"] = double(counters.numTextureBinds) / numFrames;
+    metrics["redundantTextureBindsPerFrame"] = double(counters.numRedundantTextureBinds) / numFrames;
+    metrics["vertexBufferBindsPerFrame"] = double(counters.numVertexBufferBinds) / numFrames;
+    metrics["redundantVertexBufferBindsPerFrame"] = double(counters.numRedundantVertexBufferBinds) / numFrames;
+    metrics["uniformUpdatesPerFrame"] = double(counters.numUniformUpdates) / numFrames;
+    metrics["redundantUniformUpdatesPerFrame"] = double(counters.numRedundantUniformUpdates) / numFrames;
+    metrics["stateChangesPerFrame"] = double(counters.numStateChanges) / numFrames;
+    metrics["redundantStateChangesPerFrame"] = double(counters.numRedundantStateChanges) / numFrames;
+    metrics["uploadedBytesPerFrame"] = double(counters.numUploadedBytes) / numFrames;
+}
+
+bool
+BenchmarkReport::isTiming(const std::string& metric)
+{
+    return metric.find("Time") != std::string::npos;
+}
+
+std::string
+BenchmarkReport::toJson() const
+{
+    Json::Value root(Json::objectValue);
+
+    for (const auto& name : _sceneOrder)
+    {
+        Json::Value scene(Json::objectValue);
+
+        for (const auto& metric : _scenes.at(name))
+            scene[metric.first] = metric.second;
+
+        root[name] = scene;
+    }
+
+    return Json::StyledWriter().write(root);
+}
+
+void
+BenchmarkReport::write(const std::string& filename) const
+{
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+
+    if (!file)
+        throw std::runtime_error("unable to write '" + filename + "'");
+
+    file << toJson();
+}
+
+std::vector<BenchmarkReport::Regression>
+BenchmarkReport::compare(const std::string& filename, float tolerance) const
+{
+    std::ifstream file(filename);
+
+    if (!file)
+        throw std::runtime_error("unable to read '" + filename + "'");
+
+    Json::Value thresholds;
+    Json::Reader reader;
+
+    if (!reader.parse(file, thresholds, false) || !thresholds.isObject())
+        throw std::runtime_error("invalid thresholds in '" + filename + "': " + reader.getFormattedErrorMessages());
+
+    std::vector<Regression> regressions;
+
+    for (const auto& name : _sceneOrder)
+    {
+        if (!thresholds.isMember(name))
+            continue;
+
+        const auto& sceneThresholds = thresholds[name];
+
+        for (const auto& metric : _scenes.at(name))
+        {
+            if (!sceneThresholds.isMember(metric.first))
+                continue;
+
+            auto threshold = sceneThresholds[metric.first].asDouble();
+            auto limit = isTiming(metric.first) ? threshold * (1. + tolerance) : threshold;
+
+            // Counters are averages of integers: allow for the rounding of the stored threshold.
+            if (metric.second > limit + 1e-3)
+                regressions.push_back({ name, metric.first, metric.second, threshold });
+        }
+    }
+
+    return regressions;
+}
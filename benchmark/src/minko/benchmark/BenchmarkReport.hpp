@@ -0,0 +1,101 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/render/RecordingContext.hpp"
+
+#include "minko/benchmark/FrameProfiler.hpp"
+
+namespace Json
+{
+    class Value;
+}
+
+namespace minko
+{
+    namespace benchmark
+    {
+        /*
+        ** Collects the metrics of each scene and writes them as JSON. The same format is used for
+        ** the thresholds: a metric regresses when it exceeds its threshold by more than the
+        ** tolerance, metrics missing from the thresholds are not checked. The GL counters are
+        ** deterministic and are compared exactly, the tolerance only applies to the timings.
+        */
+        class BenchmarkReport
+        {
+        public:
+            typedef std::shared_ptr<BenchmarkReport>    Ptr;
+
+            struct Regression
+            {
+                std::string     scene;
+                std::string     metric;
+                double          value;
+                double          threshold;
+            };
+
+        private:
+            typedef std::map<std::string, double>   Metrics;
+
+        private:
+            std::map<std::string, Metrics>          _scenes;
+            std::vector<std::string>                _sceneOrder;
+
+        public:
+            inline static
+            Ptr
+            create()
+            {
+                return Ptr(new BenchmarkReport());
+            }
+
+            /*
+            ** Records the timings of profiler and the counters accumulated by context, averaged
+            ** over the profiled frames.
+            */
+            void
+            addScene(const std::string&                         name,
+                     FrameProfiler::Ptr                         profiler,
+                     const render::RecordingContext::Counters&  counters);
+
+            std::string
+            toJson() const;
+
+            void
+            write(const std::string& filename) const;
+
+            /*
+            ** Compares the report to the thresholds stored in filename with the format written
+            ** by write(). tolerance is relative, .1f allowing timings 10% above their threshold.
+            */
+            std::vector<Regression>
+            compare(const std::string& filename, float tolerance) const;
+
+        private:
+            BenchmarkReport() = default;
+
+            static
+            bool
+            isTiming(const std::string& metric);
+        };
+    }
+}
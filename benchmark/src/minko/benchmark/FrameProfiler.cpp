@@ -0,0 +1,162 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/benchmark/FrameProfiler.hpp"
+
+#include "minko/component/SceneManager.hpp"
+
+using namespace minko;
+using namespace minko::benchmark;
+using namespace minko::component;
+
+FrameProfiler::FrameProfiler(SceneManagerPtr sceneManager) :
+    _sceneManager(sceneManager),
+    _frameStart(),
+    _phaseStart(),
+    _totalTimes(),
+    _frameTimes()
+{
+}
+
+void
+FrameProfiler::initialize()
+{
+    static const auto first = std::numeric_limits<float>::max();
+    static const auto last = -std::numeric_limits<float>::max();
+
+    // Transform updates the world matrices at priority 1000 and Culling runs at 0.
+    static const auto transformsEnd = 500.f;
+
+    _frameSlots.push_back(_sceneManager->frameBegin()->connect(
+        [this](SceneManagerPtr, float, float)
+        {
+            _frameStart = Clock::now();
+        },
+        first
+    ));
+    _renderSlots.push_back(_sceneManager->renderingBegin()->connect(
+        [this](SceneManagerPtr, uint, AbsTexturePtr)
+        {
+            _phaseStart = Clock::now();
+        },
+        first
+    ));
+    _renderSlots.push_back(_sceneManager->renderingBegin()->connect(
+        [this](SceneManagerPtr, uint, AbsTexturePtr)
+        {
+            endPhase(Phase::TRANSFORMS);
+        },
+        transformsEnd
+    ));
+    _renderSlots.push_back(_sceneManager->renderingBegin()->connect(
+        [this](SceneManagerPtr, uint, AbsTexturePtr)
+        {
+            endPhase(Phase::CULLING);
+        },
+        last
+    ));
+    _renderSlots.push_back(_sceneManager->renderingEnd()->connect(
+        [this](SceneManagerPtr, uint, AbsTexturePtr)
+        {
+            _phaseStart = Clock::now();
+        },
+        first
+    ));
+    _renderSlots.push_back(_sceneManager->renderingEnd()->connect(
+        [this](SceneManagerPtr, uint, AbsTexturePtr)
+        {
+            endPhase(Phase::RENDERING);
+        },
+        last
+    ));
+    _frameSlots.push_back(_sceneManager->frameEnd()->connect(
+        [this](SceneManagerPtr, float, float)
+        {
+            _phaseStart = _frameStart;
+            endPhase(Phase::FRAME);
+        },
+        last
+    ));
+}
+
+const std::string&
+FrameProfiler::phaseName(Phase phase)
+{
+    static const std::array<std::string, NUM_PHASES> names = {
+        { "frame", "transforms", "culling", "rendering" }
+    };
+
+    return names[static_cast<uint>(phase)];
+}
+
+void
+FrameProfiler::endPhase(Phase phase)
+{
+    auto now = Clock::now();
+    auto time = std::chrono::duration<float, std::milli>(now - _phaseStart).count();
+    auto index = static_cast<uint>(phase);
+
+    _totalTimes[index] += time;
+    _frameTimes[index].push_back(time);
+    _phaseStart = now;
+
+    // Frames that are not rendered still count for the other phases.
+    if (phase == Phase::FRAME)
+        for (auto i = 0u; i < NUM_PHASES; ++i)
+            if (_frameTimes[i].size() < _frameTimes[index].size())
+                _frameTimes[i].push_back(0.f);
+}
+
+float
+FrameProfiler::averageTime(Phase phase) const
+{
+    auto index = static_cast<uint>(phase);
+
+    if (_frameTimes[index].empty())
+        return 0.f;
+
+    return static_cast<float>(_totalTimes[index] / _frameTimes[index].size());
+}
+
+float
+FrameProfiler::percentileTime(Phase phase, float ratio) const
+{
+    auto times = _frameTimes[static_cast<uint>(phase)];
+
+    if (times.empty())
+        return 0.f;
+
+    auto n = std::min(
+        static_cast<std::size_t>(ratio * (times.size() - 1) + .5f),
+        times.size() - 1
+    );
+
+    std::nth_element(times.begin(), times.begin() + n, times.end());
+
+    return times[n];
+}
+
+void
+FrameProfiler::reset()
+{
+    _totalTimes.fill(0.);
+
+    for (auto& times : _frameTimes)
+        times.clear();
+}
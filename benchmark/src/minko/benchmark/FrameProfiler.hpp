@@ -0,0 +1,126 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+    namespace benchmark
+    {
+        /*
+        ** Measures the CPU time spent in each phase of SceneManager::nextFrame() by listening to
+        ** its signals with priorities above and below the ones of the framework components:
+        ** "transforms" ends when the Transform components are updated, "culling" covers the rest of
+        ** renderingBegin(), and "rendering" covers renderingEnd(), where the Renderers draw.
+        */
+        class FrameProfiler
+        {
+        public:
+            typedef std::shared_ptr<FrameProfiler>  Ptr;
+
+            enum class Phase
+            {
+                FRAME,
+                TRANSFORMS,
+                CULLING,
+                RENDERING
+            };
+
+            static const uint                       NUM_PHASES = 4;
+
+        private:
+            typedef std::chrono::steady_clock               Clock;
+            typedef std::shared_ptr<component::SceneManager> SceneManagerPtr;
+            typedef std::shared_ptr<render::AbstractTexture> AbsTexturePtr;
+
+            typedef Signal<SceneManagerPtr, float, float>::Slot                 FrameSlot;
+            typedef Signal<SceneManagerPtr, uint, AbsTexturePtr>::Slot          RenderSlot;
+
+        private:
+            SceneManagerPtr                         _sceneManager;
+
+            Clock::time_point                       _frameStart;
+            Clock::time_point                       _phaseStart;
+
+            std::array<double, NUM_PHASES>          _totalTimes;
+            std::array<std::vector<float>, NUM_PHASES>  _frameTimes;
+
+            std::vector<FrameSlot>                  _frameSlots;
+            std::vector<RenderSlot>                 _renderSlots;
+
+        public:
+            inline static
+            Ptr
+            create(SceneManagerPtr sceneManager)
+            {
+                auto instance = Ptr(new FrameProfiler(sceneManager));
+
+                instance->initialize();
+
+                return instance;
+            }
+
+            static
+            const std::string&
+            phaseName(Phase phase);
+
+            inline
+            uint
+            numFrames() const
+            {
+                return static_cast<uint>(_frameTimes[0].size());
+            }
+
+            /*
+            ** Times of the given phase for each recorded frame, in milliseconds.
+            */
+            inline
+            const std::vector<float>&
+            frameTimes(Phase phase) const
+            {
+                return _frameTimes[static_cast<uint>(phase)];
+            }
+
+            float
+            averageTime(Phase phase) const;
+
+            /*
+            ** Time below which lie the given ratio of the frames, in milliseconds.
+            */
+            float
+            percentileTime(Phase phase, float ratio) const;
+
+            void
+            reset();
+
+        private:
+            explicit
+            FrameProfiler(SceneManagerPtr sceneManager);
+
+            void
+            initialize();
+
+            void
+            endPhase(Phase phase);
+        };
+    }
+}
@@ -0,0 +1,348 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/benchmark/SyntheticScenes.hpp"
+
+#include "minko/component/SceneManager.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/Skinning.hpp"
+#include "minko/component/PointLight.hpp"
+#include "minko/component/AmbientLight.hpp"
+#include "minko/geometry/CubeGeometry.hpp"
+#include "minko/geometry/Skin.hpp"
+#include "minko/geometry/Bone.hpp"
+#include "minko/material/BasicMaterial.hpp"
+#include "minko/material/PhongMaterial.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/scene/Node.hpp"
+
+using namespace minko;
+using namespace minko::benchmark;
+using namespace minko::component;
+
+const std::string SyntheticScenes::EFFECT_BASIC = "effect/Basic.effect";
+const std::string SyntheticScenes::EFFECT_PHONG = "effect/Phong.effect";
+
+const std::map<std::string, std::pair<SyntheticScenes::BuildFunction, uint>>&
+SyntheticScenes::scenes()
+{
+    static const std::map<std::string, std::pair<BuildFunction, uint>> scenes = {
+        { "shared-material",    { &SyntheticScenes::buildSharedMaterialCubes, 2000 } },
+        { "unique-material",    { &SyntheticScenes::buildUniqueMaterialCubes, 2000 } },
+        { "skinned-meshes",     { &SyntheticScenes::buildSkinnedMeshes, 200 } },
+        { "point-lights",       { &SyntheticScenes::buildPointLights, 8 } },
+        { "deep-hierarchy",     { &SyntheticScenes::buildDeepHierarchy, 500 } }
+    };
+
+    return scenes;
+}
+
+const std::vector<std::string>&
+SyntheticScenes::names()
+{
+    static const std::vector<std::string> names = {
+        "shared-material",
+        "unique-material",
+        "skinned-meshes",
+        "point-lights",
+        "deep-hierarchy"
+    };
+
+    return names;
+}
+
+bool
+SyntheticScenes::has(const std::string& name)
+{
+    return scenes().count(name) != 0;
+}
+
+uint
+SyntheticScenes::defaultSize(const std::string& name)
+{
+    return scenes().at(name).second;
+}
+
+SyntheticScenes::UpdateFunction
+SyntheticScenes::build(const std::string& name, SceneManagerPtr sceneManager, NodePtr root, uint size)
+{
+    if (!has(name))
+        throw std::invalid_argument("name");
+
+    return scenes().at(name).first(sceneManager, root, size == 0 ? defaultSize(name) : size);
+}
+
+math::vec3
+SyntheticScenes::gridPosition(uint index, uint count, float spacing)
+{
+    auto side = std::max(1u, static_cast<uint>(std::ceil(std::cbrt(static_cast<float>(count)))));
+    auto offset = (side - 1) * spacing * .5f;
+
+    return math::vec3(
+        (index % side) * spacing - offset,
+        ((index / side) % side) * spacing - offset,
+        (index / (side * side)) * spacing - offset
+    );
+}
+
+SyntheticScenes::UpdateFunction
+SyntheticScenes::buildSharedMaterialCubes(SceneManagerPtr sceneManager, NodePtr root, uint numCubes)
+{
+    auto assets = sceneManager->assets();
+    auto geometry = geometry::CubeGeometry::create(assets->context());
+    auto material = material::BasicMaterial::create();
+    auto effect = assets->effect(EFFECT_BASIC);
+    auto nodes = std::make_shared<std::vector<NodePtr>>();
+
+    material->diffuseColor(0xff7f00ff);
+
+    for (auto i = 0u; i < numCubes; ++i)
+    {
+        auto node = scene::Node::create("cube_" + std::to_string(i))
+            ->addComponent(Transform::create(
+                math::translate(gridPosition(i, numCubes, 2.f)) * math::scale(math::vec3(.5f))
+            ))
+            ->addComponent(Surface::create(geometry, material, effect));
+
+        root->addChild(node);
+        nodes->push_back(node);
+    }
+
+    // Moves one cube out of eight each frame to keep the transforms busy without invalidating
+    // the whole scene.
+    return [=](float time)
+    {
+        for (auto i = static_cast<uint>(time) % 8u; i < nodes->size(); i += 8)
+        {
+            auto transform = (*nodes)[i]->component<Transform>();
+
+            transform->matrix(transform->matrix() * math::rotate(.01f, math::vec3(0.f, 1.f, 0.f)));
+        }
+    };
+}
+
+SyntheticScenes::UpdateFunction
+SyntheticScenes::buildUniqueMaterialCubes(SceneManagerPtr sceneManager, NodePtr root, uint numCubes)
+{
+    auto assets = sceneManager->assets();
+    auto geometry = geometry::CubeGeometry::create(assets->context());
+    auto effect = assets->effect(EFFECT_BASIC);
+    auto materials = std::make_shared<std::vector<material::BasicMaterial::Ptr>>();
+
+    for (auto i = 0u; i < numCubes; ++i)
+    {
+        auto material = material::BasicMaterial::create();
+        auto hue = 360.f * i / numCubes;
+
+        material->diffuseColor(math::vec4(math::rgbColor(math::vec3(hue, 1.f, .5f)), 1.f));
+        materials->push_back(material);
+
+        root->addChild(scene::Node::create("cube_" + std::to_string(i))
+            ->addComponent(Transform::create(
+                math::translate(gridPosition(i, numCubes, 2.f)) * math::scale(math::vec3(.5f))
+            ))
+            ->addComponent(Surface::create(geometry, material, effect))
+        );
+    }
+
+    // Changes one material out of eight each frame to measure the uniform traffic.
+    return [=](float time)
+    {
+        auto t = std::fmod(time * .001f, 1.f);
+
+        for (auto i = static_cast<uint>(time) % 8u; i < materials->size(); i += 8)
+            (*materials)[i]->diffuseColor(math::vec4(t, 1.f - t, .5f, 1.f));
+    };
+}
+
+SyntheticScenes::UpdateFunction
+SyntheticScenes::buildSkinnedMeshes(SceneManagerPtr sceneManager, NodePtr root, uint numMeshes)
+{
+    static const uint numFrames = 30;
+    static const uint duration = 1000;
+
+    auto assets = sceneManager->assets();
+    auto material = material::BasicMaterial::create();
+    auto effect = assets->effect(EFFECT_BASIC);
+
+    material->diffuseColor(0x00ff7fff);
+
+    for (auto i = 0u; i < numMeshes; ++i)
+    {
+        // The geometry is modified by the Skinning component and cannot be shared.
+        auto geometry = geometry::CubeGeometry::create(assets->context());
+        auto positions = geometry->vertexBuffer("position");
+        auto& vertexData = positions->data();
+        auto vertexSize = positions->vertexSize();
+        auto positionOffset = positions->attribute("position").offset;
+        auto numVertices = geometry->numVertices();
+
+        auto skeletonRoot = scene::Node::create("skeleton_" + std::to_string(i))
+            ->addComponent(Transform::create());
+        auto lowerBone = scene::Node::create("lower")->addComponent(Transform::create());
+        auto upperBone = scene::Node::create("upper")->addComponent(Transform::create());
+
+        skeletonRoot->addChild(lowerBone)->addChild(upperBone);
+
+        // Each half of the cube is entirely bound to one bone.
+        std::vector<unsigned short> lowerVertexIds;
+        std::vector<unsigned short> upperVertexIds;
+
+        for (auto vertexId = 0u; vertexId < numVertices; ++vertexId)
+        {
+            if (vertexData[vertexId * vertexSize + positionOffset + 1] < 0.f)
+                lowerVertexIds.push_back(static_cast<unsigned short>(vertexId));
+            else
+                upperVertexIds.push_back(static_cast<unsigned short>(vertexId));
+        }
+
+        auto skin = geometry::Skin::create(2, duration, numFrames);
+
+        skin->bone(0, geometry::Bone::create(
+            lowerBone, math::mat4(1.f), lowerVertexIds, std::vector<float>(lowerVertexIds.size(), 1.f)
+        ));
+        skin->bone(1, geometry::Bone::create(
+            upperBone, math::mat4(1.f), upperVertexIds, std::vector<float>(upperVertexIds.size(), 1.f)
+        ));
+
+        for (auto frame = 0u; frame < numFrames; ++frame)
+        {
+            auto angle = std::sin(2.f * float(M_PI) * frame / numFrames) * .5f;
+
+            skin->matrix(frame, 0, math::mat4(1.f));
+            skin->matrix(frame, 1, math::rotate(angle, math::vec3(0.f, 0.f, 1.f)));
+        }
+
+        auto skinning = Skinning::create(
+            skin->reorganizeByVertices(),
+            SkinningMethod::HARDWARE,
+            assets->context(),
+            skeletonRoot
+        );
+
+        auto mesh = scene::Node::create("skinned_" + std::to_string(i))
+            ->addComponent(Transform::create(math::scale(math::vec3(.5f))))
+            ->addComponent(Surface::create(geometry, material, effect))
+            ->addComponent(skinning);
+
+        skeletonRoot->component<Transform>()->matrix(math::translate(gridPosition(i, numMeshes, 2.f)));
+        skeletonRoot->addChild(mesh);
+        root->addChild(skeletonRoot);
+
+        skinning->play();
+    }
+
+    // The skinning components follow the scene time, they do not need to be updated.
+    return [=](float time)
+    {
+    };
+}
+
+SyntheticScenes::UpdateFunction
+SyntheticScenes::buildPointLights(SceneManagerPtr sceneManager, NodePtr root, uint numLights)
+{
+    static const uint numCubes = 500;
+
+    auto assets = sceneManager->assets();
+    auto geometry = geometry::CubeGeometry::create(assets->context());
+    auto material = material::PhongMaterial::create();
+    auto effect = assets->effect(EFFECT_PHONG);
+    auto lights = std::make_shared<std::vector<NodePtr>>();
+
+    material->diffuseColor(0xffffffff);
+
+    root->addComponent(AmbientLight::create(.1f));
+
+    for (auto i = 0u; i < numCubes; ++i)
+    {
+        root->addChild(scene::Node::create("cube_" + std::to_string(i))
+            ->addComponent(Transform::create(
+                math::translate(gridPosition(i, numCubes, 2.f)) * math::scale(math::vec3(.5f))
+            ))
+            ->addComponent(Surface::create(geometry, material, effect))
+        );
+    }
+
+    for (auto i = 0u; i < numLights; ++i)
+    {
+        auto hue = 360.f * i / numLights;
+        auto light = PointLight::create(1.f, 1.f);
+
+        light->color(math::rgbColor(math::vec3(hue, 1.f, .5f)));
+
+        auto node = scene::Node::create("light_" + std::to_string(i))
+            ->addComponent(Transform::create())
+            ->addComponent(light);
+
+        root->addChild(node);
+        lights->push_back(node);
+    }
+
+    // All the lights orbit the scene so that their uniforms change every frame.
+    return [=](float time)
+    {
+        for (auto i = 0u; i < lights->size(); ++i)
+        {
+            auto angle = time * .001f + 2.f * float(M_PI) * i / lights->size();
+
+            (*lights)[i]->component<Transform>()->matrix(
+                math::translate(math::vec3(std::cos(angle) * 10.f, 5.f, std::sin(angle) * 10.f))
+            );
+        }
+    };
+}
+
+SyntheticScenes::UpdateFunction
+SyntheticScenes::buildDeepHierarchy(SceneManagerPtr sceneManager, NodePtr root, uint depth)
+{
+    auto assets = sceneManager->assets();
+    auto geometry = geometry::CubeGeometry::create(assets->context());
+    auto material = material::BasicMaterial::create();
+    auto effect = assets->effect(EFFECT_BASIC);
+    auto parent = root;
+    auto nodes = std::make_shared<std::vector<NodePtr>>();
+
+    material->diffuseColor(0x7f7fffff);
+
+    for (auto i = 0u; i < depth; ++i)
+    {
+        auto node = scene::Node::create("link_" + std::to_string(i))
+            ->addComponent(Transform::create(
+                math::translate(math::vec3(0.f, .05f, 0.f)) * math::rotate(.05f, math::vec3(0.f, 1.f, 0.f))
+            ))
+            ->addComponent(Surface::create(geometry, material, effect));
+
+        parent->addChild(node);
+        nodes->push_back(node);
+        parent = node;
+    }
+
+    // Moving the top of the chain invalidates the world matrix of every node below it.
+    return [=](float time)
+    {
+        if (nodes->empty())
+            return;
+
+        nodes->front()->component<Transform>()->matrix(
+            math::rotate(time * .001f, math::vec3(0.f, 1.f, 0.f))
+        );
+    };
+}
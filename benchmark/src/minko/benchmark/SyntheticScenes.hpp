@@ -0,0 +1,98 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace benchmark
+    {
+        /*
+        ** Deterministic scenes stressing one part of the frame each. A scene is built below the
+        ** given root, which must already hold the SceneManager, once the "effect/Basic.effect" and
+        ** "effect/Phong.effect" assets are loaded. The returned function animates the scene: it is
+        ** called with the benchmark time, in milliseconds, before each frame.
+        */
+        class SyntheticScenes
+        {
+        public:
+            typedef std::shared_ptr<scene::Node>                NodePtr;
+            typedef std::shared_ptr<component::SceneManager>    SceneManagerPtr;
+            typedef std::function<void(float)>                  UpdateFunction;
+            typedef std::function<UpdateFunction(SceneManagerPtr, NodePtr, uint)>  BuildFunction;
+
+            static const std::string EFFECT_BASIC;
+            static const std::string EFFECT_PHONG;
+
+        public:
+            /*
+            ** Names of the available scenes, in the order they are run by default.
+            */
+            static
+            const std::vector<std::string>&
+            names();
+
+            static
+            bool
+            has(const std::string& name);
+
+            /*
+            ** size is the number of meshes, lights or nodes, depending on the scene.
+            */
+            static
+            UpdateFunction
+            build(const std::string& name, SceneManagerPtr sceneManager, NodePtr root, uint size);
+
+            static
+            uint
+            defaultSize(const std::string& name);
+
+        private:
+            static
+            const std::map<std::string, std::pair<BuildFunction, uint>>&
+            scenes();
+
+            static
+            UpdateFunction
+            buildSharedMaterialCubes(SceneManagerPtr sceneManager, NodePtr root, uint numCubes);
+
+            static
+            UpdateFunction
+            buildUniqueMaterialCubes(SceneManagerPtr sceneManager, NodePtr root, uint numCubes);
+
+            static
+            UpdateFunction
+            buildSkinnedMeshes(SceneManagerPtr sceneManager, NodePtr root, uint numMeshes);
+
+            static
+            UpdateFunction
+            buildPointLights(SceneManagerPtr sceneManager, NodePtr root, uint numLights);
+
+            static
+            UpdateFunction
+            buildDeepHierarchy(SceneManagerPtr sceneManager, NodePtr root, uint depth);
+
+            static
+            math::vec3
+            gridPosition(uint index, uint count, float spacing);
+        };
+    }
+}
@@ -0,0 +1,205 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/Minko.hpp"
+#include "minko/MinkoSDL.hpp"
+#include "minko/MinkoBullet.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+// boxes are stacked in a square grid of stacks, each stack being STACK_HEIGHT boxes high
+const uint          DEFAULT_NUM_STACKS  = 20;
+const uint          STACK_HEIGHT        = 10;
+const float         BOX_SIZE            = 1.f;
+const float         STACK_SPACING       = 2.f;
+const uint          NUM_MEASURED_STEPS  = 300;
+const float         STEP_DURATION       = 1000.f / 60.f;
+
+void
+printUsage(const char* name)
+{
+    std::cout << "usage: " << name << " [--threads <num threads>] [--stacks <num stacks per side>]" << std::endl;
+}
+
+bool
+parseArguments(int argc, char** argv, uint& numThreads, uint& numStacks)
+{
+    for (auto i = 1; i < argc; ++i)
+    {
+        auto arg = std::string(argv[i]);
+
+        if ((arg != "--threads" && arg != "--stacks") || i + 1 == argc)
+            return false;
+
+        try
+        {
+            (arg == "--threads" ? numThreads : numStacks) = std::stoul(argv[++i]);
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
+
+    return numThreads > 0 && numStacks > 0;
+}
+
+void
+createBox(scene::Node::Ptr root, const math::vec3& position, float mass, material::Material::Ptr material,
+          geometry::Geometry::Ptr geometry, render::Effect::Ptr effect)
+{
+    const auto halfSize = BOX_SIZE * .5f;
+
+    root->addChild(scene::Node::create()
+        ->addComponent(Transform::create(math::translate(position) * math::scale(math::vec3(BOX_SIZE))))
+        ->addComponent(Surface::create(geometry, material, effect))
+        ->addComponent(bullet::Collider::create(
+            bullet::ColliderData::create(mass, bullet::BoxShape::create(halfSize, halfSize, halfSize))
+        ))
+    );
+}
+
+int main(int argc, char** argv)
+{
+    auto numThreads = 1u;
+    auto numStacks = DEFAULT_NUM_STACKS;
+
+    if (!parseArguments(argc, argv, numThreads, numStacks))
+    {
+        printUsage(argv[0]);
+
+        return 1;
+    }
+
+    auto canvas = Canvas::create("Minko Example - Benchmark Physics");
+    auto sceneManager = SceneManager::create(canvas);
+    auto world = bullet::PhysicsWorld::create(numThreads);
+    auto root = scene::Node::create("root")
+        ->addComponent(sceneManager)
+        ->addComponent(world);
+
+    sceneManager->assets()->loader()->queue("effect/Phong.effect");
+    sceneManager->assets()->geometry("cube", geometry::CubeGeometry::create(sceneManager->assets()->context()));
+
+    const auto gridSize = numStacks * STACK_SPACING;
+
+    auto camera = scene::Node::create("camera")
+        ->addComponent(Renderer::create(0x7f7f7fff))
+        ->addComponent(Transform::create(math::inverse(math::lookAt(
+            math::vec3(gridSize, gridSize * .75f, gridSize), math::vec3(0.f), math::vec3(0.f, 1.f, 0.f)
+        ))))
+        ->addComponent(Camera::create(math::perspective(.785f, canvas->aspectRatio(), 0.1f, 1000.f)));
+
+    root
+        ->addChild(camera)
+        ->addChild(scene::Node::create("light")
+            ->addComponent(DirectionalLight::create())
+            ->addComponent(Transform::create(math::inverse(math::lookAt(
+                math::vec3(1.f, 3.f, 2.f), math::vec3(0.f), math::vec3(0.f, 1.f, 0.f)
+            ))))
+        )
+        ->addChild(scene::Node::create("ambientLight")->addComponent(AmbientLight::create()));
+
+    auto ready = false;
+
+    auto loaderComplete = sceneManager->assets()->loader()->complete()->connect([&](file::Loader::Ptr loader)
+    {
+        auto assets = sceneManager->assets();
+        auto cube = assets->geometry("cube");
+        auto effect = assets->effect("effect/Phong.effect");
+        auto groundMaterial = material::BasicMaterial::create();
+        auto boxMaterial = material::BasicMaterial::create();
+
+        groundMaterial->diffuseColor(0x241f1cff);
+        boxMaterial->diffuseColor(0xb5651dff);
+
+        root->addChild(scene::Node::create("ground")
+            ->addComponent(Transform::create(
+                math::translate(math::vec3(0.f, -.5f, 0.f)) * math::scale(math::vec3(gridSize * 2.f, 1.f, gridSize * 2.f))
+            ))
+            ->addComponent(Surface::create(cube, groundMaterial, effect))
+            ->addComponent(bullet::Collider::create(bullet::ColliderData::create(
+                0.f, // static object (no mass)
+                bullet::BoxShape::create(gridSize, .5f, gridSize)
+            )))
+        );
+
+        for (auto x = 0u; x < numStacks; ++x)
+            for (auto z = 0u; z < numStacks; ++z)
+                for (auto y = 0u; y < STACK_HEIGHT; ++y)
+                    createBox(
+                        root,
+                        math::vec3(
+                            (float(x) - float(numStacks - 1) * .5f) * STACK_SPACING,
+                            (float(y) + .5f) * BOX_SIZE,
+                            (float(z) - float(numStacks - 1) * .5f) * STACK_SPACING
+                        ),
+                        1.f,
+                        boxMaterial,
+                        cube,
+                        effect
+                    );
+
+        std::cout << numStacks * numStacks * STACK_HEIGHT << " boxes, " << world->numThreads() << " thread(s)" << std::endl;
+
+        ready = true;
+    });
+
+    // the physics world steps during frameBegin: these slots run right before and right after it
+    auto stepStartTime = std::chrono::steady_clock::now();
+    auto stepTime = 0.f;
+    auto numSteps = 0u;
+
+    auto stepBegin = sceneManager->frameBegin()->connect([&](SceneManager::Ptr, float, float)
+    {
+        stepStartTime = std::chrono::steady_clock::now();
+    }, 1.f);
+
+    auto stepEnd = sceneManager->frameBegin()->connect([&](SceneManager::Ptr, float, float)
+    {
+        if (!ready)
+            return;
+
+        stepTime += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - stepStartTime).count();
+
+        if (++numSteps % NUM_MEASURED_STEPS == 0)
+        {
+            std::cout << "physics step = " << stepTime / float(NUM_MEASURED_STEPS) << "ms"
+                << ", framerate = " << canvas->framerate() << std::endl;
+            stepTime = 0.f;
+        }
+    }, -1.f);
+
+    auto enterFrame = canvas->enterFrame()->connect([&](AbstractCanvas::Ptr canvas, float time, float deltaTime, bool shouldRender)
+    {
+        // fixed steps so that the measures do not depend on the framerate
+        sceneManager->nextFrame(time, STEP_DURATION, shouldRender);
+    });
+
+    auto resized = canvas->resized()->connect([&](AbstractCanvas::Ptr canvas, uint w, uint h)
+    {
+        camera->component<Camera>()->projectionMatrix(math::perspective(.785f, float(w) / float(h), 0.1f, 1000.f));
+    });
+
+    sceneManager->assets()->loader()->load();
+    canvas->run();
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#ifndef _CLUSTEREDLIGHTING_FUNCTION_GLSL_
+#define _CLUSTEREDLIGHTING_FUNCTION_GLSL_
+
+#pragma include "Pack.function.glsl"
+
+// must match ClusteredLighting::MAX_LIGHTS_PER_CLUSTER
+#define CLUSTERED_LIGHTING_MAX_LIGHTS_PER_CLUSTER 64
+
+// light data texels (see ClusteredLighting::updateLightData())
+#define CLUSTERED_LIGHTING_POSITION 0.0
+#define CLUSTERED_LIGHTING_RANGE 3.0
+#define CLUSTERED_LIGHTING_DIFFUSE 4.0
+#define CLUSTERED_LIGHTING_SPECULAR 7.0
+#define CLUSTERED_LIGHTING_DIRECTION 10.0
+#define CLUSTERED_LIGHTING_COS_INNER_CONE_ANGLE 13.0
+#define CLUSTERED_LIGHTING_COS_OUTER_CONE_ANGLE 14.0
+
+// returns the offset of the first light index of the cluster containing the fragment (x) and the number of lights (y)
+vec2 clusteredLighting_getCluster(sampler2D clusters, vec2 clustersSize, vec3 gridSize, vec2 depthRange, vec4 screenPosition)
+{
+    vec2 uv = clamp(screenPosition.xy / screenPosition.w * 0.5 + 0.5, 0.0, 0.9999);
+    vec2 xy = floor(uv * gridSize.xy);
+    // depthRange is (zNear, log(zFar / zNear)), slices are distributed exponentially
+    float z = floor(log(max(screenPosition.w, depthRange.x) / depthRange.x) / depthRange.y * gridSize.z);
+    vec2 texel = vec2(xy.y * gridSize.x + xy.x, clamp(z, 0.0, gridSize.z - 1.0));
+    vec4 bytes = floor(texture2D(clusters, (texel + 0.5) / clustersSize) * 255.0 + 0.5);
+
+    // the offset is stored on 24 bits (r, g and a) and the number of lights on 8 bits (b)
+    return vec2(bytes.r + bytes.g * 256.0 + bytes.a * 65536.0, bytes.b);
+}
+
+float clusteredLighting_getLightId(sampler2D lightIndices, vec2 lightIndicesSize, float index)
+{
+    vec2 texel = vec2(mod(index, lightIndicesSize.x), floor(index / lightIndicesSize.x));
+    vec2 bytes = floor(texture2D(lightIndices, (texel + 0.5) / lightIndicesSize).rg * 255.0 + 0.5);
+
+    return bytes.r + bytes.g * 256.0;
+}
+
+float clusteredLighting_getFloat(sampler2D lightData, vec2 lightDataSize, float lightId, float offset)
+{
+    return unpackFloat8bitRGBA(texture2D(lightData, (vec2(offset, lightId) + 0.5) / lightDataSize));
+}
+
+vec3 clusteredLighting_getVec3(sampler2D lightData, vec2 lightDataSize, float lightId, float offset)
+{
+    return vec3(
+        clusteredLighting_getFloat(lightData, lightDataSize, lightId, offset),
+        clusteredLighting_getFloat(lightData, lightDataSize, lightId, offset + 1.0),
+        clusteredLighting_getFloat(lightData, lightDataSize, lightId, offset + 2.0)
+    );
+}
+
+// smooth window reaching 0 at the light range, so that clusters can cull lights without visible seams
+float clusteredLighting_attenuation(float distance, float range)
+{
+    float ratio = distance / range;
+    float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+
+    return window * window;
+}
+
+#endif // _CLUSTEREDLIGHTING_FUNCTION_GLSL_
@@ -18,6 +18,7 @@
 #pragma include "LightMapping.function.glsl"
 #pragma include "PBR.function.glsl"
 #pragma include "ToneMapping.function.glsl"
+#pragma include "ClusteredLighting.function.glsl"
 
 #ifdef GAMMA_CORRECTION
 uniform float uGammaCorrection;
@@ -387,6 +388,22 @@ uniform float uSpotLight3_shadowBias;
 
 #endif
 
+// clustered lights
+#ifdef CLUSTERED_LIGHTING
+uniform sampler2D uClusteredLightingLightData;
+uniform vec2 uClusteredLightingLightDataSize;
+uniform sampler2D uClusteredLightingClusters;
+uniform vec2 uClusteredLightingClustersSize;
+uniform sampler2D uClusteredLightingLightIndices;
+uniform vec2 uClusteredLightingLightIndicesSize;
+uniform vec3 uClusteredLightingGridSize;
+uniform vec2 uClusteredLightingDepthRange;
+uniform vec3 uClusteredLightingBoundsMin;
+uniform vec3 uClusteredLightingBoundsSize;
+uniform float uClusteredLightingMaxRange;
+uniform float uClusteredLightingMaxIntensity;
+#endif
+
 varying vec3 vVertexPosition;
 varying vec2 vVertexUV;
 varying vec2 vVertexUV1;
@@ -616,7 +633,7 @@ void main(void)
     	#endif // NUM_AMBIENT_LIGHTS > 3
     #endif
 
-	#if defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS
+	#if defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS || defined CLUSTERED_LIGHTING
 		#if defined(NORMAL_MAP) && defined(VERTEX_UV)
 			// warning: the normal vector must be normalized at this point!
 			mat3 tangentToWorldMatrix = phong_getTangentToWorldSpaceMatrix(normalVector, vVertexTangent);
@@ -868,7 +885,61 @@ void main(void)
             #endif // NUM_SPOT_LIGHTS > 3
         #endif // defined(NUM_SPOT_LIGHTS)
 
-	#endif // defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS
+        #ifdef CLUSTERED_LIGHTING
+            vec2 cluster = clusteredLighting_getCluster(
+                uClusteredLightingClusters,
+                uClusteredLightingClustersSize,
+                uClusteredLightingGridSize,
+                uClusteredLightingDepthRange,
+                vVertexScreenPosition
+            );
+
+            for (int i = 0; i < CLUSTERED_LIGHTING_MAX_LIGHTS_PER_CLUSTER; ++i)
+            {
+                if (float(i) >= cluster.y)
+                    break;
+
+                float lightId = clusteredLighting_getLightId(uClusteredLightingLightIndices, uClusteredLightingLightIndicesSize, cluster.x + float(i));
+                vec3 lightPosition = uClusteredLightingBoundsMin + uClusteredLightingBoundsSize
+                    * clusteredLighting_getVec3(uClusteredLightingLightData, uClusteredLightingLightDataSize, lightId, CLUSTERED_LIGHTING_POSITION);
+                float range = uClusteredLightingMaxRange
+                    * clusteredLighting_getFloat(uClusteredLightingLightData, uClusteredLightingLightDataSize, lightId, CLUSTERED_LIGHTING_RANGE);
+
+                distVec = lightPosition - vVertexPosition;
+                dist = length(distVec);
+                if (dist >= range)
+                    continue;
+
+                dir = distVec / dist;
+
+                // point lights are stored with cone angles of 360 degrees
+                vec3 spotDirection = clusteredLighting_getVec3(uClusteredLightingLightData, uClusteredLightingLightDataSize, lightId, CLUSTERED_LIGHTING_DIRECTION) * 2.0 - 1.0;
+                float cosInnerConeAngle = clusteredLighting_getFloat(uClusteredLightingLightData, uClusteredLightingLightDataSize, lightId, CLUSTERED_LIGHTING_COS_INNER_CONE_ANGLE) * 2.0 - 1.0;
+                float cosOuterConeAngle = clusteredLighting_getFloat(uClusteredLightingLightData, uClusteredLightingLightDataSize, lightId, CLUSTERED_LIGHTING_COS_OUTER_CONE_ANGLE) * 2.0 - 1.0;
+
+                cosSpot = dot(-dir, normalize(spotDirection));
+                if (cosSpot < cosOuterConeAngle)
+                    continue;
+
+                cutoff = cosSpot < cosInnerConeAngle && cosOuterConeAngle < cosInnerConeAngle
+                    ? (cosSpot - cosOuterConeAngle) / (cosInnerConeAngle - cosOuterConeAngle)
+                    : 1.0;
+                att = clusteredLighting_attenuation(dist, range) * cutoff;
+
+                diffuseAccum += phong_diffuseReflection(normalVector, dir) * att * uClusteredLightingMaxIntensity
+                    * clusteredLighting_getVec3(uClusteredLightingLightData, uClusteredLightingLightDataSize, lightId, CLUSTERED_LIGHTING_DIFFUSE);
+                #ifdef SHININESS
+                    #if defined(FRESNEL)
+                        lightFresnel = phong_fresnel(specular.rgb, dir, eyeVector);
+                    #endif // FRESNEL
+                    specularAccum += phong_specularReflection(normalVector, dir, eyeVector, shininessCoeff) * att * uClusteredLightingMaxIntensity
+                        * clusteredLighting_getVec3(uClusteredLightingLightData, uClusteredLightingLightDataSize, lightId, CLUSTERED_LIGHTING_SPECULAR)
+                        * lightFresnel;
+                #endif // SHININESS
+            }
+        #endif // CLUSTERED_LIGHTING
+
+	#endif // defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS || defined CLUSTERED_LIGHTING
 
 	vec3 phong = diffuse.rgb * (ambientAccum + diffuseAccum) + specular.rgb * specular.a * specularAccum;
 
@@ -111,7 +111,7 @@ void main(void)
 		worldPosition 	= uModelToWorldMatrix * worldPosition;
 	#endif // MODEL_TO_WORLD
 
-	#if defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS || defined ENVIRONMENT_MAP_2D || defined ENVIRONMENT_CUBE_MAP
+	#if defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS || defined CLUSTERED_LIGHTING || defined ENVIRONMENT_MAP_2D || defined ENVIRONMENT_CUBE_MAP
 
 		vVertexPosition = worldPosition.xyz;
 		vVertexNormal = aNormal;
@@ -133,7 +133,7 @@ void main(void)
 			vVertexTangent = normalize(vVertexTangent);
 		#endif // NORMAL_MAP
 
-	#endif // NUM_DIRECTIONAL_LIGHTS || NUM_POINT_LIGHTS || NUM_SPOT_LIGHTS || ENVIRONMENT_MAP_2D || ENVIRONMENT_CUBE_MAP
+	#endif // NUM_DIRECTIONAL_LIGHTS || NUM_POINT_LIGHTS || NUM_SPOT_LIGHTS || CLUSTERED_LIGHTING || ENVIRONMENT_MAP_2D || ENVIRONMENT_CUBE_MAP
 
 	vec4 screenPosition = uWorldToScreenMatrix * worldPosition;
 
@@ -51,8 +51,21 @@ void main(void)
 
 varying vec4 vPosition;
 
+#ifdef STATIC_SHADOW_MAP
+uniform sampler2D uStaticShadowMap;
+uniform float uShadowMapSize;
+#endif
+
 void main(void)
 {
-    gl_FragColor = packFloat8bitRGBA(vPosition.z * 0.5 + 0.5);
+    float depth = vPosition.z * 0.5 + 0.5;
+
+    #ifdef STATIC_SHADOW_MAP
+        // the cached static shadows have already been copied in the shadow map: keep the closest depth
+        if (depth > unpackFloat8bitRGBA(texture2D(uStaticShadowMap, gl_FragCoord.xy / uShadowMapSize)))
+            discard;
+    #endif // STATIC_SHADOW_MAP
+
+    gl_FragColor = packFloat8bitRGBA(depth);
 }
 #endif
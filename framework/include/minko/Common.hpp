@@ -50,6 +50,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <climits>
 #include <cstdint>
 #include <future>
+#include <atomic>
 #include <thread>
 #include <chrono>
 #include <bitset>
@@ -99,6 +100,7 @@ namespace minko
 	namespace render
 	{
         class DrawCallPool;
+        class DrawCallTemplate;
 		class AbstractContext;
 		class OpenGLES2Context;
         class Blending;
@@ -113,6 +115,7 @@ namespace minko
 
         class States;
 		class DrawCall;
+		class CommandList;
 		class Pass;
 		class Effect;
 		class ProgramInputs;
@@ -126,6 +129,11 @@ namespace minko
         class VertexAttribute;
         class VertexBuffer;
 		class IndexBuffer;
+		class LightClusterGrid;
+		class RenderGraph;
+		class RenderTargetPool;
+		class TextureUploadQueue;
+		class BufferUploadQueue;
 
 		enum class TextureType
 		{
@@ -169,10 +177,12 @@ namespace minko
 	    class AbstractRootDataComponent;
 	    class SceneManager;
     	class Transform;
+        class TransformInterpolation;
 		class Surface;
 		class Renderer;
 		class Camera;
 		class Culling;
+		class ClusteredLighting;
 		class Picking;
 		class JobManager;
 
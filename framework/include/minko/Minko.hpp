@@ -31,6 +31,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/CloneOption.hpp"
 #include "minko/render/AbstractContext.hpp"
 #include "minko/render/OpenGLES2Context.hpp"
+#include "minko/render/RecordingContext.hpp"
+#include "minko/render/CommandList.hpp"
 #include "minko/render/ProgramInputs.hpp"
 #include "minko/render/Pass.hpp"
 #include "minko/render/Shader.hpp"
@@ -53,6 +55,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/data/MacroBinding.hpp"
 #include "minko/component/AbstractComponent.hpp"
 #include "minko/component/Transform.hpp"
+#include "minko/component/TransformInterpolation.hpp"
 #include "minko/component/Surface.hpp"
 #include "minko/component/Renderer.hpp"
 #include "minko/component/Camera.hpp"
@@ -70,6 +73,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/MouseManager.hpp"
 #include "minko/component/SkinningMethod.hpp"
 #include "minko/component/Culling.hpp"
+#include "minko/component/ClusteredLighting.hpp"
 #include "minko/component/Picking.hpp"
 #include "minko/component/PickingManager.hpp"
 #include "minko/component/AbstractAnimation.hpp"
@@ -84,6 +88,12 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/Program.hpp"
 #include "minko/render/VertexBuffer.hpp"
 #include "minko/render/IndexBuffer.hpp"
+#include "minko/render/LightClusterGrid.hpp"
+#include "minko/render/RenderGraph.hpp"
+#include "minko/render/RenderTargetPool.hpp"
+#include "minko/render/ImageResampler.hpp"
+#include "minko/render/TextureUploadQueue.hpp"
+#include "minko/render/BufferUploadQueue.hpp"
 #include "minko/render/AbstractTexture.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/RectangleTexture.hpp"
@@ -316,6 +316,13 @@ namespace minko
 			void
 			findSceneManager();
 
+			inline
+			std::shared_ptr<SceneManager>
+			sceneManager() const
+			{
+				return _sceneManager;
+			}
+
 			void
 			setSceneManager(std::shared_ptr<SceneManager>);
 
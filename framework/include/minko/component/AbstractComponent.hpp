@@ -41,16 +41,24 @@ namespace minko
             scene::Layout				    _layoutMask;
 			Signal<Ptr>						_layoutMaskChanged;
 
+            // set by scene::Node when the component is added
+            uint                            _typeId;
+            uint                            _registryIndex;
+
         protected:
             AbstractComponent(scene::Layout layoutMask = scene::LayoutMask::EVERYTHING) :
 				_layoutMask(layoutMask),
-				_layoutMaskChanged()
+				_layoutMaskChanged(),
+                _typeId(0),
+                _registryIndex(0)
 			{
 			}
 
 			AbstractComponent(const AbstractComponent& abstractComponent, const CloneOption& option) :
 				_layoutMask(abstractComponent._layoutMask),
-				_layoutMaskChanged()
+				_layoutMaskChanged(),
+                _typeId(0),
+                _registryIndex(0)
 			{
 			}
 
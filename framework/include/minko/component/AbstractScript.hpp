@@ -52,6 +52,7 @@ namespace minko
 			Signal<NodePtr, NodePtr, AbsCmpPtr>::Slot		                _componentRemovedSlot;
 			Signal<std::shared_ptr<SceneManager>, float, float>::Slot		_frameBeginSlot;
 			Signal<std::shared_ptr<SceneManager>, float, float>::Slot		_frameEndSlot;
+			Signal<std::shared_ptr<SceneManager>, float, float>::Slot		_tickSlot;
             std::shared_ptr<file::Loader>                                   _requiredAssetLoader;
             Signal<std::shared_ptr<file::Loader>, const file::Error&>::Slot _requiredAssetErrorSlot;
 
@@ -108,6 +109,15 @@ namespace minko
 				// nothing
 			}
 
+            // Called at each fixed tick of the SceneManager, see SceneManager::fixedTimestep().
+            // time() and deltaTime() then hold the tick time and the fixed timestep.
+			virtual
+			void
+			fixedUpdate(NodePtr target)
+			{
+				// nothing
+			}
+
 			virtual
 			void
 			end(NodePtr target)
@@ -159,6 +169,9 @@ namespace minko
 			void
 			frameEndHandler(std::shared_ptr<SceneManager> sceneManager, float, float);
 
+			void
+			tickHandler(std::shared_ptr<SceneManager> sceneManager, float, float);
+
 			void
 			setSceneManager(std::shared_ptr<SceneManager> sceneManager);
 
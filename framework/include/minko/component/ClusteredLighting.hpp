@@ -0,0 +1,167 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+        /*
+        ** Clustered forward lighting: each frame, bins the point and spot lights of the scene into
+        ** the view-space clusters of the camera it is attached to and packs the light data and the
+        ** per-cluster light lists into RGBA textures read by the "PhongClustered.effect" passes.
+        ** The number of lights does not appear in any macro and does not trigger new program variants.
+        */
+		class ClusteredLighting : public AbstractComponent
+		{
+		public:
+			typedef std::shared_ptr<ClusteredLighting>    Ptr;
+
+			// must match CLUSTERED_LIGHTING_MAX_LIGHTS_PER_CLUSTER in ClusteredLighting.function.glsl
+			static const uint MAX_LIGHTS_PER_CLUSTER;
+			static const uint LIGHT_DATA_TEXELS_PER_LIGHT;
+
+		private:
+			typedef std::shared_ptr<scene::Node>						NodePtr;
+			typedef std::shared_ptr<data::Provider>						ProviderPtr;
+			typedef std::shared_ptr<render::Texture>					TexturePtr;
+			typedef std::shared_ptr<render::AbstractTexture>			AbsTexPtr;
+			typedef std::shared_ptr<SceneManager>						SceneMngrPtr;
+			typedef Signal<SceneMngrPtr, uint, AbsTexPtr>::Slot			RenderingBeginSlot;
+
+		private:
+			std::shared_ptr<render::LightClusterGrid>		_grid;
+			uint											_maxNumLights;
+			float											_defaultLightRange;
+
+			math::mat4										_projection;
+			std::vector<math::vec4>							_viewSpaceSpheres;
+			std::vector<ProviderPtr>						_lights;
+			std::vector<float>								_lightRanges;
+			uint											_numDroppedLights;
+
+			ProviderPtr										_provider;
+			NodePtr											_root;
+			TexturePtr										_lightDataTexture;
+			TexturePtr										_clustersTexture;
+			TexturePtr										_lightIndicesTexture;
+
+			Signal<NodePtr, NodePtr, NodePtr>::Slot			_addedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot			_removedSlot;
+			RenderingBeginSlot								_renderingBeginSlot;
+
+		public:
+			inline static
+			Ptr
+			create(uint numClustersX	= 16,
+				   uint numClustersY	= 8,
+				   uint numClustersZ	= 24,
+				   uint maxNumLights	= 1024)
+			{
+				return std::shared_ptr<ClusteredLighting>(new ClusteredLighting(
+					numClustersX,
+					numClustersY,
+					numClustersZ,
+					maxNumLights
+				));
+			}
+
+			inline
+			std::shared_ptr<render::LightClusterGrid>
+			grid() const
+			{
+				return _grid;
+			}
+
+			inline
+			uint
+			maxNumLights() const
+			{
+				return _maxNumLights;
+			}
+
+			/*
+			** Number of (light, cluster) pairs missing from the light lists uploaded during the last
+			** frame, either because their cluster was full or because the light indices texture was.
+			*/
+			inline
+			uint
+			numDroppedLights() const
+			{
+				return _numDroppedLights;
+			}
+
+			/*
+			** Range used for the lights that do not declare a "range" property nor attenuation
+			** coefficients.
+			*/
+			inline
+			float
+			defaultLightRange() const
+			{
+				return _defaultLightRange;
+			}
+
+			inline
+			Ptr
+			defaultLightRange(float value)
+			{
+				_defaultLightRange = value;
+
+				return std::static_pointer_cast<ClusteredLighting>(shared_from_this());
+			}
+
+			/*
+			** Returns the distance beyond which the specified light provider has no visible effect.
+			*/
+			float
+			lightRange(ProviderPtr light) const;
+
+		protected:
+			void
+			targetAdded(NodePtr target);
+
+			void
+			targetRemoved(NodePtr target);
+
+		private:
+			ClusteredLighting(uint numClustersX, uint numClustersY, uint numClustersZ, uint maxNumLights);
+
+			void
+			updateRoot(NodePtr root);
+
+			void
+			initializeTextures(std::shared_ptr<render::AbstractContext> context);
+
+			void
+			update();
+
+			void
+			updateLightData();
+
+			void
+			updateClusters();
+		};
+	}
+}
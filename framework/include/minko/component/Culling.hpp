@@ -42,6 +42,8 @@ namespace minko
 			typedef std::shared_ptr<render::AbstractTexture>			AbsTexPtr;
 			typedef std::shared_ptr<SceneManager>						SceneMngrPtr;
 			typedef Signal<SceneMngrPtr, uint, AbsTexPtr>::Slot			RenderingBeginSlot;
+			typedef std::shared_ptr<Surface>							SurfacePtr;
+			typedef Signal<SceneMngrPtr, const std::vector<SurfacePtr>&>::Slot	SurfacesSlot;
 
 		private:
 			std::shared_ptr<math::OctTree>			        _octTree;
@@ -54,8 +56,8 @@ namespace minko
 
 			Signal<AbstractComponent::Ptr, NodePtr>::Slot	_targetAddedSlot;
             Signal<AbstractComponent::Ptr, NodePtr>::Slot	_targetRemovedSlot;
-            Signal<NodePtr, NodePtr, NodePtr>::Slot			_addedSlot;
-            Signal<NodePtr, NodePtr, NodePtr>::Slot			_removedSlot;
+            SurfacesSlot                        			_surfacesAddedSlot;
+            SurfacesSlot                        			_surfacesRemovedSlot;
 			Signal<NodePtr, NodePtr, NodePtr>::Slot			_addedToSceneSlot;
 			Signal<NodePtr, NodePtr>::Slot					_layoutChangedSlot;
 			PropertyChangedSignal::Slot	                    _viewMatrixChangedSlot;
@@ -121,10 +123,10 @@ namespace minko
 			Culling(ShapePtr shape, const std::string& bindProperty, scene::Layout layout);
 
             void
-            addedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+            surfacesAddedHandler(SceneMngrPtr sceneManager, const std::vector<SurfacePtr>& surfaces);
 
             void
-            removedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+            surfacesRemovedHandler(SceneMngrPtr sceneManager, const std::vector<SurfacePtr>& surfaces);
 
 			void
 			layoutChangedHandler(NodePtr node, NodePtr target);
@@ -36,6 +36,8 @@ namespace minko
         private:
             typedef std::shared_ptr<render::Texture>    TexturePtr;
             typedef std::shared_ptr<Renderer>           RendererPtr;
+            typedef std::shared_ptr<Surface>            SurfacePtr;
+            typedef std::pair<math::vec3, math::vec3>   Box;
 
         public:
             static const uint MAX_NUM_SHADOW_CASCADES;
@@ -43,6 +45,7 @@ namespace minko
             static const uint MIN_SHADOWMAP_SIZE;
             static const uint MAX_SHADOWMAP_SIZE;
             static const uint DEFAULT_SHADOWMAP_SIZE;
+            static const float DEFAULT_STATIC_SHADOW_MARGIN;
 
 		private:
 			math::vec3                  _worldDirection;
@@ -52,8 +55,18 @@ namespace minko
             uint                        _numShadowCascades;
             std::array<RendererPtr, 4>  _shadowRenderers;
             std::array<math::mat4, 4>   _shadowProjections;
+            std::array<Box, 4>          _shadowBoxes;
+            std::array<std::shared_ptr<math::Frustum>, 4>   _shadowFrustums;
             math::mat4                  _view;
 
+            bool                        _staticShadowsEnabled;
+            float                       _staticShadowMargin;
+            TexturePtr                  _staticShadowMap;
+            std::array<RendererPtr, 4>  _staticShadowRenderers;
+            std::array<RendererPtr, 4>  _staticShadowCopyRenderers;
+            std::array<math::mat4, 4>   _staticShadowViewProjections;
+            std::array<Signal<RendererPtr>::Slot, 4>    _staticShadowRenderingEndSlots;
+
 	    public:
 		    inline static
 		    Ptr
@@ -119,6 +132,33 @@ namespace minko
             void
             disableShadowMapping(bool disposeResources = false);
 
+            inline
+            bool
+            staticShadowsEnabled() const
+            {
+                return _staticShadowsEnabled;
+            }
+
+            /*
+            ** Shadow casters with the BuiltinLayout::STATIC layout are rendered once in a cached
+            ** shadow map, composited with the other casters every frame. The cascades are re-fitted
+            ** (and the cache re-rendered) only when the camera frustum leaves the cascade bounds,
+            ** which are enlarged by margin (relative to their size) to absorb small camera moves.
+            ** Static shadows are not supported with ESM.
+            */
+            void
+            enableStaticShadows(float margin = DEFAULT_STATIC_SHADOW_MARGIN);
+
+            void
+            disableStaticShadows();
+
+            /*
+            ** Forces the static shadow casters to be rendered again, for example after a static
+            ** node was added, removed or moved.
+            */
+            void
+            invalidateStaticShadows();
+
 		protected:
 			void
             updateModelToWorldMatrix(const math::mat4& modelToWorld) override;
@@ -140,7 +180,19 @@ namespace minko
             void
             updateWorldToScreenMatrix();
 
-            std::pair<math::vec3, math::vec3>
+            math::ivec4
+            shadowCascadeViewport(uint cascadeId) const;
+
+            void
+            initializeStaticShadows();
+
+            void
+            disposeStaticShadows();
+
+            bool
+            castsShadow(SurfacePtr surface, uint cascadeId, bool staticCaster);
+
+            Box
             computeBox(const math::mat4& viewProjection);
 
             std::pair<math::vec3, float>
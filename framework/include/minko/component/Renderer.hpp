@@ -48,6 +48,7 @@ namespace minko
             typedef std::shared_ptr<render::DrawCall>                                       DrawCallPtr;
             typedef std::shared_ptr<SceneManager>                                           SceneManagerPtr;
             typedef std::shared_ptr<render::AbstractTexture>                                AbsTexturePtr;
+            typedef std::shared_ptr<render::CommandList>                                    CommandListPtr;
             typedef std::shared_ptr<render::Effect>                                         EffectPtr;
             typedef std::shared_ptr<data::AbstractFilter>                                   AbsFilterPtr;
             typedef Signal<SurfacePtr, const std::string&, bool>::Slot                      SurfaceTechniqueChangedSlot;
@@ -60,6 +61,9 @@ namespace minko
             typedef render::DrawCallPool::DrawCallIteratorPair                              DrawCallIteratorPair;
             typedef std::unordered_map<SurfacePtr, std::list<SurfaceChangedSignal::Slot>>   SurfaceSlotMap;
             typedef Signal<render::DrawCall*>                                               ZSortNeeded;
+
+        public:
+            typedef std::function<bool(SurfacePtr)>                                         SurfaceFilterFunction;
         private:
             std::string                                                             _name;
 
@@ -94,6 +98,8 @@ namespace minko
             Signal<NodePtr, NodePtr, AbsCmpPtr>::Slot                               _componentAddedSlot;
             Signal<NodePtr, NodePtr, AbsCmpPtr>::Slot                               _componentRemovedSlot;
             Signal<SceneManagerPtr, uint, AbsTexturePtr>::Slot                      _renderingBeginSlot;
+            Signal<SceneManagerPtr, const std::vector<SurfacePtr>&>::Slot           _surfacesAddedSlot;
+            Signal<SceneManagerPtr, const std::vector<SurfacePtr>&>::Slot           _surfacesRemovedSlot;
             SurfaceSlotMap                                                          _surfaceChangedSlots;
             Signal<Store&, ProviderPtr, const data::Provider::PropertyName&>::Slot  _worldToScreenMatrixPropertyChangedSlot;
             ProviderPtr                                                             _rendererProvider;
@@ -117,6 +123,12 @@ namespace minko
             uint                                                                    _numDrawCalls;
             uint                                                                    _numTriangles;
 
+            SurfaceFilterFunction                                                   _surfaceFilter;
+            std::unordered_set<uint>                                                _filteredBatchIds;
+
+            AbsTexturePtr                                                           _preparedRenderTarget;
+            CommandListPtr                                                          _commandList;
+
         public:
             inline static
             Ptr
@@ -339,6 +351,35 @@ namespace minko
             render(std::shared_ptr<render::AbstractContext> context,
                    AbsTexturePtr                            renderTarget = nullptr);
 
+            /*
+            ** render() split in steps so that SceneManager can record the command lists of several
+            ** renderers in parallel. prepare() runs everything that may touch the scene, the
+            ** context or user code: it executes renderingBegin() and updates the draw calls. It
+            ** returns false if the renderer is disabled, in which case the other steps must be
+            ** skipped. recordCommandList() only reads the draw calls and can run on any thread, as
+            ** long as no other renderer records into the same list. The list is then submitted on
+            ** the thread owning the context and finishRendering() executes beforePresent(),
+            ** presents and executes renderingEnd().
+            */
+            bool
+            prepare(AbsTexturePtr renderTarget = nullptr);
+
+            void
+            recordCommandList();
+
+            void
+            submitCommandList(std::shared_ptr<render::AbstractContext> context);
+
+            void
+            finishRendering(std::shared_ptr<render::AbstractContext> context);
+
+            inline
+            CommandListPtr
+            commandList() const
+            {
+                return _commandList;
+            }
+
             void
             clear(std::shared_ptr<AbstractCanvas> canvas);
 
@@ -366,6 +407,25 @@ namespace minko
                 return _renderingEnd;
             }
 
+            inline
+            const SurfaceFilterFunction&
+            surfaceFilter() const
+            {
+                return _surfaceFilter;
+            }
+
+            /*
+            ** The surface filter is evaluated once per frame for each surface of the renderer: the
+            ** draw calls of the rejected surfaces are skipped. It is meant for cheap visibility tests
+            ** (per-view culling) that must not trigger the draw call rebuilds of a layout change.
+            */
+            inline
+            void
+            surfaceFilter(const SurfaceFilterFunction& filter)
+            {
+                _surfaceFilter = filter;
+            }
+
             Ptr
             addFilter(AbsFilterPtr, data::Binding::Source);
 
@@ -439,6 +499,12 @@ namespace minko
             void
             rootDescendantRemovedHandler(NodePtr node, NodePtr target, NodePtr parent);
 
+            void
+            surfacesAddedHandler(SceneManagerPtr sceneManager, const std::vector<SurfacePtr>& surfaces);
+
+            void
+            surfacesRemovedHandler(SceneManagerPtr sceneManager, const std::vector<SurfacePtr>& surfaces);
+
             void
             componentAddedHandler(NodePtr node, NodePtr target, AbsCmpPtr   ctrl);
 
@@ -463,6 +529,16 @@ namespace minko
             void
             materialChanged(SurfacePtr ctrl);*/
 
+            template <typename ContextPtr>
+            void
+            issue(const ContextPtr& context);
+
+            void
+            issueDrawCall(render::DrawCall& drawCall, const AbsContext& context, AbsTexturePtr renderTarget);
+
+            void
+            issueDrawCall(render::DrawCall& drawCall, const CommandListPtr& commandList, AbsTexturePtr renderTarget);
+
             void
             sceneManagerRenderingBeginHandler(std::shared_ptr<SceneManager> sceneManager,
                                               uint                          frameId,
@@ -522,6 +598,9 @@ namespace minko
 
             void
             listenRootSignals();
+
+            void
+            listenSurfaceSignals();
         };
     }
 }
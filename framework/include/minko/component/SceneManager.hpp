@@ -24,6 +24,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/AbstractComponent.hpp"
 #include "minko/Signal.hpp"
 
+#include <mutex>
+#include <condition_variable>
+
 namespace minko
 {
     namespace component
@@ -34,15 +37,29 @@ namespace minko
 	    public:
 		    typedef std::shared_ptr<SceneManager> Ptr;
 
+            typedef std::shared_ptr<Surface>                            SurfacePtr;
+            typedef Signal<Ptr, const std::vector<SurfacePtr>&>         SurfacesSignal;
+
         private:
             typedef std::shared_ptr<scene::Node>				NodePtr;
 			typedef std::shared_ptr<render::AbstractTexture>	AbsTexturePtr;
+            typedef std::shared_ptr<AbstractComponent>          AbsCmpPtr;
+            typedef std::shared_ptr<Renderer>                   RendererPtr;
+            typedef Signal<NodePtr, const std::vector<AbsCmpPtr>&>  ComponentsSignal;
 
         private:
             uint                                            _frameId;
             float                                           _time;
             std::shared_ptr<file::AssetLibrary>             _assets;
 
+            float                                           _fixedTimestep;
+            uint                                            _maxNumTicksPerFrame;
+            float                                           _tickAccumulator;
+            float                                           _tickTime;
+            uint                                            _numTicksLastFrame;
+            uint                                            _numDroppedTicks;
+
+            Signal<Ptr, float, float>::Ptr                  _tick;
             Signal<Ptr, float, float>::Ptr                  _frameBegin;
             Signal<Ptr, float, float>::Ptr                  _frameEnd;
 			Signal<Ptr>::Ptr                                _cullBegin;
@@ -52,14 +69,37 @@ namespace minko
 
 			std::shared_ptr<data::Provider>		            _data;
 
+            SurfacesSignal::Ptr                             _surfacesAdded;
+            SurfacesSignal::Ptr                             _surfacesRemoved;
+            std::vector<SurfacePtr>                         _addedSurfaces;
+            std::unordered_set<SurfacePtr>                  _pendingSurfaces;
+
             Signal<AbstractComponent::Ptr, NodePtr>::Slot   _targetAddedSlot;
             Signal<AbstractComponent::Ptr, NodePtr>::Slot   _targetRemovedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot         _addedSlot;
+            ComponentsSignal::Slot                          _componentsRegisteredSlot;
+            ComponentsSignal::Slot                          _componentsUnregisteredSlot;
 
             std::shared_ptr<AbstractCanvas>                 _canvas;
 
             bool                                            _forceRenderNextFrame;
 
+            uint                                            _numRecordingThreads;
+            std::vector<RendererPtr>                        _deferredRenderers;
+
+            // persistent recording workers: worker i records along with the calling thread when
+            // a job needs more than i threads
+            std::vector<std::thread>                        _recordingWorkers;
+            std::mutex                                      _recordingMutex;
+            std::condition_variable                         _recordingCondition;
+            std::condition_variable                         _recordingDoneCondition;
+            bool                                            _recordingTerminating;
+            uint                                            _recordingJobId;
+            uint                                            _recordingJobNumThreads;
+            uint                                            _recordingJobNumPendingWorkers;
+            const std::vector<RendererPtr>*                 _recordingJobRenderers;
+            std::atomic<uint>                               _recordingJobNextRenderer;
+
 	    public:
 		    inline static
 		    Ptr
@@ -70,9 +110,7 @@ namespace minko
                 return sm;
 		    }
 
-            ~SceneManager()
-            {
-            }
+            ~SceneManager();
 
             inline
             std::shared_ptr<AbstractCanvas>
@@ -102,6 +140,77 @@ namespace minko
                 _forceRenderNextFrame = true;
             }
 
+            inline
+            float
+            fixedTimestep() const
+            {
+                return _fixedTimestep;
+            }
+
+            // Runs the tick() signal at a fixed rate (in milliseconds) independent from the
+            // framerate. 0 disables fixed ticks.
+            inline
+            void
+            fixedTimestep(float value)
+            {
+                _fixedTimestep = std::max(0.f, value);
+                _tickAccumulator = 0.f;
+            }
+
+            inline
+            uint
+            maxNumTicksPerFrame() const
+            {
+                return _maxNumTicksPerFrame;
+            }
+
+            // Ticks that do not fit in a frame are dropped so that a slow frame cannot
+            // trigger an ever growing number of ticks. 0 means no limit, ie. the
+            // simulation runs as fast as needed to catch up, as in headless runs.
+            inline
+            void
+            maxNumTicksPerFrame(uint value)
+            {
+                _maxNumTicksPerFrame = value;
+            }
+
+            inline
+            Signal<Ptr, float, float>::Ptr
+            tick() const
+            {
+                return _tick;
+            }
+
+            // Simulation time at the last tick, in milliseconds.
+            inline
+            float
+            tickTime() const
+            {
+                return _tickTime;
+            }
+
+            // Position of the current frame between the last two ticks, in [0, 1).
+            inline
+            float
+            tickInterpolationFactor() const
+            {
+                return _fixedTimestep > 0.f ? _tickAccumulator / _fixedTimestep : 0.f;
+            }
+
+            inline
+            uint
+            numTicksLastFrame() const
+            {
+                return _numTicksLastFrame;
+            }
+
+            inline
+            uint
+            numDroppedTicks() const
+            {
+                return _numDroppedTicks;
+            }
+
             inline
             Signal<Ptr, float, float>::Ptr
             frameBegin() const
@@ -151,6 +260,56 @@ namespace minko
                 return _time;
             }
 
+            // Surfaces that entered the scene since the last frame, in the order they were added.
+            // Executed before frameBegin() and, for the surfaces added by frameBegin() listeners,
+            // before cullingBegin(). Surfaces added then removed in between are never reported.
+            inline
+            SurfacesSignal::Ptr
+            surfacesAdded() const
+            {
+                return _surfacesAdded;
+            }
+
+            // Surfaces that left the scene, executed once per removeChild() or removeComponent()
+            // while the surfaces still have their target. It is never deferred because listeners
+            // usually hold references to the data of the surface nodes.
+            inline
+            SurfacesSignal::Ptr
+            surfacesRemoved() const
+            {
+                return _surfacesRemoved;
+            }
+
+            inline
+            uint
+            numRecordingThreads() const
+            {
+                return _numRecordingThreads;
+            }
+
+            // With a non-zero value, the renderers driven by renderingEnd() no longer render right
+            // away: they are prepared in priority order, then their command lists are recorded by
+            // up to this number of threads, the calling thread included, and submitted in the same
+            // order. The renderingBegin() signals of all the renderers are thus executed before
+            // any of them is drawn, and their renderingEnd() signals after all of them are drawn.
+            // The worker threads are started on demand and kept alive until the SceneManager is
+            // destroyed. 0, the default, renders each renderer in turn.
+            inline
+            void
+            numRecordingThreads(uint value)
+            {
+                _numRecordingThreads = value;
+            }
+
+            // Called by the renderers prepared during renderingEnd() when numRecordingThreads()
+            // is not 0.
+            void
+            deferRendering(RendererPtr renderer);
+
+            // Executes surfacesAdded() right away with the surfaces added since the last call.
+            void
+            flushAddedSurfaces();
+
             void
             nextFrame(float time, float deltaTime, bool shouldRender = true, AbsTexturePtr target = nullptr);
 
@@ -166,6 +325,24 @@ namespace minko
 
             void
             addedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+
+            void
+            executeTicks(float deltaTime);
+
+            void
+            renderDeferredRenderers();
+
+            void
+            recordCommandLists();
+
+            void
+            recordingWorkerLoop(uint worker, uint jobId);
+
+            void
+            componentsRegisteredHandler(NodePtr root, const std::vector<AbsCmpPtr>& components);
+
+            void
+            componentsUnregisteredHandler(NodePtr root, const std::vector<AbsCmpPtr>& components);
 	    };
     }
 }
@@ -0,0 +1,97 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+    namespace component
+    {
+        /*
+        ** Keeps the local matrix of the target's Transform at the last two fixed ticks of the
+        ** SceneManager and, for each rendered frame, sets it to their interpolation according to
+        ** SceneManager::tickInterpolationFactor(). The simulated matrix is restored before the
+        ** next tick, so simulation code never sees interpolated values. Changes made outside of
+        ** ticks are treated as teleports and are not interpolated.
+        */
+        class TransformInterpolation :
+            public AbstractComponent
+        {
+        public:
+            typedef std::shared_ptr<TransformInterpolation>     Ptr;
+
+        private:
+            typedef std::shared_ptr<scene::Node>                NodePtr;
+            typedef std::shared_ptr<SceneManager>               SceneManagerPtr;
+
+        private:
+            math::mat4                                          _previous;
+            math::mat4                                          _current;
+            math::mat4                                          _interpolated;
+            bool                                                _hasSnapshot;
+
+            Signal<NodePtr, NodePtr, NodePtr>::Slot             _addedSlot;
+            Signal<NodePtr, NodePtr, NodePtr>::Slot             _removedSlot;
+            Signal<SceneManagerPtr, float, float>::Slot         _tickBeginSlot;
+            Signal<SceneManagerPtr, float, float>::Slot         _tickEndSlot;
+            Signal<SceneManagerPtr, float, float>::Slot         _frameBeginSlot;
+
+        public:
+            inline static
+            Ptr
+            create()
+            {
+                return std::shared_ptr<TransformInterpolation>(new TransformInterpolation());
+            }
+
+            AbstractComponent::Ptr
+            clone(const CloneOption& option);
+
+            static
+            math::mat4
+            interpolate(const math::mat4& from, const math::mat4& to, float ratio);
+
+        protected:
+            void
+            targetAdded(NodePtr target);
+
+            void
+            targetRemoved(NodePtr target);
+
+        private:
+            TransformInterpolation();
+
+            void
+            setSceneManager(SceneManagerPtr sceneManager);
+
+            void
+            tickBeginHandler();
+
+            void
+            tickEndHandler();
+
+            void
+            frameBeginHandler(SceneManagerPtr sceneManager);
+        };
+    }
+}
@@ -53,6 +53,9 @@ namespace minko
 			typedef std::shared_ptr<material::Material>		                MaterialPtr;
             typedef std::shared_ptr<audio::Sound>                           SoundPtr;
             typedef std::shared_ptr<file::AbstractAssetDescriptor>          AbstractAssetDescriptorPtr;
+            typedef std::shared_ptr<render::RenderTargetPool>               RenderTargetPoolPtr;
+            typedef std::shared_ptr<render::TextureUploadQueue>             TextureUploadQueuePtr;
+            typedef std::shared_ptr<render::BufferUploadQueue>              BufferUploadQueuePtr;
 
         private:
             AbsContextPtr                                                   _context;
@@ -70,6 +73,9 @@ namespace minko
             std::unordered_map<std::string, scene::Layout>				    _layouts;
             std::unordered_map<std::string, SoundPtr>                       _sounds;
             std::unordered_map<std::string, AbstractAssetDescriptorPtr>     _assetDescriptors;
+            RenderTargetPoolPtr                                             _renderTargetPool;
+            TextureUploadQueuePtr                                           _textureUploadQueue;
+            BufferUploadQueuePtr                                            _bufferUploadQueue;
 
             Signal<Ptr, std::shared_ptr<AbstractParser>>::Ptr               _parserError;
             Signal<Ptr>::Ptr                                                _ready;
@@ -123,6 +129,26 @@ namespace minko
                 return _context;
             }
 
+            /*
+            ** Pool the transient render targets of the loaded effects are allocated from.
+            */
+            RenderTargetPoolPtr
+            renderTargetPool();
+
+            /*
+            ** Queue the texture parsers decode and upload through when Options::loadTexturesAsynchronously()
+            ** is enabled. It is updated every frame by the SceneManager owning this library.
+            */
+            TextureUploadQueuePtr
+            textureUploadQueue();
+
+            /*
+            ** Queue the vertex and index buffers updated every frame are uploaded through. It is
+            ** updated every frame by the SceneManager owning this library, right after frameBegin().
+            */
+            BufferUploadQueuePtr
+            bufferUploadQueue();
+
             inline
             std::shared_ptr<Loader>
             loader()
@@ -109,6 +109,15 @@ namespace minko
                 }
             };
 
+            struct TransientTarget
+            {
+                std::string name;
+                uint width;
+                uint height;
+                bool isCube;
+                AbstractTexturePtr placeholder;
+            };
+
             typedef Block<data::BindingMap> AttributeBlock;
             typedef Block<data::MacroBindingMap> MacroBlock;
             typedef Block<data::BindingMap> UniformBlock;
@@ -184,6 +193,7 @@ namespace minko
             unsigned int                    _numDependencies;
             unsigned int                    _numLoadedDependencies;
             std::shared_ptr<data::Provider> _effectData;
+            std::unordered_map<std::string, TransientTarget>    _transientTargets;
 
             LoaderCompleteSlotMap           _loaderCompleteSlots;
             LoaderErrorSlotMap              _loaderErrorSlots;
@@ -454,6 +464,9 @@ namespace minko
             std::shared_ptr<render::States>
             createStates(const StateBlock& block);
 
+            void
+            allocateTransientTargets();
+
             void
             finalize();
         };
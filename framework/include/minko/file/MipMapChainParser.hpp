@@ -42,7 +42,14 @@ namespace minko
                          bool                  					    mipMapping	= false,
                          bool                  					    smooth      = true,
                          render::TextureFormat 					    format      = render::TextureFormat::RGBA,
-                         const std::string&    					    filename    = "");
+                         const std::string&    					    filename    = "",
+                         bool                                       upload      = true);
+
+            /*
+            ** Uploads a texture returned by parseTexture() with upload set to false, along with its parsed mip levels.
+            */
+            void
+            uploadTexture(std::shared_ptr<render::Texture> texture);
 
             std::shared_ptr<render::CubeTexture>
             parseCubeTexture(std::shared_ptr<render::AbstractContext>   context,
@@ -53,7 +60,8 @@ namespace minko
                              bool                                       mipMapping  = false,
                              bool                                       smooth      = true,
                              render::TextureFormat                      format      = render::TextureFormat::RGBA,
-                             const std::string&                         filename    = "");
+                             const std::string&                         filename    = "",
+                             bool                                       upload      = true);
 
             void
             parseMipMap(unsigned char*       out,
@@ -96,11 +96,13 @@ namespace minko
             bool                                                        _includeAnimation;
 			bool										                _startAnimation;
 			bool										                _loadAsynchronously;
+			bool										                _loadTexturesAsynchronously;
             bool                                                        _disposeIndexBufferAfterLoading;
             bool                                                        _disposeVertexBufferAfterLoading;
             bool                                                        _disposeTextureAfterLoading;
             bool                                                        _storeDataIfNotParsed;
             bool                                                        _preserveMaterials;
+            bool                                                        _allowUnsignedIntIndices;
             bool                                                        _trackAssetDescriptor;
 			unsigned int								                _skinningFramerate;
 			component::SkinningMethod					                _skinningMethod;
@@ -303,6 +305,26 @@ namespace minko
 				return shared_from_this();
 			}
 
+			/*
+			** Whether texture parsers decode on the decoding threads of AssetLibrary::textureUploadQueue()
+			** and leave the GPU upload to its per-frame budget instead of doing both immediately.
+			*/
+			inline
+			bool
+			loadTexturesAsynchronously() const
+			{
+				return _loadTexturesAsynchronously;
+			}
+
+			inline
+			Ptr
+			loadTexturesAsynchronously(bool value)
+			{
+				_loadTexturesAsynchronously = value;
+
+				return shared_from_this();
+			}
+
 			inline
 			bool
 			resizeSmoothly() const
@@ -479,6 +501,27 @@ namespace minko
                 return shared_from_this();
             }
 
+            inline
+            bool
+            allowUnsignedIntIndices() const
+            {
+                return _allowUnsignedIntIndices;
+            }
+
+            /**
+             * Let parsers keep meshes with more than 65535 vertices in a single 32-bit index buffer
+             * instead of splitting them. Only enable it when the target context supports
+             * 32-bit indices (OES_element_index_uint on OpenGL ES 2).
+             */
+            inline
+            Ptr
+            allowUnsignedIntIndices(bool value)
+            {
+                _allowUnsignedIntIndices = value;
+
+                return shared_from_this();
+            }
+
             inline
             bool
             trackAssetDescriptor() const
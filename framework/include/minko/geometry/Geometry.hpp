@@ -236,6 +236,17 @@ namespace minko
 
 			void
 			getHitNormal(uint triangle, math::vec3* hitNormal);
+
+            inline
+            uint
+            indexAt(uint i) const
+            {
+                const auto ushortIndices = _indexBuffer->dataPointer<unsigned short>();
+
+                return ushortIndices
+                    ? static_cast<uint>((*ushortIndices)[i])
+                    : (*_indexBuffer->dataPointer<unsigned int>())[i];
+            }
 		};
 	}
 }
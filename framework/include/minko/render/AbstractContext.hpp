@@ -23,6 +23,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/render/Blending.hpp"
 #include "minko/render/TextureFormat.hpp"
+#include "minko/render/VertexAttribute.hpp"
 #include "minko/render/CubeTexture.hpp"
 
 namespace minko
@@ -110,6 +111,15 @@ namespace minko
                               const uint    stride,
                               const uint    offset) = 0;
 
+            virtual
+            void
+            setVertexBufferAt(const uint                    position,
+                              const uint                    vertexBuffer,
+                              const uint                    size,
+                              const uint                    stride,
+                              const uint                    offset,
+                              const VertexAttribute::Format format) = 0;
+
             virtual
             void
             uploadVertexBufferData(const uint     vertexBuffer,
@@ -117,6 +127,15 @@ namespace minko
                                    const uint     size,
                                    void*                 data) = 0;
 
+            /*
+            ** Replaces the storage of the buffer by a new one of size floats with undefined content.
+            ** The draw calls already issued keep reading the previous storage, so the next uploads
+            ** do not have to wait for them.
+            */
+            virtual
+            void
+            orphanVertexBuffer(const uint vertexBuffer, const uint size) = 0;
+
             virtual
             void
             deleteVertexBuffer(const uint vertexBuffer) = 0;
@@ -125,6 +144,10 @@ namespace minko
             const uint
             createIndexBuffer(const uint size) = 0;
 
+            virtual
+            const uint
+            createIndexBuffer(const uint size, const uint indexSize) = 0;
+
             virtual
             void
             uploadIndexBufferData(const uint     indexBuffer,
@@ -132,10 +155,21 @@ namespace minko
                                   const uint     size,
                                   void*          data) = 0;
 
+            /*
+            ** Same as orphanVertexBuffer(), size being a number of indices.
+            */
+            virtual
+            void
+            orphanIndexBuffer(const uint indexBuffer, const uint size) = 0;
+
             virtual
             void
             deleteIndexBuffer(const uint indexBuffer) = 0;
 
+            virtual
+            bool
+            supportsUnsignedIntIndices() = 0;
+
             virtual
             uint
             createTexture(TextureType   type,
@@ -0,0 +1,168 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+        /*
+        ** Batches the uploads of the vertex and index buffers updated every frame, such as the ones of
+        ** software skinning. Uploads are performed by update() - called once per frame by the
+        ** SceneManager, right after frameBegin() - and the ranges queued for the same vertex buffer are
+        ** merged. A buffer whose queued ranges cover at least orphanRatio() of its vertices is
+        ** orphaned then uploaded at once: its draw calls of the previous frames keep reading the old
+        ** storage instead of stalling the upload until the GPU is done with them.
+        */
+		class BufferUploadQueue :
+			public std::enable_shared_from_this<BufferUploadQueue>
+		{
+		public:
+			typedef std::shared_ptr<BufferUploadQueue> Ptr;
+
+		private:
+			typedef std::shared_ptr<VertexBuffer>		VertexBufferPtr;
+			typedef std::shared_ptr<IndexBuffer>		IndexBufferPtr;
+
+			struct Range
+			{
+				uint	begin;
+				uint	end;
+			};
+
+		private:
+			static const float                                      DEFAULT_ORPHAN_RATIO;
+
+			std::vector<VertexBufferPtr>				            _vertexBuffers;
+			std::unordered_map<VertexBufferPtr, std::vector<Range>>	_vertexBufferRanges;
+			std::vector<IndexBufferPtr>					            _indexBuffers;
+			std::unordered_set<IndexBufferPtr>			            _queuedIndexBuffers;
+
+			float										            _orphanRatio;
+
+			uint64_t									            _numUploadedBytes;
+			uint										            _numUploadsLastFrame;
+			uint										            _numUploadedBytesLastFrame;
+			uint										            _numOrphanedBuffersLastFrame;
+
+		public:
+			inline static
+			Ptr
+			create()
+			{
+				return std::shared_ptr<BufferUploadQueue>(new BufferUploadQueue());
+			}
+
+			/*
+			** Fraction of the vertices of a buffer above which the buffer is orphaned and fully
+			** uploaded instead of uploading each queued range. Above 1, buffers are never orphaned.
+			*/
+			inline
+			float
+			orphanRatio() const
+			{
+				return _orphanRatio;
+			}
+
+			inline
+			Ptr
+			orphanRatio(float value)
+			{
+				_orphanRatio = value;
+
+				return shared_from_this();
+			}
+
+			inline
+			uint
+			numPendingUploads() const
+			{
+				return static_cast<uint>(_vertexBuffers.size() + _indexBuffers.size());
+			}
+
+			inline
+			uint64_t
+			numUploadedBytes() const
+			{
+				return _numUploadedBytes;
+			}
+
+			/*
+			** Number of calls to the context performed by the last update().
+			*/
+			inline
+			uint
+			numUploadsLastFrame() const
+			{
+				return _numUploadsLastFrame;
+			}
+
+			inline
+			uint
+			numUploadedBytesLastFrame() const
+			{
+				return _numUploadedBytesLastFrame;
+			}
+
+			inline
+			uint
+			numOrphanedBuffersLastFrame() const
+			{
+				return _numOrphanedBuffersLastFrame;
+			}
+
+			/*
+			** Queues the upload of numVertices vertices of vertexBuffer starting at offset, 0 meaning
+			** up to the last vertex.
+			*/
+			void
+			upload(VertexBufferPtr vertexBuffer, uint offset = 0, uint numVertices = 0);
+
+			/*
+			** Queues the upload of all the indices of indexBuffer.
+			*/
+			void
+			upload(IndexBufferPtr indexBuffer);
+
+			void
+			cancel(VertexBufferPtr vertexBuffer);
+
+			void
+			cancel(IndexBufferPtr indexBuffer);
+
+			/*
+			** Performs all the queued uploads.
+			*/
+			void
+			update();
+
+		private:
+			BufferUploadQueue();
+
+			void
+			uploadVertexBuffer(VertexBufferPtr vertexBuffer, std::vector<Range>& ranges);
+
+			void
+			uploadIndexBuffer(IndexBufferPtr indexBuffer);
+		};
+	}
+}
@@ -0,0 +1,248 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        /*
+        ** Flat buffer of the GL calls issued to render a frame, recorded without touching the
+        ** context so that it can be filled on a worker thread and submitted on the thread owning
+        ** the context. Uniform values are copied when they are recorded. Only the calls needed to
+        ** render draw calls are supported: resources must be created on the context beforehand.
+        ** Unlike a RecordingContext log, the list is only read back by submit() within the frame:
+        ** it has no header, timestamps or command sizes and stores draw call pointers as they are.
+        */
+        class CommandList
+        {
+        public:
+            typedef std::shared_ptr<CommandList>    Ptr;
+
+        private:
+            enum class Command : unsigned char
+            {
+                CLEAR,
+                CONFIGURE_VIEWPORT,
+                DRAW_TRIANGLES,
+                DRAW_INDEXED_TRIANGLES,
+                SET_PROGRAM,
+                SET_RENDER_TO_BACK_BUFFER,
+                SET_RENDER_TO_TEXTURE,
+                SET_UNIFORM_FLOAT,
+                SET_UNIFORM_FLOAT2,
+                SET_UNIFORM_FLOAT3,
+                SET_UNIFORM_FLOAT4,
+                SET_UNIFORM_MATRIX4X4,
+                SET_UNIFORM_INT,
+                SET_UNIFORM_INT2,
+                SET_UNIFORM_INT3,
+                SET_UNIFORM_INT4,
+                SET_TEXTURE_AT,
+                SET_SAMPLER_STATE_AT,
+                SET_VERTEX_BUFFER_AT,
+                SET_VERTEX_ATTRIBUTE_ARRAY,
+                BIND_VERTEX_ATTRIBUTES,
+                SET_BLENDING_MODE,
+                SET_COLOR_MASK,
+                SET_DEPTH_TEST,
+                SET_STENCIL_TEST,
+                SET_SCISSOR_TEST,
+                SET_TRIANGLE_CULLING
+            };
+
+            std::vector<unsigned char>  _buffer;
+            uint                        _numCommands;
+            uint                        _renderTarget;
+
+        public:
+            inline static
+            Ptr
+            create()
+            {
+                return Ptr(new CommandList());
+            }
+
+            inline
+            uint
+            numCommands() const
+            {
+                return _numCommands;
+            }
+
+            inline
+            std::size_t
+            size() const
+            {
+                return _buffer.size();
+            }
+
+            /*
+            ** Empties the list but keeps its memory, so that recording the next frame does not
+            ** allocate once the list has grown to its working size.
+            */
+            void
+            reset();
+
+            /*
+            ** Executes the recorded commands on context, in order.
+            */
+            void
+            submit(AbstractContext& context) const;
+
+            /*
+            ** Render target set by the last recorded setRenderToTexture() or
+            ** setRenderToBackBuffer() call.
+            */
+            inline
+            uint
+            renderTarget() const
+            {
+                return _renderTarget;
+            }
+
+            void
+            configureViewport(const uint x, const uint y, const uint width, const uint height);
+
+            void
+            clear(uint          clearFlags,
+                  float         red     = 0.f,
+                  float         green   = 0.f,
+                  float         blue    = 0.f,
+                  float         alpha   = 0.f,
+                  float         depth   = 1.f,
+                  unsigned int  stencil = 0,
+                  unsigned int  mask    = 0xffffffff);
+
+            void
+            drawTriangles(const uint indexBuffer, const uint firstIndex, const int numTriangles);
+
+            void
+            drawTriangles(const uint firstIndex, const int numTriangles);
+
+            void
+            setProgram(const uint program);
+
+            void
+            setRenderToBackBuffer();
+
+            void
+            setRenderToTexture(unsigned int texture, bool enableDepthAndStencil = false);
+
+            void
+            setUniformFloat(uint location, uint count, const float* v);
+
+            void
+            setUniformFloat2(uint location, uint count, const float* v);
+
+            void
+            setUniformFloat3(uint location, uint count, const float* v);
+
+            void
+            setUniformFloat4(uint location, uint count, const float* v);
+
+            void
+            setUniformMatrix4x4(uint location, uint count, const float* v);
+
+            void
+            setUniformInt(uint location, uint count, const int* v);
+
+            void
+            setUniformInt2(uint location, uint count, const int* v);
+
+            void
+            setUniformInt3(uint location, uint count, const int* v);
+
+            void
+            setUniformInt4(uint location, uint count, const int* v);
+
+            void
+            setTextureAt(uint position, int texture = 0, int location = -1);
+
+            void
+            setSamplerStateAt(uint position, WrapMode wrapping, TextureFilter filtering, MipFilter mipFiltering);
+
+            void
+            setVertexBufferAt(const uint                    position,
+                              const uint                    vertexBuffer,
+                              const uint                    size,
+                              const uint                    stride,
+                              const uint                    offset,
+                              const VertexAttribute::Format format);
+
+            void
+            setVertexAttributeArray(const uint vertexArray);
+
+            /*
+            ** Binds the vertex attributes of drawCall when the list is submitted, creating its
+            ** vertex attribute array if needed. drawCall must outlive the submission.
+            */
+            void
+            bindVertexAttributes(DrawCall* drawCall);
+
+            void
+            setBlendingMode(Blending::Source source, Blending::Destination destination);
+
+            void
+            setColorMask(bool colorMask);
+
+            void
+            setDepthTest(bool depthMask, CompareMode depthFunc);
+
+            void
+            setStencilTest(CompareMode      stencilFunc,
+                           int              stencilRef,
+                           uint             stencilMask,
+                           StencilOperation stencilFailOp,
+                           StencilOperation stencilZFailOp,
+                           StencilOperation stencilZPassOp);
+
+            void
+            setScissorTest(bool scissorTest, const math::ivec4& scissorBox);
+
+            void
+            setTriangleCulling(TriangleCulling triangleCulling);
+
+        private:
+            CommandList();
+
+            template <typename T>
+            inline
+            void
+            write(const T& value)
+            {
+                auto position = _buffer.size();
+
+                _buffer.resize(position + sizeof(T));
+                std::memcpy(&_buffer[position], &value, sizeof(T));
+            }
+
+            void
+            writeCommand(Command command);
+
+            void
+            writeUniform(Command command, uint location, uint count, const void* data, uint size);
+        };
+    }
+}
@@ -72,6 +72,7 @@ namespace minko
                 const uint size;
                 const uint* stride;
                 const uint offset;
+                const VertexAttribute::Format format;
             };
 
             typedef std::shared_ptr<AbstractContext>	            AbsCtxPtr;
@@ -93,6 +94,7 @@ namespace minko
             EffectVariables                		_variables;
 
 			std::shared_ptr<Program>			_program;
+            std::shared_ptr<DrawCallTemplate>   _template;
             const int*							_indexBuffer;
             const uint*                         _firstIndex;
             const uint*							_numIndices;
@@ -177,6 +179,13 @@ namespace minko
                 return _program;
             }
 
+            inline
+            std::shared_ptr<DrawCallTemplate>
+            drawCallTemplate() const
+            {
+                return _template;
+            }
+
             inline
             EffectVariables&
             variables()
@@ -369,8 +378,10 @@ namespace minko
 				return _numIndices ? *_numIndices / 3 : 0;
 			}
 
+            // drawCallTemplate, if any, must have been created for the pass, the program and the
+            // variable names of this draw call.
             void
-            bind(std::shared_ptr<Program> program);
+            bind(std::shared_ptr<Program> program, std::shared_ptr<DrawCallTemplate> drawCallTemplate = nullptr);
 
 			void
 			render(std::shared_ptr<AbstractContext>  context,
@@ -378,6 +389,19 @@ namespace minko
 				   const math::ivec4&				 viewport,
 				   uint 							 clearColor);
 
+            // Same as render() but appends the calls to commandList instead of issuing them, so
+            // that it can run on a worker thread.
+            void
+            record(CommandList&                      commandList,
+                   AbsTexturePtr                     renderTarget,
+                   const math::ivec4&                viewport,
+                   uint                              clearColor);
+
+            // Binds the vertex buffers of the draw call, creating its vertex attribute array the
+            // first time.
+            void
+            bindVertexAttributes(AbstractContext& context);
+
             void
             bindAttribute(ConstAttrInputRef     						        input,
 						  const std::unordered_map<std::string, data::Binding>& attributeBindings,
@@ -424,6 +448,16 @@ namespace minko
             void
             reset();
 
+            template <typename Context>
+            void
+            issue(Context&              context,
+                  AbsTexturePtr         renderTarget,
+                  const math::ivec4&    viewport,
+                  uint                  clearColor);
+
+            void
+            bindVertexAttributes(CommandList& commandList);
+
             data::Store&
             getStore(data::Binding::Source source);
 
@@ -431,6 +465,9 @@ namespace minko
             resolveBinding(const std::string&          					            inputName,
                            const std::unordered_map<std::string, data::Binding>&    bindings);
 
+            std::string
+            actualPropertyName(const std::string& propertyName);
+
 			void
 			setUniformValueFromStore(const ProgramInputs::UniformInput&   input,
 									 const std::string&                   propertyName,
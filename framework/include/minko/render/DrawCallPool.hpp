@@ -117,6 +117,8 @@ namespace minko
 
 			PropertyRebindFuncMap* 			_drawCallToPropRebindFuncs;
 
+            std::unordered_map<std::string, std::shared_ptr<DrawCallTemplate>> _drawCallTemplates;
+
 		public:
             DrawCallPool();
 
@@ -152,6 +154,13 @@ namespace minko
             unsigned int
             numDrawCalls() const;
 
+            inline
+            unsigned int
+            numDrawCallTemplates() const
+            {
+                return static_cast<unsigned int>(_drawCallTemplates.size());
+            }
+
         private:
             void
             watchProgramSignature(DrawCall&                     drawCall,
@@ -234,6 +243,17 @@ namespace minko
 			void
 			unbindDrawCall(DrawCall& drawCall);
 
+            std::shared_ptr<DrawCallTemplate>
+            drawCallTemplate(std::shared_ptr<Pass>      pass,
+                             std::shared_ptr<Program>   program,
+                             const EffectVariables&     variables);
+
+            static
+            bool
+            bindsProperty(const std::vector<PropertyName>&  propertyNames,
+                          const EffectVariables&            variables,
+                          const std::string&                propertyName);
+
             static
             bool
             compareZSortedDrawCalls(DrawCall* a, DrawCall* b);
@@ -0,0 +1,159 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/data/Binding.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        /*
+        ** Binding resolution shared by all the draw calls of a pass using the same program and the
+        ** same effect variable names. The first draw call resolves each of its inputs against the
+        ** bindings of the pass; the next ones reuse that work and only substitute the values of
+        ** their own variables before looking the properties up in their own stores.
+        */
+        class DrawCallTemplate
+        {
+        public:
+            typedef std::shared_ptr<DrawCallTemplate>                   Ptr;
+
+        private:
+            typedef std::unordered_map<std::string, data::Binding>      BindingMap;
+
+        public:
+            // Property name with at most one effect variable, split around that variable.
+            struct PropertyNamePlan
+            {
+                static const int    NO_VARIABLE;
+                static const int    UNSUPPORTED;
+
+                std::string         propertyName;
+                std::string         prefix;
+                std::string         suffix;
+                int                 variable;
+            };
+
+            struct BoundInput
+            {
+                const data::Binding*    binding;
+                const PropertyNamePlan* plan;
+                std::string             collectionSuffix;
+            };
+
+        private:
+            std::shared_ptr<Pass>                                                   _pass;
+            std::shared_ptr<Program>                                                _program;
+            std::vector<Flyweight<std::string>>                                     _variableNames;
+            std::string                                                             _key;
+
+            std::unordered_map<std::string, std::unique_ptr<PropertyNamePlan>>      _plans;
+            std::vector<std::pair<const BindingMap*, std::unordered_map<std::string, BoundInput>>>  _inputs;
+
+            uint                                                                    _numDrawCalls;
+
+        public:
+            inline static
+            Ptr
+            create(std::shared_ptr<Pass>        pass,
+                   std::shared_ptr<Program>     program,
+                   const EffectVariables&       variables)
+            {
+                return Ptr(new DrawCallTemplate(pass, program, variables));
+            }
+
+            // Key of the template the draw calls of pass, program and variables share.
+            static
+            std::string
+            key(std::shared_ptr<Pass> pass, std::shared_ptr<Program> program, const EffectVariables& variables);
+
+            // Binding of inputName, if any, and the suffix to append to its property name when the
+            // input is a field of a collection.
+            static
+            const data::Binding*
+            findBinding(const std::string& inputName, const BindingMap& bindings, std::string& collectionSuffix);
+
+            // Key this template was created for.
+            inline
+            const std::string&
+            key() const
+            {
+                return _key;
+            }
+
+            inline
+            std::shared_ptr<Pass>
+            pass() const
+            {
+                return _pass;
+            }
+
+            inline
+            std::shared_ptr<Program>
+            program() const
+            {
+                return _program;
+            }
+
+            inline
+            uint
+            numDrawCalls() const
+            {
+                return _numDrawCalls;
+            }
+
+            inline
+            void
+            drawCallBound()
+            {
+                ++_numDrawCalls;
+            }
+
+            // Returns the number of draw calls still bound to the template.
+            inline
+            uint
+            drawCallUnbound()
+            {
+                return --_numDrawCalls;
+            }
+
+            const BoundInput&
+            input(const BindingMap& bindings, const std::string& inputName);
+
+            const PropertyNamePlan&
+            plan(const std::string& propertyName);
+
+            // Same as data::Store::getActualPropertyName(variables, plan.propertyName).
+            std::string
+            propertyName(const PropertyNamePlan& plan, const EffectVariables& variables) const;
+
+            std::string
+            propertyName(const BoundInput& input, const EffectVariables& variables) const;
+
+        private:
+            DrawCallTemplate(std::shared_ptr<Pass>      pass,
+                             std::shared_ptr<Program>   program,
+                             const EffectVariables&     variables);
+        };
+    }
+}
@@ -39,6 +39,7 @@ namespace minko
 
 		private:
 			typedef std::shared_ptr<Pass>										PassPtr;
+			typedef std::shared_ptr<RenderGraph>								RenderGraphPtr;
 			typedef std::shared_ptr<VertexBuffer>								VertexBufferPtr;
 			typedef std::shared_ptr<std::function<void(PassPtr)>>				OnPassFunctionPtr;
 			typedef std::list<std::function<void(PassPtr)>>						OnPassFunctionList;
@@ -51,6 +52,7 @@ namespace minko
 			std::unordered_map<std::string, Technique>		_techniques;
 			std::unordered_map<std::string, std::string>	_fallback;
 			std::shared_ptr<data::Provider>					_data;
+			std::unordered_map<std::string, RenderGraphPtr>	_renderGraphs;
 
 			OnPassFunctionList								_uniformFunctions;
 			OnPassFunctionList								_attributeFunctions;
@@ -132,6 +134,25 @@ namespace minko
 				return _techniques.count(techniqueName) != 0;
 			}
 
+			/*
+			** Render graph holding the transient targets of a technique, if it declares any.
+			*/
+			inline
+			RenderGraphPtr
+			renderGraph(const std::string& techniqueName) const
+			{
+				auto renderGraphIt = _renderGraphs.find(techniqueName);
+
+				return renderGraphIt != _renderGraphs.end() ? renderGraphIt->second : nullptr;
+			}
+
+			inline
+			void
+			renderGraph(const std::string& techniqueName, RenderGraphPtr renderGraph)
+			{
+				_renderGraphs[techniqueName] = renderGraph;
+			}
+
 			inline
 			bool
 			hasFallback(const std::string& techniqueName) const
@@ -0,0 +1,97 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        /*
+        ** Separable resampling of RGBA8 images. Each axis is filtered with precomputed weights, the
+        ** filter footprint being widened when minifying so that no source pixel is skipped. Rows are
+        ** processed in parallel and the inner loops use SSE or NEON when available.
+        **
+        ** When a gamma other than 1 is given, color channels are decoded to linear space before
+        ** filtering and encoded back afterwards, like TextureWriter::gammaDecode/gammaEncode do.
+        ** Alpha is always filtered linearly.
+        */
+        class ImageResampler
+        {
+        public:
+            enum class Filter
+            {
+                NEAREST,
+                BILINEAR,
+                BOX,
+                LANCZOS,
+                KAISER
+            };
+
+        private:
+            struct Contributors;
+
+        public:
+            static
+            void
+            resample(const unsigned char*   data,
+                     unsigned int           width,
+                     unsigned int           height,
+                     unsigned char*         newData,
+                     unsigned int           newWidth,
+                     unsigned int           newHeight,
+                     Filter                 filter      = Filter::BOX,
+                     float                  gamma       = 1.f,
+                     unsigned int           numThreads  = 0u);
+
+            /*
+            ** Fills mipMapChain with every level of the mipmap chain of an image, from the image
+            ** itself down to 1x1, each level being filtered from the previous one.
+            */
+            static
+            void
+            mipMapChain(const unsigned char*        data,
+                        unsigned int                width,
+                        unsigned int                height,
+                        std::vector<unsigned char>& mipMapChain,
+                        Filter                      filter      = Filter::BOX,
+                        float                       gamma       = 1.f,
+                        unsigned int                numThreads  = 0u);
+
+            static
+            unsigned int
+            defaultNumThreads();
+
+        private:
+            static
+            void
+            computeContributors(unsigned int size, unsigned int newSize, Filter filter, Contributors& contributors);
+
+            static
+            float
+            filterSupport(Filter filter);
+
+            static
+            float
+            filterWeight(Filter filter, float x);
+        };
+    }
+}
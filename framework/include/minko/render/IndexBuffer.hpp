@@ -127,6 +127,16 @@ namespace minko
 				return _numIndices;
 			}
 
+            /**
+             * Size in bytes of a single index: 2 for 16-bit buffers, 4 for 32-bit ones.
+             */
+            inline
+            unsigned int
+            indexSize() const
+            {
+                return dataPointer<unsigned int>() != nullptr ? sizeof(unsigned int) : sizeof(unsigned short);
+            }
+
 			inline
 			void
 			upload()
@@ -140,6 +150,16 @@ namespace minko
 			void
 			upload(uint offset, int count, const std::vector<unsigned short>& data);
 
+			void
+			upload(uint offset, int count, const std::vector<unsigned int>& data);
+
+			/*
+			** Replaces the GPU storage of the buffer by an undefined one, to be called right before
+			** uploading the whole buffer again. See AbstractContext::orphanIndexBuffer().
+			*/
+			void
+			orphan();
+
 			void
 			dispose();
 
@@ -161,6 +181,16 @@ namespace minko
 				return _changed;
 			}
 
+		private:
+            // dataOffset is the first index read from data: the internal data is uploaded from
+            // offset, external vectors only hold the indices to write at offset
+            template <typename T>
+            bool
+            uploadData(uint offset, int count, const std::vector<T>& data, uint dataOffset);
+
+            bool
+            demoteToUnsignedShort();
+
 		protected:
 			inline
 			IndexBuffer(AbsContextPtr context) :
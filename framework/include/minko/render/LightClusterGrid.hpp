@@ -0,0 +1,237 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <mutex>
+#include <condition_variable>
+
+namespace minko
+{
+	namespace render
+	{
+        /*
+        ** Assigns spherical light volumes to a view-space grid of clusters: the screen is split in
+        ** numClustersX * numClustersY tiles and the view depth in numClustersZ exponential slices.
+        ** The result is a list of light indices per cluster, stored contiguously in lightIndices()
+        ** and addressed with clusterOffsets()/clusterCounts(). No GPU resource is involved.
+        */
+		class LightClusterGrid :
+			public std::enable_shared_from_this<LightClusterGrid>
+		{
+		public:
+			typedef std::shared_ptr<LightClusterGrid> Ptr;
+
+		private:
+			uint				_numClustersX;
+			uint				_numClustersY;
+			uint				_numClustersZ;
+			uint				_maxLightsPerCluster;
+			uint				_numThreads;
+
+			float				_zNear;
+			float				_zFar;
+
+			// per-slice cluster bounds, stored as structures of arrays
+			std::vector<float>	_columnMin;
+			std::vector<float>	_columnMax;
+			std::vector<float>	_rowMin;
+			std::vector<float>	_rowMax;
+			std::vector<float>	_sliceMin;
+			std::vector<float>	_sliceMax;
+
+			std::vector<uint>	_binnedLights;
+			std::vector<uint>	_clusterOffsets;
+			std::vector<uint>	_clusterCounts;
+			std::vector<uint>	_lightIndices;
+			uint				_numDroppedLights;
+
+			// persistent binning workers: worker i bins the i-th range of depth slices of a job
+			std::vector<std::thread>			_workers;
+			std::mutex							_workMutex;
+			std::condition_variable				_workCondition;
+			std::condition_variable				_workDoneCondition;
+			bool								_terminating;
+			uint								_jobId;
+			uint								_jobNumRanges;
+			uint								_jobNumPendingRanges;
+			const std::vector<math::vec4>*		_jobSpheres;
+			std::vector<uint>					_jobNumDroppedLights;
+
+		public:
+			inline static
+			Ptr
+			create(uint numClustersX = 16, uint numClustersY = 8, uint numClustersZ = 24)
+			{
+				return std::shared_ptr<LightClusterGrid>(new LightClusterGrid(
+					numClustersX,
+					numClustersY,
+					numClustersZ
+				));
+			}
+
+			inline
+			uint
+			numClustersX() const
+			{
+				return _numClustersX;
+			}
+
+			inline
+			uint
+			numClustersY() const
+			{
+				return _numClustersY;
+			}
+
+			inline
+			uint
+			numClustersZ() const
+			{
+				return _numClustersZ;
+			}
+
+			inline
+			uint
+			numClusters() const
+			{
+				return _numClustersX * _numClustersY * _numClustersZ;
+			}
+
+			inline
+			uint
+			maxLightsPerCluster() const
+			{
+				return _maxLightsPerCluster;
+			}
+
+			Ptr
+			maxLightsPerCluster(uint value);
+
+			inline
+			uint
+			numThreads() const
+			{
+				return _numThreads;
+			}
+
+			inline
+			Ptr
+			numThreads(uint value)
+			{
+				_numThreads = std::max(1u, value);
+
+				return shared_from_this();
+			}
+
+			inline
+			float
+			zNear() const
+			{
+				return _zNear;
+			}
+
+			inline
+			float
+			zFar() const
+			{
+				return _zFar;
+			}
+
+			inline
+			uint
+			clusterIndex(uint x, uint y, uint z) const
+			{
+				return (z * _numClustersY + y) * _numClustersX + x;
+			}
+
+			inline
+			const std::vector<uint>&
+			clusterOffsets() const
+			{
+				return _clusterOffsets;
+			}
+
+			inline
+			const std::vector<uint>&
+			clusterCounts() const
+			{
+				return _clusterCounts;
+			}
+
+			inline
+			const std::vector<uint>&
+			lightIndices() const
+			{
+				return _lightIndices;
+			}
+
+			/*
+			** Number of (light, cluster) pairs ignored during the last call to bin() because a
+			** cluster already referenced maxLightsPerCluster() lights.
+			*/
+			inline
+			uint
+			numDroppedLights() const
+			{
+				return _numDroppedLights;
+			}
+
+			/*
+			** Rebuilds the view-space bounds of the clusters from the camera projection matrix.
+			*/
+			Ptr
+			projection(const math::mat4& projection);
+
+			/*
+			** Returns the depth slice containing the specified (positive) view depth.
+			*/
+			uint
+			slice(float depth) const;
+
+			void
+			clusterBounds(uint x, uint y, uint z, math::vec3& min, math::vec3& max) const;
+
+			/*
+			** Bins light spheres expressed in view space: xyz is the center and w the radius.
+			*/
+			void
+			bin(const std::vector<math::vec4>& viewSpaceSpheres);
+
+			~LightClusterGrid();
+
+		private:
+			LightClusterGrid(uint numClustersX, uint numClustersY, uint numClustersZ);
+
+			void
+			updateClusterBounds(const math::mat4& projection);
+
+			uint
+			binSlices(const std::vector<math::vec4>& viewSpaceSpheres, uint firstSlice, uint lastSlice);
+
+			uint
+			binRange(const std::vector<math::vec4>& viewSpaceSpheres, uint range, uint numRanges);
+
+			void
+			workerLoop(uint range, uint jobId);
+		};
+	}
+}
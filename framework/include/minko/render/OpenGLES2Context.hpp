@@ -90,6 +90,7 @@ namespace minko
 			std::vector<int>		                _currentVertexSize;
 			std::vector<int>		                _currentVertexStride;
 			std::vector<int>		                _currentVertexOffset;
+			std::vector<VertexAttribute::Format>	_currentVertexFormat;
 			uint									_currentBoundTexture;
 			std::vector<int>		                _currentTexture;
             std::unordered_map<uint, WrapMode>      _currentWrapMode;
@@ -112,6 +113,9 @@ namespace minko
 
 			int										_stencilBits;
 
+			std::unordered_map<uint, uint>			_indexBufferIndexSizes;
+			bool									_supportsUnsignedIntIndices;
+
 		public:
 			~OpenGLES2Context();
 
@@ -209,27 +213,48 @@ namespace minko
 							  const uint	size,
 							  const uint	stride,
 							  const uint	offset) override;
+
+			void
+			setVertexBufferAt(const uint					position,
+							  const uint					vertexBuffer,
+							  const uint					size,
+							  const uint					stride,
+							  const uint					offset,
+							  const VertexAttribute::Format	format) override;
+
 			void
 			uploadVertexBufferData(const uint 	vertexBuffer,
 								   const uint 	offset,
 								   const uint 	size,
 								   void* 		data) override;
 
+			void
+			orphanVertexBuffer(const uint vertexBuffer, const uint size) override;
+
 			void
 			deleteVertexBuffer(const uint vertexBuffer) override;
 
 			const uint
 			createIndexBuffer(const uint size) override;
 
+			const uint
+			createIndexBuffer(const uint size, const uint indexSize) override;
+
 			void
 			uploadIndexBufferData(const uint 	indexBuffer,
 							      const uint 	offset,
 							      const uint 	size,
 							      void*		    data) override;
 
+			void
+			orphanIndexBuffer(const uint indexBuffer, const uint size) override;
+
 			void
 			deleteIndexBuffer(const uint indexBuffer) override;
 
+            bool
+            supportsUnsignedIntIndices() override;
+
 			uint
 			createTexture(TextureType	type,
 						  uint  width,
@@ -0,0 +1,570 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/ProgramInputs.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        /*
+        ** Records every call into a compact binary log, each command being stamped with the number
+        ** of microseconds elapsed since the log was started. The log can be replayed into another
+        ** context with replay().
+        ** Created without a context, it never touches GL: the resource ids are allocated locally and
+        ** the program inputs are found by scanning the GLSL sources, keeping only the inputs that are
+        ** used in the code enabled by the preprocessor. Created with a context, the calls are also
+        ** forwarded to it and the queries are answered by it.
+        ** The counters report what the framework asks for, redundant calls included, so they do not
+        ** depend on the state caching of the actual context.
+        */
+        class RecordingContext :
+            public AbstractContext
+        {
+        public:
+            typedef std::shared_ptr<RecordingContext>   Ptr;
+
+            typedef std::function<ProgramInputs(const std::string&, const std::string&)>   ProgramInputsFunction;
+
+            enum class Command : unsigned char
+            {
+                CLEAR,
+                PRESENT,
+                CONFIGURE_VIEWPORT,
+                DRAW_TRIANGLES,
+                DRAW_INDEXED_TRIANGLES,
+                CREATE_VERTEX_BUFFER,
+                SET_VERTEX_BUFFER_AT,
+                UPLOAD_VERTEX_BUFFER_DATA,
+                DELETE_VERTEX_BUFFER,
+                CREATE_INDEX_BUFFER,
+                UPLOAD_INDEX_BUFFER_DATA,
+                DELETE_INDEX_BUFFER,
+                CREATE_TEXTURE,
+                CREATE_RECTANGLE_TEXTURE,
+                CREATE_COMPRESSED_TEXTURE,
+                UPLOAD_TEXTURE_2D_DATA,
+                UPLOAD_CUBE_TEXTURE_DATA,
+                UPLOAD_COMPRESSED_TEXTURE_2D_DATA,
+                UPLOAD_COMPRESSED_CUBE_TEXTURE_DATA,
+                ACTIVATE_MIPMAPPING,
+                GENERATE_MIPMAPS,
+                DELETE_TEXTURE,
+                SET_TEXTURE_AT,
+                SET_SAMPLER_STATE_AT,
+                CREATE_PROGRAM,
+                ATTACH_SHADER,
+                LINK_PROGRAM,
+                PROGRAM_INPUTS,
+                SET_PROGRAM,
+                DELETE_PROGRAM,
+                CREATE_VERTEX_SHADER,
+                CREATE_FRAGMENT_SHADER,
+                SET_SHADER_SOURCE,
+                COMPILE_SHADER,
+                DELETE_VERTEX_SHADER,
+                DELETE_FRAGMENT_SHADER,
+                SET_BLENDING_FACTORS,
+                SET_BLENDING_MODE,
+                SET_COLOR_MASK,
+                SET_DEPTH_TEST,
+                SET_STENCIL_TEST,
+                SET_SCISSOR_TEST,
+                SET_TRIANGLE_CULLING,
+                SET_RENDER_TO_BACK_BUFFER,
+                SET_RENDER_TO_TEXTURE,
+                READ_PIXELS,
+                SET_UNIFORM_FLOAT,
+                SET_UNIFORM_FLOAT2,
+                SET_UNIFORM_FLOAT3,
+                SET_UNIFORM_FLOAT4,
+                SET_UNIFORM_MATRIX4X4,
+                SET_UNIFORM_INT,
+                SET_UNIFORM_INT2,
+                SET_UNIFORM_INT3,
+                SET_UNIFORM_INT4,
+                CREATE_VERTEX_ATTRIBUTE_ARRAY,
+                SET_VERTEX_ATTRIBUTE_ARRAY,
+                DELETE_VERTEX_ATTRIBUTE_ARRAY,
+                ORPHAN_VERTEX_BUFFER,
+                ORPHAN_INDEX_BUFFER,
+
+                NUM_COMMANDS
+            };
+
+            struct Counters
+            {
+                uint        numCommands;
+                uint        numDrawCalls;
+                uint        numTriangles;
+                uint        numProgramChanges;
+                uint        numRedundantProgramChanges;
+                uint        numTextureBinds;
+                uint        numRedundantTextureBinds;
+                uint        numVertexBufferBinds;
+                uint        numRedundantVertexBufferBinds;
+                uint        numUniformUpdates;
+                uint        numRedundantUniformUpdates;
+                uint        numStateChanges;
+                uint        numRedundantStateChanges;
+                std::size_t numUploadedBytes;
+
+                Counters();
+            };
+
+        private:
+            typedef std::chrono::steady_clock                               Clock;
+            typedef std::vector<unsigned char>                              Bytes;
+
+            struct VertexBufferBinding
+            {
+                uint                    vertexBuffer;
+                uint                    size;
+                uint                    stride;
+                uint                    offset;
+                VertexAttribute::Format format;
+            };
+
+            static const uint                                               LOG_MAGIC;
+            static const uint                                               LOG_VERSION;
+
+            AbstractContext::Ptr                                            _context;
+
+            Bytes                                                           _log;
+            Bytes                                                           _arguments;
+            Command                                                         _command;
+            Clock::time_point                                               _startTime;
+            bool                                                            _recording;
+
+            Counters                                                        _counters;
+            std::array<Bytes, static_cast<uint>(Command::NUM_COMMANDS)>     _states;
+            std::unordered_map<uint64_t, Bytes>                             _uniforms;
+            std::unordered_map<uint, int>                                   _textures;
+            std::unordered_map<uint, VertexBufferBinding>                   _vertexBufferBindings;
+            std::unordered_map<uint, uint>                                  _indexSizes;
+
+            bool                                                            _errorsEnabled;
+            uint                                                            _nextResourceId;
+            uint                                                            _currentProgram;
+            uint                                                            _renderTarget;
+            uint                                                            _viewportWidth;
+            uint                                                            _viewportHeight;
+            std::unordered_map<uint, std::string>                           _shaderSources;
+            std::unordered_set<uint>                                        _vertexShaders;
+            std::unordered_map<uint, std::vector<uint>>                     _programShaders;
+            ProgramInputsFunction                                           _programInputsFunction;
+
+        public:
+            ~RecordingContext()
+            {
+            }
+
+            inline static
+            Ptr
+            create(AbstractContext::Ptr context = nullptr)
+            {
+                return Ptr(new RecordingContext(context));
+            }
+
+            inline
+            AbstractContext::Ptr
+            context() const
+            {
+                return _context;
+            }
+
+            /*
+            ** The recorded commands, preceded by a header identifying the format.
+            */
+            inline
+            const std::vector<unsigned char>&
+            log() const
+            {
+                return _log;
+            }
+
+            /*
+            ** Empties the log and restarts its clock. Resources created before are unknown to a
+            ** replay of the new log: clear the log before the scene is loaded to be able to replay it.
+            */
+            void
+            clearLog();
+
+            inline
+            bool
+            recording() const
+            {
+                return _recording;
+            }
+
+            /*
+            ** Stops or resumes appending commands to the log. The counters are always updated.
+            */
+            inline
+            void
+            recording(bool recording)
+            {
+                _recording = recording;
+            }
+
+            inline
+            const Counters&
+            counters() const
+            {
+                return _counters;
+            }
+
+            inline
+            void
+            resetCounters()
+            {
+                _counters = Counters();
+            }
+
+            /*
+            ** Overrides how the program inputs are found when there is no context to query. The
+            ** function receives the vertex and fragment shader sources of the program.
+            */
+            inline
+            void
+            programInputsFunction(const ProgramInputsFunction& function)
+            {
+                _programInputsFunction = function;
+            }
+
+            /*
+            ** Executes the commands of log on context. Resource ids and program input locations are
+            ** translated to the ones of context, which must support the same features as the context
+            ** the log was recorded with.
+            */
+            static
+            void
+            replay(const std::vector<unsigned char>& log, AbstractContext::Ptr context);
+
+            /*
+            ** Finds the inputs of a program by scanning its GLSL sources.
+            */
+            static
+            ProgramInputs
+            scanProgramInputs(const std::string& vertexShaderSource, const std::string& fragmentShaderSource);
+
+            bool
+            errorsEnabled() override;
+
+            void
+            errorsEnabled(bool errorsEnabled) override;
+
+            const std::string&
+            driverInfo() override;
+
+            uint
+            renderTarget() override;
+
+            uint
+            viewportWidth() override;
+
+            uint
+            viewportHeight() override;
+
+            uint
+            currentProgram() override;
+
+            void
+            configureViewport(const uint x, const uint y, const uint width, const uint height) override;
+
+            void
+            clear(uint          clearFlags  = ClearFlags::COLOR | ClearFlags::DEPTH | ClearFlags::STENCIL,
+                  float         red         = 0.f,
+                  float         green       = 0.f,
+                  float         blue        = 0.f,
+                  float         alpha       = 0.f,
+                  float         depth       = 1.f,
+                  unsigned int  stencil     = 0,
+                  unsigned int  mask        = 0xffffffff) override;
+
+            void
+            present() override;
+
+            void
+            drawTriangles(const uint indexBuffer, const uint firstIndex, const int numTriangles) override;
+
+            void
+            drawTriangles(const uint firstIndex, const int numTriangles) override;
+
+            const uint
+            createVertexBuffer(const uint size) override;
+
+            void
+            setVertexBufferAt(const uint    position,
+                              const uint    vertexBuffer,
+                              const uint    size,
+                              const uint    stride,
+                              const uint    offset) override;
+
+            void
+            setVertexBufferAt(const uint                    position,
+                              const uint                    vertexBuffer,
+                              const uint                    size,
+                              const uint                    stride,
+                              const uint                    offset,
+                              const VertexAttribute::Format format) override;
+
+            void
+            uploadVertexBufferData(const uint vertexBuffer, const uint offset, const uint size, void* data) override;
+
+            void
+            orphanVertexBuffer(const uint vertexBuffer, const uint size) override;
+
+            void
+            deleteVertexBuffer(const uint vertexBuffer) override;
+
+            const uint
+            createIndexBuffer(const uint size) override;
+
+            const uint
+            createIndexBuffer(const uint size, const uint indexSize) override;
+
+            void
+            uploadIndexBufferData(const uint indexBuffer, const uint offset, const uint size, void* data) override;
+
+            void
+            orphanIndexBuffer(const uint indexBuffer, const uint size) override;
+
+            void
+            deleteIndexBuffer(const uint indexBuffer) override;
+
+            bool
+            supportsUnsignedIntIndices() override;
+
+            uint
+            createTexture(TextureType   type,
+                          unsigned int  width,
+                          unsigned int  height,
+                          bool          mipMapping,
+                          bool          optimizeForRenderToTexture = false) override;
+
+            uint
+            createRectangleTexture(TextureType type, unsigned int width, unsigned int height) override;
+
+            uint
+            createCompressedTexture(TextureType     type,
+                                    TextureFormat   format,
+                                    unsigned int    width,
+                                    unsigned int    height,
+                                    bool            mipMapping) override;
+
+            void
+            uploadTexture2dData(uint            texture,
+                                unsigned int    width,
+                                unsigned int    height,
+                                unsigned int    mipLevel,
+                                void*           data) override;
+
+            void
+            uploadCubeTextureData(uint                texture,
+                                  CubeTexture::Face   face,
+                                  unsigned int        width,
+                                  unsigned int        height,
+                                  unsigned int        mipLevel,
+                                  void*               data) override;
+
+            void
+            uploadCompressedTexture2dData(uint          texture,
+                                          TextureFormat format,
+                                          unsigned int  width,
+                                          unsigned int  height,
+                                          unsigned int  size,
+                                          unsigned int  mipLevel,
+                                          void*         data) override;
+
+            void
+            uploadCompressedCubeTextureData(uint                texture,
+                                            CubeTexture::Face   face,
+                                            TextureFormat       format,
+                                            unsigned int        width,
+                                            unsigned int        height,
+                                            unsigned int        mipLevel,
+                                            void*               data) override;
+
+            void
+            activateMipMapping(uint texture) override;
+
+            void
+            deleteTexture(uint texture) override;
+
+            void
+            setTextureAt(uint position, int texture = 0, int location = -1) override;
+
+            void
+            setSamplerStateAt(uint position, WrapMode wrapping, TextureFilter filtering, MipFilter mipFiltering) override;
+
+            const uint
+            createProgram() override;
+
+            void
+            attachShader(const uint program, const uint shader) override;
+
+            void
+            linkProgram(const uint program) override;
+
+            void
+            deleteProgram(const uint program) override;
+
+            void
+            setProgram(const uint program) override;
+
+            void
+            compileShader(const uint shader) override;
+
+            void
+            setShaderSource(const uint shader, const std::string& source) override;
+
+            const uint
+            createVertexShader() override;
+
+            void
+            deleteVertexShader(const uint vertexShader) override;
+
+            const uint
+            createFragmentShader() override;
+
+            void
+            deleteFragmentShader(const uint fragmentShader) override;
+
+            ProgramInputs
+            getProgramInputs(const uint program) override;
+
+            void
+            setBlendingMode(Blending::Source source, Blending::Destination destination) override;
+
+            void
+            setBlendingMode(Blending::Mode blendMode) override;
+
+            void
+            setColorMask(bool colorMask) override;
+
+            void
+            setDepthTest(bool depthMask, CompareMode depthFunc) override;
+
+            void
+            setStencilTest(CompareMode      stencilFunc,
+                           int              stencilRef,
+                           uint             stencilMask,
+                           StencilOperation stencilFailOp,
+                           StencilOperation stencilZFailOp,
+                           StencilOperation stencilZPassOp) override;
+
+            void
+            setScissorTest(bool scissorTest, const math::ivec4& scissorBox) override;
+
+            void
+            readPixels(unsigned char* pixels) override;
+
+            void
+            readPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels) override;
+
+            void
+            setTriangleCulling(TriangleCulling triangleCulling) override;
+
+            void
+            setRenderToBackBuffer() override;
+
+            void
+            setRenderToTexture(unsigned int texture, bool enableDepthAndStencil = false) override;
+
+            void
+            generateMipmaps(unsigned int texture) override;
+
+            void
+            setUniformFloat(uint location, uint count, const float* v) override;
+
+            void
+            setUniformFloat2(uint location, uint count, const float* v) override;
+
+            void
+            setUniformFloat3(uint location, uint count, const float* v) override;
+
+            void
+            setUniformFloat4(uint location, uint count, const float* v) override;
+
+            void
+            setUniformMatrix4x4(uint location, uint count, const float* v) override;
+
+            void
+            setUniformInt(uint location, uint count, const int* v) override;
+
+            void
+            setUniformInt2(uint location, uint count, const int* v) override;
+
+            void
+            setUniformInt3(uint location, uint count, const int* v) override;
+
+            void
+            setUniformInt4(uint location, uint count, const int* v) override;
+
+            int
+            createVertexAttributeArray() override;
+
+            void
+            setVertexAttributeArray(const uint vertexArray) override;
+
+            void
+            deleteVertexAttributeArray(const uint vertexArray) override;
+
+        private:
+            explicit
+            RecordingContext(AbstractContext::Ptr context);
+
+            void
+            begin(Command command);
+
+            template <typename T>
+            void
+            write(const T& value)
+            {
+                auto bytes = reinterpret_cast<const unsigned char*>(&value);
+
+                _arguments.insert(_arguments.end(), bytes, bytes + sizeof(T));
+            }
+
+            void
+            write(const std::string& value);
+
+            void
+            write(const void* data, std::size_t size);
+
+            void
+            end();
+
+            void
+            endState(Command state);
+
+            void
+            endUniform(uint location);
+
+            uint
+            nextResourceId();
+        };
+    }
+}
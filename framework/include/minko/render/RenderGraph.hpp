@@ -0,0 +1,192 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+        /*
+        ** Declarative description of a chain of passes and of the transient render targets they
+        ** read and write. compile() orders the passes according to their dependencies, culls the
+        ** passes whose results are never used and assigns the transient targets to as few physical
+        ** textures as possible: two targets with disjoint lifetimes and the same dimensions share the
+        ** same texture.
+        **
+        ** A read resolves to the last pass declared before the reader that writes the same target.
+        ** Writing anything but a declared transient target (the back buffer, a persistent texture)
+        ** is an external side effect: such passes are never culled.
+        */
+		class RenderGraph :
+			public std::enable_shared_from_this<RenderGraph>
+		{
+		public:
+			typedef std::shared_ptr<RenderGraph> Ptr;
+
+		private:
+			typedef std::shared_ptr<RenderTargetPool>	RenderTargetPoolPtr;
+			typedef std::shared_ptr<AbstractTexture>	AbstractTexturePtr;
+
+			struct Target
+			{
+				uint	width;
+				uint	height;
+				bool	isCube;
+				bool	output;
+				int		physicalTarget;
+			};
+
+			struct PassNode
+			{
+				std::string					name;
+				std::vector<std::string>	reads;
+				std::string					write;
+				std::vector<uint>			dependencies;
+				bool						culled;
+			};
+
+		private:
+			RenderTargetPoolPtr							_pool;
+
+			std::vector<PassNode>						_passes;
+			std::map<std::string, Target>				_targets;
+
+			std::vector<uint>							_order;
+			std::vector<AbstractTexturePtr>				_physicalTargets;
+			std::vector<uint>							_physicalTargetMemory;
+			uint										_transientMemory;
+
+		public:
+			inline static
+			Ptr
+			create(RenderTargetPoolPtr pool = nullptr)
+			{
+				return std::shared_ptr<RenderGraph>(new RenderGraph(pool));
+			}
+
+			~RenderGraph();
+
+			/*
+			** Declares a transient target.
+			*/
+			Ptr
+			target(const std::string& name, uint width, uint height, bool isCube = false);
+
+			/*
+			** Marks a transient target as a result of the graph: its content is expected to outlive the
+			** graph, so it is never aliased and the passes writing it are never culled.
+			*/
+			Ptr
+			output(const std::string& name);
+
+			/*
+			** Declares a pass, identified by its declaration index, that samples the targets in reads
+			** and renders into write.
+			*/
+			Ptr
+			pass(const std::string& name, const std::vector<std::string>& reads, const std::string& write = "");
+
+			inline
+			bool
+			hasTarget(const std::string& name) const
+			{
+				return _targets.count(name) != 0;
+			}
+
+			inline
+			uint
+			numPasses() const
+			{
+				return static_cast<uint>(_passes.size());
+			}
+
+			inline
+			const std::string&
+			passName(uint passId) const
+			{
+				return _passes.at(passId).name;
+			}
+
+			void
+			compile();
+
+			/*
+			** Indices of the passes that were not culled, in execution order.
+			*/
+			inline
+			const std::vector<uint>&
+			order() const
+			{
+				return _order;
+			}
+
+			inline
+			bool
+			culled(uint passId) const
+			{
+				return _passes.at(passId).culled;
+			}
+
+			inline
+			uint
+			numPhysicalTargets() const
+			{
+				return static_cast<uint>(_physicalTargetMemory.size());
+			}
+
+			/*
+			** Index of the physical texture assigned to a transient target, or -1 if no remaining pass
+			** uses it.
+			*/
+			int
+			physicalTarget(const std::string& name) const;
+
+			/*
+			** Texture acquired from the pool for a transient target, if the graph has a pool.
+			*/
+			AbstractTexturePtr
+			texture(const std::string& name) const;
+
+			/*
+			** Memory the transient targets would use if each had its own texture, in bytes.
+			*/
+			inline
+			uint
+			transientMemory() const
+			{
+				return _transientMemory;
+			}
+
+			/*
+			** Memory actually used by the physical textures, in bytes.
+			*/
+			uint
+			allocatedMemory() const;
+
+		private:
+			RenderGraph(RenderTargetPoolPtr pool);
+
+			void
+			releasePhysicalTargets();
+		};
+	}
+}
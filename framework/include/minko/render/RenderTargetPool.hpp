@@ -0,0 +1,112 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+        /*
+        ** Recycles render-to-texture targets: released textures are kept on the GPU and handed back
+        ** by acquire() for the next request with the same dimensions instead of being re-created.
+        */
+		class RenderTargetPool :
+			public std::enable_shared_from_this<RenderTargetPool>
+		{
+		public:
+			typedef std::shared_ptr<RenderTargetPool> Ptr;
+
+		private:
+			typedef std::shared_ptr<AbstractContext>	AbstractContextPtr;
+			typedef std::shared_ptr<AbstractTexture>	AbstractTexturePtr;
+			typedef std::tuple<uint, uint, bool>		TargetKey;
+
+		private:
+			AbstractContextPtr										_context;
+
+			std::map<TargetKey, std::list<AbstractTexturePtr>>		_free;
+			std::unordered_set<AbstractTexturePtr>					_used;
+
+			uint													_allocatedMemory;
+			uint													_usedMemory;
+
+		public:
+			inline static
+			Ptr
+			create(AbstractContextPtr context)
+			{
+				return std::shared_ptr<RenderTargetPool>(new RenderTargetPool(context));
+			}
+
+			~RenderTargetPool();
+
+			/*
+			** Total GPU memory held by the pool, in bytes, whether the targets are in use or not.
+			*/
+			inline
+			uint
+			allocatedMemory() const
+			{
+				return _allocatedMemory;
+			}
+
+			/*
+			** GPU memory of the targets currently acquired, in bytes.
+			*/
+			inline
+			uint
+			usedMemory() const
+			{
+				return _usedMemory;
+			}
+
+			inline
+			uint
+			numUsedTargets() const
+			{
+				return static_cast<uint>(_used.size());
+			}
+
+			uint
+			numFreeTargets() const;
+
+			AbstractTexturePtr
+			acquire(uint width, uint height, bool isCube = false);
+
+			void
+			release(AbstractTexturePtr target);
+
+			/*
+			** Disposes all the targets that are not currently acquired.
+			*/
+			void
+			clear();
+
+			static
+			uint
+			targetMemory(uint width, uint height, bool isCube);
+
+		private:
+			RenderTargetPool(AbstractContextPtr context);
+		};
+	}
+}
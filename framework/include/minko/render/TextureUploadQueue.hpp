@@ -0,0 +1,301 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/Signal.hpp"
+
+#include <mutex>
+#include <condition_variable>
+
+namespace minko
+{
+	namespace render
+	{
+        /*
+        ** Decodes textures on background threads and spreads their GPU uploads over several frames.
+        ** Uploads are performed by update() - called once per frame by the SceneManager - by decreasing
+        ** priority until either the per-frame byte budget or the per-frame time budget is exhausted.
+        */
+		class TextureUploadQueue :
+			public std::enable_shared_from_this<TextureUploadQueue>
+		{
+		public:
+			typedef std::shared_ptr<TextureUploadQueue> Ptr;
+
+			typedef std::function<uint(void)>          DecodeFunction;
+			typedef std::function<void(void)>          UploadFunction;
+
+		private:
+			typedef std::shared_ptr<AbstractTexture>	AbstractTexturePtr;
+
+			struct DecodeJob
+			{
+				DecodeFunction	decode;
+				UploadFunction	decoded;
+				UploadFunction	failed;
+				uint			numBytes;
+			};
+
+			struct UploadJob
+			{
+				AbstractTexturePtr	texture;
+				UploadFunction		upload;
+				uint				numBytes;
+				float				priority;
+				uint				order;
+
+				struct PriorityComparator
+				{
+					inline
+					bool
+					operator()(const UploadJob& left, const UploadJob& right) const
+					{
+						return left.priority != right.priority
+							? left.priority < right.priority
+							: left.order > right.order;
+					}
+				};
+			};
+
+		private:
+			static const uint                                       DEFAULT_MAX_UPLOADED_BYTES_PER_FRAME;
+			static const float                                      DEFAULT_MAX_UPLOAD_TIME_PER_FRAME;
+
+			uint										            _numDecodingThreads;
+			std::vector<std::thread>					            _decodingThreads;
+			std::mutex									            _decodingMutex;
+			std::condition_variable						            _decodingCondition;
+			std::list<DecodeJob>						            _decodeJobs;
+			std::list<DecodeJob>						            _decodedJobs;
+			uint                                                    _numPendingDecodes;
+			bool										            _terminating;
+
+			std::vector<UploadJob>						            _uploadJobs;
+			std::unordered_map<std::string, float>		            _priorities;
+			uint										            _nextUploadOrder;
+			bool                                                    _sortingNeeded;
+
+			uint										            _maxUploadedBytesPerFrame;
+			float										            _maxUploadTimePerFrame;
+
+			uint										            _numDecodedTextures;
+			uint64_t									            _numDecodedBytes;
+			uint										            _numUploadedTextures;
+			uint64_t									            _numUploadedBytes;
+			float										            _uploadTime;
+			uint										            _numUploadedBytesLastFrame;
+
+			Signal<Ptr, AbstractTexturePtr>::Ptr		            _textureUploaded;
+
+		public:
+			inline static
+			Ptr
+			create(uint numDecodingThreads = defaultNumDecodingThreads())
+			{
+				return std::shared_ptr<TextureUploadQueue>(new TextureUploadQueue(numDecodingThreads));
+			}
+
+			~TextureUploadQueue();
+
+			/*
+			** Maximum number of bytes uploaded to the GPU during a single frame. The first upload of
+			** each frame is always performed, even if it exceeds the budget on its own.
+			*/
+			inline
+			uint
+			maxUploadedBytesPerFrame() const
+			{
+				return _maxUploadedBytesPerFrame;
+			}
+
+			inline
+			Ptr
+			maxUploadedBytesPerFrame(uint value)
+			{
+				_maxUploadedBytesPerFrame = value;
+
+				return shared_from_this();
+			}
+
+			/*
+			** Maximum time spent uploading textures during a single frame, in milliseconds.
+			*/
+			inline
+			float
+			maxUploadTimePerFrame() const
+			{
+				return _maxUploadTimePerFrame;
+			}
+
+			inline
+			Ptr
+			maxUploadTimePerFrame(float value)
+			{
+				_maxUploadTimePerFrame = value;
+
+				return shared_from_this();
+			}
+
+			inline
+			uint
+			numDecodingThreads() const
+			{
+				return _numDecodingThreads;
+			}
+
+			inline
+			uint
+			numPendingDecodes() const
+			{
+				return _numPendingDecodes;
+			}
+
+			inline
+			uint
+			numPendingUploads() const
+			{
+				return static_cast<uint>(_uploadJobs.size());
+			}
+
+			inline
+			uint
+			numDecodedTextures() const
+			{
+				return _numDecodedTextures;
+			}
+
+			inline
+			uint64_t
+			numDecodedBytes() const
+			{
+				return _numDecodedBytes;
+			}
+
+			inline
+			uint
+			numUploadedTextures() const
+			{
+				return _numUploadedTextures;
+			}
+
+			inline
+			uint64_t
+			numUploadedBytes() const
+			{
+				return _numUploadedBytes;
+			}
+
+			inline
+			uint
+			numUploadedBytesLastFrame() const
+			{
+				return _numUploadedBytesLastFrame;
+			}
+
+			/*
+			** Total time spent in uploads, in milliseconds.
+			*/
+			inline
+			float
+			uploadTime() const
+			{
+				return _uploadTime;
+			}
+
+			inline
+			Signal<Ptr, AbstractTexturePtr>::Ptr
+			textureUploaded() const
+			{
+				return _textureUploaded;
+			}
+
+			/*
+			** Runs decode on a decoding thread, then decoded on the main thread during the next update().
+			** decode returns the number of bytes it decoded and must not touch the GPU nor any state
+			** shared with the main thread. failed is called instead of decoded if the queue is destroyed
+			** before the job completes.
+			*/
+			void
+			decode(DecodeFunction decode, UploadFunction decoded, UploadFunction failed = nullptr);
+
+			/*
+			** Queues the upload of the texture data with texture->upload().
+			*/
+			void
+			upload(AbstractTexturePtr texture);
+
+			/*
+			** Queues a custom upload of numBytes of data into texture, such as a single mip level.
+			*/
+			void
+			upload(AbstractTexturePtr texture, uint numBytes, UploadFunction upload);
+
+			float
+			priority(AbstractTexturePtr texture) const;
+
+			/*
+			** Sets the priority of all the current and future uploads into texture. Higher priorities
+			** are uploaded first, uploads of equal priority are performed in the order they were queued.
+			*/
+			void
+			priority(AbstractTexturePtr texture, float priority);
+
+			/*
+			** Forgets the pending uploads and the priority of texture.
+			*/
+			void
+			cancel(AbstractTexturePtr texture);
+
+			/*
+			** Completes the finished decodings and performs as many uploads as the budgets allow.
+			*/
+			void
+			update();
+
+			/*
+			** Waits for all the decodings and performs all the uploads regardless of the budgets.
+			*/
+			void
+			flush();
+
+			static
+			uint
+			defaultNumDecodingThreads();
+
+			static
+			uint
+			textureMemory(AbstractTexturePtr texture);
+
+		private:
+			TextureUploadQueue(uint numDecodingThreads);
+
+			void
+			decodingThreadLoop();
+
+			void
+			completeDecodedJobs();
+
+			void
+			uploadJob(const UploadJob& job);
+		};
+	}
+}
@@ -31,6 +31,19 @@ namespace minko
         public:
             using Type = uint32_t;
 
+            // Storage format of the attribute components once uploaded: every component is still exposed
+            // as a float on the CPU side (VertexBuffer::data()) and in shaders.
+            enum class Format
+            {
+                FLOAT,
+                HALF_FLOAT,
+                SHORT_NORMALIZED,
+                UNSIGNED_SHORT_NORMALIZED,
+                BYTE_NORMALIZED,
+                UNSIGNED_BYTE_NORMALIZED,
+                UNSIGNED_BYTE
+            };
+
         public:
             static const Type NONE;
             static const Type POSITION;
@@ -45,12 +58,43 @@ namespace minko
             Flyweight<std::string> name;
             uint size;
             uint offset;
+            Format format;
+            const uint* packedVertexSize;
+            uint packedOffset;
 
             bool
             operator==(const VertexAttribute& rhs) const
             {
                 return resourceId == rhs.resourceId && vertexSize == rhs.vertexSize && name == rhs.name
-                    && size == rhs.size && offset == rhs.offset;
+                    && size == rhs.size && offset == rhs.offset && format == rhs.format;
+            }
+
+            // Number of 32-bit words used by an attribute once packed, components are padded to keep
+            // every attribute 4-byte aligned.
+            static
+            uint
+            packedSize(Format format, uint size)
+            {
+                return (size * componentSize(format) + 3u) / 4u;
+            }
+
+            static
+            uint
+            componentSize(Format format)
+            {
+                switch (format)
+                {
+                case Format::HALF_FLOAT:
+                case Format::SHORT_NORMALIZED:
+                case Format::UNSIGNED_SHORT_NORMALIZED:
+                    return 2u;
+                case Format::BYTE_NORMALIZED:
+                case Format::UNSIGNED_BYTE_NORMALIZED:
+                case Format::UNSIGNED_BYTE:
+                    return 1u;
+                default:
+                    return 4u;
+                }
             }
         };
     }
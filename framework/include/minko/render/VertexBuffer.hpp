@@ -39,6 +39,8 @@ namespace minko
 			std::vector<float>					_data;
             std::list<VertexAttribute>		    _attributes;
 			uint								_vertexSize;
+			uint								_packedVertexSize;
+			bool								_isPacked;
 
 			std::shared_ptr<Signal<Ptr, int>>	_vertexSizeChanged;
 
@@ -121,6 +123,20 @@ namespace minko
 				return _vertexSize;
 			}
 
+			inline
+			uint
+			packedVertexSize() const
+			{
+				return _packedVertexSize;
+			}
+
+			inline
+			bool
+			isPacked() const
+			{
+				return _isPacked;
+			}
+
 			inline
 			std::shared_ptr<Signal<Ptr, int>>
 			vertexSizeChanged()
@@ -148,6 +164,16 @@ namespace minko
 			void
 			upload(uint offset, uint numVertices, const std::vector<float>& data);
 
+			void
+			uploadPacked(uint offset, uint numVertices, const std::vector<unsigned char>& packedData);
+
+			/*
+			** Replaces the GPU storage of the buffer by an undefined one, to be called right before
+			** uploading the whole buffer again. See AbstractContext::orphanVertexBuffer().
+			*/
+			void
+			orphan();
+
 			void
 			dispose();
 
@@ -155,7 +181,19 @@ namespace minko
             disposeData();
 
 			void
-			addAttribute(const std::string& name, const unsigned int size, const unsigned int offset = 0);
+			addAttribute(const std::string&			name,
+						 const unsigned int			size,
+						 const unsigned int			offset = 0,
+						 VertexAttribute::Format	format = VertexAttribute::Format::FLOAT);
+
+			void
+			attributeFormat(const std::string& attributeName, VertexAttribute::Format format);
+
+			void
+			pack(const float* vertices, uint numVertices, std::vector<unsigned char>& packedData) const;
+
+			void
+			unpack(const unsigned char* packedData, uint numVertices, float* vertices) const;
 
 			void
 			removeAttribute(const std::string& name);
@@ -190,6 +228,12 @@ namespace minko
 
 			void
 			vertexSize(unsigned int value);
+
+			void
+			updatePackedLayout();
+
+			void
+			uploadPackedWords(uint offset, uint numVertices, const unsigned char* packedData);
 		};
 	}
 }
@@ -24,6 +24,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Signal.hpp"
 #include "minko/scene/Layout.hpp"
 #include "minko/data/Store.hpp"
+#include "minko/component/AbstractComponent.hpp"
 
 namespace minko
 {
@@ -39,13 +40,60 @@ namespace minko
 		private:
 			typedef std::shared_ptr<component::AbstractComponent>	AbsCmpPtr;
 
+            /*
+            ** Each concrete component class gets a type id the first time an instance of it is
+            ** added to a node. A node keeps the set of the type ids of its components as a bit mask,
+            ** and for each queried type T a static cache records which type ids are (or are not)
+            ** compatible with T and the pointer adjustment to apply: after the first query of a
+            ** given (T, type id) pair, hasComponent<T>() and component<T>() no longer use RTTI.
+            ** Type ids above MAX_NUM_COMPONENT_TYPES - 1 share the last bit, which is never
+            ** considered resolved and falls back to checking each component with RTTI. The caches
+            ** can be queried from any thread.
+            */
+            static const uint                                       MAX_NUM_COMPONENT_TYPES = 128;
+
+            static const std::ptrdiff_t                             UNKNOWN_COMPONENT_OFFSET;
+            static const std::ptrdiff_t                             INCOMPATIBLE_COMPONENT_OFFSET;
+
+            typedef std::bitset<MAX_NUM_COMPONENT_TYPES>            ComponentTypeMask;
+
+            // filled by the first query of each (T, type id) pair, possibly from several threads at
+            // once: the fields are atomic and the resolved bit is published after the others
+            struct ComponentTypeCache
+            {
+                static const uint                                                       NUM_WORDS = MAX_NUM_COMPONENT_TYPES / 64;
+
+                std::array<std::atomic<uint64_t>, NUM_WORDS>                            resolvedWords;
+                std::array<std::atomic<uint64_t>, NUM_WORDS>                            compatibleWords;
+                std::array<std::atomic<std::ptrdiff_t>, MAX_NUM_COMPONENT_TYPES - 1>    offsets;
+
+                ComponentTypeCache();
+
+                ComponentTypeMask
+                resolved() const;
+
+                ComponentTypeMask
+                compatible() const;
+
+                void
+                resolve(uint typeId, std::ptrdiff_t offset);
+            };
+
+            // components of a whole scene by type id, owned by the root node
+            struct ComponentRegistry
+            {
+                std::vector<std::vector<AbsCmpPtr>> componentsByType;
+            };
+
 		private:
 			std::string 					_name;
 			std::vector<Ptr>				_children;
 			std::weak_ptr<Node> 			_root;
             std::weak_ptr<Node>				_parent;
 			data::Store                     _container;
-			std::list<AbsCmpPtr>			_components;
+			std::vector<AbsCmpPtr>			_components;
+            ComponentTypeMask               _componentTypes;
+            std::shared_ptr<ComponentRegistry>  _componentRegistry;
             Layout                          _layout;
 
 			Signal<Ptr, Ptr, Ptr>			_added;
@@ -53,6 +101,8 @@ namespace minko
 			Signal<Ptr, Ptr>				_layoutChanged;
 			Signal<Ptr, Ptr, AbsCmpPtr>		_componentAdded;
 			Signal<Ptr, Ptr, AbsCmpPtr>		_componentRemoved;
+            Signal<Ptr, const std::vector<AbsCmpPtr>&>  _componentsRegistered;
+            Signal<Ptr, const std::vector<AbsCmpPtr>&>  _componentsUnregistered;
 
             static bool _signalBubblingEnabled;
 
@@ -229,6 +279,24 @@ namespace minko
 				return _componentRemoved;
 			}
 
+            // Executed on a root node, once per addChild() or addComponent(), with all the components
+            // entering its subtree. Unlike componentAdded(), it does not depend on signal bubbling.
+            inline
+            Signal<Ptr, const std::vector<AbsCmpPtr>&>&
+            componentsRegistered()
+            {
+                return _componentsRegistered;
+            }
+
+            // Executed on a root node, once per removeChild() or removeComponent(), with all the
+            // components leaving its subtree. Components still have their target when it is executed.
+            inline
+            Signal<Ptr, const std::vector<AbsCmpPtr>&>&
+            componentsUnregistered()
+            {
+                return _componentsUnregistered;
+            }
+
 			Ptr
 			addChild(Ptr Node);
 
@@ -255,11 +323,21 @@ namespace minko
 			bool
 			hasComponent()
 			{
-				return component<T>() != nullptr;
+                auto& cache = componentTypeCache<T>();
+
+                if ((_componentTypes & ~cache.resolved()).none())
+                    return (_componentTypes & cache.compatible()).any();
+
+                for (const auto& component : _components)
+                    if (castComponent<T>(component))
+                        return true;
+
+                return false;
 			}
 
-            const std::list<AbsCmpPtr>
-            components()
+            inline
+            const std::vector<AbsCmpPtr>&
+            components() const
             {
                 return _components;
             }
@@ -270,9 +348,12 @@ namespace minko
 			{
 				std::vector<std::shared_ptr<T>> result;
 
-				for (auto component : _components)
+                if (!mayHaveComponent<T>())
+                    return result;
+
+				for (const auto& component : _components)
 				{
-					std::shared_ptr<T> typedComponent = std::dynamic_pointer_cast<T>(component);
+					auto typedComponent = castComponent<T>(component);
 
 					if (typedComponent != nullptr)
 						result.push_back(typedComponent);
@@ -287,9 +368,12 @@ namespace minko
 			{
 				unsigned int counter = 0;
 
-				for (auto component : _components)
+                if (!mayHaveComponent<T>())
+                    return nullptr;
+
+				for (const auto& component : _components)
 				{
-					std::shared_ptr<T> typedComponent = std::dynamic_pointer_cast<T>(component);
+					auto typedComponent = castComponent<T>(component);
 
 					if (typedComponent != nullptr)
 					{
@@ -303,6 +387,39 @@ namespace minko
 				return nullptr;
 			}
 
+            /*
+            ** Components of type T attached to this node or to any of its descendants. On a root
+            ** node, this iterates the scene-wide registry of the components of each type instead
+            ** of traversing the scene: the order of the components is then unspecified.
+            */
+            template <typename T>
+            std::vector<std::shared_ptr<T>>
+            descendantComponents()
+            {
+                std::vector<std::shared_ptr<T>> result;
+
+                if (root().get() != this)
+                {
+                    appendDescendantComponents<T>(result);
+
+                    return result;
+                }
+
+                if (!_componentRegistry)
+                    return result;
+
+                for (const auto& typedComponents : _componentRegistry->componentsByType)
+                {
+                    if (typedComponents.empty() || !castComponent<T>(typedComponents.front()))
+                        continue;
+
+                    for (const auto& component : typedComponents)
+                        result.push_back(castComponent<T>(component));
+                }
+
+                return result;
+            }
+
 		protected:
 			Node();
 
@@ -310,6 +427,104 @@ namespace minko
 
 			void
 			updateRoot();
+
+        private:
+            template <typename T>
+            static
+            ComponentTypeCache&
+            componentTypeCache()
+            {
+                static ComponentTypeCache cache;
+
+                return cache;
+            }
+
+            // thread safe, components can be created and added off the main thread
+            static
+            uint
+            registerComponentType(const component::AbstractComponent& component);
+
+            static
+            uint
+            componentTypeBit(uint typeId)
+            {
+                return typeId < MAX_NUM_COMPONENT_TYPES ? typeId : MAX_NUM_COMPONENT_TYPES - 1;
+            }
+
+            template <typename T>
+            static
+            std::shared_ptr<T>
+            castComponent(const AbsCmpPtr& component)
+            {
+                auto& cache = componentTypeCache<T>();
+                const auto typeId = component->_typeId;
+                const auto cached = typeId < MAX_NUM_COMPONENT_TYPES - 1;
+
+                auto offset = cached
+                    ? cache.offsets[typeId].load(std::memory_order_relaxed)
+                    : UNKNOWN_COMPONENT_OFFSET;
+
+                if (offset == UNKNOWN_COMPONENT_OFFSET)
+                {
+                    // the layout of an object only depends on its dynamic type: the offset from its
+                    // AbstractComponent base to its T base is the same for every instance of the type
+                    auto typedComponent = dynamic_cast<T*>(component.get());
+
+                    offset = typedComponent
+                        ? reinterpret_cast<const char*>(typedComponent) - reinterpret_cast<const char*>(component.get())
+                        : INCOMPATIBLE_COMPONENT_OFFSET;
+
+                    if (cached)
+                        cache.resolve(typeId, offset);
+                }
+
+                if (offset == INCOMPATIBLE_COMPONENT_OFFSET)
+                    return nullptr;
+
+                return std::shared_ptr<T>(
+                    component,
+                    reinterpret_cast<T*>(reinterpret_cast<char*>(component.get()) + offset)
+                );
+            }
+
+            template <typename T>
+            inline
+            bool
+            mayHaveComponent()
+            {
+                auto& cache = componentTypeCache<T>();
+
+                return (_componentTypes & ~cache.resolved()).any() || (_componentTypes & cache.compatible()).any();
+            }
+
+            template <typename T>
+            void
+            appendDescendantComponents(std::vector<std::shared_ptr<T>>& result)
+            {
+                if (mayHaveComponent<T>())
+                    for (const auto& component : _components)
+                    {
+                        auto typedComponent = castComponent<T>(component);
+
+                        if (typedComponent)
+                            result.push_back(typedComponent);
+                    }
+
+                for (const auto& child : _children)
+                    child->appendDescendantComponents<T>(result);
+            }
+
+            void
+            collectComponents(std::vector<AbsCmpPtr>& components) const;
+
+            void
+            updateComponentTypes();
+
+            void
+            registerComponent(AbsCmpPtr component);
+
+            void
+            unregisterComponent(AbsCmpPtr component);
 		};
 	}
 }
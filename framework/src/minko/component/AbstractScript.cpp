@@ -43,6 +43,7 @@ AbstractScript::AbstractScript() :
     _componentRemovedSlot(nullptr),
     _frameBeginSlot(nullptr),
     _frameEndSlot(nullptr),
+    _tickSlot(nullptr),
     _requiredAssetLoader(file::Loader::create())
 {
     _requiredAssetErrorSlot = _requiredAssetLoader->error()->connect(
@@ -62,6 +63,7 @@ AbstractScript::~AbstractScript()
     _removedSlot = nullptr;
     _frameBeginSlot = nullptr;
     _frameEndSlot = nullptr;
+    _tickSlot = nullptr;
 }
 
 void
@@ -112,6 +114,7 @@ AbstractScript::targetRemoved(Node::Ptr target)
 	_componentRemovedSlot   = nullptr;
     _frameBeginSlot         = nullptr;
 	_frameEndSlot           = nullptr;
+	_tickSlot               = nullptr;
 
     if (_started)
     {
@@ -171,6 +174,26 @@ AbstractScript::frameEndHandler(SceneManager::Ptr 	sceneManager,
 		end(target());
 }
 
+void
+AbstractScript::tickHandler(SceneManager::Ptr   sceneManager,
+                            float               time,
+                            float               deltaTime)
+{
+    if (!_started)
+        return;
+
+    const auto frameTime = _time;
+    const auto frameDeltaTime = _deltaTime;
+
+    _time = time;
+    _deltaTime = deltaTime;
+
+    fixedUpdate(target());
+
+    _time = frameTime;
+    _deltaTime = frameDeltaTime;
+}
+
 void
 AbstractScript::setSceneManager(SceneManager::Ptr sceneManager)
 {
@@ -199,6 +222,14 @@ AbstractScript::setSceneManager(SceneManager::Ptr sceneManager)
 				},
 				priority()
 			);
+		if (!_tickSlot)
+			_tickSlot = sceneManager->tick()->connect(
+				[=](SceneManager::Ptr s, float t, float dt)
+				{
+					tickHandler(s, t, dt);
+				},
+				priority()
+			);
 	}
 	else if (_frameBeginSlot)
 	{
@@ -210,6 +241,7 @@ AbstractScript::setSceneManager(SceneManager::Ptr sceneManager)
 
 		_frameBeginSlot = nullptr;
 		_frameEndSlot   = nullptr;
+		_tickSlot       = nullptr;
 	}
 }
 
@@ -0,0 +1,367 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/ClusteredLighting.hpp"
+#include "minko/component/SceneManager.hpp"
+#include "minko/data/Collection.hpp"
+#include "minko/data/Provider.hpp"
+#include "minko/data/Store.hpp"
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/log/Logger.hpp"
+#include "minko/render/LightClusterGrid.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/scene/Node.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+const uint ClusteredLighting::MAX_LIGHTS_PER_CLUSTER = 64;
+const uint ClusteredLighting::LIGHT_DATA_TEXELS_PER_LIGHT = 16;
+
+namespace
+{
+    // Inverse of unpackFloat8bitRGBA() (see Pack.function.glsl): value must be in [0, 1).
+    inline
+    void
+    packFloat8bitRGBA(float value, unsigned char* rgba)
+    {
+        double remainder = std::min(std::max(double(value), 0.), 1. - 1e-9);
+
+        for (auto i = 0; i < 4; ++i)
+        {
+            remainder *= 255.;
+
+            auto digit = std::floor(remainder);
+
+            rgba[i] = static_cast<unsigned char>(digit);
+            remainder -= digit;
+        }
+    }
+}
+
+ClusteredLighting::ClusteredLighting(uint numClustersX, uint numClustersY, uint numClustersZ, uint maxNumLights) :
+	AbstractComponent(),
+	_grid(render::LightClusterGrid::create(numClustersX, numClustersY, numClustersZ)),
+	_maxNumLights(std::min(maxNumLights, render::AbstractTexture::MAX_SIZE)),
+	_defaultLightRange(10.f),
+	_projection(0.f),
+	_numDroppedLights(0),
+	_provider(data::Provider::create())
+{
+	_grid->maxLightsPerCluster(MAX_LIGHTS_PER_CLUSTER);
+}
+
+void
+ClusteredLighting::targetAdded(NodePtr target)
+{
+	if (target->components<ClusteredLighting>().size() > 1)
+		throw std::logic_error("The same camera node cannot have more than one ClusteredLighting.");
+
+	auto cb = [this](NodePtr node, NodePtr target, NodePtr ancestor)
+	{
+		updateRoot(node->root());
+	};
+
+	_addedSlot = target->added().connect(cb);
+	_removedSlot = target->removed().connect(cb);
+
+	updateRoot(target->root());
+}
+
+void
+ClusteredLighting::targetRemoved(NodePtr target)
+{
+	_addedSlot = nullptr;
+	_removedSlot = nullptr;
+
+	updateRoot(nullptr);
+}
+
+void
+ClusteredLighting::updateRoot(NodePtr root)
+{
+	if (root == _root)
+		return;
+
+	_renderingBeginSlot = nullptr;
+
+	if (_root)
+		_root->data().removeProvider(_provider);
+
+	_root = root;
+
+	if (!_root)
+		return;
+
+	_root->data().addProvider(_provider);
+
+	auto sceneManager = _root->component<SceneManager>();
+
+	if (sceneManager)
+	{
+		if (_lightDataTexture == nullptr)
+			initializeTextures(sceneManager->assets()->context());
+
+		_renderingBeginSlot = sceneManager->renderingBegin()->connect(
+			[this](SceneManager::Ptr sm, uint fid, render::AbstractTexture::Ptr rt)
+			{
+				update();
+			},
+			-1.f
+		);
+	}
+}
+
+void
+ClusteredLighting::initializeTextures(std::shared_ptr<render::AbstractContext> context)
+{
+	// data textures are sampled texel by texel: no mipmapping nor smooth resizing
+	auto createDataTexture = [&](uint width, uint height, const std::string& name)
+	{
+		auto texture = render::Texture::create(
+			context, math::clp2(width), math::clp2(height), false, false, false, render::TextureFormat::RGBA, name
+		);
+		std::vector<unsigned char> rgba(texture->width() * texture->height() * 4, 0);
+
+		texture->data(rgba.data());
+		texture->upload();
+
+		return texture;
+	};
+
+	_lightDataTexture = createDataTexture(LIGHT_DATA_TEXELS_PER_LIGHT, _maxNumLights, "clusteredLightingLightData");
+	_clustersTexture = createDataTexture(
+		_grid->numClustersX() * _grid->numClustersY(), _grid->numClustersZ(), "clusteredLightingClusters"
+	);
+	// large enough for every cluster to reference MAX_LIGHTS_PER_CLUSTER lights
+	auto maxNumIndices = _grid->numClusters() * MAX_LIGHTS_PER_CLUSTER;
+	auto lightIndicesWidth = std::min(
+		math::clp2(uint(std::ceil(std::sqrt(float(maxNumIndices))))), render::AbstractTexture::MAX_SIZE
+	);
+
+	_lightIndicesTexture = createDataTexture(
+		lightIndicesWidth, (maxNumIndices + lightIndicesWidth - 1) / lightIndicesWidth, "clusteredLightingLightIndices"
+	);
+
+	_provider
+		->set("clusteredLightingLightData", _lightDataTexture->sampler())
+		->set("clusteredLightingLightDataSize", math::vec2(_lightDataTexture->width(), _lightDataTexture->height()))
+		->set("clusteredLightingClusters", _clustersTexture->sampler())
+		->set("clusteredLightingClustersSize", math::vec2(_clustersTexture->width(), _clustersTexture->height()))
+		->set("clusteredLightingLightIndices", _lightIndicesTexture->sampler())
+		->set("clusteredLightingLightIndicesSize", math::vec2(_lightIndicesTexture->width(), _lightIndicesTexture->height()))
+		->set("clusteredLightingGridSize", math::vec3(
+			_grid->numClustersX(), _grid->numClustersY(), _grid->numClustersZ()
+		));
+}
+
+float
+ClusteredLighting::lightRange(ProviderPtr light) const
+{
+	if (light->hasProperty("range"))
+		return light->get<float>("range");
+
+	if (light->hasProperty("attenuationCoeffs"))
+	{
+		// distance at which 1 / (c + l * d + q * d^2) drops below the precision of an 8 bit color
+		const auto& coeffs = light->get<math::vec3>("attenuationCoeffs");
+		const auto threshold = 256.f;
+
+		if (coeffs.x >= 0.f && coeffs.y >= 0.f && coeffs.z >= 0.f)
+		{
+			if (coeffs.z > 0.f)
+				return (-coeffs.y + std::sqrt(coeffs.y * coeffs.y - 4.f * coeffs.z * (coeffs.x - threshold)))
+					/ (2.f * coeffs.z);
+			if (coeffs.y > 0.f)
+				return std::max(0.f, (threshold - coeffs.x) / coeffs.y);
+		}
+	}
+
+	return _defaultLightRange;
+}
+
+void
+ClusteredLighting::update()
+{
+	auto target = this->target();
+	const auto& viewMatrix = target->data().get<math::mat4>("viewMatrix");
+	const auto& projection = target->data().get<math::mat4>("projectionMatrix");
+
+	if (projection != _projection)
+	{
+		_projection = projection;
+		_grid->projection(projection);
+		_provider->set("clusteredLightingDepthRange", math::vec2(
+			_grid->zNear(), std::log(_grid->zFar() / _grid->zNear())
+		));
+	}
+
+	_viewSpaceSpheres.clear();
+	_lights.clear();
+	_lightRanges.clear();
+
+	for (const auto& collection : _root->data().collections())
+	{
+		const auto& name = *collection->name();
+
+		if (name != "pointLight" && name != "spotLight")
+			continue;
+
+		for (const auto& light : collection->items())
+		{
+			if (_lights.size() == _maxNumLights)
+				break;
+
+			auto range = lightRange(light);
+			auto position = viewMatrix * math::vec4(light->get<math::vec3>("position"), 1.f);
+
+			_viewSpaceSpheres.push_back(math::vec4(math::vec3(position), range));
+			_lights.push_back(light);
+			_lightRanges.push_back(range);
+		}
+	}
+
+	_grid->bin(_viewSpaceSpheres);
+
+	updateLightData();
+	updateClusters();
+}
+
+void
+ClusteredLighting::updateLightData()
+{
+	auto boundsMin = math::vec3(0.f);
+	auto boundsMax = math::vec3(0.f);
+	auto maxRange = 1e-3f;
+	auto maxIntensity = 1e-3f;
+
+	for (auto i = 0u; i < _lights.size(); ++i)
+	{
+		const auto& light = _lights[i];
+		const auto& position = light->get<math::vec3>("position");
+		const auto& color = light->get<math::vec3>("color");
+		auto intensity = std::max(light->get<float>("diffuse"), light->get<float>("specular"));
+
+		boundsMin = i == 0 ? position : math::min(boundsMin, position);
+		boundsMax = i == 0 ? position : math::max(boundsMax, position);
+		maxRange = std::max(maxRange, _lightRanges[i]);
+		maxIntensity = std::max(maxIntensity, intensity * std::max(color.x, std::max(color.y, color.z)));
+	}
+
+	// keep the normalized values strictly below 1, the upper bound of the packed encoding
+	auto boundsSize = (boundsMax - boundsMin) * 1.001f + math::vec3(1e-3f);
+
+	maxRange *= 1.001f;
+	maxIntensity *= 1.001f;
+
+	auto& rgba = _lightDataTexture->data();
+	const auto rowSize = _lightDataTexture->width() * 4;
+
+	for (auto i = 0u; i < _lights.size(); ++i)
+	{
+		const auto& light = _lights[i];
+		const auto& color = light->get<math::vec3>("color");
+		auto position = (light->get<math::vec3>("position") - boundsMin) / boundsSize;
+		auto diffuse = color * light->get<float>("diffuse") / maxIntensity;
+		auto specular = color * light->get<float>("specular") / maxIntensity;
+		auto direction = math::vec3(0.f, 0.f, -1.f);
+		// point lights behave as spot lights with a 360 degrees cone
+		auto cosInnerConeAngle = -1.f;
+		auto cosOuterConeAngle = -1.f;
+
+		if (light->hasProperty("direction"))
+		{
+			direction = light->get<math::vec3>("direction");
+			cosInnerConeAngle = light->get<float>("cosInnerConeAngle");
+			cosOuterConeAngle = light->get<float>("cosOuterConeAngle");
+		}
+
+		float values[] = {
+			position.x, position.y, position.z,
+			_lightRanges[i] / maxRange,
+			diffuse.x, diffuse.y, diffuse.z,
+			specular.x, specular.y, specular.z,
+			direction.x * .5f + .5f, direction.y * .5f + .5f, direction.z * .5f + .5f,
+			cosInnerConeAngle * .5f + .5f,
+			cosOuterConeAngle * .5f + .5f,
+			0.f
+		};
+
+		for (auto j = 0u; j < LIGHT_DATA_TEXELS_PER_LIGHT; ++j)
+			packFloat8bitRGBA(values[j], &rgba[i * rowSize + j * 4]);
+	}
+
+	_lightDataTexture->upload();
+
+	_provider
+		->set("clusteredLightingBoundsMin", boundsMin)
+		->set("clusteredLightingBoundsSize", boundsSize)
+		->set("clusteredLightingMaxRange", maxRange)
+		->set("clusteredLightingMaxIntensity", maxIntensity);
+}
+
+void
+ClusteredLighting::updateClusters()
+{
+	const auto maxNumIndices = _lightIndicesTexture->width() * _lightIndicesTexture->height();
+	const auto& offsets = _grid->clusterOffsets();
+	const auto& counts = _grid->clusterCounts();
+	const auto& indices = _grid->lightIndices();
+	const auto numClustersXY = _grid->numClustersX() * _grid->numClustersY();
+	const auto rowSize = _clustersTexture->width() * 4;
+	auto& clusters = _clustersTexture->data();
+	auto numDroppedLights = _grid->numDroppedLights();
+
+	for (auto cluster = 0u; cluster < _grid->numClusters(); ++cluster)
+	{
+		// only happens when the grid is too large for the maximum texture size
+		auto offset = std::min(offsets[cluster], maxNumIndices);
+		auto count = std::min(counts[cluster], maxNumIndices - offset);
+		auto* texel = &clusters[(cluster / numClustersXY) * rowSize + (cluster % numClustersXY) * 4];
+
+		numDroppedLights += counts[cluster] - count;
+
+		// the offset is stored on 24 bits (r, g and a) and the count on 8 bits (b)
+		texel[0] = static_cast<unsigned char>(offset & 0xff);
+		texel[1] = static_cast<unsigned char>((offset >> 8) & 0xff);
+		texel[2] = static_cast<unsigned char>(count);
+		texel[3] = static_cast<unsigned char>(offset >> 16);
+	}
+
+	auto& lightIndices = _lightIndicesTexture->data();
+	auto numIndices = std::min(uint(indices.size()), maxNumIndices);
+
+	for (auto i = 0u; i < numIndices; ++i)
+	{
+		lightIndices[i * 4] = static_cast<unsigned char>(indices[i] & 0xff);
+		lightIndices[i * 4 + 1] = static_cast<unsigned char>(indices[i] >> 8);
+	}
+
+	_clustersTexture->upload();
+	_lightIndicesTexture->upload();
+
+	// only log when the situation changes to avoid flooding the log every frame
+	if (numDroppedLights != 0 && numDroppedLights != _numDroppedLights)
+		LOG_WARNING(
+			std::to_string(numDroppedLights) + " light(s) dropped from the cluster light lists, "
+			"increase the number of clusters or decrease the lights range."
+		);
+
+	_numDroppedLights = numDroppedLights;
+}
@@ -22,7 +22,6 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/scene/Node.hpp"
 #include "minko/data/Store.hpp"
 #include "minko/math/Frustum.hpp"
-#include "minko/scene/NodeSet.hpp"
 #include "minko/scene/Layout.hpp"
 #include "minko/math/OctTree.hpp"
 #include "minko/component/Camera.hpp"
@@ -40,7 +39,8 @@ Culling::Culling(ShapePtr shape, const std::string& bindProperty, scene::Layout
     _bindProperty(bindProperty),
     _worldSize(50.f),
     _maxDepth(7u),
-    _layout(layout)
+    _layout(layout),
+    _updateNextFrame(false)
 {
 }
 
@@ -76,8 +76,8 @@ Culling::targetAdded(NodePtr target)
 void
 Culling::targetRemoved(NodePtr target)
 {
-    _addedSlot              = nullptr;
-    _removedSlot            = nullptr;
+    _surfacesAddedSlot      = nullptr;
+    _surfacesRemovedSlot    = nullptr;
     _layoutChangedSlot      = nullptr;
     _renderingBeginSlot     = nullptr;
     _octTree                = nullptr;
@@ -102,18 +102,18 @@ Culling::targetAddedToSceneHandler(NodePtr node, NodePtr target, NodePtr ancesto
             }
         );
 
-        _addedSlot = target->root()->added().connect(
-            [this](NodePtr node, NodePtr target, NodePtr ancestor)
+        _surfacesAddedSlot = sceneManager->surfacesAdded()->connect(
+            [this](SceneManager::Ptr sm, const std::vector<SurfacePtr>& surfaces)
             {
-                addedHandler(node, target, ancestor);
+                surfacesAddedHandler(sm, surfaces);
             },
             -1.f
         );
 
-        _removedSlot = target->root()->removed().connect(
-            [this](NodePtr node, NodePtr target, NodePtr ancestor)
+        _surfacesRemovedSlot = sceneManager->surfacesRemoved()->connect(
+            [this](SceneManager::Ptr sm, const std::vector<SurfacePtr>& surfaces)
             {
-                removedHandler(node, target, ancestor);
+                surfacesRemovedHandler(sm, surfaces);
             }
         );
 
@@ -153,38 +153,33 @@ Culling::targetAddedToSceneHandler(NodePtr node, NodePtr target, NodePtr ancesto
             -1.f
         );
 
-        addedHandler(target->root(), target->root(), target->root());
+        surfacesAddedHandler(sceneManager, target->root()->descendantComponents<Surface>());
     }
 }
 
 void
-Culling::addedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
+Culling::surfacesAddedHandler(SceneMngrPtr sceneManager, const std::vector<SurfacePtr>& surfaces)
 {
-    scene::NodeSet::Ptr nodeSet = scene::NodeSet::create(target)
-        ->descendants(true)
-        ->where([&](NodePtr descendant)
-        {
-            return (descendant->layout() & scene::BuiltinLayout::IGNORE_CULLING) == 0
-                && descendant->hasComponent<Surface>();
-        });
+    for (const auto& surface : surfaces)
+    {
+        auto node = surface->target();
 
-    for (auto n : nodeSet->nodes())
-        _octTree->insert(n);
+        if ((node->layout() & scene::BuiltinLayout::IGNORE_CULLING) == 0)
+            _octTree->insert(node);
+    }
 }
 
 void
-Culling::removedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
+Culling::surfacesRemovedHandler(SceneMngrPtr sceneManager, const std::vector<SurfacePtr>& surfaces)
 {
-    auto nodeSet = scene::NodeSet::create(target)
-        ->descendants(true)
-        ->where([](NodePtr descendant)
+    for (const auto& surface : surfaces)
     {
-        return (descendant->layout() & scene::BuiltinLayout::IGNORE_CULLING) == 0
-            && descendant->hasComponent<Surface>();
-    });
+        auto node = surface->target();
 
-    for (auto nodeToRemove : nodeSet->nodes())
-        _octTree->remove(nodeToRemove);
+        // the node stays in the octree as long as it holds a surface within the scene
+        if (node->root() != target()->root() || !node->hasComponent<Surface>())
+            _octTree->remove(node);
+    }
 }
 
 void
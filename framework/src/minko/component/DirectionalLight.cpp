@@ -22,6 +22,10 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/file/Options.hpp"
 #include "minko/component/Renderer.hpp"
+#include "minko/component/BoundingBox.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/math/Box.hpp"
+#include "minko/math/Frustum.hpp"
 #include "minko/component/SceneManager.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/scene/Layout.hpp"
@@ -35,6 +39,7 @@ const uint DirectionalLight::MAX_NUM_SHADOW_CASCADES 		= 4;
 const uint DirectionalLight::MIN_SHADOWMAP_SIZE				= 32;
 const uint DirectionalLight::MAX_SHADOWMAP_SIZE				= 1024;
 const uint DirectionalLight::DEFAULT_SHADOWMAP_SIZE			= 512;
+const float DirectionalLight::DEFAULT_STATIC_SHADOW_MARGIN	= .1f;
 
 DirectionalLight::DirectionalLight(float diffuse, float specular) :
 	AbstractDiscreteLight("directionalLight", diffuse, specular),
@@ -42,13 +47,22 @@ DirectionalLight::DirectionalLight(float diffuse, float specular) :
 	_numShadowCascades(0),
 	_shadowMap(nullptr),
 	_shadowMapSize(0),
-	_shadowRenderers()
+	_shadowRenderers(),
+	_staticShadowsEnabled(false),
+	_staticShadowMargin(DEFAULT_STATIC_SHADOW_MARGIN)
 {
     updateModelToWorldMatrix(math::mat4(1.f));
 }
 
 DirectionalLight::DirectionalLight(const DirectionalLight& directionalLight, const CloneOption& option) :
-	AbstractDiscreteLight("directionalLight", directionalLight.diffuse(), directionalLight.specular())
+	AbstractDiscreteLight("directionalLight", directionalLight.diffuse(), directionalLight.specular()),
+	_shadowMappingEnabled(false),
+	_numShadowCascades(0),
+	_shadowMap(nullptr),
+	_shadowMapSize(0),
+	_shadowRenderers(),
+	_staticShadowsEnabled(false),
+	_staticShadowMargin(directionalLight._staticShadowMargin)
 {
     updateModelToWorldMatrix(math::mat4(1.f));
 }
@@ -123,12 +137,6 @@ DirectionalLight::initializeShadowMapping()
         ->set("shadowBias", -0.001f)
         ->set("shadowMapSize", static_cast<float>(_shadowMapSize) * 2.f);
 
-	std::array<math::ivec4, 4> viewports = {
-		math::ivec4(0, _shadowMapSize, _shadowMapSize, _shadowMapSize),
-		math::ivec4(_shadowMapSize, _shadowMapSize, _shadowMapSize, _shadowMapSize),
-		math::ivec4(0, 0, _shadowMapSize, _shadowMapSize),
-		math::ivec4(_shadowMapSize, 0, _shadowMapSize, _shadowMapSize)
-	};
 	for (auto i = 0u; i < _numShadowCascades; ++i)
 	{
         auto techniqueName = "shadow-map-cascade" + std::to_string(i);
@@ -144,21 +152,188 @@ DirectionalLight::initializeShadowMapping()
 		);
 
 		renderer->clearBeforeRender(i == 0);
-		renderer->viewport(viewports[i]);
+		renderer->viewport(shadowCascadeViewport(i));
 		renderer->effectVariables().push_back({ "lightUuid", data()->uuid() });
 		// renderer->effectVariables()["shadowProjectionId"] = std::to_string(i);
 		renderer->layoutMask(scene::BuiltinLayout::CAST_SHADOW);
+		// each cascade only renders the casters inside its own light frustum
+		renderer->surfaceFilter([=](SurfacePtr surface) { return castsShadow(surface, i, false); });
 		target()->addComponent(renderer);
 
 		_shadowRenderers[i] = renderer;
+		_shadowFrustums[i] = math::Frustum::create();
 	}
 
+	if (_staticShadowsEnabled)
+		initializeStaticShadows();
+
 	computeShadowProjection(math::mat4(1.f), math::perspective(.785f, 1.f, 0.1f, 1000.f));
 
 	return true;
 }
 
-std::pair<math::vec3, math::vec3>
+math::ivec4
+DirectionalLight::shadowCascadeViewport(uint cascadeId) const
+{
+	// cascades are laid out in the quadrants of the shadow map: 0 and 1 on top, 2 and 3 at the bottom
+	return math::ivec4(
+		(cascadeId % 2) * _shadowMapSize,
+		(cascadeId < 2 ? 1 : 0) * _shadowMapSize,
+		_shadowMapSize,
+		_shadowMapSize
+	);
+}
+
+void
+DirectionalLight::initializeStaticShadows()
+{
+	if (!_shadowMap || _staticShadowMap)
+		return;
+
+	auto root = target()->root();
+	auto smTechnique = root->hasComponent<ShadowMappingTechnique>()
+		? root->data().get<ShadowMappingTechnique::Technique>("shadowMappingTechnique")
+		: ShadowMappingTechnique::Technique::DEFAULT;
+
+	// blurred (ESM) shadow maps cannot be composited depth-wise
+	if (smTechnique == ShadowMappingTechnique::Technique::ESM)
+		return;
+
+	auto assets = root->component<SceneManager>()->assets();
+	auto fx = assets->effect("effect/ShadowMap.effect");
+
+	_staticShadowMap = render::Texture::create(assets->context(), _shadowMapSize * 2, _shadowMapSize * 2, false, true);
+	_staticShadowMap->upload();
+	data()->set("staticShadowMap", _staticShadowMap->sampler());
+
+	for (auto i = 0u; i < _numShadowCascades; ++i)
+	{
+		auto cascadeName = "shadow-map-cascade" + std::to_string(i);
+		auto viewport = shadowCascadeViewport(i);
+
+		// renders the static casters when the cache is invalid, then disables itself
+		auto staticRenderer = component::Renderer::create(
+			0xffffffff,
+			_staticShadowMap,
+			fx,
+			cascadeName,
+			render::Priority::FIRST + 1.f
+		);
+
+		staticRenderer->viewport(viewport);
+		staticRenderer->scissorBox(viewport.x, viewport.y, viewport.z, viewport.w);
+		staticRenderer->effectVariables().push_back({ "lightUuid", data()->uuid() });
+		staticRenderer->layoutMask(scene::BuiltinLayout::CAST_SHADOW);
+		staticRenderer->surfaceFilter([=](SurfacePtr surface) { return castsShadow(surface, i, true); });
+		_staticShadowRenderingEndSlots[i] = staticRenderer->renderingEnd()->connect([](RendererPtr renderer)
+		{
+			renderer->enabled(false);
+		});
+		target()->addComponent(staticRenderer);
+
+		// copies the cached static shadows in the cascade before the dynamic casters are rendered
+		auto copyRenderer = component::Renderer::create(
+			0xffffffff,
+			_shadowMap,
+			fx,
+			cascadeName + "-static-copy",
+			render::Priority::FIRST - i + .5f
+		);
+
+		copyRenderer->viewport(viewport);
+		copyRenderer->scissorBox(viewport.x, viewport.y, viewport.z, viewport.w);
+		copyRenderer->effectVariables().push_back({ "lightUuid", data()->uuid() });
+		copyRenderer->layoutMask(scene::BuiltinLayout::CAST_SHADOW);
+		target()->addComponent(copyRenderer);
+
+		_staticShadowRenderers[i] = staticRenderer;
+		_staticShadowCopyRenderers[i] = copyRenderer;
+
+		_shadowRenderers[i]->clearBeforeRender(false);
+		_shadowRenderers[i]->effect(fx, cascadeName + "-dynamic");
+	}
+
+	// force the cascades to be re-fitted with a margin
+	_shadowBoxes.fill(Box(math::vec3(0.f), math::vec3(0.f)));
+}
+
+void
+DirectionalLight::disposeStaticShadows()
+{
+	if (!_staticShadowMap)
+		return;
+
+	for (auto i = 0u; i < _numShadowCascades; ++i)
+	{
+		if (target())
+		{
+			if (target()->hasComponent(_staticShadowRenderers[i]))
+				target()->removeComponent(_staticShadowRenderers[i]);
+			if (target()->hasComponent(_staticShadowCopyRenderers[i]))
+				target()->removeComponent(_staticShadowCopyRenderers[i]);
+		}
+
+		_staticShadowRenderingEndSlots[i] = nullptr;
+		_staticShadowRenderers[i] = nullptr;
+		_staticShadowCopyRenderers[i] = nullptr;
+
+		if (_shadowRenderers[i])
+		{
+			_shadowRenderers[i]->clearBeforeRender(i == 0);
+			_shadowRenderers[i]->effect(_shadowRenderers[i]->effect(), "shadow-map-cascade" + std::to_string(i));
+		}
+	}
+
+	data()->unset("staticShadowMap");
+	_staticShadowMap = nullptr;
+}
+
+bool
+DirectionalLight::castsShadow(SurfacePtr surface, uint cascadeId, bool staticCaster)
+{
+	auto node = surface->target();
+
+	if (_staticShadowMap && ((node->layout() & scene::BuiltinLayout::STATIC) != 0) != staticCaster)
+		return false;
+
+	if (!node->hasComponent<BoundingBox>())
+		return true;
+
+	return static_cast<int>(_shadowFrustums[cascadeId]->testBoundingBox(node->component<BoundingBox>()->box())) < 0;
+}
+
+void
+DirectionalLight::enableStaticShadows(float margin)
+{
+	_staticShadowMargin = margin;
+
+	if (_staticShadowsEnabled)
+		return;
+
+	_staticShadowsEnabled = true;
+	if (_shadowMap)
+		initializeStaticShadows();
+}
+
+void
+DirectionalLight::disableStaticShadows()
+{
+	if (!_staticShadowsEnabled)
+		return;
+
+	_staticShadowsEnabled = false;
+	disposeStaticShadows();
+}
+
+void
+DirectionalLight::invalidateStaticShadows()
+{
+	for (auto renderer : _staticShadowRenderers)
+		if (renderer)
+			renderer->enabled(true);
+}
+
+DirectionalLight::Box
 DirectionalLight::computeBox(const math::mat4& viewProjection)
 {
 	math::mat4 t = _view * math::inverse(viewProjection);
@@ -274,6 +449,27 @@ DirectionalLight::computeShadowProjection(const math::mat4& view,
 		math::mat4 cameraViewProjection = math::perspective(fov, ratio, zNear, splitFar[i]) * view;
 		auto box = computeBox(cameraViewProjection);
 
+		if (_staticShadowMap)
+		{
+			// keep the current cascade bounds, and thus the cached static shadows, as long as they
+			// contain the cascade and are not too large for it
+			const auto& currentBox = _shadowBoxes[i];
+			auto size = box.second - box.first;
+			auto contained = math::all(math::greaterThanEqual(box.first, currentBox.first))
+				&& math::all(math::lessThanEqual(box.second, currentBox.second));
+			auto tooLarge = math::any(math::greaterThan(
+				currentBox.second - currentBox.first,
+				size * (1.f + 4.f * _staticShadowMargin)
+			));
+
+			if (!contained || tooLarge)
+				_shadowBoxes[i] = Box(box.first - size * _staticShadowMargin, box.second + size * _staticShadowMargin);
+
+			box = _shadowBoxes[i];
+		}
+		else
+			_shadowBoxes[i] = box;
+
 		_shadowProjections[i] = math::ortho<float>(
             box.first.x, box.second.x,
             box.first.y, box.second.y,
@@ -318,6 +514,15 @@ DirectionalLight::updateWorldToScreenMatrix()
 		zNear[i] = (farMinusNear + farPlusNear) / 2.f;
 		zFar[i] = farPlusNear - zNear[i];
 		viewProjections.push_back(projection * _view);
+
+		if (_shadowFrustums[i])
+			_shadowFrustums[i]->updateFromMatrix(viewProjections[i]);
+
+		if (_staticShadowRenderers[i] && viewProjections[i] != _staticShadowViewProjections[i])
+		{
+			_staticShadowViewProjections[i] = viewProjections[i];
+			_staticShadowRenderers[i]->enabled(true);
+		}
 	}
 
 	data()
@@ -340,6 +545,13 @@ DirectionalLight::targetRemoved(minko::scene::Node::Ptr target)
 {
 	AbstractDiscreteLight::targetRemoved(target);
 
+	for (auto renderer : _staticShadowRenderers)
+		if (renderer && target->hasComponent(renderer))
+			target->removeComponent(renderer);
+	for (auto renderer : _staticShadowCopyRenderers)
+		if (renderer && target->hasComponent(renderer))
+			target->removeComponent(renderer);
+
 	for (auto renderer : _shadowRenderers)
 		if (renderer && target->hasComponent(renderer))
 	    	target->removeComponent(renderer);
@@ -362,6 +574,10 @@ DirectionalLight::enableShadowMapping(uint shadowMapSize, uint numCascades)
 			for (auto renderer : _shadowRenderers)
 				if (renderer)
 					renderer->enabled(true);
+			for (auto renderer : _staticShadowCopyRenderers)
+				if (renderer)
+					renderer->enabled(true);
+			invalidateStaticShadows();
 
 			data()->set("shadowMap", _shadowMap->sampler());
 		}
@@ -378,10 +594,17 @@ DirectionalLight::disableShadowMapping(bool disposeResources)
 		for (auto renderer : _shadowRenderers)
 			if (renderer)
 				renderer->enabled(false);
+		for (auto renderer : _staticShadowCopyRenderers)
+			if (renderer)
+				renderer->enabled(false);
+		for (auto renderer : _staticShadowRenderers)
+			if (renderer)
+				renderer->enabled(false);
 		data()->unset("shadowMap");
 
 		if (disposeResources)
 		{
+			disposeStaticShadows();
 			_shadowMap = nullptr;
 
 			for (auto& renderer : _shadowRenderers)
@@ -24,6 +24,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/scene/NodeSet.hpp"
 #include "minko/component/Surface.hpp"
 #include "minko/render/DrawCall.hpp"
+#include "minko/render/CommandList.hpp"
 #include "minko/render/Effect.hpp"
 #include "minko/render/Pass.hpp"
 #include "minko/render/AbstractTexture.hpp"
@@ -71,7 +72,8 @@ Renderer::Renderer(std::shared_ptr<render::AbstractTexture> renderTarget,
 	_lightMaskFilter(data::LightMaskFilter::create()),*/
 	_filterChanged(Signal<Ptr, data::AbstractFilter::Ptr, data::Binding::Source, SurfacePtr>::create()),
 	_numDrawCalls(0),
-	_numTriangles(0)
+	_numTriangles(0),
+	_commandList(CommandList::create())
 {
 }
 
@@ -195,6 +197,8 @@ Renderer::targetRemoved(std::shared_ptr<Node> target)
 	_addedSlot = nullptr;
 	_removedSlot = nullptr;
 	_renderingBeginSlot = nullptr;
+	_surfacesAddedSlot = nullptr;
+	_surfacesRemovedSlot = nullptr;
 	_surfaceChangedSlots.clear();
 
 	_rootDescendantAddedSlot = nullptr;
@@ -270,29 +274,84 @@ Renderer::listenRootSignals()
             std::placeholders::_3
         ), std::numeric_limits<float>::max());
 
-        // Listening to the root allows us to see changes in every branches of
-        // the scene tree instead of just the changes of the branch we are in.
-        // If our target is our own root, don't listen to the root signals.
-        // In this situation, we already listen to addition and removal because
-        // of the _addedSlot and _removedSlot.
-        if (root != target())
-        {
-            _rootDescendantAddedSlot = root->added().connect(std::bind(
-                &Renderer::rootDescendantAddedHandler,
-                std::static_pointer_cast<Renderer>(shared_from_this()),
-                std::placeholders::_1,
-                std::placeholders::_2,
-                std::placeholders::_3
-            ), std::numeric_limits<float>::max());
-
-            _rootDescendantRemovedSlot = root->removed().connect(std::bind(
-                &Renderer::rootDescendantRemovedHandler,
-                std::static_pointer_cast<Renderer>(shared_from_this()),
-                std::placeholders::_1,
-                std::placeholders::_2,
-                std::placeholders::_3
-            ), std::numeric_limits<float>::max());
-        }
+        listenSurfaceSignals();
+    }
+}
+
+void
+Renderer::listenSurfaceSignals()
+{
+    _surfacesAddedSlot = nullptr;
+    _surfacesRemovedSlot = nullptr;
+    _rootDescendantAddedSlot = nullptr;
+    _rootDescendantRemovedSlot = nullptr;
+
+    if (_sceneManager)
+    {
+        // The scene manager tracks the surfaces entering and leaving the scene
+        // without walking the added or removed subtrees.
+        _surfacesAddedSlot = _sceneManager->surfacesAdded()->connect(std::bind(
+            &Renderer::surfacesAddedHandler,
+            std::static_pointer_cast<Renderer>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2
+        ), std::numeric_limits<float>::max());
+
+        _surfacesRemovedSlot = _sceneManager->surfacesRemoved()->connect(std::bind(
+            &Renderer::surfacesRemovedHandler,
+            std::static_pointer_cast<Renderer>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2
+        ), std::numeric_limits<float>::max());
+
+        return;
+    }
+
+    auto root = target()->root();
+
+    // Listening to the root allows us to see changes in every branches of
+    // the scene tree instead of just the changes of the branch we are in.
+    // If our target is our own root, don't listen to the root signals.
+    // In this situation, we already listen to addition and removal because
+    // of the _addedSlot and _removedSlot.
+    if (root != target())
+    {
+        _rootDescendantAddedSlot = root->added().connect(std::bind(
+            &Renderer::rootDescendantAddedHandler,
+            std::static_pointer_cast<Renderer>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ), std::numeric_limits<float>::max());
+
+        _rootDescendantRemovedSlot = root->removed().connect(std::bind(
+            &Renderer::rootDescendantRemovedHandler,
+            std::static_pointer_cast<Renderer>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ), std::numeric_limits<float>::max());
+    }
+}
+
+void
+Renderer::surfacesAddedHandler(SceneManagerPtr                   sceneManager,
+                               const std::vector<SurfacePtr>&    surfaces)
+{
+    for (const auto& surface : surfaces)
+        // the surface might already have been collected when this renderer joined the scene
+        if (_surfaceToDrawCallIterator.count(surface) == 0 && _surfaceChangedSlots.count(surface) == 0)
+            _toCollect.insert(surface);
+}
+
+void
+Renderer::surfacesRemovedHandler(SceneManagerPtr                 sceneManager,
+                                 const std::vector<SurfacePtr>&  surfaces)
+{
+    for (const auto& surface : surfaces)
+    {
+        unwatchSurface(surface, surface->target());
+        removeSurface(surface);
     }
 }
 
@@ -301,16 +360,8 @@ Renderer::rootDescendantAddedHandler(std::shared_ptr<Node> node,
 									 std::shared_ptr<Node> target,
 									 std::shared_ptr<Node> parent)
 {
-    auto surfaceNodes = NodeSet::create(target)
-		->descendants(true)
-        ->where([](scene::Node::Ptr node)
-        {
-            return node->hasComponent<Surface>();
-        });
-
-	for (auto surfaceNode : surfaceNodes->nodes())
-		for (auto surface : surfaceNode->components<Surface>())
-            _toCollect.insert(surface);
+	for (auto surface : target->descendantComponents<Surface>())
+        _toCollect.insert(surface);
 }
 
 void
@@ -318,19 +369,12 @@ Renderer::rootDescendantRemovedHandler(std::shared_ptr<Node> 	node,
 									   std::shared_ptr<Node> 	target,
 									   std::shared_ptr<Node> 	parent)
 {
-	auto surfaceNodes = NodeSet::create(target)
-		->descendants(true)
-        ->where([](scene::Node::Ptr node)
-        {
-            return node->hasComponent<Surface>();
-        });
-
-	for (auto surfaceNode : surfaceNodes->nodes())
-		for (auto surface : surfaceNode->components<Surface>())
-		{
-			unwatchSurface(surface, surfaceNode);
-			removeSurface(surface);
-		}
+	// target is the root of the removed subtree by now: this iterates its component registry
+	for (auto surface : target->descendantComponents<Surface>())
+	{
+		unwatchSurface(surface, surface->target());
+		removeSurface(surface);
+	}
 
 	// Because scene signals bubble down before bubbling up, some Surface might
 	// have been removed before we add a chance to
@@ -347,7 +391,10 @@ Renderer::componentAddedHandler(std::shared_ptr<Node>				node,
     auto perspectiveCamera = std::dynamic_pointer_cast<Camera>(ctrl);
 
 	if (surfaceCtrl)
-        _toCollect.insert(surfaceCtrl);
+    {
+        if (!_sceneManager)
+            _toCollect.insert(surfaceCtrl);
+    }
 	else if (sceneManager)
 		setSceneManager(sceneManager);
     else if (perspectiveCamera)
@@ -372,8 +419,11 @@ Renderer::componentRemovedHandler(std::shared_ptr<Node>					node,
 
 	if (surface)
 	{
-		unwatchSurface(surface, target);
-		removeSurface(surface);
+        if (!_sceneManager)
+        {
+		    unwatchSurface(surface, target);
+		    removeSurface(surface);
+        }
 	}
     else if (sceneManager)
         setSceneManager(nullptr);
@@ -467,9 +517,24 @@ Renderer::surfaceEffectChangedHandler(SurfacePtr surface)
 void
 Renderer::render(render::AbstractContext::Ptr	context,
 				 render::AbstractTexture::Ptr	renderTarget)
+{
+    if (!prepare(renderTarget))
+        return;
+
+    issue(context);
+    finishRendering(context);
+}
+
+bool
+Renderer::prepare(render::AbstractTexture::Ptr renderTarget)
 {
     if (!_enabled)
-		return;
+		return false;
+
+    // surfaces added since the scene manager emitted its last batch, e.g. when rendering outside of
+    // SceneManager::nextFrame()
+    if (_sceneManager)
+        _sceneManager->flushAddedSurfaces();
 
     const bool forceSort = !_toCollect.empty();
 
@@ -497,7 +562,52 @@ Renderer::render(render::AbstractContext::Ptr	context,
 
 	_renderingBegin->execute(std::static_pointer_cast<Renderer>(shared_from_this()));
 
-	auto rt = _renderTarget ? _renderTarget : renderTarget;
+	_preparedRenderTarget = _renderTarget ? _renderTarget : renderTarget;
+
+    _drawCallPool.update(forceSort, _mustZSort);
+
+    _mustZSort = false;
+
+    _filteredBatchIds.clear();
+    if (_surfaceFilter)
+        for (const auto& surfaceAndBatchId : _surfaceToDrawCallIterator)
+            if (!_surfaceFilter(surfaceAndBatchId.first))
+                _filteredBatchIds.insert(surfaceAndBatchId.second);
+
+    return true;
+}
+
+void
+Renderer::recordCommandList()
+{
+    _commandList->reset();
+
+    issue(_commandList);
+}
+
+void
+Renderer::submitCommandList(render::AbstractContext::Ptr context)
+{
+    _commandList->submit(*context);
+}
+
+void
+Renderer::finishRendering(render::AbstractContext::Ptr context)
+{
+    _preparedRenderTarget = nullptr;
+
+    _beforePresent->execute(std::static_pointer_cast<Renderer>(shared_from_this()));
+
+    context->present();
+
+    _renderingEnd->execute(std::static_pointer_cast<Renderer>(shared_from_this()));
+}
+
+template <typename ContextPtr>
+void
+Renderer::issue(const ContextPtr& context)
+{
+	auto rt = _preparedRenderTarget;
 
 	if (_scissorBox.z >= 0 && _scissorBox.w >= 0)
 		context->setScissorTest(true, _scissorBox);
@@ -523,10 +633,6 @@ Renderer::render(render::AbstractContext::Ptr	context,
 		);
 	}
 
-    _drawCallPool.update(forceSort, _mustZSort);
-
-    _mustZSort = false;
-
     const auto& drawCalls = _drawCallPool.drawCalls();
 
 	_numDrawCalls = 0;
@@ -535,19 +641,29 @@ Renderer::render(render::AbstractContext::Ptr	context,
         for (const auto& drawCalls : priorityToDrawCalls.second)
             for (auto drawCall : drawCalls)
 			{
-				if (drawCall->enabled())
+				// post-processing draw calls (multiple batch IDs) are never filtered
+				if (drawCall->enabled()
+					&& (_filteredBatchIds.empty()
+						|| drawCall->batchIDs().size() > 1u
+						|| _filteredBatchIds.count(drawCall->batchIDs().front()) == 0))
 				{
-	                drawCall->render(context, rt, _viewportBox, _backgroundColor);
+	                issueDrawCall(*drawCall, context, rt);
 					++_numDrawCalls;
 					_numTriangles += drawCall->numTriangles();
 				}
 			}
+}
 
-    _beforePresent->execute(std::static_pointer_cast<Renderer>(shared_from_this()));
-
-    context->present();
+void
+Renderer::issueDrawCall(DrawCall& drawCall, const AbsContext& context, AbsTexturePtr renderTarget)
+{
+    drawCall.render(context, renderTarget, _viewportBox, _backgroundColor);
+}
 
-    _renderingEnd->execute(std::static_pointer_cast<Renderer>(shared_from_this()));
+void
+Renderer::issueDrawCall(DrawCall& drawCall, const CommandListPtr& commandList, AbsTexturePtr renderTarget)
+{
+    drawCall.record(*commandList, renderTarget, _viewportBox, _backgroundColor);
 }
 
 void
@@ -619,6 +735,9 @@ Renderer::setSceneManager(std::shared_ptr<SceneManager> sceneManager)
 				_postProcessingGeom = nullptr;
 			}
 		}
+
+        if (target())
+            listenSurfaceSignals();
 	}
 }
 
@@ -627,7 +746,10 @@ Renderer::sceneManagerRenderingBeginHandler(std::shared_ptr<SceneManager>	sceneM
 										    uint							frameId,
 										    AbstractTexture::Ptr			renderTarget)
 {
-	render(sceneManager->assets()->context(), renderTarget);
+    if (sceneManager->numRecordingThreads() == 0)
+        render(sceneManager->assets()->context(), renderTarget);
+    else if (prepare(renderTarget))
+        sceneManager->deferRendering(std::static_pointer_cast<Renderer>(shared_from_this()));
 }
 
 Renderer::Ptr
@@ -763,7 +885,7 @@ Renderer::unwatchSurface(SurfacePtr surface, NodePtr node)
 {
 	_surfaceLayoutMaskChangedSlot.erase(surface);
 
-	if (!node->hasComponent<Surface>())
+	if (!node->hasComponent<Surface>() || node->root() != target()->root())
 		_nodeLayoutChangedSlot.erase(node);
 }
 
@@ -21,7 +21,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/scene/Node.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/Renderer.hpp"
 #include "minko/render/AbstractTexture.hpp"
+#include "minko/render/TextureUploadQueue.hpp"
+#include "minko/render/BufferUploadQueue.hpp"
 #include "minko/data/Provider.hpp"
 #include "minko/data/Store.hpp"
 #include "minko/AbstractCanvas.hpp"
@@ -34,6 +38,13 @@ SceneManager::SceneManager(const std::shared_ptr<AbstractCanvas>& canvas) :
     _frameId(0),
 	_time(0.f),
     _assets(file::AssetLibrary::create(canvas->context())),
+    _fixedTimestep(0.f),
+    _maxNumTicksPerFrame(8),
+    _tickAccumulator(0.f),
+    _tickTime(0.f),
+    _numTicksLastFrame(0),
+    _numDroppedTicks(0),
+    _tick(Signal<Ptr, float, float>::create()),
     _frameBegin(Signal<Ptr, float, float>::create()),
     _frameEnd(Signal<Ptr, float, float>::create()),
 	_cullBegin(Signal<Ptr>::create()),
@@ -41,10 +52,33 @@ SceneManager::SceneManager(const std::shared_ptr<AbstractCanvas>& canvas) :
 	_renderBegin(Signal<Ptr, uint, render::AbstractTexture::Ptr>::create()),
 	_renderEnd(Signal<Ptr, uint, render::AbstractTexture::Ptr>::create()),
 	_data(data::Provider::create()),
-    _forceRenderNextFrame(false)
+    _surfacesAdded(SurfacesSignal::create()),
+    _surfacesRemoved(SurfacesSignal::create()),
+    _forceRenderNextFrame(false),
+    _numRecordingThreads(0),
+    _recordingTerminating(false),
+    _recordingJobId(0),
+    _recordingJobNumThreads(0),
+    _recordingJobNumPendingWorkers(0),
+    _recordingJobRenderers(nullptr),
+    _recordingJobNextRenderer(0)
 {
 }
 
+SceneManager::~SceneManager()
+{
+    {
+        std::lock_guard<std::mutex> lock(_recordingMutex);
+
+        _recordingTerminating = true;
+    }
+
+    _recordingCondition.notify_all();
+
+    for (auto& worker : _recordingWorkers)
+        worker.join();
+}
+
 void
 SceneManager::targetAdded(NodePtr target)
 {
@@ -63,12 +97,30 @@ SceneManager::targetAdded(NodePtr target)
         std::placeholders::_2,
         std::placeholders::_3
     ));
+
+    _componentsRegisteredSlot = target->componentsRegistered().connect(std::bind(
+        &SceneManager::componentsRegisteredHandler,
+        std::static_pointer_cast<SceneManager>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+
+    _componentsUnregisteredSlot = target->componentsUnregistered().connect(std::bind(
+        &SceneManager::componentsUnregisteredHandler,
+        std::static_pointer_cast<SceneManager>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
 }
 
 void
 SceneManager::targetRemoved(NodePtr target)
 {
     _addedSlot = nullptr;
+    _componentsRegisteredSlot = nullptr;
+    _componentsUnregisteredSlot = nullptr;
+    _addedSurfaces.clear();
+    _pendingSurfaces.clear();
 
 	target->data().removeProvider(_data);
     target->data().removeProvider(_canvas->data());
@@ -87,13 +139,23 @@ SceneManager::nextFrame(float time, float deltaTime, bool shouldRender, render::
     _time = time;
 	_data->set("time", _time);
 
+    _assets->textureUploadQueue()->update();
+
+    executeTicks(deltaTime);
+
+    flushAddedSurfaces();
+
 	_frameBegin->execute(std::static_pointer_cast<SceneManager>(shared_from_this()), time, deltaTime);
+    _assets->bufferUploadQueue()->update();
     if (shouldRender || _forceRenderNextFrame)
     {
+        flushAddedSurfaces();
+
         _cullBegin->execute(std::static_pointer_cast<SceneManager>(shared_from_this()));
         _cullEnd->execute(std::static_pointer_cast<SceneManager>(shared_from_this()));
         _renderBegin->execute(std::static_pointer_cast<SceneManager>(shared_from_this()), _frameId, renderTarget);
         _renderEnd->execute(std::static_pointer_cast<SceneManager>(shared_from_this()), _frameId, renderTarget);
+        renderDeferredRenderers();
 
         _forceRenderNextFrame = false;
     }
@@ -101,3 +163,196 @@ SceneManager::nextFrame(float time, float deltaTime, bool shouldRender, render::
 
 	++_frameId;
 }
+
+void
+SceneManager::deferRendering(RendererPtr renderer)
+{
+    _deferredRenderers.push_back(renderer);
+}
+
+void
+SceneManager::renderDeferredRenderers()
+{
+    if (_deferredRenderers.empty())
+        return;
+
+    std::vector<RendererPtr> renderers;
+
+    renderers.swap(_deferredRenderers);
+
+    const auto numThreads = std::min(_numRecordingThreads, static_cast<uint>(renderers.size()));
+
+    _recordingJobRenderers = &renderers;
+    _recordingJobNextRenderer = 0;
+
+    if (numThreads <= 1)
+        recordCommandLists();
+    else
+    {
+        {
+            std::lock_guard<std::mutex> lock(_recordingMutex);
+
+            // workers are started on demand and kept alive across frames
+            while (_recordingWorkers.size() < numThreads - 1)
+                _recordingWorkers.push_back(std::thread(
+                    &SceneManager::recordingWorkerLoop, this, uint(_recordingWorkers.size()) + 1, _recordingJobId
+                ));
+
+            _recordingJobNumThreads = numThreads;
+            _recordingJobNumPendingWorkers = numThreads - 1;
+            ++_recordingJobId;
+        }
+
+        _recordingCondition.notify_all();
+
+        // the calling thread records too instead of waiting for the workers
+        recordCommandLists();
+
+        std::unique_lock<std::mutex> lock(_recordingMutex);
+
+        _recordingDoneCondition.wait(lock, [this]() { return _recordingJobNumPendingWorkers == 0; });
+    }
+
+    _recordingJobRenderers = nullptr;
+
+    auto context = _assets->context();
+
+    // no signal is executed until all the lists are submitted: listeners could destroy draw calls
+    // referenced by the lists
+    for (const auto& renderer : renderers)
+        renderer->submitCommandList(context);
+    for (const auto& renderer : renderers)
+        renderer->finishRendering(context);
+}
+
+void
+SceneManager::recordCommandLists()
+{
+    const auto& renderers = *_recordingJobRenderers;
+    const auto numRenderers = static_cast<uint>(renderers.size());
+
+    // renderers are picked one at a time so that a renderer with many draw calls does not hold
+    // back the renderers assigned to the same thread
+    for (auto i = _recordingJobNextRenderer++; i < numRenderers; i = _recordingJobNextRenderer++)
+        renderers[i]->recordCommandList();
+}
+
+void
+SceneManager::recordingWorkerLoop(uint worker, uint jobId)
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_recordingMutex);
+
+            _recordingCondition.wait(lock, [&]() { return _recordingTerminating || _recordingJobId != jobId; });
+
+            if (_recordingTerminating)
+                return;
+
+            jobId = _recordingJobId;
+
+            // the job might need fewer workers than there are running
+            if (worker >= _recordingJobNumThreads)
+                continue;
+        }
+
+        recordCommandLists();
+
+        {
+            std::lock_guard<std::mutex> lock(_recordingMutex);
+
+            --_recordingJobNumPendingWorkers;
+        }
+
+        _recordingDoneCondition.notify_one();
+    }
+}
+
+void
+SceneManager::executeTicks(float deltaTime)
+{
+    _numTicksLastFrame = 0;
+
+    if (_fixedTimestep <= 0.f)
+        return;
+
+    _tickAccumulator += deltaTime;
+
+    auto numTicks = static_cast<uint>(_tickAccumulator / _fixedTimestep);
+
+    if (_maxNumTicksPerFrame != 0 && numTicks > _maxNumTicksPerFrame)
+    {
+        _numDroppedTicks += numTicks - _maxNumTicksPerFrame;
+        _tickAccumulator -= (numTicks - _maxNumTicksPerFrame) * _fixedTimestep;
+        numTicks = _maxNumTicksPerFrame;
+    }
+
+    auto that = std::static_pointer_cast<SceneManager>(shared_from_this());
+
+    for (auto i = 0u; i < numTicks; ++i)
+    {
+        _tickTime += _fixedTimestep;
+        _tick->execute(that, _tickTime, _fixedTimestep);
+    }
+
+    _tickAccumulator = std::max(0.f, _tickAccumulator - numTicks * _fixedTimestep);
+    _numTicksLastFrame = numTicks;
+}
+
+void
+SceneManager::flushAddedSurfaces()
+{
+    if (_pendingSurfaces.empty())
+    {
+        _addedSurfaces.clear();
+
+        return;
+    }
+
+    std::vector<SurfacePtr> surfaces;
+
+    surfaces.reserve(_pendingSurfaces.size());
+
+    // a surface removed then added again during the same frame appears twice in _addedSurfaces
+    for (auto& surface : _addedSurfaces)
+        if (_pendingSurfaces.erase(surface) != 0)
+            surfaces.push_back(surface);
+
+    _addedSurfaces.clear();
+
+    _surfacesAdded->execute(std::static_pointer_cast<SceneManager>(shared_from_this()), surfaces);
+}
+
+void
+SceneManager::componentsRegisteredHandler(NodePtr root, const std::vector<AbsCmpPtr>& components)
+{
+    for (const auto& component : components)
+    {
+        auto surface = std::dynamic_pointer_cast<Surface>(component);
+
+        if (surface && _pendingSurfaces.insert(surface).second)
+            _addedSurfaces.push_back(surface);
+    }
+}
+
+void
+SceneManager::componentsUnregisteredHandler(NodePtr root, const std::vector<AbsCmpPtr>& components)
+{
+    std::vector<SurfacePtr> surfaces;
+
+    for (const auto& component : components)
+    {
+        auto surface = std::dynamic_pointer_cast<Surface>(component);
+
+        if (!surface)
+            continue;
+
+        // listeners may have collected the surface by themselves: the removal is always reported
+        _pendingSurfaces.erase(surface);
+        surfaces.push_back(surface);
+    }
+
+    if (!surfaces.empty())
+        _surfacesRemoved->execute(std::static_pointer_cast<SceneManager>(shared_from_this()), surfaces);
+}
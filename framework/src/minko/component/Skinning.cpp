@@ -27,11 +27,13 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <minko/geometry/Bone.hpp>
 #include <minko/geometry/Skin.hpp>
 #include <minko/render/AbstractContext.hpp>
+#include <minko/render/BufferUploadQueue.hpp>
 #include <minko/component/Surface.hpp>
 #include <minko/component/SceneManager.hpp>
 #include <minko/component/MasterAnimation.hpp>
 #include <minko/component/Animation.hpp>
 #include <minko/component/Transform.hpp>
+#include <minko/file/AssetLibrary.hpp>
 
 using namespace minko;
 using namespace minko::data;
@@ -352,7 +354,11 @@ Skinning::performSoftwareSkinning(const VertexAttribute&		 attr,
 		index += vertexSize;
 	}
 
-	vertexBuffer->upload();
+	// positions and normals usually share the same buffer: the queue uploads it once
+	if (sceneManager())
+		sceneManager()->assets()->bufferUploadQueue()->upload(vertexBuffer);
+	else
+		vertexBuffer->upload();
 }
 
 void
@@ -0,0 +1,165 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "minko/component/TransformInterpolation.hpp"
+
+#include "minko/component/SceneManager.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/scene/Node.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+TransformInterpolation::TransformInterpolation() :
+    AbstractComponent(),
+    _previous(),
+    _current(),
+    _interpolated(),
+    _hasSnapshot(false)
+{
+}
+
+AbstractComponent::Ptr
+TransformInterpolation::clone(const CloneOption& option)
+{
+    return TransformInterpolation::create();
+}
+
+math::mat4
+TransformInterpolation::interpolate(const math::mat4& from, const math::mat4& to, float ratio)
+{
+    auto fromScale = math::vec3();
+    auto fromRotation = math::quat();
+    auto fromTranslation = math::vec3();
+    auto toScale = math::vec3();
+    auto toRotation = math::quat();
+    auto toTranslation = math::vec3();
+    auto skew = math::vec3();
+    auto perspective = math::vec4();
+
+    if (!math::decompose(from, fromScale, fromRotation, fromTranslation, skew, perspective)
+        || !math::decompose(to, toScale, toRotation, toTranslation, skew, perspective))
+        return ratio < .5f ? from : to;
+
+    return math::translate(math::mix(fromTranslation, toTranslation, ratio))
+        * math::mat4_cast(math::slerp(fromRotation, toRotation, ratio))
+        * math::scale(math::mix(fromScale, toScale, ratio));
+}
+
+void
+TransformInterpolation::targetAdded(NodePtr target)
+{
+    auto callback = [=](NodePtr node, NodePtr target, NodePtr parent)
+    {
+        setSceneManager(target->root()->component<SceneManager>());
+    };
+
+    _addedSlot = target->added().connect(callback);
+    _removedSlot = target->removed().connect(callback);
+
+    _hasSnapshot = false;
+
+    setSceneManager(target->root()->component<SceneManager>());
+}
+
+void
+TransformInterpolation::targetRemoved(NodePtr target)
+{
+    _addedSlot = nullptr;
+    _removedSlot = nullptr;
+
+    setSceneManager(nullptr);
+}
+
+void
+TransformInterpolation::setSceneManager(SceneManagerPtr sceneManager)
+{
+    _tickBeginSlot = nullptr;
+    _tickEndSlot = nullptr;
+    _frameBeginSlot = nullptr;
+
+    if (sceneManager == nullptr)
+        return;
+
+    _tickBeginSlot = sceneManager->tick()->connect(
+        [=](SceneManagerPtr sceneManager, float time, float deltaTime) { tickBeginHandler(); },
+        std::numeric_limits<float>::max()
+    );
+    _tickEndSlot = sceneManager->tick()->connect(
+        [=](SceneManagerPtr sceneManager, float time, float deltaTime) { tickEndHandler(); },
+        std::numeric_limits<float>::lowest()
+    );
+    // apply the interpolation before any other frameBegin listener reads or writes the matrix
+    _frameBeginSlot = sceneManager->frameBegin()->connect(
+        [=](SceneManagerPtr sceneManager, float time, float deltaTime) { frameBeginHandler(sceneManager); },
+        std::numeric_limits<float>::max()
+    );
+}
+
+void
+TransformInterpolation::tickBeginHandler()
+{
+    auto transform = target()->component<Transform>();
+
+    if (transform == nullptr || !_hasSnapshot)
+        return;
+
+    // the matrix was changed outside of a tick: do not interpolate towards it
+    if (transform->matrix() != _interpolated)
+    {
+        _previous = _current = transform->matrix();
+
+        return;
+    }
+
+    transform->matrix(_current);
+}
+
+void
+TransformInterpolation::tickEndHandler()
+{
+    auto transform = target()->component<Transform>();
+
+    if (transform == nullptr)
+        return;
+
+    _previous = _hasSnapshot ? _current : transform->matrix();
+    _current = transform->matrix();
+    _interpolated = _current;
+    _hasSnapshot = true;
+}
+
+void
+TransformInterpolation::frameBeginHandler(SceneManagerPtr sceneManager)
+{
+    auto transform = target()->component<Transform>();
+
+    if (transform == nullptr || !_hasSnapshot || sceneManager->fixedTimestep() <= 0.f)
+        return;
+
+    if (transform->matrix() != _interpolated)
+    {
+        _previous = _current = _interpolated = transform->matrix();
+
+        return;
+    }
+
+    _interpolated = interpolate(_previous, _current, sceneManager->tickInterpolationFactor());
+
+    transform->matrix(_interpolated);
+}
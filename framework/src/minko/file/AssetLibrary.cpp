@@ -29,6 +29,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/CubeTexture.hpp"
 #include "minko/render/RectangleTexture.hpp"
 #include "minko/render/Effect.hpp"
+#include "minko/render/RenderTargetPool.hpp"
+#include "minko/render/TextureUploadQueue.hpp"
+#include "minko/render/BufferUploadQueue.hpp"
 #include "minko/render/IndexBuffer.hpp"
 #include "minko/render/VertexBuffer.hpp"
 #include "minko/geometry/Geometry.hpp"
@@ -54,6 +57,10 @@ AssetLibrary::create(AssetLibrary::Ptr original)
 {
     auto al = create(original->_context);
 
+    al->_renderTargetPool = original->_renderTargetPool;
+    al->_textureUploadQueue = original->_textureUploadQueue;
+    al->_bufferUploadQueue = original->_bufferUploadQueue;
+
     for (auto it = original->_materials.begin(); it != original->_materials.end(); ++it)
         al->_materials[it->first] = it->second;
 
@@ -92,7 +99,10 @@ AssetLibrary::create(AssetLibrary::Ptr original)
 
 AssetLibrary::AssetLibrary(std::shared_ptr<AbstractContext> context) :
     _context(context),
-    _loader(Loader::create())
+    _loader(Loader::create()),
+    _renderTargetPool(nullptr),
+    _textureUploadQueue(nullptr),
+    _bufferUploadQueue(nullptr)
 {
 }
 
@@ -103,6 +113,33 @@ AssetLibrary::~AssetLibrary()
     disposeLoader();
 }
 
+AssetLibrary::RenderTargetPoolPtr
+AssetLibrary::renderTargetPool()
+{
+    if (!_renderTargetPool)
+        _renderTargetPool = render::RenderTargetPool::create(_context);
+
+    return _renderTargetPool;
+}
+
+AssetLibrary::TextureUploadQueuePtr
+AssetLibrary::textureUploadQueue()
+{
+    if (!_textureUploadQueue)
+        _textureUploadQueue = render::TextureUploadQueue::create();
+
+    return _textureUploadQueue;
+}
+
+AssetLibrary::BufferUploadQueuePtr
+AssetLibrary::bufferUploadQueue()
+{
+    if (!_bufferUploadQueue)
+        _bufferUploadQueue = render::BufferUploadQueue::create();
+
+    return _bufferUploadQueue;
+}
+
 void
 AssetLibrary::clear()
 {
@@ -35,6 +35,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/Pass.hpp"
 #include "minko/render/Priority.hpp"
 #include "minko/render/Program.hpp"
+#include "minko/render/RenderGraph.hpp"
+#include "minko/render/RenderTargetPool.hpp"
 #include "minko/render/States.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/TriangleCulling.hpp"
@@ -140,7 +142,8 @@ EffectParser::EffectParser() :
 	_effect(nullptr),
 	_numDependencies(0),
 	_numLoadedDependencies(0),
-	_effectData(data::Provider::create())
+	_effectData(data::Provider::create()),
+	_transientTargets()
 {
 }
 
@@ -939,6 +942,17 @@ EffectParser::parseMacros(const JSON::Value& node, const Scope& scope, MacroBloc
         {
             auto macroNode = macrosNode[macroName];
 
+            // a null macro removes the macro inherited from an extended pass
+            if (macroNode.isNull())
+            {
+                macros.bindingMap.bindings.erase(macroName);
+                macros.bindingMap.types.erase(macroName);
+                if (defaultValuesProvider->hasProperty(macroName))
+                    defaultValuesProvider->unset(macroName);
+
+                continue;
+            }
+
 			data::MacroBinding binding;
 			if (parseBinding(macroNode, scope, binding))
 			{
@@ -1372,6 +1386,22 @@ EffectParser::parseTarget(const JSON::Value&    node,
             ? node.get("isCube", 0).asBool()
             : false;
 
+        if (targetName.length() && node.get("transient", 0).isBool() && node.get("transient", 0).asBool())
+        {
+            // transient targets are only given an actual texture in finalize(), once the passes using
+            // them are known: until then they are represented by a texture that is never uploaded
+            if (isCubeTexture)
+                target = CubeTexture::create(_options->context(), width, height, false, true);
+            else
+                target = Texture::create(_options->context(), width, height, false, true);
+
+            _transientTargets[target->uuid()] = { targetName, static_cast<uint>(width), static_cast<uint>(height), isCubeTexture, target };
+            _effectData->set(targetName, target->sampler());
+            stateBlock.states.target(target->sampler());
+
+            return;
+        }
+
         if (isCubeTexture)
         {
             target = CubeTexture::create(_options->context(), width, height, false, true);
@@ -1704,9 +1734,202 @@ EffectParser::concatenateGLSLBlocks(GLSLBlockListPtr blocks)
     return glsl;
 }
 
+void
+EffectParser::allocateTransientTargets()
+{
+    std::unordered_map<std::string, std::string> targetNameToUuid;
+    std::unordered_map<std::string, std::vector<std::vector<std::string>>> techniqueToPassReads;
+    std::unordered_map<std::string, std::unordered_set<std::string>> targetToTechniques;
+    std::unordered_set<std::string> outputTargetNames;
+    const auto prefix = std::string("effect[${effectUuid}].");
+
+    for (const auto& transientTarget : _transientTargets)
+        targetNameToUuid[transientTarget.second.name] = transientTarget.first;
+
+    // name of the transient target a property name refers to in any form, or an empty string
+    auto referencedTargetName = [&](const std::string& propertyName) -> std::string
+    {
+        auto separatorPos = propertyName.find_last_of('.');
+        auto targetNameIt = targetNameToUuid.find(
+            separatorPos == std::string::npos ? propertyName : propertyName.substr(separatorPos + 1)
+        );
+
+        return targetNameIt != targetNameToUuid.end() ? targetNameIt->first : std::string();
+    };
+
+    for (const auto& technique : _globalScope.techniques)
+    {
+        auto& passReads = techniqueToPassReads[technique.first];
+
+        for (auto pass : technique.second)
+        {
+            std::vector<std::string> reads;
+
+            for (const auto& binding : pass->uniformBindings().bindings)
+            {
+                const auto& propertyName = binding.second.propertyName;
+                auto targetName = referencedTargetName(propertyName);
+
+                if (targetName.empty())
+                    continue;
+
+                if (propertyName.compare(0, prefix.size(), prefix) == 0 && propertyName.size() == prefix.size() + targetName.size())
+                {
+                    reads.push_back(targetName);
+                    targetToTechniques[targetNameToUuid.at(targetName)].insert(technique.first);
+                }
+                else
+                    outputTargetNames.insert(targetName);
+            }
+
+            // a target reached through anything but a sampler binding is not known to be unread: the
+            // passes writing it are kept
+            for (const auto& binding : pass->macroBindings().bindings)
+            {
+                auto targetName = referencedTargetName(binding.second.propertyName);
+
+                if (!targetName.empty())
+                    outputTargetNames.insert(targetName);
+            }
+
+            for (const auto& binding : pass->stateBindings().bindings)
+            {
+                auto targetName = referencedTargetName(binding.second.propertyName);
+
+                if (!targetName.empty())
+                    outputTargetNames.insert(targetName);
+            }
+
+            passReads.push_back(reads);
+
+            if (_transientTargets.count(pass->states().target().uuid) != 0)
+                targetToTechniques[pass->states().target().uuid].insert(technique.first);
+        }
+    }
+
+    auto pool = _assetLibrary->renderTargetPool();
+    std::unordered_map<std::string, AbstractTexturePtr> textures;
+
+    for (auto& technique : _globalScope.techniques)
+    {
+        auto& passes = technique.second;
+        auto numPasses = passes.size();
+        auto graph = render::RenderGraph::create(pool);
+        std::vector<uint> passOrder(numPasses);
+
+        // passes are declared to the graph in the order they will be rendered
+        for (auto passId = 0u; passId < numPasses; ++passId)
+            passOrder[passId] = passId;
+        std::stable_sort(passOrder.begin(), passOrder.end(), [&](uint a, uint b)
+        {
+            return passes[a]->states().priority() > passes[b]->states().priority();
+        });
+
+        for (const auto& targetUuidAndTechniques : targetToTechniques)
+        {
+            const auto& transientTarget = _transientTargets.at(targetUuidAndTechniques.first);
+
+            // a target shared by several techniques cannot be aliased independently in each of them
+            if (targetUuidAndTechniques.second.size() == 1 && targetUuidAndTechniques.second.count(technique.first))
+            {
+                graph->target(transientTarget.name, transientTarget.width, transientTarget.height, transientTarget.isCube);
+
+                if (outputTargetNames.count(transientTarget.name) != 0)
+                    graph->output(transientTarget.name);
+            }
+        }
+
+        for (auto passId : passOrder)
+        {
+            auto targetIt = _transientTargets.find(passes[passId]->states().target().uuid);
+
+            graph->pass(
+                passes[passId]->name(),
+                techniqueToPassReads[technique.first][passId],
+                targetIt != _transientTargets.end() ? targetIt->second.name : ""
+            );
+        }
+
+        graph->compile();
+
+        for (auto graphPassId = 0u; graphPassId < graph->numPasses(); ++graphPassId)
+            if (graph->culled(graphPassId))
+                LOG_WARNING(
+                    "pass \"" << graph->passName(graphPassId) << "\" of technique \"" << technique.first
+                    << "\" in \"" << _filename << "\" is culled: none of its results is ever read"
+                );
+
+        std::vector<PassPtr> remainingPasses;
+
+        // the graph identifies passes by declaration index, i.e. by index in passOrder
+        for (auto graphPassId : graph->order())
+            remainingPasses.push_back(passes[passOrder[graphPassId]]);
+
+        // a technique with nothing left to render is most likely not meant to be used with transient targets
+        if (!remainingPasses.empty())
+            passes = remainingPasses;
+
+        for (const auto& transientTarget : _transientTargets)
+            if (graph->texture(transientTarget.second.name))
+                textures[transientTarget.first] = graph->texture(transientTarget.second.name);
+
+        _effect->renderGraph(technique.first, graph);
+    }
+
+    // targets shared by several techniques fall back to regular render targets
+    for (const auto& targetUuidAndTechniques : targetToTechniques)
+    {
+        if (targetUuidAndTechniques.second.size() < 2)
+            continue;
+
+        const auto& transientTarget = _transientTargets.at(targetUuidAndTechniques.first);
+        AbstractTexturePtr texture;
+
+        if (transientTarget.isCube)
+        {
+            auto cubeTexture = CubeTexture::create(_options->context(), transientTarget.width, transientTarget.height, false, true);
+
+            _assetLibrary->cubeTexture(transientTarget.name, cubeTexture);
+            texture = cubeTexture;
+        }
+        else
+        {
+            auto texture2D = Texture::create(_options->context(), transientTarget.width, transientTarget.height, false, true);
+
+            _assetLibrary->texture(transientTarget.name, texture2D);
+            texture = texture2D;
+        }
+
+        texture->upload();
+        textures[targetUuidAndTechniques.first] = texture;
+    }
+
+    for (auto& technique : _globalScope.techniques)
+        for (auto pass : technique.second)
+        {
+            auto textureIt = textures.find(pass->states().target().uuid);
+
+            if (textureIt != textures.end())
+                pass->states().target(textureIt->second->sampler());
+        }
+
+    for (const auto& transientTarget : _transientTargets)
+    {
+        auto textureIt = textures.find(transientTarget.first);
+
+        if (textureIt != textures.end())
+            _effectData->set(transientTarget.second.name, textureIt->second->sampler());
+        else
+            _effectData->unset(transientTarget.second.name);
+    }
+}
+
 void
 EffectParser::finalize()
 {
+    if (!_transientTargets.empty())
+        allocateTransientTargets();
+
     for (auto& technique : _globalScope.techniques)
     {
         _effect->addTechnique(technique.first, technique.second);
@@ -43,7 +43,8 @@ MipMapChainParser::parseTexture(std::shared_ptr<AbstractContext>   context,
                                 bool                               mipMapping,
                                 bool                               smooth,
                                 TextureFormat                      format,
-                                const std::string&                 filename)
+                                const std::string&                 filename,
+                                bool                               upload)
 {
     const unsigned int numLevels = mipMapping && parseMipMaps ? AbstractTexture::numMipMaps(width, height) : 1u;
     unsigned int actualHeight = height;
@@ -72,7 +73,6 @@ MipMapChainParser::parseTexture(std::shared_ptr<AbstractContext>   context,
 
     parseMipMap(&rgba[0], data, width, height, math::ivec2(0), width, actualHeight, bytesPerPixel);
     texture->data(&rgba[0]);
-    texture->upload();
 
     auto& textureRgbaData = texture->data();
 
@@ -94,15 +94,38 @@ MipMapChainParser::parseTexture(std::shared_ptr<AbstractContext>   context,
             parseMipMap(&textureRgbaData[rgbaOffset], data + dataOffset, width, height, math::ivec2(0), width >> level, actualHeight >> level, bytesPerPixel);
 
             dataOffset += width * (actualHeight >> level) * bytesPerPixel;
-            texture->uploadMipLevel(level, &textureRgbaData[rgbaOffset]);
-
             rgbaOffset += mipMapSize;
         }
     }
 
+    if (upload)
+        uploadTexture(texture);
+
     return texture;
 }
 
+void
+MipMapChainParser::uploadTexture(Texture::Ptr texture)
+{
+    texture->upload();
+
+    auto& data = texture->data();
+    auto width = texture->width();
+    auto height = texture->height();
+    auto offset = width * height * 4u;
+
+    // mip levels parsed from the source image are stored after the first level
+    for (uint level = 1; offset < data.size() && (width > 1 || height > 1); ++level)
+    {
+        width = math::max(width >> 1, 1u);
+        height = math::max(height >> 1, 1u);
+
+        texture->uploadMipLevel(level, &data[offset]);
+
+        offset += width * height * 4u;
+    }
+}
+
 CubeTexture::Ptr
 MipMapChainParser::parseCubeTexture(std::shared_ptr<AbstractContext>   context,
                                     uint             		           width,
@@ -112,7 +135,8 @@ MipMapChainParser::parseCubeTexture(std::shared_ptr<AbstractContext>   context,
                                     bool                               mipMapping,
                                     bool                               smooth,
                                     TextureFormat                      format,
-                                    const std::string&                 filename)
+                                    const std::string&                 filename,
+                                    bool                               upload)
 {
     int faceSize = width / 4;
 
@@ -157,6 +181,11 @@ MipMapChainParser::parseCubeTexture(std::shared_ptr<AbstractContext>   context,
         this->parseMipMap(&rgba[0], data, width, height, offset, faceSize, faceSize, bytesPerPixel);
         texture->data(&rgba[0], face);
     }
+
+    // cube textures do not store their mip levels: when the upload is deferred, they are generated on upload
+    if (!upload)
+        return texture;
+
     texture->upload();
 
     auto eof = width * height * bytesPerPixel;
@@ -55,11 +55,13 @@ Options::Options() :
     _includeAnimation(true),
     _startAnimation(true),
     _loadAsynchronously(false),
+    _loadTexturesAsynchronously(false),
     _disposeIndexBufferAfterLoading(false),
     _disposeVertexBufferAfterLoading(false),
     _disposeTextureAfterLoading(false),
     _storeDataIfNotParsed(true),
     _preserveMaterials(true),
+    _allowUnsignedIntIndices(false),
     _trackAssetDescriptor(false),
     _skinningFramerate(30),
     _skinningMethod(component::SkinningMethod::HARDWARE),
@@ -120,6 +122,7 @@ Options::Options(const Options& copy) :
     _disposeTextureAfterLoading(copy._disposeTextureAfterLoading),
     _storeDataIfNotParsed(copy._storeDataIfNotParsed),
     _preserveMaterials(copy._preserveMaterials),
+    _allowUnsignedIntIndices(copy._allowUnsignedIntIndices),
     _trackAssetDescriptor(copy._trackAssetDescriptor),
     _skinningFramerate(copy._skinningFramerate),
     _skinningMethod(copy._skinningMethod),
@@ -140,6 +143,7 @@ Options::Options(const Options& copy) :
     _preventLoadingFunction(copy._preventLoadingFunction),
     _retryOnErrorFunction(copy._retryOnErrorFunction),
     _loadAsynchronously(copy._loadAsynchronously),
+    _loadTexturesAsynchronously(copy._loadTexturesAsynchronously),
     _seekingOffset(copy._seekingOffset),
     _seekedLength(copy._seekedLength),
     _cache(copy._cache),
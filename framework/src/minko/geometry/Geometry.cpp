@@ -459,8 +459,9 @@ Geometry::cast(std::shared_ptr<math::Ray>	ray,
 	static const auto EPSILON = 0.00001f;
 
 	auto hit = false;
-	auto& indicesData = _indexBuffer->data();
-	auto numIndices = indicesData.size();
+    const auto ushortIndices = _indexBuffer->dataPointer<unsigned short>();
+    const auto uintIndices = _indexBuffer->dataPointer<unsigned int>();
+	auto numIndices = ushortIndices ? ushortIndices->size() : uintIndices->size();
 
 	auto xyzBuffer = vertexBuffer("position");
 	auto& xyzData = xyzBuffer->data();
@@ -503,9 +504,9 @@ Geometry::cast(std::shared_ptr<math::Ray>	ray,
             }
         }
 
-		v0 = math::make_vec3(xyzPtr + indicesData[i] * xyzVertexSize);
-		v1 = math::make_vec3(xyzPtr + indicesData[i + 1] * xyzVertexSize);
-		v2 = math::make_vec3(xyzPtr + indicesData[i + 2] * xyzVertexSize);
+		v0 = math::make_vec3(xyzPtr + indexAt(i) * xyzVertexSize);
+		v1 = math::make_vec3(xyzPtr + indexAt(i + 1) * xyzVertexSize);
+		v2 = math::make_vec3(xyzPtr + indexAt(i + 2) * xyzVertexSize);
 
 		edge1 = v1 - v0;
 		edge2 = v2 - v0;
@@ -570,16 +571,15 @@ Geometry::getHitUv(uint triangle, math::vec2& lambda, math::vec2* hitUv)
 	auto uvPtr = &uvData[0];
 	auto uvVertexSize = uvBuffer->vertexSize();
 	auto uvOffset = uvBuffer->attribute("uv").offset;
-	auto& indicesData = _indexBuffer->data();
 
-	auto u0 = uvData[indicesData[triangle] * uvVertexSize + uvOffset];
-	auto v0 = uvData[indicesData[triangle] * uvVertexSize + uvOffset + 1];
+	auto u0 = uvData[indexAt(triangle) * uvVertexSize + uvOffset];
+	auto v0 = uvData[indexAt(triangle) * uvVertexSize + uvOffset + 1];
 
-	auto u1 = uvData[indicesData[triangle + 1] * uvVertexSize + uvOffset];
-	auto v1 = uvData[indicesData[triangle + 1] * uvVertexSize + uvOffset + 1];
+	auto u1 = uvData[indexAt(triangle + 1) * uvVertexSize + uvOffset];
+	auto v1 = uvData[indexAt(triangle + 1) * uvVertexSize + uvOffset + 1];
 
-	auto u2 = uvData[indicesData[triangle + 2] * uvVertexSize + uvOffset];
-	auto v2 = uvData[indicesData[triangle + 2] * uvVertexSize + uvOffset + 1];
+	auto u2 = uvData[indexAt(triangle + 2) * uvVertexSize + uvOffset];
+	auto v2 = uvData[indexAt(triangle + 2) * uvVertexSize + uvOffset + 1];
 
 	auto z = 1.f - lambda.x - lambda.y;
 
@@ -597,11 +597,10 @@ Geometry::getHitNormal(uint triangle, math::vec3* hitNormal)
 	auto normalPtr = &normalData[0];
 	auto normalVertexSize = normalBuffer->vertexSize();
 	auto normalOffset = normalBuffer->attribute("normal").offset;
-	auto& indicesData = _indexBuffer->data();
 
-	auto v0 = math::make_vec3(normalPtr + indicesData[triangle] * normalVertexSize + normalOffset);
-	auto v1 = math::make_vec3(normalPtr + indicesData[triangle + 1] * normalVertexSize + normalOffset);
-	auto v2 = math::make_vec3(normalPtr + indicesData[triangle + 2] * normalVertexSize + normalOffset);
+	auto v0 = math::make_vec3(normalPtr + indexAt(triangle) * normalVertexSize + normalOffset);
+	auto v1 = math::make_vec3(normalPtr + indexAt(triangle + 1) * normalVertexSize + normalOffset);
+	auto v2 = math::make_vec3(normalPtr + indexAt(triangle + 2) * normalVertexSize + normalOffset);
 
     *hitNormal = math::normalize((v0 + v1 + v2) / 3.f);
 }
@@ -0,0 +1,192 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/BufferUploadQueue.hpp"
+
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/render/IndexBuffer.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+// past half of the buffer, waiting for the GPU costs more than uploading the untouched vertices
+const float BufferUploadQueue::DEFAULT_ORPHAN_RATIO = .5f;
+
+BufferUploadQueue::BufferUploadQueue() :
+    _orphanRatio(DEFAULT_ORPHAN_RATIO),
+    _numUploadedBytes(0u),
+    _numUploadsLastFrame(0u),
+    _numUploadedBytesLastFrame(0u),
+    _numOrphanedBuffersLastFrame(0u)
+{
+}
+
+void
+BufferUploadQueue::upload(VertexBufferPtr vertexBuffer, uint offset, uint numVertices)
+{
+    auto rangesIt = _vertexBufferRanges.find(vertexBuffer);
+
+    if (rangesIt == _vertexBufferRanges.end())
+    {
+        _vertexBuffers.push_back(vertexBuffer);
+        rangesIt = _vertexBufferRanges.emplace(vertexBuffer, std::vector<Range>()).first;
+    }
+
+    // the end of the buffer is resolved by update(), the buffer may grow in between
+    rangesIt->second.push_back({ offset, numVertices == 0 ? std::numeric_limits<uint>::max() : offset + numVertices });
+}
+
+void
+BufferUploadQueue::upload(IndexBufferPtr indexBuffer)
+{
+    if (_queuedIndexBuffers.insert(indexBuffer).second)
+        _indexBuffers.push_back(indexBuffer);
+}
+
+void
+BufferUploadQueue::cancel(VertexBufferPtr vertexBuffer)
+{
+    if (_vertexBufferRanges.erase(vertexBuffer) != 0)
+        _vertexBuffers.erase(std::find(_vertexBuffers.begin(), _vertexBuffers.end(), vertexBuffer));
+}
+
+void
+BufferUploadQueue::cancel(IndexBufferPtr indexBuffer)
+{
+    if (_queuedIndexBuffers.erase(indexBuffer) != 0)
+        _indexBuffers.erase(std::find(_indexBuffers.begin(), _indexBuffers.end(), indexBuffer));
+}
+
+void
+BufferUploadQueue::update()
+{
+    _numUploadsLastFrame = 0u;
+    _numUploadedBytesLastFrame = 0u;
+    _numOrphanedBuffersLastFrame = 0u;
+
+    // swapped first: uploads can trigger signals whose listeners queue new uploads for the next frame
+    std::vector<VertexBufferPtr> vertexBuffers;
+    std::unordered_map<VertexBufferPtr, std::vector<Range>> vertexBufferRanges;
+    std::vector<IndexBufferPtr> indexBuffers;
+
+    vertexBuffers.swap(_vertexBuffers);
+    vertexBufferRanges.swap(_vertexBufferRanges);
+    indexBuffers.swap(_indexBuffers);
+    _queuedIndexBuffers.clear();
+
+    for (const auto& vertexBuffer : vertexBuffers)
+        uploadVertexBuffer(vertexBuffer, vertexBufferRanges[vertexBuffer]);
+
+    for (const auto& indexBuffer : indexBuffers)
+        uploadIndexBuffer(indexBuffer);
+
+    _numUploadedBytes += _numUploadedBytesLastFrame;
+}
+
+void
+BufferUploadQueue::uploadVertexBuffer(VertexBufferPtr vertexBuffer, std::vector<Range>& ranges)
+{
+    const auto numVertices = vertexBuffer->numVertices();
+
+    if (numVertices == 0)
+        return;
+
+    const auto vertexBytes = (vertexBuffer->isPacked() ? vertexBuffer->packedVertexSize() : vertexBuffer->vertexSize())
+        * static_cast<uint>(sizeof(float));
+
+    std::sort(ranges.begin(), ranges.end(), [](const Range& left, const Range& right)
+    {
+        return left.begin < right.begin;
+    });
+
+    // coalesce the overlapping and contiguous ranges
+    auto numRanges = 0u;
+    auto numQueuedVertices = 0u;
+
+    for (const auto& range : ranges)
+    {
+        const auto end = std::min(range.end, numVertices);
+
+        if (range.begin >= end)
+            continue;
+
+        if (numRanges != 0 && range.begin <= ranges[numRanges - 1].end)
+        {
+            auto& last = ranges[numRanges - 1];
+
+            numQueuedVertices += std::max(end, last.end) - last.end;
+            last.end = std::max(end, last.end);
+        }
+        else
+        {
+            ranges[numRanges++] = { range.begin, end };
+            numQueuedVertices += end - range.begin;
+        }
+    }
+
+    if (numRanges == 0)
+        return;
+
+    // a buffer never uploaded has no storage to wait for
+    if (!vertexBuffer->isReady() || numQueuedVertices >= _orphanRatio * numVertices)
+    {
+        if (vertexBuffer->isReady())
+        {
+            vertexBuffer->orphan();
+            ++_numOrphanedBuffersLastFrame;
+        }
+
+        vertexBuffer->upload();
+
+        ++_numUploadsLastFrame;
+        _numUploadedBytesLastFrame += numVertices * vertexBytes;
+
+        return;
+    }
+
+    for (auto i = 0u; i < numRanges; ++i)
+    {
+        vertexBuffer->upload(ranges[i].begin, ranges[i].end - ranges[i].begin);
+
+        ++_numUploadsLastFrame;
+        _numUploadedBytesLastFrame += (ranges[i].end - ranges[i].begin) * vertexBytes;
+    }
+}
+
+void
+BufferUploadQueue::uploadIndexBuffer(IndexBufferPtr indexBuffer)
+{
+    const auto numIndices = indexBuffer->dataPointer<unsigned int>()
+        ? indexBuffer->dataPointer<unsigned int>()->size()
+        : indexBuffer->data().size();
+
+    if (numIndices == 0)
+        return;
+
+    if (indexBuffer->isReady() && _orphanRatio <= 1.f)
+    {
+        indexBuffer->orphan();
+        ++_numOrphanedBuffersLastFrame;
+    }
+
+    indexBuffer->upload();
+
+    ++_numUploadsLastFrame;
+    _numUploadedBytesLastFrame += static_cast<uint>(numIndices) * indexBuffer->indexSize();
+}
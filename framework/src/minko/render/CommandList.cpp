@@ -0,0 +1,534 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/CommandList.hpp"
+
+#include "minko/render/DrawCall.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+    class CommandReader
+    {
+    private:
+        const unsigned char*    _position;
+
+    public:
+        explicit
+        CommandReader(const unsigned char* position) :
+            _position(position)
+        {
+        }
+
+        inline
+        const unsigned char*
+        position() const
+        {
+            return _position;
+        }
+
+        template <typename T>
+        inline
+        T
+        read()
+        {
+            T value;
+
+            std::memcpy(&value, _position, sizeof(T));
+            _position += sizeof(T);
+
+            return value;
+        }
+
+        // uniform values are not aligned in the buffer, hence the copy
+        template <typename T>
+        inline
+        const T*
+        readArray(uint size, std::vector<T>& values)
+        {
+            values.resize(size);
+            std::memcpy(values.data(), _position, size * sizeof(T));
+            _position += size * sizeof(T);
+
+            return values.data();
+        }
+    };
+}
+
+CommandList::CommandList() :
+    _numCommands(0),
+    _renderTarget(0)
+{
+}
+
+void
+CommandList::reset()
+{
+    _buffer.clear();
+    _numCommands = 0;
+    _renderTarget = 0;
+}
+
+void
+CommandList::writeCommand(Command command)
+{
+    write(command);
+    ++_numCommands;
+}
+
+void
+CommandList::writeUniform(Command command, uint location, uint count, const void* data, uint size)
+{
+    writeCommand(command);
+    write(location);
+    write(count);
+
+    auto position = _buffer.size();
+
+    _buffer.resize(position + size);
+    std::memcpy(&_buffer[position], data, size);
+}
+
+void
+CommandList::submit(AbstractContext& context) const
+{
+    if (_buffer.empty())
+        return;
+
+    CommandReader reader(&_buffer[0]);
+    const auto* end = reader.position() + _buffer.size();
+    std::vector<float> floats;
+    std::vector<int> ints;
+
+    while (reader.position() != end)
+    {
+        auto command = reader.read<Command>();
+
+        switch (command)
+        {
+        case Command::CLEAR:
+        {
+            auto clearFlags = reader.read<uint>();
+            auto red = reader.read<float>();
+            auto green = reader.read<float>();
+            auto blue = reader.read<float>();
+            auto alpha = reader.read<float>();
+            auto depth = reader.read<float>();
+            auto stencil = reader.read<unsigned int>();
+            auto mask = reader.read<unsigned int>();
+
+            context.clear(clearFlags, red, green, blue, alpha, depth, stencil, mask);
+            break;
+        }
+        case Command::CONFIGURE_VIEWPORT:
+        {
+            auto x = reader.read<uint>();
+            auto y = reader.read<uint>();
+            auto width = reader.read<uint>();
+            auto height = reader.read<uint>();
+
+            context.configureViewport(x, y, width, height);
+            break;
+        }
+        case Command::DRAW_TRIANGLES:
+        {
+            auto firstIndex = reader.read<uint>();
+            auto numTriangles = reader.read<int>();
+
+            context.drawTriangles(firstIndex, numTriangles);
+            break;
+        }
+        case Command::DRAW_INDEXED_TRIANGLES:
+        {
+            auto indexBuffer = reader.read<uint>();
+            auto firstIndex = reader.read<uint>();
+            auto numTriangles = reader.read<int>();
+
+            context.drawTriangles(indexBuffer, firstIndex, numTriangles);
+            break;
+        }
+        case Command::SET_PROGRAM:
+            context.setProgram(reader.read<uint>());
+            break;
+        case Command::SET_RENDER_TO_BACK_BUFFER:
+            context.setRenderToBackBuffer();
+            break;
+        case Command::SET_RENDER_TO_TEXTURE:
+        {
+            auto texture = reader.read<uint>();
+            auto enableDepthAndStencil = reader.read<bool>();
+
+            context.setRenderToTexture(texture, enableDepthAndStencil);
+            break;
+        }
+        case Command::SET_UNIFORM_FLOAT:
+        case Command::SET_UNIFORM_FLOAT2:
+        case Command::SET_UNIFORM_FLOAT3:
+        case Command::SET_UNIFORM_FLOAT4:
+        case Command::SET_UNIFORM_MATRIX4X4:
+        {
+            auto location = reader.read<uint>();
+            auto count = reader.read<uint>();
+
+            if (command == Command::SET_UNIFORM_FLOAT)
+                context.setUniformFloat(location, count, reader.readArray(count, floats));
+            else if (command == Command::SET_UNIFORM_FLOAT2)
+                context.setUniformFloat2(location, count, reader.readArray(count * 2, floats));
+            else if (command == Command::SET_UNIFORM_FLOAT3)
+                context.setUniformFloat3(location, count, reader.readArray(count * 3, floats));
+            else if (command == Command::SET_UNIFORM_FLOAT4)
+                context.setUniformFloat4(location, count, reader.readArray(count * 4, floats));
+            else
+                context.setUniformMatrix4x4(location, count, reader.readArray(count * 16, floats));
+            break;
+        }
+        case Command::SET_UNIFORM_INT:
+        case Command::SET_UNIFORM_INT2:
+        case Command::SET_UNIFORM_INT3:
+        case Command::SET_UNIFORM_INT4:
+        {
+            auto location = reader.read<uint>();
+            auto count = reader.read<uint>();
+
+            if (command == Command::SET_UNIFORM_INT)
+                context.setUniformInt(location, count, reader.readArray(count, ints));
+            else if (command == Command::SET_UNIFORM_INT2)
+                context.setUniformInt2(location, count, reader.readArray(count * 2, ints));
+            else if (command == Command::SET_UNIFORM_INT3)
+                context.setUniformInt3(location, count, reader.readArray(count * 3, ints));
+            else
+                context.setUniformInt4(location, count, reader.readArray(count * 4, ints));
+            break;
+        }
+        case Command::SET_TEXTURE_AT:
+        {
+            auto position = reader.read<uint>();
+            auto texture = reader.read<int>();
+            auto location = reader.read<int>();
+
+            context.setTextureAt(position, texture, location);
+            break;
+        }
+        case Command::SET_SAMPLER_STATE_AT:
+        {
+            auto position = reader.read<uint>();
+            auto wrapping = reader.read<WrapMode>();
+            auto filtering = reader.read<TextureFilter>();
+            auto mipFiltering = reader.read<MipFilter>();
+
+            context.setSamplerStateAt(position, wrapping, filtering, mipFiltering);
+            break;
+        }
+        case Command::SET_VERTEX_BUFFER_AT:
+        {
+            auto position = reader.read<uint>();
+            auto vertexBuffer = reader.read<uint>();
+            auto size = reader.read<uint>();
+            auto stride = reader.read<uint>();
+            auto offset = reader.read<uint>();
+            auto format = reader.read<VertexAttribute::Format>();
+
+            context.setVertexBufferAt(position, vertexBuffer, size, stride, offset, format);
+            break;
+        }
+        case Command::SET_VERTEX_ATTRIBUTE_ARRAY:
+            context.setVertexAttributeArray(reader.read<uint>());
+            break;
+        case Command::BIND_VERTEX_ATTRIBUTES:
+            reader.read<DrawCall*>()->bindVertexAttributes(context);
+            break;
+        case Command::SET_BLENDING_MODE:
+        {
+            auto source = reader.read<Blending::Source>();
+            auto destination = reader.read<Blending::Destination>();
+
+            context.setBlendingMode(source, destination);
+            break;
+        }
+        case Command::SET_COLOR_MASK:
+            context.setColorMask(reader.read<bool>());
+            break;
+        case Command::SET_DEPTH_TEST:
+        {
+            auto depthMask = reader.read<bool>();
+            auto depthFunc = reader.read<CompareMode>();
+
+            context.setDepthTest(depthMask, depthFunc);
+            break;
+        }
+        case Command::SET_STENCIL_TEST:
+        {
+            auto stencilFunc = reader.read<CompareMode>();
+            auto stencilRef = reader.read<int>();
+            auto stencilMask = reader.read<uint>();
+            auto stencilFailOp = reader.read<StencilOperation>();
+            auto stencilZFailOp = reader.read<StencilOperation>();
+            auto stencilZPassOp = reader.read<StencilOperation>();
+
+            context.setStencilTest(stencilFunc, stencilRef, stencilMask, stencilFailOp, stencilZFailOp, stencilZPassOp);
+            break;
+        }
+        case Command::SET_SCISSOR_TEST:
+        {
+            auto scissorTest = reader.read<bool>();
+            auto scissorBox = reader.read<math::ivec4>();
+
+            context.setScissorTest(scissorTest, scissorBox);
+            break;
+        }
+        case Command::SET_TRIANGLE_CULLING:
+            context.setTriangleCulling(reader.read<TriangleCulling>());
+            break;
+        }
+    }
+}
+
+void
+CommandList::configureViewport(const uint x, const uint y, const uint width, const uint height)
+{
+    writeCommand(Command::CONFIGURE_VIEWPORT);
+    write(x);
+    write(y);
+    write(width);
+    write(height);
+}
+
+void
+CommandList::clear(uint         clearFlags,
+                   float        red,
+                   float        green,
+                   float        blue,
+                   float        alpha,
+                   float        depth,
+                   unsigned int stencil,
+                   unsigned int mask)
+{
+    writeCommand(Command::CLEAR);
+    write(clearFlags);
+    write(red);
+    write(green);
+    write(blue);
+    write(alpha);
+    write(depth);
+    write(stencil);
+    write(mask);
+}
+
+void
+CommandList::drawTriangles(const uint indexBuffer, const uint firstIndex, const int numTriangles)
+{
+    writeCommand(Command::DRAW_INDEXED_TRIANGLES);
+    write(indexBuffer);
+    write(firstIndex);
+    write(numTriangles);
+}
+
+void
+CommandList::drawTriangles(const uint firstIndex, const int numTriangles)
+{
+    writeCommand(Command::DRAW_TRIANGLES);
+    write(firstIndex);
+    write(numTriangles);
+}
+
+void
+CommandList::setProgram(const uint program)
+{
+    writeCommand(Command::SET_PROGRAM);
+    write(program);
+}
+
+void
+CommandList::setRenderToBackBuffer()
+{
+    writeCommand(Command::SET_RENDER_TO_BACK_BUFFER);
+
+    _renderTarget = 0;
+}
+
+void
+CommandList::setRenderToTexture(unsigned int texture, bool enableDepthAndStencil)
+{
+    writeCommand(Command::SET_RENDER_TO_TEXTURE);
+    write(texture);
+    write(enableDepthAndStencil);
+
+    _renderTarget = texture;
+}
+
+void
+CommandList::setUniformFloat(uint location, uint count, const float* v)
+{
+    writeUniform(Command::SET_UNIFORM_FLOAT, location, count, v, count * sizeof(float));
+}
+
+void
+CommandList::setUniformFloat2(uint location, uint count, const float* v)
+{
+    writeUniform(Command::SET_UNIFORM_FLOAT2, location, count, v, count * 2 * sizeof(float));
+}
+
+void
+CommandList::setUniformFloat3(uint location, uint count, const float* v)
+{
+    writeUniform(Command::SET_UNIFORM_FLOAT3, location, count, v, count * 3 * sizeof(float));
+}
+
+void
+CommandList::setUniformFloat4(uint location, uint count, const float* v)
+{
+    writeUniform(Command::SET_UNIFORM_FLOAT4, location, count, v, count * 4 * sizeof(float));
+}
+
+void
+CommandList::setUniformMatrix4x4(uint location, uint count, const float* v)
+{
+    writeUniform(Command::SET_UNIFORM_MATRIX4X4, location, count, v, count * 16 * sizeof(float));
+}
+
+void
+CommandList::setUniformInt(uint location, uint count, const int* v)
+{
+    writeUniform(Command::SET_UNIFORM_INT, location, count, v, count * sizeof(int));
+}
+
+void
+CommandList::setUniformInt2(uint location, uint count, const int* v)
+{
+    writeUniform(Command::SET_UNIFORM_INT2, location, count, v, count * 2 * sizeof(int));
+}
+
+void
+CommandList::setUniformInt3(uint location, uint count, const int* v)
+{
+    writeUniform(Command::SET_UNIFORM_INT3, location, count, v, count * 3 * sizeof(int));
+}
+
+void
+CommandList::setUniformInt4(uint location, uint count, const int* v)
+{
+    writeUniform(Command::SET_UNIFORM_INT4, location, count, v, count * 4 * sizeof(int));
+}
+
+void
+CommandList::setTextureAt(uint position, int texture, int location)
+{
+    writeCommand(Command::SET_TEXTURE_AT);
+    write(position);
+    write(texture);
+    write(location);
+}
+
+void
+CommandList::setSamplerStateAt(uint position, WrapMode wrapping, TextureFilter filtering, MipFilter mipFiltering)
+{
+    writeCommand(Command::SET_SAMPLER_STATE_AT);
+    write(position);
+    write(wrapping);
+    write(filtering);
+    write(mipFiltering);
+}
+
+void
+CommandList::setVertexBufferAt(const uint                       position,
+                               const uint                       vertexBuffer,
+                               const uint                       size,
+                               const uint                       stride,
+                               const uint                       offset,
+                               const VertexAttribute::Format    format)
+{
+    writeCommand(Command::SET_VERTEX_BUFFER_AT);
+    write(position);
+    write(vertexBuffer);
+    write(size);
+    write(stride);
+    write(offset);
+    write(format);
+}
+
+void
+CommandList::setVertexAttributeArray(const uint vertexArray)
+{
+    writeCommand(Command::SET_VERTEX_ATTRIBUTE_ARRAY);
+    write(vertexArray);
+}
+
+void
+CommandList::bindVertexAttributes(DrawCall* drawCall)
+{
+    writeCommand(Command::BIND_VERTEX_ATTRIBUTES);
+    write(drawCall);
+}
+
+void
+CommandList::setBlendingMode(Blending::Source source, Blending::Destination destination)
+{
+    writeCommand(Command::SET_BLENDING_MODE);
+    write(source);
+    write(destination);
+}
+
+void
+CommandList::setColorMask(bool colorMask)
+{
+    writeCommand(Command::SET_COLOR_MASK);
+    write(colorMask);
+}
+
+void
+CommandList::setDepthTest(bool depthMask, CompareMode depthFunc)
+{
+    writeCommand(Command::SET_DEPTH_TEST);
+    write(depthMask);
+    write(depthFunc);
+}
+
+void
+CommandList::setStencilTest(CompareMode         stencilFunc,
+                            int                 stencilRef,
+                            uint                stencilMask,
+                            StencilOperation    stencilFailOp,
+                            StencilOperation    stencilZFailOp,
+                            StencilOperation    stencilZPassOp)
+{
+    writeCommand(Command::SET_STENCIL_TEST);
+    write(stencilFunc);
+    write(stencilRef);
+    write(stencilMask);
+    write(stencilFailOp);
+    write(stencilZFailOp);
+    write(stencilZPassOp);
+}
+
+void
+CommandList::setScissorTest(bool scissorTest, const math::ivec4& scissorBox)
+{
+    writeCommand(Command::SET_SCISSOR_TEST);
+    write(scissorTest);
+    write(scissorBox);
+}
+
+void
+CommandList::setTriangleCulling(TriangleCulling triangleCulling)
+{
+    writeCommand(Command::SET_TRIANGLE_CULLING);
+    write(triangleCulling);
+}
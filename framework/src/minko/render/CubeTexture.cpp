@@ -72,8 +72,9 @@ CubeTexture::resize(unsigned int width, unsigned int height, bool resizeSmoothly
 
     for (int faceId = 0; faceId < 6; ++faceId)
     {
-        auto previousData = _data[faceId];
+        auto previousData = std::vector<unsigned char>();
 
+        previousData.swap(_data[faceId]);
         resizeData(previousWidth, previousHeight, &previousData[0], width, height, resizeSmoothly, _data[faceId]);
     }
 
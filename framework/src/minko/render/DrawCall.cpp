@@ -18,6 +18,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 */
 
 #include "minko/render/DrawCall.hpp"
+#include "minko/render/DrawCallTemplate.hpp"
+#include "minko/render/CommandList.hpp"
 
 #include "minko/data/Store.hpp"
 #include "minko/log/Logger.hpp"
@@ -122,6 +124,7 @@ DrawCall::reset()
     _vertexAttribArray = 0;
 
     _program = nullptr;
+    _template = nullptr;
     _indexBuffer = nullptr;
     _firstIndex = nullptr;
     _numIndices = nullptr;
@@ -133,11 +136,12 @@ DrawCall::reset()
 }
 
 void
-DrawCall::bind(std::shared_ptr<Program> program)
+DrawCall::bind(std::shared_ptr<Program> program, std::shared_ptr<DrawCallTemplate> drawCallTemplate)
 {
     reset();
 
     _program = program;
+    _template = drawCallTemplate;
 
     // bindIndexBuffer();
     // bindStates();
@@ -268,8 +272,9 @@ DrawCall::setAttributeValueFromStore(const ProgramInputs::AttributeInput& input,
         input.location,
         attr->resourceId,
         attr->size,
-        attr->vertexSize,
-        attr->offset
+        attr->packedVertexSize,
+        attr->packedOffset,
+        attr->format
     });
 }
 
@@ -635,22 +640,16 @@ DrawCall::setStateValueFromStore(const std::string&   stateName,
 void
 DrawCall::bindIndexBuffer()
 {
-    auto indexBufferProperty = data::Store::getActualPropertyName(_variables, "geometry[${geometryUuid}].indices");
+    auto indexBufferProperty = actualPropertyName("geometry[${geometryUuid}].indices");
 
     if (_targetData.hasProperty(indexBufferProperty))
         _indexBuffer = _targetData.getPointer<int>(indexBufferProperty);
 
-    auto surfaceFirstIndexProperty = data::Store::getActualPropertyName(
-        _variables,
-        "surface[${surfaceUuid}].firstIndex"
-    );
+    auto surfaceFirstIndexProperty = actualPropertyName("surface[${surfaceUuid}].firstIndex");
 
     if (!_targetData.hasProperty(surfaceFirstIndexProperty))
     {
-        auto geometryFirstIndexProperty = data::Store::getActualPropertyName(
-            _variables,
-            "geometry[${geometryUuid}].firstIndex"
-        );
+        auto geometryFirstIndexProperty = actualPropertyName("geometry[${geometryUuid}].firstIndex");
 
         if (_targetData.hasProperty(geometryFirstIndexProperty))
             _firstIndex = _targetData.getPointer<uint>(geometryFirstIndexProperty);
@@ -660,17 +659,11 @@ DrawCall::bindIndexBuffer()
         _firstIndex = _targetData.getPointer<uint>(surfaceFirstIndexProperty);
     }
 
-    auto surfaceNumIndicesProperty = data::Store::getActualPropertyName(
-        _variables,
-        "surface[${surfaceUuid}].numIndices"
-    );
+    auto surfaceNumIndicesProperty = actualPropertyName("surface[${surfaceUuid}].numIndices");
 
     if (!_targetData.hasProperty(surfaceNumIndicesProperty))
     {
-        auto geometryNumIndicesProperty = data::Store::getActualPropertyName(
-            _variables,
-            "geometry[${geometryUuid}].numIndices"
-        );
+        auto geometryNumIndicesProperty = actualPropertyName("geometry[${geometryUuid}].numIndices");
 
         if (_targetData.hasProperty(geometryNumIndicesProperty))
             _numIndices = _targetData.getPointer<uint>(geometryNumIndicesProperty);
@@ -738,26 +731,80 @@ DrawCall::render(AbstractContext::Ptr   context,
                  AbstractTexture::Ptr   renderTarget,
                  const math::ivec4&     viewport,
                  uint                   clearColor)
+{
+    issue(*context, renderTarget, viewport, clearColor);
+}
+
+void
+DrawCall::record(CommandList&           commandList,
+                 AbstractTexture::Ptr   renderTarget,
+                 const math::ivec4&     viewport,
+                 uint                   clearColor)
+{
+    issue(commandList, renderTarget, viewport, clearColor);
+}
+
+void
+DrawCall::bindVertexAttributes(AbstractContext& context)
+{
+    if (_vertexAttribArray == 0)
+    {
+        _vertexAttribArray = context.createVertexAttributeArray();
+
+        if (_vertexAttribArray != -1)
+        {
+            context.setVertexAttributeArray(_vertexAttribArray);
+            for (const auto& a : _attributes)
+                context.setVertexBufferAt(a.location, *a.resourceId, a.size, *a.stride, a.offset, a.format);
+        }
+    }
+    if (_vertexAttribArray != -1)
+        context.setVertexAttributeArray(_vertexAttribArray);
+    else
+        for (const auto& a : _attributes)
+            context.setVertexBufferAt(a.location, *a.resourceId, a.size, *a.stride, a.offset, a.format);
+}
+
+void
+DrawCall::bindVertexAttributes(CommandList& commandList)
+{
+    // vertex attribute arrays can only be created on the context, when the list is submitted
+    if (_vertexAttribArray == 0)
+        commandList.bindVertexAttributes(this);
+    else if (_vertexAttribArray != -1)
+        commandList.setVertexAttributeArray(_vertexAttribArray);
+    else
+        for (const auto& a : _attributes)
+            commandList.setVertexBufferAt(a.location, *a.resourceId, a.size, *a.stride, a.offset, a.format);
+}
+
+template <typename Context>
+void
+DrawCall::issue(Context&               context,
+                AbstractTexture::Ptr   renderTarget,
+                const math::ivec4&     viewport,
+                uint                   clearColor)
 {
     if (!this->enabled())
         return;
 
-    context->setProgram(_program->id());
+    context.setProgram(_program->id());
 
     auto hasOwnTarget = _target && _target->id;
-    auto renderTargetId = hasOwnTarget
+    // resource ids are signed but the contexts report their render target as unsigned
+    auto renderTargetId = static_cast<uint>(hasOwnTarget
         ? *_target->id
-        : renderTarget ? renderTarget->id() : 0;
+        : renderTarget ? renderTarget->id() : 0);
     bool targetChanged = false;
 
     if (renderTargetId)
     {
-        if (renderTargetId != context->renderTarget())
+        if (renderTargetId != context.renderTarget())
         {
-            context->setRenderToTexture(renderTargetId, true);
+            context.setRenderToTexture(renderTargetId, true);
 
             if (hasOwnTarget)
-                context->clear(
+                context.clear(
                     // FIXME: the DrawCall should keep track of the clear flags
                     ClearFlags::DEPTH | ClearFlags::STENCIL | ClearFlags::COLOR,
                     ((clearColor >> 24) & 0xff) / 255.f,
@@ -770,144 +817,113 @@ DrawCall::render(AbstractContext::Ptr   context,
         }
     }
     else
-        context->setRenderToBackBuffer();
+        context.setRenderToBackBuffer();
 
     if (targetChanged && !hasOwnTarget && viewport.z >= 0 && viewport.w >= 0)
-        context->configureViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+        context.configureViewport(viewport.x, viewport.y, viewport.z, viewport.w);
 
     for (const auto& u : _uniformBool)
     {
         if (u.size == 1)
-            context->setUniformInt(u.location, u.count, u.data);
+            context.setUniformInt(u.location, u.count, u.data);
         else if (u.size == 2)
-            context->setUniformInt2(u.location, u.count, u.data);
+            context.setUniformInt2(u.location, u.count, u.data);
         else if (u.size == 3)
-            context->setUniformInt3(u.location, u.count, u.data);
+            context.setUniformInt3(u.location, u.count, u.data);
         else if (u.size == 4)
-            context->setUniformInt4(u.location, u.count, u.data);
+            context.setUniformInt4(u.location, u.count, u.data);
     }
 
     for (const auto& u : _uniformInt)
     {
         if (u.size == 1)
-            context->setUniformInt(u.location, u.count, u.data);
+            context.setUniformInt(u.location, u.count, u.data);
         else if (u.size == 2)
-            context->setUniformInt2(u.location, u.count, u.data);
+            context.setUniformInt2(u.location, u.count, u.data);
         else if (u.size == 3)
-            context->setUniformInt3(u.location, u.count, u.data);
+            context.setUniformInt3(u.location, u.count, u.data);
         else if (u.size == 4)
-            context->setUniformInt4(u.location, u.count, u.data);
+            context.setUniformInt4(u.location, u.count, u.data);
     }
 
     for (const auto& u : _uniformFloat)
     {
         if (u.size == 1)
-            context->setUniformFloat(u.location, u.count, u.data);
+            context.setUniformFloat(u.location, u.count, u.data);
         else if (u.size == 2)
-            context->setUniformFloat2(u.location, u.count, u.data);
+            context.setUniformFloat2(u.location, u.count, u.data);
         else if (u.size == 3)
-            context->setUniformFloat3(u.location, u.count, u.data);
+            context.setUniformFloat3(u.location, u.count, u.data);
         else if (u.size == 4)
-            context->setUniformFloat4(u.location, u.count, u.data);
+            context.setUniformFloat4(u.location, u.count, u.data);
         else if (u.size == 16)
-            context->setUniformMatrix4x4(u.location, u.count, u.data);
+            context.setUniformMatrix4x4(u.location, u.count, u.data);
     }
 
     for (const auto& s : _samplers)
     {
-        context->setTextureAt(s.position, *s.sampler->id, s.location);
-        context->setSamplerStateAt(s.position, *s.wrapMode, *s.textureFilter, *s.mipFilter);
+        context.setTextureAt(s.position, *s.sampler->id, s.location);
+        context.setSamplerStateAt(s.position, *s.wrapMode, *s.textureFilter, *s.mipFilter);
     }
 
-    if (_vertexAttribArray == 0)
-    {
-        _vertexAttribArray = context->createVertexAttributeArray();
-
-        if (_vertexAttribArray != -1)
-        {
-            context->setVertexAttributeArray(_vertexAttribArray);
-            for (const auto& a : _attributes)
-                context->setVertexBufferAt(a.location, *a.resourceId, a.size, *a.stride, a.offset);
-        }
-    }
-    if (_vertexAttribArray != -1)
-        context->setVertexAttributeArray(_vertexAttribArray);
-    else
-        for (const auto& a : _attributes)
-            context->setVertexBufferAt(a.location, *a.resourceId, a.size, *a.stride, a.offset);
+    bindVertexAttributes(context);
 
-    context->setColorMask(*_colorMask);
-    context->setBlendingMode(*_blendingSourceFactor, *_blendingDestinationFactor);
-    context->setDepthTest(*_depthMask, *_depthFunc);
-    context->setStencilTest(*_stencilFunction, *_stencilReference, *_stencilMask, *_stencilFailOp, *_stencilZFailOp, *_stencilZPassOp);
-    context->setScissorTest(*_scissorTest, *_scissorBox);
-    context->setTriangleCulling(*_triangleCulling);
+    context.setColorMask(*_colorMask);
+    context.setBlendingMode(*_blendingSourceFactor, *_blendingDestinationFactor);
+    context.setDepthTest(*_depthMask, *_depthFunc);
+    context.setStencilTest(*_stencilFunction, *_stencilReference, *_stencilMask, *_stencilFailOp, *_stencilZFailOp, *_stencilZPassOp);
+    context.setScissorTest(*_scissorTest, *_scissorBox);
+    context.setTriangleCulling(*_triangleCulling);
 
     if (!_pass->isForward())
-        context->drawTriangles(0, 2);
+        context.drawTriangles(0, 2);
     else
-        context->drawTriangles(*_indexBuffer, *_firstIndex, *_numIndices / 3);
+        context.drawTriangles(*_indexBuffer, *_firstIndex, *_numIndices / 3);
 }
 
 data::ResolvedBinding*
 DrawCall::resolveBinding(const std::string&                                     inputName,
                          const std::unordered_map<std::string, data::Binding>&  bindings)
 {
-    bool isCollection = false;
-    std::string bindingName = inputName;
-    bool isArray = inputName[inputName.length() - 1] == ']';
-    auto pos = bindingName.find_first_of('[');
-
-    if (!isArray && pos != std::string::npos)
-    {
-        bindingName = bindingName.substr(0, pos);
-        isCollection = true;
-    }
-
-    const data::Binding* binding = nullptr;
-    std::string bindingPropertyName;
-
-    // Some OpenGL drivers will provide uniform array names without the "[0]" suffix. In order to properly match uniform array
-    // bindings, we will check for bindings with 1) the original name first but also 2) the named with the "[0]" suffix appened.
-    if (bindings.count(bindingName) != 0 || (!isArray && bindings.count(bindingName += "[0]") != 0))
-    {
-        binding = &bindings.at(bindingName);
-        bindingPropertyName = binding->propertyName;
-        // isCollection = isCollection && bindingPropertyName.find_first_of('[') == std::string::npos;
-    }
-    // else
-    // {
-    //     for (const auto& inputNameAndBinding : bindings)
-    //     {
-    //         std::regex r(inputNameAndBinding.first);
-    //
-    //         if (std::regex_match(inputName, r))
-    //         {
-    //             bindingPropertyName = std::regex_replace(inputName, r, inputNameAndBinding.second.propertyName);
-    //             binding = &inputNameAndBinding.second;
-    //             isCollection = false;
-    //             break;
-    //         }
-    //     }
-
-        if (!binding)
-            return nullptr;
-    // }
-
-    auto& store = getStore(binding->source);
-    auto propertyName = data::Store::getActualPropertyName(_variables, bindingPropertyName);
-
     // FIXME: handle uniforms with struct types
 
     // FIXME: we assume the uniform is an array of struct or the code to be irrelevantly slow here
     // uniform arrays of non-struct types should be detected and handled as such using a single call
     // to the context providing the direct pointer to the contiguous stored data
 
-    // FIXME: handle per-fields bindings instead of using the raw uniform suffix
-    if (isCollection && !isArray)
-        propertyName += inputName.substr(pos);
+    if (_template)
+    {
+        const auto& input = _template->input(bindings, inputName);
+
+        if (input.binding == nullptr)
+            return nullptr;
 
-    return new data::ResolvedBinding(*binding, propertyName, store);
+        return new data::ResolvedBinding(
+            *input.binding,
+            _template->propertyName(input, _variables),
+            getStore(input.binding->source)
+        );
+    }
+
+    std::string collectionSuffix;
+    auto binding = DrawCallTemplate::findBinding(inputName, bindings, collectionSuffix);
+
+    if (!binding)
+        return nullptr;
+
+    return new data::ResolvedBinding(
+        *binding,
+        data::Store::getActualPropertyName(_variables, binding->propertyName) + collectionSuffix,
+        getStore(binding->source)
+    );
+}
+
+std::string
+DrawCall::actualPropertyName(const std::string& propertyName)
+{
+    return _template
+        ? _template->propertyName(_template->plan(propertyName), _variables)
+        : data::Store::getActualPropertyName(_variables, propertyName);
 }
 
 math::vec3
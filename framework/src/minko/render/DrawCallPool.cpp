@@ -18,6 +18,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 */
 
 #include "minko/render/DrawCallPool.hpp"
+#include "minko/render/DrawCallTemplate.hpp"
 
 #include "minko/data/ResolvedBinding.hpp"
 
@@ -473,18 +474,7 @@ DrawCallPool::uniformBindingPropertyAddedHandler(DrawCall&
         // => we listen to the useful properties
         if (propertyExist && drawCall.zSorted())
         {
-            auto propertyRelatedToZSortIt = std::find_if(
-                _zSortUsefulPropertyNames.begin(),
-                _zSortUsefulPropertyNames.end(),
-                [&](const PropertyName& zSortUsefulPropertyName) -> bool
-                {
-                    return
-                        data::Store::getActualPropertyName(drawCall.variables(), zSortUsefulPropertyName) ==
-                        propertyName;
-                }
-            );
-
-            if (propertyRelatedToZSortIt != _zSortUsefulPropertyNames.end())
+            if (bindsProperty(_zSortUsefulPropertyNames, drawCall.variables(), propertyName))
             {
                 // Bind the signal to request a Z-sorting if one of these properties changed
                 _zSortUsefulPropertyChangedSlot->insert(
@@ -584,18 +574,7 @@ DrawCallPool::stateBindingPropertyAddedHandler(const std::string&       stateNam
             )
         );
 
-        auto propertyRelatedToSortIt = std::find_if(
-            _sortUsefulPropertyNames.begin(),
-            _sortUsefulPropertyNames.end(),
-            [&](const PropertyName& sortUsefulPropertyName) -> bool
-            {
-                return
-                    data::Store::getActualPropertyName(drawCall.variables(), sortUsefulPropertyName) ==
-                    propertyName;
-            }
-        );
-
-        if (propertyRelatedToSortIt != _sortUsefulPropertyNames.end())
+        if (bindsProperty(_sortUsefulPropertyNames, drawCall.variables(), propertyName))
         {
             _sortUsefulPropertyChangedSlot->insert(
                 std::make_pair(
@@ -707,6 +686,7 @@ DrawCallPool::clear()
     _drawCallToPropRebindFuncs->resize(0);
 #endif
     _drawCallsToBeSorted.clear();
+    _drawCallTemplates.clear();
 }
 
 void
@@ -786,7 +766,10 @@ DrawCallPool::numDrawCalls() const
 void
 DrawCallPool::bindDrawCall(DrawCall& drawCall, Pass::Ptr pass, Program::Ptr program, bool forceRebind)
 {
-    drawCall.bind(program);
+    auto drawCallTemplate = this->drawCallTemplate(pass, program, drawCall.variables());
+
+    drawCall.bind(program, drawCallTemplate);
+    drawCallTemplate->drawCallBound();
 
     // bind attributes
     // FIXME: like for uniforms, watch and swap default values / binding value
@@ -836,6 +819,43 @@ DrawCallPool::unbindDrawCall(DrawCall& drawCall)
 
     _drawCallToPropRebindFuncs->erase(&drawCall);
     //_drawCallToPropRebindFuncs->clear();
+
+    // templates keep their pass and program alive: they must not outlive their last draw call
+    auto drawCallTemplate = drawCall.drawCallTemplate();
+
+    if (drawCallTemplate != nullptr && drawCallTemplate->drawCallUnbound() == 0)
+        _drawCallTemplates.erase(drawCallTemplate->key());
+}
+
+DrawCallTemplate::Ptr
+DrawCallPool::drawCallTemplate(Pass::Ptr                pass,
+                               Program::Ptr             program,
+                               const EffectVariables&   variables)
+{
+    auto key = DrawCallTemplate::key(pass, program, variables);
+    auto drawCallTemplateIt = _drawCallTemplates.find(key);
+
+    if (drawCallTemplateIt != _drawCallTemplates.end())
+        return drawCallTemplateIt->second;
+
+    auto drawCallTemplate = DrawCallTemplate::create(pass, program, variables);
+
+    _drawCallTemplates.emplace(key, drawCallTemplate);
+
+    return drawCallTemplate;
+}
+
+bool
+DrawCallPool::bindsProperty(const std::vector<PropertyName>&    propertyNames,
+                            const EffectVariables&              variables,
+                            const std::string&                  propertyName)
+{
+    // compare the resolved names: bindings can reach the same property through other variables
+    for (const auto& usefulPropertyName : propertyNames)
+        if (data::Store::getActualPropertyName(variables, usefulPropertyName) == propertyName)
+            return true;
+
+    return false;
 }
 
 bool
@@ -0,0 +1,189 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/DrawCallTemplate.hpp"
+
+#include "minko/data/Store.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+const int DrawCallTemplate::PropertyNamePlan::NO_VARIABLE = -1;
+const int DrawCallTemplate::PropertyNamePlan::UNSUPPORTED = -2;
+
+DrawCallTemplate::DrawCallTemplate(std::shared_ptr<Pass>    pass,
+                                   std::shared_ptr<Program> program,
+                                   const EffectVariables&   variables) :
+    _pass(pass),
+    _program(program),
+    _variableNames(),
+    _key(key(pass, program, variables)),
+    _plans(),
+    _inputs(),
+    _numDrawCalls(0)
+{
+    for (const auto& variable : variables)
+        _variableNames.push_back(variable.first);
+}
+
+std::string
+DrawCallTemplate::key(std::shared_ptr<Pass> pass, std::shared_ptr<Program> program, const EffectVariables& variables)
+{
+    std::stringstream key;
+
+    key << pass.get() << ';' << program.get();
+
+    for (const auto& variable : variables)
+        key << ';' << *variable.first;
+
+    return key.str();
+}
+
+const data::Binding*
+DrawCallTemplate::findBinding(const std::string&    inputName,
+                              const BindingMap&     bindings,
+                              std::string&          collectionSuffix)
+{
+    std::string bindingName = inputName;
+    bool isArray = inputName[inputName.length() - 1] == ']';
+    auto pos = bindingName.find_first_of('[');
+    bool isCollection = !isArray && pos != std::string::npos;
+
+    collectionSuffix.clear();
+
+    if (isCollection)
+        bindingName = bindingName.substr(0, pos);
+
+    // Some OpenGL drivers will provide uniform array names without the "[0]" suffix. In order to properly match uniform array
+    // bindings, we will check for bindings with 1) the original name first but also 2) the named with the "[0]" suffix appened.
+    auto bindingIt = bindings.find(bindingName);
+
+    if (bindingIt == bindings.end() && !isArray)
+        bindingIt = bindings.find(bindingName + "[0]");
+
+    if (bindingIt == bindings.end())
+        return nullptr;
+
+    // FIXME: handle per-fields bindings instead of using the raw uniform suffix
+    if (isCollection)
+        collectionSuffix = inputName.substr(pos);
+
+    return &bindingIt->second;
+}
+
+const DrawCallTemplate::BoundInput&
+DrawCallTemplate::input(const BindingMap& bindings, const std::string& inputName)
+{
+    auto inputsIt = std::find_if(
+        _inputs.begin(),
+        _inputs.end(),
+        [&](const std::pair<const BindingMap*, std::unordered_map<std::string, BoundInput>>& inputs)
+        {
+            return inputs.first == &bindings;
+        }
+    );
+
+    if (inputsIt == _inputs.end())
+    {
+        _inputs.emplace_back(&bindings, std::unordered_map<std::string, BoundInput>());
+        inputsIt = _inputs.end() - 1;
+    }
+
+    auto& inputs = inputsIt->second;
+    auto inputIt = inputs.find(inputName);
+
+    if (inputIt != inputs.end())
+        return inputIt->second;
+
+    BoundInput input;
+
+    input.binding = findBinding(inputName, bindings, input.collectionSuffix);
+    input.plan = input.binding != nullptr ? &plan(input.binding->propertyName) : nullptr;
+
+    return inputs.emplace(inputName, input).first->second;
+}
+
+const DrawCallTemplate::PropertyNamePlan&
+DrawCallTemplate::plan(const std::string& propertyName)
+{
+    auto planIt = _plans.find(propertyName);
+
+    if (planIt != _plans.end())
+        return *planIt->second;
+
+    auto plan = std::unique_ptr<PropertyNamePlan>(new PropertyNamePlan());
+
+    plan->propertyName = propertyName;
+    plan->variable = PropertyNamePlan::UNSUPPORTED;
+
+    // Substitute markers instead of the actual values: the resulting name tells which variable
+    // ends up where, as long as there is a single substitution.
+    const char marker = '\x01';
+    EffectVariables markers;
+
+    for (auto i = 0u; i < _variableNames.size(); ++i)
+        markers.push_back({ _variableNames[i], std::string(1, marker) + std::to_string(i) + marker });
+
+    if (propertyName.find(marker) == std::string::npos)
+    {
+        auto substituted = data::Store::getActualPropertyName(markers, propertyName);
+        auto begin = substituted.find(marker);
+
+        if (begin == std::string::npos)
+        {
+            plan->prefix = substituted;
+            plan->variable = PropertyNamePlan::NO_VARIABLE;
+        }
+        else
+        {
+            auto end = substituted.find(marker, begin + 1);
+
+            if (substituted.find(marker, end + 1) == std::string::npos)
+            {
+                plan->prefix = substituted.substr(0, begin);
+                plan->suffix = substituted.substr(end + 1);
+                plan->variable = std::stoi(substituted.substr(begin + 1, end - begin - 1));
+            }
+        }
+    }
+
+    return *_plans.emplace(propertyName, std::move(plan)).first->second;
+}
+
+std::string
+DrawCallTemplate::propertyName(const PropertyNamePlan& plan, const EffectVariables& variables) const
+{
+    if (plan.variable == PropertyNamePlan::NO_VARIABLE)
+        return plan.prefix;
+
+    if (plan.variable == PropertyNamePlan::UNSUPPORTED)
+        return data::Store::getActualPropertyName(variables, plan.propertyName);
+
+    auto variableIt = variables.begin();
+
+    std::advance(variableIt, plan.variable);
+
+    return plan.prefix + *variableIt->second + plan.suffix;
+}
+
+std::string
+DrawCallTemplate::propertyName(const BoundInput& input, const EffectVariables& variables) const
+{
+    return propertyName(*input.plan, variables) + input.collectionSuffix;
+}
@@ -31,8 +31,9 @@ using namespace minko;
 using namespace minko::render;
 
 Effect::Effect(const std::string& name) :
+    _name(name),
     _data(data::Provider::create()),
-    _name(name)
+    _renderGraphs()
 {
 }
 
@@ -70,6 +71,7 @@ Effect::removeTechnique(const std::string& name)
 
 	_techniques.erase(name);
 	_fallback.erase(name);
+	_renderGraphs.erase(name);
 }
 
 void
@@ -0,0 +1,433 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/ImageResampler.hpp"
+
+#include "minko/render/AbstractTexture.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define MINKO_RESAMPLER_SSE
+# include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+# define MINKO_RESAMPLER_NEON
+# include <arm_neon.h>
+#endif
+
+using namespace minko;
+using namespace minko::render;
+
+struct ImageResampler::Contributors
+{
+    std::vector<unsigned int>   first;
+    std::vector<unsigned int>   count;
+    // maxCount weights per output pixel
+    std::vector<float>          weights;
+    unsigned int                maxCount;
+};
+
+namespace
+{
+    // below this number of output pixels, spawning threads costs more than it saves
+    const unsigned int MIN_NUM_PIXELS_PER_THREAD = 256u * 256u;
+
+    template <typename F>
+    void
+    parallelRows(unsigned int numRows, unsigned int numThreads, F function)
+    {
+        numThreads = std::max(1u, std::min(numThreads, numRows));
+
+        if (numThreads == 1u)
+        {
+            function(0u, numRows);
+
+            return;
+        }
+
+        const auto numRowsPerThread = (numRows + numThreads - 1u) / numThreads;
+        std::vector<std::thread> threads;
+
+        for (auto i = 1u; i < numThreads; ++i)
+        {
+            const auto begin = std::min(numRows, i * numRowsPerThread);
+            const auto end = std::min(numRows, begin + numRowsPerThread);
+
+            threads.push_back(std::thread(function, begin, end));
+        }
+
+        function(0u, std::min(numRows, numRowsPerThread));
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    inline
+    void
+    filterPixel(const float* pixels, const float* weights, unsigned int numWeights, float* out)
+    {
+#if defined(MINKO_RESAMPLER_SSE)
+        __m128 sum = _mm_setzero_ps();
+
+        for (auto i = 0u; i < numWeights; ++i)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pixels + (i << 2)), _mm_set1_ps(weights[i])));
+
+        _mm_storeu_ps(out, sum);
+#elif defined(MINKO_RESAMPLER_NEON)
+        float32x4_t sum = vdupq_n_f32(0.f);
+
+        for (auto i = 0u; i < numWeights; ++i)
+            sum = vmlaq_n_f32(sum, vld1q_f32(pixels + (i << 2)), weights[i]);
+
+        vst1q_f32(out, sum);
+#else
+        out[0] = out[1] = out[2] = out[3] = 0.f;
+
+        for (auto i = 0u; i < numWeights; ++i)
+            for (auto k = 0u; k < 4u; ++k)
+                out[k] += pixels[(i << 2) + k] * weights[i];
+#endif
+    }
+
+    inline
+    void
+    accumulateRow(const float* row, float weight, unsigned int numFloats, float* out)
+    {
+        auto i = 0u;
+
+#if defined(MINKO_RESAMPLER_SSE)
+        const __m128 w = _mm_set1_ps(weight);
+
+        for (; i + 4u <= numFloats; i += 4u)
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(row + i), w)));
+#elif defined(MINKO_RESAMPLER_NEON)
+        for (; i + 4u <= numFloats; i += 4u)
+            vst1q_f32(out + i, vmlaq_n_f32(vld1q_f32(out + i), vld1q_f32(row + i), weight));
+#endif
+
+        for (; i < numFloats; ++i)
+            out[i] += row[i] * weight;
+    }
+
+    inline
+    float
+    sinc(float x)
+    {
+        if (std::abs(x) < 1e-6f)
+            return 1.f;
+
+        x *= static_cast<float>(M_PI);
+
+        return std::sin(x) / x;
+    }
+
+    inline
+    float
+    bessel0(float x)
+    {
+        // power series of the zeroth order modified Bessel function of the first kind
+        auto sum = 1.f;
+        auto term = 1.f;
+        const auto halfX = x * .5f;
+
+        for (auto k = 1; k < 20; ++k)
+        {
+            term *= halfX / static_cast<float>(k);
+            sum += term * term;
+        }
+
+        return sum;
+    }
+}
+
+unsigned int
+ImageResampler::defaultNumThreads()
+{
+    return std::max(1u, std::min(4u, std::thread::hardware_concurrency()));
+}
+
+float
+ImageResampler::filterSupport(Filter filter)
+{
+    switch (filter)
+    {
+    case Filter::NEAREST:
+    case Filter::BOX:
+        return .5f;
+    case Filter::BILINEAR:
+        return 1.f;
+    case Filter::LANCZOS:
+    case Filter::KAISER:
+        return 3.f;
+    }
+
+    return 1.f;
+}
+
+float
+ImageResampler::filterWeight(Filter filter, float x)
+{
+    static const auto kaiserAlpha = 4.f;
+    static const auto kaiserNormalization = 1.f / bessel0(kaiserAlpha);
+
+    const auto absX = std::abs(x);
+
+    switch (filter)
+    {
+    case Filter::NEAREST:
+    case Filter::BOX:
+        return x >= -.5f && x < .5f ? 1.f : 0.f;
+    case Filter::BILINEAR:
+        return std::max(0.f, 1.f - absX);
+    case Filter::LANCZOS:
+        return absX < 3.f ? sinc(x) * sinc(x / 3.f) : 0.f;
+    case Filter::KAISER:
+    {
+        if (absX >= 3.f)
+            return 0.f;
+
+        const auto t = x / 3.f;
+
+        return sinc(x) * bessel0(kaiserAlpha * std::sqrt(1.f - t * t)) * kaiserNormalization;
+    }
+    }
+
+    return 0.f;
+}
+
+void
+ImageResampler::computeContributors(unsigned int size, unsigned int newSize, Filter filter, Contributors& contributors)
+{
+    const auto scale = static_cast<float>(newSize) / static_cast<float>(size);
+    // the filter is stretched when minifying so that every source pixel contributes
+    const auto filterScale = std::max(1.f, 1.f / scale);
+    const auto support = filterSupport(filter) * filterScale;
+
+    contributors.maxCount = filter == Filter::NEAREST ? 1u : static_cast<unsigned int>(std::ceil(support * 2.f)) + 1u;
+    contributors.first.resize(newSize);
+    contributors.count.resize(newSize);
+    contributors.weights.assign(newSize * contributors.maxCount, 0.f);
+
+    for (auto i = 0u; i < newSize; ++i)
+    {
+        const auto center = (static_cast<float>(i) + .5f) / scale;
+        auto* weights = &contributors.weights[i * contributors.maxCount];
+
+        if (filter == Filter::NEAREST)
+        {
+            contributors.first[i] = std::min(size - 1u, static_cast<unsigned int>(center));
+            contributors.count[i] = 1u;
+            weights[0] = 1.f;
+
+            continue;
+        }
+
+        const auto left = std::max(0, static_cast<int>(std::floor(center - support)));
+        const auto right = std::min(static_cast<int>(size) - 1, static_cast<int>(std::ceil(center + support)));
+        auto first = -1;
+        auto count = 0u;
+        auto sum = 0.f;
+
+        for (auto j = left; j <= right && count < contributors.maxCount; ++j)
+        {
+            const auto weight = filterWeight(filter, (static_cast<float>(j) + .5f - center) / filterScale);
+
+            if (weight == 0.f && first < 0)
+                continue;
+            if (first < 0)
+                first = j;
+
+            weights[count++] = weight;
+            sum += weight;
+        }
+
+        // trailing zero weights are harmless, but a degenerate footprint falls back to the nearest pixel
+        if (first < 0 || std::abs(sum) < 1e-6f)
+        {
+            contributors.first[i] = std::min(size - 1u, static_cast<unsigned int>(center));
+            contributors.count[i] = 1u;
+            weights[0] = 1.f;
+
+            continue;
+        }
+
+        contributors.first[i] = static_cast<unsigned int>(first);
+        contributors.count[i] = count;
+
+        for (auto k = 0u; k < count; ++k)
+            weights[k] /= sum;
+    }
+}
+
+void
+ImageResampler::resample(const unsigned char*   data,
+                         unsigned int           width,
+                         unsigned int           height,
+                         unsigned char*         newData,
+                         unsigned int           newWidth,
+                         unsigned int           newHeight,
+                         Filter                 filter,
+                         float                  gamma,
+                         unsigned int           numThreads)
+{
+    if (width == 0u || height == 0u || newWidth == 0u || newHeight == 0u)
+        return;
+
+    if (width == newWidth && height == newHeight)
+    {
+        std::memcpy(newData, data, width * height * sizeof(int));
+
+        return;
+    }
+
+    if (numThreads == 0u)
+        numThreads = defaultNumThreads();
+    if (std::max(width * height, newWidth * newHeight) < MIN_NUM_PIXELS_PER_THREAD)
+        numThreads = 1u;
+
+    const auto linear = std::abs(gamma - 1.f) < 1e-6f;
+
+    // 8 bit to float conversion, decoding the color channels to linear space
+    std::array<float, 256> colorToFloat;
+    std::array<float, 256> alphaToFloat;
+
+    for (auto i = 0u; i < 256u; ++i)
+    {
+        alphaToFloat[i] = static_cast<float>(i) / 255.f;
+        colorToFloat[i] = linear ? alphaToFloat[i] : std::pow(alphaToFloat[i], gamma);
+    }
+
+    // float to 8 bit conversion, encoding the color channels back
+    static const auto numEncodingSteps = 4096u;
+    std::vector<unsigned char> floatToColor;
+
+    if (!linear)
+    {
+        floatToColor.resize(numEncodingSteps);
+        for (auto i = 0u; i < numEncodingSteps; ++i)
+            floatToColor[i] = static_cast<unsigned char>(
+                std::pow(static_cast<float>(i) / (numEncodingSteps - 1u), 1.f / gamma) * 255.f + .5f
+            );
+    }
+
+    Contributors columns;
+    Contributors rows;
+
+    computeContributors(width, newWidth, filter, columns);
+    computeContributors(height, newHeight, filter, rows);
+
+    // horizontal pass: height x newWidth RGBA float pixels
+    std::vector<float> horizontal(height * newWidth * 4u);
+
+    parallelRows(height, numThreads, [&](unsigned int begin, unsigned int end)
+    {
+        std::vector<float> row(width * 4u);
+
+        for (auto y = begin; y < end; ++y)
+        {
+            const auto* src = data + y * width * 4u;
+
+            for (auto x = 0u; x < width * 4u; x += 4u)
+            {
+                row[x] = colorToFloat[src[x]];
+                row[x + 1u] = colorToFloat[src[x + 1u]];
+                row[x + 2u] = colorToFloat[src[x + 2u]];
+                row[x + 3u] = alphaToFloat[src[x + 3u]];
+            }
+
+            auto* dst = &horizontal[y * newWidth * 4u];
+
+            for (auto x = 0u; x < newWidth; ++x)
+                filterPixel(
+                    &row[columns.first[x] * 4u],
+                    &columns.weights[x * columns.maxCount],
+                    columns.count[x],
+                    dst + x * 4u
+                );
+        }
+    });
+
+    // vertical pass, straight into the 8 bit output
+    parallelRows(newHeight, numThreads, [&](unsigned int begin, unsigned int end)
+    {
+        const auto numFloats = newWidth * 4u;
+        std::vector<float> row(numFloats);
+
+        for (auto y = begin; y < end; ++y)
+        {
+            const auto* weights = &rows.weights[y * rows.maxCount];
+
+            std::fill(row.begin(), row.end(), 0.f);
+            for (auto k = 0u; k < rows.count[y]; ++k)
+                accumulateRow(&horizontal[(rows.first[y] + k) * numFloats], weights[k], numFloats, &row[0]);
+
+            auto* dst = newData + y * numFloats;
+
+            for (auto i = 0u; i < numFloats; ++i)
+            {
+                const auto value = std::min(1.f, std::max(0.f, row[i]));
+
+                if (linear || (i & 3u) == 3u)
+                    dst[i] = static_cast<unsigned char>(value * 255.f + .5f);
+                else
+                    dst[i] = floatToColor[static_cast<unsigned int>(value * (numEncodingSteps - 1u) + .5f)];
+            }
+        }
+    });
+}
+
+void
+ImageResampler::mipMapChain(const unsigned char*        data,
+                            unsigned int                width,
+                            unsigned int                height,
+                            std::vector<unsigned char>& mipMapChain,
+                            Filter                      filter,
+                            float                       gamma,
+                            unsigned int                numThreads)
+{
+    const auto numLevels = AbstractTexture::numMipMaps(width, height);
+    auto size = 0u;
+
+    for (auto level = 0; level < numLevels; ++level)
+        size += std::max(width >> level, 1u) * std::max(height >> level, 1u) * sizeof(int);
+
+    mipMapChain.resize(size);
+    std::memcpy(&mipMapChain[0], data, width * height * sizeof(int));
+
+    auto offset = 0u;
+
+    for (auto level = 1; level < numLevels; ++level)
+    {
+        const auto previousWidth = std::max(width >> (level - 1), 1u);
+        const auto previousHeight = std::max(height >> (level - 1), 1u);
+        const auto levelOffset = offset + previousWidth * previousHeight * sizeof(int);
+
+        resample(
+            &mipMapChain[offset],
+            previousWidth,
+            previousHeight,
+            &mipMapChain[levelOffset],
+            std::max(width >> level, 1u),
+            std::max(height >> level, 1u),
+            filter,
+            gamma,
+            numThreads
+        );
+
+        offset = levelOffset;
+    }
+}
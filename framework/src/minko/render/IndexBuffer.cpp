@@ -36,55 +36,97 @@ IndexBuffer::clone() const
 }
 
 void
-IndexBuffer::upload(uint	offset,
-					int		count)
+IndexBuffer::upload(uint    offset,
+                    int     count)
 {
-	if (data().empty())
-		return;
+    if (dataPointer<unsigned int>() && !_context->supportsUnsignedIntIndices() && !demoteToUnsignedShort())
+        throw std::runtime_error("IndexBuffer::upload: 32-bit indices are not supported by the context");
 
-	assert(count <= (int)data().size());
+    const auto oldNumIndices = _numIndices;
 
-	if (_id == -1)
-    	_id = _context->createIndexBuffer(static_cast<uint>(data().size()));
+    const auto uploaded = dataPointer<unsigned int>()
+        ? uploadData(offset, count, *dataPointer<unsigned int>(), offset)
+        : uploadData(offset, count, data(), offset);
 
-	const auto oldNumIndices	= _numIndices;
-	_numIndices					= count > 0 ? count : static_cast<unsigned int>(data().size());
-
-	_context->uploadIndexBufferData(
-		_id,
-		offset,
-        _numIndices,
-		&data()[offset]
-	);
-
-	if (_numIndices != oldNumIndices)
-		_changed->execute(shared_from_this());
+    if (uploaded && _numIndices != oldNumIndices)
+        _changed->execute(shared_from_this());
 }
 
 void
 IndexBuffer::upload(uint                                offset,
                     int                                 count,
                     const std::vector<unsigned short>&  data)
+{
+    if (uploadData(offset, count, data, 0))
+        _changed->execute(shared_from_this());
+}
+
+void
+IndexBuffer::upload(uint                                offset,
+                    int                                 count,
+                    const std::vector<unsigned int>&    data)
+{
+    if (!_context->supportsUnsignedIntIndices())
+        throw std::runtime_error("IndexBuffer::upload: 32-bit indices are not supported by the context");
+
+    if (uploadData(offset, count, data, 0))
+        _changed->execute(shared_from_this());
+}
+
+template <typename T>
+bool
+IndexBuffer::uploadData(uint                    offset,
+                        int                     count,
+                        const std::vector<T>&   data,
+                        uint                    dataOffset)
 {
     if (data.empty())
-        return;
+        return false;
 
     assert(count <= (int)data.size());
 
     if (_id == -1)
-        _id = _context->createIndexBuffer(static_cast<unsigned int>(data.size()));
+        _id = _context->createIndexBuffer(static_cast<uint>(data.size()), sizeof(T));
+
+    // the GPU buffer keeps the index type it was created with
+    assert(indexSize() == sizeof(T));
 
-    const auto numIndices = count > 0 ? count : static_cast<unsigned int>(data.size());
-    _numIndices = numIndices;
+    _numIndices = count > 0 ? count : static_cast<unsigned int>(data.size());
 
     _context->uploadIndexBufferData(
         _id,
         offset,
-        numIndices,
-        const_cast<unsigned short*>(data.data())
+        _numIndices,
+        const_cast<T*>(&data[dataOffset])
     );
 
-    _changed->execute(shared_from_this());
+    return true;
+}
+
+void
+IndexBuffer::orphan()
+{
+    if (_id == -1)
+        return;
+
+    const auto size = dataPointer<unsigned int>()
+        ? dataPointer<unsigned int>()->size()
+        : data().size();
+
+    _context->orphanIndexBuffer(_id, static_cast<uint>(size));
+}
+
+bool
+IndexBuffer::demoteToUnsignedShort()
+{
+    const auto& u32Data = *dataPointer<unsigned int>();
+
+    if (!u32Data.empty() && *std::max_element(u32Data.begin(), u32Data.end()) > std::numeric_limits<unsigned short>::max())
+        return false;
+
+    _data = std::vector<unsigned short>(u32Data.begin(), u32Data.end());
+
+    return true;
 }
 
 void
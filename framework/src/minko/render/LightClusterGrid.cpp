@@ -0,0 +1,348 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/LightClusterGrid.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+LightClusterGrid::LightClusterGrid(uint numClustersX, uint numClustersY, uint numClustersZ) :
+	_numClustersX(std::max(1u, numClustersX)),
+	_numClustersY(std::max(1u, numClustersY)),
+	_numClustersZ(std::max(1u, numClustersZ)),
+	_maxLightsPerCluster(64),
+	_numThreads(std::max(1u, std::min(4u, std::thread::hardware_concurrency()))),
+	_zNear(0.1f),
+	_zFar(1000.f),
+	_numDroppedLights(0),
+	_terminating(false),
+	_jobId(0),
+	_jobNumRanges(0),
+	_jobNumPendingRanges(0),
+	_jobSpheres(nullptr)
+{
+	_clusterOffsets.resize(numClusters(), 0);
+	_clusterCounts.resize(numClusters(), 0);
+
+	updateClusterBounds(math::perspective(.785f, 1.f, _zNear, _zFar));
+}
+
+LightClusterGrid::~LightClusterGrid()
+{
+	{
+		std::lock_guard<std::mutex> lock(_workMutex);
+
+		_terminating = true;
+	}
+
+	_workCondition.notify_all();
+
+	for (auto& worker : _workers)
+		worker.join();
+}
+
+LightClusterGrid::Ptr
+LightClusterGrid::maxLightsPerCluster(uint value)
+{
+	_maxLightsPerCluster = std::max(1u, value);
+
+	return shared_from_this();
+}
+
+LightClusterGrid::Ptr
+LightClusterGrid::projection(const math::mat4& projection)
+{
+	updateClusterBounds(projection);
+
+	return shared_from_this();
+}
+
+void
+LightClusterGrid::updateClusterBounds(const math::mat4& projection)
+{
+	const auto invProjection = math::inverse(projection);
+
+	auto unproject = [&](float x, float y, float z)
+	{
+		auto p = invProjection * math::vec4(x, y, z, 1.f);
+
+		return math::vec3(p) / p.w;
+	};
+
+	// view-space point of the (x, y) NDC ray at the specified positive view depth
+	auto pointAtDepth = [&](float x, float y, float depth)
+	{
+		auto nearPoint = unproject(x, y, -1.f);
+		auto farPoint = unproject(x, y, 1.f);
+		auto t = (depth + nearPoint.z) / (nearPoint.z - farPoint.z);
+
+		return nearPoint + (farPoint - nearPoint) * t;
+	};
+
+	_zNear = std::max(1e-3f, -unproject(0.f, 0.f, -1.f).z);
+	_zFar = std::max(_zNear * 1.001f, -unproject(0.f, 0.f, 1.f).z);
+
+	_columnMin.resize(_numClustersZ * _numClustersX);
+	_columnMax.resize(_numClustersZ * _numClustersX);
+	_rowMin.resize(_numClustersZ * _numClustersY);
+	_rowMax.resize(_numClustersZ * _numClustersY);
+	_sliceMin.resize(_numClustersZ);
+	_sliceMax.resize(_numClustersZ);
+
+	const auto depthRatio = _zFar / _zNear;
+
+	for (auto z = 0u; z < _numClustersZ; ++z)
+	{
+		auto sliceNear = _zNear * std::pow(depthRatio, float(z) / float(_numClustersZ));
+		auto sliceFar = _zNear * std::pow(depthRatio, float(z + 1) / float(_numClustersZ));
+
+		_sliceMin[z] = -sliceFar;
+		_sliceMax[z] = -sliceNear;
+
+		for (auto x = 0u; x < _numClustersX; ++x)
+		{
+			auto left = -1.f + 2.f * float(x) / float(_numClustersX);
+			auto right = -1.f + 2.f * float(x + 1) / float(_numClustersX);
+			float corners[] = {
+				pointAtDepth(left, 0.f, sliceNear).x,
+				pointAtDepth(left, 0.f, sliceFar).x,
+				pointAtDepth(right, 0.f, sliceNear).x,
+				pointAtDepth(right, 0.f, sliceFar).x
+			};
+
+			_columnMin[z * _numClustersX + x] = *std::min_element(corners, corners + 4);
+			_columnMax[z * _numClustersX + x] = *std::max_element(corners, corners + 4);
+		}
+
+		for (auto y = 0u; y < _numClustersY; ++y)
+		{
+			auto bottom = -1.f + 2.f * float(y) / float(_numClustersY);
+			auto top = -1.f + 2.f * float(y + 1) / float(_numClustersY);
+			float corners[] = {
+				pointAtDepth(0.f, bottom, sliceNear).y,
+				pointAtDepth(0.f, bottom, sliceFar).y,
+				pointAtDepth(0.f, top, sliceNear).y,
+				pointAtDepth(0.f, top, sliceFar).y
+			};
+
+			_rowMin[z * _numClustersY + y] = *std::min_element(corners, corners + 4);
+			_rowMax[z * _numClustersY + y] = *std::max_element(corners, corners + 4);
+		}
+	}
+}
+
+uint
+LightClusterGrid::slice(float depth) const
+{
+	if (depth <= _zNear)
+		return 0;
+
+	auto z = std::log(depth / _zNear) / std::log(_zFar / _zNear) * float(_numClustersZ);
+
+	return std::min(_numClustersZ - 1, uint(z));
+}
+
+void
+LightClusterGrid::clusterBounds(uint x, uint y, uint z, math::vec3& min, math::vec3& max) const
+{
+	min = math::vec3(_columnMin[z * _numClustersX + x], _rowMin[z * _numClustersY + y], _sliceMin[z]);
+	max = math::vec3(_columnMax[z * _numClustersX + x], _rowMax[z * _numClustersY + y], _sliceMax[z]);
+}
+
+void
+LightClusterGrid::bin(const std::vector<math::vec4>& viewSpaceSpheres)
+{
+	// sharing the binning is only worth it when there is enough work to share
+	static const uint minNumLightsPerThread = 32;
+
+	_binnedLights.resize(numClusters() * _maxLightsPerCluster);
+	std::fill(_clusterCounts.begin(), _clusterCounts.end(), 0u);
+
+	auto numThreads = std::min(
+		std::min(_numThreads, _numClustersZ),
+		std::max(1u, uint(viewSpaceSpheres.size()) / minNumLightsPerThread)
+	);
+
+	if (numThreads <= 1)
+		_numDroppedLights = binSlices(viewSpaceSpheres, 0, _numClustersZ);
+	else
+	{
+		// each range of depth slices owns a disjoint set of clusters: the calling thread bins the
+		// first one and the persistent workers the others
+		{
+			std::lock_guard<std::mutex> lock(_workMutex);
+
+			// workers are started on demand and kept alive across frames
+			while (_workers.size() < numThreads - 1)
+				_workers.push_back(std::thread(
+					&LightClusterGrid::workerLoop, this, uint(_workers.size()) + 1, _jobId
+				));
+
+			_jobSpheres = &viewSpaceSpheres;
+			_jobNumRanges = numThreads;
+			_jobNumPendingRanges = numThreads - 1;
+			_jobNumDroppedLights.assign(numThreads, 0);
+			++_jobId;
+		}
+
+		_workCondition.notify_all();
+
+		auto numDroppedLights = binRange(viewSpaceSpheres, 0, numThreads);
+
+		std::unique_lock<std::mutex> lock(_workMutex);
+
+		_workDoneCondition.wait(lock, [this]() { return _jobNumPendingRanges == 0; });
+
+		_numDroppedLights = numDroppedLights;
+		for (auto numDropped : _jobNumDroppedLights)
+			_numDroppedLights += numDropped;
+
+		_jobSpheres = nullptr;
+	}
+
+	auto numIndices = 0u;
+
+	for (auto i = 0u; i < numClusters(); ++i)
+	{
+		_clusterOffsets[i] = numIndices;
+		numIndices += _clusterCounts[i];
+	}
+
+	_lightIndices.resize(numIndices);
+
+	for (auto i = 0u; i < numClusters(); ++i)
+		std::copy(
+			_binnedLights.begin() + i * _maxLightsPerCluster,
+			_binnedLights.begin() + i * _maxLightsPerCluster + _clusterCounts[i],
+			_lightIndices.begin() + _clusterOffsets[i]
+		);
+}
+
+uint
+LightClusterGrid::binRange(const std::vector<math::vec4>& viewSpaceSpheres, uint range, uint numRanges)
+{
+	return binSlices(
+		viewSpaceSpheres,
+		range * _numClustersZ / numRanges,
+		(range + 1) * _numClustersZ / numRanges
+	);
+}
+
+void
+LightClusterGrid::workerLoop(uint range, uint jobId)
+{
+	while (true)
+	{
+		const std::vector<math::vec4>* spheres = nullptr;
+		auto numRanges = 0u;
+
+		{
+			std::unique_lock<std::mutex> lock(_workMutex);
+
+			_workCondition.wait(lock, [&]() { return _terminating || _jobId != jobId; });
+
+			if (_terminating)
+				return;
+
+			jobId = _jobId;
+
+			// the job might need fewer workers than there are running
+			if (range >= _jobNumRanges)
+				continue;
+
+			spheres = _jobSpheres;
+			numRanges = _jobNumRanges;
+		}
+
+		auto numDroppedLights = binRange(*spheres, range, numRanges);
+
+		{
+			std::lock_guard<std::mutex> lock(_workMutex);
+
+			_jobNumDroppedLights[range] = numDroppedLights;
+			--_jobNumPendingRanges;
+		}
+
+		_workDoneCondition.notify_one();
+	}
+}
+
+uint
+LightClusterGrid::binSlices(const std::vector<math::vec4>& viewSpaceSpheres, uint firstSlice, uint lastSlice)
+{
+	std::vector<float> columnDistances(_numClustersX);
+	auto numDroppedLights = 0u;
+
+	for (auto z = firstSlice; z < lastSlice; ++z)
+	{
+		const auto sliceMin = _sliceMin[z];
+		const auto sliceMax = _sliceMax[z];
+		const float* columnMin = &_columnMin[z * _numClustersX];
+		const float* columnMax = &_columnMax[z * _numClustersX];
+		const float* rowMin = &_rowMin[z * _numClustersY];
+		const float* rowMax = &_rowMax[z * _numClustersY];
+
+		for (auto lightId = 0u; lightId < viewSpaceSpheres.size(); ++lightId)
+		{
+			const auto& sphere = viewSpaceSpheres[lightId];
+			const auto radius2 = sphere.w * sphere.w;
+			const auto dz = std::max(sliceMin - sphere.z, 0.f) + std::max(sphere.z - sliceMax, 0.f);
+			const auto dz2 = dz * dz;
+
+			if (dz2 > radius2)
+				continue;
+
+			// squared distances to every column of the slice, kept branchless so it vectorizes
+			for (auto x = 0u; x < _numClustersX; ++x)
+			{
+				auto dx = std::max(columnMin[x] - sphere.x, 0.f) + std::max(sphere.x - columnMax[x], 0.f);
+
+				columnDistances[x] = dx * dx;
+			}
+
+			for (auto y = 0u; y < _numClustersY; ++y)
+			{
+				auto dy = std::max(rowMin[y] - sphere.y, 0.f) + std::max(sphere.y - rowMax[y], 0.f);
+				auto dyz2 = dy * dy + dz2;
+
+				if (dyz2 > radius2)
+					continue;
+
+				for (auto x = 0u; x < _numClustersX; ++x)
+				{
+					if (columnDistances[x] + dyz2 > radius2)
+						continue;
+
+					auto cluster = clusterIndex(x, y, z);
+					auto count = _clusterCounts[cluster];
+
+					if (count < _maxLightsPerCluster)
+					{
+						_binnedLights[cluster * _maxLightsPerCluster + count] = lightId;
+						_clusterCounts[cluster] = count + 1;
+					}
+					else
+						++numDroppedLights;
+				}
+			}
+		}
+	}
+
+	return numDroppedLights;
+}
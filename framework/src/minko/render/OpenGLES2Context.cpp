@@ -230,6 +230,7 @@ OpenGLES2Context::OpenGLES2Context() :
 	_currentVertexSize(8, -1),
 	_currentVertexStride(8, -1),
 	_currentVertexOffset(8, -1),
+	_currentVertexFormat(8, VertexAttribute::Format::FLOAT),
 	_currentBoundTexture(0),
 	_currentTexture(8, 0),
 	_currentProgram(0),
@@ -248,7 +249,9 @@ OpenGLES2Context::OpenGLES2Context() :
 	_currentStencilZFailOp(StencilOperation::UNSET),
 	_currentStencilZPassOp(StencilOperation::UNSET),
 	_vertexAttributeEnabled(32u, false),
-	_stencilBits(0)
+	_stencilBits(0),
+	_indexBufferIndexSizes(),
+	_supportsUnsignedIntIndices(false)
 {
 #if (MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS) && !defined(MINKO_PLUGIN_ANGLE) && !defined(MINKO_PLUGIN_OFFSCREEN)
 	glewInit();
@@ -299,6 +302,12 @@ OpenGLES2Context::OpenGLES2Context() :
 		setStencilTest(CompareMode::ALWAYS, 0, 0x1, StencilOperation::KEEP, StencilOperation::KEEP, StencilOperation::KEEP);
 	}
 
+#ifdef GL_ES_VERSION_2_0
+	_supportsUnsignedIntIndices = supportsExtension("OES_element_index_uint");
+#else
+	_supportsUnsignedIntIndices = true;
+#endif
+
 	initializeExtFunctions();
 }
 
@@ -434,6 +443,8 @@ OpenGLES2Context::drawTriangles(const uint indexBuffer, const uint firstIndex, c
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
 	//}
 
+	const auto indexSize = _indexBufferIndexSizes[indexBuffer];
+
 	// http://www.opengl.org/sdk/docs/man/xhtml/glDrawElements.xml
 	//
 	// void glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices);
@@ -443,7 +454,13 @@ OpenGLES2Context::drawTriangles(const uint indexBuffer, const uint firstIndex, c
 	// indices Specifies a pointer to the location where the indices are stored.
 	//
 	// glDrawElements render primitives from array data
-	glDrawElements(GL_TRIANGLES, numTriangles * 3, GL_UNSIGNED_SHORT, reinterpret_cast<GLvoid*>(firstIndex));
+	// firstIndex is expressed in indices, the offset expected by OpenGL is in bytes
+	glDrawElements(
+		GL_TRIANGLES,
+		numTriangles * 3,
+		indexSize == sizeof(GLuint) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT,
+		reinterpret_cast<GLvoid*>(firstIndex * indexSize)
+	);
 
 	checkForErrors();
 }
@@ -524,6 +541,18 @@ OpenGLES2Context::uploadVertexBufferData(const uint vertexBuffer,
 	checkForErrors();
 }
 
+void
+OpenGLES2Context::orphanVertexBuffer(const uint vertexBuffer, const uint size)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+
+	// without data, the driver can hand out a new data store right away instead of waiting for the
+	// draw calls still reading the current one
+	glBufferData(GL_ARRAY_BUFFER, size * sizeof(GLfloat), 0, GL_DYNAMIC_DRAW);
+
+	checkForErrors();
+}
+
 void
 OpenGLES2Context::deleteVertexBuffer(const uint vertexBuffer)
 {
@@ -556,9 +585,47 @@ OpenGLES2Context::setVertexBufferAt(const uint	position,
 									const uint	size,
 									const uint	stride,
 									const uint	offset)
+{
+	setVertexBufferAt(position, vertexBuffer, size, stride, offset, VertexAttribute::Format::FLOAT);
+}
+
+static
+std::pair<GLenum, GLboolean>
+vertexAttributeType(VertexAttribute::Format format)
+{
+	switch (format)
+	{
+	case VertexAttribute::Format::HALF_FLOAT:
+#ifdef GL_HALF_FLOAT
+		return std::make_pair(GL_HALF_FLOAT, GL_FALSE);
+#else
+		return std::make_pair(GLenum(0x8D61) /* GL_HALF_FLOAT_OES */, GL_FALSE);
+#endif
+	case VertexAttribute::Format::SHORT_NORMALIZED:
+		return std::make_pair(GL_SHORT, GL_TRUE);
+	case VertexAttribute::Format::UNSIGNED_SHORT_NORMALIZED:
+		return std::make_pair(GL_UNSIGNED_SHORT, GL_TRUE);
+	case VertexAttribute::Format::BYTE_NORMALIZED:
+		return std::make_pair(GL_BYTE, GL_TRUE);
+	case VertexAttribute::Format::UNSIGNED_BYTE_NORMALIZED:
+		return std::make_pair(GL_UNSIGNED_BYTE, GL_TRUE);
+	case VertexAttribute::Format::UNSIGNED_BYTE:
+		return std::make_pair(GL_UNSIGNED_BYTE, GL_FALSE);
+	default:
+		return std::make_pair(GL_FLOAT, GL_FALSE);
+	}
+}
+
+void
+OpenGLES2Context::setVertexBufferAt(const uint						position,
+									const uint						vertexBuffer,
+									const uint						size,
+									const uint						stride,
+									const uint						offset,
+									const VertexAttribute::Format	format)
 {
 	bool vertexAttributeEnabled = vertexBuffer > 0;
-    bool vertexBufferChanged = (_currentVertexBuffer[position] != vertexBuffer) || vertexAttributeEnabled;
+    bool vertexBufferChanged = (_currentVertexBuffer[position] != static_cast<int>(vertexBuffer)) || vertexAttributeEnabled;
 
 	if (vertexBufferChanged)
 	{
@@ -569,16 +636,20 @@ OpenGLES2Context::setVertexBufferAt(const uint	position,
 	}
 
 	if (vertexBufferChanged
-		|| _currentVertexSize[position] != size
-		|| _currentVertexStride[position] != stride
-		|| _currentVertexOffset[position] != offset)
+		|| _currentVertexSize[position] != static_cast<int>(size)
+		|| _currentVertexStride[position] != static_cast<int>(stride)
+		|| _currentVertexOffset[position] != static_cast<int>(offset)
+		|| _currentVertexFormat[position] != format)
 	{
+		const auto type = vertexAttributeType(format);
+
+		// stride and offset are expressed in 32-bit words, packed attributes are 4-byte aligned
 		// http://www.khronos.org/opengles/sdk/docs/man/xhtml/glVertexAttribPointer.xml
 		glVertexAttribPointer(
 			position,
 			size,
-			GL_FLOAT,
-			GL_FALSE,
+			type.first,
+			type.second,
 			sizeof(GLfloat) * stride,
 			(void*)(sizeof(GLfloat) * offset)
 		);
@@ -587,6 +658,7 @@ OpenGLES2Context::setVertexBufferAt(const uint	position,
 		_currentVertexSize[position] = size;
 		_currentVertexStride[position] = stride;
 		_currentVertexOffset[position] = offset;
+		_currentVertexFormat[position] = format;
 	}
 
     if (vertexBufferChanged || _vertexAttributeEnabled[position] != vertexAttributeEnabled)
@@ -643,6 +715,12 @@ OpenGLES2Context::deleteVertexAttributeArray(const uint vertexArray)
 
 const uint
 OpenGLES2Context::createIndexBuffer(const uint size)
+{
+	return createIndexBuffer(size, sizeof(GLushort));
+}
+
+const uint
+OpenGLES2Context::createIndexBuffer(const uint size, const uint indexSize)
 {
 	uint indexBuffer;
 
@@ -651,9 +729,10 @@ OpenGLES2Context::createIndexBuffer(const uint size)
 
 	_currentIndexBuffer = indexBuffer;
 
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, size * sizeof(GLushort), 0, GL_STATIC_DRAW);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, size * indexSize, 0, GL_STATIC_DRAW);
 
 	_indexBuffers.push_back(indexBuffer);
+	_indexBufferIndexSizes[indexBuffer] = indexSize;
 
 	checkForErrors();
 
@@ -670,7 +749,21 @@ OpenGLES2Context::uploadIndexBufferData(const uint 	indexBuffer,
 
 	_currentIndexBuffer = indexBuffer;
 
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * sizeof(GLushort), size * sizeof(GLushort), data);
+	const auto indexSize = _indexBufferIndexSizes[indexBuffer];
+
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * indexSize, size * indexSize, data);
+
+	checkForErrors();
+}
+
+void
+OpenGLES2Context::orphanIndexBuffer(const uint indexBuffer, const uint size)
+{
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+	_currentIndexBuffer = indexBuffer;
+
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, size * _indexBufferIndexSizes[indexBuffer], 0, GL_DYNAMIC_DRAW);
 
 	checkForErrors();
 }
@@ -682,6 +775,7 @@ OpenGLES2Context::deleteIndexBuffer(const uint indexBuffer)
 		_currentIndexBuffer = 0;
 
 	_indexBuffers.erase(std::find(_indexBuffers.begin(), _indexBuffers.end(), indexBuffer));
+	_indexBufferIndexSizes.erase(indexBuffer);
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, 0, 0, GL_STATIC_DRAW);
@@ -691,6 +785,12 @@ OpenGLES2Context::deleteIndexBuffer(const uint indexBuffer)
 	checkForErrors();
 }
 
+bool
+OpenGLES2Context::supportsUnsignedIntIndices()
+{
+	return _supportsUnsignedIntIndices;
+}
+
 uint
 OpenGLES2Context::createTexture(TextureType	type,
 								uint 		width,
@@ -108,7 +108,14 @@ Program::setAttribute(const std::string& name, const VertexAttribute& attribute,
     {
         auto oldProgram = _context->currentProgram();
 
-        _context->setVertexBufferAt(it->location, *attribute.resourceId, attribute.size, *attribute.vertexSize, attribute.offset);
+        _context->setVertexBufferAt(
+            it->location,
+            *attribute.resourceId,
+            attribute.size,
+            *attribute.packedVertexSize,
+            attribute.packedOffset,
+            attribute.format
+        );
         _context->setProgram(oldProgram);
 
         _setAttributes.insert(name);
@@ -0,0 +1,2322 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/RecordingContext.hpp"
+
+#include "minko/render/TextureFormatInfo.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+    /*
+    ** Finds the uniforms and attributes declared by a GLSL source in the code enabled by its
+    ** preprocessor directives, and the identifiers used by that code.
+    */
+    class GLSLScanner
+    {
+    public:
+        struct Declaration
+        {
+            std::string         name;
+            ProgramInputs::Type type;
+            int                 size;
+            bool                isUniform;
+        };
+
+    private:
+        struct Condition
+        {
+            bool    active;
+            bool    taken;
+            bool    parentActive;
+        };
+
+        std::unordered_map<std::string, std::string>    _macros;
+        std::vector<Condition>                          _conditions;
+
+        std::vector<Declaration>                        _declarations;
+        std::unordered_set<std::string>                 _identifiers;
+
+        // expression evaluation
+        std::vector<std::string>                        _tokens;
+        uint                                            _position;
+        uint                                            _depth;
+
+    public:
+        explicit
+        GLSLScanner(const std::string& source) :
+            _position(0),
+            _depth(0)
+        {
+            std::stringstream lines(removeComments(source));
+            std::string line;
+            std::string code;
+
+            while (std::getline(lines, line))
+            {
+                auto first = line.find_first_not_of(" \t\r");
+
+                if (first != std::string::npos && line[first] == '#')
+                    directive(line.substr(first + 1));
+                else if (active())
+                    code += line + "\n";
+            }
+
+            scanCode(code);
+        }
+
+        const std::vector<Declaration>&
+        declarations() const
+        {
+            return _declarations;
+        }
+
+        bool
+        uses(const std::string& identifier) const
+        {
+            return _identifiers.count(identifier) != 0;
+        }
+
+    private:
+        bool
+        active() const
+        {
+            return _conditions.empty() || _conditions.back().active;
+        }
+
+        static
+        std::string
+        removeComments(const std::string& source)
+        {
+            std::string result;
+
+            result.reserve(source.size());
+
+            for (auto i = 0u; i < source.size(); ++i)
+            {
+                if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '/')
+                {
+                    while (i < source.size() && source[i] != '\n')
+                        ++i;
+                    if (i < source.size())
+                        result += '\n';
+                }
+                else if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '*')
+                {
+                    for (i += 2; i < source.size() && !(source[i] == '*' && i + 1 < source.size() && source[i + 1] == '/'); ++i)
+                        if (source[i] == '\n')
+                            result += '\n';
+                    ++i;
+                    result += ' ';
+                }
+                else
+                    result += source[i];
+            }
+
+            return result;
+        }
+
+        static
+        std::vector<std::string>
+        tokenize(const std::string& code)
+        {
+            static const std::vector<std::string> operators = { "&&", "||", "==", "!=", "<=", ">=" };
+
+            std::vector<std::string> tokens;
+
+            for (auto i = 0u; i < code.size();)
+            {
+                auto c = code[i];
+
+                if (std::isspace(static_cast<unsigned char>(c)))
+                    ++i;
+                else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+                {
+                    auto start = i;
+
+                    while (i < code.size() && (std::isalnum(static_cast<unsigned char>(code[i])) || code[i] == '_'))
+                        ++i;
+                    tokens.push_back(code.substr(start, i - start));
+                }
+                else if (std::isdigit(static_cast<unsigned char>(c)))
+                {
+                    auto start = i;
+
+                    while (i < code.size() && (std::isalnum(static_cast<unsigned char>(code[i])) || code[i] == '.'))
+                        ++i;
+                    tokens.push_back(code.substr(start, i - start));
+                }
+                else
+                {
+                    auto op = std::find_if(operators.begin(), operators.end(), [&](const std::string& op)
+                    {
+                        return code.compare(i, op.size(), op) == 0;
+                    });
+
+                    auto size = op != operators.end() ? op->size() : 1u;
+
+                    tokens.push_back(code.substr(i, size));
+                    i += size;
+                }
+            }
+
+            return tokens;
+        }
+
+        void
+        directive(const std::string& line)
+        {
+            std::stringstream stream(line);
+            std::string name;
+            std::string argument;
+
+            stream >> name;
+            std::getline(stream, argument);
+
+            auto first = argument.find_first_not_of(" \t");
+            auto last = argument.find_last_not_of(" \t\r");
+
+            argument = first == std::string::npos ? "" : argument.substr(first, last - first + 1);
+
+            if (name == "ifdef" || name == "ifndef")
+            {
+                auto value = (_macros.count(argument) != 0) == (name == "ifdef");
+
+                _conditions.push_back({ active() && value, value, active() });
+            }
+            else if (name == "if")
+            {
+                auto value = active() && evaluate(argument) != 0;
+
+                _conditions.push_back({ value, value, active() });
+            }
+            else if (name == "elif" && !_conditions.empty())
+            {
+                auto& condition = _conditions.back();
+
+                condition.active = condition.parentActive && !condition.taken && evaluate(argument) != 0;
+                condition.taken = condition.taken || condition.active;
+            }
+            else if (name == "else" && !_conditions.empty())
+            {
+                auto& condition = _conditions.back();
+
+                condition.active = condition.parentActive && !condition.taken;
+                condition.taken = true;
+            }
+            else if (name == "endif" && !_conditions.empty())
+                _conditions.pop_back();
+            else if (!active())
+                return;
+            else if (name == "define")
+            {
+                auto end = argument.find_first_of(" \t(");
+                auto macro = argument.substr(0, end);
+
+                // Function-like macros are only known to be defined.
+                if (end == std::string::npos || argument[end] == '(')
+                    _macros[macro] = "";
+                else
+                    _macros[macro] = argument.substr(end + 1);
+            }
+            else if (name == "undef")
+                _macros.erase(argument);
+            else if (name == "version")
+                _macros["__VERSION__"] = argument.substr(0, argument.find(' '));
+        }
+
+        long
+        evaluate(const std::string& expression)
+        {
+            auto tokens = tokenize(expression);
+            auto position = 0u;
+
+            std::swap(tokens, _tokens);
+            std::swap(position, _position);
+
+            auto value = ++_depth < 16 ? parseOr() : 0;
+
+            --_depth;
+            std::swap(tokens, _tokens);
+            std::swap(position, _position);
+
+            return value;
+        }
+
+        const std::string&
+        peek() const
+        {
+            static const std::string end;
+
+            return _position < _tokens.size() ? _tokens[_position] : end;
+        }
+
+        bool
+        accept(const std::string& token)
+        {
+            if (peek() != token)
+                return false;
+
+            ++_position;
+
+            return true;
+        }
+
+        long
+        parseOr()
+        {
+            auto value = parseAnd();
+
+            while (accept("||"))
+                value = (parseAnd() != 0) || (value != 0);
+
+            return value;
+        }
+
+        long
+        parseAnd()
+        {
+            auto value = parseEquality();
+
+            while (accept("&&"))
+                value = (parseEquality() != 0) && (value != 0);
+
+            return value;
+        }
+
+        long
+        parseEquality()
+        {
+            auto value = parseRelation();
+
+            while (true)
+            {
+                if (accept("=="))
+                    value = value == parseRelation();
+                else if (accept("!="))
+                    value = value != parseRelation();
+                else
+                    return value;
+            }
+        }
+
+        long
+        parseRelation()
+        {
+            auto value = parseSum();
+
+            while (true)
+            {
+                if (accept("<"))
+                    value = value < parseSum();
+                else if (accept(">"))
+                    value = value > parseSum();
+                else if (accept("<="))
+                    value = value <= parseSum();
+                else if (accept(">="))
+                    value = value >= parseSum();
+                else
+                    return value;
+            }
+        }
+
+        long
+        parseSum()
+        {
+            auto value = parseProduct();
+
+            while (true)
+            {
+                if (accept("+"))
+                    value += parseProduct();
+                else if (accept("-"))
+                    value -= parseProduct();
+                else
+                    return value;
+            }
+        }
+
+        long
+        parseProduct()
+        {
+            auto value = parseUnary();
+
+            while (true)
+            {
+                if (accept("*"))
+                    value *= parseUnary();
+                else if (accept("/") || accept("%"))
+                {
+                    auto isDivision = _tokens[_position - 1] == "/";
+                    auto divisor = parseUnary();
+
+                    value = divisor == 0 ? 0 : (isDivision ? value / divisor : value % divisor);
+                }
+                else
+                    return value;
+            }
+        }
+
+        long
+        parseUnary()
+        {
+            if (accept("!"))
+                return parseUnary() == 0;
+            if (accept("-"))
+                return -parseUnary();
+            if (accept("+"))
+                return parseUnary();
+
+            return parsePrimary();
+        }
+
+        long
+        parsePrimary()
+        {
+            if (accept("("))
+            {
+                auto value = parseOr();
+
+                accept(")");
+
+                return value;
+            }
+
+            auto token = peek();
+
+            if (token.empty())
+                return 0;
+
+            ++_position;
+
+            if (token == "defined")
+            {
+                auto parenthesized = accept("(");
+                auto defined = _macros.count(peek()) != 0;
+
+                ++_position;
+                if (parenthesized)
+                    accept(")");
+
+                return defined;
+            }
+
+            if (std::isdigit(static_cast<unsigned char>(token[0])))
+                return std::strtol(token.c_str(), nullptr, 0);
+
+            auto macro = _macros.find(token);
+
+            return macro == _macros.end() ? 0 : evaluate(macro->second);
+        }
+
+        static
+        bool
+        inputType(const std::string& typeName, ProgramInputs::Type& type)
+        {
+            static const std::unordered_map<std::string, ProgramInputs::Type> types = {
+                { "float",              ProgramInputs::Type::float1 },
+                { "vec2",               ProgramInputs::Type::float2 },
+                { "vec3",               ProgramInputs::Type::float3 },
+                { "vec4",               ProgramInputs::Type::float4 },
+                { "int",                ProgramInputs::Type::int1 },
+                { "ivec2",              ProgramInputs::Type::int2 },
+                { "ivec3",              ProgramInputs::Type::int3 },
+                { "ivec4",              ProgramInputs::Type::int4 },
+                { "bool",               ProgramInputs::Type::bool1 },
+                { "bvec2",              ProgramInputs::Type::bool2 },
+                { "bvec3",              ProgramInputs::Type::bool3 },
+                { "bvec4",              ProgramInputs::Type::bool4 },
+                { "mat3",               ProgramInputs::Type::float9 },
+                { "mat4",               ProgramInputs::Type::float16 },
+                { "sampler2D",          ProgramInputs::Type::sampler2d },
+                { "samplerCube",        ProgramInputs::Type::samplerCube },
+                { "samplerExternalOES", ProgramInputs::Type::samplerExternalOES }
+            };
+
+            auto it = types.find(typeName);
+
+            if (it == types.end())
+                return false;
+
+            type = it->second;
+
+            return true;
+        }
+
+        void
+        scanCode(const std::string& code)
+        {
+            auto tokens = tokenize(code);
+
+            for (auto i = 0u; i < tokens.size(); ++i)
+            {
+                const auto& token = tokens[i];
+
+                if (token != "uniform" && token != "attribute")
+                {
+                    if (std::isalpha(static_cast<unsigned char>(token[0])) || token[0] == '_')
+                        _identifiers.insert(token);
+
+                    continue;
+                }
+
+                auto isUniform = token == "uniform";
+
+                ++i;
+                while (i < tokens.size() && (tokens[i] == "lowp" || tokens[i] == "mediump" || tokens[i] == "highp"))
+                    ++i;
+                if (i >= tokens.size())
+                    break;
+
+                auto type = ProgramInputs::Type::unknown;
+                auto supported = inputType(tokens[i], type);
+
+                // Declarators: name[size], name, ... ;
+                for (++i; i < tokens.size() && tokens[i] != ";"; ++i)
+                {
+                    if (tokens[i] == ",")
+                        continue;
+
+                    auto name = tokens[i];
+                    auto size = 1l;
+                    auto isArray = i + 1 < tokens.size() && tokens[i + 1] == "[";
+
+                    if (isArray)
+                    {
+                        std::string sizeExpression;
+
+                        for (i += 2; i < tokens.size() && tokens[i] != "]"; ++i)
+                            sizeExpression += tokens[i] + " ";
+
+                        size = std::max(1l, evaluate(sizeExpression));
+                    }
+
+                    if (supported)
+                        _declarations.push_back({ name, type, static_cast<int>(size), isUniform });
+                }
+            }
+        }
+    };
+
+    class LogReader
+    {
+    private:
+        const std::vector<unsigned char>&   _log;
+        std::size_t                         _offset;
+
+    public:
+        LogReader(const std::vector<unsigned char>& log) :
+            _log(log),
+            _offset(0)
+        {
+        }
+
+        bool
+        eof() const
+        {
+            return _offset >= _log.size();
+        }
+
+        std::size_t
+        offset() const
+        {
+            return _offset;
+        }
+
+        void
+        seek(std::size_t offset)
+        {
+            _offset = offset;
+        }
+
+        const unsigned char*
+        data(std::size_t size)
+        {
+            if (_offset + size > _log.size())
+                throw std::runtime_error("truncated command log");
+
+            auto data = &_log[_offset];
+
+            _offset += size;
+
+            return data;
+        }
+
+        template <typename T>
+        T
+        read()
+        {
+            T value;
+
+            std::memcpy(&value, data(sizeof(T)), sizeof(T));
+
+            return value;
+        }
+
+        std::string
+        readString()
+        {
+            auto size = read<uint>();
+            auto bytes = data(size);
+
+            return std::string(reinterpret_cast<const char*>(bytes), size);
+        }
+
+        // Uploads and uniforms point inside the log, copied since the context API is not const.
+        std::vector<unsigned char>
+        readData()
+        {
+            auto size = read<uint>();
+            auto bytes = data(size);
+
+            return std::vector<unsigned char>(bytes, bytes + size);
+        }
+    };
+}
+
+const uint RecordingContext::LOG_MAGIC = 0x43524b4d; // "MKRC"
+const uint RecordingContext::LOG_VERSION = 2;
+
+RecordingContext::Counters::Counters() :
+    numCommands(0),
+    numDrawCalls(0),
+    numTriangles(0),
+    numProgramChanges(0),
+    numRedundantProgramChanges(0),
+    numTextureBinds(0),
+    numRedundantTextureBinds(0),
+    numVertexBufferBinds(0),
+    numRedundantVertexBufferBinds(0),
+    numUniformUpdates(0),
+    numRedundantUniformUpdates(0),
+    numStateChanges(0),
+    numRedundantStateChanges(0),
+    numUploadedBytes(0)
+{
+}
+
+RecordingContext::RecordingContext(AbstractContext::Ptr context) :
+    _context(context),
+    _command(Command::NUM_COMMANDS),
+    _recording(true),
+    _errorsEnabled(false),
+    _nextResourceId(0),
+    _currentProgram(0),
+    _renderTarget(0),
+    _viewportWidth(0),
+    _viewportHeight(0),
+    _programInputsFunction(&RecordingContext::scanProgramInputs)
+{
+    clearLog();
+}
+
+void
+RecordingContext::clearLog()
+{
+    _log.clear();
+    _startTime = Clock::now();
+
+    _arguments.clear();
+    write(LOG_MAGIC);
+    write(LOG_VERSION);
+    _log.swap(_arguments);
+}
+
+void
+RecordingContext::begin(Command command)
+{
+    _command = command;
+    _arguments.clear();
+
+    ++_counters.numCommands;
+}
+
+void
+RecordingContext::write(const std::string& value)
+{
+    write(static_cast<uint>(value.size()));
+    _arguments.insert(_arguments.end(), value.begin(), value.end());
+}
+
+void
+RecordingContext::write(const void* data, std::size_t size)
+{
+    auto bytes = static_cast<const unsigned char*>(data);
+
+    write(static_cast<uint>(size));
+    if (bytes != nullptr)
+        _arguments.insert(_arguments.end(), bytes, bytes + size);
+    else
+        _arguments.resize(_arguments.size() + size, 0);
+}
+
+void
+RecordingContext::end()
+{
+    if (!_recording)
+        return;
+
+    // a 32-bit count of microseconds would wrap after 71 minutes of recording
+    auto time = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - _startTime).count()
+    );
+    auto command = static_cast<unsigned char>(_command);
+    auto size = static_cast<uint>(_arguments.size());
+
+    _log.push_back(command);
+    _log.insert(_log.end(), reinterpret_cast<unsigned char*>(&time), reinterpret_cast<unsigned char*>(&time) + sizeof(uint64_t));
+    _log.insert(_log.end(), reinterpret_cast<unsigned char*>(&size), reinterpret_cast<unsigned char*>(&size) + sizeof(uint));
+    _log.insert(_log.end(), _arguments.begin(), _arguments.end());
+}
+
+void
+RecordingContext::endState(Command state)
+{
+    auto& previous = _states[static_cast<uint>(state)];
+
+    ++_counters.numStateChanges;
+    if (previous == _arguments)
+        ++_counters.numRedundantStateChanges;
+    else
+        previous = _arguments;
+
+    end();
+}
+
+void
+RecordingContext::endUniform(uint location)
+{
+    auto& previous = _uniforms[(static_cast<uint64_t>(_currentProgram) << 32) | location];
+
+    ++_counters.numUniformUpdates;
+    if (previous == _arguments)
+        ++_counters.numRedundantUniformUpdates;
+    else
+        previous = _arguments;
+
+    end();
+}
+
+uint
+RecordingContext::nextResourceId()
+{
+    return ++_nextResourceId;
+}
+
+bool
+RecordingContext::errorsEnabled()
+{
+    return _context ? _context->errorsEnabled() : _errorsEnabled;
+}
+
+void
+RecordingContext::errorsEnabled(bool errorsEnabled)
+{
+    _errorsEnabled = errorsEnabled;
+
+    if (_context)
+        _context->errorsEnabled(errorsEnabled);
+}
+
+const std::string&
+RecordingContext::driverInfo()
+{
+    static const std::string driverInfo = "RecordingContext";
+
+    return _context ? _context->driverInfo() : driverInfo;
+}
+
+uint
+RecordingContext::renderTarget()
+{
+    return _context ? _context->renderTarget() : _renderTarget;
+}
+
+uint
+RecordingContext::viewportWidth()
+{
+    return _context ? _context->viewportWidth() : _viewportWidth;
+}
+
+uint
+RecordingContext::viewportHeight()
+{
+    return _context ? _context->viewportHeight() : _viewportHeight;
+}
+
+uint
+RecordingContext::currentProgram()
+{
+    return _context ? _context->currentProgram() : _currentProgram;
+}
+
+void
+RecordingContext::configureViewport(const uint x, const uint y, const uint width, const uint height)
+{
+    _viewportWidth = width;
+    _viewportHeight = height;
+
+    begin(Command::CONFIGURE_VIEWPORT);
+    write(x);
+    write(y);
+    write(width);
+    write(height);
+    endState(Command::CONFIGURE_VIEWPORT);
+
+    if (_context)
+        _context->configureViewport(x, y, width, height);
+}
+
+void
+RecordingContext::clear(uint         clearFlags,
+                        float        red,
+                        float        green,
+                        float        blue,
+                        float        alpha,
+                        float        depth,
+                        unsigned int stencil,
+                        unsigned int mask)
+{
+    begin(Command::CLEAR);
+    write(clearFlags);
+    write(red);
+    write(green);
+    write(blue);
+    write(alpha);
+    write(depth);
+    write(stencil);
+    write(mask);
+    end();
+
+    if (_context)
+        _context->clear(clearFlags, red, green, blue, alpha, depth, stencil, mask);
+}
+
+void
+RecordingContext::present()
+{
+    begin(Command::PRESENT);
+    end();
+
+    if (_context)
+        _context->present();
+}
+
+void
+RecordingContext::drawTriangles(const uint indexBuffer, const uint firstIndex, const int numTriangles)
+{
+    ++_counters.numDrawCalls;
+    _counters.numTriangles += numTriangles;
+
+    begin(Command::DRAW_INDEXED_TRIANGLES);
+    write(indexBuffer);
+    write(firstIndex);
+    write(numTriangles);
+    end();
+
+    if (_context)
+        _context->drawTriangles(indexBuffer, firstIndex, numTriangles);
+}
+
+void
+RecordingContext::drawTriangles(const uint firstIndex, const int numTriangles)
+{
+    ++_counters.numDrawCalls;
+    _counters.numTriangles += numTriangles;
+
+    begin(Command::DRAW_TRIANGLES);
+    write(firstIndex);
+    write(numTriangles);
+    end();
+
+    if (_context)
+        _context->drawTriangles(firstIndex, numTriangles);
+}
+
+const uint
+RecordingContext::createVertexBuffer(const uint size)
+{
+    auto vertexBuffer = _context ? _context->createVertexBuffer(size) : nextResourceId();
+
+    begin(Command::CREATE_VERTEX_BUFFER);
+    write(vertexBuffer);
+    write(size);
+    end();
+
+    return vertexBuffer;
+}
+
+void
+RecordingContext::setVertexBufferAt(const uint position,
+                                    const uint vertexBuffer,
+                                    const uint size,
+                                    const uint stride,
+                                    const uint offset)
+{
+    setVertexBufferAt(position, vertexBuffer, size, stride, offset, VertexAttribute::Format::FLOAT);
+}
+
+void
+RecordingContext::setVertexBufferAt(const uint                      position,
+                                    const uint                      vertexBuffer,
+                                    const uint                      size,
+                                    const uint                      stride,
+                                    const uint                      offset,
+                                    const VertexAttribute::Format   format)
+{
+    auto binding = _vertexBufferBindings.find(position);
+
+    ++_counters.numVertexBufferBinds;
+    if (binding != _vertexBufferBindings.end() && binding->second.vertexBuffer == vertexBuffer
+        && binding->second.size == size && binding->second.stride == stride
+        && binding->second.offset == offset && binding->second.format == format)
+        ++_counters.numRedundantVertexBufferBinds;
+    else
+        _vertexBufferBindings[position] = { vertexBuffer, size, stride, offset, format };
+
+    begin(Command::SET_VERTEX_BUFFER_AT);
+    write(position);
+    write(vertexBuffer);
+    write(size);
+    write(stride);
+    write(offset);
+    write(static_cast<uint>(format));
+    end();
+
+    if (_context)
+        _context->setVertexBufferAt(position, vertexBuffer, size, stride, offset, format);
+}
+
+void
+RecordingContext::uploadVertexBufferData(const uint vertexBuffer, const uint offset, const uint size, void* data)
+{
+    // Offset and size are expressed in floats.
+    _counters.numUploadedBytes += size * sizeof(float);
+
+    begin(Command::UPLOAD_VERTEX_BUFFER_DATA);
+    write(vertexBuffer);
+    write(offset);
+    write(size);
+    write(data, size * sizeof(float));
+    end();
+
+    if (_context)
+        _context->uploadVertexBufferData(vertexBuffer, offset, size, data);
+}
+
+void
+RecordingContext::orphanVertexBuffer(const uint vertexBuffer, const uint size)
+{
+    begin(Command::ORPHAN_VERTEX_BUFFER);
+    write(vertexBuffer);
+    write(size);
+    end();
+
+    if (_context)
+        _context->orphanVertexBuffer(vertexBuffer, size);
+}
+
+void
+RecordingContext::deleteVertexBuffer(const uint vertexBuffer)
+{
+    for (auto binding = _vertexBufferBindings.begin(); binding != _vertexBufferBindings.end();)
+        binding = binding->second.vertexBuffer == vertexBuffer ? _vertexBufferBindings.erase(binding) : std::next(binding);
+
+    begin(Command::DELETE_VERTEX_BUFFER);
+    write(vertexBuffer);
+    end();
+
+    if (_context)
+        _context->deleteVertexBuffer(vertexBuffer);
+}
+
+const uint
+RecordingContext::createIndexBuffer(const uint size)
+{
+    return createIndexBuffer(size, sizeof(unsigned short));
+}
+
+const uint
+RecordingContext::createIndexBuffer(const uint size, const uint indexSize)
+{
+    auto indexBuffer = _context ? _context->createIndexBuffer(size, indexSize) : nextResourceId();
+
+    _indexSizes[indexBuffer] = indexSize;
+
+    begin(Command::CREATE_INDEX_BUFFER);
+    write(indexBuffer);
+    write(size);
+    write(indexSize);
+    end();
+
+    return indexBuffer;
+}
+
+void
+RecordingContext::uploadIndexBufferData(const uint indexBuffer, const uint offset, const uint size, void* data)
+{
+    // Offset and size are expressed in indices.
+    auto indexSize = _indexSizes.count(indexBuffer) != 0 ? _indexSizes[indexBuffer] : sizeof(unsigned short);
+
+    _counters.numUploadedBytes += size * indexSize;
+
+    begin(Command::UPLOAD_INDEX_BUFFER_DATA);
+    write(indexBuffer);
+    write(offset);
+    write(size);
+    write(data, size * indexSize);
+    end();
+
+    if (_context)
+        _context->uploadIndexBufferData(indexBuffer, offset, size, data);
+}
+
+void
+RecordingContext::orphanIndexBuffer(const uint indexBuffer, const uint size)
+{
+    begin(Command::ORPHAN_INDEX_BUFFER);
+    write(indexBuffer);
+    write(size);
+    end();
+
+    if (_context)
+        _context->orphanIndexBuffer(indexBuffer, size);
+}
+
+void
+RecordingContext::deleteIndexBuffer(const uint indexBuffer)
+{
+    _indexSizes.erase(indexBuffer);
+
+    begin(Command::DELETE_INDEX_BUFFER);
+    write(indexBuffer);
+    end();
+
+    if (_context)
+        _context->deleteIndexBuffer(indexBuffer);
+}
+
+bool
+RecordingContext::supportsUnsignedIntIndices()
+{
+    return _context ? _context->supportsUnsignedIntIndices() : true;
+}
+
+uint
+RecordingContext::createTexture(TextureType   type,
+                                unsigned int  width,
+                                unsigned int  height,
+                                bool          mipMapping,
+                                bool          optimizeForRenderToTexture)
+{
+    auto texture = _context
+        ? _context->createTexture(type, width, height, mipMapping, optimizeForRenderToTexture)
+        : nextResourceId();
+
+    begin(Command::CREATE_TEXTURE);
+    write(texture);
+    write(static_cast<uint>(type));
+    write(width);
+    write(height);
+    write(mipMapping);
+    write(optimizeForRenderToTexture);
+    end();
+
+    return texture;
+}
+
+uint
+RecordingContext::createRectangleTexture(TextureType type, unsigned int width, unsigned int height)
+{
+    auto texture = _context ? _context->createRectangleTexture(type, width, height) : nextResourceId();
+
+    begin(Command::CREATE_RECTANGLE_TEXTURE);
+    write(texture);
+    write(static_cast<uint>(type));
+    write(width);
+    write(height);
+    end();
+
+    return texture;
+}
+
+uint
+RecordingContext::createCompressedTexture(TextureType     type,
+                                          TextureFormat   format,
+                                          unsigned int    width,
+                                          unsigned int    height,
+                                          bool            mipMapping)
+{
+    auto texture = _context
+        ? _context->createCompressedTexture(type, format, width, height, mipMapping)
+        : nextResourceId();
+
+    begin(Command::CREATE_COMPRESSED_TEXTURE);
+    write(texture);
+    write(static_cast<uint>(type));
+    write(static_cast<uint>(format));
+    write(width);
+    write(height);
+    write(mipMapping);
+    end();
+
+    return texture;
+}
+
+void
+RecordingContext::uploadTexture2dData(uint            texture,
+                                      unsigned int    width,
+                                      unsigned int    height,
+                                      unsigned int    mipLevel,
+                                      void*           data)
+{
+    auto size = width * height * 4;
+
+    _counters.numUploadedBytes += size;
+
+    begin(Command::UPLOAD_TEXTURE_2D_DATA);
+    write(texture);
+    write(width);
+    write(height);
+    write(mipLevel);
+    write(data, size);
+    end();
+
+    if (_context)
+        _context->uploadTexture2dData(texture, width, height, mipLevel, data);
+}
+
+void
+RecordingContext::uploadCubeTextureData(uint                texture,
+                                        CubeTexture::Face   face,
+                                        unsigned int        width,
+                                        unsigned int        height,
+                                        unsigned int        mipLevel,
+                                        void*               data)
+{
+    auto size = width * height * 4;
+
+    _counters.numUploadedBytes += size;
+
+    begin(Command::UPLOAD_CUBE_TEXTURE_DATA);
+    write(texture);
+    write(static_cast<uint>(face));
+    write(width);
+    write(height);
+    write(mipLevel);
+    write(data, size);
+    end();
+
+    if (_context)
+        _context->uploadCubeTextureData(texture, face, width, height, mipLevel, data);
+}
+
+void
+RecordingContext::uploadCompressedTexture2dData(uint          texture,
+                                                TextureFormat format,
+                                                unsigned int  width,
+                                                unsigned int  height,
+                                                unsigned int  size,
+                                                unsigned int  mipLevel,
+                                                void*         data)
+{
+    _counters.numUploadedBytes += size;
+
+    begin(Command::UPLOAD_COMPRESSED_TEXTURE_2D_DATA);
+    write(texture);
+    write(static_cast<uint>(format));
+    write(width);
+    write(height);
+    write(mipLevel);
+    write(data, size);
+    end();
+
+    if (_context)
+        _context->uploadCompressedTexture2dData(texture, format, width, height, size, mipLevel, data);
+}
+
+void
+RecordingContext::uploadCompressedCubeTextureData(uint                texture,
+                                                  CubeTexture::Face   face,
+                                                  TextureFormat       format,
+                                                  unsigned int        width,
+                                                  unsigned int        height,
+                                                  unsigned int        mipLevel,
+                                                  void*               data)
+{
+    auto size = TextureFormatInfo::textureSize(format, width, height);
+
+    _counters.numUploadedBytes += size;
+
+    begin(Command::UPLOAD_COMPRESSED_CUBE_TEXTURE_DATA);
+    write(texture);
+    write(static_cast<uint>(face));
+    write(static_cast<uint>(format));
+    write(width);
+    write(height);
+    write(mipLevel);
+    write(data, size);
+    end();
+
+    if (_context)
+        _context->uploadCompressedCubeTextureData(texture, face, format, width, height, mipLevel, data);
+}
+
+void
+RecordingContext::activateMipMapping(uint texture)
+{
+    begin(Command::ACTIVATE_MIPMAPPING);
+    write(texture);
+    end();
+
+    if (_context)
+        _context->activateMipMapping(texture);
+}
+
+void
+RecordingContext::deleteTexture(uint texture)
+{
+    for (auto binding = _textures.begin(); binding != _textures.end();)
+        binding = binding->second == static_cast<int>(texture) ? _textures.erase(binding) : std::next(binding);
+
+    begin(Command::DELETE_TEXTURE);
+    write(texture);
+    end();
+
+    if (_context)
+        _context->deleteTexture(texture);
+}
+
+void
+RecordingContext::setTextureAt(uint position, int texture, int location)
+{
+    auto binding = _textures.find(position);
+
+    ++_counters.numTextureBinds;
+    if (binding != _textures.end() && binding->second == texture)
+        ++_counters.numRedundantTextureBinds;
+    else
+        _textures[position] = texture;
+
+    begin(Command::SET_TEXTURE_AT);
+    write(position);
+    write(texture);
+    write(location);
+    end();
+
+    if (_context)
+        _context->setTextureAt(position, texture, location);
+}
+
+void
+RecordingContext::setSamplerStateAt(uint            position,
+                                    WrapMode        wrapping,
+                                    TextureFilter   filtering,
+                                    MipFilter       mipFiltering)
+{
+    begin(Command::SET_SAMPLER_STATE_AT);
+    write(position);
+    write(static_cast<uint>(wrapping));
+    write(static_cast<uint>(filtering));
+    write(static_cast<uint>(mipFiltering));
+    end();
+
+    if (_context)
+        _context->setSamplerStateAt(position, wrapping, filtering, mipFiltering);
+}
+
+const uint
+RecordingContext::createProgram()
+{
+    auto program = _context ? _context->createProgram() : nextResourceId();
+
+    begin(Command::CREATE_PROGRAM);
+    write(program);
+    end();
+
+    return program;
+}
+
+void
+RecordingContext::attachShader(const uint program, const uint shader)
+{
+    if (!_context)
+        _programShaders[program].push_back(shader);
+
+    begin(Command::ATTACH_SHADER);
+    write(program);
+    write(shader);
+    end();
+
+    if (_context)
+        _context->attachShader(program, shader);
+}
+
+void
+RecordingContext::linkProgram(const uint program)
+{
+    begin(Command::LINK_PROGRAM);
+    write(program);
+    end();
+
+    if (_context)
+        _context->linkProgram(program);
+}
+
+void
+RecordingContext::deleteProgram(const uint program)
+{
+    _programShaders.erase(program);
+    if (_currentProgram == program)
+        _currentProgram = 0;
+
+    begin(Command::DELETE_PROGRAM);
+    write(program);
+    end();
+
+    if (_context)
+        _context->deleteProgram(program);
+}
+
+void
+RecordingContext::setProgram(const uint program)
+{
+    ++_counters.numProgramChanges;
+    if (program == _currentProgram)
+        ++_counters.numRedundantProgramChanges;
+
+    _currentProgram = program;
+
+    begin(Command::SET_PROGRAM);
+    write(program);
+    end();
+
+    if (_context)
+        _context->setProgram(program);
+}
+
+void
+RecordingContext::compileShader(const uint shader)
+{
+    begin(Command::COMPILE_SHADER);
+    write(shader);
+    end();
+
+    if (_context)
+        _context->compileShader(shader);
+}
+
+void
+RecordingContext::setShaderSource(const uint shader, const std::string& source)
+{
+    if (!_context)
+        _shaderSources[shader] = source;
+
+    begin(Command::SET_SHADER_SOURCE);
+    write(shader);
+    write(source);
+    end();
+
+    if (_context)
+        _context->setShaderSource(shader, source);
+}
+
+const uint
+RecordingContext::createVertexShader()
+{
+    auto shader = _context ? _context->createVertexShader() : nextResourceId();
+
+    if (!_context)
+        _vertexShaders.insert(shader);
+
+    begin(Command::CREATE_VERTEX_SHADER);
+    write(shader);
+    end();
+
+    return shader;
+}
+
+void
+RecordingContext::deleteVertexShader(const uint vertexShader)
+{
+    _vertexShaders.erase(vertexShader);
+    _shaderSources.erase(vertexShader);
+
+    begin(Command::DELETE_VERTEX_SHADER);
+    write(vertexShader);
+    end();
+
+    if (_context)
+        _context->deleteVertexShader(vertexShader);
+}
+
+const uint
+RecordingContext::createFragmentShader()
+{
+    auto shader = _context ? _context->createFragmentShader() : nextResourceId();
+
+    begin(Command::CREATE_FRAGMENT_SHADER);
+    write(shader);
+    end();
+
+    return shader;
+}
+
+void
+RecordingContext::deleteFragmentShader(const uint fragmentShader)
+{
+    _shaderSources.erase(fragmentShader);
+
+    begin(Command::DELETE_FRAGMENT_SHADER);
+    write(fragmentShader);
+    end();
+
+    if (_context)
+        _context->deleteFragmentShader(fragmentShader);
+}
+
+ProgramInputs
+RecordingContext::getProgramInputs(const uint program)
+{
+    ProgramInputs inputs;
+
+    if (_context)
+        inputs = _context->getProgramInputs(program);
+    else
+    {
+        std::string vertexShaderSource;
+        std::string fragmentShaderSource;
+
+        for (auto shader : _programShaders[program])
+        {
+            auto source = _shaderSources.find(shader);
+
+            if (source == _shaderSources.end())
+                continue;
+
+            if (_vertexShaders.count(shader) != 0)
+                vertexShaderSource += source->second;
+            else
+                fragmentShaderSource += source->second;
+        }
+
+        inputs = _programInputsFunction(vertexShaderSource, fragmentShaderSource);
+    }
+
+    // The inputs are recorded so that the locations can be translated on replay.
+    begin(Command::PROGRAM_INPUTS);
+    write(program);
+    write(static_cast<uint>(inputs.uniforms().size()));
+    for (const auto& uniform : inputs.uniforms())
+    {
+        write(uniform.name);
+        write(uniform.location);
+    }
+    write(static_cast<uint>(inputs.attributes().size()));
+    for (const auto& attribute : inputs.attributes())
+    {
+        write(attribute.name);
+        write(attribute.location);
+    }
+    end();
+
+    return inputs;
+}
+
+void
+RecordingContext::setBlendingMode(Blending::Source source, Blending::Destination destination)
+{
+    begin(Command::SET_BLENDING_FACTORS);
+    write(static_cast<uint>(source) | static_cast<uint>(destination));
+    endState(Command::SET_BLENDING_MODE);
+
+    if (_context)
+        _context->setBlendingMode(source, destination);
+}
+
+void
+RecordingContext::setBlendingMode(Blending::Mode blendMode)
+{
+    begin(Command::SET_BLENDING_MODE);
+    write(static_cast<uint>(blendMode));
+    endState(Command::SET_BLENDING_MODE);
+
+    if (_context)
+        _context->setBlendingMode(blendMode);
+}
+
+void
+RecordingContext::setColorMask(bool colorMask)
+{
+    begin(Command::SET_COLOR_MASK);
+    write(colorMask);
+    endState(Command::SET_COLOR_MASK);
+
+    if (_context)
+        _context->setColorMask(colorMask);
+}
+
+void
+RecordingContext::setDepthTest(bool depthMask, CompareMode depthFunc)
+{
+    begin(Command::SET_DEPTH_TEST);
+    write(depthMask);
+    write(static_cast<uint>(depthFunc));
+    endState(Command::SET_DEPTH_TEST);
+
+    if (_context)
+        _context->setDepthTest(depthMask, depthFunc);
+}
+
+void
+RecordingContext::setStencilTest(CompareMode      stencilFunc,
+                                 int              stencilRef,
+                                 uint             stencilMask,
+                                 StencilOperation stencilFailOp,
+                                 StencilOperation stencilZFailOp,
+                                 StencilOperation stencilZPassOp)
+{
+    begin(Command::SET_STENCIL_TEST);
+    write(static_cast<uint>(stencilFunc));
+    write(stencilRef);
+    write(stencilMask);
+    write(static_cast<uint>(stencilFailOp));
+    write(static_cast<uint>(stencilZFailOp));
+    write(static_cast<uint>(stencilZPassOp));
+    endState(Command::SET_STENCIL_TEST);
+
+    if (_context)
+        _context->setStencilTest(stencilFunc, stencilRef, stencilMask, stencilFailOp, stencilZFailOp, stencilZPassOp);
+}
+
+void
+RecordingContext::setScissorTest(bool scissorTest, const math::ivec4& scissorBox)
+{
+    begin(Command::SET_SCISSOR_TEST);
+    write(scissorTest);
+    write(scissorBox);
+    endState(Command::SET_SCISSOR_TEST);
+
+    if (_context)
+        _context->setScissorTest(scissorTest, scissorBox);
+}
+
+void
+RecordingContext::readPixels(unsigned char* pixels)
+{
+    begin(Command::READ_PIXELS);
+    write(0u);
+    write(0u);
+    write(0u);
+    write(0u);
+    end();
+
+    if (_context)
+        _context->readPixels(pixels);
+    else
+        std::fill(pixels, pixels + _viewportWidth * _viewportHeight * 4, 0);
+}
+
+void
+RecordingContext::readPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels)
+{
+    begin(Command::READ_PIXELS);
+    write(x);
+    write(y);
+    write(width);
+    write(height);
+    end();
+
+    if (_context)
+        _context->readPixels(x, y, width, height, pixels);
+    else
+        std::fill(pixels, pixels + width * height * 4, 0);
+}
+
+void
+RecordingContext::setTriangleCulling(TriangleCulling triangleCulling)
+{
+    begin(Command::SET_TRIANGLE_CULLING);
+    write(static_cast<uint>(triangleCulling));
+    endState(Command::SET_TRIANGLE_CULLING);
+
+    if (_context)
+        _context->setTriangleCulling(triangleCulling);
+}
+
+void
+RecordingContext::setRenderToBackBuffer()
+{
+    _renderTarget = 0;
+
+    begin(Command::SET_RENDER_TO_BACK_BUFFER);
+    write(0u);
+    write(false);
+    endState(Command::SET_RENDER_TO_TEXTURE);
+
+    if (_context)
+        _context->setRenderToBackBuffer();
+}
+
+void
+RecordingContext::setRenderToTexture(unsigned int texture, bool enableDepthAndStencil)
+{
+    _renderTarget = texture;
+
+    begin(Command::SET_RENDER_TO_TEXTURE);
+    write(texture);
+    write(enableDepthAndStencil);
+    endState(Command::SET_RENDER_TO_TEXTURE);
+
+    if (_context)
+        _context->setRenderToTexture(texture, enableDepthAndStencil);
+}
+
+void
+RecordingContext::generateMipmaps(unsigned int texture)
+{
+    begin(Command::GENERATE_MIPMAPS);
+    write(texture);
+    end();
+
+    if (_context)
+        _context->generateMipmaps(texture);
+}
+
+void
+RecordingContext::setUniformFloat(uint location, uint count, const float* v)
+{
+    begin(Command::SET_UNIFORM_FLOAT);
+    write(location);
+    write(count);
+    write(v, count * sizeof(float));
+    endUniform(location);
+
+    if (_context)
+        _context->setUniformFloat(location, count, v);
+}
+
+void
+RecordingContext::setUniformFloat2(uint location, uint count, const float* v)
+{
+    begin(Command::SET_UNIFORM_FLOAT2);
+    write(location);
+    write(count);
+    write(v, count * 2 * sizeof(float));
+    endUniform(location);
+
+    if (_context)
+        _context->setUniformFloat2(location, count, v);
+}
+
+void
+RecordingContext::setUniformFloat3(uint location, uint count, const float* v)
+{
+    begin(Command::SET_UNIFORM_FLOAT3);
+    write(location);
+    write(count);
+    write(v, count * 3 * sizeof(float));
+    endUniform(location);
+
+    if (_context)
+        _context->setUniformFloat3(location, count, v);
+}
+
+void
+RecordingContext::setUniformFloat4(uint location, uint count, const float* v)
+{
+    begin(Command::SET_UNIFORM_FLOAT4);
+    write(location);
+    write(count);
+    write(v, count * 4 * sizeof(float));
+    endUniform(location);
+
+    if (_context)
+        _context->setUniformFloat4(location, count, v);
+}
+
+void
+RecordingContext::setUniformMatrix4x4(uint location, uint count, const float* v)
+{
+    begin(Command::SET_UNIFORM_MATRIX4X4);
+    write(location);
+    write(count);
+    write(v, count * 16 * sizeof(float));
+    endUniform(location);
+
+    if (_context)
+        _context->setUniformMatrix4x4(location, count, v);
+}
+
+void
+RecordingContext::setUniformInt(uint location, uint count, const int* v)
+{
+    begin(Command::SET_UNIFORM_INT);
+    write(location);
+    write(count);
+    write(v, count * sizeof(int));
+    endUniform(location);
+
+    if (_context)
+        _context->setUniformInt(location, count, v);
+}
+
+void
+RecordingContext::setUniformInt2(uint location, uint count, const int* v)
+{
+    begin(Command::SET_UNIFORM_INT2);
+    write(location);
+    write(count);
+    write(v, count * 2 * sizeof(int));
+    endUniform(location);
+
+    if (_context)
+        _context->setUniformInt2(location, count, v);
+}
+
+void
+RecordingContext::setUniformInt3(uint location, uint count, const int* v)
+{
+    begin(Command::SET_UNIFORM_INT3);
+    write(location);
+    write(count);
+    write(v, count * 3 * sizeof(int));
+    endUniform(location);
+
+    if (_context)
+        _context->setUniformInt3(location, count, v);
+}
+
+void
+RecordingContext::setUniformInt4(uint location, uint count, const int* v)
+{
+    begin(Command::SET_UNIFORM_INT4);
+    write(location);
+    write(count);
+    write(v, count * 4 * sizeof(int));
+    endUniform(location);
+
+    if (_context)
+        _context->setUniformInt4(location, count, v);
+}
+
+int
+RecordingContext::createVertexAttributeArray()
+{
+    // Without a context, vertex array objects are reported as unsupported so that the log can be
+    // replayed on any context.
+    auto vertexArray = _context ? _context->createVertexAttributeArray() : -1;
+
+    begin(Command::CREATE_VERTEX_ATTRIBUTE_ARRAY);
+    write(vertexArray);
+    end();
+
+    return vertexArray;
+}
+
+void
+RecordingContext::setVertexAttributeArray(const uint vertexArray)
+{
+    // The vertex buffer bindings belong to the vertex array object.
+    _vertexBufferBindings.clear();
+
+    begin(Command::SET_VERTEX_ATTRIBUTE_ARRAY);
+    write(vertexArray);
+    end();
+
+    if (_context)
+        _context->setVertexAttributeArray(vertexArray);
+}
+
+void
+RecordingContext::deleteVertexAttributeArray(const uint vertexArray)
+{
+    begin(Command::DELETE_VERTEX_ATTRIBUTE_ARRAY);
+    write(vertexArray);
+    end();
+
+    if (_context)
+        _context->deleteVertexAttributeArray(vertexArray);
+}
+
+ProgramInputs
+RecordingContext::scanProgramInputs(const std::string& vertexShaderSource, const std::string& fragmentShaderSource)
+{
+    // The GLSL compilers drop the inputs that are not used: the declarations alone would report
+    // inputs whose bindings are not meant to be resolved, such as the shadow maps of a light
+    // when shadows are disabled.
+    auto vertexShader = GLSLScanner(vertexShaderSource);
+    auto fragmentShader = GLSLScanner(fragmentShaderSource);
+    auto uniformNames = std::unordered_set<std::string>();
+    auto uniformLocation = 0;
+    auto attributeLocation = 0;
+
+    std::vector<ProgramInputs::UniformInput> uniforms;
+    std::vector<ProgramInputs::AttributeInput> attributes;
+
+    for (auto shader : { &vertexShader, &fragmentShader })
+    {
+        for (const auto& declaration : shader->declarations())
+        {
+            if (!vertexShader.uses(declaration.name) && !fragmentShader.uses(declaration.name))
+                continue;
+
+            if (!declaration.isUniform)
+            {
+                if (shader == &vertexShader)
+                    attributes.emplace_back(declaration.name, attributeLocation++);
+
+                continue;
+            }
+
+            if (!uniformNames.insert(declaration.name).second)
+                continue;
+
+            // Most drivers report arrays with the name of their first element.
+            auto name = declaration.size > 1 ? declaration.name + "[0]" : declaration.name;
+
+            uniforms.emplace_back(name, uniformLocation, declaration.size, declaration.type);
+            uniformLocation += declaration.size;
+        }
+    }
+
+    return ProgramInputs(std::move(uniforms), std::move(attributes));
+}
+
+void
+RecordingContext::replay(const std::vector<unsigned char>& log, AbstractContext::Ptr context)
+{
+    typedef std::unordered_map<uint, uint>              IdMap;
+    typedef std::unordered_map<int, int>                LocationMap;
+
+    LogReader reader(log);
+
+    if (reader.read<uint>() != LOG_MAGIC || reader.read<uint>() != LOG_VERSION)
+        throw std::invalid_argument("log");
+
+    IdMap resources;
+    std::unordered_map<uint, LocationMap> uniformLocations;
+    std::unordered_map<uint, LocationMap> attributeLocations;
+    auto currentProgram = 0u;
+
+    auto resource = [&](uint id) -> uint
+    {
+        if (id == 0)
+            return 0;
+
+        auto it = resources.find(id);
+
+        if (it == resources.end())
+            throw std::runtime_error("command log uses a resource created before it started");
+
+        return it->second;
+    };
+
+    // Array names are reported with or without the "[0]" suffix depending on the driver.
+    auto inputName = [](const std::string& name)
+    {
+        auto size = name.size();
+
+        return size > 3 && name.compare(size - 3, 3, "[0]") == 0 ? name.substr(0, size - 3) : name;
+    };
+
+    auto location = [&](std::unordered_map<uint, LocationMap>& locations, int recordedLocation) -> int
+    {
+        auto& programLocations = locations[currentProgram];
+        auto it = programLocations.find(recordedLocation);
+
+        return it == programLocations.end() ? -1 : it->second;
+    };
+
+    while (!reader.eof())
+    {
+        auto command = static_cast<Command>(reader.read<unsigned char>());
+
+        reader.read<uint64_t>(); // time
+        auto size = reader.read<uint>();
+        auto next = reader.offset() + size;
+
+        switch (command)
+        {
+        case Command::CLEAR:
+        {
+            auto clearFlags = reader.read<uint>();
+            auto red = reader.read<float>();
+            auto green = reader.read<float>();
+            auto blue = reader.read<float>();
+            auto alpha = reader.read<float>();
+            auto depth = reader.read<float>();
+            auto stencil = reader.read<unsigned int>();
+            auto mask = reader.read<unsigned int>();
+
+            context->clear(clearFlags, red, green, blue, alpha, depth, stencil, mask);
+            break;
+        }
+        case Command::PRESENT:
+            context->present();
+            break;
+        case Command::CONFIGURE_VIEWPORT:
+        {
+            auto x = reader.read<uint>();
+            auto y = reader.read<uint>();
+            auto width = reader.read<uint>();
+            auto height = reader.read<uint>();
+
+            context->configureViewport(x, y, width, height);
+            break;
+        }
+        case Command::DRAW_TRIANGLES:
+        {
+            auto firstIndex = reader.read<uint>();
+            auto numTriangles = reader.read<int>();
+
+            context->drawTriangles(firstIndex, numTriangles);
+            break;
+        }
+        case Command::DRAW_INDEXED_TRIANGLES:
+        {
+            auto indexBuffer = resource(reader.read<uint>());
+            auto firstIndex = reader.read<uint>();
+            auto numTriangles = reader.read<int>();
+
+            context->drawTriangles(indexBuffer, firstIndex, numTriangles);
+            break;
+        }
+        case Command::CREATE_VERTEX_BUFFER:
+        {
+            auto id = reader.read<uint>();
+
+            resources[id] = context->createVertexBuffer(reader.read<uint>());
+            break;
+        }
+        case Command::SET_VERTEX_BUFFER_AT:
+        {
+            auto position = location(attributeLocations, reader.read<uint>());
+            auto vertexBuffer = resource(reader.read<uint>());
+            auto vertexSize = reader.read<uint>();
+            auto stride = reader.read<uint>();
+            auto offset = reader.read<uint>();
+            auto format = static_cast<VertexAttribute::Format>(reader.read<uint>());
+
+            if (position >= 0)
+                context->setVertexBufferAt(position, vertexBuffer, vertexSize, stride, offset, format);
+            break;
+        }
+        case Command::UPLOAD_VERTEX_BUFFER_DATA:
+        {
+            auto vertexBuffer = resource(reader.read<uint>());
+            auto offset = reader.read<uint>();
+            auto numFloats = reader.read<uint>();
+            auto data = reader.readData();
+
+            context->uploadVertexBufferData(vertexBuffer, offset, numFloats, data.data());
+            break;
+        }
+        case Command::DELETE_VERTEX_BUFFER:
+            context->deleteVertexBuffer(resource(reader.read<uint>()));
+            break;
+        case Command::CREATE_INDEX_BUFFER:
+        {
+            auto id = reader.read<uint>();
+            auto numIndices = reader.read<uint>();
+            auto indexSize = reader.read<uint>();
+
+            resources[id] = context->createIndexBuffer(numIndices, indexSize);
+            break;
+        }
+        case Command::UPLOAD_INDEX_BUFFER_DATA:
+        {
+            auto indexBuffer = resource(reader.read<uint>());
+            auto offset = reader.read<uint>();
+            auto numIndices = reader.read<uint>();
+            auto data = reader.readData();
+
+            context->uploadIndexBufferData(indexBuffer, offset, numIndices, data.data());
+            break;
+        }
+        case Command::DELETE_INDEX_BUFFER:
+            context->deleteIndexBuffer(resource(reader.read<uint>()));
+            break;
+        case Command::CREATE_TEXTURE:
+        {
+            auto id = reader.read<uint>();
+            auto type = static_cast<TextureType>(reader.read<uint>());
+            auto width = reader.read<uint>();
+            auto height = reader.read<uint>();
+            auto mipMapping = reader.read<bool>();
+            auto optimizeForRenderToTexture = reader.read<bool>();
+
+            resources[id] = context->createTexture(type, width, height, mipMapping, optimizeForRenderToTexture);
+            break;
+        }
+        case Command::CREATE_RECTANGLE_TEXTURE:
+        {
+            auto id = reader.read<uint>();
+            auto type = static_cast<TextureType>(reader.read<uint>());
+            auto width = reader.read<uint>();
+            auto height = reader.read<uint>();
+
+            resources[id] = context->createRectangleTexture(type, width, height);
+            break;
+        }
+        case Command::CREATE_COMPRESSED_TEXTURE:
+        {
+            auto id = reader.read<uint>();
+            auto type = static_cast<TextureType>(reader.read<uint>());
+            auto format = static_cast<TextureFormat>(reader.read<uint>());
+            auto width = reader.read<uint>();
+            auto height = reader.read<uint>();
+            auto mipMapping = reader.read<bool>();
+
+            resources[id] = context->createCompressedTexture(type, format, width, height, mipMapping);
+            break;
+        }
+        case Command::UPLOAD_TEXTURE_2D_DATA:
+        {
+            auto texture = resource(reader.read<uint>());
+            auto width = reader.read<uint>();
+            auto height = reader.read<uint>();
+            auto mipLevel = reader.read<uint>();
+            auto data = reader.readData();
+
+            context->uploadTexture2dData(texture, width, height, mipLevel, data.data());
+            break;
+        }
+        case Command::UPLOAD_CUBE_TEXTURE_DATA:
+        {
+            auto texture = resource(reader.read<uint>());
+            auto face = static_cast<CubeTexture::Face>(reader.read<uint>());
+            auto width = reader.read<uint>();
+            auto height = reader.read<uint>();
+            auto mipLevel = reader.read<uint>();
+            auto data = reader.readData();
+
+            context->uploadCubeTextureData(texture, face, width, height, mipLevel, data.data());
+            break;
+        }
+        case Command::UPLOAD_COMPRESSED_TEXTURE_2D_DATA:
+        {
+            auto texture = resource(reader.read<uint>());
+            auto format = static_cast<TextureFormat>(reader.read<uint>());
+            auto width = reader.read<uint>();
+            auto height = reader.read<uint>();
+            auto mipLevel = reader.read<uint>();
+            auto data = reader.readData();
+
+            context->uploadCompressedTexture2dData(
+                texture, format, width, height, static_cast<uint>(data.size()), mipLevel, data.data()
+            );
+            break;
+        }
+        case Command::UPLOAD_COMPRESSED_CUBE_TEXTURE_DATA:
+        {
+            auto texture = resource(reader.read<uint>());
+            auto face = static_cast<CubeTexture::Face>(reader.read<uint>());
+            auto format = static_cast<TextureFormat>(reader.read<uint>());
+            auto width = reader.read<uint>();
+            auto height = reader.read<uint>();
+            auto mipLevel = reader.read<uint>();
+            auto data = reader.readData();
+
+            context->uploadCompressedCubeTextureData(texture, face, format, width, height, mipLevel, data.data());
+            break;
+        }
+        case Command::ACTIVATE_MIPMAPPING:
+            context->activateMipMapping(resource(reader.read<uint>()));
+            break;
+        case Command::GENERATE_MIPMAPS:
+            context->generateMipmaps(resource(reader.read<uint>()));
+            break;
+        case Command::DELETE_TEXTURE:
+            context->deleteTexture(resource(reader.read<uint>()));
+            break;
+        case Command::SET_TEXTURE_AT:
+        {
+            auto position = reader.read<uint>();
+            auto texture = reader.read<int>();
+            auto textureLocation = reader.read<int>();
+
+            context->setTextureAt(
+                position,
+                texture > 0 ? resource(texture) : texture,
+                textureLocation >= 0 ? location(uniformLocations, textureLocation) : textureLocation
+            );
+            break;
+        }
+        case Command::SET_SAMPLER_STATE_AT:
+        {
+            auto position = reader.read<uint>();
+            auto wrapping = static_cast<WrapMode>(reader.read<uint>());
+            auto filtering = static_cast<TextureFilter>(reader.read<uint>());
+            auto mipFiltering = static_cast<MipFilter>(reader.read<uint>());
+
+            context->setSamplerStateAt(position, wrapping, filtering, mipFiltering);
+            break;
+        }
+        case Command::CREATE_PROGRAM:
+        {
+            auto id = reader.read<uint>();
+
+            resources[id] = context->createProgram();
+            break;
+        }
+        case Command::ATTACH_SHADER:
+        {
+            auto program = resource(reader.read<uint>());
+            auto shader = resource(reader.read<uint>());
+
+            context->attachShader(program, shader);
+            break;
+        }
+        case Command::LINK_PROGRAM:
+            context->linkProgram(resource(reader.read<uint>()));
+            break;
+        case Command::PROGRAM_INPUTS:
+        {
+            auto program = reader.read<uint>();
+            auto inputs = context->getProgramInputs(resource(program));
+            auto uniforms = std::unordered_map<std::string, int>();
+            auto attributes = std::unordered_map<std::string, int>();
+
+            for (const auto& uniform : inputs.uniforms())
+                uniforms[inputName(uniform.name)] = uniform.location;
+            for (const auto& attribute : inputs.attributes())
+                attributes[attribute.name] = attribute.location;
+
+            auto& programUniformLocations = uniformLocations[program];
+            auto& programAttributeLocations = attributeLocations[program];
+
+            programUniformLocations.clear();
+            programAttributeLocations.clear();
+
+            for (auto i = reader.read<uint>(); i > 0; --i)
+            {
+                auto name = inputName(reader.readString());
+                auto recordedLocation = reader.read<int>();
+
+                if (uniforms.count(name) != 0)
+                    programUniformLocations[recordedLocation] = uniforms[name];
+            }
+            for (auto i = reader.read<uint>(); i > 0; --i)
+            {
+                auto name = reader.readString();
+                auto recordedLocation = reader.read<int>();
+
+                if (attributes.count(name) != 0)
+                    programAttributeLocations[recordedLocation] = attributes[name];
+            }
+
+            // getProgramInputs() might have changed the current program of the context.
+            if (currentProgram != 0)
+                context->setProgram(resource(currentProgram));
+            break;
+        }
+        case Command::SET_PROGRAM:
+            currentProgram = reader.read<uint>();
+            context->setProgram(resource(currentProgram));
+            break;
+        case Command::DELETE_PROGRAM:
+        {
+            auto program = reader.read<uint>();
+
+            uniformLocations.erase(program);
+            attributeLocations.erase(program);
+            if (currentProgram == program)
+                currentProgram = 0;
+            context->deleteProgram(resource(program));
+            break;
+        }
+        case Command::CREATE_VERTEX_SHADER:
+        {
+            auto id = reader.read<uint>();
+
+            resources[id] = context->createVertexShader();
+            break;
+        }
+        case Command::CREATE_FRAGMENT_SHADER:
+        {
+            auto id = reader.read<uint>();
+
+            resources[id] = context->createFragmentShader();
+            break;
+        }
+        case Command::SET_SHADER_SOURCE:
+        {
+            auto shader = resource(reader.read<uint>());
+
+            context->setShaderSource(shader, reader.readString());
+            break;
+        }
+        case Command::COMPILE_SHADER:
+            context->compileShader(resource(reader.read<uint>()));
+            break;
+        case Command::DELETE_VERTEX_SHADER:
+            context->deleteVertexShader(resource(reader.read<uint>()));
+            break;
+        case Command::DELETE_FRAGMENT_SHADER:
+            context->deleteFragmentShader(resource(reader.read<uint>()));
+            break;
+        case Command::SET_BLENDING_FACTORS:
+        case Command::SET_BLENDING_MODE:
+            context->setBlendingMode(static_cast<Blending::Mode>(reader.read<uint>()));
+            break;
+        case Command::SET_COLOR_MASK:
+            context->setColorMask(reader.read<bool>());
+            break;
+        case Command::SET_DEPTH_TEST:
+        {
+            auto depthMask = reader.read<bool>();
+            auto depthFunc = static_cast<CompareMode>(reader.read<uint>());
+
+            context->setDepthTest(depthMask, depthFunc);
+            break;
+        }
+        case Command::SET_STENCIL_TEST:
+        {
+            auto stencilFunc = static_cast<CompareMode>(reader.read<uint>());
+            auto stencilRef = reader.read<int>();
+            auto stencilMask = reader.read<uint>();
+            auto stencilFailOp = static_cast<StencilOperation>(reader.read<uint>());
+            auto stencilZFailOp = static_cast<StencilOperation>(reader.read<uint>());
+            auto stencilZPassOp = static_cast<StencilOperation>(reader.read<uint>());
+
+            context->setStencilTest(stencilFunc, stencilRef, stencilMask, stencilFailOp, stencilZFailOp, stencilZPassOp);
+            break;
+        }
+        case Command::SET_SCISSOR_TEST:
+        {
+            auto scissorTest = reader.read<bool>();
+            auto scissorBox = reader.read<math::ivec4>();
+
+            context->setScissorTest(scissorTest, scissorBox);
+            break;
+        }
+        case Command::SET_TRIANGLE_CULLING:
+            context->setTriangleCulling(static_cast<TriangleCulling>(reader.read<uint>()));
+            break;
+        case Command::SET_RENDER_TO_BACK_BUFFER:
+            context->setRenderToBackBuffer();
+            break;
+        case Command::SET_RENDER_TO_TEXTURE:
+        {
+            auto texture = resource(reader.read<uint>());
+            auto enableDepthAndStencil = reader.read<bool>();
+
+            context->setRenderToTexture(texture, enableDepthAndStencil);
+            break;
+        }
+        case Command::READ_PIXELS:
+        {
+            auto x = reader.read<uint>();
+            auto y = reader.read<uint>();
+            auto width = reader.read<uint>();
+            auto height = reader.read<uint>();
+
+            // An empty rectangle stands for the whole viewport.
+            if (width == 0 || height == 0)
+            {
+                std::vector<unsigned char> pixels(context->viewportWidth() * context->viewportHeight() * 4);
+
+                context->readPixels(pixels.data());
+            }
+            else
+            {
+                std::vector<unsigned char> pixels(width * height * 4);
+
+                context->readPixels(x, y, width, height, pixels.data());
+            }
+            break;
+        }
+        case Command::SET_UNIFORM_FLOAT:
+        case Command::SET_UNIFORM_FLOAT2:
+        case Command::SET_UNIFORM_FLOAT3:
+        case Command::SET_UNIFORM_FLOAT4:
+        case Command::SET_UNIFORM_MATRIX4X4:
+        case Command::SET_UNIFORM_INT:
+        case Command::SET_UNIFORM_INT2:
+        case Command::SET_UNIFORM_INT3:
+        case Command::SET_UNIFORM_INT4:
+        {
+            auto uniformLocation = location(uniformLocations, reader.read<uint>());
+            auto count = reader.read<uint>();
+            auto data = reader.readData();
+            auto floats = reinterpret_cast<const float*>(data.data());
+            auto ints = reinterpret_cast<const int*>(data.data());
+
+            if (uniformLocation < 0)
+                break;
+
+            if (command == Command::SET_UNIFORM_FLOAT)
+                context->setUniformFloat(uniformLocation, count, floats);
+            else if (command == Command::SET_UNIFORM_FLOAT2)
+                context->setUniformFloat2(uniformLocation, count, floats);
+            else if (command == Command::SET_UNIFORM_FLOAT3)
+                context->setUniformFloat3(uniformLocation, count, floats);
+            else if (command == Command::SET_UNIFORM_FLOAT4)
+                context->setUniformFloat4(uniformLocation, count, floats);
+            else if (command == Command::SET_UNIFORM_MATRIX4X4)
+                context->setUniformMatrix4x4(uniformLocation, count, floats);
+            else if (command == Command::SET_UNIFORM_INT)
+                context->setUniformInt(uniformLocation, count, ints);
+            else if (command == Command::SET_UNIFORM_INT2)
+                context->setUniformInt2(uniformLocation, count, ints);
+            else if (command == Command::SET_UNIFORM_INT3)
+                context->setUniformInt3(uniformLocation, count, ints);
+            else
+                context->setUniformInt4(uniformLocation, count, ints);
+            break;
+        }
+        case Command::CREATE_VERTEX_ATTRIBUTE_ARRAY:
+        {
+            auto id = reader.read<int>();
+
+            if (id != -1)
+                resources[id] = context->createVertexAttributeArray();
+            break;
+        }
+        case Command::SET_VERTEX_ATTRIBUTE_ARRAY:
+            context->setVertexAttributeArray(resource(reader.read<uint>()));
+            break;
+        case Command::DELETE_VERTEX_ATTRIBUTE_ARRAY:
+            context->deleteVertexAttributeArray(resource(reader.read<uint>()));
+            break;
+        case Command::ORPHAN_VERTEX_BUFFER:
+        {
+            auto vertexBuffer = resource(reader.read<uint>());
+
+            context->orphanVertexBuffer(vertexBuffer, reader.read<uint>());
+            break;
+        }
+        case Command::ORPHAN_INDEX_BUFFER:
+        {
+            auto indexBuffer = resource(reader.read<uint>());
+
+            context->orphanIndexBuffer(indexBuffer, reader.read<uint>());
+            break;
+        }
+        default:
+            // Commands from a newer version of the log are skipped.
+            break;
+        }
+
+        reader.seek(next);
+    }
+}
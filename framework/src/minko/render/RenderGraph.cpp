@@ -0,0 +1,306 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/RenderGraph.hpp"
+
+#include "minko/render/AbstractTexture.hpp"
+#include "minko/render/RenderTargetPool.hpp"
+
+#include <numeric>
+
+using namespace minko;
+using namespace minko::render;
+
+RenderGraph::RenderGraph(RenderTargetPoolPtr pool) :
+	_pool(pool),
+	_passes(),
+	_targets(),
+	_order(),
+	_physicalTargets(),
+	_physicalTargetMemory(),
+	_transientMemory(0)
+{
+}
+
+RenderGraph::~RenderGraph()
+{
+	releasePhysicalTargets();
+}
+
+RenderGraph::Ptr
+RenderGraph::target(const std::string& name, uint width, uint height, bool isCube)
+{
+	_targets[name] = { width, height, isCube, false, -1 };
+
+	return shared_from_this();
+}
+
+RenderGraph::Ptr
+RenderGraph::output(const std::string& name)
+{
+	if (!hasTarget(name))
+		throw std::invalid_argument("name");
+
+	_targets[name].output = true;
+
+	return shared_from_this();
+}
+
+RenderGraph::Ptr
+RenderGraph::pass(const std::string& name, const std::vector<std::string>& reads, const std::string& write)
+{
+	_passes.push_back({ name, reads, write, {}, false });
+
+	return shared_from_this();
+}
+
+void
+RenderGraph::compile()
+{
+	auto numPasses = static_cast<uint>(_passes.size());
+
+	releasePhysicalTargets();
+	_order.clear();
+	_transientMemory = 0;
+
+	// dependencies: read after write, write after read and write after write on the same target
+	std::unordered_map<std::string, uint> lastWriter;
+	std::unordered_map<std::string, std::vector<uint>> readersSinceWrite;
+	std::vector<std::vector<uint>> producers(numPasses);
+	std::unordered_set<std::string> history;
+
+	for (auto passId = 0u; passId < numPasses; ++passId)
+	{
+		auto& pass = _passes[passId];
+
+		pass.dependencies.clear();
+		pass.culled = true;
+
+		for (const auto& read : pass.reads)
+		{
+			if (!hasTarget(read))
+				continue;
+
+			auto writerIt = lastWriter.find(read);
+
+			if (writerIt != lastWriter.end() && writerIt->second != passId)
+			{
+				pass.dependencies.push_back(writerIt->second);
+				producers[passId].push_back(writerIt->second);
+			}
+			else if (writerIt == lastWriter.end())
+				history.insert(read);
+			readersSinceWrite[read].push_back(passId);
+		}
+
+		if (hasTarget(pass.write))
+		{
+			auto writerIt = lastWriter.find(pass.write);
+
+			if (writerIt != lastWriter.end())
+				pass.dependencies.push_back(writerIt->second);
+			for (auto readerId : readersSinceWrite[pass.write])
+				if (readerId != passId)
+					pass.dependencies.push_back(readerId);
+
+			lastWriter[pass.write] = passId;
+			readersSinceWrite[pass.write].clear();
+		}
+	}
+
+	// culling: keep the passes with external side effects and, transitively, the passes they read from;
+	// writing a target read before being written is a side effect on the next frame
+	std::vector<uint> toVisit;
+
+	for (auto passId = 0u; passId < numPasses; ++passId)
+	{
+		const auto& write = _passes[passId].write;
+
+		if (!hasTarget(write) || _targets.at(write).output || history.count(write) != 0)
+			toVisit.push_back(passId);
+	}
+
+	while (!toVisit.empty())
+	{
+		auto passId = toVisit.back();
+
+		toVisit.pop_back();
+		if (!_passes[passId].culled)
+			continue;
+
+		_passes[passId].culled = false;
+		for (auto producerId : producers[passId])
+			toVisit.push_back(producerId);
+	}
+
+	// ordering: topological sort that keeps the declaration order whenever the dependencies allow it
+	std::vector<uint> numDependencies(numPasses, 0);
+	std::vector<std::vector<uint>> dependents(numPasses);
+	std::priority_queue<uint, std::vector<uint>, std::greater<uint>> ready;
+
+	for (auto passId = 0u; passId < numPasses; ++passId)
+	{
+		if (_passes[passId].culled)
+			continue;
+
+		for (auto dependencyId : _passes[passId].dependencies)
+		{
+			if (_passes[dependencyId].culled)
+				continue;
+
+			++numDependencies[passId];
+			dependents[dependencyId].push_back(passId);
+		}
+
+		if (numDependencies[passId] == 0)
+			ready.push(passId);
+	}
+
+	while (!ready.empty())
+	{
+		auto passId = ready.top();
+
+		ready.pop();
+		_order.push_back(passId);
+
+		for (auto dependentId : dependents[passId])
+			if (--numDependencies[dependentId] == 0)
+				ready.push(dependentId);
+	}
+
+	// lifetimes, as [first use, last use] positions in the execution order
+	auto numOrderedPasses = static_cast<uint>(_order.size());
+	std::map<std::string, std::pair<uint, uint>> lifetimes;
+
+	for (auto position = 0u; position < numOrderedPasses; ++position)
+	{
+		const auto& pass = _passes[_order[position]];
+		auto use = [&](const std::string& name, bool write)
+		{
+			if (!hasTarget(name))
+				return;
+
+			auto lifetimeIt = lifetimes.find(name);
+
+			if (lifetimeIt == lifetimes.end())
+			{
+				// a target read before being written holds content from a previous frame: it must
+				// never be aliased
+				lifetimes[name] = write
+					? std::make_pair(position, position)
+					: std::make_pair(0u, numOrderedPasses);
+			}
+			else
+				lifetimeIt->second.second = std::max(lifetimeIt->second.second, position);
+		};
+
+		for (const auto& read : pass.reads)
+			use(read, false);
+		use(pass.write, true);
+	}
+
+	for (auto& lifetime : lifetimes)
+	{
+		const auto& target = _targets.at(lifetime.first);
+
+		if (target.output)
+			lifetime.second = std::make_pair(0u, numOrderedPasses);
+
+		_transientMemory += RenderTargetPool::targetMemory(target.width, target.height, target.isCube);
+	}
+
+	// allocation: a physical target is free again once the last pass using its current target is done
+	std::vector<bool> freePhysicalTargets;
+	std::vector<std::tuple<uint, uint, bool>> physicalTargetFormats;
+
+	for (auto& target : _targets)
+		target.second.physicalTarget = -1;
+
+	for (auto position = 0u; position < numOrderedPasses; ++position)
+	{
+		for (const auto& lifetime : lifetimes)
+		{
+			if (lifetime.second.first != position)
+				continue;
+
+			auto& target = _targets.at(lifetime.first);
+			auto format = std::make_tuple(target.width, target.height, target.isCube);
+			auto numPhysicalTargets = static_cast<int>(freePhysicalTargets.size());
+
+			for (auto i = 0; i < numPhysicalTargets && target.physicalTarget < 0; ++i)
+				if (freePhysicalTargets[i] && physicalTargetFormats[i] == format)
+					target.physicalTarget = i;
+
+			if (target.physicalTarget < 0)
+			{
+				target.physicalTarget = numPhysicalTargets;
+				freePhysicalTargets.push_back(false);
+				physicalTargetFormats.push_back(format);
+				_physicalTargetMemory.push_back(
+					RenderTargetPool::targetMemory(target.width, target.height, target.isCube)
+				);
+			}
+			else
+				freePhysicalTargets[target.physicalTarget] = false;
+		}
+
+		for (const auto& lifetime : lifetimes)
+			if (lifetime.second.second == position)
+				freePhysicalTargets[_targets.at(lifetime.first).physicalTarget] = true;
+	}
+
+	if (_pool)
+		for (const auto& format : physicalTargetFormats)
+			_physicalTargets.push_back(_pool->acquire(std::get<0>(format), std::get<1>(format), std::get<2>(format)));
+}
+
+int
+RenderGraph::physicalTarget(const std::string& name) const
+{
+	auto targetIt = _targets.find(name);
+
+	return targetIt != _targets.end() ? targetIt->second.physicalTarget : -1;
+}
+
+RenderGraph::AbstractTexturePtr
+RenderGraph::texture(const std::string& name) const
+{
+	auto physicalTargetId = physicalTarget(name);
+
+	return physicalTargetId >= 0 && physicalTargetId < static_cast<int>(_physicalTargets.size())
+		? _physicalTargets[physicalTargetId]
+		: nullptr;
+}
+
+uint
+RenderGraph::allocatedMemory() const
+{
+	return std::accumulate(_physicalTargetMemory.begin(), _physicalTargetMemory.end(), 0u);
+}
+
+void
+RenderGraph::releasePhysicalTargets()
+{
+	if (_pool)
+		for (auto texture : _physicalTargets)
+			_pool->release(texture);
+
+	_physicalTargets.clear();
+	_physicalTargetMemory.clear();
+}
@@ -0,0 +1,116 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/RenderTargetPool.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/CubeTexture.hpp"
+#include "minko/render/Texture.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+RenderTargetPool::RenderTargetPool(AbstractContextPtr context) :
+	_context(context),
+	_free(),
+	_used(),
+	_allocatedMemory(0),
+	_usedMemory(0)
+{
+}
+
+RenderTargetPool::~RenderTargetPool()
+{
+	clear();
+}
+
+uint
+RenderTargetPool::numFreeTargets() const
+{
+	auto numTargets = 0u;
+
+	for (const auto& targets : _free)
+		numTargets += static_cast<uint>(targets.second.size());
+
+	return numTargets;
+}
+
+RenderTargetPool::AbstractTexturePtr
+RenderTargetPool::acquire(uint width, uint height, bool isCube)
+{
+	auto& freeTargets = _free[TargetKey(width, height, isCube)];
+	AbstractTexturePtr target = nullptr;
+
+	if (!freeTargets.empty())
+	{
+		target = freeTargets.front();
+		freeTargets.pop_front();
+	}
+	else
+	{
+		if (isCube)
+			target = CubeTexture::create(_context, width, height, false, true);
+		else
+			target = Texture::create(_context, width, height, false, true);
+
+		target->upload();
+		_allocatedMemory += targetMemory(width, height, isCube);
+	}
+
+	_used.insert(target);
+	_usedMemory += targetMemory(width, height, isCube);
+
+	return target;
+}
+
+void
+RenderTargetPool::release(AbstractTexturePtr target)
+{
+	if (_used.erase(target) == 0)
+		throw std::invalid_argument("target");
+
+	auto isCube = target->type() == TextureType::CubeTexture;
+
+	_usedMemory -= targetMemory(target->width(), target->height(), isCube);
+	_free[TargetKey(target->width(), target->height(), isCube)].push_back(target);
+}
+
+void
+RenderTargetPool::clear()
+{
+	for (auto& targets : _free)
+	{
+		auto isCube = std::get<2>(targets.first);
+
+		for (auto target : targets.second)
+		{
+			_allocatedMemory -= targetMemory(target->width(), target->height(), isCube);
+			target->dispose();
+		}
+	}
+
+	_free.clear();
+}
+
+uint
+RenderTargetPool::targetMemory(uint width, uint height, bool isCube)
+{
+	// render targets are always RGBA, without mipmaps
+	return width * height * 4 * (isCube ? 6 : 1);
+}
@@ -19,6 +19,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/log/Logger.hpp"
 #include "minko/render/AbstractContext.hpp"
+#include "minko/render/ImageResampler.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/TextureFormatInfo.hpp"
 
@@ -121,39 +122,38 @@ Texture::resize(unsigned int width, unsigned int height, bool resizeSmoothly)
         ? AbstractTexture::numMipMaps(width, height)
         : 1u;
 
-    auto dataOffset = 0u;
+    auto newSize = 0u;
+
+    for (auto i = 0u; i < numMipMaps; ++i)
+        newSize += TextureFormatInfo::textureSize(_format, math::max(width >> i, 1u), math::max(height >> i, 1u));
 
-    auto newData = std::vector<unsigned char>();
+    auto newData = std::vector<unsigned char>(newSize);
+    auto dataOffset = 0u;
+    auto newDataOffset = 0u;
 
+    // each level is resampled in place in the new chain, without intermediate copies
     for (auto i = 0u; i < numMipMaps; ++i)
     {
         const auto mipMapPreviousWidth = math::max(previousWidth >> i, 1u);
         const auto mipMapPreviousHeight = math::max(previousHeight >> i, 1u);
-        const auto mipMapWidth = width >> i;
-        const auto mipMapHeight = height >> i;
-
-        const auto mipMapDataBegin = data().begin() + dataOffset;
-        const auto mipMapDataEnd = mipMapDataBegin + TextureFormatInfo::textureSize(_format, mipMapPreviousWidth, mipMapPreviousHeight);
-        auto mipMapData = std::vector<unsigned char>(mipMapDataBegin, mipMapDataEnd);
-
-        dataOffset += static_cast<unsigned int>(mipMapData.size());
-
-        auto newMipMapData = std::vector<unsigned char>();
+        const auto mipMapWidth = math::max(width >> i, 1u);
+        const auto mipMapHeight = math::max(height >> i, 1u);
 
-        resizeData(
+        ImageResampler::resample(
+            data().data() + dataOffset,
             mipMapPreviousWidth,
             mipMapPreviousHeight,
-            mipMapData.data(),
+            newData.data() + newDataOffset,
             mipMapWidth,
             mipMapHeight,
-            resizeSmoothly,
-            newMipMapData
+            resizeSmoothly ? ImageResampler::Filter::BILINEAR : ImageResampler::Filter::NEAREST
         );
 
-        newData.insert(newData.end(), newMipMapData.begin(), newMipMapData.end());
+        dataOffset += TextureFormatInfo::textureSize(_format, mipMapPreviousWidth, mipMapPreviousHeight);
+        newDataOffset += TextureFormatInfo::textureSize(_format, mipMapWidth, mipMapHeight);
     }
 
-    _data = newData;
+    _data.swap(newData);
 
     _width = width;
     _widthGPU = width;
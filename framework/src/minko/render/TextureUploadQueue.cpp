@@ -0,0 +1,312 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/TextureUploadQueue.hpp"
+
+#include "minko/render/AbstractTexture.hpp"
+#include "minko/render/TextureFormatInfo.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+// 4MB per frame is a 1024x1024 RGBA texture, or its whole mip chain once compressed
+const uint TextureUploadQueue::DEFAULT_MAX_UPLOADED_BYTES_PER_FRAME = 4u << 20;
+const float TextureUploadQueue::DEFAULT_MAX_UPLOAD_TIME_PER_FRAME = 4.f;
+
+TextureUploadQueue::TextureUploadQueue(uint numDecodingThreads) :
+    _numDecodingThreads(numDecodingThreads),
+    _numPendingDecodes(0u),
+    _terminating(false),
+    _nextUploadOrder(0u),
+    _sortingNeeded(false),
+    _maxUploadedBytesPerFrame(DEFAULT_MAX_UPLOADED_BYTES_PER_FRAME),
+    _maxUploadTimePerFrame(DEFAULT_MAX_UPLOAD_TIME_PER_FRAME),
+    _numDecodedTextures(0u),
+    _numDecodedBytes(0u),
+    _numUploadedTextures(0u),
+    _numUploadedBytes(0u),
+    _uploadTime(0.f),
+    _numUploadedBytesLastFrame(0u),
+    _textureUploaded(Signal<Ptr, AbstractTexturePtr>::create())
+{
+}
+
+TextureUploadQueue::~TextureUploadQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(_decodingMutex);
+
+        _terminating = true;
+    }
+
+    _decodingCondition.notify_all();
+
+    for (auto& thread : _decodingThreads)
+        thread.join();
+
+    // the jobs that will never complete still have to notify their owner
+    for (auto* jobs : { &_decodedJobs, &_decodeJobs })
+        for (auto& job : *jobs)
+            if (job.failed)
+                job.failed();
+}
+
+uint
+TextureUploadQueue::defaultNumDecodingThreads()
+{
+#if defined(EMSCRIPTEN)
+    return 0u;
+#else
+    // keep at least one core for the main thread
+    const auto numCores = std::thread::hardware_concurrency();
+
+    return std::max(1u, std::min(4u, numCores > 1u ? numCores - 1u : 1u));
+#endif
+}
+
+uint
+TextureUploadQueue::textureMemory(AbstractTexturePtr texture)
+{
+    auto size = 0u;
+    auto width = texture->width();
+    auto height = texture->height();
+    const auto numMipMaps = texture->mipMapping() ? AbstractTexture::numMipMaps(width, height) : 1;
+
+    for (auto i = 0; i < numMipMaps; ++i)
+    {
+        size += TextureFormatInfo::textureSize(texture->format(), width, height);
+
+        width = std::max(width >> 1, 1u);
+        height = std::max(height >> 1, 1u);
+    }
+
+    return texture->type() == TextureType::CubeTexture ? size * 6u : size;
+}
+
+void
+TextureUploadQueue::decode(DecodeFunction decode, UploadFunction decoded, UploadFunction failed)
+{
+    auto job = DecodeJob { decode, decoded, failed, 0u };
+
+    ++_numPendingDecodes;
+
+    if (_numDecodingThreads == 0u)
+    {
+        job.numBytes = job.decode();
+        _decodedJobs.push_back(std::move(job));
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_decodingMutex);
+
+        // threads are started on demand so that queues that never decode anything stay cheap
+        while (_decodingThreads.size() < _numDecodingThreads)
+            _decodingThreads.push_back(std::thread(&TextureUploadQueue::decodingThreadLoop, this));
+
+        _decodeJobs.push_back(std::move(job));
+    }
+
+    _decodingCondition.notify_one();
+}
+
+void
+TextureUploadQueue::decodingThreadLoop()
+{
+    while (true)
+    {
+        auto job = DecodeJob();
+
+        {
+            std::unique_lock<std::mutex> lock(_decodingMutex);
+
+            _decodingCondition.wait(lock, [this]() { return _terminating || !_decodeJobs.empty(); });
+
+            if (_terminating)
+                return;
+
+            job = std::move(_decodeJobs.front());
+            _decodeJobs.pop_front();
+        }
+
+        job.numBytes = job.decode();
+
+        std::lock_guard<std::mutex> lock(_decodingMutex);
+
+        _decodedJobs.push_back(std::move(job));
+    }
+}
+
+void
+TextureUploadQueue::completeDecodedJobs()
+{
+    auto decodedJobs = std::list<DecodeJob>();
+
+    if (_numDecodingThreads == 0u)
+        decodedJobs.swap(_decodedJobs);
+    else
+    {
+        std::lock_guard<std::mutex> lock(_decodingMutex);
+
+        decodedJobs.swap(_decodedJobs);
+    }
+
+    for (auto& job : decodedJobs)
+    {
+        --_numPendingDecodes;
+        ++_numDecodedTextures;
+        _numDecodedBytes += job.numBytes;
+
+        if (job.decoded)
+            job.decoded();
+    }
+}
+
+void
+TextureUploadQueue::upload(AbstractTexturePtr texture)
+{
+    upload(texture, textureMemory(texture), [=]() { texture->upload(); });
+}
+
+void
+TextureUploadQueue::upload(AbstractTexturePtr texture, uint numBytes, UploadFunction upload)
+{
+    _uploadJobs.push_back(UploadJob { texture, upload, numBytes, priority(texture), _nextUploadOrder++ });
+    _sortingNeeded = true;
+}
+
+float
+TextureUploadQueue::priority(AbstractTexturePtr texture) const
+{
+    auto priorityIt = _priorities.find(texture->uuid());
+
+    return priorityIt != _priorities.end() ? priorityIt->second : 0.f;
+}
+
+void
+TextureUploadQueue::priority(AbstractTexturePtr texture, float priority)
+{
+    auto& currentPriority = _priorities[texture->uuid()];
+
+    if (currentPriority == priority)
+        return;
+
+    currentPriority = priority;
+
+    for (auto& job : _uploadJobs)
+        if (job.texture == texture)
+        {
+            job.priority = priority;
+            _sortingNeeded = true;
+        }
+}
+
+void
+TextureUploadQueue::cancel(AbstractTexturePtr texture)
+{
+    _priorities.erase(texture->uuid());
+
+    _uploadJobs.erase(
+        std::remove_if(_uploadJobs.begin(), _uploadJobs.end(), [&](const UploadJob& job) { return job.texture == texture; }),
+        _uploadJobs.end()
+    );
+}
+
+void
+TextureUploadQueue::update()
+{
+    completeDecodedJobs();
+
+    _numUploadedBytesLastFrame = 0u;
+
+    if (_uploadJobs.empty())
+        return;
+
+    if (_sortingNeeded)
+    {
+        _sortingNeeded = false;
+
+        // the next job to upload is kept at the back of the vector
+        std::sort(_uploadJobs.begin(), _uploadJobs.end(), UploadJob::PriorityComparator());
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    auto elapsedTime = 0.f;
+
+    while (!_uploadJobs.empty())
+    {
+        const auto numBytes = _uploadJobs.back().numBytes;
+
+        if (_numUploadedBytesLastFrame > 0u &&
+            (_numUploadedBytesLastFrame + numBytes > _maxUploadedBytesPerFrame || elapsedTime >= _maxUploadTimePerFrame))
+            break;
+
+        auto job = _uploadJobs.back();
+
+        _uploadJobs.pop_back();
+        uploadJob(job);
+
+        _numUploadedBytesLastFrame += std::max(numBytes, 1u);
+        elapsedTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    _uploadTime += elapsedTime;
+}
+
+void
+TextureUploadQueue::flush()
+{
+    while (_numPendingDecodes != 0u)
+    {
+        completeDecodedJobs();
+
+        if (_numPendingDecodes != 0u)
+            std::this_thread::yield();
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // decoded callbacks may queue new uploads, so the queue is re-checked after each one
+    while (!_uploadJobs.empty())
+    {
+        std::sort(_uploadJobs.begin(), _uploadJobs.end(), UploadJob::PriorityComparator());
+
+        auto jobs = std::vector<UploadJob>();
+
+        jobs.swap(_uploadJobs);
+
+        for (auto jobIt = jobs.rbegin(); jobIt != jobs.rend(); ++jobIt)
+            uploadJob(*jobIt);
+    }
+
+    _sortingNeeded = false;
+    _uploadTime += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void
+TextureUploadQueue::uploadJob(const UploadJob& job)
+{
+    job.upload();
+
+    ++_numUploadedTextures;
+    _numUploadedBytes += job.numBytes;
+
+    _textureUploaded->execute(shared_from_this(), job.texture);
+}
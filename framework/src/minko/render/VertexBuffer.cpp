@@ -33,6 +33,8 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext> context) :
 	std::enable_shared_from_this<VertexBuffer>(),
 	_data(),
 	_vertexSize(0),
+	_packedVertexSize(0),
+	_isPacked(false),
 	_vertexSizeChanged(Signal<Ptr, int>::create())
 {
 }
@@ -44,6 +46,8 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext>	context,
 	AbstractResource(context),
 	_data(data + offset, data + offset + size),
 	_vertexSize(0),
+	_packedVertexSize(0),
+	_isPacked(false),
 	_vertexSizeChanged(Signal<Ptr, int>::create())
 {
 	upload();
@@ -55,6 +59,8 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext>		context,
 	AbstractResource(context),
 	_data(begin, end),
 	_vertexSize(0),
+	_packedVertexSize(0),
+	_isPacked(false),
 	_vertexSizeChanged(Signal<Ptr, int>::create())
 {
 	upload();
@@ -64,6 +70,8 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext> context, float* begi
 	AbstractResource(context),
 	_data(begin, end),
 	_vertexSize(0),
+	_packedVertexSize(0),
+	_isPacked(false),
 	_vertexSizeChanged(Signal<Ptr, int>::create())
 {
 	upload();
@@ -75,7 +83,7 @@ VertexBuffer::clone() const
     auto cloned  = VertexBuffer::create(_context, _data);
 
     for (const auto& attribute : _attributes)
-        cloned->addAttribute(*attribute.name, attribute.size, attribute.offset);
+        cloned->addAttribute(*attribute.name, attribute.size, attribute.offset, attribute.format);
 
     return cloned;
 }
@@ -86,6 +94,17 @@ VertexBuffer::upload(uint offset, uint numVertices)
 	if (_data.empty())
 		return;
 
+    if (_isPacked)
+    {
+        const auto numPackedVertices = numVertices == 0 ? this->numVertices() - offset : numVertices;
+        auto packedData = std::vector<unsigned char>();
+
+        pack(&_data[offset * _vertexSize], numPackedVertices, packedData);
+        uploadPackedWords(offset, numPackedVertices, packedData.data());
+
+        return;
+    }
+
     if (_id == -1)
     	_id = _context->createVertexBuffer(static_cast<uint>(_data.size()));
 
@@ -105,6 +124,17 @@ VertexBuffer::upload(uint offset, uint numVertices, const std::vector<float>& da
     if (data.empty())
         return;
 
+    if (_isPacked)
+    {
+        const auto numPackedVertices = numVertices == 0 ? static_cast<uint>(data.size()) / _vertexSize : numVertices;
+        auto packedData = std::vector<unsigned char>();
+
+        pack(data.data(), numPackedVertices, packedData);
+        uploadPackedWords(offset, numPackedVertices, packedData.data());
+
+        return;
+    }
+
     if (_id == -1)
         _id = _context->createVertexBuffer(static_cast<uint>(data.size()));
 
@@ -116,6 +146,57 @@ VertexBuffer::upload(uint offset, uint numVertices, const std::vector<float>& da
     );
 }
 
+void
+VertexBuffer::uploadPacked(uint offset, uint numVertices, const std::vector<unsigned char>& packedData)
+{
+    if (packedData.empty())
+        return;
+
+    if (!_isPacked)
+    {
+        // float layout: packed data is the raw float array
+        upload(
+            offset,
+            numVertices,
+            std::vector<float>(
+                reinterpret_cast<const float*>(packedData.data()),
+                reinterpret_cast<const float*>(packedData.data()) + packedData.size() / sizeof(float)
+            )
+        );
+
+        return;
+    }
+
+    uploadPackedWords(offset, numVertices, packedData.data());
+}
+
+void
+VertexBuffer::uploadPackedWords(uint offset, uint numVertices, const unsigned char* packedData)
+{
+    // the storage is sized for the whole buffer, the remaining vertices can be uploaded later
+    if (_id == -1)
+        _id = _context->createVertexBuffer(std::max(this->numVertices(), offset + numVertices) * _packedVertexSize);
+
+    _context->uploadVertexBufferData(
+        _id,
+        offset * _packedVertexSize,
+        numVertices * _packedVertexSize,
+        const_cast<unsigned char*>(packedData)
+    );
+}
+
+void
+VertexBuffer::orphan()
+{
+    if (_id == -1)
+        return;
+
+    _context->orphanVertexBuffer(
+        _id,
+        _isPacked ? numVertices() * _packedVertexSize : static_cast<uint>(_data.size())
+    );
+}
+
 void
 VertexBuffer::dispose()
 {
@@ -136,9 +217,10 @@ VertexBuffer::disposeData()
 }
 
 void
-VertexBuffer::addAttribute(const std::string& 	name,
-						   const unsigned int	size,
-						   const unsigned int	offset)
+VertexBuffer::addAttribute(const std::string& 		name,
+						   const unsigned int		size,
+						   const unsigned int		offset,
+						   VertexAttribute::Format	format)
 {
 	if (hasAttribute(name))
 		throw std::invalid_argument("name");
@@ -147,9 +229,271 @@ VertexBuffer::addAttribute(const std::string& 	name,
     if (actualOffset == 0)
         actualOffset = _vertexSize;
 
-	_attributes.push_back({ &_id, &_vertexSize, name, size, actualOffset });
+	_attributes.push_back({ &_id, &_vertexSize, name, size, actualOffset, format, &_packedVertexSize, actualOffset });
 
 	vertexSize(_vertexSize + size);
+
+    updatePackedLayout();
+}
+
+void
+VertexBuffer::attributeFormat(const std::string& attributeName, VertexAttribute::Format format)
+{
+	auto it = std::find_if(_attributes.begin(), _attributes.end(), [&](const VertexAttribute& attr)
+	{
+		return attr.name == attributeName;
+	});
+
+	if (it == _attributes.end())
+		throw std::invalid_argument("attributeName = " + attributeName);
+
+    if (it->format == format)
+        return;
+
+    it->format = format;
+
+    updatePackedLayout();
+
+    // the GPU storage was allocated for the previous layout
+    if (_id != -1 && !_data.empty())
+    {
+        _context->deleteVertexBuffer(_id);
+        _id = -1;
+
+        upload();
+    }
+}
+
+void
+VertexBuffer::updatePackedLayout()
+{
+    _isPacked = std::any_of(_attributes.begin(), _attributes.end(), [](const VertexAttribute& attr)
+    {
+        return attr.format != VertexAttribute::Format::FLOAT;
+    });
+
+    if (!_isPacked)
+    {
+        for (auto& attribute : _attributes)
+            attribute.packedOffset = attribute.offset;
+
+        _packedVertexSize = _vertexSize;
+
+        return;
+    }
+
+    auto sortedAttributes = std::vector<VertexAttribute*>();
+
+    for (auto& attribute : _attributes)
+        sortedAttributes.push_back(&attribute);
+
+    std::stable_sort(sortedAttributes.begin(), sortedAttributes.end(), [](VertexAttribute* a, VertexAttribute* b)
+    {
+        return a->offset < b->offset;
+    });
+
+    auto packedOffset = 0u;
+
+    for (auto attribute : sortedAttributes)
+    {
+        attribute->packedOffset = packedOffset;
+
+        packedOffset += VertexAttribute::packedSize(attribute->format, attribute->size);
+    }
+
+    _packedVertexSize = packedOffset;
+}
+
+static
+unsigned short
+floatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(float));
+
+    const auto sign = static_cast<uint32_t>((bits >> 16) & 0x8000u);
+
+    bits &= 0x7fffffffu;
+
+    // NaN keeps a quiet payload, finite values beyond the half range become infinite
+    if (bits > 0x7f800000u)
+        return static_cast<unsigned short>(sign | 0x7e00u);
+    if (bits >= 0x47800000u)
+        return static_cast<unsigned short>(sign | 0x7c00u);
+
+    const auto exponent = static_cast<int>(bits >> 23);
+
+    // below 2^-25, the value rounds to zero
+    if (exponent < 102)
+        return static_cast<unsigned short>(sign);
+
+    uint32_t half;
+    uint32_t remainder;
+    uint32_t halfway;
+
+    if (exponent < 113)
+    {
+        // subnormal half: the implicit bit is shifted into the mantissa
+        const auto mantissa = (bits & 0x7fffffu) | 0x800000u;
+        const auto shift = static_cast<uint32_t>(126 - exponent);
+
+        half = mantissa >> shift;
+        remainder = mantissa & ((1u << shift) - 1u);
+        halfway = 1u << (shift - 1u);
+    }
+    else
+    {
+        half = (static_cast<uint32_t>(exponent - 112) << 10) | ((bits & 0x7fffffu) >> 13);
+        remainder = bits & 0x1fffu;
+        halfway = 0x1000u;
+    }
+
+    // round to nearest, ties to even: a carry into the exponent is the next representable value
+    if (remainder > halfway || (remainder == halfway && (half & 1u)))
+        ++half;
+
+    return static_cast<unsigned short>(sign | half);
+}
+
+static
+float
+halfToFloat(unsigned short value)
+{
+    const auto sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const auto exponent = static_cast<uint32_t>((value >> 10) & 0x1fu);
+    const auto mantissa = static_cast<uint32_t>(value & 0x3ffu);
+
+    if (exponent == 0u)
+    {
+        const auto result = std::ldexp(static_cast<float>(mantissa), -24);
+
+        return sign ? -result : result;
+    }
+
+    uint32_t bits = sign;
+
+    if (exponent == 31u)
+        bits |= 0x7f800000u | (mantissa << 13);
+    else
+        bits |= ((exponent - 15u + 127u) << 23) | (mantissa << 13);
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(float));
+
+    return result;
+}
+
+template <typename T>
+static
+void
+packComponent(unsigned char* destination, T value)
+{
+    std::memcpy(destination, &value, sizeof(T));
+}
+
+template <typename T>
+static
+T
+unpackComponent(const unsigned char* source)
+{
+    T value;
+    std::memcpy(&value, source, sizeof(T));
+
+    return value;
+}
+
+void
+VertexBuffer::pack(const float* vertices, uint numVertices, std::vector<unsigned char>& packedData) const
+{
+    const auto packedVertexBytes = _packedVertexSize * 4u;
+
+    packedData.assign(numVertices * packedVertexBytes, 0u);
+
+    for (const auto& attribute : _attributes)
+    {
+        const auto componentSize = VertexAttribute::componentSize(attribute.format);
+
+        for (auto i = 0u; i < numVertices; ++i)
+        {
+            const auto* source = vertices + i * _vertexSize + attribute.offset;
+            auto* destination = packedData.data() + i * packedVertexBytes + attribute.packedOffset * 4u;
+
+            for (auto j = 0u; j < attribute.size; ++j, destination += componentSize)
+            {
+                const auto value = source[j];
+
+                switch (attribute.format)
+                {
+                case VertexAttribute::Format::HALF_FLOAT:
+                    packComponent(destination, floatToHalf(value));
+                    break;
+                case VertexAttribute::Format::SHORT_NORMALIZED:
+                    packComponent(destination, static_cast<int16_t>(std::round(math::clamp(value, -1.f, 1.f) * 32767.f)));
+                    break;
+                case VertexAttribute::Format::UNSIGNED_SHORT_NORMALIZED:
+                    packComponent(destination, static_cast<uint16_t>(std::round(math::clamp(value, 0.f, 1.f) * 65535.f)));
+                    break;
+                case VertexAttribute::Format::BYTE_NORMALIZED:
+                    packComponent(destination, static_cast<int8_t>(std::round(math::clamp(value, -1.f, 1.f) * 127.f)));
+                    break;
+                case VertexAttribute::Format::UNSIGNED_BYTE_NORMALIZED:
+                    packComponent(destination, static_cast<uint8_t>(std::round(math::clamp(value, 0.f, 1.f) * 255.f)));
+                    break;
+                case VertexAttribute::Format::UNSIGNED_BYTE:
+                    packComponent(destination, static_cast<uint8_t>(math::clamp(value, 0.f, 255.f)));
+                    break;
+                default:
+                    packComponent(destination, value);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void
+VertexBuffer::unpack(const unsigned char* packedData, uint numVertices, float* vertices) const
+{
+    const auto packedVertexBytes = _packedVertexSize * 4u;
+
+    for (const auto& attribute : _attributes)
+    {
+        const auto componentSize = VertexAttribute::componentSize(attribute.format);
+
+        for (auto i = 0u; i < numVertices; ++i)
+        {
+            const auto* source = packedData + i * packedVertexBytes + attribute.packedOffset * 4u;
+            auto* destination = vertices + i * _vertexSize + attribute.offset;
+
+            for (auto j = 0u; j < attribute.size; ++j, source += componentSize)
+            {
+                switch (attribute.format)
+                {
+                case VertexAttribute::Format::HALF_FLOAT:
+                    destination[j] = halfToFloat(unpackComponent<uint16_t>(source));
+                    break;
+                case VertexAttribute::Format::SHORT_NORMALIZED:
+                    destination[j] = std::max(unpackComponent<int16_t>(source) / 32767.f, -1.f);
+                    break;
+                case VertexAttribute::Format::UNSIGNED_SHORT_NORMALIZED:
+                    destination[j] = unpackComponent<uint16_t>(source) / 65535.f;
+                    break;
+                case VertexAttribute::Format::BYTE_NORMALIZED:
+                    destination[j] = std::max(unpackComponent<int8_t>(source) / 127.f, -1.f);
+                    break;
+                case VertexAttribute::Format::UNSIGNED_BYTE_NORMALIZED:
+                    destination[j] = unpackComponent<uint8_t>(source) / 255.f;
+                    break;
+                case VertexAttribute::Format::UNSIGNED_BYTE:
+                    destination[j] = float(unpackComponent<uint8_t>(source));
+                    break;
+                default:
+                    destination[j] = unpackComponent<float>(source);
+                    break;
+                }
+            }
+        }
+    }
 }
 
 bool
@@ -176,6 +520,8 @@ VertexBuffer::removeAttribute(const std::string& attributeName)
 
 	vertexSize(_vertexSize - it->size);
     _attributes.erase(it);
+
+    updatePackedLayout();
 }
 
 const VertexAttribute&
@@ -27,15 +27,26 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/data/Store.hpp"
 #include "minko/Uuid.hpp"
 
+#include <typeindex>
+#include <mutex>
+
 using namespace minko;
 using namespace minko::scene;
 using namespace minko::component;
 
 bool Node::_signalBubblingEnabled = true;
 
+const uint Node::MAX_NUM_COMPONENT_TYPES;
+const uint Node::ComponentTypeCache::NUM_WORDS;
+const std::ptrdiff_t Node::UNKNOWN_COMPONENT_OFFSET = std::numeric_limits<std::ptrdiff_t>::max();
+const std::ptrdiff_t Node::INCOMPATIBLE_COMPONENT_OFFSET = std::numeric_limits<std::ptrdiff_t>::min();
+
 Node::Node() :
     Uuid::enable_uuid(),
 	_name(""),
+	_components(),
+	_componentTypes(),
+	_componentRegistry(),
 	_layout(BuiltinLayout::DEFAULT)
 {
 }
@@ -43,10 +54,70 @@ Node::Node() :
 Node::Node(const std::string& uuid, const std::string& name) :
     Uuid::enable_uuid(uuid),
     _name(name),
+	_components(),
+	_componentTypes(),
+	_componentRegistry(),
 	_layout(BuiltinLayout::DEFAULT)
 {
 }
 
+Node::ComponentTypeCache::ComponentTypeCache()
+{
+    for (auto& word : resolvedWords)
+        word.store(0u);
+    for (auto& word : compatibleWords)
+        word.store(0u);
+    for (auto& offset : offsets)
+        offset.store(UNKNOWN_COMPONENT_OFFSET);
+}
+
+Node::ComponentTypeMask
+Node::ComponentTypeCache::resolved() const
+{
+    auto mask = ComponentTypeMask();
+
+    for (auto i = NUM_WORDS; i > 0; --i)
+        mask = (mask << 64) | ComponentTypeMask(resolvedWords[i - 1].load(std::memory_order_acquire));
+
+    return mask;
+}
+
+Node::ComponentTypeMask
+Node::ComponentTypeCache::compatible() const
+{
+    auto mask = ComponentTypeMask();
+
+    for (auto i = NUM_WORDS; i > 0; --i)
+        mask = (mask << 64) | ComponentTypeMask(compatibleWords[i - 1].load(std::memory_order_relaxed));
+
+    return mask;
+}
+
+void
+Node::ComponentTypeCache::resolve(uint typeId, std::ptrdiff_t offset)
+{
+    const auto bit = uint64_t(1) << (typeId % 64);
+
+    // racing threads resolve the same offset: whichever store wins, the value is the same
+    offsets[typeId].store(offset, std::memory_order_relaxed);
+    if (offset != INCOMPATIBLE_COMPONENT_OFFSET)
+        compatibleWords[typeId / 64].fetch_or(bit, std::memory_order_relaxed);
+
+    // released last, so that a thread seeing the type as resolved also sees it as compatible
+    resolvedWords[typeId / 64].fetch_or(bit, std::memory_order_release);
+}
+
+uint
+Node::registerComponentType(const AbstractComponent& component)
+{
+    static auto typeIds = std::unordered_map<std::type_index, uint>();
+    static std::mutex typeIdsMutex;
+
+    std::lock_guard<std::mutex> lock(typeIdsMutex);
+
+    return typeIds.emplace(std::type_index(typeid(component)), static_cast<uint>(typeIds.size())).first->second;
+}
+
 Node::Ptr
 Node::clone(const CloneOption& option)
 {
@@ -168,6 +239,25 @@ Node::addChild(Node::Ptr child)
 	child->_parent = shared_from_this();
 	child->updateRoot();
 
+    // the components of the child subtree join the registry of the new root
+    if (child->_componentRegistry)
+    {
+        auto newRoot = root();
+        std::vector<AbsCmpPtr> components;
+
+        for (auto& typedComponents : child->_componentRegistry->componentsByType)
+            for (auto& component : typedComponents)
+            {
+                newRoot->registerComponent(component);
+                components.push_back(component);
+            }
+
+        child->_componentRegistry = nullptr;
+
+        if (!components.empty())
+            newRoot->_componentsRegistered.execute(newRoot, components);
+    }
+
     if (_signalBubblingEnabled)
     {
         // bubble down
@@ -194,9 +284,25 @@ Node::removeChild(Node::Ptr child)
 
 	_children.erase(it);
 
+    auto oldRoot = root();
+
 	child->_parent.reset();
 	child->updateRoot();
 
+    // the components of the child subtree move to its own registry
+    std::vector<AbsCmpPtr> components;
+
+    child->collectComponents(components);
+
+    for (auto& component : components)
+    {
+        oldRoot->unregisterComponent(component);
+        child->registerComponent(component);
+    }
+
+    if (!components.empty())
+        oldRoot->_componentsUnregistered.execute(oldRoot, components);
+
     if (_signalBubblingEnabled)
     {
         // bubble down
@@ -247,9 +353,20 @@ Node::addComponent(std::shared_ptr<AbstractComponent> component)
 
     if (component->target())
         component->target()->removeComponent(component);
+
+    component->_typeId = registerComponentType(*component);
+
 	_components.push_back(component);
+    _componentTypes.set(componentTypeBit(component->_typeId));
+    auto root = this->root();
+
+    root->registerComponent(component);
+
 	component->target(shared_from_this());
 
+    if (root->_componentsRegistered.numCallbacks() != 0)
+        root->_componentsRegistered.execute(root, std::vector<AbsCmpPtr>(1, component));
+
     if (_signalBubblingEnabled)
     {
         // bubble down
@@ -278,6 +395,15 @@ Node::removeComponent(std::shared_ptr<AbstractComponent> component)
 		throw std::invalid_argument("component");
 
 	_components.erase(it);
+    updateComponentTypes();
+
+    auto root = this->root();
+
+    root->unregisterComponent(component);
+
+    if (root->_componentsUnregistered.numCallbacks() != 0)
+        root->_componentsUnregistered.execute(root, std::vector<AbsCmpPtr>(1, component));
+
     component->target(nullptr);
 
     if (_signalBubblingEnabled)
@@ -301,6 +427,59 @@ Node::hasComponent(std::shared_ptr<AbstractComponent> component)
 	return std::find(_components.begin(), _components.end(), component) != _components.end();
 }
 
+void
+Node::collectComponents(std::vector<AbsCmpPtr>& components) const
+{
+    components.insert(components.end(), _components.begin(), _components.end());
+
+    for (const auto& child : _children)
+        child->collectComponents(components);
+}
+
+void
+Node::updateComponentTypes()
+{
+    _componentTypes.reset();
+
+    for (const auto& component : _components)
+        _componentTypes.set(componentTypeBit(component->_typeId));
+}
+
+void
+Node::registerComponent(AbsCmpPtr component)
+{
+    if (!_componentRegistry)
+        _componentRegistry = std::make_shared<ComponentRegistry>();
+
+    auto& componentsByType = _componentRegistry->componentsByType;
+
+    if (component->_typeId >= componentsByType.size())
+        componentsByType.resize(component->_typeId + 1);
+
+    auto& typedComponents = componentsByType[component->_typeId];
+
+    component->_registryIndex = static_cast<uint>(typedComponents.size());
+    typedComponents.push_back(component);
+}
+
+void
+Node::unregisterComponent(AbsCmpPtr component)
+{
+    auto& typedComponents = _componentRegistry->componentsByType[component->_typeId];
+    const auto index = component->_registryIndex;
+
+    assert(typedComponents[index] == component);
+
+    // swap and pop: the order of the registry does not matter
+    if (index + 1 != typedComponents.size())
+    {
+        typedComponents[index] = typedComponents.back();
+        typedComponents[index]->_registryIndex = index;
+    }
+
+    typedComponents.pop_back();
+}
+
 void
 Node::updateRoot()
 {
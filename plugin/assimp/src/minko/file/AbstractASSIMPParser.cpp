@@ -260,7 +260,7 @@ AbstractASSIMPParser::getPostProcessingFlags(const aiScene*             scene,
         | aiProcess_ValidateDataStructure
         | aiProcess_RemoveComponent;
 
-    if (options->optimizeForRendering())
+    if (options->optimizeForRendering() && !options->allowUnsignedIntIndices())
     {
         flags |= aiProcess_SplitLargeMeshes;
     }
@@ -548,7 +548,13 @@ createIndexBuffer(aiMesh*                       mesh,
         }
 	}
 
-    return render::IndexBuffer::create(context, indexData);
+    auto indexBuffer = render::IndexBuffer::create(context, indexData);
+
+    // 32-bit index buffers are not uploaded on creation
+    if (!indexBuffer->isReady())
+        indexBuffer->upload();
+
+    return indexBuffer;
 }
 
 static
@@ -627,8 +633,8 @@ AbstractASSIMPParser::createMeshGeometry(scene::Node::Ptr minkoNode, aiMesh* mes
 
     auto indices = render::IndexBuffer::Ptr();
 
-    if (_options->optimizeForRendering() ||
-        numVertices <= static_cast<unsigned int>(std::numeric_limits<unsigned short>::max()))
+    if (numVertices <= static_cast<unsigned int>(std::numeric_limits<unsigned short>::max()) ||
+        (_options->optimizeForRendering() && !_options->allowUnsignedIntIndices()))
     {
         indices = createIndexBuffer<unsigned short>(mesh, _assetLibrary->context());
     }
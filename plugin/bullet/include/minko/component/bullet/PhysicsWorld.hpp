@@ -35,6 +35,7 @@ struct btDefaultMotionState;
 class btCollisionObject;
 class btTransform;
 class btRigidBody;
+class btThreadSupportInterface;
 
 namespace minko
 {
@@ -75,7 +76,8 @@ namespace minko
                 typedef std::unordered_map<ColliderPtr, BulletColliderPtr>          ColliderMap;
                 typedef std::unordered_map<const btCollisionObject*, ColliderPtr>   ColliderReverseMap;
 
-                typedef std::set<std::pair<uint, uint>>                             CollisionSet;
+                // collision pairs are keyed by their ordered collider uids, see collisionKey()
+                typedef std::unordered_set<unsigned long long>                      CollisionSet;
                 typedef Signal<NodePtr, NodePtr>                                    NodeLayoutsChanged;
                 typedef Signal<AbsCmp>                                              LayoutMaskChanged;
                 typedef Signal<ColliderPtr>                                         ColliderChanged;
@@ -89,6 +91,9 @@ namespace minko
                 std::unordered_map<uint, ColliderPtr>                               _uidToCollider;
                 CollisionSet                                                        _collisions;
 
+                uint                                                                _numThreads;
+                std::shared_ptr<btThreadSupportInterface>                           _collisionThreadSupport;
+                std::shared_ptr<btThreadSupportInterface>                           _solverThreadSupport;
                 btBroadphasePtr                                                     _bulletBroadphase;
                 btCollisionConfigurationPtr                                         _bulletCollisionConfiguration;
                 btConstraintSolverPtr                                               _bulletConstraintSolver;
@@ -102,6 +107,7 @@ namespace minko
                 Signal<AbsCmp, NodePtr>::Slot                                       _exitFrameSlot;
                 Signal<std::shared_ptr<SceneManager>, float, float>::Slot           _frameBeginSlot;
                 Signal<std::shared_ptr<SceneManager>, float, float>::Slot           _frameEndSlot;
+                Signal<std::shared_ptr<SceneManager>, float, float>::Slot           _tickSlot;
                 Signal<NodePtr, NodePtr, NodePtr>::Slot                             _addedOrRemovedSlot;
                 Signal<NodePtr, NodePtr, AbsCmp>::Slot                              _componentAddedOrRemovedSlot;
                 std::unordered_map<ColliderPtr, ColliderChanged::Slot>              _colliderPropertiesChangedSlot;
@@ -114,17 +120,31 @@ namespace minko
                 bool                                                                _paused;
 
             public:
+                /*
+                ** With numThreads > 1, the narrowphase and the constraint solver run on numThreads
+                ** worker threads, using Bullet's parallel dispatcher and parallel constraint solver.
+                ** numThreads is clamped to the number of hardware threads, since workers sharing a core
+                ** make the step slower than the sequential one. This is not available on HTML5, where
+                ** the world is always single-threaded.
+                */
                 static
                 Ptr
-                create()
+                create(uint numThreads = 1)
                 {
                     Ptr ptr(new PhysicsWorld());
 
-                    ptr->initialize();
+                    ptr->initialize(numThreads);
 
                     return ptr;
                 }
 
+                inline
+                uint
+                numThreads() const
+                {
+                    return _numThreads;
+                }
+
                 ~PhysicsWorld()
                 {
                 }
@@ -224,7 +244,16 @@ namespace minko
                 PhysicsWorld();
 
                 void
-                initialize();
+                initialize(uint numThreads);
+
+                static
+                unsigned long long
+                collisionKey(uint uid1, uint uid2)
+                {
+                    return uid1 < uid2
+                        ? (static_cast<unsigned long long>(uid1) << 32) | uid2
+                        : (static_cast<unsigned long long>(uid2) << 32) | uid1;
+                }
 
                 void
                 targetAdded(NodePtr);
@@ -241,6 +270,9 @@ namespace minko
                 void
                 frameEndHandler(std::shared_ptr<SceneManager>, float time, float deltaTime);
 
+                void
+                tickHandler(std::shared_ptr<SceneManager>, float time, float deltaTime);
+
                 void
                 updateColliders();
 
@@ -24,8 +24,6 @@ minko.project.library("minko-plugin-" .. PROJECT_NAME)
 
 	excludes {
 		"lib/bullet2/src/MiniCL/MiniCL.cpp",
-		"lib/bullet2/src/BulletMultiThreaded/*.h",
-		"lib/bullet2/src/BulletMultiThreaded/*.cpp",
 		"lib/bullet2/src/BulletMultiThreaded/GpuSoftBodySolvers/*.h",
 		"lib/bullet2/src/BulletMultiThreaded/GpuSoftBodySolvers/*.cpp",
 		"lib/bullet2/src/BulletMultiThreaded/GpuSoftBodySolvers/DX11/*.h",
@@ -36,8 +34,6 @@ minko.project.library("minko-plugin-" .. PROJECT_NAME)
 		"lib/bullet2/src/BulletMultiThreaded/GpuSoftBodySolvers/OpenCL/MiniCL/*.cpp",
 		"lib/bullet2/src/BulletMultiThreaded/GpuSoftBodySolvers/Shared/*.h",
 		"lib/bullet2/src/BulletMultiThreaded/GpuSoftBodySolvers/Shared/*.cpp",
-		"lib/bullet2/src/BulletMultiThreaded/SpuNarrowPhaseCollisionTask/*.h",
-		"lib/bullet2/src/BulletMultiThreaded/SpuNarrowPhaseCollisionTask/*.cpp",
 		"lib/bullet2/src/BulletMultiThreaded/SpuSampleTask/*.h",
 		"lib/bullet2/src/BulletMultiThreaded/SpuSampleTask/*.cpp"
 	}
@@ -66,3 +62,10 @@ minko.project.library("minko-plugin-" .. PROJECT_NAME)
 		buildoptions {
 			"-Wno-narrowing -Wno-int-to-pointer-cast"
 		}
+		-- the parallel dispatcher and constraint solver need threads
+		excludes {
+			"lib/bullet2/src/BulletMultiThreaded/*.h",
+			"lib/bullet2/src/BulletMultiThreaded/*.cpp",
+			"lib/bullet2/src/BulletMultiThreaded/SpuNarrowPhaseCollisionTask/*.h",
+			"lib/bullet2/src/BulletMultiThreaded/SpuNarrowPhaseCollisionTask/*.cpp"
+		}
@@ -20,6 +20,18 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/bullet/PhysicsWorld.hpp"
 
 #include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionDispatch/btSimulationIslandManager.h>
+#if MINKO_PLATFORM != MINKO_PLATFORM_HTML5
+# define MINKO_BULLET_MULTITHREADED
+# include <BulletMultiThreaded/SpuGatheringCollisionDispatcher.h>
+# include <BulletMultiThreaded/SpuNarrowPhaseCollisionTask/SpuGatheringCollisionTask.h>
+# include <BulletMultiThreaded/btParallelConstraintSolver.h>
+# if defined(_WIN32)
+#  include <BulletMultiThreaded/Win32ThreadSupport.h>
+# else
+#  include <BulletMultiThreaded/PosixThreadSupport.h>
+# endif
+#endif
 #include <minko/scene/Node.hpp>
 #include <minko/scene/NodeSet.hpp>
 #include <minko/component/SceneManager.hpp>
@@ -31,11 +43,13 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/math/tools.hpp"
 
+#include <thread>
+
 using namespace minko;
 using namespace minko::scene;
 using namespace minko::component;
 
-/*static*/ const uint bullet::PhysicsWorld::_MAX_BODIES = 2048;
+/*static*/ const uint bullet::PhysicsWorld::_MAX_BODIES = 32768;
 
 
 bullet::PhysicsWorld::PhysicsWorld():
@@ -45,6 +59,9 @@ bullet::PhysicsWorld::PhysicsWorld():
     _colliderReverseMap(),
     _uidToCollider(),
     _collisions(),
+    _numThreads(1),
+    _collisionThreadSupport(nullptr),
+    _solverThreadSupport(nullptr),
     _bulletBroadphase(nullptr),
     _bulletCollisionConfiguration(nullptr),
     _bulletConstraintSolver(nullptr),
@@ -54,6 +71,7 @@ bullet::PhysicsWorld::PhysicsWorld():
     _targetRemovedSlot(nullptr),
     _frameBeginSlot(nullptr),
     _frameEndSlot(nullptr),
+    _tickSlot(nullptr),
     _componentAddedOrRemovedSlot(nullptr),
     _addedOrRemovedSlot(nullptr),
     _colliderNodeLayoutChangedSlot(),
@@ -65,22 +83,95 @@ bullet::PhysicsWorld::PhysicsWorld():
 {
 }
 
+#ifdef MINKO_BULLET_MULTITHREADED
+static
+std::shared_ptr<btThreadSupportInterface>
+createThreadSupport(const char* name, void* (*lsMemoryFunc)(), uint numThreads,
+# if defined(_WIN32)
+                    Win32ThreadFunc threadFunc)
+{
+    return std::make_shared<Win32ThreadSupport>(Win32ThreadSupport::Win32ThreadConstructionInfo(
+        name, threadFunc, lsMemoryFunc, numThreads
+    ));
+}
+# else
+                    PosixThreadFunc threadFunc)
+{
+    PosixThreadSupport::ThreadConstructionInfo info(const_cast<char*>(name), threadFunc, lsMemoryFunc, numThreads);
+
+    return std::make_shared<PosixThreadSupport>(info);
+}
+# endif
+#endif
 
 void
-bullet::PhysicsWorld::initialize()
+bullet::PhysicsWorld::initialize(uint numThreads)
 {
-    // straightforward physics world initialization for the time being
     _bulletBroadphase = std::shared_ptr<btDbvtBroadphase>(new btDbvtBroadphase());
-    _bulletCollisionConfiguration = std::shared_ptr<btDefaultCollisionConfiguration>(new btDefaultCollisionConfiguration());
-    _bulletConstraintSolver = std::shared_ptr<btSequentialImpulseConstraintSolver>(new btSequentialImpulseConstraintSolver());
-    _bulletDispatcher = std::shared_ptr<btCollisionDispatcher>(new btCollisionDispatcher(_bulletCollisionConfiguration.get()));
 
-    _bulletDynamicsWorld = std::shared_ptr<btDiscreteDynamicsWorld>(new btDiscreteDynamicsWorld(
+#ifdef MINKO_BULLET_MULTITHREADED
+    // the workers only pay off when they get cores of their own: time-sliced on fewer cores, the
+    // parallel dispatcher and solver take about twice as long as the sequential step
+    numThreads = std::min(numThreads, std::max(1u, std::thread::hardware_concurrency()));
+
+    if (numThreads > 1)
+    {
+        _numThreads = numThreads;
+
+        // the parallel dispatcher cannot grow the manifold pool from its worker threads
+        btDefaultCollisionConstructionInfo constructionInfo;
+
+        constructionInfo.m_defaultMaxPersistentManifoldPoolSize = 32768;
+
+        _bulletCollisionConfiguration = std::shared_ptr<btDefaultCollisionConfiguration>(
+            new btDefaultCollisionConfiguration(constructionInfo)
+        );
+
+        _collisionThreadSupport = createThreadSupport(
+            "collision", createCollisionLocalStoreMemory, numThreads, processCollisionTask
+        );
+        _solverThreadSupport = createThreadSupport(
+            "solver", SolverlsMemoryFunc, numThreads, SolverThreadFunc
+        );
+
+        auto dispatcher = std::shared_ptr<SpuGatheringCollisionDispatcher>(new SpuGatheringCollisionDispatcher(
+            _collisionThreadSupport.get(),
+            numThreads,
+            _bulletCollisionConfiguration.get()
+        ));
+
+        dispatcher->setDispatcherFlags(btCollisionDispatcher::CD_DISABLE_CONTACTPOOL_DYNAMIC_ALLOCATION);
+
+        _bulletDispatcher = dispatcher;
+        _bulletConstraintSolver = std::shared_ptr<btParallelConstraintSolver>(
+            new btParallelConstraintSolver(_solverThreadSupport.get())
+        );
+    }
+    else
+#endif
+    {
+        _numThreads = 1;
+        _bulletCollisionConfiguration = std::shared_ptr<btDefaultCollisionConfiguration>(new btDefaultCollisionConfiguration());
+        _bulletConstraintSolver = std::shared_ptr<btSequentialImpulseConstraintSolver>(new btSequentialImpulseConstraintSolver());
+        _bulletDispatcher = std::shared_ptr<btCollisionDispatcher>(new btCollisionDispatcher(_bulletCollisionConfiguration.get()));
+    }
+
+    auto dynamicsWorld = std::shared_ptr<btDiscreteDynamicsWorld>(new btDiscreteDynamicsWorld(
         _bulletDispatcher.get(),
         _bulletBroadphase.get(),
         _bulletConstraintSolver.get(),
         _bulletCollisionConfiguration.get()
-        ));
+    ));
+
+    if (_numThreads > 1)
+    {
+        // the parallel solver batches the constraints of all the islands itself
+        dynamicsWorld->getSimulationIslandManager()->setSplitIslands(false);
+        dynamicsWorld->getSolverInfo().m_solverMode = SOLVER_SIMD | SOLVER_USE_WARMSTARTING;
+        dynamicsWorld->getDispatchInfo().m_enableSPU = true;
+    }
+
+    _bulletDynamicsWorld = dynamicsWorld;
 }
 
 void
@@ -95,6 +186,7 @@ bullet::PhysicsWorld::targetRemoved(Node::Ptr target)
     _sceneManager = nullptr;
     _frameBeginSlot = nullptr;
     _frameEndSlot = nullptr;
+    _tickSlot = nullptr;
     _addedOrRemovedSlot = nullptr;
     _componentAddedOrRemovedSlot = nullptr;
     _exitFrameSlot = nullptr;
@@ -142,6 +234,15 @@ bullet::PhysicsWorld::setSceneManager(std::shared_ptr<SceneManager> sceneManager
                 std::placeholders::_3
             ));
 
+            // step before any other tick listener so that they see the current physics state
+            _tickSlot = sceneManager->tick()->connect(std::bind(
+                &PhysicsWorld::tickHandler,
+                std::static_pointer_cast<PhysicsWorld>(shared_from_this()),
+                std::placeholders::_1,
+                std::placeholders::_2,
+                std::placeholders::_3
+            ), 1000.f);
+
             _componentAddedOrRemovedSlot = target()->componentRemoved().connect(componentCallback);
             _addedOrRemovedSlot = target()->removed().connect(nodeCallback);
         }
@@ -150,6 +251,7 @@ bullet::PhysicsWorld::setSceneManager(std::shared_ptr<SceneManager> sceneManager
             _sceneManager = nullptr;
             _frameBeginSlot = nullptr;
             _frameEndSlot = nullptr;
+            _tickSlot = nullptr;
 
             _componentAddedOrRemovedSlot = target()->componentAdded().connect(componentCallback);
             _addedOrRemovedSlot = target()->added().connect(nodeCallback);
@@ -308,10 +410,10 @@ bullet::PhysicsWorld::removeCollider(Collider::Ptr collider)
         _uidToCollider.erase(uidIt);
     }
 
-    // remove all current collision pairs the collider appears in (warning: it is an ordered set, remove_if won't work).
+    // remove all current collision pairs the collider appears in
     for (auto collisionIt = _collisions.begin(); collisionIt != _collisions.end();)
     {
-        if (collisionIt->first == uid || collisionIt->second == uid)
+        if (uint(*collisionIt >> 32) == uid || uint(*collisionIt & 0xffffffff) == uid)
             collisionIt = _collisions.erase(collisionIt);
         else
             ++collisionIt;
@@ -333,7 +435,8 @@ bullet::PhysicsWorld::setGravity(const math::vec3& gravity)
 void
 bullet::PhysicsWorld::frameBeginHandler(std::shared_ptr<SceneManager> sceneManager, float time, float deltaTime)
 {
-    if (_paused)
+    // the simulation is stepped by tickHandler() when the scene runs fixed ticks
+    if (_paused || sceneManager->fixedTimestep() > 0.f)
         return;
     
     deltaTime = deltaTime / 1000.0f;
@@ -348,6 +451,19 @@ bullet::PhysicsWorld::frameBeginHandler(std::shared_ptr<SceneManager> sceneManag
     updateColliders();
 }
 
+void
+bullet::PhysicsWorld::tickHandler(std::shared_ptr<SceneManager> sceneManager, float time, float deltaTime)
+{
+    if (_paused)
+        return;
+
+    deltaTime = deltaTime / 1000.0f;
+
+    _bulletDynamicsWorld->stepSimulation(deltaTime, 1, deltaTime);
+
+    updateColliders();
+}
+
 void
 bullet::PhysicsWorld::frameEndHandler(std::shared_ptr<SceneManager> sceneManager, float time, float deltaTime)
 {
@@ -357,20 +473,16 @@ bullet::PhysicsWorld::frameEndHandler(std::shared_ptr<SceneManager> sceneManager
 void
 bullet::PhysicsWorld::updateColliders()
 {
-    static auto physicsModelToWorld = math::mat4();
-
+    // sleeping and static bodies did not move during the step: leave their Transform alone
     for (auto& dataAndBulletCollider : _colliderMap)
     {
-        auto collider = dataAndBulletCollider.first;
-        auto bulletCollider = dataAndBulletCollider.second;
-        //auto data = collider->colliderData();
+        auto& collider = dataAndBulletCollider.first;
+        auto rigidBody = dataAndBulletCollider.second->rigidBody();
 
-        if (collider->colliderData()->isStatic())
+        if (collider->colliderData()->isStatic() || !rigidBody->isActive())
             continue;
 
-        physicsModelToWorld = math::fromBulletTransform(bulletCollider->rigidBody()->getWorldTransform());
-
-        collider->setPhysicsTransform(physicsModelToWorld);
+        collider->setPhysicsTransform(math::fromBulletTransform(rigidBody->getWorldTransform()));
     }
 }
 
@@ -408,6 +520,11 @@ bullet::PhysicsWorld::updateRigidBodyState(Collider::Ptr        collider,
 
     bulletMotionState->getWorldTransform(bulletTransform);
     bulletCollider->rigidBody()->setWorldTransform(bulletTransform);
+
+    // a sleeping body moved from the scene must be simulated again, or updateColliders() would
+    // skip it and the step would never see its new position
+    if (!collider->colliderData()->isStatic())
+        bulletCollider->rigidBody()->activate(true);
 }
 
 void
@@ -437,10 +554,7 @@ bullet::PhysicsWorld::notifyCollisions()
         //    continue;
 
         // a collision exists between to valid colliders
-        auto collision = std::make_pair(colliders[0]->uid(),  colliders[1]->uid());
-
-        if (collision.first > collision.second)
-            std::swap(collision.first, collision.second);
+        auto collision = collisionKey(colliders[0]->uid(), colliders[1]->uid());
 
         if (_collisions.find(collision) == _collisions.end()) // inserted only once
         {
@@ -453,26 +567,18 @@ bullet::PhysicsWorld::notifyCollisions()
         currentCollisions.insert(collision);
     }
 
-    // FIXME: not optimal at all.
-    // find and notify collisions that are not present anymore as the difference with the intersection
-    // between the previous collision set and the current one.
-
-    CollisionSet lostCollisions;
-    
-    std::set_difference(
-        _collisions.begin(), _collisions.end(),
-        currentCollisions.begin(), currentCollisions.end(),
-        std::inserter(lostCollisions, lostCollisions.end())
-    );
-
-    for (auto& collision : lostCollisions)
+    // find and notify collisions that are not present anymore
+    for (auto collision : _collisions)
     {
-        auto foundColliderIt = _uidToCollider.find(collision.first);
+        if (currentCollisions.count(collision))
+            continue;
+
+        auto foundColliderIt = _uidToCollider.find(uint(collision >> 32));
         colliders[0] = foundColliderIt != _uidToCollider.end()
             ? foundColliderIt->second
             : nullptr;
 
-        foundColliderIt = _uidToCollider.find(collision.second);
+        foundColliderIt = _uidToCollider.find(uint(collision & 0xffffffff));
         colliders[1] = foundColliderIt != _uidToCollider.end()
             ? foundColliderIt->second
             : nullptr;
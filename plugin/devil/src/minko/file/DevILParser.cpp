@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/Options.hpp"
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/render/Texture.hpp"
+#include "minko/render/TextureUploadQueue.hpp"
 
 #include <IL/il.h>
 #include <IL/ilu.h>
@@ -82,16 +83,39 @@ DevILParser::parse(const std::string&                 filename,
     texture = std::static_pointer_cast<render::Texture>(options->textureFunction()(filename, texture));
 
     texture->data(bmpData);
+
+    AssetLibrary->texture(filename, texture);
+
+    ilShutDown();
+
+    // DevIL keeps its images in a global state: only the upload can be deferred, not the decoding
+    if (options->loadTexturesAsynchronously())
+    {
+        auto parser = shared_from_this();
+
+        AssetLibrary->textureUploadQueue()->upload(
+            texture,
+            render::TextureUploadQueue::textureMemory(texture),
+            [=]()
+            {
+                texture->upload();
+
+                if (options->disposeTextureAfterLoading())
+                    texture->disposeData();
+
+                parser->complete()->execute(parser);
+            }
+        );
+
+        return;
+    }
+
     texture->upload();
 
     if (options->disposeTextureAfterLoading())
         texture->disposeData();
 
-    AssetLibrary->texture(filename, texture);
-
     complete()->execute(shared_from_this());
-
-    ilShutDown();
 }
 
 void
@@ -53,6 +53,22 @@ namespace minko
             JPEGParser()
             {
             }
+
+            void
+            parseAsynchronously(const std::string&                  filename,
+                                std::shared_ptr<Options>            options,
+                                const std::vector<unsigned char>&   data,
+                                std::shared_ptr<AssetLibrary>       assetLibrary);
+
+            std::shared_ptr<render::AbstractTexture>
+            createTexture(const std::string&                    filename,
+                          std::shared_ptr<Options>              options,
+                          std::shared_ptr<AssetLibrary>         assetLibrary,
+                          const unsigned char*                  bmpData,
+                          int                                   width,
+                          int                                   height,
+                          int                                   comps,
+                          bool                                  upload);
         };
     }
 }
@@ -24,6 +24,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/MipMapChainParser.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/CubeTexture.hpp"
+#include "minko/render/TextureUploadQueue.hpp"
 
 #include "jpgd.h"
 
@@ -37,6 +38,13 @@ JPEGParser::parse(const std::string&                filename,
                   const std::vector<unsigned char>& data,
                   std::shared_ptr<AssetLibrary>     assetLibrary)
 {
+    if (options->loadTexturesAsynchronously())
+    {
+        parseAsynchronously(filename, options, data, assetLibrary);
+
+        return;
+    }
+
     int width;
     int height;
     int comps;
@@ -56,6 +64,88 @@ JPEGParser::parse(const std::string&                filename,
         return;
     }
 
+    auto texture = createTexture(filename, options, assetLibrary, bmpData, width, height, comps, true);
+
+    free(bmpData);
+
+    if (options->disposeTextureAfterLoading())
+        texture->disposeData();
+
+    complete()->execute(shared_from_this());
+}
+
+void
+JPEGParser::parseAsynchronously(const std::string&                filename,
+                                std::shared_ptr<Options>          options,
+                                const std::vector<unsigned char>& data,
+                                std::shared_ptr<AssetLibrary>     assetLibrary)
+{
+    auto parser = std::static_pointer_cast<JPEGParser>(shared_from_this());
+    // the queue owns the jobs, their closures must not own the queue
+    auto weakUploadQueue = std::weak_ptr<render::TextureUploadQueue>(assetLibrary->textureUploadQueue());
+    // the loader does not keep the file data alive once parse() has returned
+    auto jpegData = std::make_shared<std::vector<unsigned char>>(data);
+    auto bmpData = std::make_shared<unsigned char*>(nullptr);
+    auto size = std::make_shared<math::ivec3>();
+
+    assetLibrary->textureUploadQueue()->decode(
+        [=]() -> uint
+        {
+            *bmpData = jpgd::decompress_jpeg_image_from_memory(
+                jpegData->data(), static_cast<int>(jpegData->size()), &size->x, &size->y, &size->z, 3
+            );
+            jpegData->clear();
+
+            return *bmpData != nullptr ? static_cast<uint>(size->x * size->y * 3) : 0u;
+        },
+        [=]()
+        {
+            if (*bmpData == nullptr)
+            {
+                parser->error()->execute(parser, Error("ParserError", "failed to decode JPEG file " + filename));
+
+                return;
+            }
+
+            auto uploadQueue = weakUploadQueue.lock();
+
+            auto texture = parser->createTexture(filename, options, assetLibrary, *bmpData, size->x, size->y, size->z, false);
+
+            free(*bmpData);
+
+            uploadQueue->upload(texture, render::TextureUploadQueue::textureMemory(texture), [=]()
+            {
+                if (texture->type() == render::TextureType::Texture2D)
+                    MipMapChainParser().uploadTexture(std::static_pointer_cast<render::Texture>(texture));
+                else
+                    texture->upload();
+
+                if (options->disposeTextureAfterLoading())
+                    texture->disposeData();
+
+                parser->complete()->execute(parser);
+            });
+        },
+        [=]()
+        {
+            free(*bmpData);
+            parser->error()->execute(parser, Error(
+                "ParserError", "JPEG file " + filename + " was not decoded before its upload queue was destroyed"
+            ));
+        }
+    );
+}
+
+render::AbstractTexture::Ptr
+JPEGParser::createTexture(const std::string&                filename,
+                          std::shared_ptr<Options>          options,
+                          std::shared_ptr<AssetLibrary>     assetLibrary,
+                          const unsigned char*              bmpData,
+                          int                               width,
+                          int                               height,
+                          int                               comps,
+                          bool                              upload)
+{
     auto format = render::TextureFormat::RGBA;
     if (comps == 3 || comps == 1)
         format = render::TextureFormat::RGB;
@@ -75,7 +165,8 @@ JPEGParser::parse(const std::string&                filename,
             options->parseMipMaps() || options->generateMipmaps(),
             options->resizeSmoothly(),
             format,
-            filename
+            filename,
+            upload
         );
 
         cubeTexture = std::static_pointer_cast<render::CubeTexture>(options->textureFunction()(filename, cubeTexture));
@@ -100,7 +191,8 @@ JPEGParser::parse(const std::string&                filename,
             options->parseMipMaps() || options->generateMipmaps(),
             options->resizeSmoothly(),
             format,
-            filename
+            filename,
+            upload
         );
 
         texture2d = std::static_pointer_cast<render::Texture>(options->textureFunction()(filename, texture2d));
@@ -109,13 +201,5 @@ JPEGParser::parse(const std::string&                filename,
         assetLibrary->texture(filename, texture2d);
     }
 
-    if (options->disposeTextureAfterLoading())
-        texture->disposeData();
-
-    free(bmpData);
-
-    if (options->disposeTextureAfterLoading())
-        texture->disposeData();
-
-    complete()->execute(shared_from_this());
+    return texture;
 }
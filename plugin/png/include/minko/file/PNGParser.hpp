@@ -52,6 +52,24 @@ namespace minko
             PNGParser()
             {
             }
+
+            void
+            parseAsynchronously(const std::string&                  filename,
+                                std::shared_ptr<Options>            options,
+                                const std::vector<unsigned char>&   data,
+                                std::shared_ptr<AssetLibrary>       assetLibrary);
+
+            void
+            decodingError(const std::string& filename, unsigned int error);
+
+            std::shared_ptr<render::AbstractTexture>
+            createTexture(const std::string&                    filename,
+                          std::shared_ptr<Options>              options,
+                          std::shared_ptr<AssetLibrary>         assetLibrary,
+                          const std::vector<unsigned char>&     bmpData,
+                          unsigned int                          width,
+                          unsigned int                          height,
+                          bool                                  upload);
         };
     }
 }
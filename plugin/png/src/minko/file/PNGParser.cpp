@@ -24,6 +24,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/Texture.hpp"
 #include "minko/render/CubeTexture.hpp"
 #include "minko/render/RectangleTexture.hpp"
+#include "minko/render/TextureUploadQueue.hpp"
 #include "minko/file/MipMapChainParser.hpp"
 
 #include "lodepng.h"
@@ -38,6 +39,13 @@ PNGParser::parse(const std::string&                 filename,
                  const std::vector<unsigned char>&  data,
                  std::shared_ptr<AssetLibrary>      assetLibrary)
 {
+    if (options->loadTexturesAsynchronously())
+    {
+        parseAsynchronously(filename, options, data, assetLibrary);
+
+        return;
+    }
+
     std::vector<unsigned char> bmpData;
     unsigned int width;
     unsigned int height;
@@ -46,14 +54,100 @@ PNGParser::parse(const std::string&                 filename,
 
     if (error)
     {
-        const char* text = lodepng_error_text(error);
-
-        _error->execute(shared_from_this(), Error("file '" + filename + "' loading error (" + text + ")"));
-        _complete->execute(shared_from_this());
+        decodingError(filename, error);
 
         return;
     }
 
+    auto texture = createTexture(filename, options, assetLibrary, bmpData, width, height, true);
+
+    texture->upload();
+
+    if (options->disposeTextureAfterLoading())
+        texture->disposeData();
+
+    complete()->execute(shared_from_this());
+}
+
+void
+PNGParser::parseAsynchronously(const std::string&                 filename,
+                               std::shared_ptr<Options>           options,
+                               const std::vector<unsigned char>&  data,
+                               std::shared_ptr<AssetLibrary>      assetLibrary)
+{
+    auto parser = std::static_pointer_cast<PNGParser>(shared_from_this());
+    // the queue owns the jobs, their closures must not own the queue
+    auto weakUploadQueue = std::weak_ptr<render::TextureUploadQueue>(assetLibrary->textureUploadQueue());
+    // the loader does not keep the file data alive once parse() has returned
+    auto pngData = std::make_shared<std::vector<unsigned char>>(data);
+    auto bmpData = std::make_shared<std::vector<unsigned char>>();
+    auto size = std::make_shared<math::uvec2>();
+    auto error = std::make_shared<unsigned>(0u);
+
+    assetLibrary->textureUploadQueue()->decode(
+        [=]() -> uint
+        {
+            *error = lodepng::decode(*bmpData, size->x, size->y, pngData->data(), pngData->size());
+            pngData->clear();
+
+            return static_cast<uint>(bmpData->size());
+        },
+        [=]()
+        {
+            if (*error)
+            {
+                parser->decodingError(filename, *error);
+
+                return;
+            }
+
+            auto uploadQueue = weakUploadQueue.lock();
+
+            auto texture = parser->createTexture(filename, options, assetLibrary, *bmpData, size->x, size->y, false);
+
+            bmpData->clear();
+
+            uploadQueue->upload(texture, render::TextureUploadQueue::textureMemory(texture), [=]()
+            {
+                if (texture->type() == render::TextureType::Texture2D)
+                    MipMapChainParser().uploadTexture(std::static_pointer_cast<render::Texture>(texture));
+                else
+                    texture->upload();
+
+                if (options->disposeTextureAfterLoading())
+                    texture->disposeData();
+
+                parser->complete()->execute(parser);
+            });
+        },
+        [=]()
+        {
+            parser->error()->execute(parser, Error(
+                "ParserError", "file '" + filename + "' was not decoded before its upload queue was destroyed"
+            ));
+            parser->complete()->execute(parser);
+        }
+    );
+}
+
+void
+PNGParser::decodingError(const std::string& filename, unsigned int error)
+{
+    const char* text = lodepng_error_text(error);
+
+    _error->execute(shared_from_this(), Error("file '" + filename + "' loading error (" + text + ")"));
+    _complete->execute(shared_from_this());
+}
+
+render::AbstractTexture::Ptr
+PNGParser::createTexture(const std::string&                 filename,
+                         std::shared_ptr<Options>           options,
+                         std::shared_ptr<AssetLibrary>      assetLibrary,
+                         const std::vector<unsigned char>&  bmpData,
+                         unsigned int                       width,
+                         unsigned int                       height,
+                         bool                               upload)
+{
     render::AbstractTexture::Ptr texture = nullptr;
 
     if (options->isCubeTexture())
@@ -69,7 +163,8 @@ PNGParser::parse(const std::string&                 filename,
             options->parseMipMaps() || options->generateMipmaps(),
             options->resizeSmoothly(),
             render::TextureFormat::RGBA,
-            filename
+            filename,
+            upload
         );
 
         cubeTexture = std::static_pointer_cast<render::CubeTexture>(options->textureFunction()(filename, cubeTexture));
@@ -94,7 +189,8 @@ PNGParser::parse(const std::string&                 filename,
             options->parseMipMaps() || options->generateMipmaps(),
             options->resizeSmoothly(),
             render::TextureFormat::RGBA,
-            filename
+            filename,
+            upload
         );
 
         texture2d = std::static_pointer_cast<render::Texture>(options->textureFunction()(filename, texture2d));
@@ -103,10 +199,5 @@ PNGParser::parse(const std::string&                 filename,
         assetLibrary->texture(filename, texture2d);
     }
 
-    texture->upload();
-
-    if (options->disposeTextureAfterLoading())
-        texture->disposeData();
-
-    complete()->execute(shared_from_this());
+    return texture;
 }
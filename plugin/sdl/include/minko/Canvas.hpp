@@ -99,6 +99,10 @@ namespace minko
         float                                                                   _desiredEventrate;
         bool                                                                    _swapBuffersAtEnterFrame;
 
+        std::vector<float>                                                      _frameIntervals;
+        uint                                                                    _frameIntervalIndex;
+        uint                                                                    _numLateFrames;
+
         std::shared_ptr<audio::SDLAudio>                                        _audio;
 
         std::shared_ptr<input::SDLMouse>                                        _mouse;
@@ -365,6 +369,27 @@ namespace minko
             return _relativeTime;
         }
 
+        // Frame pacing statistics, computed over the last rendered frames.
+        // Intervals are the times between two rendered frames, in milliseconds.
+        float
+        averageFrameInterval() const;
+
+        float
+        maxFrameInterval() const;
+
+        // Standard deviation of the frame intervals, ie. the frame pacing jitter.
+        float
+        frameIntervalDeviation() const;
+
+        // Number of rendered frames that came more than 1.5 times later than
+        // desiredFramerate() asks for, since the canvas was created.
+        inline
+        uint
+        numLateFrames() const
+        {
+            return _numLateFrames;
+        }
+
         WorkerPtr
         getWorker(const std::string& name) override;
 
@@ -413,6 +438,9 @@ namespace minko
         void
         initializeWindow();
 
+        void
+        recordFrameInterval(float interval);
+
     public:
         void
         step();
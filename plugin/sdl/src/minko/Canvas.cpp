@@ -77,6 +77,9 @@ Canvas::Canvas(const std::string& name, const uint width, const uint height, int
     _desiredFramerateChanged(false),
     _desiredEventrate(60.f),
 	_swapBuffersAtEnterFrame(true),
+    _frameIntervals(),
+    _frameIntervalIndex(0),
+    _numLateFrames(0),
     _enterFrame(Signal<AbstractCanvas::Ptr, float, float, bool>::create()),
     _resized(Signal<AbstractCanvas::Ptr, uint, uint>::create()),
     _fileDropped(Signal<const std::string&>::create()),
@@ -1015,8 +1018,13 @@ Canvas::step()
     auto shouldRender = _desiredFramerateChanged || (_desiredEventrate == _desiredFramerate) || _deltaRenderTime >= (1000.f / _desiredFramerate);
 
     if (shouldRender)
+    {
         _previousRenderTime = absoluteTime;
 
+        if (_enableRendering)
+            recordFrameInterval(_deltaRenderTime);
+    }
+
     if (_enableRendering)
     {
         _enterFrame->execute(that, _relativeTime, _deltaTime, shouldRender);
@@ -1042,6 +1050,61 @@ Canvas::step()
         _desiredFramerateChanged = false;
 }
 
+void
+Canvas::recordFrameInterval(float interval)
+{
+    static const auto maxNumFrameIntervals = 120u;
+
+    if (_frameIntervals.size() < maxNumFrameIntervals)
+        _frameIntervals.push_back(interval);
+    else
+        _frameIntervals[_frameIntervalIndex] = interval;
+
+    _frameIntervalIndex = (_frameIntervalIndex + 1) % maxNumFrameIntervals;
+
+    if (interval > 1.5f * 1000.f / _desiredFramerate)
+        ++_numLateFrames;
+}
+
+float
+Canvas::averageFrameInterval() const
+{
+    if (_frameIntervals.empty())
+        return 0.f;
+
+    auto sum = 0.f;
+
+    for (auto interval : _frameIntervals)
+        sum += interval;
+
+    return sum / _frameIntervals.size();
+}
+
+float
+Canvas::maxFrameInterval() const
+{
+    if (_frameIntervals.empty())
+        return 0.f;
+
+    return *std::max_element(_frameIntervals.begin(), _frameIntervals.end());
+}
+
+float
+Canvas::frameIntervalDeviation() const
+{
+    if (_frameIntervals.empty())
+        return 0.f;
+
+    const auto average = averageFrameInterval();
+
+    auto variance = 0.f;
+
+    for (auto interval : _frameIntervals)
+        variance += (interval - average) * (interval - average);
+
+    return std::sqrt(variance / _frameIntervals.size());
+}
+
 void
 Canvas::run()
 {
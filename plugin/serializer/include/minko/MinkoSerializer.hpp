@@ -11,9 +11,12 @@
 #include "minko/file/MaterialWriter.hpp"
 #include "minko/file/SceneTreeFlattener.hpp"
 #include "minko/file/SurfaceClusterBuilder.hpp"
+#include "minko/file/TextureContainer.hpp"
+#include "minko/file/TextureContainerParser.hpp"
 #include "minko/file/TextureParser.hpp"
 #include "minko/file/TextureWriter.hpp"
 #include "minko/file/UnusedVertexCleaner.hpp"
+#include "minko/file/VertexCacheOptimizer.hpp"
 #include "minko/file/VertexColorSampler.hpp"
 #include "minko/file/VertexWelder.hpp"
 #include "minko/file/WriterOptions.hpp"
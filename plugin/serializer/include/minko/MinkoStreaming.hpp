@@ -8,6 +8,7 @@
 #include "minko/extension/StreamingExtension.hpp"
 #include "minko/file/AbstractStreamedAssetParser.hpp"
 #include "minko/file/MeshPartitioner.hpp"
+#include "minko/file/MeshSimplifier.hpp"
 #include "minko/file/POPGeometryParser.hpp"
 #include "minko/file/POPGeometryWriter.hpp"
 #include "minko/file/POPGeometryWriterPreprocessor.hpp"
@@ -49,8 +49,11 @@ namespace minko
         struct SceneVersion;
         class SceneWriter;
         class SurfaceOperator;
+        class TextureContainer;
+        class TextureContainerParser;
         class TextureParser;
         class TextureWriter;
+        class VertexCacheOptimizer;
         class VertexColorSampler;
         class VertexWelder;
         class WriterOptions;
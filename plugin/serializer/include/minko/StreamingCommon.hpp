@@ -100,6 +100,7 @@ namespace minko
     {
         class AbstractStreamedAssetParser;
         class MeshPartitioner;
+        class MeshSimplifier;
         class POPGeometryParser;
         class POPGeometryWriter;
         class StreamedAssetParserScheduler;
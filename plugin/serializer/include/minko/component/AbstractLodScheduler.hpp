@@ -65,6 +65,10 @@ namespace minko
             };
 
         protected:
+            struct ResourceInfo;
+
+            typedef std::multimap<double, ResourceInfo*>                    EyeTravelInvalidationMap;
+
             struct ResourceInfo
             {
                 ProviderPtr														data;
@@ -73,6 +77,9 @@ namespace minko
 
                 LodInfo															lodInfo;
 
+                bool                                                            eyeTravelInvalidationScheduled;
+                EyeTravelInvalidationMap::iterator                              eyeTravelInvalidationIt;
+
                 Signal<ProviderPtr, const data::Provider::PropertyName&>::Slot  propertyChangedSlot;
                 Signal<NodePtr, NodePtr>::Slot                                  layoutChangedSlot;
 
@@ -80,8 +87,10 @@ namespace minko
                 explicit
                 ResourceInfo(ProviderPtr data) :
                     data(data),
-                    lodRequirementIsInvalid(true),
+                    lodRequirementIsInvalid(false),
                     lodInfo(),
+                    eyeTravelInvalidationScheduled(false),
+                    eyeTravelInvalidationIt(),
                     propertyChangedSlot(),
                     layoutChangedSlot()
                 {
@@ -107,9 +116,24 @@ namespace minko
             static const int																DEFAULT_LOD;
 
         private:
+            static const float                                                              EYE_VELOCITY_SMOOTHING;
+
+        private:
+            SceneManagerPtr                                                                 _sceneManager;
             MasterLodSchedulerPtr															_masterLodScheduler;
 
             std::unordered_map<std::string, ResourceInfo>									_resources;
+            std::vector<ResourceInfo*>                                                      _invalidResources;
+
+            bool                                                                            _eyePositionIsValid;
+            math::vec3                                                                      _eyePosition;
+            double                                                                          _eyeTravelDistance;
+            EyeTravelInvalidationMap                                                        _eyeTravelInvalidations;
+
+            bool                                                                            _eyeVelocityIsValid;
+            math::vec3                                                                      _eyeVelocity;
+            math::vec3                                                                      _eyeVelocitySamplePosition;
+            float                                                                           _eyeVelocitySampleTime;
 
             ComponentSolverFunction															_sceneManagerFunction;
             ComponentSolverFunction															_rendererFunction;
@@ -122,6 +146,8 @@ namespace minko
             Signal<NodePtr, NodePtr, AbstractComponentPtr>::Slot							_componentRemovedSlot;
 
             Signal<SceneManagerPtr, float, float>::Slot										_frameBeginSlot;
+            Signal<SceneManagerPtr, const std::vector<SurfacePtr>&>::Slot                   _surfacesAddedSlot;
+            Signal<SceneManagerPtr, const std::vector<SurfacePtr>&>::Slot                   _surfacesRemovedSlot;
 
             Signal<data::Store&, ProviderPtr, const data::Provider::PropertyName&>::Slot	_rootNodePropertyChangedSlot;
             Signal<data::Store&, ProviderPtr, const data::Provider::PropertyName&>::Slot	_rendererNodePropertyChangedSlot;
@@ -129,13 +155,15 @@ namespace minko
             std::unordered_map<NodePtr, Signal<NodePtr, NodePtr>::Slot>                     _nodeLayoutChangedSlots;
             std::unordered_map<SurfacePtr, Signal<AbstractComponentPtr>::Slot>              _surfaceLayoutmaskChangedSlots;
 
-            std::list<SurfacePtr>															_addedSurfaces;
-            std::list<SurfacePtr>															_removedSurfaces;
+            std::unordered_set<SurfacePtr>													_addedSurfaces;
+            std::unordered_set<SurfacePtr>													_removedSurfaces;
 
             bool                                                                            _enabled;
 
             float                                                                           _frameTime;
 
+            uint                                                                            _numLodEvaluations;
+
         public:
             ~AbstractLodScheduler() = default;
 
@@ -218,6 +246,17 @@ namespace minko
             void
             layoutMask(scene::Layout value) override;
 
+            /*
+            ** Number of times the LOD requirement of a resource was evaluated since the scheduler
+            ** was created.
+            */
+            inline
+            uint
+            numLodEvaluations() const
+            {
+                return _numLodEvaluations;
+            }
+
         protected:
             AbstractLodScheduler();
 
@@ -228,6 +267,16 @@ namespace minko
                 return _masterLodScheduler;
             }
 
+            /*
+            ** Smoothed velocity of the eye, in world units per millisecond, sampled once per frame.
+            */
+            inline
+            const math::vec3&
+            eyeVelocity() const
+            {
+                return _eyeVelocity;
+            }
+
             void
             targetAdded(NodePtr target) override;
 
@@ -246,6 +295,15 @@ namespace minko
             void
             invalidateLodRequirement(ResourceInfo& resource);
 
+            /*
+            ** Invalidates the LOD requirement of the resource once the eye has travelled the given
+            ** distance from its current position, whatever the path. Schedulers whose LOD
+            ** requirements only depend on the distance from the eye use it instead of invalidating
+            ** every resource each time the camera moves. An infinite distance cancels it.
+            */
+            void
+            invalidateLodRequirementOnEyeTravel(ResourceInfo& resource, float distance);
+
             virtual
             void
             sceneManagerSet(SceneManagerPtr sceneManager);
@@ -280,6 +338,10 @@ namespace minko
             void
             viewportChanged(const math::vec4& viewport);
 
+            virtual
+            void
+            eyeVelocityChanged(const math::vec3& eyeVelocity);
+
             virtual
             void
             maxAvailableLodChanged(ResourceInfo&    resource,
@@ -321,6 +383,12 @@ namespace minko
             void
             componentRemovedHandler(NodePtr target, AbstractComponentPtr component);
 
+            void
+            surfacesAddedHandler(SceneManagerPtr sceneManager, const std::vector<SurfacePtr>& surfaces);
+
+            void
+            surfacesRemovedHandler(SceneManagerPtr sceneManager, const std::vector<SurfacePtr>& surfaces);
+
             void
             frameBeginHandler(SceneManagerPtr sceneManager, float time, float deltaTime);
 
@@ -354,6 +422,12 @@ namespace minko
 
             void
             removePendingSurface(SurfacePtr surface);
+
+            void
+            cancelEyeTravelInvalidation(ResourceInfo& resource);
+
+            void
+            sampleEyeVelocity(float time);
         };
     }
 }
@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 #include "minko/StreamingCommon.hpp"
 #include "minko/component/AbstractComponent.hpp"
+#include "minko/data/Provider.hpp"
 
 namespace minko
 {
@@ -45,6 +46,8 @@ namespace minko
 
             typedef std::shared_ptr<file::StreamingOptions>     StreamingOptionsPtr;
 
+            typedef std::function<void(int)>                    LodEvictionFunction;
+
             typedef Signal<Ptr, ProviderPtr>                    DeferredTextureRegisteredSignal;
             typedef Signal<
                 Ptr,
@@ -54,6 +57,25 @@ namespace minko
                 AbstractTexturePtr
             >                                                   DeferredTextureReadySignal;
 
+        private:
+            struct ResidentResource
+            {
+                std::size_t                                                         cpuMemory;
+                std::size_t                                                         gpuMemory;
+
+                LodEvictionFunction                                                 evictionFunction;
+
+                Signal<ProviderPtr, const data::Provider::PropertyName&>::Slot      propertyChangedSlot;
+
+                ResidentResource() :
+                    cpuMemory(0),
+                    gpuMemory(0),
+                    evictionFunction(),
+                    propertyChangedSlot()
+                {
+                }
+            };
+
         private:
             std::unordered_map<GeometryPtr, ProviderPtr>            _geometryToDataMap;
             std::unordered_map<AbstractTexturePtr, ProviderPtr>     _textureToDataMap;
@@ -72,6 +94,13 @@ namespace minko
 
             std::vector<AbstractLodSchedulerPtr>                    _lodSchedulers;
 
+            std::unordered_map<ProviderPtr, ResidentResource>       _residentResources;
+            std::size_t                                             _residentCpuMemory;
+            std::size_t                                             _residentGpuMemory;
+            std::size_t                                             _cpuMemoryBudget;
+            std::size_t                                             _gpuMemoryBudget;
+            uint                                                    _numLodEvictions;
+
         public:
             inline
             static
@@ -149,6 +178,67 @@ namespace minko
             void
             layoutMask(scene::Layout value) override;
 
+            /*
+            ** Limits the bytes held by the streamed resources, 0 meaning no limit. Once a budget is
+            ** exceeded, resources loaded beyond their required LOD are downgraded back to it, in the
+            ** order given by StreamingOptions::lodEvictionPriorityFunction(), until the resident
+            ** memory fits again. Must be set before the streamed assets are loaded.
+            ** The GPU memory of a resource is the size of the data of its resident LODs: buffers
+            ** and textures are allocated for all their LODs on creation and are not reallocated
+            ** on downgrade, the evicted ranges are just no longer drawn nor sampled.
+            */
+            Ptr
+            memoryBudget(std::size_t cpuBytes, std::size_t gpuBytes);
+
+            inline
+            std::size_t
+            cpuMemoryBudget() const
+            {
+                return _cpuMemoryBudget;
+            }
+
+            inline
+            std::size_t
+            gpuMemoryBudget() const
+            {
+                return _gpuMemoryBudget;
+            }
+
+            /*
+            ** Sum of the "residentCpuMemory" and "residentGpuMemory" properties published by the
+            ** streamed resources.
+            */
+            inline
+            std::size_t
+            residentCpuMemory() const
+            {
+                return _residentCpuMemory;
+            }
+
+            inline
+            std::size_t
+            residentGpuMemory() const
+            {
+                return _residentGpuMemory;
+            }
+
+            inline
+            uint
+            numLodEvictions() const
+            {
+                return _numLodEvictions;
+            }
+
+            /*
+            ** function downgrades the resource of data to the given LOD or to the closest coarser
+            ** LOD it can keep.
+            */
+            Ptr
+            registerLodEviction(ProviderPtr data, LodEvictionFunction function);
+
+            void
+            enforceMemoryBudget();
+
         protected:
             void
             targetAdded(NodePtr target) override;
@@ -167,6 +257,18 @@ namespace minko
 
             void
             removeLodScheduler(AbstractLodSchedulerPtr lodScheduler);
+
+            void
+            watchResidentMemory(ProviderPtr data);
+
+            void
+            unwatchResidentMemory(ProviderPtr data);
+
+            void
+            residentMemoryChanged(ResidentResource& resource, ProviderPtr data);
+
+            bool
+            overMemoryBudget() const;
         };
     }
 }
\ No newline at end of file
@@ -40,6 +40,7 @@ namespace minko
             typedef std::shared_ptr<MasterLodScheduler>         MasterLodSchedulerPtr;
             typedef std::shared_ptr<Surface>                    SurfacePtr;
 
+            typedef std::shared_ptr<BoundingBox>                BoundingBoxPtr;
             typedef std::shared_ptr<math::Box>                  BoxPtr;
 
             typedef std::shared_ptr<geometry::Geometry>         GeometryPtr;
@@ -53,11 +54,18 @@ namespace minko
                 Signal<
                     AbstractComponentPtr
                 >::Slot                         layoutMaskChangedSlot;
+                Signal<
+                    NodePtr,
+                    NodePtr,
+                    AbstractComponentPtr
+                >::Slot                         componentAddedSlot;
 
                 int                             activeLod;
 
                 float                           requiredPrecisionLevel;
 
+                float                           distanceFromEye;
+
                 float                           weight;
 
                 explicit
@@ -66,8 +74,10 @@ namespace minko
                     box(),
                     layoutChangedSlot(),
                     layoutMaskChangedSlot(),
+                    componentAddedSlot(),
                     activeLod(-1),
                     requiredPrecisionLevel(0),
+                    distanceFromEye(0.f),
                     weight(0.f)
                 {
                 }
@@ -84,6 +94,9 @@ namespace minko
                 int                                         minAvailableLod;
                 int                                         maxAvailableLod;
                 int                                         fullPrecisionLod;
+                bool                                        simplifiedLods;
+
+                int                                         prefetchLod;
 
                 const std::map<
                     int,
@@ -112,6 +125,8 @@ namespace minko
                     minAvailableLod(-1),
                     maxAvailableLod(-1),
                     fullPrecisionLod(-1),
+                    simplifiedLods(false),
+                    prefetchLod(-1),
                     availableLods(nullptr),
                     lodToClosestValidLod(),
                     precisionLevelToClosestLod(),
@@ -138,6 +153,12 @@ namespace minko
 
             float                                                       _blendingRange;
 
+            float                                                       _prefetchDistance;
+            std::unordered_set<POPGeometryResourceInfo*>                _prefetchingResources;
+            int                                                         _numPrefetches;
+            int                                                         _numPrefetchHits;
+            int                                                         _numPrefetchMisses;
+
         public:
             inline
             static
@@ -152,6 +173,45 @@ namespace minko
             void
             blendingRange(float value);
 
+            /*
+            ** Number of LODs requested ahead of time for the eye position predicted by
+            ** StreamingOptions::popGeometryPrefetchTime. A prefetch is a hit when the LOD required
+            ** from the actual eye position reaches the prefetched LOD and the prefetched LOD is
+            ** already available, a miss when it is not available yet or when the prediction is
+            ** withdrawn before.
+            */
+            inline
+            int
+            numPrefetches() const
+            {
+                return _numPrefetches;
+            }
+
+            inline
+            int
+            numPrefetchHits() const
+            {
+                return _numPrefetchHits;
+            }
+
+            inline
+            int
+            numPrefetchMisses() const
+            {
+                return _numPrefetchMisses;
+            }
+
+            inline
+            float
+            prefetchHitRate() const
+            {
+                const auto numResolvedPrefetches = _numPrefetchHits + _numPrefetchMisses;
+
+                return numResolvedPrefetches > 0
+                    ? float(_numPrefetchHits) / float(numResolvedPrefetches)
+                    : 0.f;
+            }
+
         protected:
             void
             sceneManagerSet(SceneManagerPtr sceneManager);
@@ -177,6 +237,9 @@ namespace minko
             void
             viewportChanged(const math::vec4& viewport);
 
+            void
+            eyeVelocityChanged(const math::vec3& eyeVelocity);
+
             void
             maxAvailableLodChanged(ResourceInfo&    resource,
                                    int              maxAvailableLod);
@@ -192,6 +255,14 @@ namespace minko
             layoutChanged(POPGeometryResourceInfo&  resource,
                           SurfaceInfo&              surfaceInfo);
 
+            void
+            boundingBoxChanged(POPGeometryResourceInfo&     resource,
+                               NodePtr                      target,
+                               BoundingBoxPtr               boundingBox);
+
+            bool
+            lodRequirementFollowsEyeTravel() const;
+
             void
             activeLodChanged(POPGeometryResourceInfo&   resource,
                              SurfaceInfo&               surfaceInfo,
@@ -203,7 +274,14 @@ namespace minko
             int
             computeRequiredLod(const POPGeometryResourceInfo&   resource,
                                SurfaceInfo&                     surfaceInfo,
-                               float&                           requiredPrecisionLevel);
+                               const math::vec3&                eyePosition,
+                               float&                           requiredPrecisionLevel,
+                               float&                           distanceFromEye);
+
+            void
+            prefetch(POPGeometryResourceInfo&   resource,
+                     LodInfo&                   lodInfo,
+                     int                        predictedLod);
 
             float
             computeLodPriority(const POPGeometryResourceInfo&  resource,
@@ -231,6 +309,10 @@ namespace minko
             const ProgressiveOrderedMeshLodInfo&
             lodToClosestValidLod(const POPGeometryResourceInfo& resource, int lod) const;
 
+            float
+            eyeTravelSlack(const POPGeometryResourceInfo&   resource,
+                           const SurfaceInfo&               surfaceInfo) const;
+
             float
             distanceFromEye(const POPGeometryResourceInfo&  resource,
                             SurfaceInfo&                    surfaceInfo,
@@ -45,5 +45,26 @@ namespace minko
         {
             unpack(result, reinterpret_cast<const char*>(&source[0]), length, offset);
         }
+
+        template <typename T>
+        bool
+        unpackArrayElement(T& result, const std::vector<unsigned char>& source, std::size_t length, std::size_t index)
+        {
+            bool referenced;
+            auto neverCopy = [](msgpack::type::object_type, std::size_t, void*) -> bool { return true ; };
+
+            msgpack::unpacked unpacked;
+            std::size_t _ = 0;
+            msgpack::unpack(unpacked, reinterpret_cast<const char*>(&source[0]), length, _, referenced, neverCopy);
+            msgpack::object object(unpacked.get());
+
+            // Fields appended to an array after a format revision are missing from older files.
+            if (object.type != msgpack::type::ARRAY || object.via.array.size <= index)
+                return false;
+
+            object.via.array.ptr[index].convert(&result);
+
+            return true;
+        }
     }
 }
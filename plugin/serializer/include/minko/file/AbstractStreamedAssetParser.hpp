@@ -142,6 +142,7 @@ namespace minko
             Signal<std::shared_ptr<LinkedAsset>, const std::vector<unsigned char>&>::Slot       _loaderCompleteSlot;
 
             bool																				_complete;
+            bool                                                                                _fetching;
 
             std::shared_ptr<data::Provider>														_data;
             Signal<std::shared_ptr<data::Provider>, const data::Provider::PropertyName&>::Slot  _dataPropertyChangedSlot;
@@ -279,6 +280,16 @@ namespace minko
             void
             lodRequestFetchingComplete(const std::vector<unsigned char>& data);
 
+            /*
+            ** Downgrades the asset to lod, or to the closest coarser LOD it can keep, and makes
+            ** the evicted LODs fetchable again. Does nothing while a LOD request is in flight.
+            */
+            void
+            evict(int lod);
+
+            bool
+            lodEvictionEnabled() const;
+
         protected:
             AbstractStreamedAssetParser();
 
@@ -333,6 +344,17 @@ namespace minko
             bool
             complete(int currentLod) = 0;
 
+            /*
+            ** Releases the data of the LODs above lod and returns the new resident LOD, or
+            ** residentLod if nothing could be released.
+            */
+            virtual
+            int
+            lodEvicted(int residentLod, int lod)
+            {
+                return residentLod;
+            }
+
             virtual
             void
             completed() = 0;
@@ -29,6 +29,10 @@ namespace minko
         class CRNTranscoder
         {
         public:
+            static
+            bool
+            supportsFormat(render::TextureFormat format);
+
             static
             bool
             transcode(std::shared_ptr<render::AbstractTexture>  texture,
@@ -36,6 +40,36 @@ namespace minko
                       std::shared_ptr<WriterOptions>            writerOptions,
                       render::TextureFormat                     outFormat,
                       std::vector<unsigned char>&               out);
+
+            /*
+            ** Transcodes the texture to each of outFormats concurrently, sharing
+            ** writerOptions->numTranscodingThreads() between them. out[i] is left empty
+            ** when transcoding to outFormats[i] failed.
+            */
+            static
+            bool
+            transcode(std::shared_ptr<render::AbstractTexture>  texture,
+                      const std::string&                        textureType,
+                      std::shared_ptr<WriterOptions>            writerOptions,
+                      const std::vector<render::TextureFormat>& outFormats,
+                      std::vector<std::vector<unsigned char>>&  out);
+
+        private:
+            static
+            bool
+            transcode(std::shared_ptr<render::AbstractTexture>  texture,
+                      const std::string&                        textureType,
+                      std::shared_ptr<WriterOptions>            writerOptions,
+                      render::TextureFormat                     outFormat,
+                      unsigned int                              numHelperThreads,
+                      std::vector<unsigned char>&               out);
+
+            static
+            std::string
+            cacheFilename(std::shared_ptr<render::AbstractTexture>  texture,
+                          const std::string&                        textureType,
+                          std::shared_ptr<WriterOptions>            writerOptions,
+                          render::TextureFormat                     outFormat);
         };
     }
 }
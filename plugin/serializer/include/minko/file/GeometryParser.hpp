@@ -40,6 +40,7 @@ namespace minko
         private:
             typedef unsigned char                                                                    uchar;
             typedef msgpack::type::tuple<std::string, uchar, uchar>                                  SerializeAttribute;
+            typedef msgpack::type::tuple<std::string, uchar, uchar, uchar>                           SerializePackedAttribute;
             typedef msgpack::type::tuple<uchar, std::string, std::string, std::vector<std::string>>  SerializedGeometry;
 
         private:
@@ -84,8 +85,13 @@ namespace minko
                                    AbstractContextPtr    context)
             {
                 auto vector = deserialize::TypeDeserializer::deserializeVector<T>(serializedIndexBuffer);
+                auto indexBuffer = render::IndexBuffer::create(context, vector);
 
-                return render::IndexBuffer::create(context, vector);
+                // 32-bit index buffers are not uploaded on creation
+                if (!indexBuffer->isReady())
+                    indexBuffer->upload();
+
+                return indexBuffer;
             }
 
         private:
@@ -105,6 +111,11 @@ namespace minko
             deserializeVertexBuffer(std::string&        serializedVertexBuffer,
                                     AbstractContextPtr  context);
 
+            static
+            VertexBufferPtr
+            deserializePackedVertexBuffer(std::string&          serializedVertexBuffer,
+                                          AbstractContextPtr    context);
+
 
             static
             IndexBufferPtr
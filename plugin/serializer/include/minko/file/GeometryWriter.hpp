@@ -97,6 +97,10 @@ namespace minko
             bool
             indexBufferFitCharCompression(std::shared_ptr<geometry::Geometry> geometry);
 
+            static
+            render::VertexAttribute::Format
+            defaultVertexAttributeFormat(const render::VertexAttribute& attribute, const std::vector<float>& data);
+
         private:
 
             void
@@ -117,6 +121,15 @@ namespace minko
             std::string
             serializeVertexStream(std::shared_ptr<render::VertexBuffer> vertexBuffer);
 
+            static
+            std::string
+            serializePackedVertexStream(std::shared_ptr<render::VertexBuffer> vertexBuffer);
+
+            static
+            std::shared_ptr<geometry::Geometry>
+            quantizeVertexAttributes(std::shared_ptr<geometry::Geometry>                     geometry,
+                                     const WriterOptions::VertexAttributeFormatFunction&     formatFunction);
+
             GeometryWriter()
             {
                 initialize();
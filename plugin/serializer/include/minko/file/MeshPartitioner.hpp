@@ -55,6 +55,8 @@ namespace minko
                 static const unsigned int mergeSurfaces                     = 1 << 0;
                 static const unsigned int createOneNodePerSurface           = 1 << 1;
                 static const unsigned int applyCrackFreePolicy              = 1 << 2;
+                static const unsigned int outOfCore                         = 1 << 3;
+                static const unsigned int allowUnsignedIntIndices           = 1 << 4;
 
                 static const unsigned int all                               = mergeSurfaces |
                                                                               createOneNodePerSurface |
@@ -68,6 +70,10 @@ namespace minko
 
                 unsigned int                                                flags;
 
+                std::size_t                                                 outOfCoreMemoryBudget;
+                int                                                         outOfCoreMaxCellDepth;
+                std::string                                                 outOfCoreTemporaryDirectory;
+
                 std::function<math::vec3(Options&, NodeSetPtr)>             partitionMaxSizeFunction;
 
                 std::function<void(NodeSetPtr, math::vec3&, math::vec3&)>   worldBoundsFunction;
@@ -167,6 +173,20 @@ namespace minko
                 ~PartitionInfo() = default;
             };
 
+            struct OutOfCoreCell
+            {
+                std::string                 filename;
+
+                int                         depth;
+
+                math::vec3                  minBound;
+                math::vec3                  maxBound;
+
+                unsigned int                numTriangles;
+            };
+
+            typedef std::shared_ptr<math::UnorderedSpatialIndex<bool>> ProtectedPositionIndexPtr;
+
         private:
             Options                                                     _options;
             std::shared_ptr<StreamingOptions>                           _streamingOptions;
@@ -183,6 +203,8 @@ namespace minko
             float                                                       _progressRate;
             StatusChangedSignal::Ptr                                    _statusChanged;
 
+            unsigned int                                                _numOutOfCoreCells;
+
         public:
             ~MeshPartitioner() = default;
 
@@ -269,7 +291,7 @@ namespace minko
 
             void
             markProtectedVertices(GeometryPtr                                               geometry,
-                                  const std::unordered_map<unsigned short, unsigned int>&   indices,
+                                  const std::unordered_map<unsigned int, unsigned int>&     indices,
                                   PartitionInfo&                                            partitionInfo);
 
             std::vector<std::vector<SurfacePtr>>
@@ -299,6 +321,39 @@ namespace minko
                             PartitionInfo&              partitionInfo,
                             std::vector<GeometryPtr>&   geometries);
 
+            bool
+            buildOutOfCoreGeometries(NodePtr                    node,
+                                     PartitionInfo&             partitionInfo,
+                                     std::vector<GeometryPtr>&  geometries);
+
+            void
+            binSurfaces(PartitionInfo&              partitionInfo,
+                        std::vector<OutOfCoreCell>& cells,
+                        ProtectedPositionIndexPtr   protectedPositions);
+
+            void
+            binCell(const OutOfCoreCell&        cell,
+                    unsigned int                vertexSize,
+                    unsigned int                positionAttributeOffset,
+                    std::vector<OutOfCoreCell>& cells,
+                    ProtectedPositionIndexPtr   protectedPositions);
+
+            bool
+            processOutOfCoreCell(NodePtr                    node,
+                                 const OutOfCoreCell&       cell,
+                                 PartitionInfo&             partitionInfo,
+                                 ProtectedPositionIndexPtr  protectedPositions,
+                                 std::vector<GeometryPtr>&  geometries);
+
+            std::size_t
+            outOfCoreTriangleCost(unsigned int vertexSize) const;
+
+            std::size_t
+            outOfCoreCellMemoryBudget(ProtectedPositionIndexPtr protectedPositions) const;
+
+            std::string
+            outOfCoreCellFilename();
+
             bool
             patchNode(NodePtr                           node,
                       PartitionInfo&                    partitionInfo,
@@ -320,6 +375,9 @@ namespace minko
             int
             countTriangles(OctreeNodePtr partitionNode);
 
+            int
+            maxNumIndicesPerNode() const;
+
             static
             math::vec3
             positionAt(unsigned int         index,
@@ -0,0 +1,202 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/Hash.hpp"
+#include "minko/SerializerCommon.hpp"
+#include "minko/StreamingCommon.hpp"
+
+namespace minko
+{
+    namespace file
+    {
+        class MeshSimplifier :
+            public std::enable_shared_from_this<MeshSimplifier>
+        {
+        public:
+            typedef std::shared_ptr<MeshSimplifier>     Ptr;
+
+            typedef std::shared_ptr<geometry::Geometry> GeometryPtr;
+
+            struct Options
+            {
+                int             numLods;
+                float           reductionRate;
+                unsigned int    minNumTriangles;
+
+                float           maxError;
+
+                float           attributeWeight;
+                float           borderWeight;
+                float           maxNormalDeviation;
+
+                bool            lockBorders;
+
+                Options();
+            };
+
+            struct Lod
+            {
+                std::vector<unsigned int>   indices;
+                float                       error;
+            };
+
+        private:
+            struct Quadric
+            {
+                double a2, ab, ac, ad;
+                double     b2, bc, bd;
+                double         c2, cd;
+                double             d2;
+
+                Quadric();
+
+                Quadric(double a, double b, double c, double d, double weight);
+
+                Quadric&
+                operator+=(const Quadric& other);
+
+                double
+                evaluate(const math::vec3& position) const;
+            };
+
+            struct Collapse
+            {
+                double          cost;
+                double          error;
+
+                unsigned int    source;
+                unsigned int    target;
+
+                unsigned int    sourceVersion;
+                unsigned int    targetVersion;
+
+                bool
+                operator<(const Collapse& other) const
+                {
+                    return cost > other.cost;
+                }
+            };
+
+            struct SimplificationInfo
+            {
+                unsigned int                            vertexSize;
+                unsigned int                            positionAttributeOffset;
+
+                std::vector<math::vec3>                 positions;
+                const std::vector<float>*               vertices;
+
+                std::vector<Quadric>                    quadrics;
+                std::vector<Quadric>                    surfaceQuadrics;
+                std::vector<unsigned int>               versions;
+                std::vector<bool>                       removedVertices;
+                std::vector<bool>                       lockedVertices;
+                std::vector<bool>                       borderVertices;
+
+                std::vector<std::array<unsigned int, 3>> triangles;
+                std::vector<bool>                       removedTriangles;
+                std::vector<std::vector<unsigned int>>  vertexTriangles;
+
+                std::unordered_set<
+                    std::pair<unsigned int, unsigned int>,
+                    minko::Hash<std::pair<unsigned int, unsigned int>>
+                >                                       borderEdges;
+
+                std::priority_queue<Collapse>           collapses;
+
+                unsigned int                            numTriangles;
+                double                                  maxError;
+            };
+
+        private:
+            Options _options;
+
+        public:
+            ~MeshSimplifier() = default;
+
+            inline
+            static
+            Ptr
+            create(const Options& options = Options())
+            {
+                auto instance = Ptr(new MeshSimplifier());
+
+                instance->_options = options;
+
+                return instance;
+            }
+
+            inline
+            const Options&
+            options() const
+            {
+                return _options;
+            }
+
+            void
+            buildLods(GeometryPtr geometry, std::vector<Lod>& lods);
+
+            void
+            buildLods(const std::vector<unsigned int>&  indices,
+                      const std::vector<float>&         vertices,
+                      unsigned int                      vertexSize,
+                      unsigned int                      positionAttributeOffset,
+                      const std::vector<bool>&          lockedVertices,
+                      std::vector<Lod>&                 lods);
+
+        private:
+            MeshSimplifier() = default;
+
+            void
+            initialize(const std::vector<unsigned int>&  indices,
+                       SimplificationInfo&               info);
+
+            void
+            pushCollapse(unsigned int           source,
+                         unsigned int           target,
+                         SimplificationInfo&    info);
+
+            bool
+            collapseIsValid(unsigned int        source,
+                            unsigned int        target,
+                            SimplificationInfo& info) const;
+
+            void
+            collapse(unsigned int           source,
+                     unsigned int           target,
+                     SimplificationInfo&    info);
+
+            double
+            attributeError(unsigned int                 source,
+                           unsigned int                 target,
+                           const SimplificationInfo&    info) const;
+
+            void
+            simplify(unsigned int           targetNumTriangles,
+                     SimplificationInfo&    info);
+
+            static
+            void
+            extractIndices(const SimplificationInfo&    info,
+                           std::vector<unsigned int>&   indices);
+        };
+    }
+}
@@ -78,6 +78,8 @@ namespace minko
             int                                                                         _minBorderPrecision;
             int                                                                         _maxDeltaBorderPrecision;
 
+            bool                                                                        _simplifiedLods;
+
             int                                                                         _vertexSize;
             int                                                                         _numVertexBuffers;
             std::vector<msgpack::type::tuple<
@@ -143,6 +145,9 @@ namespace minko
             void
             completed() override;
 
+            int
+            lodEvicted(int residentLod, int lod) override;
+
             void
             lodRangeFetchingBound(int  currentLod,
                                   int  requiredLod,
@@ -175,6 +180,19 @@ namespace minko
             createPOPGeometry(std::shared_ptr<AssetLibrary> assetLibrary,
                               std::shared_ptr<Options>      options,
                               const std::string&            fileName);
+
+            void
+            updateResidentMemory();
+
+            template <typename T, typename U>
+            static
+            bool
+            copyLodData(std::vector<T>& bufferData, const std::vector<U>& lodData, std::size_t offset);
+
+            template <typename T>
+            static
+            void
+            shrinkLodData(std::vector<T>& bufferData, std::size_t size);
         };
     }
 }
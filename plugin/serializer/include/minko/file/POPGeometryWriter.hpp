@@ -112,6 +112,8 @@ namespace minko
             math::vec3                          _minBound;
             math::vec3                          _maxBound;
 
+            bool                                _simplifiedLods;
+
             RangeFunction                       _rangeFunction;
 
         public:
@@ -174,6 +176,15 @@ namespace minko
                          int                     minLevel,
                          int                     maxLevel);
 
+            void
+            buildSimplifiedLodData(std::map<int, LodData>&  lodData,
+                                   const math::vec3&        boxSize);
+
+            void
+            buildOrderedLodData(const std::map<int, std::vector<unsigned short>>&   orderedBufferMap,
+                                const std::unordered_map<int, int>&                 levelToPrecisionLevelMap,
+                                std::map<int, LodData>&                             lodData);
+
             void
             serializeGeometry(std::shared_ptr<Dependency>       dependency,
                               std::shared_ptr<WriterOptions>    writerOptions,
@@ -49,6 +49,7 @@ namespace minko
 
         private:
             std::shared_ptr<render::AbstractTexture>                _texture;
+            uint                                                    _numPendingUploads;
 
             render::TextureType                                     _textureType;
             render::TextureFormat                                   _textureFormat;
@@ -92,12 +93,20 @@ namespace minko
                       const std::vector<unsigned char>&  data,
                       std::shared_ptr<Options>           options) override;
 
+            void
+            uploadMipLevel(int                          mipLevel,
+                           unsigned char*               mipLevelData,
+                           std::shared_ptr<Options>     options);
+
             bool
             complete(int currentLod) override;
 
             void
             completed() override;
 
+            int
+            lodEvicted(int residentLod, int lod) override;
+
             void
             lodRangeFetchingBound(int  currentLod,
                                   int  requiredLod,
@@ -140,6 +149,9 @@ namespace minko
 
             int
             lodRangeRequestSize(int lowerLod, int upperLod) const;
+
+            void
+            updateResidentMemory(int residentLod);
         };
     }
 }
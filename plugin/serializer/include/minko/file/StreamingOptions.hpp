@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/MasterLodScheduler.hpp"
 #include "minko/data/Provider.hpp"
 #include "minko/file/MeshPartitioner.hpp"
+#include "minko/file/MeshSimplifier.hpp"
 #include "minko/file/POPGeometryWriter.hpp"
 #include "minko/file/SurfaceOperator.hpp"
 
@@ -66,6 +67,12 @@ namespace minko
                 SurfacePtr
             )>                                                      PopGeometryErrorFunction;
 
+            typedef std::function<float(
+                int,
+                int,
+                std::size_t
+            )>                                                      LodEvictionPriorityFunction;
+
         private:
             typedef std::shared_ptr<scene::Node>                    NodePtr;
             typedef std::shared_ptr<file::AbstractWriter<NodePtr>>  SceneWriter;
@@ -98,11 +105,15 @@ namespace minko
 
             LodPriorityFunction                                     _popGeometryLodPriorityFunction;
             LodPriorityFunction                                     _streamedTextureLodPriorityFunction;
+            bool                                                    _popGeometryLodPriorityFunctionIsDefault;
 
             PopGeometryErrorFunction                                _popGeometryErrorFunction;
 
             file::MeshPartitioner::Options                          _meshPartitionerOptions;
 
+            bool                                                    _popGeometrySimplificationEnabled;
+            file::MeshSimplifier::Options                           _meshSimplifierOptions;
+
             float                                                   _popGeometryPriorityFactor;
             float                                                   _streamedTexturePriorityFactor;
 
@@ -117,6 +128,8 @@ namespace minko
             bool                                                    _popGeometryLodBlendingEnabled;
             float                                                   _popGeometryLodBlendingPeriod;
             int                                                     _popGeometryLodBlendingMinPrecisionLevel;
+            float                                                   _popGeometryPrefetchTime;
+            float                                                   _popGeometryPrefetchPriority;
             bool                                                    _streamedTextureLodBlendingEnabled;
             float                                                   _streamedTextureLodBlendingPeriod;
 
@@ -125,6 +138,9 @@ namespace minko
             bool                                                    _requestAbortingEnabled;
             float                                                   _abortableRequestProgressThreshold;
 
+            bool                                                    _lodEvictionEnabled;
+            LodEvictionPriorityFunction                             _lodEvictionPriorityFunction;
+
             POPGeometryFunction                                     _popGeometryFunction;
             StreamedTextureFunction                                 _streamedTextureFunction;
 
@@ -282,10 +298,22 @@ namespace minko
             popGeometryLodPriorityFunction(const LodPriorityFunction& function)
             {
                 _popGeometryLodPriorityFunction = function;
+                _popGeometryLodPriorityFunctionIsDefault = false;
 
                 return shared_from_this();
             }
 
+            /*
+            ** False once popGeometryLodPriorityFunction() was replaced, the default function
+            ** only depends on the active and required LODs.
+            */
+            inline
+            bool
+            popGeometryLodPriorityFunctionIsDefault() const
+            {
+                return _popGeometryLodPriorityFunctionIsDefault;
+            }
+
             inline
             const LodPriorityFunction&
             streamedTextureLodPriorityFunction() const
@@ -334,6 +362,38 @@ namespace minko
                 return shared_from_this();
             }
 
+            inline
+            bool
+            popGeometrySimplificationEnabled() const
+            {
+                return _popGeometrySimplificationEnabled;
+            }
+
+            inline
+            Ptr
+            popGeometrySimplificationEnabled(bool value)
+            {
+                _popGeometrySimplificationEnabled = value;
+
+                return shared_from_this();
+            }
+
+            inline
+            const file::MeshSimplifier::Options&
+            meshSimplifierOptions() const
+            {
+                return _meshSimplifierOptions;
+            }
+
+            inline
+            Ptr
+            meshSimplifierOptions(const file::MeshSimplifier::Options& value)
+            {
+                _meshSimplifierOptions = value;
+
+                return shared_from_this();
+            }
+
             inline
             float
             popGeometryPriorityFactor() const
@@ -494,6 +554,47 @@ namespace minko
                 return shared_from_this();
             }
 
+            /*
+            ** How far ahead in time, in milliseconds, the eye position is extrapolated to prefetch
+            ** the POP geometry LODs required at the predicted viewpoint. 0 disables prefetching.
+            */
+            inline
+            float
+            popGeometryPrefetchTime() const
+            {
+                return _popGeometryPrefetchTime;
+            }
+
+            inline
+            Ptr
+            popGeometryPrefetchTime(float value)
+            {
+                _popGeometryPrefetchTime = value;
+
+                return shared_from_this();
+            }
+
+            /*
+            ** Priority of the prefetching requests. It must remain below the priority of the LODs
+            ** actually required so that speculative requests are aborted first when
+            ** requestAbortingEnabled is set.
+            */
+            inline
+            float
+            popGeometryPrefetchPriority() const
+            {
+                return _popGeometryPrefetchPriority;
+            }
+
+            inline
+            Ptr
+            popGeometryPrefetchPriority(float value)
+            {
+                _popGeometryPrefetchPriority = value;
+
+                return shared_from_this();
+            }
+
             inline
             bool
             streamedTextureLodBlendingEnabled() const
@@ -574,6 +675,49 @@ namespace minko
                 return shared_from_this();
             }
 
+            /*
+            ** When enabled, streamed asset parsers stay alive once all their LODs are loaded so that
+            ** the MasterLodScheduler can downgrade them to coarser LODs and fetch the evicted LODs
+            ** again later. Enabled by MasterLodScheduler::memoryBudget().
+            */
+            inline
+            bool
+            lodEvictionEnabled() const
+            {
+                return _lodEvictionEnabled;
+            }
+
+            inline
+            Ptr
+            lodEvictionEnabled(bool value)
+            {
+                _lodEvictionEnabled = value;
+
+                return shared_from_this();
+            }
+
+            /*
+            ** Order in which the MasterLodScheduler evicts resources that are over their required
+            ** LOD when the memory budget is exceeded: the resources with the highest priority are
+            ** downgraded first. Arguments are the resident LOD, the required LOD and the number of
+            ** resident bytes of the resource.
+            */
+            inline
+            const LodEvictionPriorityFunction&
+            lodEvictionPriorityFunction() const
+            {
+                return _lodEvictionPriorityFunction;
+            }
+
+            inline
+            Ptr
+            lodEvictionPriorityFunction(const LodEvictionPriorityFunction& function)
+            {
+                _lodEvictionPriorityFunction = function;
+
+                return shared_from_this();
+            }
+
             inline
             const POPGeometryFunction&
             popGeometryFunction() const
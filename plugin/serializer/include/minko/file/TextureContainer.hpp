@@ -0,0 +1,166 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/SerializerCommon.hpp"
+#include "minko/render/TextureFormat.hpp"
+
+namespace minko
+{
+    namespace file
+    {
+        /*
+        ** GPU-ready texture container. A fixed-size big-endian header and a table of contents are
+        ** followed by the mip levels of each stored format, in the exact layout the GPU expects and
+        ** at aligned offsets, so that they can be fetched by byte range and uploaded without copy.
+        **
+        ** header:              magic (4) | version (2) | alignment (2) | width (4) | height (4)
+        **                      | num faces (1) | num mip levels (1) | num formats (2)
+        ** table of contents:   for each format: format (4) | for each level, for each face: offset (4) | size (4)
+        */
+        class TextureContainer :
+            public std::enable_shared_from_this<TextureContainer>
+        {
+        public:
+            typedef std::shared_ptr<TextureContainer> Ptr;
+
+            struct MipLevel
+            {
+                uint offset;
+                uint size;
+            };
+
+            static const uint MAGIC_NUMBER;
+            static const uint VERSION;
+            static const uint HEADER_SIZE;
+            static const uint ALIGNMENT;
+
+        private:
+            uint                                                            _width;
+            uint                                                            _height;
+            uint                                                            _numFaces;
+            uint                                                            _numMipLevels;
+            std::vector<render::TextureFormat>                              _formats;
+            std::vector<std::vector<MipLevel>>                              _mipLevels;
+
+        public:
+            inline static
+            Ptr
+            create(uint width, uint height, uint numFaces, uint numMipLevels)
+            {
+                return Ptr(new TextureContainer(width, height, numFaces, numMipLevels));
+            }
+
+            /*
+            ** Reads the header and the table of contents at the beginning of data, or returns nullptr if
+            ** data does not start with a valid container header or is too short to hold its table of contents.
+            */
+            static
+            Ptr
+            read(const unsigned char* data, uint size);
+
+            /*
+            ** Size of the header and of the table of contents, read from the first HEADER_SIZE bytes of
+            ** a container. Returns 0 if they are not a valid container header.
+            */
+            static
+            uint
+            tableOfContentsSize(const unsigned char* header, uint size);
+
+            /*
+            ** Writes a container holding one mip chain per format. Each chain stores its levels from the
+            ** largest to the smallest and, for cube textures, the faces of each level one after the other.
+            */
+            static
+            void
+            write(uint                                                                          width,
+                  uint                                                                          height,
+                  uint                                                                          numFaces,
+                  uint                                                                          numMipLevels,
+                  const std::vector<std::pair<render::TextureFormat, std::vector<unsigned char>>>&  mipChains,
+                  std::vector<unsigned char>&                                                   out);
+
+            inline
+            uint
+            width() const
+            {
+                return _width;
+            }
+
+            inline
+            uint
+            height() const
+            {
+                return _height;
+            }
+
+            inline
+            uint
+            numFaces() const
+            {
+                return _numFaces;
+            }
+
+            inline
+            uint
+            numMipLevels() const
+            {
+                return _numMipLevels;
+            }
+
+            inline
+            const std::vector<render::TextureFormat>&
+            formats() const
+            {
+                return _formats;
+            }
+
+            bool
+            hasFormat(render::TextureFormat format) const;
+
+            const MipLevel&
+            mipLevel(render::TextureFormat format, uint level, uint face = 0) const;
+
+            /*
+            ** Contiguous byte range holding the levels from firstLevel to lastLevel of format, for all faces.
+            */
+            void
+            mipLevelsRange(render::TextureFormat format, uint firstLevel, uint lastLevel, uint& offset, uint& size) const;
+
+            inline
+            void
+            formatRange(render::TextureFormat format, uint& offset, uint& size) const
+            {
+                mipLevelsRange(format, 0u, _numMipLevels - 1u, offset, size);
+            }
+
+        private:
+            TextureContainer(uint width, uint height, uint numFaces, uint numMipLevels);
+
+            uint
+            formatIndex(render::TextureFormat format) const;
+
+            static
+            uint
+            align(uint offset);
+        };
+    }
+}
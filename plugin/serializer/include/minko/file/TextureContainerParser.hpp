@@ -0,0 +1,99 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/SerializerCommon.hpp"
+#include "minko/file/AbstractParser.hpp"
+#include "minko/render/TextureFormat.hpp"
+
+namespace minko
+{
+    namespace file
+    {
+        /*
+        ** Parses TextureContainer files. The format is picked among the ones both the container and the
+        ** context support, and its mip levels are uploaded straight from the file buffer. When the loaded
+        ** data does not hold them - for instance when only the first TextureContainer::HEADER_SIZE bytes
+        ** were requested with Options::seekedLength() - the table of contents and the mip levels of the
+        ** chosen format are fetched by byte range.
+        */
+        class TextureContainerParser :
+            public AbstractParser
+        {
+        public:
+            typedef std::shared_ptr<TextureContainerParser> Ptr;
+
+        private:
+            typedef std::shared_ptr<Options>                    OptionsPtr;
+            typedef std::shared_ptr<AssetLibrary>               AssetLibraryPtr;
+            typedef std::shared_ptr<TextureContainer>           TextureContainerPtr;
+            typedef std::shared_ptr<render::AbstractTexture>    AbstractTexturePtr;
+
+        public:
+            inline static
+            Ptr
+            create()
+            {
+                return std::shared_ptr<TextureContainerParser>(new TextureContainerParser());
+            }
+
+            void
+            parse(const std::string&                filename,
+                  const std::string&                resolvedFilename,
+                  OptionsPtr                        options,
+                  const std::vector<unsigned char>& data,
+                  AssetLibraryPtr                   assetLibrary) override;
+
+        private:
+            TextureContainerParser()
+            {
+            }
+
+            bool
+            fetch(const std::string&            filename,
+                  OptionsPtr                    options,
+                  uint                          offset,
+                  uint                          size,
+                  std::vector<unsigned char>&   data);
+
+            bool
+            selectFormat(TextureContainerPtr container, OptionsPtr options, render::TextureFormat& format);
+
+            AbstractTexturePtr
+            createTexture(const std::string&        filename,
+                          TextureContainerPtr       container,
+                          render::TextureFormat     format,
+                          uint                      numMipLevels,
+                          OptionsPtr                options,
+                          const unsigned char*      data,
+                          uint                      dataOffset);
+
+            static
+            void
+            uploadMipLevels(AbstractTexturePtr      texture,
+                            TextureContainerPtr     container,
+                            render::TextureFormat   format,
+                            uint                    numMipLevels,
+                            const unsigned char*    data,
+                            uint                    dataOffset);
+        };
+    }
+}
@@ -108,6 +108,17 @@ namespace minko
                   WriterOptionsPtr              writerOptions,
                   std::vector<unsigned char>&   embeddedHeaderData);
 
+            /*
+            ** Writes a 2D texture as a TextureContainer holding the raw mip levels of each format requested
+            ** by writerOptions, to be loaded with TextureContainerParser without any decoding.
+            */
+            static
+            bool
+            writeContainer(std::shared_ptr<render::AbstractTexture>    texture,
+                           const std::string&                          textureType,
+                           std::shared_ptr<WriterOptions>              writerOptions,
+                           std::vector<unsigned char>&                 out);
+
             static
             void
             ensureTextureSizeIsValid(std::shared_ptr<render::AbstractTexture>   texture,
@@ -0,0 +1,235 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/SerializerCommon.hpp"
+#include "minko/file/AbstractWriterPreprocessor.hpp"
+
+namespace minko
+{
+    namespace file
+    {
+        class VertexCacheOptimizer :
+            public AbstractWriterPreprocessor<std::shared_ptr<scene::Node>>
+        {
+        public:
+            typedef std::shared_ptr<VertexCacheOptimizer>   Ptr;
+
+            typedef std::shared_ptr<scene::Node>            NodePtr;
+
+            typedef std::function<bool(NodePtr)>            NodePredicateFunction;
+
+            struct Statistics
+            {
+                unsigned int    numTriangles;
+                unsigned int    numVertices;
+                unsigned int    numTransformedVerticesBefore;
+                unsigned int    numTransformedVerticesAfter;
+
+                Statistics() :
+                    numTriangles(0u),
+                    numVertices(0u),
+                    numTransformedVerticesBefore(0u),
+                    numTransformedVerticesAfter(0u)
+                {
+                }
+
+                inline
+                float
+                acmrBefore() const
+                {
+                    return numTriangles > 0u ? float(numTransformedVerticesBefore) / numTriangles : 0.f;
+                }
+
+                inline
+                float
+                acmrAfter() const
+                {
+                    return numTriangles > 0u ? float(numTransformedVerticesAfter) / numTriangles : 0.f;
+                }
+
+                inline
+                float
+                atvrBefore() const
+                {
+                    return numVertices > 0u ? float(numTransformedVerticesBefore) / numVertices : 0.f;
+                }
+
+                inline
+                float
+                atvrAfter() const
+                {
+                    return numVertices > 0u ? float(numTransformedVerticesAfter) / numVertices : 0.f;
+                }
+            };
+
+        private:
+            typedef std::shared_ptr<AssetLibrary>           AssetLibraryPtr;
+            typedef std::shared_ptr<component::Surface>     SurfacePtr;
+            typedef std::shared_ptr<geometry::Geometry>     GeometryPtr;
+
+        private:
+            static const unsigned int                       _maxScoredCacheSize;
+
+            StatusChangedSignal::Ptr                        _statusChanged;
+            float                                           _progressRate;
+
+            NodePredicateFunction                           _nodePredicateFunction;
+
+            unsigned int                                    _cacheSize;
+            float                                           _overdrawThreshold;
+            bool                                            _vertexReorderingEnabled;
+
+            Statistics                                      _statistics;
+
+            std::unordered_set<GeometryPtr>                 _optimizedGeometrySet;
+
+        public:
+            ~VertexCacheOptimizer() = default;
+
+            inline
+            static
+            Ptr
+            create()
+            {
+                auto instance = Ptr(new VertexCacheOptimizer());
+
+                return instance;
+            }
+
+            inline
+            const NodePredicateFunction&
+            nodePredicateFunction() const
+            {
+                return _nodePredicateFunction;
+            }
+
+            inline
+            Ptr
+            nodePredicateFunction(const NodePredicateFunction& func)
+            {
+                _nodePredicateFunction = func;
+
+                return std::static_pointer_cast<VertexCacheOptimizer>(shared_from_this());
+            }
+
+            inline
+            unsigned int
+            cacheSize() const
+            {
+                return _cacheSize;
+            }
+
+            inline
+            Ptr
+            cacheSize(unsigned int value)
+            {
+                _cacheSize = value;
+
+                return std::static_pointer_cast<VertexCacheOptimizer>(shared_from_this());
+            }
+
+            inline
+            float
+            overdrawThreshold() const
+            {
+                return _overdrawThreshold;
+            }
+
+            inline
+            Ptr
+            overdrawThreshold(float value)
+            {
+                _overdrawThreshold = value;
+
+                return std::static_pointer_cast<VertexCacheOptimizer>(shared_from_this());
+            }
+
+            inline
+            bool
+            vertexReorderingEnabled() const
+            {
+                return _vertexReorderingEnabled;
+            }
+
+            inline
+            Ptr
+            vertexReorderingEnabled(bool value)
+            {
+                _vertexReorderingEnabled = value;
+
+                return std::static_pointer_cast<VertexCacheOptimizer>(shared_from_this());
+            }
+
+            inline
+            const Statistics&
+            statistics() const
+            {
+                return _statistics;
+            }
+
+            inline
+            float
+            progressRate() const override
+            {
+                return _progressRate;
+            }
+
+            inline
+            StatusChangedSignal::Ptr
+            statusChanged() override
+            {
+                return _statusChanged;
+            }
+
+            void
+            process(NodePtr& node, AssetLibraryPtr assetLibrary) override;
+
+            static
+            unsigned int
+            numTransformedVertices(const std::vector<unsigned int>& indices, unsigned int cacheSize);
+
+        private:
+            VertexCacheOptimizer();
+
+            bool
+            acceptsSurface(SurfacePtr surface);
+
+            void
+            optimizeSurfaceGeometry(SurfacePtr surface, AssetLibraryPtr assetLibrary);
+
+            void
+            optimizeVertexCache(std::vector<unsigned int>& indices, unsigned int numVertices);
+
+            void
+            optimizeOverdraw(std::vector<unsigned int>&     indices,
+                             const std::vector<float>&      positions);
+
+            void
+            reorderVertices(GeometryPtr                 geometry,
+                            std::vector<unsigned int>&  indices,
+                            AssetLibraryPtr             assetLibrary);
+
+            template <typename T>
+            std::shared_ptr<render::IndexBuffer>
+            createIndexBuffer(const std::vector<unsigned int>& indices, AssetLibraryPtr assetLibrary);
+        };
+    }
+}
@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Types.hpp"
 #include "minko/render/TextureFormat.hpp"
 #include "minko/render/TextureFormatInfo.hpp"
+#include "minko/render/VertexAttribute.hpp"
 
 namespace minko
 {
@@ -36,6 +37,11 @@ namespace minko
         public:
             typedef std::shared_ptr<WriterOptions>                              Ptr;
 
+            typedef std::function<render::VertexAttribute::Format(
+                const render::VertexAttribute&,
+                const std::vector<float>&
+            )>                                                                  VertexAttributeFormatFunction;
+
             struct EmbedMode
             {
                 static const unsigned int None;
@@ -114,8 +120,14 @@ namespace minko
 
             bool                                _writeAnimations;
 
+            bool                                _quantizeVertexAttributes;
+            VertexAttributeFormatFunction       _vertexAttributeFormatFunction;
+
             std::set<std::string>               _nullAssetUuids;
 
+            unsigned int                        _numTranscodingThreads;
+            std::string                         _transcodedTextureCacheDirectory;
+
         public:
             inline
             static
@@ -149,7 +161,11 @@ namespace minko
                 instance->_compressedTextureExceptions = other->_compressedTextureExceptions;
                 instance->_textureOptions = other->_textureOptions;
                 instance->_writeAnimations = other->_writeAnimations;
+                instance->_quantizeVertexAttributes = other->_quantizeVertexAttributes;
+                instance->_vertexAttributeFormatFunction = other->_vertexAttributeFormatFunction;
                 instance->_nullAssetUuids = other->_nullAssetUuids;
+                instance->_numTranscodingThreads = other->_numTranscodingThreads;
+                instance->_transcodedTextureCacheDirectory = other->_transcodedTextureCacheDirectory;
 
                 return instance;
             }
@@ -693,6 +709,38 @@ namespace minko
                 return shared_from_this();
             }
 
+            inline
+            bool
+            quantizeVertexAttributes() const
+            {
+                return _quantizeVertexAttributes;
+            }
+
+            inline
+            Ptr
+            quantizeVertexAttributes(bool value)
+            {
+                _quantizeVertexAttributes = value;
+
+                return shared_from_this();
+            }
+
+            inline
+            const VertexAttributeFormatFunction&
+            vertexAttributeFormatFunction() const
+            {
+                return _vertexAttributeFormatFunction;
+            }
+
+            inline
+            Ptr
+            vertexAttributeFormatFunction(const VertexAttributeFormatFunction& func)
+            {
+                _vertexAttributeFormatFunction = func;
+
+                return shared_from_this();
+            }
+
             inline
             std::set<std::string>&
             nullAssetUuids()
@@ -707,6 +755,46 @@ namespace minko
                 return _nullAssetUuids.find(uuid) != _nullAssetUuids.end();
             }
 
+            inline
+            unsigned int
+            numTranscodingThreads() const
+            {
+                return _numTranscodingThreads;
+            }
+
+            /**
+             * Maximum number of threads used to compress a texture, shared between the
+             * target formats being transcoded concurrently.
+             */
+            inline
+            Ptr
+            numTranscodingThreads(unsigned int value)
+            {
+                _numTranscodingThreads = std::max(1u, value);
+
+                return shared_from_this();
+            }
+
+            inline
+            const std::string&
+            transcodedTextureCacheDirectory() const
+            {
+                return _transcodedTextureCacheDirectory;
+            }
+
+            /**
+             * Directory where compressed textures are cached, keyed by a hash of their source
+             * data, compression options and target format. Disabled when empty.
+             */
+            inline
+            Ptr
+            transcodedTextureCacheDirectory(const std::string& value)
+            {
+                _transcodedTextureCacheDirectory = value;
+
+                return shared_from_this();
+            }
+
             /**
              * Specify writer options for the given texture type
              * The entry is created only if there is no existing options
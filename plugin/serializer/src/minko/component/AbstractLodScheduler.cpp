@@ -25,7 +25,6 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/data/Provider.hpp"
 #include "minko/data/Store.hpp"
 #include "minko/scene/Node.hpp"
-#include "minko/scene/NodeSet.hpp"
 
 using namespace minko;
 using namespace minko::component;
@@ -33,10 +32,22 @@ using namespace minko::data;
 using namespace minko::scene;
 
 const int AbstractLodScheduler::DEFAULT_LOD = 0;
+const float AbstractLodScheduler::EYE_VELOCITY_SMOOTHING = .5f;
 
 AbstractLodScheduler::AbstractLodScheduler() :
     AbstractComponent(),
+    _sceneManager(),
     _masterLodScheduler(),
+    _resources(),
+    _invalidResources(),
+    _eyePositionIsValid(false),
+    _eyePosition(),
+    _eyeTravelDistance(0.),
+    _eyeTravelInvalidations(),
+    _eyeVelocityIsValid(false),
+    _eyeVelocity(0.f),
+    _eyeVelocitySamplePosition(),
+    _eyeVelocitySampleTime(0.f),
     _sceneManagerFunction(),
     _rendererFunction(),
     _masterLodSchedulerFunction(),
@@ -45,8 +56,11 @@ AbstractLodScheduler::AbstractLodScheduler() :
     _componentAddedSlot(),
     _componentRemovedSlot(),
     _frameBeginSlot(),
+    _surfacesAddedSlot(),
+    _surfacesRemovedSlot(),
     _enabled(true),
-    _frameTime(0.f)
+    _frameTime(0.f),
+    _numLodEvaluations(0)
 {
 }
 
@@ -59,11 +73,9 @@ AbstractLodScheduler::defaultSceneManagerFunction(Node::Ptr node)
 AbstractComponent::Ptr
 AbstractLodScheduler::defaultRendererFunction(Node::Ptr node)
 {
-    auto rendererNodes = NodeSet::create(node->root())
-        ->descendants(true)
-        ->where([](Node::Ptr descendant) -> bool { return descendant->hasComponent<Renderer>(); });
+    auto renderers = node->root()->descendantComponents<Renderer>();
 
-    return rendererNodes->nodes().empty() ? nullptr : rendererNodes->nodes().front()->component<Renderer>();        
+    return renderers.empty() ? nullptr : renderers.front();
 }
 
 AbstractComponent::Ptr
@@ -126,6 +138,9 @@ AbstractLodScheduler::targetRemoved(Node::Ptr target)
 {
     _nodeAddedSlot = nullptr;
     _nodeRemovedSlot = nullptr;
+    _surfacesAddedSlot = nullptr;
+    _surfacesRemovedSlot = nullptr;
+    _sceneManager = nullptr;
 }
 
 AbstractLodScheduler::ResourceInfo&
@@ -150,19 +165,70 @@ AbstractLodScheduler::registerResource(Provider::Ptr data)
         }
     );
 
+    invalidateLodRequirement(insertedResource);
+
     return insertedResource;
 }
 
 void
 AbstractLodScheduler::unregisterResource(const std::string& uuid)
 {
-    _resources.erase(uuid);
+    auto resourceIt = _resources.find(uuid);
+
+    if (resourceIt == _resources.end())
+        return;
+
+    auto& resource = resourceIt->second;
+
+    cancelEyeTravelInvalidation(resource);
+
+    // while updated() evaluates them, invalid resources are not listed anymore but still flagged
+    if (resource.lodRequirementIsInvalid)
+    {
+        auto invalidResourceIt = std::find(_invalidResources.begin(), _invalidResources.end(), &resource);
+
+        if (invalidResourceIt != _invalidResources.end())
+            _invalidResources.erase(invalidResourceIt);
+    }
+
+    _resources.erase(resourceIt);
 }
 
 void
 AbstractLodScheduler::invalidateLodRequirement(ResourceInfo& resource)
 {
+    if (resource.lodRequirementIsInvalid)
+        return;
+
     resource.lodRequirementIsInvalid = true;
+
+    _invalidResources.push_back(&resource);
+}
+
+void
+AbstractLodScheduler::invalidateLodRequirementOnEyeTravel(ResourceInfo& resource, float distance)
+{
+    cancelEyeTravelInvalidation(resource);
+
+    if (std::isinf(distance))
+        return;
+
+    resource.eyeTravelInvalidationScheduled = true;
+    resource.eyeTravelInvalidationIt = _eyeTravelInvalidations.insert(std::make_pair(
+        _eyeTravelDistance + double(math::max(0.f, distance)),
+        &resource
+    ));
+}
+
+void
+AbstractLodScheduler::cancelEyeTravelInvalidation(ResourceInfo& resource)
+{
+    if (!resource.eyeTravelInvalidationScheduled)
+        return;
+
+    resource.eyeTravelInvalidationScheduled = false;
+
+    _eyeTravelInvalidations.erase(resource.eyeTravelInvalidationIt);
 }
 
 void
@@ -212,6 +278,22 @@ AbstractLodScheduler::viewPropertyChanged(const math::mat4&   worldToScreenMatri
                                           float               zNear,
                                           float               zFar)
 {
+    if (_eyePositionIsValid)
+        _eyeTravelDistance += double(math::distance(eyePosition, _eyePosition));
+
+    _eyePositionIsValid = true;
+    _eyePosition = eyePosition;
+
+    // the distance from the eye to any point cannot change more than the distance travelled by the eye
+    while (!_eyeTravelInvalidations.empty() && _eyeTravelInvalidations.begin()->first <= _eyeTravelDistance)
+    {
+        auto& resource = *_eyeTravelInvalidations.begin()->second;
+
+        resource.eyeTravelInvalidationScheduled = false;
+        _eyeTravelInvalidations.erase(_eyeTravelInvalidations.begin());
+
+        invalidateLodRequirement(resource);
+    }
 }
 
 void
@@ -219,13 +301,57 @@ AbstractLodScheduler::viewportChanged(const math::vec4& viewport)
 {
 }
 
+void
+AbstractLodScheduler::eyeVelocityChanged(const math::vec3& eyeVelocity)
+{
+}
+
+void
+AbstractLodScheduler::sampleEyeVelocity(float time)
+{
+    if (!_eyePositionIsValid)
+        return;
+
+    if (!_eyeVelocityIsValid)
+    {
+        _eyeVelocityIsValid = true;
+        _eyeVelocitySamplePosition = _eyePosition;
+        _eyeVelocitySampleTime = time;
+
+        return;
+    }
+
+    const auto deltaTime = time - _eyeVelocitySampleTime;
+
+    if (deltaTime <= 0.f)
+        return;
+
+    const auto previousEyeVelocity = _eyeVelocity;
+
+    _eyeVelocity = math::mix(
+        _eyeVelocity,
+        (_eyePosition - _eyeVelocitySamplePosition) / deltaTime,
+        EYE_VELOCITY_SMOOTHING
+    );
+
+    // the smoothed velocity never reaches zero by itself once the eye stops
+    if (math::length(_eyeVelocity) < 1e-6f)
+        _eyeVelocity = math::vec3(0.f);
+
+    _eyeVelocitySamplePosition = _eyePosition;
+    _eyeVelocitySampleTime = time;
+
+    if (_eyeVelocity != previousEyeVelocity)
+        eyeVelocityChanged(_eyeVelocity);
+}
+
 void
 AbstractLodScheduler::collectSurfaces()
 {
     while (!_removedSurfaces.empty())
     {
-        auto surface = _removedSurfaces.front();
-        _removedSurfaces.pop_front();
+        auto surface = *_removedSurfaces.begin();
+        _removedSurfaces.erase(_removedSurfaces.begin());
 
         surfaceRemoved(surface);
     }
@@ -234,8 +360,8 @@ AbstractLodScheduler::collectSurfaces()
     {
         while (!_addedSurfaces.empty())
         {
-            auto surface = _addedSurfaces.front();
-            _addedSurfaces.pop_front();
+            auto surface = *_addedSurfaces.begin();
+            _addedSurfaces.erase(_addedSurfaces.begin());
 
             surfaceAdded(surface);
         }
@@ -249,9 +375,42 @@ AbstractLodScheduler::sceneManagerSet(SceneManager::Ptr sceneManager)
     {
         _frameBeginSlot = nullptr;
         _rootNodePropertyChangedSlot = nullptr;
+        _surfacesAddedSlot = nullptr;
+        _surfacesRemovedSlot = nullptr;
+
+        if (_sceneManager != nullptr)
+        {
+            // the scene manager of the scene the surfaces were removed from does not report them
+            std::vector<SurfacePtr> surfaces;
+
+            for (const auto& surfaceAndSlot : _surfaceLayoutmaskChangedSlots)
+                surfaces.push_back(surfaceAndSlot.first);
+
+            surfacesRemovedHandler(_sceneManager, surfaces);
+        }
     }
     else
     {
+        if (sceneManager != _sceneManager)
+        {
+            _surfacesAddedSlot = sceneManager->surfacesAdded()->connect(std::bind(
+                &AbstractLodScheduler::surfacesAddedHandler,
+                std::static_pointer_cast<AbstractLodScheduler>(shared_from_this()),
+                std::placeholders::_1,
+                std::placeholders::_2
+            ));
+
+            _surfacesRemovedSlot = sceneManager->surfacesRemoved()->connect(std::bind(
+                &AbstractLodScheduler::surfacesRemovedHandler,
+                std::static_pointer_cast<AbstractLodScheduler>(shared_from_this()),
+                std::placeholders::_1,
+                std::placeholders::_2
+            ));
+
+            // the surfaces already in the scene are never reported by the scene manager
+            surfacesAddedHandler(sceneManager, target()->descendantComponents<Surface>());
+        }
+
         _frameBeginSlot = sceneManager->frameBegin()->connect(std::bind(
             &AbstractLodScheduler::frameBeginHandler,
             std::static_pointer_cast<AbstractLodScheduler>(shared_from_this()),
@@ -277,6 +436,8 @@ AbstractLodScheduler::sceneManagerSet(SceneManager::Ptr sceneManager)
             )
         );
     }
+
+    _sceneManager = sceneManager;
 }
 
 void
@@ -343,18 +504,6 @@ AbstractLodScheduler::nodeAddedHandler(Node::Ptr target, Node::Ptr node)
                 surfaceLayoutMaskInvalidated(surface);
         })
     );
-
-    auto meshNodes = NodeSet::create(node)
-        ->descendants(true)
-        ->where([](Node::Ptr descendant) -> bool { return descendant->hasComponent<Surface>(); });
-
-    for (auto meshNode : meshNodes->nodes())
-        for (auto surface : meshNode->components<Surface>())
-        {
-            watchSurface(surface);
-
-            addPendingSurface(surface);
-        }
 }
 
 void
@@ -372,13 +521,6 @@ AbstractLodScheduler::nodeRemovedHandler(Node::Ptr target, Node::Ptr node)
     );
 
     _nodeLayoutChangedSlots.erase(node);
-
-    for (auto surface : node->components<Surface>())
-    {
-        unwatchSurface(surface);
-
-        removePendingSurface(surface);
-    }
 }
 
 void
@@ -398,16 +540,6 @@ AbstractLodScheduler::componentAddedHandler(Node::Ptr target, AbstractComponent:
 
     if (masterLodScheduler != nullptr)
         masterLodSchedulerSet(std::static_pointer_cast<MasterLodScheduler>(masterLodSchedulerFunction()(target)));
-
-    auto surface = std::dynamic_pointer_cast<Surface>(component);
-
-    if (surface != nullptr)
-    {
-        watchSurface(surface);
-
-        if (checkSurfaceLayout(surface))
-            addPendingSurface(surface);
-    }
 }
 
 void
@@ -427,11 +559,37 @@ AbstractLodScheduler::componentRemovedHandler(Node::Ptr target, AbstractComponen
 
     if (masterLodScheduler != nullptr)
         masterLodSchedulerSet(std::static_pointer_cast<MasterLodScheduler>(masterLodSchedulerFunction()(nullptr)));
+}
+
+void
+AbstractLodScheduler::surfacesAddedHandler(SceneManager::Ptr sceneManager, const std::vector<Surface::Ptr>& surfaces)
+{
+    for (const auto& surface : surfaces)
+    {
+        // only the surfaces within the subtree of the target are scheduled
+        auto node = surface->target();
 
-    auto surface = std::dynamic_pointer_cast<Surface>(component);
+        while (node != nullptr && node != target())
+            node = node->parent();
+
+        if (node == nullptr)
+            continue;
+
+        watchSurface(surface);
+
+        if (checkSurfaceLayout(surface))
+            addPendingSurface(surface);
+    }
+}
 
-    if (surface != nullptr)
+void
+AbstractLodScheduler::surfacesRemovedHandler(SceneManager::Ptr sceneManager, const std::vector<Surface::Ptr>& surfaces)
+{
+    for (const auto& surface : surfaces)
     {
+        if (_surfaceLayoutmaskChangedSlots.count(surface) == 0)
+            continue;
+
         unwatchSurface(surface);
 
         removePendingSurface(surface);
@@ -454,15 +612,20 @@ AbstractLodScheduler::updated(float time)
 {
     collectSurfaces();
 
-    for (auto& uuidToResourcePair : _resources)
-    {
-        auto& resource = uuidToResourcePair.second;
+    sampleEyeVelocity(time);
 
-        if (!resource.lodRequirementIsInvalid)
-            continue;
+    auto invalidResources = std::vector<ResourceInfo*>();
+
+    invalidResources.swap(_invalidResources);
+
+    for (auto* resourcePtr : invalidResources)
+    {
+        auto& resource = *resourcePtr;
 
         resource.lodRequirementIsInvalid = false;
 
+        ++_numLodEvaluations;
+
         const auto lodInfo = this->lodInfo(resource, time);
 
         if (!resource.lodInfo.equals(lodInfo))
@@ -474,6 +637,9 @@ AbstractLodScheduler::updated(float time)
             lodInfoChanged(resource, previousLodInfo, lodInfo);
         }
     }
+
+    if (_masterLodScheduler)
+        _masterLodScheduler->enforceMemoryBudget();
 }
 
 void
@@ -568,25 +734,13 @@ AbstractLodScheduler::unwatchSurface(Surface::Ptr surface)
 void
 AbstractLodScheduler::addPendingSurface(Surface::Ptr surface)
 {
-    auto addedSurfaceIt = std::find(_addedSurfaces.begin(), _addedSurfaces.end(), surface);
-    auto removedSurfaceIt = std::find(_removedSurfaces.begin(), _removedSurfaces.end(), surface);
-
-    if (removedSurfaceIt != _removedSurfaces.end())
-        _removedSurfaces.erase(removedSurfaceIt);
-
-    if (addedSurfaceIt == _addedSurfaces.end())
-        _addedSurfaces.push_back(surface);
+    _removedSurfaces.erase(surface);
+    _addedSurfaces.insert(surface);
 }
 
 void
 AbstractLodScheduler::removePendingSurface(Surface::Ptr surface)
 {
-    auto addedSurfaceIt = std::find(_addedSurfaces.begin(), _addedSurfaces.end(), surface);
-    auto removedSurfaceIt = std::find(_removedSurfaces.begin(), _removedSurfaces.end(), surface);
-
-    if (addedSurfaceIt != _addedSurfaces.end())
-        _addedSurfaces.erase(addedSurfaceIt);
-
-    if (removedSurfaceIt == _removedSurfaces.end())
-        _removedSurfaces.push_back(surface);
+    _addedSurfaces.erase(surface);
+    _removedSurfaces.insert(surface);
 }
@@ -40,7 +40,13 @@ MasterLodScheduler::MasterLodScheduler() :
     _textureToDataMap(),
     _deferredTextureDataSet(),
     _deferredTextureRegistered(DeferredTextureRegisteredSignal::create()),
-    _deferredTextureReady(DeferredTextureReadySignal::create())
+    _deferredTextureReady(DeferredTextureReadySignal::create()),
+    _residentResources(),
+    _residentCpuMemory(0),
+    _residentGpuMemory(0),
+    _cpuMemoryBudget(0),
+    _gpuMemoryBudget(0),
+    _numLodEvictions(0)
 {
 }
 
@@ -70,13 +76,22 @@ MasterLodScheduler::registerGeometry(Geometry::Ptr geometry, Provider::Ptr data)
 {
     _geometryToDataMap.insert(std::make_pair(geometry, data));
 
+    watchResidentMemory(data);
+
     return std::static_pointer_cast<MasterLodScheduler>(shared_from_this());
 }
 
 void
 MasterLodScheduler::unregisterGeometry(Geometry::Ptr geometry)
 {
-    _geometryToDataMap.erase(geometry);
+    auto dataIt = _geometryToDataMap.find(geometry);
+
+    if (dataIt == _geometryToDataMap.end())
+        return;
+
+    unwatchResidentMemory(dataIt->second);
+
+    _geometryToDataMap.erase(dataIt);
 }
 
 Provider::Ptr
@@ -92,6 +107,8 @@ MasterLodScheduler::registerTexture(AbstractTexture::Ptr texture, Provider::Ptr
 {
     _textureToDataMap.insert(std::make_pair(texture, data));
 
+    watchResidentMemory(data);
+
     return std::static_pointer_cast<MasterLodScheduler>(shared_from_this());
 }
 
@@ -100,6 +117,8 @@ MasterLodScheduler::registerDeferredTexture(ProviderPtr data)
 {
     _deferredTextureDataSet.emplace(data);
 
+    watchResidentMemory(data);
+
     deferredTextureRegistered()->execute(
         std::static_pointer_cast<MasterLodScheduler>(shared_from_this()),
         data
@@ -128,7 +147,14 @@ MasterLodScheduler::deferredTextureReady(ProviderPtr
 void
 MasterLodScheduler::unregisterTexture(AbstractTexture::Ptr texture)
 {
-    _textureToDataMap.erase(texture);
+    auto dataIt = _textureToDataMap.find(texture);
+
+    if (dataIt == _textureToDataMap.end())
+        return;
+
+    unwatchResidentMemory(dataIt->second);
+
+    _textureToDataMap.erase(dataIt);
 }
 
 Provider::Ptr
@@ -139,6 +165,83 @@ MasterLodScheduler::textureData(AbstractTexture::Ptr texture)
     return dataIt != _textureToDataMap.end() ? dataIt->second : nullptr;
 }
 
+MasterLodScheduler::Ptr
+MasterLodScheduler::memoryBudget(std::size_t cpuBytes, std::size_t gpuBytes)
+{
+    _cpuMemoryBudget = cpuBytes;
+    _gpuMemoryBudget = gpuBytes;
+
+    if (_cpuMemoryBudget > 0 || _gpuMemoryBudget > 0)
+        _streamingOptions->lodEvictionEnabled(true);
+
+    return std::static_pointer_cast<MasterLodScheduler>(shared_from_this());
+}
+
+MasterLodScheduler::Ptr
+MasterLodScheduler::registerLodEviction(ProviderPtr data, LodEvictionFunction function)
+{
+    watchResidentMemory(data);
+
+    _residentResources.at(data).evictionFunction = function;
+
+    return std::static_pointer_cast<MasterLodScheduler>(shared_from_this());
+}
+
+void
+MasterLodScheduler::enforceMemoryBudget()
+{
+    if (!overMemoryBudget())
+        return;
+
+    const auto& evictionPriorityFunction = _streamingOptions->lodEvictionPriorityFunction();
+
+    auto candidates = std::vector<std::tuple<float, ProviderPtr, int>>();
+
+    for (const auto& dataToResourcePair : _residentResources)
+    {
+        auto data = dataToResourcePair.first;
+        const auto& resource = dataToResourcePair.second;
+
+        if (!resource.evictionFunction || !data->hasProperty("maxAvailableLod"))
+            continue;
+
+        // only the LODs nobody requires are evicted, any other LOD would be fetched again
+        // as soon as it is evicted
+        const auto residentLod = data->get<int>("maxAvailableLod");
+        const auto requiredLod = data->hasProperty("requiredLod") ? data->get<int>("requiredLod") : 0;
+
+        if (residentLod <= requiredLod)
+            continue;
+
+        candidates.emplace_back(
+            evictionPriorityFunction(residentLod, requiredLod, resource.cpuMemory + resource.gpuMemory),
+            data,
+            requiredLod
+        );
+    }
+
+    std::sort(
+        candidates.begin(),
+        candidates.end(),
+        [](const std::tuple<float, ProviderPtr, int>& left, const std::tuple<float, ProviderPtr, int>& right) -> bool
+        {
+            return std::get<0>(left) > std::get<0>(right);
+        }
+    );
+
+    for (const auto& candidate : candidates)
+    {
+        auto evictionFunction = _residentResources.at(std::get<1>(candidate)).evictionFunction;
+
+        evictionFunction(std::get<2>(candidate));
+
+        ++_numLodEvictions;
+
+        if (!overMemoryBudget())
+            break;
+    }
+}
+
 void
 MasterLodScheduler::layoutMask(scene::Layout value)
 {
@@ -244,3 +347,72 @@ MasterLodScheduler::removeLodScheduler(AbstractLodScheduler::Ptr lodScheduler)
         _lodSchedulers.end()
     );
 }
+
+void
+MasterLodScheduler::watchResidentMemory(ProviderPtr data)
+{
+    if (_residentResources.count(data) != 0)
+        return;
+
+    auto& resource = _residentResources[data];
+
+    // the providers can outlive the scheduler, their slots must not extend its lifetime
+    auto masterLodScheduler = std::weak_ptr<MasterLodScheduler>(
+        std::static_pointer_cast<MasterLodScheduler>(shared_from_this())
+    );
+
+    resource.propertyChangedSlot = data->propertyChanged().connect(
+        [masterLodScheduler](ProviderPtr                          provider,
+                             const data::Provider::PropertyName&  propertyName)
+        {
+            if (*propertyName != "residentCpuMemory" && *propertyName != "residentGpuMemory")
+                return;
+
+            auto self = masterLodScheduler.lock();
+
+            if (self == nullptr)
+                return;
+
+            auto resourceIt = self->_residentResources.find(provider);
+
+            if (resourceIt != self->_residentResources.end())
+                self->residentMemoryChanged(resourceIt->second, provider);
+        }
+    );
+
+    residentMemoryChanged(resource, data);
+}
+
+void
+MasterLodScheduler::unwatchResidentMemory(ProviderPtr data)
+{
+    auto resourceIt = _residentResources.find(data);
+
+    if (resourceIt == _residentResources.end())
+        return;
+
+    _residentCpuMemory -= resourceIt->second.cpuMemory;
+    _residentGpuMemory -= resourceIt->second.gpuMemory;
+
+    _residentResources.erase(resourceIt);
+}
+
+void
+MasterLodScheduler::residentMemoryChanged(ResidentResource& resource, ProviderPtr data)
+{
+    const auto cpuMemory = data->hasProperty("residentCpuMemory") ? data->get<uint>("residentCpuMemory") : 0u;
+    const auto gpuMemory = data->hasProperty("residentGpuMemory") ? data->get<uint>("residentGpuMemory") : 0u;
+
+    _residentCpuMemory = _residentCpuMemory - resource.cpuMemory + cpuMemory;
+    _residentGpuMemory = _residentGpuMemory - resource.gpuMemory + gpuMemory;
+
+    resource.cpuMemory = cpuMemory;
+    resource.gpuMemory = gpuMemory;
+}
+
+bool
+MasterLodScheduler::overMemoryBudget() const
+{
+    return (_cpuMemoryBudget > 0 && _residentCpuMemory > _cpuMemoryBudget) ||
+        (_gpuMemoryBudget > 0 && _residentGpuMemory > _gpuMemoryBudget);
+}
@@ -50,7 +50,12 @@ POPGeometryLodScheduler::POPGeometryLodScheduler() :
     _viewport(),
     _worldToScreenMatrix(),
     _viewMatrix(),
-    _blendingRange(0.f)
+    _blendingRange(0.f),
+    _prefetchDistance(0.f),
+    _prefetchingResources(),
+    _numPrefetches(0),
+    _numPrefetchHits(0),
+    _numPrefetchMisses(0)
 {
 }
 
@@ -106,6 +111,8 @@ POPGeometryLodScheduler::surfaceAdded(Surface::Ptr surface)
 
         resource->geometry = geometry;
         resource->fullPrecisionLod = geometry->data()->get<float>("popFullPrecisionLod");
+        resource->simplifiedLods = geometry->data()->hasProperty("popSimplifiedLods") &&
+                                   geometry->data()->get<bool>("popSimplifiedLods");
 
         const auto* availableLods = resourceBase.data->getPointer<std::map<int, ProgressiveOrderedMeshLodInfo>>("availableLods");
 
@@ -126,9 +133,25 @@ POPGeometryLodScheduler::surfaceAdded(Surface::Ptr surface)
         resource->precisionLevelToClosestLod.resize(lodRangeSize);
 
         updateClosestLods(*resource);
-        const auto& lodDependencyProperties =
+	}
+	else
+	{
+		resource = &resourceIt->second;
+	}
+
+    // the resources scheduled on eye travel must be reevaluated as soon as the world space
+    // bounding box of one of their surfaces moves
+    if (resource->propertyChangedSlots.count(surfaceTarget) == 0)
+    {
+        auto lodDependencyProperties =
             this->masterLodScheduler()->streamingOptions()->popGeometryLodDependencyProperties();
 
+        const auto modelToWorldMatrixPropertyName = data::Provider::PropertyName("modelToWorldMatrix");
+
+        if (std::find(lodDependencyProperties.begin(), lodDependencyProperties.end(), modelToWorldMatrixPropertyName) ==
+            lodDependencyProperties.end())
+            lodDependencyProperties.push_back(modelToWorldMatrixPropertyName);
+
         for (const auto& propertyName : lodDependencyProperties)
         {
             resource->propertyChangedSlots.insert(std::make_pair(
@@ -143,11 +166,7 @@ POPGeometryLodScheduler::surfaceAdded(Surface::Ptr surface)
                 )
             ));
         }
-	}
-	else
-	{
-		resource = &resourceIt->second;
-	}
+    }
 
     auto surfaceInfoIt = std::find_if(
         resource->surfaceInfoCollection.begin(),
@@ -185,6 +204,18 @@ POPGeometryLodScheduler::surfaceAdded(Surface::Ptr surface)
         }
     );
 
+    surfaceInfo->componentAddedSlot = surfaceTarget->componentAdded().connect(
+        [this, resource](Node::Ptr node, Node::Ptr target, AbstractComponent::Ptr component)
+        {
+            auto boundingBox = std::dynamic_pointer_cast<BoundingBox>(component);
+
+            if (node != target || boundingBox == nullptr)
+                return;
+
+            boundingBoxChanged(*resource, target, boundingBox);
+        }
+    );
+
     if (!surface->data()->hasProperty("popLodEnabled"))
     {
         surface->numIndices(0u);
@@ -206,6 +237,8 @@ POPGeometryLodScheduler::surfaceAdded(Surface::Ptr surface)
         surface->data()->set("popPreviousLod", 0.f);
         surface->data()->set("popLodBlendingTime", 0.f);
     }
+
+    invalidateLodRequirement(*resource->base);
 }
 
 void
@@ -238,6 +271,8 @@ POPGeometryLodScheduler::surfaceRemoved(Surface::Ptr surface)
             return surfaceInfo.surface == surface;
         }), resource.surfaceInfoCollection.end()
     );
+
+    invalidateLodRequirement(*resource.base);
 }
 
 void
@@ -259,13 +294,17 @@ POPGeometryLodScheduler::viewPropertyChanged(const math::mat4&   worldToScreenMa
         zFar
     );
 
+    const auto projectionChanged = fov != _fov || aspectRatio != _aspectRatio;
+
     _eyePosition = eyePosition;
     _fov = fov;
     _aspectRatio = aspectRatio;
     _worldToScreenMatrix = worldToScreenMatrix;
     _viewMatrix = viewMatrix;
 
-	invalidateLodRequirement();
+    // otherwise only the resources scheduled on eye travel are invalidated
+    if (projectionChanged || !lodRequirementFollowsEyeTravel())
+        invalidateLodRequirement();
 }
 
 void
@@ -276,6 +315,38 @@ POPGeometryLodScheduler::viewportChanged(const math::vec4& viewport)
     invalidateLodRequirement();
 }
 
+void
+POPGeometryLodScheduler::eyeVelocityChanged(const math::vec3& eyeVelocity)
+{
+    AbstractLodScheduler::eyeVelocityChanged(eyeVelocity);
+
+    if (masterLodScheduler() == nullptr)
+        return;
+
+    const auto prefetchTime = masterLodScheduler()->streamingOptions()->popGeometryPrefetchTime();
+
+    if (prefetchTime <= 0.f)
+        return;
+
+    const auto prefetchDistance = math::length(eyeVelocity) * prefetchTime;
+
+    // the resources scheduled on eye travel only account for a predicted eye within _prefetchDistance
+    if (prefetchDistance > _prefetchDistance)
+    {
+        _prefetchDistance = 2.f * prefetchDistance;
+
+        invalidateLodRequirement();
+
+        return;
+    }
+
+    if (prefetchDistance < .25f * _prefetchDistance)
+        _prefetchDistance = 2.f * prefetchDistance;
+
+    for (auto resource : _prefetchingResources)
+        invalidateLodRequirement(*resource->base);
+}
+
 void
 POPGeometryLodScheduler::maxAvailableLodChanged(ResourceInfo&    resource,
                                                 int              maxAvailableLod)
@@ -291,7 +362,8 @@ POPGeometryLodScheduler::maxAvailableLodChanged(ResourceInfo&    resource,
     else
         popGeometryResource.minAvailableLod = std::min(maxAvailableLod, popGeometryResource.minAvailableLod);
 
-    popGeometryResource.maxAvailableLod = std::max(maxAvailableLod, popGeometryResource.maxAvailableLod);
+    // lower when the resource is downgraded by the MasterLodScheduler
+    popGeometryResource.maxAvailableLod = maxAvailableLod;
 
     updateClosestLods(popGeometryResource);
 }
@@ -304,8 +376,13 @@ POPGeometryLodScheduler::lodInfo(ResourceInfo&  resource,
 
 	auto& popGeometryResource = _popGeometryResources.at(resource.data);
 
+    const auto prefetchTime = masterLodScheduler()->streamingOptions()->popGeometryPrefetchTime();
+    const auto predictedEyePosition = _eyePosition + eyeVelocity() * prefetchTime;
+
     auto maxRequiredLod = 0;
+    auto maxPredictedLod = 0;
     auto maxPriority = 0.f;
+    auto minEyeTravelSlack = std::numeric_limits<float>::infinity();
 
 	for (auto& surfaceInfo : popGeometryResource.surfaceInfoCollection)
 	{
@@ -316,7 +393,15 @@ POPGeometryLodScheduler::lodInfo(ResourceInfo&  resource,
         auto activeLod = previousActiveLod;
 
         auto requiredPrecisionLevel = 0.f;
-		const auto requiredLod = computeRequiredLod(popGeometryResource, surfaceInfo, requiredPrecisionLevel);
+		const auto requiredLod = computeRequiredLod(
+            popGeometryResource,
+            surfaceInfo,
+            _eyePosition,
+            requiredPrecisionLevel,
+            surfaceInfo.distanceFromEye
+        );
+
+        surfaceInfo.surface->data()->set("distanceFromEye", surfaceInfo.distanceFromEye);
 
         const auto& lod = lodToClosestValidLod(popGeometryResource, requiredLod);
 
@@ -339,17 +424,52 @@ POPGeometryLodScheduler::lodInfo(ResourceInfo&  resource,
 
         maxRequiredLod = std::max(requiredLod, maxRequiredLod);
 
+        if (prefetchTime > 0.f)
+        {
+            auto predictedPrecisionLevel = 0.f;
+            auto predictedDistanceFromEye = 0.f;
+
+            maxPredictedLod = std::max(
+                computeRequiredLod(
+                    popGeometryResource,
+                    surfaceInfo,
+                    predictedEyePosition,
+                    predictedPrecisionLevel,
+                    predictedDistanceFromEye
+                ),
+                maxPredictedLod
+            );
+        }
+
         const auto priority = computeLodPriority(popGeometryResource, surfaceInfo, requiredLod, activeLod, time);
 
         if (priority > 0.f)
             surfaceInfo.weight = priority;
 
         maxPriority = std::max(priority, maxPriority);
+
+        // surfaces still waiting for their LOD are reevaluated each time the camera moves
+        minEyeTravelSlack = std::min(
+            priority > 0.f ? 0.f : eyeTravelSlack(popGeometryResource, surfaceInfo),
+            minEyeTravelSlack
+        );
 	}
 
     lodInfo.requiredLod = maxRequiredLod;
     lodInfo.priority = maxPriority;
 
+    if (prefetchTime > 0.f)
+    {
+        prefetch(popGeometryResource, lodInfo, maxPredictedLod);
+
+        // the predicted eye moves up to _prefetchDistance away from the actual one
+        minEyeTravelSlack = popGeometryResource.prefetchLod >= 0
+            ? 0.f
+            : math::max(0.f, minEyeTravelSlack - 2.f * _prefetchDistance);
+    }
+
+    invalidateLodRequirementOnEyeTravel(resource, minEyeTravelSlack);
+
 	return lodInfo;
 }
 
@@ -360,6 +480,32 @@ POPGeometryLodScheduler::layoutChanged(POPGeometryResourceInfo&  resource,
     invalidateLodRequirement(*resource.base);
 }
 
+void
+POPGeometryLodScheduler::boundingBoxChanged(POPGeometryResourceInfo&    resource,
+                                            Node::Ptr                   target,
+                                            BoundingBox::Ptr            boundingBox)
+{
+    for (auto& surfaceInfo : resource.surfaceInfoCollection)
+        if (surfaceInfo.surface->target() == target)
+            surfaceInfo.box = boundingBox->box();
+
+    invalidateLodRequirement(*resource.base);
+}
+
+bool
+POPGeometryLodScheduler::lodRequirementFollowsEyeTravel() const
+{
+    if (masterLodScheduler() == nullptr)
+        return false;
+
+    const auto& streamingOptions = masterLodScheduler()->streamingOptions();
+
+    // user functions can depend on anything but the distance from the eye
+    return !streamingOptions->popGeometryLodFunction() &&
+        !streamingOptions->popGeometryErrorFunction() &&
+        streamingOptions->popGeometryLodPriorityFunctionIsDefault();
+}
+
 void
 POPGeometryLodScheduler::activeLodChanged(POPGeometryResourceInfo&   resource,
                              			  SurfaceInfo&               surfaceInfo,
@@ -372,6 +518,17 @@ POPGeometryLodScheduler::activeLodChanged(POPGeometryResourceInfo&   resource,
 
 	const auto& activeLod = lodToClosestValidLod(resource, lod);
 
+    if (resource.simplifiedLods)
+    {
+        // each simplified lod is a standalone index range over the shared vertices,
+        // vertex positions are exact so neither quantization nor blending apply
+        surfaceInfo.surface->firstIndex(static_cast<unsigned int>(activeLod._indexOffset));
+        surfaceInfo.surface->numIndices(static_cast<unsigned int>(activeLod._indexCount));
+        surfaceInfo.surface->data()->set("popLod", float(resource.fullPrecisionLod));
+
+        return;
+    }
+
 	const auto numIndices = static_cast<unsigned int>(
 		(activeLod._indexOffset + activeLod._indexCount)
 	);
@@ -415,10 +572,68 @@ POPGeometryLodScheduler::activeLodChanged(POPGeometryResourceInfo&   resource,
     }
 }
 
+void
+POPGeometryLodScheduler::prefetch(POPGeometryResourceInfo&   resource,
+                                  LodInfo&                   lodInfo,
+                                  int                        predictedLod)
+{
+    if (resource.prefetchLod >= 0)
+    {
+        auto resolved = false;
+
+        if (lodInfo.requiredLod >= resource.prefetchLod)
+        {
+            // a prefetch still in flight when its LOD gets required did not hide any latency
+            if (resource.maxAvailableLod >= resource.prefetchLod)
+                ++_numPrefetchHits;
+            else
+                ++_numPrefetchMisses;
+
+            resolved = true;
+        }
+        else if (predictedLod < resource.prefetchLod)
+        {
+            ++_numPrefetchMisses;
+            resolved = true;
+        }
+
+        if (resolved)
+        {
+            resource.prefetchLod = -1;
+
+            _prefetchingResources.erase(&resource);
+        }
+    }
+
+    if (predictedLod > lodInfo.requiredLod && predictedLod > resource.maxAvailableLod && lodInfo.priority <= 0.f)
+    {
+        if (resource.prefetchLod < 0)
+        {
+            ++_numPrefetches;
+
+            _prefetchingResources.insert(&resource);
+        }
+
+        resource.prefetchLod = std::max(predictedLod, resource.prefetchLod);
+    }
+
+    // the LODs actually required are always fetched first, withdrawing the prediction drops the
+    // priority to 0 and aborts the speculative request if requestAbortingEnabled is set
+    if (resource.prefetchLod < 0 || lodInfo.priority > 0.f)
+        return;
+
+    lodInfo.requiredLod = resource.prefetchLod;
+
+    if (resource.maxAvailableLod < resource.prefetchLod)
+        lodInfo.priority = masterLodScheduler()->streamingOptions()->popGeometryPrefetchPriority();
+}
+
 int
 POPGeometryLodScheduler::computeRequiredLod(const POPGeometryResourceInfo&  resource,
 											SurfaceInfo& 				    surfaceInfo,
-                                            float&                          requiredPrecisionLevel)
+                                            const math::vec3&               eyePosition,
+                                            float&                          requiredPrecisionLevel,
+                                            float&                          distanceFromEye)
 {
     auto target = surfaceInfo.surface->target();
 
@@ -427,9 +642,9 @@ POPGeometryLodScheduler::computeRequiredLod(const POPGeometryResourceInfo&  reso
     const auto worldMinBound = box->bottomLeft();
     const auto worldMaxBound = box->topRight();
 
-    const auto targetDistance = distanceFromEye(resource, surfaceInfo, _eyePosition);
+    const auto targetDistance = this->distanceFromEye(resource, surfaceInfo, eyePosition);
 
-    surfaceInfo.surface->data()->set("distanceFromEye", targetDistance);
+    distanceFromEye = targetDistance;
 
     if (targetDistance <= 0)
     {
@@ -595,6 +810,31 @@ POPGeometryLodScheduler::lodToClosestValidLod(const POPGeometryResourceInfo& res
     return *resource.lodToClosestValidLod.at(math::clamp(lod, resource.minLod, resource.fullPrecisionLod));
 }
 
+float
+POPGeometryLodScheduler::eyeTravelSlack(const POPGeometryResourceInfo&  resource,
+                                        const SurfaceInfo&              surfaceInfo) const
+{
+    const auto distance = surfaceInfo.distanceFromEye;
+    const auto requiredPrecisionLevel = surfaceInfo.requiredPrecisionLevel;
+
+    if (distance <= 0.f || !std::isfinite(requiredPrecisionLevel))
+        return 0.f;
+
+    // the required precision level is log2(k / distance) for a given surface and projection,
+    // its ceiled value remains the same as long as the distance stays within [minDistance, maxDistance)
+    const auto precisionLevel = std::ceil(requiredPrecisionLevel);
+
+    const auto minDistance = precisionLevel >= float(resource.fullPrecisionLod)
+        ? 0.f
+        : distance * std::exp2(requiredPrecisionLevel - precisionLevel);
+
+    const auto maxDistance = precisionLevel <= float(resource.minLod)
+        ? std::numeric_limits<float>::infinity()
+        : distance * std::exp2(requiredPrecisionLevel - precisionLevel + 1.f);
+
+    return math::max(0.f, math::min(distance - minDistance, maxDistance - distance));
+}
+
 float
 POPGeometryLodScheduler::distanceFromEye(const POPGeometryResourceInfo&  resource,
                                          SurfaceInfo&                    surfaceInfo,
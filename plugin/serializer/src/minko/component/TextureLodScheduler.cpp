@@ -28,6 +28,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/StreamingOptions.hpp"
 #include "minko/material/Material.hpp"
 #include "minko/render/AbstractTexture.hpp"
+#include "minko/render/TextureUploadQueue.hpp"
 #include "minko/scene/Node.hpp"
 
 #include "sparsehash/sparse_hash_map"
@@ -358,6 +359,10 @@ TextureLodScheduler::lodInfo(ResourceInfo&  resource,
     lodInfo.requiredLod = maxRequiredLod;
     lodInfo.priority = maxPriority;
 
+    // deferred uploads of the LODs already fetched follow the same order as the fetching itself
+    if (textureResource.texture != nullptr)
+        _assetLibrary->textureUploadQueue()->priority(textureResource.texture, maxPriority);
+
     const auto activeLod = std::min(maxRequiredLod, textureResource.maxAvailableLod);
 
     if (previousActiveLod != activeLod)
@@ -464,6 +464,14 @@ StreamingExtension::deserializePOPGeometry(unsigned short					metaData,
     parserScheduler->addParser(parser);
 
     _streamingOptions->masterLodScheduler()->registerGeometry(geometry, geometryData);
+
+    if (_streamingOptions->lodEvictionEnabled())
+    {
+        _streamingOptions->masterLodScheduler()->registerLodEviction(
+            geometryData,
+            std::bind(&AbstractStreamedAssetParser::evict, parser, std::placeholders::_1)
+        );
+    }
 }
 
 Dependency::SerializedAsset
@@ -671,6 +679,14 @@ StreamingExtension::deserializeStreamedTexture(unsigned short											metaData
         _streamingOptions->masterLodScheduler()->registerDeferredTexture(textureData);
     }
 
+    if (_streamingOptions->lodEvictionEnabled())
+    {
+        _streamingOptions->masterLodScheduler()->registerLodEviction(
+            textureData,
+            std::bind(&AbstractStreamedAssetParser::evict, parser, std::placeholders::_1)
+        );
+    }
+
     registerStreamedTextureParser(parser, texture);
 
     auto parserScheduler = this->parserScheduler(options, jobList);
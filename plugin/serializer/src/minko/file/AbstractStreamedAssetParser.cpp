@@ -57,6 +57,7 @@ AbstractStreamedAssetParser::AbstractStreamedAssetParser() :
     _loaderErrorSlot(),
     _loaderCompleteSlot(),
     _complete(false),
+    _fetching(false),
     _data(),
     _dataPropertyChangedSlot(),
     _requiredLod(0),
@@ -127,7 +128,7 @@ AbstractStreamedAssetParser::parse(const std::string&                 filename,
 float
 AbstractStreamedAssetParser::priority()
 {
-    if (_readingHeader)
+    if (_readingHeader || _complete)
         return 0.f;
 
     return _priority;
@@ -157,6 +158,7 @@ AbstractStreamedAssetParser::getNextLodRequestInfo(int& offset, int& size)
 void
 AbstractStreamedAssetParser::lodRequestFetchingBegin()
 {
+    _fetching = true;
 }
 
 void
@@ -167,6 +169,8 @@ AbstractStreamedAssetParser::lodRequestFetchingProgress(float progressRate)
 void
 AbstractStreamedAssetParser::lodRequestFetchingError(const Error& error)
 {
+    _fetching = false;
+
     this->error()->execute(shared_from_this(), error);
 }
 
@@ -182,6 +186,8 @@ AbstractStreamedAssetParser::lodRequestFetchingComplete(const std::vector<unsign
             },
             [this]()
             {
+                _fetching = false;
+
                 lodRequestComplete()->execute(
                     std::static_pointer_cast<AbstractStreamedAssetParser>(shared_from_this())
                 );
@@ -196,6 +202,8 @@ AbstractStreamedAssetParser::lodRequestFetchingComplete(const std::vector<unsign
     {
         parseLod(_previousLod, _currentLod, data, _options);
 
+        _fetching = false;
+
         lodRequestComplete()->execute(
             std::static_pointer_cast<AbstractStreamedAssetParser>(shared_from_this())
         );
@@ -204,6 +212,35 @@ AbstractStreamedAssetParser::lodRequestFetchingComplete(const std::vector<unsign
     }
 }
 
+void
+AbstractStreamedAssetParser::evict(int lod)
+{
+    if (!_headerIsRead || _fetching || lod >= _previousLod)
+        return;
+
+    const auto residentLod = lodEvicted(_previousLod, lod);
+
+    if (residentLod >= _previousLod)
+        return;
+
+    auto self = std::static_pointer_cast<AbstractStreamedAssetParser>(shared_from_this());
+
+    beforePriorityChanged()->execute(self, _priority);
+
+    _complete = false;
+    _previousLod = residentLod;
+
+    nextLod(_previousLod, _requiredLod, _currentLod, _nextLodOffset, _nextLodSize);
+
+    priorityChanged()->execute(self, _priority);
+}
+
+bool
+AbstractStreamedAssetParser::lodEvictionEnabled() const
+{
+    return _streamingOptions && _streamingOptions->lodEvictionEnabled();
+}
+
 void
 AbstractStreamedAssetParser::parseLod(int                                previousLod,
                                       int                                currentLod,
@@ -239,6 +276,8 @@ AbstractStreamedAssetParser::prepareNextLod()
 {
     if (complete(_currentLod))
     {
+        _previousLod = _currentLod;
+
         terminate();
     }
     else
@@ -252,7 +291,17 @@ AbstractStreamedAssetParser::prepareNextLod()
 void
 AbstractStreamedAssetParser::terminate()
 {
-    _dataPropertyChangedSlot = nullptr;
+    // an evictable asset keeps following its required LOD and priority to fetch its evicted LODs again
+    if (!lodEvictionEnabled())
+        _dataPropertyChangedSlot = nullptr;
+
+    auto self = std::static_pointer_cast<AbstractStreamedAssetParser>(shared_from_this());
+
+    beforePriorityChanged()->execute(self, _priority);
+
+    _complete = true;
+
+    priorityChanged()->execute(self, _priority);
 
     completed();
 
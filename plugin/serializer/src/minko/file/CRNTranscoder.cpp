@@ -24,6 +24,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/Texture.hpp"
 #include "minko/render/TextureFormatInfo.hpp"
 
+#include <fstream>
+#include <iomanip>
+
 #ifndef MINKO_NO_CRNLIB
 # define CRND_HEADER_FILE_ONLY
 # include "crn_core.h"
@@ -99,13 +102,206 @@ fillTextureData(const crn_uint32*                           data[6][16],
 
 #endif
 
+static
+void
+hashBytes(unsigned long long& hash, const unsigned char* data, std::size_t size)
+{
+    // 64-bit FNV-1a
+    for (auto i = 0u; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+template <typename T>
+static
+void
+hashValue(unsigned long long& hash, const T& value)
+{
+    hashBytes(hash, reinterpret_cast<const unsigned char*>(&value), sizeof(T));
+}
+
+static
+bool
+readCachedTexture(const std::string& filename, std::vector<unsigned char>& out)
+{
+    std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+
+    if (!file.is_open())
+        return false;
+
+    const auto size = static_cast<std::size_t>(file.tellg());
+
+    if (size == 0u)
+        return false;
+
+    auto data = std::vector<unsigned char>(size);
+
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char*>(data.data()), size);
+
+    if (!file)
+        return false;
+
+    out.insert(out.end(), data.begin(), data.end());
+
+    return true;
+}
+
+static
+void
+writeCachedTexture(const std::string& filename, const unsigned char* data, std::size_t size)
+{
+    // write to a temporary file first so that concurrent writers never expose a partial entry
+    const auto temporaryFilename = filename + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+    {
+        std::ofstream file(temporaryFilename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+        if (!file.is_open())
+        {
+            LOG_WARNING("unable to write transcoded texture cache entry: " << filename);
+
+            return;
+        }
+
+        file.write(reinterpret_cast<const char*>(data), size);
+    }
+
+    if (std::rename(temporaryFilename.c_str(), filename.c_str()) != 0)
+        std::remove(temporaryFilename.c_str());
+}
+
+bool
+CRNTranscoder::supportsFormat(TextureFormat format)
+{
+    return format == TextureFormat::RGB_DXT1
+        || format == TextureFormat::RGBA_DXT1
+        || format == TextureFormat::RGBA_DXT3
+        || format == TextureFormat::RGBA_DXT5;
+}
+
+std::string
+CRNTranscoder::cacheFilename(std::shared_ptr<render::AbstractTexture>  texture,
+                             const std::string&                        textureType,
+                             std::shared_ptr<WriterOptions>            writerOptions,
+                             render::TextureFormat                     outFormat)
+{
+    const auto& cacheDirectory = writerOptions->transcodedTextureCacheDirectory();
+
+    if (cacheDirectory.empty() || texture->type() != TextureType::Texture2D)
+        return std::string();
+
+    const auto& data = std::static_pointer_cast<Texture>(texture)->data();
+
+    auto hash = 14695981039346656037ull;
+
+    hashBytes(hash, data.data(), data.size());
+    hashValue(hash, texture->width());
+    hashValue(hash, texture->height());
+    hashValue(hash, texture->format());
+    hashValue(hash, outFormat);
+    hashValue(hash, writerOptions->compressedTextureQualityFactor(textureType));
+    hashValue(hash, writerOptions->generateMipMaps(textureType));
+    hashValue(hash, writerOptions->preserveMipMaps(textureType));
+    hashValue(hash, writerOptions->useTextureSRGBSpace(textureType));
+
+    std::stringstream filename;
+
+    filename << cacheDirectory << "/" << std::hex << std::setw(16) << std::setfill('0') << hash
+             << "." << TextureFormatInfo::name(outFormat) << ".crn";
+
+    return filename.str();
+}
+
+bool
+CRNTranscoder::transcode(std::shared_ptr<render::AbstractTexture>  texture,
+                         const std::string&                        textureType,
+                         std::shared_ptr<WriterOptions>            writerOptions,
+                         render::TextureFormat                     outFormat,
+                         std::vector<unsigned char>&               out)
+{
+    const auto numHelperThreads = std::min(
+        writerOptions->numTranscodingThreads() - 1u,
+        static_cast<unsigned int>(16u)
+    );
+
+    return transcode(texture, textureType, writerOptions, outFormat, numHelperThreads, out);
+}
+
+bool
+CRNTranscoder::transcode(std::shared_ptr<render::AbstractTexture>  texture,
+                         const std::string&                        textureType,
+                         std::shared_ptr<WriterOptions>            writerOptions,
+                         const std::vector<render::TextureFormat>& outFormats,
+                         std::vector<std::vector<unsigned char>>&  out)
+{
+    out.clear();
+    out.resize(outFormats.size());
+
+    if (outFormats.empty())
+        return true;
+
+#ifndef MINKO_NO_CRNLIB
+    crnlib::console::disable_output();
+#endif
+
+    const auto numThreads = writerOptions->numTranscodingThreads();
+    const auto numWorkers = std::min(numThreads, static_cast<unsigned int>(outFormats.size()));
+    const auto numHelperThreads = std::min(numThreads / numWorkers - 1u, static_cast<unsigned int>(16u));
+
+    auto failed = std::vector<unsigned char>(outFormats.size(), 0u);
+
+    auto work = [&](unsigned int worker)
+    {
+        for (auto i = worker; i < outFormats.size(); i += numWorkers)
+        {
+            if (!transcode(texture, textureType, writerOptions, outFormats[i], numHelperThreads, out[i]))
+            {
+                out[i].clear();
+                failed[i] = 1u;
+            }
+        }
+    };
+
+    if (numWorkers == 1u)
+    {
+        work(0u);
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+
+        for (auto i = 1u; i < numWorkers; ++i)
+            threads.push_back(std::thread(work, i));
+
+        work(0u);
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    return std::find(failed.begin(), failed.end(), 1u) == failed.end();
+}
+
 bool
 CRNTranscoder::transcode(std::shared_ptr<render::AbstractTexture>  texture,
                          const std::string&                        textureType,
                          std::shared_ptr<WriterOptions>            writerOptions,
                          render::TextureFormat                     outFormat,
+                         unsigned int                              numHelperThreads,
                          std::vector<unsigned char>&               out)
 {
+    const auto cachedFilename = cacheFilename(texture, textureType, writerOptions, outFormat);
+
+    if (!cachedFilename.empty() && readCachedTexture(cachedFilename, out))
+    {
+        LOG_DEBUG("transcoded texture read from cache: " << cachedFilename);
+
+        return true;
+    }
+
 #ifndef MINKO_NO_CRNLIB
     crnlib::console::disable_output();
 
@@ -117,7 +313,8 @@ CRNTranscoder::transcode(std::shared_ptr<render::AbstractTexture>  texture,
         { TextureFormat::RGBA_DXT5,     crn_format::cCRNFmtDXT5 }
     };
 
-    const auto startTimeStamp = std::clock();
+    const auto startTimeStamp = std::chrono::steady_clock::now();
+    const auto outOffset = out.size();
 
     const auto generateMipmaps = writerOptions->generateMipMaps(textureType);
     const auto numMipMaps = generateMipmaps ? AbstractTexture::numMipMaps(texture->width(), texture->height()) : 1u;
@@ -138,6 +335,7 @@ CRNTranscoder::transcode(std::shared_ptr<render::AbstractTexture>  texture,
         crn_comp_params compressorParameters;
 
         compressorParameters.m_faces = 1u;
+        compressorParameters.m_num_helper_threads = std::min(numHelperThreads, static_cast<unsigned int>(cCRNMaxHelperThreads));
 
         compressorParameters.m_width = texture2d->width();
         compressorParameters.m_height = texture2d->height();
@@ -191,13 +389,20 @@ CRNTranscoder::transcode(std::shared_ptr<render::AbstractTexture>  texture,
         const auto width = texture->width();
         const auto height = texture->height();
 
+        if (ddsFileRawData == nullptr)
+            return false;
+
         auto ddsFileData = reinterpret_cast<const char*>(ddsFileRawData);
 
         unsigned int ddsFilecode = 0u;
         memcpy(&ddsFilecode, ddsFileData, 4u);
 
         if (ddsFilecode != crnlib::cDDSFileSignature)
+        {
+            crn_free_block(ddsFileRawData);
+
             return false;
+        }
 
         crnlib::DDSURFACEDESC2 ddsHeader;
         memcpy(&ddsHeader, ddsFileData + 4u, crnlib::cDDSSizeofDDSurfaceDesc2);
@@ -230,6 +435,8 @@ CRNTranscoder::transcode(std::shared_ptr<render::AbstractTexture>  texture,
             );
         }
 
+        crn_free_block(ddsFileRawData);
+
         break;
     }
     case TextureType::CubeTexture:
@@ -241,7 +448,7 @@ CRNTranscoder::transcode(std::shared_ptr<render::AbstractTexture>  texture,
     }
     }
 
-    const auto duration = (std::clock() - startTimeStamp) / static_cast<double>(CLOCKS_PER_SEC);
+    const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTimeStamp).count();
 
     LOG_INFO("compressing texture: "
         << texture->width()
@@ -255,6 +462,9 @@ CRNTranscoder::transcode(std::shared_ptr<render::AbstractTexture>  texture,
         << duration
     );
 
+    if (!cachedFilename.empty())
+        writeCachedTexture(cachedFilename, out.data() + outOffset, out.size() - outOffset);
+
     return true;
 #else
     return false;
@@ -66,6 +66,12 @@ GeometryParser::initialize()
         std::bind(&GeometryParser::deserializeVertexBuffer, std::placeholders::_1, std::placeholders::_2),
         0
     );
+
+    // Packed vertex attributes.
+    registerVertexBufferParserFunction(
+        std::bind(&GeometryParser::deserializePackedVertexBuffer, std::placeholders::_1, std::placeholders::_2),
+        1
+    );
 }
 
 std::shared_ptr<render::VertexBuffer>
@@ -90,6 +96,41 @@ GeometryParser::deserializeVertexBuffer(std::string&
 	return vertexBuffer;
 }
 
+std::shared_ptr<render::VertexBuffer>
+GeometryParser::deserializePackedVertexBuffer(std::string&                              serializedVertexBuffer,
+                                              std::shared_ptr<render::AbstractContext>  context)
+{
+    msgpack::type::tuple<std::string, std::vector<SerializePackedAttribute>> deserializedVertex;
+
+    unpack(deserializedVertex, serializedVertexBuffer.data(), serializedVertexBuffer.size());
+
+    auto vertexBuffer = render::VertexBuffer::create(context);
+
+    for (const auto& attribute : deserializedVertex.get<1>())
+        vertexBuffer->addAttribute(
+            attribute.get<0>(),
+            attribute.get<1>(),
+            attribute.get<2>(),
+            static_cast<render::VertexAttribute::Format>(attribute.get<3>())
+        );
+
+    const auto& packedData = deserializedVertex.get<0>();
+    const auto packedVertexBytes = vertexBuffer->packedVertexSize() * 4u;
+    const auto numVertices = packedVertexBytes > 0u ? packedData.size() / packedVertexBytes : 0u;
+
+    // the CPU copy is expanded to floats, the GPU copy is uploaded as is
+    vertexBuffer->data().resize(numVertices * vertexBuffer->vertexSize());
+    vertexBuffer->unpack(
+        reinterpret_cast<const unsigned char*>(packedData.data()),
+        numVertices,
+        vertexBuffer->data().data()
+    );
+
+    vertexBuffer->uploadPacked(0u, numVertices, std::vector<unsigned char>(packedData.begin(), packedData.end()));
+
+    return vertexBuffer;
+}
+
 GeometryParser::IndexBufferPtr
 GeometryParser::deserializeIndexBufferChar(std::string&                             serializedIndexBuffer,
                                            std::shared_ptr<render::AbstractContext> context)
@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/GeometryWriter.hpp"
 #include "minko/serialize/TypeSerializer.hpp"
 #include "minko/render/IndexBuffer.hpp"
+#include "minko/render/VertexBuffer.hpp"
 
 using namespace minko;
 using namespace minko::file;
@@ -84,6 +85,23 @@ GeometryWriter::initialize()
         [=](std::shared_ptr<geometry::Geometry> geometry) { return true; },
 		0
 	);
+
+    // Packed vertex attributes (half float, normalized integers).
+	registerVertexBufferWriterFunction(
+		std::bind(
+			GeometryWriter::serializePackedVertexStream,
+			std::placeholders::_1
+		),
+        [](std::shared_ptr<geometry::Geometry> geometry) -> bool
+        {
+            for (auto vertexBuffer : geometry->vertexBuffers())
+                if (vertexBuffer->isPacked())
+                    return true;
+
+            return false;
+        },
+		1
+	);
 }
 
 std::string
@@ -94,6 +112,17 @@ GeometryWriter::embed(std::shared_ptr<AssetLibrary>		assetLibrary,
                       std::vector<unsigned char>&       embeddedHeaderData)
 {
 	geometry::Geometry::Ptr		geometry				= data();
+
+    if (writerOptions->quantizeVertexAttributes())
+    {
+        geometry = quantizeVertexAttributes(
+            geometry,
+            writerOptions->vertexAttributeFormatFunction()
+                ? writerOptions->vertexAttributeFormatFunction()
+                : std::bind(GeometryWriter::defaultVertexAttributeFormat, std::placeholders::_1, std::placeholders::_2)
+        );
+    }
+
 	uint						indexBufferFunctionId	= 0;
 	uint						vertexBufferFunctionId	= 0;
 	uint						metaData				= computeMetaData(geometry, indexBufferFunctionId, vertexBufferFunctionId, writerOptions);
@@ -147,6 +176,113 @@ GeometryWriter::serializeVertexStream(std::shared_ptr<render::VertexBuffer> vert
 	return sbuf.str();
 }
 
+std::string
+GeometryWriter::serializePackedVertexStream(std::shared_ptr<render::VertexBuffer> vertexBuffer)
+{
+	std::vector<msgpack::type::tuple<std::string, unsigned char, unsigned char, unsigned char>> serializedAttributes;
+
+    for (const auto& attribute : vertexBuffer->attributes())
+	{
+		serializedAttributes.push_back(msgpack::type::tuple<std::string, unsigned char, unsigned char, unsigned char>(
+            *attribute.name,
+            attribute.size,
+            attribute.offset,
+            static_cast<unsigned char>(attribute.format)
+        ));
+	}
+
+    auto packedData = std::vector<unsigned char>();
+
+    vertexBuffer->pack(vertexBuffer->data().data(), vertexBuffer->numVertices(), packedData);
+
+	std::stringstream sbuf;
+
+	msgpack::type::tuple<std::string, std::vector<msgpack::type::tuple<std::string, unsigned char, unsigned char, unsigned char>>> res(
+		std::string(packedData.begin(), packedData.end()),
+		serializedAttributes
+    );
+
+	msgpack::pack(sbuf, res);
+
+	return sbuf.str();
+}
+
+render::VertexAttribute::Format
+GeometryWriter::defaultVertexAttributeFormat(const render::VertexAttribute& attribute, const std::vector<float>& data)
+{
+    const auto& name = *attribute.name;
+    const auto vertexSize = *attribute.vertexSize;
+
+    auto minValue = std::numeric_limits<float>::max();
+    auto maxValue = -std::numeric_limits<float>::max();
+    auto integral = true;
+
+    for (auto i = attribute.offset; i + attribute.size <= data.size(); i += vertexSize)
+    {
+        for (auto j = 0u; j < attribute.size; ++j)
+        {
+            const auto value = data[i + j];
+
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+            integral = integral && value == std::floor(value);
+        }
+    }
+
+    const auto inUnitRange = minValue >= 0.f && maxValue <= 1.f;
+
+    // positions stay full precision: vertex shaders read them without any dequantization step
+    if (name == "normal" || name == "tangent")
+        return render::VertexAttribute::Format::SHORT_NORMALIZED;
+
+    if (name.compare(0, 2, "uv") == 0)
+        return inUnitRange
+            ? render::VertexAttribute::Format::UNSIGNED_SHORT_NORMALIZED
+            : render::VertexAttribute::Format::HALF_FLOAT;
+
+    if (name.compare(0, 7, "boneIds") == 0 && integral && minValue >= 0.f && maxValue <= 255.f)
+        return render::VertexAttribute::Format::UNSIGNED_BYTE;
+
+    if (name.compare(0, 11, "boneWeights") == 0 && inUnitRange)
+        return render::VertexAttribute::Format::UNSIGNED_SHORT_NORMALIZED;
+
+    if (name == "color" && inUnitRange)
+        return render::VertexAttribute::Format::UNSIGNED_BYTE_NORMALIZED;
+
+    return render::VertexAttribute::Format::FLOAT;
+}
+
+geometry::Geometry::Ptr
+GeometryWriter::quantizeVertexAttributes(geometry::Geometry::Ptr                                geometry,
+                                         const WriterOptions::VertexAttributeFormatFunction&    formatFunction)
+{
+    auto quantizedGeometry = geometry::Geometry::create(geometry->name());
+
+    quantizedGeometry->indices(geometry->indices());
+
+    for (auto vertexBuffer : geometry->vertexBuffers())
+    {
+        // contextless copy, only used to drive serialization
+        auto quantizedVertexBuffer = render::VertexBuffer::create(nullptr);
+
+        quantizedVertexBuffer->data() = vertexBuffer->data();
+
+        for (const auto& attribute : vertexBuffer->attributes())
+        {
+            quantizedVertexBuffer->addAttribute(
+                *attribute.name,
+                attribute.size,
+                attribute.offset,
+                formatFunction(attribute, vertexBuffer->data())
+            );
+        }
+
+        quantizedGeometry->addVertexBuffer(quantizedVertexBuffer);
+    }
+
+    return quantizedGeometry;
+}
+
 unsigned short
 GeometryWriter::computeMetaData(std::shared_ptr<geometry::Geometry> geometry,
 							    uint&								indexBufferFunctionId,
@@ -171,10 +307,12 @@ GeometryWriter::computeMetaData(std::shared_ptr<geometry::Geometry> geometry,
 bool
 GeometryWriter::indexBufferFitCharCompression(std::shared_ptr<geometry::Geometry> geometry)
 {
-    if (geometry->indices()->data().empty())
+    const auto ushortIndices = geometry->indices()->dataPointer<unsigned short>();
+
+    if (ushortIndices == nullptr || ushortIndices->empty())
         return false;
 
-	std::vector<unsigned short>::iterator maxIndice = std::max_element(geometry->indices()->data().begin(), geometry->indices()->data().end());
+	std::vector<unsigned short>::const_iterator maxIndice = std::max_element(ushortIndices->begin(), ushortIndices->end());
 
     return *maxIndice <= 255;
 
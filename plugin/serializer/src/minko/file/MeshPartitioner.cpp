@@ -32,6 +32,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/scene/Node.hpp"
 #include "minko/scene/NodeSet.hpp"
 #include "minko/log/Logger.hpp"
+#include "minko/Uuid.hpp"
 
 using namespace minko;
 using namespace minko::component;
@@ -48,6 +49,9 @@ MeshPartitioner::Options::Options() :
     maxNumSurfacesPerSurfaceBucket(255),
     maxNumTrianglesPerSurfaceBucket(3000000),
     flags(Options::none),
+    outOfCoreMemoryBudget(256u * 1024u * 1024u),
+    outOfCoreMaxCellDepth(8),
+    outOfCoreTemporaryDirectory("."),
     partitionMaxSizeFunction(defaultPartitionMaxSizeFunction),
     worldBoundsFunction(defaultWorldBoundsFunction),
     nodeFilterFunction(defaultNodeFilterFunction),
@@ -197,7 +201,8 @@ MeshPartitioner::defaultNodeFilterFunction(Node::Ptr node)
 MeshPartitioner::MeshPartitioner() :
     AbstractWriterPreprocessor<Node::Ptr>(),
     _progressRate(0.f),
-    _statusChanged(StatusChangedSignal::create())
+    _statusChanged(StatusChangedSignal::create()),
+    _numOutOfCoreCells(0u)
 {
 }
 
@@ -565,13 +570,20 @@ MeshPartitioner::process(Node::Ptr& node, AssetLibraryPtr assetLibrary)
                 }
             }
 
-            buildGlobalIndex(partitionInfo);
+            if (_options.flags & Options::outOfCore)
+            {
+                buildOutOfCoreGeometries(targetNode, partitionInfo, geometries);
+            }
+            else
+            {
+                buildGlobalIndex(partitionInfo);
 
-            buildHalfEdges(partitionInfo);
+                buildHalfEdges(partitionInfo);
 
-            buildPartitions(partitionInfo);
+                buildPartitions(partitionInfo);
 
-            buildGeometries(targetNode, partitionInfo, geometries);
+                buildGeometries(targetNode, partitionInfo, geometries);
+            }
         }
 
         patchNode(targetNode, partitionInfo, geometries);
@@ -640,10 +652,10 @@ MeshPartitioner::createGeometry(Geometry::Ptr                       referenceGeo
 
     const auto vertexSize = referenceGeometry->vertexSize();
 
-    auto globalIndexToLocalIndexMap = std::unordered_map<unsigned int, unsigned short>(indexCount);
-    auto localIndexToGlobalIndexMap = std::unordered_map<unsigned short, unsigned int>(indexCount);
+    auto globalIndexToLocalIndexMap = std::unordered_map<unsigned int, unsigned int>(indexCount);
+    auto localIndexToGlobalIndexMap = std::unordered_map<unsigned int, unsigned int>(indexCount);
 
-    auto localIndices = std::vector<unsigned short>(indexCount);
+    auto localIndices = std::vector<unsigned int>(indexCount);
 
     auto currentIndex = 0;
 
@@ -675,7 +687,17 @@ MeshPartitioner::createGeometry(Geometry::Ptr                       referenceGeo
         }
     }
 
-    geometry->indices(IndexBuffer::create(referenceGeometry->indices()->context(), localIndices));
+    if (vertexCount > std::numeric_limits<unsigned short>::max() + 1)
+    {
+        geometry->indices(IndexBuffer::create(referenceGeometry->indices()->context(), localIndices));
+    }
+    else
+    {
+        geometry->indices(IndexBuffer::create(
+            referenceGeometry->indices()->context(),
+            std::vector<unsigned short>(localIndices.begin(), localIndices.end())
+        ));
+    }
 
     auto globalAttributeOffset = 0;
 
@@ -722,7 +744,7 @@ MeshPartitioner::createGeometry(Geometry::Ptr                       referenceGeo
 
 void
 MeshPartitioner::markProtectedVertices(Geometry::Ptr                                            geometry,
-                                       const std::unordered_map<unsigned short, unsigned int>&  indices,
+                                       const std::unordered_map<unsigned int, unsigned int>&    indices,
                                        PartitionInfo&                                           partitionInfo)
 {
     const auto numVertices = geometry->numVertices();
@@ -732,9 +754,10 @@ MeshPartitioner::markProtectedVertices(Geometry::Ptr
 
     auto protectedFlagVertexBufferData = std::vector<float>(numVertices * protectedFlagVertexAttributeSize);
 
-    for (auto index : geometry->indices()->data())
+    for (const auto& localToGlobalIndex : indices)
     {
-        auto globalIndex = indices.at(index);
+        const auto index = localToGlobalIndex.first;
+        const auto globalIndex = localToGlobalIndex.second;
 
         const auto protectedFlagVertexBufferDataOffset =
             index * protectedFlagVertexAttributeSize + protectedFlagVertexAttributeOffset;
@@ -852,7 +875,7 @@ MeshPartitioner::insertTriangle(OctreeNodePtr       partitionNode,
 
             if (_options.flags & Options::applyCrackFreePolicy)
             {
-                if (expectedNumIndices >= _options.maxNumIndicesPerNode)
+                if (expectedNumIndices >= maxNumIndicesPerNode())
                 {
                     splitNode(partitionNode, partitionInfo);
                 }
@@ -866,7 +889,7 @@ MeshPartitioner::insertTriangle(OctreeNodePtr       partitionNode,
             }
             else
             {
-                if (expectedNumIndices >= _options.maxNumIndicesPerNode)
+                if (expectedNumIndices >= maxNumIndicesPerNode())
                 {
                     partitionNode->triangles.push_back(std::vector<unsigned int>());
                     partitionNode->indices.push_back(std::set<unsigned int>());
@@ -932,7 +955,7 @@ MeshPartitioner::insertTriangle(OctreeNodePtr       partitionNode,
 
             const auto expectedNumIndices = sharedIndices.back().size() + triangleIndices.size();
 
-            if (expectedNumIndices >= _options.maxNumIndicesPerNode)
+            if (expectedNumIndices >= maxNumIndicesPerNode())
             {
                 sharedTriangles.push_back(std::vector<unsigned int>());
                 sharedIndices.push_back(std::set<unsigned int>());
@@ -991,6 +1014,15 @@ MeshPartitioner::countTriangles(OctreeNodePtr partitionNode)
     return numTriangles;
 }
 
+int
+MeshPartitioner::maxNumIndicesPerNode() const
+{
+    // with 32-bit indices, the vertex count no longer bounds partition size
+    return (_options.flags & Options::allowUnsignedIntIndices)
+        ? std::numeric_limits<int>::max()
+        : _options.maxNumIndicesPerNode;
+}
+
 int
 MeshPartitioner::indexAt(int x, int y, int z)
 {
@@ -1428,6 +1460,607 @@ MeshPartitioner::buildGeometries(Node::Ptr                      node,
     return true;
 }
 
+std::size_t
+MeshPartitioner::outOfCoreTriangleCost(unsigned int vertexSize) const
+{
+    // rough estimate of the working set required to partition one triangle in memory:
+    // its binned record, the welded vertex data, the half-edges and the octree bookkeeping
+    static const auto triangleOverhead = 512u;
+
+    return 3u * vertexSize * sizeof(float) + triangleOverhead;
+}
+
+std::size_t
+MeshPartitioner::outOfCoreCellMemoryBudget(ProtectedPositionIndexPtr protectedPositions) const
+{
+    // one hash map node per position shared between cells: the key, the value, the link and the bucket
+    static const auto protectedPositionCost = sizeof(math::vec3) + 4u * sizeof(void*);
+
+    const auto protectedPositionsMemory = protectedPositions->size() * protectedPositionCost;
+
+    return protectedPositionsMemory < _options.outOfCoreMemoryBudget
+        ? _options.outOfCoreMemoryBudget - protectedPositionsMemory
+        : 0u;
+}
+
+std::string
+MeshPartitioner::outOfCoreCellFilename()
+{
+    static const auto filenamePrefix = std::string("minko-mesh-partitioner-");
+
+    const auto& directory = _options.outOfCoreTemporaryDirectory;
+
+    return (directory.empty() ? std::string(".") : directory) + "/" +
+        filenamePrefix + Uuid::getUuid() + "-" + std::to_string(_numOutOfCoreCells++) + ".bin";
+}
+
+static
+int
+cellIndexAt(const math::vec3&   position,
+            const math::vec3&   minBound,
+            const math::vec3&   maxBound,
+            int                 resolution)
+{
+    static const auto minCellSize = 1.0E-7f;
+
+    const auto size = math::max(maxBound - minBound, math::vec3(minCellSize));
+    const auto cell = math::clamp(
+        math::ivec3(math::floor((position - minBound) / size * float(resolution))),
+        math::ivec3(0),
+        math::ivec3(resolution - 1)
+    );
+
+    return cell.x + (cell.y + cell.z * resolution) * resolution;
+}
+
+static
+void
+cellBoundsAt(int                index,
+             const math::vec3&  minBound,
+             const math::vec3&  maxBound,
+             int                resolution,
+             math::vec3&        cellMinBound,
+             math::vec3&        cellMaxBound)
+{
+    const auto cell = math::vec3(
+        index % resolution,
+        (index / resolution) % resolution,
+        index / (resolution * resolution)
+    );
+
+    const auto cellSize = (maxBound - minBound) / float(resolution);
+
+    cellMinBound = minBound + cell * cellSize;
+    cellMaxBound = minBound + (cell + math::vec3(1.f)) * cellSize;
+}
+
+class OutOfCoreCellBinner
+{
+private:
+    std::vector<std::string>&           _filenames;
+    std::vector<std::vector<float>>     _buffers;
+    std::vector<bool>                   _created;
+    std::vector<unsigned int>           _numTriangles;
+
+    std::size_t                         _numBufferedFloats;
+    std::size_t                         _maxNumBufferedFloats;
+
+public:
+    OutOfCoreCellBinner(std::vector<std::string>& filenames, std::size_t bufferSize) :
+        _filenames(filenames),
+        _buffers(filenames.size()),
+        _created(filenames.size(), false),
+        _numTriangles(filenames.size(), 0u),
+        _numBufferedFloats(0u),
+        _maxNumBufferedFloats(std::max<std::size_t>(bufferSize / sizeof(float), 1u))
+    {
+    }
+
+    const std::vector<unsigned int>&
+    numTriangles() const
+    {
+        return _numTriangles;
+    }
+
+    void
+    push(int cellIndex, const float* record, std::size_t recordSize)
+    {
+        auto& buffer = _buffers[cellIndex];
+
+        buffer.insert(buffer.end(), record, record + recordSize);
+
+        ++_numTriangles[cellIndex];
+
+        _numBufferedFloats += recordSize;
+
+        if (_numBufferedFloats >= _maxNumBufferedFloats)
+            flush();
+    }
+
+    void
+    flush()
+    {
+        for (auto i = 0u; i < _buffers.size(); ++i)
+        {
+            auto& buffer = _buffers[i];
+
+            if (buffer.empty())
+                continue;
+
+            std::ofstream file(
+                _filenames[i],
+                std::ios::out | std::ios::binary | (_created[i] ? std::ios::app : std::ios::trunc)
+            );
+
+            if (!file.is_open())
+                throw std::runtime_error("MeshPartitioner: failed to open temporary file " + _filenames[i]);
+
+            file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(float));
+
+            _created[i] = true;
+
+            buffer.clear();
+            buffer.shrink_to_fit();
+        }
+
+        _numBufferedFloats = 0u;
+    }
+};
+
+static
+void
+protectRecordPositions(const float*                                        record,
+                       unsigned int                                        vertexSize,
+                       unsigned int                                        positionAttributeOffset,
+                       std::shared_ptr<math::UnorderedSpatialIndex<bool>>  protectedPositions)
+{
+    for (auto i = 0u; i < 3u; ++i)
+        protectedPositions->at(math::make_vec3(&record[i * vertexSize + positionAttributeOffset])) = true;
+}
+
+bool
+MeshPartitioner::buildOutOfCoreGeometries(Node::Ptr                     node,
+                                          PartitionInfo&                partitionInfo,
+                                          std::vector<Geometry::Ptr>&   geometries)
+{
+    if (partitionInfo.surfaces.empty())
+        return false;
+
+    auto referenceGeometry = partitionInfo.surfaces.front()->geometry();
+
+    partitionInfo.vertexSize = referenceGeometry->vertexSize();
+    partitionInfo.positionAttributeOffset = 0u;
+
+    for (auto vertexBuffer : referenceGeometry->vertexBuffers())
+    {
+        if (vertexBuffer->hasAttribute("position"))
+        {
+            partitionInfo.positionAttributeOffset += vertexBuffer->attribute("position").offset;
+
+            break;
+        }
+
+        partitionInfo.positionAttributeOffset += vertexBuffer->vertexSize();
+    }
+
+    auto protectedPositions = math::UnorderedSpatialIndex<bool>::create();
+
+    auto pendingCells = std::vector<OutOfCoreCell>();
+
+    binSurfaces(partitionInfo, pendingCells, protectedPositions);
+
+    const auto firstGeometry = geometries.size();
+
+    const auto triangleCost = outOfCoreTriangleCost(partitionInfo.vertexSize);
+
+    while (!pendingCells.empty())
+    {
+        const auto cell = pendingCells.back();
+        pendingCells.pop_back();
+
+        // the positions shared between cells are kept in memory until all cells are processed
+        if (cell.numTriangles * triangleCost > outOfCoreCellMemoryBudget(protectedPositions) &&
+            cell.depth < _options.outOfCoreMaxCellDepth)
+        {
+            binCell(
+                cell,
+                partitionInfo.vertexSize,
+                partitionInfo.positionAttributeOffset,
+                pendingCells,
+                protectedPositions
+            );
+        }
+        else
+        {
+            processOutOfCoreCell(node, cell, partitionInfo, protectedPositions, geometries);
+        }
+
+        std::remove(cell.filename.c_str());
+    }
+
+    // each cell only knows its own subtree, the partitioning depth range is made global once all cells are processed
+    auto maxDepth = 0;
+
+    for (auto i = firstGeometry; i < geometries.size(); ++i)
+        maxDepth = std::max(maxDepth, geometries[i]->data()->get<int>("partitioningMaxDepth"));
+
+    for (auto i = firstGeometry; i < geometries.size(); ++i)
+        geometries[i]->data()->set("partitioningMaxDepth", maxDepth);
+
+    if (partitionInfo.isInstance)
+    {
+        _processedInstances[referenceGeometry] = std::vector<Geometry::Ptr>(
+            geometries.begin() + firstGeometry,
+            geometries.end()
+        );
+    }
+
+    return true;
+}
+
+void
+MeshPartitioner::binSurfaces(PartitionInfo&                 partitionInfo,
+                             std::vector<OutOfCoreCell>&    cells,
+                             ProtectedPositionIndexPtr      protectedPositions)
+{
+    const auto vertexSize = partitionInfo.vertexSize;
+    const auto positionAttributeOffset = partitionInfo.positionAttributeOffset;
+    const auto recordSize = 3u * vertexSize;
+
+    auto& minBound = partitionInfo.minBound;
+    auto& maxBound = partitionInfo.maxBound;
+
+    minBound = math::vec3(std::numeric_limits<float>::max());
+    maxBound = math::vec3(-std::numeric_limits<float>::max());
+
+    auto numTriangles = 0u;
+
+    auto transformMatrices = std::vector<math::mat4>();
+
+    for (auto surface : partitionInfo.surfaces)
+    {
+        auto target = surface->target();
+        auto transformMatrix = math::mat4();
+
+        if (partitionInfo.useRootSpace && target->hasComponent<Transform>())
+            transformMatrix = target->component<Transform>()->modelToWorldMatrix(true);
+
+        transformMatrices.push_back(transformMatrix);
+
+        auto geometry = surface->geometry();
+        auto positionVertexBuffer = geometry->vertexBuffer("position");
+
+        const auto& positionAttribute = positionVertexBuffer->attribute("position");
+        const auto& localVertices = positionVertexBuffer->data();
+
+        for (auto i = 0u; i < geometry->numVertices(); ++i)
+        {
+            auto position = math::make_vec3(&localVertices.at(
+                i * positionVertexBuffer->vertexSize() + positionAttribute.offset
+            ));
+
+            position = math::vec3(transformMatrix * math::vec4(position, 1.f));
+
+            minBound = math::min(minBound, position);
+            maxBound = math::max(maxBound, position);
+        }
+
+        numTriangles += geometry->indices()->numIndices() / 3u;
+    }
+
+    const auto triangleCost = outOfCoreTriangleCost(vertexSize);
+
+    auto depth = 0;
+
+    while (depth < _options.outOfCoreMaxCellDepth &&
+           (numTriangles * triangleCost) >> (3 * depth) > _options.outOfCoreMemoryBudget)
+        ++depth;
+
+    const auto resolution = 1 << depth;
+    const auto numCells = resolution * resolution * resolution;
+
+    auto filenames = std::vector<std::string>(numCells);
+
+    for (auto& filename : filenames)
+        filename = outOfCoreCellFilename();
+
+    OutOfCoreCellBinner binner(filenames, _options.outOfCoreMemoryBudget / 4u);
+
+    auto record = std::vector<float>(recordSize);
+
+    for (auto surfaceIndex = 0u; surfaceIndex < partitionInfo.surfaces.size(); ++surfaceIndex)
+    {
+        auto surface = partitionInfo.surfaces[surfaceIndex];
+        auto geometry = surface->geometry();
+
+        const auto& transformMatrix = transformMatrices[surfaceIndex];
+        const auto normalMatrix = math::mat3(transformMatrix);
+
+        auto indexData = std::vector<unsigned int>();
+
+        auto ushortIndexDataPointer = geometry->indices()->dataPointer<unsigned short>();
+
+        if (ushortIndexDataPointer)
+            indexData.assign(ushortIndexDataPointer->begin(), ushortIndexDataPointer->end());
+
+        const auto& localIndices = ushortIndexDataPointer
+            ? indexData
+            : *geometry->indices()->dataPointer<unsigned int>();
+
+        for (auto i = 0u; i + 2u < localIndices.size(); i += 3u)
+        {
+            auto cellIndices = std::array<int, 3>();
+
+            for (auto j = 0u; j < 3u; ++j)
+            {
+                const auto localIndex = localIndices[i + j];
+
+                auto vertex = record.begin() + j * vertexSize;
+
+                for (auto vertexBuffer : geometry->vertexBuffers())
+                {
+                    const auto localVertexSize = vertexBuffer->vertexSize();
+                    const auto& localVertices = vertexBuffer->data();
+
+                    std::copy(
+                        localVertices.begin() + localIndex * localVertexSize,
+                        localVertices.begin() + (localIndex + 1) * localVertexSize,
+                        vertex
+                    );
+
+                    if (partitionInfo.useRootSpace)
+                    {
+                        if (vertexBuffer->hasAttribute("position"))
+                        {
+                            auto position = &*vertex + vertexBuffer->attribute("position").offset;
+                            auto transformedPosition = math::vec3(transformMatrix * math::vec4(math::make_vec3(position), 1.f));
+
+                            std::copy(&transformedPosition.x, &transformedPosition.x + 3, position);
+                        }
+
+                        for (const auto& attributeName : { "normal", "tangent" })
+                        {
+                            if (!vertexBuffer->hasAttribute(attributeName))
+                                continue;
+
+                            auto direction = &*vertex + vertexBuffer->attribute(attributeName).offset;
+                            auto transformedDirection = normalMatrix * math::make_vec3(direction);
+
+                            std::copy(&transformedDirection.x, &transformedDirection.x + 3, direction);
+                        }
+                    }
+
+                    vertex += localVertexSize;
+                }
+
+                cellIndices[j] = cellIndexAt(
+                    math::make_vec3(&record[j * vertexSize + positionAttributeOffset]),
+                    minBound,
+                    maxBound,
+                    resolution
+                );
+            }
+
+            if (cellIndices[0] != cellIndices[1] || cellIndices[1] != cellIndices[2])
+                protectRecordPositions(record.data(), vertexSize, positionAttributeOffset, protectedPositions);
+
+            binner.push(cellIndices[0], record.data(), recordSize);
+        }
+
+        if (!_options.instanceSurfacePredicate(surface))
+        {
+            geometry->disposeIndexBufferData();
+            geometry->disposeVertexBufferData();
+        }
+    }
+
+    binner.flush();
+
+    for (auto i = 0; i < numCells; ++i)
+    {
+        if (binner.numTriangles()[i] == 0u)
+            continue;
+
+        auto cell = OutOfCoreCell();
+
+        cell.filename = filenames[i];
+        cell.depth = depth;
+        cell.numTriangles = binner.numTriangles()[i];
+
+        cellBoundsAt(i, minBound, maxBound, resolution, cell.minBound, cell.maxBound);
+
+        cells.push_back(cell);
+    }
+}
+
+void
+MeshPartitioner::binCell(const OutOfCoreCell&           cell,
+                         unsigned int                   vertexSize,
+                         unsigned int                   positionAttributeOffset,
+                         std::vector<OutOfCoreCell>&    cells,
+                         ProtectedPositionIndexPtr      protectedPositions)
+{
+    static const auto resolution = 2;
+    static const auto numCells = 8;
+
+    const auto recordSize = 3u * vertexSize;
+
+    auto filenames = std::vector<std::string>(numCells);
+
+    for (auto& filename : filenames)
+        filename = outOfCoreCellFilename();
+
+    const auto bufferSize = std::max<std::size_t>(outOfCoreCellMemoryBudget(protectedPositions) / 4u, recordSize * sizeof(float));
+
+    OutOfCoreCellBinner binner(filenames, bufferSize);
+
+    std::ifstream file(cell.filename, std::ios::in | std::ios::binary);
+
+    if (!file.is_open())
+        throw std::runtime_error("MeshPartitioner: failed to open temporary file " + cell.filename);
+
+    const auto numRecordsPerChunk = std::max<std::size_t>(bufferSize / (recordSize * sizeof(float)), 1u);
+
+    auto chunk = std::vector<float>(numRecordsPerChunk * recordSize);
+
+    while (file)
+    {
+        file.read(reinterpret_cast<char*>(chunk.data()), chunk.size() * sizeof(float));
+
+        const auto numRecords = static_cast<std::size_t>(file.gcount()) / (recordSize * sizeof(float));
+
+        for (auto i = 0u; i < numRecords; ++i)
+        {
+            auto record = chunk.data() + i * recordSize;
+
+            auto cellIndices = std::array<int, 3>();
+
+            for (auto j = 0u; j < 3u; ++j)
+            {
+                cellIndices[j] = cellIndexAt(
+                    math::make_vec3(&record[j * vertexSize + positionAttributeOffset]),
+                    cell.minBound,
+                    cell.maxBound,
+                    resolution
+                );
+            }
+
+            if (cellIndices[0] != cellIndices[1] || cellIndices[1] != cellIndices[2])
+                protectRecordPositions(record, vertexSize, positionAttributeOffset, protectedPositions);
+
+            binner.push(cellIndices[0], record, recordSize);
+        }
+    }
+
+    binner.flush();
+
+    for (auto i = 0; i < numCells; ++i)
+    {
+        if (binner.numTriangles()[i] == 0u)
+            continue;
+
+        auto childCell = OutOfCoreCell();
+
+        childCell.filename = filenames[i];
+        childCell.depth = cell.depth + 1;
+        childCell.numTriangles = binner.numTriangles()[i];
+
+        cellBoundsAt(i, cell.minBound, cell.maxBound, resolution, childCell.minBound, childCell.maxBound);
+
+        cells.push_back(childCell);
+    }
+}
+
+bool
+MeshPartitioner::processOutOfCoreCell(Node::Ptr                     node,
+                                      const OutOfCoreCell&          cell,
+                                      PartitionInfo&                partitionInfo,
+                                      ProtectedPositionIndexPtr     protectedPositions,
+                                      std::vector<Geometry::Ptr>&   geometries)
+{
+    if (statusChanged() && statusChanged()->numCallbacks() > 0u)
+    {
+        statusChanged()->execute(
+            shared_from_this(),
+            "MeshPartitioner: processing out-of-core cell with " + std::to_string(cell.numTriangles) + " triangles"
+        );
+    }
+
+    const auto vertexSize = partitionInfo.vertexSize;
+    const auto recordSize = 3u * vertexSize;
+
+    auto records = std::vector<float>(cell.numTriangles * recordSize);
+
+    std::ifstream file(cell.filename, std::ios::in | std::ios::binary);
+
+    if (!file.is_open())
+        throw std::runtime_error("MeshPartitioner: failed to open temporary file " + cell.filename);
+
+    file.read(reinterpret_cast<char*>(records.data()), records.size() * sizeof(float));
+    file.close();
+
+    auto cellInfo = PartitionInfo();
+
+    cellInfo.surfaces = partitionInfo.surfaces;
+    cellInfo.useRootSpace = partitionInfo.useRootSpace;
+    cellInfo.isInstance = partitionInfo.isInstance;
+    cellInfo.vertexSize = vertexSize;
+    cellInfo.positionAttributeOffset = partitionInfo.positionAttributeOffset;
+    cellInfo.minBound = cell.minBound;
+    cellInfo.maxBound = cell.maxBound;
+    cellInfo.mergedIndices = math::UnorderedSpatialIndex<std::unordered_set<unsigned int>>::create();
+
+    auto& indices = cellInfo.indices;
+    auto& vertices = cellInfo.vertices;
+
+    indices.reserve(cell.numTriangles * 3u);
+
+    // binned triangles carry their own vertex copies, identical vertices are welded back into an indexed mesh
+    auto vertexHash = [&](unsigned int index) -> std::size_t
+    {
+        auto hashValue = std::size_t();
+
+        for (auto i = 0u; i < vertexSize; ++i)
+            minko::hash_combine<float, std::hash<float>>(hashValue, vertices[index * vertexSize + i]);
+
+        return hashValue;
+    };
+
+    auto vertexEqual = [&](unsigned int left, unsigned int right) -> bool
+    {
+        return std::equal(
+            vertices.begin() + left * vertexSize,
+            vertices.begin() + (left + 1) * vertexSize,
+            vertices.begin() + right * vertexSize
+        );
+    };
+
+    auto vertexIndices = std::unordered_set<
+        unsigned int,
+        std::function<std::size_t(unsigned int)>,
+        std::function<bool(unsigned int, unsigned int)>
+    >(cell.numTriangles * 3u, vertexHash, vertexEqual);
+
+    for (auto i = 0u; i < cell.numTriangles; ++i)
+    {
+        for (auto j = 0u; j < 3u; ++j)
+        {
+            const auto vertex = records.begin() + i * recordSize + j * vertexSize;
+            const auto candidateIndex = static_cast<unsigned int>(vertices.size() / vertexSize);
+
+            vertices.insert(vertices.end(), vertex, vertex + vertexSize);
+
+            auto vertexIndexIt = vertexIndices.insert(candidateIndex);
+
+            if (!vertexIndexIt.second)
+                vertices.resize(vertices.size() - vertexSize);
+
+            indices.push_back(*vertexIndexIt.first);
+        }
+    }
+
+    records.clear();
+    records.shrink_to_fit();
+
+    vertexIndices.clear();
+
+    buildHalfEdges(cellInfo);
+
+    const auto numVertices = vertices.size() / vertexSize;
+
+    for (auto i = 0u; i < numVertices; ++i)
+    {
+        if (protectedPositions->find(positionAt(i, cellInfo)) != protectedPositions->end())
+            cellInfo.protectedIndices.insert(i);
+    }
+
+    buildPartitions(cellInfo);
+
+    cellInfo.baseDepth = -cell.depth;
+
+    return buildGeometries(node, cellInfo, geometries);
+}
+
 bool
 MeshPartitioner::patchNode(Node::Ptr                            node,
                            PartitionInfo&                       partitionInfo,
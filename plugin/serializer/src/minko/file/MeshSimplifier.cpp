@@ -0,0 +1,577 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/data/HalfEdge.hpp"
+#include "minko/data/HalfEdgeCollection.hpp"
+#include "minko/file/MeshSimplifier.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/math/UnorderedSpatialIndex.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/render/VertexBuffer.hpp"
+
+using namespace minko;
+using namespace minko::data;
+using namespace minko::file;
+using namespace minko::geometry;
+using namespace minko::render;
+
+MeshSimplifier::Options::Options() :
+    numLods(4),
+    reductionRate(0.5f),
+    minNumTriangles(16u),
+    maxError(0.f),
+    attributeWeight(0.1f),
+    borderWeight(10.f),
+    maxNormalDeviation(0.2f),
+    lockBorders(false)
+{
+}
+
+MeshSimplifier::Quadric::Quadric() :
+    a2(0.0), ab(0.0), ac(0.0), ad(0.0),
+    b2(0.0), bc(0.0), bd(0.0),
+    c2(0.0), cd(0.0),
+    d2(0.0)
+{
+}
+
+MeshSimplifier::Quadric::Quadric(double a, double b, double c, double d, double weight) :
+    a2(weight * a * a), ab(weight * a * b), ac(weight * a * c), ad(weight * a * d),
+    b2(weight * b * b), bc(weight * b * c), bd(weight * b * d),
+    c2(weight * c * c), cd(weight * c * d),
+    d2(weight * d * d)
+{
+}
+
+MeshSimplifier::Quadric&
+MeshSimplifier::Quadric::operator+=(const Quadric& other)
+{
+    a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+    b2 += other.b2; bc += other.bc; bd += other.bd;
+    c2 += other.c2; cd += other.cd;
+    d2 += other.d2;
+
+    return *this;
+}
+
+double
+MeshSimplifier::Quadric::evaluate(const math::vec3& position) const
+{
+    const double x = position.x;
+    const double y = position.y;
+    const double z = position.z;
+
+    return a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x +
+           b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y +
+           c2 * z * z + 2.0 * cd * z +
+           d2;
+}
+
+static
+std::pair<unsigned int, unsigned int>
+edge(unsigned int first, unsigned int second)
+{
+    return first < second ? std::make_pair(first, second) : std::make_pair(second, first);
+}
+
+void
+MeshSimplifier::buildLods(Geometry::Ptr geometry, std::vector<Lod>& lods)
+{
+    auto indices = std::vector<unsigned int>();
+
+    auto ushortIndexDataPointer = geometry->indices()->dataPointer<unsigned short>();
+
+    if (ushortIndexDataPointer)
+        indices.assign(ushortIndexDataPointer->begin(), ushortIndexDataPointer->end());
+    else
+        indices = *geometry->indices()->dataPointer<unsigned int>();
+
+    const auto numVertices = geometry->numVertices();
+    const auto vertexSize = geometry->vertexSize();
+
+    auto vertices = std::vector<float>(numVertices * vertexSize);
+    auto lockedVertices = std::vector<bool>(numVertices, false);
+
+    auto positionAttributeOffset = 0u;
+    auto globalVertexAttributeOffset = 0u;
+
+    for (auto vertexBuffer : geometry->vertexBuffers())
+    {
+        const auto localVertexSize = vertexBuffer->vertexSize();
+        const auto& localVertices = vertexBuffer->data();
+
+        if (vertexBuffer->hasAttribute("position"))
+            positionAttributeOffset = globalVertexAttributeOffset + vertexBuffer->attribute("position").offset;
+
+        for (auto i = 0u; i < numVertices; ++i)
+        {
+            std::copy(
+                localVertices.begin() + i * localVertexSize,
+                localVertices.begin() + (i + 1) * localVertexSize,
+                vertices.begin() + i * vertexSize + globalVertexAttributeOffset
+            );
+        }
+
+        if (vertexBuffer->hasAttribute("popProtected"))
+        {
+            const auto protectedFlagOffset = vertexBuffer->attribute("popProtected").offset;
+
+            for (auto i = 0u; i < numVertices; ++i)
+                lockedVertices[i] = localVertices[i * localVertexSize + protectedFlagOffset] != 0.f;
+        }
+
+        globalVertexAttributeOffset += localVertexSize;
+    }
+
+    buildLods(indices, vertices, vertexSize, positionAttributeOffset, lockedVertices, lods);
+}
+
+void
+MeshSimplifier::buildLods(const std::vector<unsigned int>&  indices,
+                          const std::vector<float>&         vertices,
+                          unsigned int                      vertexSize,
+                          unsigned int                      positionAttributeOffset,
+                          const std::vector<bool>&          lockedVertices,
+                          std::vector<Lod>&                 lods)
+{
+    auto info = SimplificationInfo();
+
+    info.vertexSize = vertexSize;
+    info.positionAttributeOffset = positionAttributeOffset;
+    info.vertices = &vertices;
+    info.lockedVertices = lockedVertices;
+
+    initialize(indices, info);
+
+    for (auto i = 0; i < _options.numLods; ++i)
+    {
+        const auto previousNumTriangles = info.numTriangles;
+
+        const auto targetNumTriangles = std::max(
+            _options.minNumTriangles,
+            static_cast<unsigned int>(previousNumTriangles * _options.reductionRate)
+        );
+
+        if (targetNumTriangles >= previousNumTriangles)
+            break;
+
+        simplify(targetNumTriangles, info);
+
+        if (info.numTriangles == previousNumTriangles)
+            break;
+
+        auto lod = Lod();
+
+        extractIndices(info, lod.indices);
+        lod.error = static_cast<float>(std::sqrt(info.maxError));
+
+        lods.push_back(lod);
+    }
+}
+
+void
+MeshSimplifier::initialize(const std::vector<unsigned int>& indices,
+                           SimplificationInfo&              info)
+{
+    const auto& vertices = *info.vertices;
+    const auto numVertices = vertices.size() / info.vertexSize;
+
+    info.positions.resize(numVertices);
+    info.quadrics.resize(numVertices);
+    info.surfaceQuadrics.resize(numVertices);
+    info.versions.resize(numVertices, 0u);
+    info.removedVertices.resize(numVertices, false);
+    info.lockedVertices.resize(numVertices, false);
+    info.borderVertices.resize(numVertices, false);
+    info.vertexTriangles.resize(numVertices);
+    info.numTriangles = 0u;
+    info.maxError = 0.0;
+
+    for (auto i = 0u; i < numVertices; ++i)
+        info.positions[i] = math::make_vec3(&vertices[i * info.vertexSize + info.positionAttributeOffset]);
+
+    for (auto i = 0u; i + 2u < indices.size(); i += 3u)
+    {
+        const auto triangle = std::array<unsigned int, 3> { { indices[i], indices[i + 1u], indices[i + 2u] } };
+
+        if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2])
+            continue;
+
+        const auto& p0 = info.positions[triangle[0]];
+        const auto& p1 = info.positions[triangle[1]];
+        const auto& p2 = info.positions[triangle[2]];
+
+        const auto normal = math::cross(p1 - p0, p2 - p0);
+        const auto normalLength = math::length(normal);
+
+        if (normalLength > 0.f)
+        {
+            const auto unitNormal = normal / normalLength;
+
+            const auto quadric = Quadric(
+                unitNormal.x,
+                unitNormal.y,
+                unitNormal.z,
+                -math::dot(unitNormal, p0),
+                1.0
+            );
+
+            for (auto index : triangle)
+            {
+                info.quadrics[index] += quadric;
+                info.surfaceQuadrics[index] += quadric;
+            }
+        }
+
+        const auto triangleIndex = static_cast<unsigned int>(info.triangles.size());
+
+        info.triangles.push_back(triangle);
+
+        for (auto index : triangle)
+            info.vertexTriangles[index].push_back(triangleIndex);
+    }
+
+    info.removedTriangles.resize(info.triangles.size(), false);
+    info.numTriangles = info.triangles.size();
+
+    auto validIndices = std::vector<unsigned int>();
+
+    validIndices.reserve(info.triangles.size() * 3u);
+
+    for (const auto& triangle : info.triangles)
+        validIndices.insert(validIndices.end(), triangle.begin(), triangle.end());
+
+    // border edges only have one half-edge, they constrain collapses to slide along the border
+    auto halfEdgeCollection = HalfEdgeCollection::create(validIndices);
+
+    for (auto halfEdge : halfEdgeCollection->halfEdges())
+    {
+        if (halfEdge->adjacent() != nullptr)
+            continue;
+
+        const auto start = halfEdge->startNodeId();
+        const auto end = halfEdge->endNodeId();
+
+        info.borderEdges.insert(edge(start, end));
+
+        info.borderVertices[start] = true;
+        info.borderVertices[end] = true;
+
+        const auto& startPosition = info.positions[start];
+        const auto& endPosition = info.positions[end];
+        const auto& thirdPosition = info.positions[halfEdge->getThirdVertex()];
+
+        const auto edgeVector = endPosition - startPosition;
+        const auto faceNormal = math::cross(edgeVector, thirdPosition - startPosition);
+        const auto borderNormal = math::cross(faceNormal, edgeVector);
+        const auto borderNormalLength = math::length(borderNormal);
+
+        if (borderNormalLength <= 0.f)
+            continue;
+
+        const auto unitBorderNormal = borderNormal / borderNormalLength;
+
+        const auto quadric = Quadric(
+            unitBorderNormal.x,
+            unitBorderNormal.y,
+            unitBorderNormal.z,
+            -math::dot(unitBorderNormal, startPosition),
+            _options.borderWeight
+        );
+
+        info.quadrics[start] += quadric;
+        info.quadrics[end] += quadric;
+    }
+
+    // attribute seams split vertices sharing the same position, collapsing only one side would open cracks
+    auto positionToVertexCount = math::UnorderedSpatialIndex<unsigned int>::create();
+
+    for (auto i = 0u; i < numVertices; ++i)
+        if (!info.vertexTriangles[i].empty())
+            ++positionToVertexCount->at(info.positions[i]);
+
+    for (auto i = 0u; i < numVertices; ++i)
+    {
+        if (info.vertexTriangles[i].empty())
+            continue;
+
+        if (positionToVertexCount->at(info.positions[i]) > 1u ||
+            (_options.lockBorders && info.borderVertices[i]))
+            info.lockedVertices[i] = true;
+    }
+
+    for (const auto& triangle : info.triangles)
+    {
+        for (auto i = 0u; i < 3u; ++i)
+        {
+            pushCollapse(triangle[i], triangle[(i + 1u) % 3u], info);
+            pushCollapse(triangle[(i + 1u) % 3u], triangle[i], info);
+        }
+    }
+}
+
+double
+MeshSimplifier::attributeError(unsigned int                 source,
+                               unsigned int                 target,
+                               const SimplificationInfo&    info) const
+{
+    const auto& vertices = *info.vertices;
+
+    auto error = 0.0;
+
+    for (auto i = 0u; i < info.vertexSize; ++i)
+    {
+        if (i >= info.positionAttributeOffset && i < info.positionAttributeOffset + 3u)
+            continue;
+
+        const double delta = vertices[source * info.vertexSize + i] - vertices[target * info.vertexSize + i];
+
+        error += delta * delta;
+    }
+
+    return _options.attributeWeight * error;
+}
+
+void
+MeshSimplifier::pushCollapse(unsigned int           source,
+                             unsigned int           target,
+                             SimplificationInfo&    info)
+{
+    if (info.lockedVertices[source])
+        return;
+
+    if (info.borderVertices[source] && info.borderEdges.find(edge(source, target)) == info.borderEdges.end())
+        return;
+
+    auto quadric = info.quadrics[source];
+    auto surfaceQuadric = info.surfaceQuadrics[source];
+
+    quadric += info.quadrics[target];
+    surfaceQuadric += info.surfaceQuadrics[target];
+
+    auto collapse = Collapse();
+
+    // the border and attribute terms only rank the collapses, the error is the distance to the original surface
+    collapse.error = std::max(0.0, surfaceQuadric.evaluate(info.positions[target]));
+    collapse.cost = std::max(0.0, quadric.evaluate(info.positions[target])) + attributeError(source, target, info);
+    collapse.source = source;
+    collapse.target = target;
+    collapse.sourceVersion = info.versions[source];
+    collapse.targetVersion = info.versions[target];
+
+    info.collapses.push(collapse);
+}
+
+bool
+MeshSimplifier::collapseIsValid(unsigned int        source,
+                                unsigned int        target,
+                                SimplificationInfo& info) const
+{
+    if (info.removedVertices[source] || info.removedVertices[target] || info.lockedVertices[source])
+        return false;
+
+    if (info.borderVertices[source] && info.borderEdges.find(edge(source, target)) == info.borderEdges.end())
+        return false;
+
+    auto sourceNeighbors = std::unordered_set<unsigned int>();
+    auto numSharedTriangles = 0u;
+
+    for (auto triangleIndex : info.vertexTriangles[source])
+    {
+        if (info.removedTriangles[triangleIndex])
+            continue;
+
+        const auto& triangle = info.triangles[triangleIndex];
+
+        for (auto index : triangle)
+            if (index != source && index != target)
+                sourceNeighbors.insert(index);
+
+        if (std::find(triangle.begin(), triangle.end(), target) != triangle.end())
+        {
+            ++numSharedTriangles;
+
+            continue;
+        }
+
+        // the triangle is kept once the source moves onto the target: it must not flip or degenerate
+        const auto& p0 = info.positions[triangle[0]];
+        const auto& p1 = info.positions[triangle[1]];
+        const auto& p2 = info.positions[triangle[2]];
+
+        const auto previousNormal = math::cross(p1 - p0, p2 - p0);
+
+        auto positions = std::array<math::vec3, 3> { { p0, p1, p2 } };
+
+        for (auto i = 0u; i < 3u; ++i)
+            if (triangle[i] == source)
+                positions[i] = info.positions[target];
+
+        const auto normal = math::cross(positions[1] - positions[0], positions[2] - positions[0]);
+
+        const auto previousNormalLength = math::length(previousNormal);
+        const auto normalLength = math::length(normal);
+
+        if (normalLength <= 0.f || previousNormalLength <= 0.f)
+            return false;
+
+        if (math::dot(previousNormal, normal) / (previousNormalLength * normalLength) < _options.maxNormalDeviation)
+            return false;
+    }
+
+    if (numSharedTriangles == 0u)
+        return false;
+
+    // link condition: the only vertices shared by both one-rings are the apexes of the collapsed triangles
+    auto numCommonNeighbors = 0u;
+
+    for (auto triangleIndex : info.vertexTriangles[target])
+    {
+        if (info.removedTriangles[triangleIndex])
+            continue;
+
+        for (auto index : info.triangles[triangleIndex])
+        {
+            if (index != target && sourceNeighbors.erase(index) > 0u)
+                ++numCommonNeighbors;
+        }
+    }
+
+    return numCommonNeighbors == numSharedTriangles;
+}
+
+void
+MeshSimplifier::collapse(unsigned int           source,
+                         unsigned int           target,
+                         SimplificationInfo&    info)
+{
+    auto neighbors = std::unordered_set<unsigned int>();
+
+    for (auto triangleIndex : info.vertexTriangles[source])
+    {
+        if (info.removedTriangles[triangleIndex])
+            continue;
+
+        auto& triangle = info.triangles[triangleIndex];
+
+        for (auto index : triangle)
+            if (index != source)
+                neighbors.insert(index);
+
+        if (std::find(triangle.begin(), triangle.end(), target) != triangle.end())
+        {
+            info.removedTriangles[triangleIndex] = true;
+
+            --info.numTriangles;
+
+            continue;
+        }
+
+        std::replace(triangle.begin(), triangle.end(), source, target);
+
+        info.vertexTriangles[target].push_back(triangleIndex);
+    }
+
+    if (info.borderVertices[source])
+    {
+        for (auto neighbor : neighbors)
+        {
+            if (info.borderEdges.erase(edge(source, neighbor)) > 0u && neighbor != target)
+                info.borderEdges.insert(edge(target, neighbor));
+        }
+    }
+
+    info.quadrics[target] += info.quadrics[source];
+    info.surfaceQuadrics[target] += info.surfaceQuadrics[source];
+
+    info.removedVertices[source] = true;
+    info.vertexTriangles[source].clear();
+
+    ++info.versions[source];
+    ++info.versions[target];
+
+    auto& targetTriangles = info.vertexTriangles[target];
+
+    targetTriangles.erase(
+        std::remove_if(targetTriangles.begin(), targetTriangles.end(), [&](unsigned int triangleIndex)
+        {
+            return info.removedTriangles[triangleIndex];
+        }),
+        targetTriangles.end()
+    );
+
+    auto targetNeighbors = std::unordered_set<unsigned int>();
+
+    for (auto triangleIndex : targetTriangles)
+        for (auto index : info.triangles[triangleIndex])
+            if (index != target)
+                targetNeighbors.insert(index);
+
+    for (auto neighbor : targetNeighbors)
+    {
+        pushCollapse(target, neighbor, info);
+        pushCollapse(neighbor, target, info);
+    }
+}
+
+void
+MeshSimplifier::simplify(unsigned int           targetNumTriangles,
+                         SimplificationInfo&    info)
+{
+    const auto maxCost = double(_options.maxError) * double(_options.maxError);
+
+    while (info.numTriangles > targetNumTriangles && !info.collapses.empty())
+    {
+        const auto collapse = info.collapses.top();
+
+        if (maxCost > 0.0 && collapse.error > maxCost)
+            break;
+
+        info.collapses.pop();
+
+        if (collapse.sourceVersion != info.versions[collapse.source] ||
+            collapse.targetVersion != info.versions[collapse.target])
+            continue;
+
+        if (!collapseIsValid(collapse.source, collapse.target, info))
+            continue;
+
+        this->collapse(collapse.source, collapse.target, info);
+
+        info.maxError = std::max(info.maxError, collapse.error);
+    }
+}
+
+void
+MeshSimplifier::extractIndices(const SimplificationInfo&    info,
+                               std::vector<unsigned int>&   indices)
+{
+    indices.clear();
+    indices.reserve(info.numTriangles * 3u);
+
+    for (auto i = 0u; i < info.triangles.size(); ++i)
+    {
+        if (info.removedTriangles[i])
+            continue;
+
+        const auto& triangle = info.triangles[i];
+
+        indices.insert(indices.end(), triangle.begin(), triangle.end());
+    }
+}
@@ -46,6 +46,7 @@ POPGeometryParser::POPGeometryParser() :
     _maxLod(0),
     _minBound(),
     _maxBound(),
+    _simplifiedLods(false),
     _vertexSize(0),
     _vertexAttributes(),
     _lods(),
@@ -135,6 +136,8 @@ POPGeometryParser::parsed(const std::string&                 filename,
         );
     }
 
+    updateResidentMemory();
+
     if (!options->trackAssetDescriptor())
         return;
 
@@ -285,6 +288,9 @@ POPGeometryParser::createPOPGeometry(AssetLibrary::Ptr      assetLibrary,
 
     popGeometry->data()->set("popFullPrecisionLod", float(_fullPrecisionLod));
 
+    if (_simplifiedLods)
+        popGeometry->data()->set("popSimplifiedLods", true);
+
     if (streamingOptions()->popGeometryFunction())
     {
         popGeometry = streamingOptions()->popGeometryFunction()(
@@ -344,6 +350,10 @@ POPGeometryParser::headerParsed(const std::vector<unsigned char>&    data,
         _maxDeltaBorderPrecision = headerData.get<11>();
     }
 
+    _simplifiedLods = false;
+
+    unpackArrayElement(_simplifiedLods, data, data.size(), 13u);
+
     for (auto i = 0; i < _lodCount; ++i)
     {
         const auto& lodData = headerData.get<12>().at(i);
@@ -460,14 +470,22 @@ POPGeometryParser::lodParsed(int                                 previousLod,
         }
         else
         {
-            auto& indexData = indexBuffer->data();
-
-            if (indexData.size() < geometryIndexOffset + indices.size())
-                indexData.resize(geometryIndexOffset + indices.size());
+            auto u32IndexData = indexBuffer->dataPointer<unsigned int>();
 
-            std::copy(indices.begin(), indices.end(), indexData.begin() + geometryIndexOffset);
+            const auto indexDataGrown = u32IndexData != nullptr
+                ? copyLodData(*u32IndexData, indices, geometryIndexOffset)
+                : copyLodData(indexBuffer->data(), indices, geometryIndexOffset);
 
-            indexBuffer->upload(geometryIndexOffset, lodInfo.indexCount);
+            // the GPU storage was shrunk by lodEvicted() and must be allocated again
+            if (indexDataGrown)
+            {
+                indexBuffer->orphan();
+                indexBuffer->upload();
+            }
+            else
+            {
+                indexBuffer->upload(geometryIndexOffset, lodInfo.indexCount);
+            }
         }
 
         auto geometryVertexOffset = _geometryVertexOffset;
@@ -487,19 +505,13 @@ POPGeometryParser::lodParsed(int                                 previousLod,
                 {
                     vertexBuffer->upload(geometryVertexOffset, lodInfo.vertexCount, vertices);
                 }
+                else if (copyLodData(vertexBuffer->data(), vertices, localVertexOffset))
+                {
+                    vertexBuffer->orphan();
+                    vertexBuffer->upload();
+                }
                 else
                 {
-                    auto& vertexData = vertexBuffer->data();
-
-                    if (vertexData.size() < localVertexOffset + vertices.size())
-                        vertexData.resize(localVertexOffset + vertices.size());
-
-                    std::copy(
-                        vertices.begin(),
-                        vertices.end(),
-                        vertexData.begin() + localVertexOffset
-                    );
-
                     vertexBuffer->upload(geometryVertexOffset, lodInfo.vertexCount);
                 }
             }
@@ -523,6 +535,160 @@ POPGeometryParser::lodParsed(int                                 previousLod,
         this->data()->set("availableLods", availableLods);
         this->data()->set("maxAvailableLod", lodInfoRangeEndIt->second.level);
     }
+
+    updateResidentMemory();
+}
+
+int
+POPGeometryParser::lodEvicted(int residentLod, int lod)
+{
+    if (_geometry == nullptr || _geometry->indices() == nullptr || _lods.empty() || !data())
+        return residentLod;
+
+    // LODs are appended to the buffers in increasing order, the LODs that are kept
+    // are a prefix of each buffer
+    const auto keptLod = std::max(lod, _lods.begin()->first);
+
+    auto newResidentLod = -1;
+    auto numIndices = 0;
+    auto numVertices = 0;
+
+    for (const auto& levelToLodPair : _lods)
+    {
+        const auto& lodInfo = levelToLodPair.second;
+
+        if (lodInfo.level > keptLod || lodInfo.level > residentLod)
+            break;
+
+        newResidentLod = lodInfo.level;
+        numIndices += lodInfo.indexCount;
+        numVertices += lodInfo.vertexCount;
+    }
+
+    if (newResidentLod < 0 || newResidentLod >= residentLod)
+        return residentLod;
+
+    auto indexBuffer = _geometry->indices();
+    auto u32IndexData = indexBuffer->dataPointer<unsigned int>();
+
+    const auto indexDataIsDisposed = u32IndexData != nullptr ? u32IndexData->empty() : indexBuffer->data().empty();
+    auto vertexDataIsDisposed = true;
+
+    for (auto vertexBuffer : _geometry->vertexBuffers())
+        vertexDataIsDisposed = vertexDataIsDisposed && vertexBuffer->data().empty();
+
+    // disposed buffers can't be reallocated without their data, evicting their LODs would
+    // not release any memory
+    if (indexDataIsDisposed && vertexDataIsDisposed)
+        return residentLod;
+
+    _geometryIndexOffset = numIndices;
+    _geometryVertexOffset = numVertices;
+
+    // the buffers are reallocated to their kept prefix, lodParsed() grows them again
+    if (!indexDataIsDisposed)
+    {
+        if (u32IndexData != nullptr)
+            shrinkLodData(*u32IndexData, numIndices);
+        else
+            shrinkLodData(indexBuffer->data(), numIndices);
+
+        indexBuffer->orphan();
+        indexBuffer->upload();
+    }
+
+    for (auto vertexBuffer : _geometry->vertexBuffers())
+    {
+        auto& vertexData = vertexBuffer->data();
+
+        if (vertexData.empty())
+            continue;
+
+        shrinkLodData(vertexData, numVertices * vertexBuffer->vertexSize());
+
+        vertexBuffer->orphan();
+        vertexBuffer->upload();
+    }
+
+    auto availableLods = data()->get<std::map<int, ProgressiveOrderedMeshLodInfo>>("availableLods");
+
+    for (auto& levelToLodPair : availableLods)
+    {
+        auto& lodInfo = levelToLodPair.second;
+
+        if (lodInfo._level > newResidentLod)
+            lodInfo = ProgressiveOrderedMeshLodInfo(lodInfo._level, lodInfo._precisionLevel);
+    }
+
+    data()->set("availableLods", availableLods);
+    data()->set("maxAvailableLod", newResidentLod);
+
+    updateResidentMemory();
+
+    return newResidentLod;
+}
+
+void
+POPGeometryParser::updateResidentMemory()
+{
+    if (_geometry == nullptr || _geometry->indices() == nullptr || !data())
+        return;
+
+    auto numIndices = 0u;
+    auto numVertices = 0u;
+
+    for (const auto& levelToLodPair : _lods)
+    {
+        numIndices += levelToLodPair.second.indexCount;
+        numVertices += levelToLodPair.second.vertexCount;
+    }
+
+    auto cpuMemory = std::size_t(0);
+    auto gpuMemory = std::size_t(0);
+
+    // the GPU storage of a buffer is the size of its data, or the size of the whole geometry
+    // when its data was disposed after loading, see createPOPGeometry() and lodEvicted()
+    auto indexBuffer = _geometry->indices();
+    auto u32IndexData = indexBuffer->dataPointer<unsigned int>();
+
+    const auto indexDataSize = u32IndexData != nullptr ? u32IndexData->size() : indexBuffer->data().size();
+    const auto indexDataCapacity = u32IndexData != nullptr ? u32IndexData->capacity() : indexBuffer->data().capacity();
+
+    cpuMemory += indexDataCapacity * indexBuffer->indexSize();
+    gpuMemory += (indexDataSize > 0 ? indexDataSize : numIndices) * indexBuffer->indexSize();
+
+    for (auto vertexBuffer : _geometry->vertexBuffers())
+    {
+        const auto& vertexData = vertexBuffer->data();
+
+        cpuMemory += vertexData.capacity() * sizeof(float);
+        gpuMemory += (!vertexData.empty() ? vertexData.size() : numVertices * vertexBuffer->vertexSize()) * sizeof(float);
+    }
+
+    data()->set("residentCpuMemory", static_cast<uint>(cpuMemory));
+    data()->set("residentGpuMemory", static_cast<uint>(gpuMemory));
+}
+
+template <typename T, typename U>
+bool
+POPGeometryParser::copyLodData(std::vector<T>& bufferData, const std::vector<U>& lodData, std::size_t offset)
+{
+    const auto grown = bufferData.size() < offset + lodData.size();
+
+    if (grown)
+        bufferData.resize(offset + lodData.size());
+
+    std::copy(lodData.begin(), lodData.end(), bufferData.begin() + offset);
+
+    return grown;
+}
+
+template <typename T>
+void
+POPGeometryParser::shrinkLodData(std::vector<T>& bufferData, std::size_t size)
+{
+    bufferData.resize(size);
+    bufferData.shrink_to_fit();
 }
 
 void
@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/Transform.hpp"
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/file/LinkedAsset.hpp"
+#include "minko/file/MeshSimplifier.hpp"
 #include "minko/file/Options.hpp"
 #include "minko/file/POPGeometryWriter.hpp"
 #include "minko/file/StreamingOptions.hpp"
@@ -51,6 +52,7 @@ POPGeometryWriter::POPGeometryWriter() :
     AbstractWriter<Geometry::Ptr>(),
     _assetLibrary(),
     _geometry(),
+    _simplifiedLods(false),
     _rangeFunction(std::bind(
         &POPGeometryWriter::defaultRangeFunction,
         std::placeholders::_1,
@@ -247,6 +249,15 @@ POPGeometryWriter::buildLodData(std::map<int, LodData>& lodData,
     static const auto minBoxSize = 1.0E-7f;
     boxSize = glm::max(math::vec3(minBoxSize), boxSize);
 
+    _simplifiedLods = _streamingOptions->popGeometrySimplificationEnabled();
+
+    if (_simplifiedLods)
+    {
+        buildSimplifiedLodData(lodData, boxSize);
+
+        return;
+    }
+
     for (auto level = maxLevel; level >= minLevel - 1; --level)
     {
         auto& currentOrderedBuffer = orderedBufferMap[level == maxLevel ? _fullPrecisionLevel : level + 1];
@@ -321,6 +332,53 @@ POPGeometryWriter::buildLodData(std::map<int, LodData>& lodData,
         orderedBuffer.insert(orderedBuffer.end(), indices.begin(), indices.end());
     }
 
+    buildOrderedLodData(orderedBufferMap, levelToPrecisionLevelMap, lodData);
+}
+
+void
+POPGeometryWriter::buildSimplifiedLodData(std::map<int, LodData>&   lodData,
+                                          const math::vec3&         boxSize)
+{
+    auto geometry = _geometry;
+
+    auto orderedBufferMap = std::map<int, std::vector<unsigned short>>();
+    auto levelToPrecisionLevelMap = std::unordered_map<int, int>();
+
+    orderedBufferMap.insert(std::make_pair(_fullPrecisionLevel, geometry->indices()->data()));
+    levelToPrecisionLevelMap.insert(std::make_pair(_fullPrecisionLevel, _fullPrecisionLevel));
+
+    auto lods = std::vector<MeshSimplifier::Lod>();
+
+    MeshSimplifier::create(_streamingOptions->meshSimplifierOptions())->buildLods(geometry, lods);
+
+    const auto diagonal = math::length(boxSize);
+
+    // the precision level of a simplified lod is the finest quantization level its error fits in,
+    // lods are sorted from finest to coarsest so the coarsest one wins when two of them collide
+    for (const auto& lod : lods)
+    {
+        const auto precisionLevel = lod.error > 0.f
+            ? math::clamp(
+                static_cast<int>(std::floor(std::log2(diagonal / lod.error))),
+                0,
+                _fullPrecisionLevel - 1
+              )
+            : _fullPrecisionLevel - 1;
+
+        orderedBufferMap[precisionLevel] = std::vector<unsigned short>(lod.indices.begin(), lod.indices.end());
+        levelToPrecisionLevelMap[precisionLevel] = precisionLevel;
+    }
+
+    buildOrderedLodData(orderedBufferMap, levelToPrecisionLevelMap, lodData);
+}
+
+void
+POPGeometryWriter::buildOrderedLodData(const std::map<int, std::vector<unsigned short>>&    orderedBufferMap,
+                                       const std::unordered_map<int, int>&                  levelToPrecisionLevelMap,
+                                       std::map<int, LodData>&                              lodData)
+{
+    auto geometry = _geometry;
+
     unsigned short currentOrderedIndex = 0;
 
     auto indexToOrderedIndexMap = std::unordered_map<unsigned short, unsigned short>();
@@ -491,7 +549,8 @@ POPGeometryWriter::serializeHeader(msgpack::sbuffer&                    headerBu
             unsigned int, std::string, unsigned int, unsigned int>
         >,
         bool, int, int,
-        std::vector<msgpack::type::tuple<int, int, int, int, int, int>>
+        std::vector<msgpack::type::tuple<int, int, int, int, int, int>>,
+        bool
     > headerData(
         _linkedAssetId,
         levelCount,
@@ -505,7 +564,8 @@ POPGeometryWriter::serializeHeader(msgpack::sbuffer&                    headerBu
         isSharedPartition,
         borderMinPrecision,
         borderMaxDeltaPrecision,
-        lodInfo
+        lodInfo,
+        _simplifiedLods
     );
 
     auto levels = std::list<int>();
@@ -103,7 +103,10 @@ StreamedAssetParserScheduler::addParser(AbstractStreamedAssetParser::Ptr parser)
     entry->parserCompleteSlot = parser->AbstractParser::complete()->connect(
         [this, entry](AbstractParser::Ptr parser)
         {
-            _entriesToRemove.insert(entry);
+            // a complete parser has a null priority, evictable ones stay idle until their
+            // LODs are evicted
+            if (!entry->parser->lodEvictionEnabled())
+                _entriesToRemove.insert(entry);
         }
     );
 
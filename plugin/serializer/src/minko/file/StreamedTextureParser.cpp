@@ -29,6 +29,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/OpenGLES2Context.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/TextureFormatInfo.hpp"
+#include "minko/render/TextureUploadQueue.hpp"
 
 using namespace minko;
 using namespace minko::component;
@@ -40,6 +41,7 @@ using namespace minko::render;
 StreamedTextureParser::StreamedTextureParser() :
     AbstractStreamedAssetParser(),
     _texture(),
+    _numPendingUploads(0u),
     _textureType(TextureType::Texture2D),
     _textureFormat(TextureFormat::RGBA),
     _textureWidth(0),
@@ -197,7 +199,11 @@ StreamedTextureParser::lodParsed(int                                 previousLod
                                  const std::vector<unsigned char>&   data,
                                  Options::Ptr                        options)
 {
+    const auto uploadAsynchronously = options->loadTexturesAsynchronously();
+
     auto dataOffset = 0u;
+    auto deferredMipLevels = std::make_shared<std::vector<std::pair<int, std::vector<unsigned char>>>>();
+    auto numDeferredBytes = 0u;
 
     for (auto lod = previousLod + 1; lod <= currentLod; ++lod)
     {
@@ -225,35 +231,75 @@ StreamedTextureParser::lodParsed(int                                 previousLod
             mipLevelDataSize = extractedLodData.size();
         }
 
-        switch (_textureType)
+        if (uploadAsynchronously)
         {
-        case TextureType::Texture2D:
+            // data is only valid until this function returns
+            deferredMipLevels->emplace_back(mipLevel, std::vector<unsigned char>(mipLevelData, mipLevelData + mipLevelDataSize));
+            numDeferredBytes += mipLevelDataSize;
+        }
+        else
         {
-            auto texture2d = std::static_pointer_cast<Texture>(_texture);
+            uploadMipLevel(mipLevel, const_cast<unsigned char*>(mipLevelData), options);
+        }
+    }
 
-            texture2d->uploadMipLevel(
-                mipLevel,
-                const_cast<unsigned char*>(mipLevelData)
-            );
+    if (!uploadAsynchronously)
+    {
+        this->data()->set("maxAvailableLod", currentLod);
 
-            if (mipLevel == 0)
-            {
-                const auto storeTextureData = !options->disposeTextureAfterLoading();
+        updateResidentMemory(currentLod);
 
-                if (storeTextureData)
-                {
-                    texture2d->data(const_cast<unsigned char*>(mipLevelData));
-                }
-            }
+        return;
+    }
 
-            break;
-        }
-        default:
-            break;
+    auto parser = std::static_pointer_cast<StreamedTextureParser>(shared_from_this());
+
+    ++_numPendingUploads;
+
+    options->assetLibrary()->textureUploadQueue()->upload(_texture, numDeferredBytes, [=]()
+    {
+        for (auto& mipLevel : *deferredMipLevels)
+            parser->uploadMipLevel(mipLevel.first, mipLevel.second.data(), options);
+
+        --parser->_numPendingUploads;
+
+        parser->data()->set("maxAvailableLod", currentLod);
+
+        parser->updateResidentMemory(currentLod);
+    });
+}
+
+void
+StreamedTextureParser::uploadMipLevel(int               mipLevel,
+                                      unsigned char*    mipLevelData,
+                                      Options::Ptr      options)
+{
+    switch (_textureType)
+    {
+    case TextureType::Texture2D:
+    {
+        auto texture2d = std::static_pointer_cast<Texture>(_texture);
+
+        texture2d->uploadMipLevel(
+            mipLevel,
+            mipLevelData
+        );
+
+        if (mipLevel == 0)
+        {
+            const auto storeTextureData = !options->disposeTextureAfterLoading();
+
+            if (storeTextureData)
+            {
+                texture2d->data(mipLevelData);
+            }
         }
-    }
 
-    this->data()->set("maxAvailableLod", currentLod);
+        break;
+    }
+    default:
+        break;
+    }
 }
 
 TextureFormat
@@ -296,6 +342,54 @@ StreamedTextureParser::completed()
 {
 }
 
+int
+StreamedTextureParser::lodEvicted(int residentLod, int lod)
+{
+    // mip levels uploaded later would be flagged as available again
+    if (_texture == nullptr || _numPendingUploads > 0)
+        return residentLod;
+
+    const auto newResidentLod = std::max(lod, 0);
+
+    if (newResidentLod >= residentLod)
+        return residentLod;
+
+    // only the finest mip level is ever kept in memory
+    if (lodToMipLevel(newResidentLod) > 0)
+        _texture->disposeData();
+
+    data()->set("maxAvailableLod", newResidentLod);
+
+    updateResidentMemory(newResidentLod);
+
+    return newResidentLod;
+}
+
+void
+StreamedTextureParser::updateResidentMemory(int residentLod)
+{
+    if (_texture == nullptr || _textureType != TextureType::Texture2D)
+        return;
+
+    auto gpuMemory = std::size_t(0);
+
+    for (auto lod = 0; lod <= residentLod; ++lod)
+    {
+        const auto mipLevel = lodToMipLevel(lod);
+
+        gpuMemory += TextureFormatInfo::textureSize(
+            _textureFormat,
+            std::max(1, _textureWidth >> mipLevel),
+            std::max(1, _textureHeight >> mipLevel)
+        );
+    }
+
+    const auto cpuMemory = std::static_pointer_cast<Texture>(_texture)->data().capacity();
+
+    data()->set("residentCpuMemory", static_cast<uint>(cpuMemory));
+    data()->set("residentGpuMemory", static_cast<uint>(gpuMemory));
+}
+
 int
 StreamedTextureParser::lodToMipLevel(int lod) const
 {
@@ -30,6 +30,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/WriterOptions.hpp"
 #include "minko/log/Logger.hpp"
 #include "minko/render/AbstractTexture.hpp"
+#include "minko/render/ImageResampler.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/TextureFormatInfo.hpp"
 
@@ -104,13 +105,41 @@ StreamedTextureWriter::embed(AssetLibrary::Ptr              assetLibrary,
 
     auto formatHeaders = std::vector<msgpack::type::tuple<int, std::vector<msgpack::type::tuple<int, int>>>>();
 
+    auto crnFormats = std::vector<TextureFormat>();
+    auto crnMipChains = std::vector<std::vector<unsigned char>>();
+
+    std::copy_if(textureFormats.begin(), textureFormats.end(), std::back_inserter(crnFormats), &CRNTranscoder::supportsFormat);
+
+    CRNTranscoder::transcode(texture, _textureType, writerOptions, crnFormats, crnMipChains);
+
     for (auto textureFormat : textureFormats)
     {
         auto formatHeader = msgpack::type::tuple<int, std::vector<msgpack::type::tuple<int, int>>>();
 
         formatHeader.get<0>() = static_cast<int>(textureFormat);
 
-        if (!_formatWriterFunctions.at(textureFormat)(_data, _textureType, writerOptions, blobStream, formatHeader.get<1>()))
+        auto crnFormatIt = std::find(crnFormats.begin(), crnFormats.end(), textureFormat);
+        auto written = false;
+
+        if (crnFormatIt != crnFormats.end())
+        {
+            const auto& mipChain = crnMipChains.at(crnFormatIt - crnFormats.begin());
+
+            written = !mipChain.empty() && writeMipLevels(
+                textureFormat,
+                texture->width(),
+                texture->height(),
+                mipChain,
+                formatHeader.get<1>(),
+                blobStream
+            );
+        }
+        else
+        {
+            written = _formatWriterFunctions.at(textureFormat)(_data, _textureType, writerOptions, blobStream, formatHeader.get<1>());
+        }
+
+        if (!written)
         {
             // TODO
             // handle error
@@ -230,22 +259,24 @@ StreamedTextureWriter::writeRGBATexture(AbstractTexture::Ptr
     const auto baseHeight = texture->originalHeight();
     const auto numComponents = textureFormat == TextureFormat::RGB ? 3 : 4;
 
-    auto mipLevelTemplate = Texture::create(
-        texture->context(),
+    // textures kept in sRGB space are filtered in linear space, the others were gamma decoded in embed()
+    auto mipMapChain = std::vector<unsigned char>();
+
+    ImageResampler::mipMapChain(
+        texture->data().data(),
         baseWidth,
         baseHeight,
-        false,
-        false,
-        true
+        mipMapChain,
+        ImageResampler::Filter::BOX,
+        writerOptions->useTextureSRGBSpace(textureType) ? TextureWriter::defaultGamma() : 1.f
     );
 
-    mipLevelTemplate->data(texture->data().data());
-
     const auto numMipLevels = AbstractTexture::numMipMaps(baseWidth, baseHeight);
 
     mipLevels.resize(numMipLevels);
 
     auto serializedDataOffset = blob.size();
+    auto mipLevelDataOffset = 0u;
 
     for (auto i = 0u; i < static_cast<unsigned>(numMipLevels); ++i)
     {
@@ -253,8 +284,13 @@ StreamedTextureWriter::writeRGBATexture(AbstractTexture::Ptr
 
         const auto mipLevelWidth = std::max(baseWidth >> i, 1u);
         const auto mipLevelHeight = std::max(baseHeight >> i, 1u);
+        const auto mipLevelSize = mipLevelWidth * mipLevelHeight * sizeof(int);
+        const auto mipLevelPixels = std::vector<unsigned char>(
+            mipMapChain.begin() + mipLevelDataOffset,
+            mipMapChain.begin() + mipLevelDataOffset + mipLevelSize
+        );
 
-        mipLevelTemplate->resize(mipLevelWidth, mipLevelHeight, true);
+        mipLevelDataOffset += mipLevelSize;
 
         auto mipLevelData = std::vector<unsigned char>();
 
@@ -264,7 +300,7 @@ StreamedTextureWriter::writeRGBATexture(AbstractTexture::Ptr
         {
             auto writer = PNGWriter::create();
 
-            writer->writeToStream(mipLevelData, mipLevelTemplate->data(), mipLevelWidth, mipLevelHeight);
+            writer->writeToStream(mipLevelData, mipLevelPixels, mipLevelWidth, mipLevelHeight);
 
             break;
         }
@@ -272,7 +308,7 @@ StreamedTextureWriter::writeRGBATexture(AbstractTexture::Ptr
         {
             auto writer = JPEGWriter::create();
 
-            writer->encode(mipLevelData, mipLevelTemplate->data(), mipLevelWidth, mipLevelHeight, numComponents, writerOptions->jpegImageQualityFactor(textureType));
+            writer->encode(mipLevelData, mipLevelPixels, mipLevelWidth, mipLevelHeight, numComponents, writerOptions->jpegImageQualityFactor(textureType));
 
             break;
         }
@@ -50,7 +50,10 @@ StreamingOptions::StreamingOptions() :
         else
             return requiredLod - activeLod;
     }),
+    _popGeometryLodPriorityFunctionIsDefault(true),
     _meshPartitionerOptions(),
+    _popGeometrySimplificationEnabled(false),
+    _meshSimplifierOptions(),
     _popGeometryPriorityFactor(1.f),
     _streamedTexturePriorityFactor(1.f),
     _popGeometryMaxPrecisionLevel(16),
@@ -61,11 +64,18 @@ StreamingOptions::StreamingOptions() :
     _popGeometryLodBlendingEnabled(false),
     _popGeometryLodBlendingPeriod(1000.f),
     _popGeometryLodBlendingMinPrecisionLevel(0),
+    _popGeometryPrefetchTime(0.f),
+    _popGeometryPrefetchPriority(1e-2f),
     _streamedTextureLodBlendingEnabled(false),
     _streamedTextureLodBlendingPeriod(1000.f),
     _maxNumActiveParsers(40),
     _requestAbortingEnabled(false),
     _abortableRequestProgressThreshold(0.8f),
+    _lodEvictionEnabled(false),
+    _lodEvictionPriorityFunction([](int residentLod, int requiredLod, std::size_t residentBytes) -> float
+    {
+        return float(residentLod - requiredLod);
+    }),
     _popGeometryFunction(),
     _popGeometryLodDependencyProperties{"modelToWorldMatrix"},
     _streamedTextureLodDependencyProperties{"modelToWorldMatrix"},
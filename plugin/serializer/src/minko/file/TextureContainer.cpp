@@ -0,0 +1,247 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/file/TextureContainer.hpp"
+
+#include "minko/render/TextureFormatInfo.hpp"
+
+using namespace minko;
+using namespace minko::file;
+using namespace minko::render;
+
+const uint TextureContainer::MAGIC_NUMBER = 0x4D4B5458; // MKTX
+const uint TextureContainer::VERSION = 1u;
+const uint TextureContainer::HEADER_SIZE = 20u;
+// large enough for any block-compressed format and for SIMD loads of the uploaded data
+const uint TextureContainer::ALIGNMENT = 16u;
+
+namespace
+{
+    inline
+    uint
+    readUInt(const unsigned char* data, uint offset)
+    {
+        return (uint)(data[offset] << 24 | data[offset + 1] << 16 | data[offset + 2] << 8 | data[offset + 3]);
+    }
+
+    inline
+    uint
+    readUShort(const unsigned char* data, uint offset)
+    {
+        return (uint)(data[offset] << 8 | data[offset + 1]);
+    }
+
+    inline
+    void
+    writeUInt(std::vector<unsigned char>& data, uint offset, uint value)
+    {
+        data[offset] = (value >> 24) & 0xff;
+        data[offset + 1] = (value >> 16) & 0xff;
+        data[offset + 2] = (value >> 8) & 0xff;
+        data[offset + 3] = value & 0xff;
+    }
+
+    inline
+    void
+    writeUShort(std::vector<unsigned char>& data, uint offset, uint value)
+    {
+        data[offset] = (value >> 8) & 0xff;
+        data[offset + 1] = value & 0xff;
+    }
+}
+
+TextureContainer::TextureContainer(uint width, uint height, uint numFaces, uint numMipLevels) :
+    _width(width),
+    _height(height),
+    _numFaces(numFaces),
+    _numMipLevels(numMipLevels),
+    _formats(),
+    _mipLevels()
+{
+}
+
+uint
+TextureContainer::align(uint offset)
+{
+    return (offset + ALIGNMENT - 1u) & ~(ALIGNMENT - 1u);
+}
+
+uint
+TextureContainer::tableOfContentsSize(const unsigned char* header, uint size)
+{
+    if (size < HEADER_SIZE || readUInt(header, 0) != MAGIC_NUMBER || readUShort(header, 4) > VERSION)
+        return 0u;
+
+    const auto numFaces = static_cast<uint>(header[16]);
+    const auto numMipLevels = static_cast<uint>(header[17]);
+    const auto numFormats = readUShort(header, 18);
+
+    return HEADER_SIZE + numFormats * (4u + numFaces * numMipLevels * 8u);
+}
+
+TextureContainer::Ptr
+TextureContainer::read(const unsigned char* data, uint size)
+{
+    const auto tocSize = tableOfContentsSize(data, size);
+
+    if (tocSize == 0u || size < tocSize)
+        return nullptr;
+
+    auto container = create(readUInt(data, 8), readUInt(data, 12), data[16], data[17]);
+    const auto numFormats = readUShort(data, 18);
+    const auto numEntries = container->_numFaces * container->_numMipLevels;
+    auto offset = HEADER_SIZE;
+
+    for (auto i = 0u; i < numFormats; ++i)
+    {
+        container->_formats.push_back(static_cast<TextureFormat>(readUInt(data, offset)));
+        offset += 4u;
+
+        auto mipLevels = std::vector<MipLevel>(numEntries);
+
+        for (auto& mipLevel : mipLevels)
+        {
+            mipLevel.offset = readUInt(data, offset);
+            mipLevel.size = readUInt(data, offset + 4u);
+            offset += 8u;
+        }
+
+        container->_mipLevels.push_back(mipLevels);
+    }
+
+    return container;
+}
+
+void
+TextureContainer::write(uint                                                                              width,
+                        uint                                                                              height,
+                        uint                                                                              numFaces,
+                        uint                                                                              numMipLevels,
+                        const std::vector<std::pair<TextureFormat, std::vector<unsigned char>>>&          mipChains,
+                        std::vector<unsigned char>&                                                       out)
+{
+    if (numFaces == 0u || numFaces > 255u || numMipLevels == 0u || numMipLevels > 255u)
+        throw std::invalid_argument("numFaces/numMipLevels");
+
+    auto container = create(width, height, numFaces, numMipLevels);
+    auto tocSize = HEADER_SIZE + mipChains.size() * (4u + numFaces * numMipLevels * 8u);
+    auto dataOffset = align(tocSize);
+
+    // lay out every level at an aligned offset before copying anything
+    for (const auto& mipChain : mipChains)
+    {
+        auto mipLevels = std::vector<MipLevel>();
+        auto chainOffset = 0u;
+
+        for (auto level = 0u; level < numMipLevels; ++level)
+        {
+            const auto mipLevelSize = TextureFormatInfo::textureSize(
+                mipChain.first,
+                std::max(width >> level, 1u),
+                std::max(height >> level, 1u)
+            );
+
+            for (auto face = 0u; face < numFaces; ++face)
+            {
+                mipLevels.push_back(MipLevel { dataOffset, mipLevelSize });
+
+                dataOffset = align(dataOffset + mipLevelSize);
+                chainOffset += mipLevelSize;
+            }
+        }
+
+        if (chainOffset > mipChain.second.size())
+            throw std::invalid_argument("mipChains");
+
+        container->_formats.push_back(mipChain.first);
+        container->_mipLevels.push_back(mipLevels);
+    }
+
+    out.assign(dataOffset, 0);
+
+    writeUInt(out, 0, MAGIC_NUMBER);
+    writeUShort(out, 4, VERSION);
+    writeUShort(out, 6, ALIGNMENT);
+    writeUInt(out, 8, width);
+    writeUInt(out, 12, height);
+    out[16] = static_cast<unsigned char>(numFaces);
+    out[17] = static_cast<unsigned char>(numMipLevels);
+    writeUShort(out, 18, static_cast<uint>(mipChains.size()));
+
+    auto tocOffset = HEADER_SIZE;
+
+    for (auto i = 0u; i < mipChains.size(); ++i)
+    {
+        writeUInt(out, tocOffset, static_cast<uint>(mipChains[i].first));
+        tocOffset += 4u;
+
+        auto chainOffset = 0u;
+
+        for (const auto& mipLevel : container->_mipLevels[i])
+        {
+            writeUInt(out, tocOffset, mipLevel.offset);
+            writeUInt(out, tocOffset + 4u, mipLevel.size);
+            tocOffset += 8u;
+
+            std::memcpy(&out[mipLevel.offset], &mipChains[i].second[chainOffset], mipLevel.size);
+            chainOffset += mipLevel.size;
+        }
+    }
+}
+
+uint
+TextureContainer::formatIndex(TextureFormat format) const
+{
+    auto formatIt = std::find(_formats.begin(), _formats.end(), format);
+
+    if (formatIt == _formats.end())
+        throw std::invalid_argument("format");
+
+    return static_cast<uint>(formatIt - _formats.begin());
+}
+
+bool
+TextureContainer::hasFormat(TextureFormat format) const
+{
+    return std::find(_formats.begin(), _formats.end(), format) != _formats.end();
+}
+
+const TextureContainer::MipLevel&
+TextureContainer::mipLevel(TextureFormat format, uint level, uint face) const
+{
+    if (level >= _numMipLevels)
+        throw std::invalid_argument("level");
+    if (face >= _numFaces)
+        throw std::invalid_argument("face");
+
+    return _mipLevels[formatIndex(format)][level * _numFaces + face];
+}
+
+void
+TextureContainer::mipLevelsRange(TextureFormat format, uint firstLevel, uint lastLevel, uint& offset, uint& size) const
+{
+    if (firstLevel > lastLevel)
+        throw std::invalid_argument("firstLevel");
+
+    const auto& first = mipLevel(format, firstLevel, 0u);
+    const auto& last = mipLevel(format, lastLevel, _numFaces - 1u);
+
+    offset = first.offset;
+    size = last.offset + last.size - first.offset;
+}
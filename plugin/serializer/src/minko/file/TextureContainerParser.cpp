@@ -0,0 +1,301 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/file/TextureContainerParser.hpp"
+
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/file/File.hpp"
+#include "minko/file/Loader.hpp"
+#include "minko/file/Options.hpp"
+#include "minko/file/TextureContainer.hpp"
+#include "minko/log/Logger.hpp"
+#include "minko/render/CubeTexture.hpp"
+#include "minko/render/OpenGLES2Context.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/render/TextureFormatInfo.hpp"
+#include "minko/render/TextureUploadQueue.hpp"
+
+using namespace minko;
+using namespace minko::file;
+using namespace minko::render;
+
+void
+TextureContainerParser::parse(const std::string&                filename,
+                              const std::string&                resolvedFilename,
+                              Options::Ptr                      options,
+                              const std::vector<unsigned char>& data,
+                              AssetLibrary::Ptr                 assetLibrary)
+{
+    const auto tableOfContentsSize = TextureContainer::tableOfContentsSize(data.data(), data.size());
+
+    if (tableOfContentsSize == 0u)
+    {
+        _error->execute(shared_from_this(), Error("InvalidTextureContainer", "Invalid texture container '" + filename + "'"));
+
+        return;
+    }
+
+    auto container = TextureContainer::read(data.data(), data.size());
+
+    if (container == nullptr)
+    {
+        auto tableOfContents = std::vector<unsigned char>();
+
+        if (!fetch(filename, options, 0u, tableOfContentsSize, tableOfContents))
+            return;
+
+        container = TextureContainer::read(tableOfContents.data(), tableOfContents.size());
+    }
+
+    auto format = TextureFormat::RGBA;
+
+    if (container == nullptr || !selectFormat(container, options, format))
+    {
+        _error->execute(shared_from_this(), Error("TextureParsingError", "No supported texture format in '" + filename + "'"));
+
+        return;
+    }
+
+    const auto numMipLevels = options->generateMipmaps() ? container->numMipLevels() : 1u;
+
+    auto offset = 0u;
+    auto size = 0u;
+
+    container->mipLevelsRange(format, 0u, numMipLevels - 1u, offset, size);
+
+    // the levels are either read in place from the loaded data or fetched by byte range
+    auto fetchedData = std::make_shared<std::vector<unsigned char>>();
+    auto levelsData = data.data();
+    auto dataOffset = 0u;
+
+    if (offset + size > data.size())
+    {
+        if (!fetch(filename, options, offset, size, *fetchedData))
+            return;
+
+        levelsData = fetchedData->data();
+        dataOffset = offset;
+    }
+
+    auto texture = createTexture(filename, container, format, numMipLevels, options, levelsData, dataOffset);
+
+    if (texture == nullptr)
+    {
+        _error->execute(shared_from_this(), Error("TextureParsingError", "Unsupported cube texture format in '" + filename + "'"));
+
+        return;
+    }
+
+    if (options->loadTexturesAsynchronously())
+    {
+        if (fetchedData->empty())
+        {
+            fetchedData->assign(data.begin() + offset, data.begin() + offset + size);
+            dataOffset = offset;
+        }
+
+        assetLibrary->textureUploadQueue()->upload(texture, size, [=]()
+        {
+            uploadMipLevels(texture, container, format, numMipLevels, fetchedData->data(), dataOffset);
+
+            if (options->disposeTextureAfterLoading())
+                texture->disposeData();
+        });
+    }
+    else
+    {
+        uploadMipLevels(texture, container, format, numMipLevels, levelsData, dataOffset);
+
+        if (options->disposeTextureAfterLoading())
+            texture->disposeData();
+    }
+
+    if (texture->type() == TextureType::CubeTexture)
+        assetLibrary->cubeTexture(filename, std::static_pointer_cast<CubeTexture>(texture));
+    else
+        assetLibrary->texture(filename, std::static_pointer_cast<Texture>(texture));
+
+    complete()->execute(shared_from_this());
+}
+
+bool
+TextureContainerParser::fetch(const std::string&            filename,
+                              Options::Ptr                  options,
+                              uint                          offset,
+                              uint                          size,
+                              std::vector<unsigned char>&   data)
+{
+    auto fetched = false;
+
+    auto rangeOptions = options->clone()
+        ->seekingOffset(offset)
+        ->seekedLength(size)
+        ->loadAsynchronously(false)
+        ->storeDataIfNotParsed(false)
+        ->parserFunction([](const std::string& extension) -> AbstractParser::Ptr { return nullptr; });
+
+    auto loader = Loader::create();
+
+    loader->options(rangeOptions);
+
+    auto errorSlot = loader->error()->connect([&](Loader::Ptr, const Error& error)
+    {
+        _error->execute(
+            shared_from_this(),
+            Error("TextureLoadingError", std::string("Failed to load texture ") + filename)
+        );
+    });
+
+    auto completeSlot = loader->complete()->connect([&](Loader::Ptr loaderThis)
+    {
+        data = loaderThis->files().at(filename)->data();
+        fetched = data.size() >= size;
+    });
+
+    loader
+        ->queue(filename)
+        ->load();
+
+    return fetched;
+}
+
+bool
+TextureContainerParser::selectFormat(TextureContainer::Ptr container, Options::Ptr options, TextureFormat& format)
+{
+    auto availableTextureFormats = std::unordered_set<TextureFormat, Hash<TextureFormat>>();
+
+    for (const auto& entry : OpenGLES2Context::availableTextureFormats())
+        if (container->hasFormat(entry.first))
+            availableTextureFormats.insert(entry.first);
+
+    if (availableTextureFormats.empty())
+        return false;
+
+    format = options->textureFormatFunction()(availableTextureFormats);
+
+    LOG_DEBUG("texture container format: " << TextureFormatInfo::name(format));
+
+    return container->hasFormat(format);
+}
+
+AbstractTexture::Ptr
+TextureContainerParser::createTexture(const std::string&        filename,
+                                      TextureContainer::Ptr     container,
+                                      TextureFormat             format,
+                                      uint                      numMipLevels,
+                                      Options::Ptr              options,
+                                      const unsigned char*      data,
+                                      uint                      dataOffset)
+{
+    const auto storeTextureData = !options->disposeTextureAfterLoading();
+    const auto mipMapping = numMipLevels > 1u;
+
+    if (container->numFaces() == 1u)
+    {
+        auto texture = Texture::create(
+            options->context(),
+            container->width(),
+            container->height(),
+            mipMapping,
+            false,
+            false,
+            format,
+            filename
+        );
+
+        texture = std::static_pointer_cast<Texture>(options->textureFunction()(filename, texture));
+
+        // the GPU texture is allocated before any data is set so that the levels are only uploaded once
+        texture->upload();
+
+        if (storeTextureData)
+        {
+            const auto& mipLevel = container->mipLevel(format, 0u);
+
+            texture->data(const_cast<unsigned char*>(data + mipLevel.offset - dataOffset));
+        }
+
+        return texture;
+    }
+
+    // cube textures keep a copy of the data of their first level, uploaded by uploadMipLevels()
+    if (TextureFormatInfo::isCompressed(format))
+        return nullptr;
+
+    auto texture = CubeTexture::create(
+        options->context(),
+        container->width(),
+        container->height(),
+        mipMapping,
+        false,
+        false,
+        format,
+        filename
+    );
+
+    texture = std::static_pointer_cast<CubeTexture>(options->textureFunction()(filename, texture));
+
+    for (auto face = 0u; face < container->numFaces(); ++face)
+    {
+        const auto& mipLevel = container->mipLevel(format, 0u, face);
+
+        texture->data(const_cast<unsigned char*>(data + mipLevel.offset - dataOffset), static_cast<CubeTexture::Face>(face));
+    }
+
+    return texture;
+}
+
+void
+TextureContainerParser::uploadMipLevels(AbstractTexture::Ptr    texture,
+                                        TextureContainer::Ptr   container,
+                                        TextureFormat           format,
+                                        uint                    numMipLevels,
+                                        const unsigned char*    data,
+                                        uint                    dataOffset)
+{
+    if (texture->type() == TextureType::CubeTexture)
+    {
+        auto cubeTexture = std::static_pointer_cast<CubeTexture>(texture);
+
+        cubeTexture->upload();
+
+        for (auto level = 1u; level < numMipLevels; ++level)
+            for (auto face = 0u; face < container->numFaces(); ++face)
+            {
+                const auto& mipLevel = container->mipLevel(format, level, face);
+
+                cubeTexture->uploadMipLevel(
+                    level,
+                    const_cast<unsigned char*>(data + mipLevel.offset - dataOffset),
+                    static_cast<CubeTexture::Face>(face)
+                );
+            }
+
+        return;
+    }
+
+    auto texture2d = std::static_pointer_cast<Texture>(texture);
+
+    for (auto level = 0u; level < numMipLevels; ++level)
+    {
+        const auto& mipLevel = container->mipLevel(format, level);
+
+        texture2d->uploadMipLevel(level, const_cast<unsigned char*>(data + mipLevel.offset - dataOffset));
+    }
+}
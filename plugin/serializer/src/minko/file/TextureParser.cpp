@@ -29,6 +29,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/OpenGLES2Context.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/TextureFormatInfo.hpp"
+#include "minko/render/TextureUploadQueue.hpp"
 
 using namespace minko;
 using namespace minko::file;
@@ -215,8 +216,10 @@ TextureParser::parseRGBATexture(const std::string&                  fileName,
     msgpack::type::tuple<int, std::string> deserializedTexture;
     unpack(deserializedTexture, data, data.size());
 
-    auto parsingOptions = options->parserFunction()
-        ? options->clone()->parserFunction(nullptr)
+    // the texture must be in the asset library by the time this parser completes, so the embedded
+    // image is always decoded synchronously
+    auto parsingOptions = options->parserFunction() || options->loadTexturesAsynchronously()
+        ? options->clone()->parserFunction(nullptr)->loadTexturesAsynchronously(false)
         : options;
 
     auto imageFormat = static_cast<ImageFormat>(deserializedTexture.get<0>());
@@ -280,6 +283,41 @@ TextureParser::parseCompressedTexture(TextureFormat                        forma
 
         const auto storeTextureData = !options->disposeTextureAfterLoading();
 
+        if (options->loadTexturesAsynchronously())
+        {
+            // the GPU texture is created right away so that the asset can be used before its data is uploaded
+            texture->upload();
+
+            if (storeTextureData)
+                texture->data(const_cast<unsigned char*>(textureData.data()));
+
+            auto mipLevelsData = std::make_shared<std::vector<unsigned char>>(textureData);
+            auto numMipLevels = hasMipmaps ? numMipmaps : 1;
+
+            assetLibrary->textureUploadQueue()->upload(
+                texture,
+                static_cast<uint>(mipLevelsData->size()),
+                [=]()
+                {
+                    auto mipLevelOffset = 0u;
+
+                    for (auto i = 0; i < numMipLevels; ++i)
+                    {
+                        texture->uploadMipLevel(i, mipLevelsData->data() + mipLevelOffset);
+
+                        mipLevelOffset += TextureFormatInfo::textureSize(format, std::max(width >> i, 1), std::max(height >> i, 1));
+                    }
+
+                    if (options->disposeTextureAfterLoading())
+                        texture->disposeData();
+                }
+            );
+
+            assetLibrary->texture(fileName, texture);
+
+            break;
+        }
+
         if (storeTextureData)
             texture->data(const_cast<unsigned char*>(textureData.data()));
 
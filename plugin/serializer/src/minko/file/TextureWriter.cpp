@@ -27,10 +27,12 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/PNGWriter.hpp"
 #include "minko/file/PVRTranscoder.hpp"
 #include "minko/file/QTranscoder.hpp"
+#include "minko/file/TextureContainer.hpp"
 #include "minko/file/WriterOptions.hpp"
 #include "minko/log/Logger.hpp"
 #include "minko/render/AbstractTexture.hpp"
 #include "minko/render/CubeTexture.hpp"
+#include "minko/render/ImageResampler.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/TextureFormatInfo.hpp"
 
@@ -140,11 +142,34 @@ TextureWriter::embed(AssetLibraryPtr               assetLibrary,
 
     auto formatHeaderData = std::vector<msgpack::type::tuple<int, int, int>>();
 
+    auto crnFormats = std::vector<TextureFormat>();
+    auto crnMipChains = std::vector<std::vector<unsigned char>>();
+
+    std::copy_if(textureFormats.begin(), textureFormats.end(), std::back_inserter(crnFormats), &CRNTranscoder::supportsFormat);
+
+    CRNTranscoder::transcode(texture, _textureType, writerOptions, crnFormats, crnMipChains);
+
     for (auto textureFormat : textureFormats)
     {
         const auto offset = blobStream.str().size();
 
-        if (!_formatWriterFunctions.at(textureFormat)(_data, _textureType, writerOptions, blobStream))
+        auto crnFormatIt = std::find(crnFormats.begin(), crnFormats.end(), textureFormat);
+        auto written = false;
+
+        if (crnFormatIt != crnFormats.end())
+        {
+            const auto& mipChain = crnMipChains.at(crnFormatIt - crnFormats.begin());
+
+            blobStream.write(reinterpret_cast<const char*>(mipChain.data()), mipChain.size());
+
+            written = !mipChain.empty();
+        }
+        else
+        {
+            written = _formatWriterFunctions.at(textureFormat)(_data, _textureType, writerOptions, blobStream);
+        }
+
+        if (!written)
         {
             // TODO
             // handle error
@@ -193,6 +218,103 @@ TextureWriter::embed(AssetLibraryPtr               assetLibrary,
     return result.str();
 }
 
+bool
+TextureWriter::writeContainer(AbstractTexture::Ptr          texture,
+                              const std::string&            textureType,
+                              WriterOptions::Ptr            writerOptions,
+                              std::vector<unsigned char>&   out)
+{
+    if (texture->type() != TextureType::Texture2D)
+        return false;
+
+    auto texture2D = std::static_pointer_cast<Texture>(texture);
+
+    ensureTextureSizeIsValid(texture, writerOptions, textureType);
+
+    if (!writerOptions->useTextureSRGBSpace(textureType))
+        gammaDecode(texture2D->data(), texture2D->data(), defaultGamma());
+
+    const auto width = texture->width();
+    const auto height = texture->height();
+    const auto generateMipmaps = writerOptions->generateMipMaps(textureType);
+    const auto numMipLevels = generateMipmaps ? AbstractTexture::numMipMaps(width, height) : 1;
+
+    const auto textureFormats = writerOptions->textureFormats(textureType, "");
+
+    auto mipChains = std::vector<std::pair<TextureFormat, std::vector<unsigned char>>>();
+
+    auto crnFormats = std::vector<TextureFormat>();
+    auto crnMipChains = std::vector<std::vector<unsigned char>>();
+
+    std::copy_if(textureFormats.begin(), textureFormats.end(), std::back_inserter(crnFormats), &CRNTranscoder::supportsFormat);
+
+    CRNTranscoder::transcode(texture, textureType, writerOptions, crnFormats, crnMipChains);
+
+    for (auto textureFormat : textureFormats)
+    {
+        auto mipChain = std::vector<unsigned char>();
+
+        switch (textureFormat)
+        {
+        case TextureFormat::RGB:
+        case TextureFormat::RGBA:
+            // RGB textures are stored as RGBA, as Texture::data() expands them
+            textureFormat = TextureFormat::RGBA;
+
+            if (generateMipmaps)
+                ImageResampler::mipMapChain(
+                    texture2D->data().data(),
+                    width,
+                    height,
+                    mipChain,
+                    ImageResampler::Filter::BOX,
+                    writerOptions->useTextureSRGBSpace(textureType) ? defaultGamma() : 1.f
+                );
+            else
+                mipChain.assign(texture2D->data().begin(), texture2D->data().begin() + width * height * 4u);
+
+            break;
+
+        case TextureFormat::RGB_DXT1:
+        case TextureFormat::RGBA_DXT1:
+        case TextureFormat::RGBA_DXT3:
+        case TextureFormat::RGBA_DXT5:
+            mipChain = std::move(crnMipChains.at(std::find(crnFormats.begin(), crnFormats.end(), textureFormat) - crnFormats.begin()));
+
+            if (mipChain.empty())
+                continue;
+            break;
+
+        case TextureFormat::RGB_ATITC:
+        case TextureFormat::RGBA_ATITC:
+            if (!QTranscoder::transcode(texture, textureType, writerOptions, textureFormat, mipChain))
+                continue;
+            break;
+
+        default:
+            if (!PVRTranscoder::transcode(texture, textureType, writerOptions, textureFormat, mipChain, { PVRTranscoder::Options::fastCompression }))
+                continue;
+            break;
+        }
+
+        auto alreadyWritten = std::find_if(
+            mipChains.begin(),
+            mipChains.end(),
+            [&](const std::pair<TextureFormat, std::vector<unsigned char>>& entry) { return entry.first == textureFormat; }
+        ) != mipChains.end();
+
+        if (!alreadyWritten)
+            mipChains.emplace_back(textureFormat, std::move(mipChain));
+    }
+
+    if (mipChains.empty())
+        return false;
+
+    TextureContainer::write(width, height, 1u, numMipLevels, mipChains, out);
+
+    return true;
+}
+
 void
 TextureWriter::ensureTextureSizeIsValid(AbstractTexture::Ptr    texture,
                                         WriterOptions::Ptr      writerOptions,
@@ -0,0 +1,573 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/StreamingCommon.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/file/VertexCacheOptimizer.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/log/Logger.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::file;
+using namespace minko::geometry;
+using namespace minko::scene;
+
+const unsigned int VertexCacheOptimizer::_maxScoredCacheSize = 32u;
+
+VertexCacheOptimizer::VertexCacheOptimizer() :
+    AbstractWriterPreprocessor<Node::Ptr>(),
+    _statusChanged(StatusChangedSignal::create()),
+    _progressRate(0.f),
+    _nodePredicateFunction([](Node::Ptr) -> bool { return true; }),
+    _cacheSize(16u),
+    _overdrawThreshold(1.05f),
+    _vertexReorderingEnabled(true),
+    _statistics(),
+    _optimizedGeometrySet()
+{
+}
+
+void
+VertexCacheOptimizer::process(Node::Ptr& node, AssetLibrary::Ptr assetLibrary)
+{
+    if (statusChanged() && statusChanged()->numCallbacks() > 0u)
+        statusChanged()->execute(shared_from_this(), "VertexCacheOptimizer: start");
+
+    _statistics = Statistics();
+
+    auto surfaceNodes = NodeSet::create(node)
+        ->descendants(true)
+        ->where([this](Node::Ptr descendant) -> bool
+            {
+                return descendant->hasComponent<Surface>() &&
+                    (!nodePredicateFunction() || nodePredicateFunction()(descendant));
+            }
+        );
+
+    for (auto surfaceNode : surfaceNodes->nodes())
+        for (auto surface : surfaceNode->components<Surface>())
+            if (acceptsSurface(surface))
+                optimizeSurfaceGeometry(surface, assetLibrary);
+
+    _progressRate = 1.f;
+
+    LOG_INFO("ACMR: " << _statistics.acmrBefore() << " -> " << _statistics.acmrAfter()
+        << ", ATVR: " << _statistics.atvrBefore() << " -> " << _statistics.atvrAfter()
+        << " (" << _statistics.numTriangles << " triangles, cache size " << _cacheSize << ")");
+
+    if (statusChanged() && statusChanged()->numCallbacks() > 0u)
+        statusChanged()->execute(shared_from_this(), "VertexCacheOptimizer: stop");
+}
+
+unsigned int
+VertexCacheOptimizer::numTransformedVertices(const std::vector<unsigned int>& indices, unsigned int cacheSize)
+{
+    if (indices.empty())
+        return 0u;
+
+    // FIFO cache simulation: a vertex is a hit if it was pushed less than cacheSize misses ago
+    auto timestamps = std::vector<unsigned int>(*std::max_element(indices.begin(), indices.end()) + 1u, 0u);
+    auto time = cacheSize + 1u;
+    auto numMisses = 0u;
+
+    for (auto index : indices)
+    {
+        if (time - timestamps[index] > cacheSize)
+        {
+            timestamps[index] = time++;
+
+            ++numMisses;
+        }
+    }
+
+    return numMisses;
+}
+
+bool
+VertexCacheOptimizer::acceptsSurface(Surface::Ptr surface)
+{
+    auto geometry = surface->geometry();
+
+    if (_optimizedGeometrySet.find(geometry) != _optimizedGeometrySet.end())
+        return false;
+
+    if (geometry->indices() == nullptr || !geometry->hasVertexAttribute("position"))
+        return false;
+
+    return geometry->indices()->dataPointer<unsigned short>() != nullptr ||
+           geometry->indices()->dataPointer<unsigned int>() != nullptr;
+}
+
+void
+VertexCacheOptimizer::optimizeSurfaceGeometry(Surface::Ptr surface, AssetLibrary::Ptr assetLibrary)
+{
+    auto geometry = surface->geometry();
+
+    _optimizedGeometrySet.insert(geometry);
+
+    auto indices = std::vector<unsigned int>();
+
+    auto ushortIndexDataPointer = geometry->indices()->dataPointer<unsigned short>();
+
+    if (ushortIndexDataPointer)
+        indices.assign(ushortIndexDataPointer->begin(), ushortIndexDataPointer->end());
+    else
+        indices = *geometry->indices()->dataPointer<unsigned int>();
+
+    if (indices.size() < 3u || indices.size() % 3u != 0u)
+        return;
+
+    const auto numVertices = geometry->numVertices();
+
+    auto positionVertexBuffer = geometry->vertexBuffer("position");
+    const auto& positionAttribute = positionVertexBuffer->attribute("position");
+    const auto& positionData = positionVertexBuffer->data();
+
+    auto positions = std::vector<float>(numVertices * 3u);
+
+    for (auto i = 0u; i < numVertices; ++i)
+        std::copy(
+            positionData.begin() + i * positionVertexBuffer->vertexSize() + positionAttribute.offset,
+            positionData.begin() + i * positionVertexBuffer->vertexSize() + positionAttribute.offset + 3u,
+            positions.begin() + i * 3u
+        );
+
+    // triangles never move across pre-ordered POP lods, each lod index range is optimized on its own
+    auto ranges = std::vector<std::pair<unsigned int, unsigned int>>();
+
+    if (geometry->data()->hasProperty("availableLods"))
+    {
+        const auto& availableLods = geometry->data()->get<std::map<int, ProgressiveOrderedMeshLodInfo>>(
+            "availableLods"
+        );
+
+        for (const auto& availableLod : availableLods)
+        {
+            const auto& lodInfo = availableLod.second;
+
+            if (lodInfo.isValid() && lodInfo._indexCount > 0)
+                ranges.emplace_back(lodInfo._indexOffset, lodInfo._indexCount);
+        }
+    }
+
+    if (ranges.empty())
+        ranges.emplace_back(0u, indices.size());
+
+    auto referencedVertices = std::vector<bool>(numVertices, false);
+
+    for (auto index : indices)
+        referencedVertices[index] = true;
+
+    _statistics.numTriangles += indices.size() / 3u;
+    _statistics.numVertices += std::count(referencedVertices.begin(), referencedVertices.end(), true);
+    _statistics.numTransformedVerticesBefore += numTransformedVertices(indices, _cacheSize);
+
+    for (const auto& range : ranges)
+    {
+        if (range.first + range.second > indices.size())
+            continue;
+
+        auto rangeIndices = std::vector<unsigned int>(
+            indices.begin() + range.first,
+            indices.begin() + range.first + range.second
+        );
+
+        optimizeVertexCache(rangeIndices, numVertices);
+
+        if (_overdrawThreshold > 0.f)
+            optimizeOverdraw(rangeIndices, positions);
+
+        std::copy(rangeIndices.begin(), rangeIndices.end(), indices.begin() + range.first);
+    }
+
+    if (_vertexReorderingEnabled)
+        reorderVertices(geometry, indices, assetLibrary);
+
+    _statistics.numTransformedVerticesAfter += numTransformedVertices(indices, _cacheSize);
+
+    if (ushortIndexDataPointer)
+        geometry->indices(createIndexBuffer<unsigned short>(indices, assetLibrary));
+    else
+        geometry->indices(createIndexBuffer<unsigned int>(indices, assetLibrary));
+}
+
+static
+float
+vertexScore(int cachePosition, unsigned int numRemainingTriangles, unsigned int maxCacheSize)
+{
+    // Tom Forsyth, "Linear-Speed Vertex Cache Optimisation"
+    static const auto cacheDecayPower = 1.5f;
+    static const auto lastTriangleScore = 0.75f;
+    static const auto valenceBoostScale = 2.f;
+    static const auto valenceBoostPower = 0.5f;
+
+    if (numRemainingTriangles == 0u)
+        return -1.f;
+
+    auto score = 0.f;
+
+    if (cachePosition >= 0)
+    {
+        if (cachePosition < 3)
+            score = lastTriangleScore;
+        else
+            score = std::pow(1.f - float(cachePosition - 3) / float(maxCacheSize - 3u), cacheDecayPower);
+    }
+
+    return score + valenceBoostScale * std::pow(float(numRemainingTriangles), -valenceBoostPower);
+}
+
+void
+VertexCacheOptimizer::optimizeVertexCache(std::vector<unsigned int>& indices, unsigned int numVertices)
+{
+    const auto numTriangles = indices.size() / 3u;
+
+    auto vertexTriangleOffsets = std::vector<unsigned int>(numVertices + 1u, 0u);
+    auto numRemainingTriangles = std::vector<unsigned int>(numVertices, 0u);
+
+    for (auto index : indices)
+        ++numRemainingTriangles[index];
+
+    for (auto i = 0u; i < numVertices; ++i)
+        vertexTriangleOffsets[i + 1u] = vertexTriangleOffsets[i] + numRemainingTriangles[i];
+
+    auto vertexTriangles = std::vector<unsigned int>(indices.size());
+    auto vertexTriangleFill = std::vector<unsigned int>(vertexTriangleOffsets.begin(), vertexTriangleOffsets.end() - 1);
+
+    for (auto i = 0u; i < indices.size(); ++i)
+        vertexTriangles[vertexTriangleFill[indices[i]]++] = i / 3u;
+
+    auto vertexScores = std::vector<float>(numVertices, 0.f);
+
+    for (auto i = 0u; i < numVertices; ++i)
+        vertexScores[i] = vertexScore(-1, numRemainingTriangles[i], _maxScoredCacheSize);
+
+    auto triangleScores = std::vector<float>(numTriangles, 0.f);
+    auto triangleEmitted = std::vector<bool>(numTriangles, false);
+
+    auto bestTriangle = 0u;
+
+    for (auto i = 0u; i < numTriangles; ++i)
+    {
+        triangleScores[i] = vertexScores[indices[i * 3u]] +
+                            vertexScores[indices[i * 3u + 1u]] +
+                            vertexScores[indices[i * 3u + 2u]];
+
+        if (triangleScores[i] > triangleScores[bestTriangle])
+            bestTriangle = i;
+    }
+
+    auto optimizedIndices = std::vector<unsigned int>();
+    optimizedIndices.reserve(indices.size());
+
+    auto cache = std::vector<unsigned int>();
+    auto nextCache = std::vector<unsigned int>();
+    auto inputCursor = 0u;
+
+    while (optimizedIndices.size() < indices.size())
+    {
+        if (bestTriangle == numTriangles)
+        {
+            // no scored triangle left around the cache, resume from the first remaining one
+            while (triangleEmitted[inputCursor])
+                ++inputCursor;
+
+            bestTriangle = inputCursor;
+        }
+
+        triangleEmitted[bestTriangle] = true;
+
+        nextCache.clear();
+
+        for (auto i = 0u; i < 3u; ++i)
+        {
+            const auto index = indices[bestTriangle * 3u + i];
+
+            optimizedIndices.push_back(index);
+            nextCache.push_back(index);
+
+            // remove the triangle from the active part of the vertex adjacency list
+            const auto begin = vertexTriangleOffsets[index];
+            auto& numRemaining = numRemainingTriangles[index];
+
+            for (auto j = begin; j < begin + numRemaining; ++j)
+            {
+                if (vertexTriangles[j] == bestTriangle)
+                {
+                    std::swap(vertexTriangles[j], vertexTriangles[begin + numRemaining - 1u]);
+                    --numRemaining;
+
+                    break;
+                }
+            }
+        }
+
+        for (auto index : cache)
+            if (std::find(nextCache.begin(), nextCache.end(), index) == nextCache.end())
+                nextCache.push_back(index);
+
+        std::swap(cache, nextCache);
+
+        bestTriangle = numTriangles;
+        auto bestScore = -1.f;
+
+        for (auto i = 0u; i < cache.size(); ++i)
+        {
+            const auto index = cache[i];
+            const auto cachePosition = i < _maxScoredCacheSize ? static_cast<int>(i) : -1;
+
+            const auto previousScore = vertexScores[index];
+            const auto score = vertexScore(cachePosition, numRemainingTriangles[index], _maxScoredCacheSize);
+            const auto scoreDelta = score - previousScore;
+
+            vertexScores[index] = score;
+
+            const auto begin = vertexTriangleOffsets[index];
+
+            for (auto j = begin; j < begin + numRemainingTriangles[index]; ++j)
+            {
+                const auto triangle = vertexTriangles[j];
+
+                triangleScores[triangle] += scoreDelta;
+
+                if (triangleScores[triangle] > bestScore)
+                {
+                    bestScore = triangleScores[triangle];
+                    bestTriangle = triangle;
+                }
+            }
+        }
+
+        if (cache.size() > _maxScoredCacheSize)
+            cache.resize(_maxScoredCacheSize);
+    }
+
+    indices.swap(optimizedIndices);
+}
+
+void
+VertexCacheOptimizer::optimizeOverdraw(std::vector<unsigned int>&   indices,
+                                       const std::vector<float>&    positions)
+{
+    // Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw": the cache
+    // optimized order is cut into clusters which are then sorted so that outward facing ones come first
+    const auto numTriangles = indices.size() / 3u;
+
+    if (numTriangles < 2u)
+        return;
+
+    auto triangleMisses = std::vector<unsigned int>(numTriangles, 0u);
+    auto timestamps = std::vector<unsigned int>(positions.size() / 3u, 0u);
+    auto time = _cacheSize + 1u;
+    auto numMisses = 0u;
+
+    for (auto i = 0u; i < indices.size(); ++i)
+    {
+        if (time - timestamps[indices[i]] > _cacheSize)
+        {
+            timestamps[indices[i]] = time++;
+
+            ++triangleMisses[i / 3u];
+            ++numMisses;
+        }
+    }
+
+    const auto maxClusterAcmr = _overdrawThreshold * float(numMisses) / numTriangles;
+    const auto minClusterSize = _cacheSize * 4u;
+
+    auto clusters = std::vector<unsigned int>(1, 0u);
+    auto clusterStart = 0u;
+    auto clusterMisses = 0u;
+
+    for (auto i = 0u; i < numTriangles; ++i)
+    {
+        // a triangle missing all of its vertices starts a region the cache optimizer could not connect
+        if (i > clusterStart && triangleMisses[i] == 3u)
+        {
+            clusters.push_back(i);
+
+            clusterStart = i;
+            clusterMisses = 0u;
+        }
+
+        clusterMisses += triangleMisses[i];
+
+        // clusters shorter than a few cache refills would spend most of their misses warming the cache up
+        if (i + 1u < numTriangles &&
+            i - clusterStart + 1u >= minClusterSize &&
+            float(clusterMisses) / float(i - clusterStart + 1u) <= maxClusterAcmr)
+        {
+            clusters.push_back(i + 1u);
+
+            clusterStart = i + 1u;
+            clusterMisses = 0u;
+        }
+    }
+
+    clusters.push_back(numTriangles);
+
+    const auto numClusters = clusters.size() - 1u;
+
+    if (numClusters < 2u)
+        return;
+
+    auto meshCentroid = math::vec3(0.f);
+
+    for (auto index : indices)
+        meshCentroid += math::make_vec3(&positions[index * 3u]);
+
+    meshCentroid /= float(indices.size());
+
+    auto clusterSortKeys = std::vector<std::pair<float, unsigned int>>(numClusters);
+
+    for (auto i = 0u; i < numClusters; ++i)
+    {
+        auto centroid = math::vec3(0.f);
+        auto normal = math::vec3(0.f);
+        auto area = 0.f;
+
+        for (auto triangle = clusters[i]; triangle < clusters[i + 1u]; ++triangle)
+        {
+            const auto p0 = math::make_vec3(&positions[indices[triangle * 3u] * 3u]);
+            const auto p1 = math::make_vec3(&positions[indices[triangle * 3u + 1u] * 3u]);
+            const auto p2 = math::make_vec3(&positions[indices[triangle * 3u + 2u] * 3u]);
+
+            const auto triangleNormal = math::cross(p1 - p0, p2 - p0);
+            const auto triangleArea = math::length(triangleNormal);
+
+            centroid += (p0 + p1 + p2) * (triangleArea / 3.f);
+            normal += triangleNormal;
+            area += triangleArea;
+        }
+
+        if (area > 0.f)
+            centroid /= area;
+
+        const auto normalLength = math::length(normal);
+
+        clusterSortKeys[i] = std::make_pair(
+            normalLength > 0.f ? math::dot(centroid - meshCentroid, normal / normalLength) : 0.f,
+            i
+        );
+    }
+
+    std::stable_sort(
+        clusterSortKeys.begin(),
+        clusterSortKeys.end(),
+        [](const std::pair<float, unsigned int>& left, const std::pair<float, unsigned int>& right) -> bool
+        {
+            return left.first > right.first;
+        }
+    );
+
+    auto sortedIndices = std::vector<unsigned int>();
+    sortedIndices.reserve(indices.size());
+
+    for (const auto& clusterSortKey : clusterSortKeys)
+    {
+        const auto cluster = clusterSortKey.second;
+
+        sortedIndices.insert(
+            sortedIndices.end(),
+            indices.begin() + clusters[cluster] * 3u,
+            indices.begin() + clusters[cluster + 1u] * 3u
+        );
+    }
+
+    // the overdraw order is only kept as long as it stays within the allowed vertex cache degradation
+    if (numTransformedVertices(sortedIndices, _cacheSize) <= _overdrawThreshold * numMisses)
+        indices.swap(sortedIndices);
+}
+
+void
+VertexCacheOptimizer::reorderVertices(Geometry::Ptr                 geometry,
+                                      std::vector<unsigned int>&    indices,
+                                      AssetLibrary::Ptr             assetLibrary)
+{
+    // vertices are renumbered in order of first use, unreferenced ones are kept at the end,
+    // pre-ordered POP lods keep their prefix property since lod ranges are visited in order
+    const auto numVertices = geometry->numVertices();
+
+    auto vertexMap = std::vector<int>(numVertices, -1);
+    auto newToOldVertexMap = std::vector<unsigned int>();
+
+    newToOldVertexMap.reserve(numVertices);
+
+    for (auto& index : indices)
+    {
+        if (vertexMap[index] < 0)
+        {
+            vertexMap[index] = static_cast<int>(newToOldVertexMap.size());
+            newToOldVertexMap.push_back(index);
+        }
+
+        index = static_cast<unsigned int>(vertexMap[index]);
+    }
+
+    for (auto i = 0u; i < numVertices; ++i)
+        if (vertexMap[i] < 0)
+            newToOldVertexMap.push_back(i);
+
+    auto vertexBuffers = geometry->vertexBuffers();
+    auto newVertexBuffers = std::vector<render::VertexBuffer::Ptr>();
+
+    for (auto vertexBuffer : vertexBuffers)
+    {
+        const auto vertexSize = vertexBuffer->vertexSize();
+        const auto& data = vertexBuffer->data();
+
+        auto newData = std::vector<float>(data.size());
+
+        for (auto i = 0u; i < numVertices; ++i)
+            std::copy(
+                data.begin() + newToOldVertexMap[i] * vertexSize,
+                data.begin() + (newToOldVertexMap[i] + 1u) * vertexSize,
+                newData.begin() + i * vertexSize
+            );
+
+        auto newVertexBuffer = render::VertexBuffer::create(vertexBuffer->context());
+
+        // the layout must be known before the upload for packed attributes to keep their format
+        for (const auto& attribute : vertexBuffer->attributes())
+            newVertexBuffer->addAttribute(*attribute.name, attribute.size, attribute.offset, attribute.format);
+
+        newVertexBuffer->data().swap(newData);
+        newVertexBuffer->upload();
+
+        geometry->removeVertexBuffer(vertexBuffer);
+
+        newVertexBuffers.push_back(newVertexBuffer);
+    }
+
+    for (auto vertexBuffer : newVertexBuffers)
+        geometry->addVertexBuffer(vertexBuffer);
+}
+
+template <typename T>
+render::IndexBuffer::Ptr
+VertexCacheOptimizer::createIndexBuffer(const std::vector<unsigned int>& indices, AssetLibrary::Ptr assetLibrary)
+{
+    return render::IndexBuffer::create(assetLibrary->context(), std::vector<T>(indices.begin(), indices.end()));
+}
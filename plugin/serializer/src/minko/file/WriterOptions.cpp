@@ -58,6 +58,10 @@ WriterOptions::WriterOptions() :
         { "irradianceMap",  { ImageFormat::JPEG, 0.9f, true, 0.f, false, false, true, true, math::vec2(1.f), math::ivec2(2048), TextureFilter::NEAREST, MipFilter::NONE } }
     },
     _writeAnimations(false),
-    _nullAssetUuids()
+    _quantizeVertexAttributes(false),
+    _vertexAttributeFormatFunction(),
+    _nullAssetUuids(),
+    _numTranscodingThreads(std::max(1u, std::thread::hardware_concurrency())),
+    _transcodedTextureCacheDirectory()
 {
 }
@@ -19,5 +19,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #pragma once
 
+#include "minko/component/TextBatch.hpp"
 #include "minko/component/UTF8Text.hpp"
 #include "minko/geometry/TextGeometry.hpp"
+#include "minko/render/GlyphAtlas.hpp"
@@ -0,0 +1,225 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/Signal.hpp"
+#include "minko/component/AbstractComponent.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        class GlyphAtlas;
+    }
+
+    namespace component
+    {
+        /*
+        ** Draws any number of text labels sharing a GlyphAtlas with a single Surface. Each label owns
+        ** a range of glyph quads in one dynamic vertex buffer: changing a label only rewrites its own
+        ** range. The dirty ranges are flushed once per frame, when the scene frame begins, or when
+        ** flush() is called. Within a scene, they are queued on the BufferUploadQueue of the
+        ** SceneManager assets and uploaded at its next update(); out of a scene, they are uploaded
+        ** right away.
+        */
+        class TextBatch : public AbstractComponent
+        {
+        public:
+            using Ptr = std::shared_ptr<TextBatch>;
+
+        private:
+            struct Label
+            {
+                std::string     text;
+                math::vec3      position;
+                float           size;
+                uint            firstGlyph;
+                uint            capacity;
+                bool            used;
+                bool            dirty;
+            };
+
+            struct GlyphRange
+            {
+                uint            first;
+                uint            count;
+            };
+
+            typedef std::shared_ptr<scene::Node>                            NodePtr;
+            typedef Signal<NodePtr, NodePtr, NodePtr>::Slot                 NodeSlot;
+            typedef Signal<std::shared_ptr<SceneManager>, float, float>     SceneManagerSignal;
+
+        private:
+            static const uint                                               VERTEX_SIZE;
+            static const uint                                               MAX_NUM_GLYPHS;
+
+            std::shared_ptr<render::GlyphAtlas>                             _atlas;
+            std::shared_ptr<material::Material>                             _material;
+            std::shared_ptr<render::Effect>                                 _effect;
+
+            std::vector<Label>                                              _labels;
+            std::vector<uint>                                               _freeLabels;
+            std::vector<GlyphRange>                                         _freeGlyphRanges;
+            uint                                                            _numGlyphs;
+            uint                                                            _capacity;
+
+            std::shared_ptr<render::VertexBuffer>                           _vertexBuffer;
+            std::shared_ptr<Surface>                                        _surface;
+            bool                                                            _rebuildGeometry;
+            std::vector<GlyphRange>                                         _dirtyGlyphRanges;
+            uint                                                            _atlasVersion;
+            uint                                                            _numUploadedGlyphsLastFlush;
+
+            NodeSlot                                                        _addedSlot;
+            NodeSlot                                                        _removedSlot;
+            SceneManagerSignal::Slot                                        _frameBeginSlot;
+
+        public:
+            static
+            Ptr
+            create(std::shared_ptr<render::GlyphAtlas>  atlas,
+                   std::shared_ptr<material::Material>  material,
+                   std::shared_ptr<render::Effect>      effect,
+                   uint                                 capacity = 1024)
+            {
+                auto instance = Ptr(new TextBatch(atlas, material, effect, capacity));
+
+                return instance;
+            }
+
+            std::shared_ptr<render::GlyphAtlas>
+            atlas() const
+            {
+                return _atlas;
+            }
+
+            std::shared_ptr<material::Material>
+            material() const
+            {
+                return _material;
+            }
+
+            std::shared_ptr<render::Effect>
+            effect() const
+            {
+                return _effect;
+            }
+
+            /*
+            ** Number of glyph quads the vertex buffer can hold before it has to be reallocated.
+            */
+            uint
+            capacity() const
+            {
+                return _capacity;
+            }
+
+            uint
+            numLabels() const
+            {
+                return static_cast<uint>(_labels.size() - _freeLabels.size());
+            }
+
+            uint
+            numUploadedGlyphsLastFlush() const
+            {
+                return _numUploadedGlyphsLastFlush;
+            }
+
+            /*
+            ** Adds a label whose baseline starts at position, in the local space of the target.
+            ** size is the height of the font, in local units. Returns the id of the label.
+            */
+            uint
+            addLabel(const std::string& text, const math::vec3& position, float size);
+
+            void
+            removeLabel(uint label);
+
+            const std::string&
+            text(uint label) const
+            {
+                return _labels.at(label).text;
+            }
+
+            Ptr
+            text(uint label, const std::string& text);
+
+            const math::vec3&
+            position(uint label) const
+            {
+                return _labels.at(label).position;
+            }
+
+            Ptr
+            position(uint label, const math::vec3& position);
+
+            float
+            size(uint label) const
+            {
+                return _labels.at(label).size;
+            }
+
+            Ptr
+            size(uint label, float size);
+
+            /*
+            ** Writes the dirty labels and uploads, or queues the upload of, their ranges of the
+            ** vertex buffer.
+            */
+            void
+            flush();
+
+        private:
+            TextBatch(std::shared_ptr<render::GlyphAtlas>   atlas,
+                      std::shared_ptr<material::Material>   material,
+                      std::shared_ptr<render::Effect>       effect,
+                      uint                                  capacity);
+
+            void
+            targetAdded(NodePtr target) override;
+
+            void
+            targetRemoved(NodePtr target) override;
+
+            void
+            addedOrRemovedHandler(NodePtr node, NodePtr target, NodePtr parent);
+
+            Label&
+            label(uint label);
+
+            void
+            invalidate(Label& label);
+
+            void
+            allocateGlyphs(Label& label, uint numGlyphs);
+
+            void
+            freeGlyphs(Label& label);
+
+            void
+            rebuildGeometry();
+
+            void
+            writeLabel(const Label& label, std::vector<float>& vertexData);
+        };
+    }
+}
@@ -0,0 +1,222 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        /*
+        ** Glyph cache shared by any number of texts. Glyphs are stored as signed distance fields in
+        ** fixed size cells of a single RGBA texture, so that they can be drawn at any scale with an
+        ** alpha threshold of .5. Glyphs are added on demand: the texture grows vertically up to
+        ** maxHeight, then the least recently used glyphs are evicted to make room for new ones.
+        ** version() changes each time the UVs of already cached glyphs might have been invalidated.
+        */
+        class GlyphAtlas :
+            public std::enable_shared_from_this<GlyphAtlas>
+        {
+        public:
+            using Ptr = std::shared_ptr<GlyphAtlas>;
+
+            struct Glyph
+            {
+                unsigned long   codepoint;
+                uint            cell;
+                math::vec2      offset;     // top left corner of the quad relative to the pen, y up
+                math::vec2      size;       // size of the quad, distance field spread included
+                float           advance;
+            };
+
+        private:
+            struct FontFace;
+
+            typedef std::list<unsigned long>                            LRUList;
+            typedef std::pair<Glyph, LRUList::iterator>                 CachedGlyph;
+
+        private:
+            std::shared_ptr<AbstractContext>                            _context;
+            std::shared_ptr<FontFace>                                   _face;
+
+            uint                                                        _pixelSize;
+            uint                                                        _spread;
+            uint                                                        _cellSize;
+            uint                                                        _width;
+            uint                                                        _height;
+            uint                                                        _maxHeight;
+
+            std::shared_ptr<RectangleTexture>                           _texture;
+            bool                                                        _dirty;
+
+            std::unordered_map<unsigned long, CachedGlyph>              _glyphs;
+            LRUList                                                     _lru;
+            std::vector<uint>                                           _freeCells;
+            uint                                                        _numCells;
+
+            uint                                                        _version;
+            uint                                                        _numEvictedGlyphs;
+
+        public:
+            /*
+            ** Empty atlas: glyphs must be added with addGlyph().
+            */
+            static
+            Ptr
+            create(std::shared_ptr<AbstractContext>  context,
+                   uint                              pixelSize  = 32,
+                   uint                              spread     = 4,
+                   uint                              width      = 512,
+                   uint                              maxHeight  = 2048)
+            {
+                auto instance = Ptr(new GlyphAtlas(context, pixelSize, spread, width, maxHeight));
+
+                instance->initialize();
+
+                return instance;
+            }
+
+#ifdef MINKO_PLUGIN_TTF_FREETYPE
+            /*
+            ** Atlas rasterizing the glyphs of the given font file as they are requested.
+            */
+            static
+            Ptr
+            create(std::shared_ptr<AbstractContext>  context,
+                   const std::string&                fontFilename,
+                   uint                              pixelSize  = 32,
+                   uint                              spread     = 4,
+                   uint                              width      = 512,
+                   uint                              maxHeight  = 2048)
+            {
+                auto instance = create(context, pixelSize, spread, width, maxHeight);
+
+                instance->loadFont(fontFilename);
+
+                return instance;
+            }
+#endif
+
+            inline
+            std::shared_ptr<AbstractContext>
+            context() const
+            {
+                return _context;
+            }
+
+            inline
+            std::shared_ptr<RectangleTexture>
+            texture() const
+            {
+                return _texture;
+            }
+
+            /*
+            ** Size of the glyphs in the atlas, in pixels. Texts laid out with a size of s must scale
+            ** the glyph metrics by s / pixelSize().
+            */
+            inline
+            uint
+            pixelSize() const
+            {
+                return _pixelSize;
+            }
+
+            inline
+            uint
+            version() const
+            {
+                return _version;
+            }
+
+            inline
+            uint
+            numGlyphs() const
+            {
+                return static_cast<uint>(_glyphs.size());
+            }
+
+            inline
+            uint
+            numEvictedGlyphs() const
+            {
+                return _numEvictedGlyphs;
+            }
+
+            /*
+            ** Returns the cached glyph for codepoint, rasterizing it if needed, or nullptr if the
+            ** glyph is not available. The returned pointer is valid until the next call to glyph()
+            ** or addGlyph().
+            */
+            const Glyph*
+            glyph(unsigned long codepoint);
+
+            /*
+            ** Adds a glyph from its 8-bit coverage bitmap. bearing is the offset from the pen to the
+            ** top left corner of the bitmap, y up, and advance is the horizontal pen advance, both in
+            ** pixels.
+            */
+            const Glyph*
+            addGlyph(unsigned long          codepoint,
+                     const unsigned char*   coverage,
+                     uint                   width,
+                     uint                   height,
+                     const math::ivec2&     bearing,
+                     float                  advance);
+
+            /*
+            ** UV rectangle of the glyph quad as (uMin, vMin, uMax, vMax), vMin being the top edge.
+            */
+            math::vec4
+            uv(const Glyph& glyph) const;
+
+            /*
+            ** Uploads the texture if any glyph has been added since the last upload.
+            */
+            void
+            upload();
+
+        private:
+            GlyphAtlas(std::shared_ptr<AbstractContext> context,
+                       uint                             pixelSize,
+                       uint                             spread,
+                       uint                             width,
+                       uint                             maxHeight);
+
+            void
+            initialize();
+
+#ifdef MINKO_PLUGIN_TTF_FREETYPE
+            void
+            loadFont(const std::string& fontFilename);
+#endif
+
+            bool
+            allocateCell(uint& cell);
+
+            void
+            grow();
+
+            void
+            writeDistanceField(uint cell, const unsigned char* coverage, uint width, uint height);
+        };
+    }
+}
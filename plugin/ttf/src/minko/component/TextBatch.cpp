@@ -0,0 +1,489 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/TextBatch.hpp"
+#include "minko/component/SceneManager.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/material/Material.hpp"
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/BufferUploadQueue.hpp"
+#include "minko/render/GlyphAtlas.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/render/Priority.hpp"
+#include "minko/render/RectangleTexture.hpp"
+#include "minko/render/TriangleCulling.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/scene/Node.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+std::vector<unsigned long>
+strToUnicode(const std::string& str);
+
+// position (3) + uv (2)
+const uint TextBatch::VERTEX_SIZE = 5;
+// 4 vertices per glyph, indexed with unsigned shorts
+const uint TextBatch::MAX_NUM_GLYPHS = 16384;
+
+static const uint LABEL_CAPACITY_GRANULARITY = 8;
+
+TextBatch::TextBatch(std::shared_ptr<render::GlyphAtlas>   atlas,
+                     std::shared_ptr<material::Material>   material,
+                     std::shared_ptr<render::Effect>       effect,
+                     uint                                  capacity) :
+    _atlas(atlas),
+    _material(material),
+    _effect(effect),
+    _labels(),
+    _freeLabels(),
+    _freeGlyphRanges(),
+    _numGlyphs(0),
+    _capacity(std::min(std::max(capacity, LABEL_CAPACITY_GRANULARITY), MAX_NUM_GLYPHS)),
+    _vertexBuffer(),
+    _surface(),
+    _rebuildGeometry(true),
+    _dirtyGlyphRanges(),
+    _atlasVersion(atlas->version()),
+    _numUploadedGlyphsLastFlush(0),
+    _addedSlot(),
+    _removedSlot(),
+    _frameBeginSlot()
+{
+}
+
+uint
+TextBatch::addLabel(const std::string& text, const math::vec3& position, float size)
+{
+    auto id = static_cast<uint>(_labels.size());
+
+    if (_freeLabels.empty())
+        _labels.emplace_back();
+    else
+    {
+        id = _freeLabels.back();
+        _freeLabels.pop_back();
+    }
+
+    auto& label = _labels[id];
+
+    label.text = text;
+    label.position = position;
+    label.size = size;
+    label.firstGlyph = 0;
+    label.capacity = 0;
+    label.used = true;
+
+    allocateGlyphs(label, static_cast<uint>(strToUnicode(text).size()));
+    invalidate(label);
+
+    return id;
+}
+
+void
+TextBatch::removeLabel(uint id)
+{
+    auto& label = this->label(id);
+
+    freeGlyphs(label);
+
+    label.text.clear();
+    label.used = false;
+    label.dirty = false;
+
+    _freeLabels.push_back(id);
+}
+
+TextBatch::Ptr
+TextBatch::text(uint id, const std::string& text)
+{
+    auto& label = this->label(id);
+
+    if (label.text != text)
+    {
+        const auto numGlyphs = static_cast<uint>(strToUnicode(text).size());
+
+        if (numGlyphs > label.capacity)
+        {
+            freeGlyphs(label);
+            allocateGlyphs(label, numGlyphs);
+        }
+
+        label.text = text;
+        invalidate(label);
+    }
+
+    return std::static_pointer_cast<TextBatch>(shared_from_this());
+}
+
+TextBatch::Ptr
+TextBatch::position(uint id, const math::vec3& position)
+{
+    auto& label = this->label(id);
+
+    if (label.position != position)
+    {
+        label.position = position;
+        invalidate(label);
+    }
+
+    return std::static_pointer_cast<TextBatch>(shared_from_this());
+}
+
+TextBatch::Ptr
+TextBatch::size(uint id, float size)
+{
+    auto& label = this->label(id);
+
+    if (label.size != size)
+    {
+        label.size = size;
+        invalidate(label);
+    }
+
+    return std::static_pointer_cast<TextBatch>(shared_from_this());
+}
+
+void
+TextBatch::flush()
+{
+    _numUploadedGlyphsLastFlush = 0;
+
+    if (!target())
+        return;
+
+    if (_rebuildGeometry)
+        rebuildGeometry();
+
+    auto& vertexData = _vertexBuffer->data();
+
+    // adding glyphs to the atlas might move or evict the ones used by other labels: in that case,
+    // every label is written again once
+    auto numPasses = 0;
+
+    do
+    {
+        if (_atlasVersion != _atlas->version())
+            for (auto& label : _labels)
+                if (label.used)
+                    label.dirty = true;
+
+        _atlasVersion = _atlas->version();
+
+        for (auto& label : _labels)
+        {
+            if (!label.dirty)
+                continue;
+
+            writeLabel(label, vertexData);
+            label.dirty = false;
+
+            _dirtyGlyphRanges.push_back(GlyphRange{ label.firstGlyph, label.capacity });
+        }
+    }
+    while (_atlasVersion != _atlas->version() && ++numPasses < 2);
+
+    _atlas->upload();
+
+    if (_dirtyGlyphRanges.empty())
+        return;
+
+    // within a scene, the ranges are uploaded along with the other dynamic buffers right after
+    // frameBegin(), orphaning the vertex buffer when most of the labels changed
+    auto sceneManager = target()->root()->component<SceneManager>();
+    auto uploadQueue = sceneManager ? sceneManager->assets()->bufferUploadQueue() : nullptr;
+
+    // coalesce the dirty ranges to upload contiguous labels at once
+    std::sort(
+        _dirtyGlyphRanges.begin(),
+        _dirtyGlyphRanges.end(),
+        [](const GlyphRange& a, const GlyphRange& b) { return a.first < b.first; }
+    );
+
+    auto range = _dirtyGlyphRanges.front();
+
+    for (auto i = 1u; i <= _dirtyGlyphRanges.size(); ++i)
+    {
+        if (i < _dirtyGlyphRanges.size() && _dirtyGlyphRanges[i].first <= range.first + range.count)
+        {
+            const auto end = std::max(range.first + range.count, _dirtyGlyphRanges[i].first + _dirtyGlyphRanges[i].count);
+
+            range.count = end - range.first;
+
+            continue;
+        }
+
+        if (range.count != 0)
+        {
+            if (uploadQueue)
+                uploadQueue->upload(_vertexBuffer, range.first * 4, range.count * 4);
+            else
+                _vertexBuffer->upload(range.first * 4, range.count * 4);
+            _numUploadedGlyphsLastFlush += range.count;
+        }
+
+        if (i < _dirtyGlyphRanges.size())
+            range = _dirtyGlyphRanges[i];
+    }
+
+    _dirtyGlyphRanges.clear();
+}
+
+void
+TextBatch::targetAdded(NodePtr target)
+{
+    AbstractComponent::targetAdded(target);
+
+    auto addedOrRemovedCallback = [=](NodePtr node, NodePtr target, NodePtr parent)
+    {
+        addedOrRemovedHandler(node, target, parent);
+    };
+
+    _addedSlot = target->added().connect(addedOrRemovedCallback);
+    _removedSlot = target->removed().connect(addedOrRemovedCallback);
+
+    _rebuildGeometry = true;
+
+    addedOrRemovedHandler(target, target, target->parent());
+}
+
+void
+TextBatch::targetRemoved(NodePtr target)
+{
+    AbstractComponent::targetRemoved(target);
+
+    if (_surface && target->hasComponent(_surface))
+        target->removeComponent(_surface);
+
+    _surface = nullptr;
+    _vertexBuffer = nullptr;
+    _rebuildGeometry = true;
+    _dirtyGlyphRanges.clear();
+
+    _addedSlot = nullptr;
+    _removedSlot = nullptr;
+    _frameBeginSlot = nullptr;
+}
+
+void
+TextBatch::addedOrRemovedHandler(NodePtr node, NodePtr target, NodePtr parent)
+{
+    auto sceneManager = target->root()->component<SceneManager>();
+
+    if (!sceneManager)
+    {
+        _frameBeginSlot = nullptr;
+
+        return;
+    }
+
+    _frameBeginSlot = sceneManager->frameBegin()->connect(
+        [=](SceneManager::Ptr, float, float)
+        {
+            flush();
+        }
+    );
+}
+
+TextBatch::Label&
+TextBatch::label(uint id)
+{
+    if (id >= _labels.size() || !_labels[id].used)
+        throw std::invalid_argument("label");
+
+    return _labels[id];
+}
+
+void
+TextBatch::invalidate(Label& label)
+{
+    label.dirty = true;
+}
+
+void
+TextBatch::allocateGlyphs(Label& label, uint numGlyphs)
+{
+    const auto capacity = std::max(
+        LABEL_CAPACITY_GRANULARITY,
+        (numGlyphs + LABEL_CAPACITY_GRANULARITY - 1) / LABEL_CAPACITY_GRANULARITY * LABEL_CAPACITY_GRANULARITY
+    );
+
+    // first fit among the ranges released by removed or relocated labels
+    for (auto rangeIt = _freeGlyphRanges.begin(); rangeIt != _freeGlyphRanges.end(); ++rangeIt)
+    {
+        if (rangeIt->count < capacity)
+            continue;
+
+        label.firstGlyph = rangeIt->first;
+        label.capacity = rangeIt->count;
+        _freeGlyphRanges.erase(rangeIt);
+
+        return;
+    }
+
+    if (_numGlyphs + capacity > _capacity)
+    {
+        if (_numGlyphs + capacity > MAX_NUM_GLYPHS)
+            throw std::length_error("A TextBatch cannot hold more than 16384 glyphs.");
+
+        while (_numGlyphs + capacity > _capacity)
+            _capacity = std::min(_capacity * 2, MAX_NUM_GLYPHS);
+
+        _rebuildGeometry = true;
+    }
+
+    label.firstGlyph = _numGlyphs;
+    label.capacity = capacity;
+    _numGlyphs += capacity;
+}
+
+void
+TextBatch::freeGlyphs(Label& label)
+{
+    if (label.capacity == 0)
+        return;
+
+    // clear the released quads so that they are not drawn anymore
+    if (_vertexBuffer && !_rebuildGeometry)
+    {
+        auto& vertexData = _vertexBuffer->data();
+
+        std::fill(
+            vertexData.begin() + label.firstGlyph * 4 * VERTEX_SIZE,
+            vertexData.begin() + (label.firstGlyph + label.capacity) * 4 * VERTEX_SIZE,
+            0.f
+        );
+
+        _dirtyGlyphRanges.push_back(GlyphRange{ label.firstGlyph, label.capacity });
+    }
+
+    if (label.firstGlyph + label.capacity == _numGlyphs)
+        _numGlyphs = label.firstGlyph;
+    else
+        _freeGlyphRanges.push_back(GlyphRange{ label.firstGlyph, label.capacity });
+
+    label.firstGlyph = 0;
+    label.capacity = 0;
+}
+
+void
+TextBatch::rebuildGeometry()
+{
+    auto target = this->target();
+    auto context = _atlas->context();
+
+    if (_surface && target->hasComponent(_surface))
+        target->removeComponent(_surface);
+
+    // unused quads are left degenerate: the index buffer never changes until the capacity does
+    auto indexData = std::vector<unsigned short>(_capacity * 6);
+
+    for (auto i = 0u; i < _capacity; ++i)
+    {
+        const auto vertex = static_cast<unsigned short>(i * 4);
+
+        indexData[i * 6]     = vertex;
+        indexData[i * 6 + 1] = vertex + 2;
+        indexData[i * 6 + 2] = vertex + 1;
+        indexData[i * 6 + 3] = vertex;
+        indexData[i * 6 + 4] = vertex + 3;
+        indexData[i * 6 + 5] = vertex + 2;
+    }
+
+    _vertexBuffer = render::VertexBuffer::create(context, std::vector<float>(_capacity * 4 * VERTEX_SIZE, 0.f));
+    _vertexBuffer->addAttribute("position", 3, 0);
+    _vertexBuffer->addAttribute("uv", 2, 3);
+
+    auto geometry = geometry::Geometry::create("text-batch");
+
+    geometry->addVertexBuffer(_vertexBuffer);
+    geometry->indices(render::IndexBuffer::create(context, indexData));
+
+    // distance field glyphs: the edge of the glyphs is at alpha = .5
+    if (!_material->data()->hasProperty("alphaThreshold"))
+        _material->data()->set("alphaThreshold", .5f);
+    if (!_material->data()->hasProperty("triangleCulling"))
+        _material->data()->set("triangleCulling", render::TriangleCulling::NONE);
+    if (!_material->data()->hasProperty("priority"))
+        _material->data()->set("priority", render::Priority::TRANSPARENT);
+    if (!_material->data()->hasProperty("blendingMode"))
+        _material->data()->set("blendingMode", render::Blending::Mode::ALPHA);
+    if (!_material->data()->hasProperty("blendingSource"))
+        _material->data()->set("blendingSource", render::Blending::Source::SRC_ALPHA);
+    if (!_material->data()->hasProperty("blendingDestination"))
+        _material->data()->set("blendingDestination", render::Blending::Destination::ONE_MINUS_SRC_ALPHA);
+
+    _material->data()->set("alphaMap", _atlas->texture()->sampler());
+
+    _surface = Surface::create(geometry, _material, _effect);
+
+    target->addComponent(_surface);
+
+    for (auto& label : _labels)
+        if (label.used)
+            label.dirty = true;
+
+    _dirtyGlyphRanges.clear();
+    _rebuildGeometry = false;
+}
+
+void
+TextBatch::writeLabel(const Label& label, std::vector<float>& vertexData)
+{
+    const auto text = strToUnicode(label.text);
+    const auto scale = label.size / _atlas->pixelSize();
+    const auto z = label.position.z;
+    auto pen = math::vec2(label.position);
+    auto vertex = vertexData.begin() + label.firstGlyph * 4 * VERTEX_SIZE;
+
+    for (auto i = 0u; i < label.capacity; ++i)
+    {
+        const auto glyph = i < text.size() && text[i] != '\n' ? _atlas->glyph(text[i]) : nullptr;
+
+        if (i < text.size() && text[i] == '\n')
+        {
+            pen.x = label.position.x;
+            pen.y -= label.size * 1.2f;
+        }
+
+        if (!glyph)
+        {
+            std::fill(vertex, vertex + 4 * VERTEX_SIZE, 0.f);
+            vertex += 4 * VERTEX_SIZE;
+
+            continue;
+        }
+
+        const auto uv = _atlas->uv(*glyph);
+        const auto min = math::vec2(pen.x + glyph->offset.x * scale, pen.y + (glyph->offset.y - glyph->size.y) * scale);
+        const auto max = min + glyph->size * scale;
+
+        const float quad[] = {
+            min.x, min.y, z, uv.x, uv.w,
+            min.x, max.y, z, uv.x, uv.y,
+            max.x, max.y, z, uv.z, uv.y,
+            max.x, min.y, z, uv.z, uv.w
+        };
+
+        vertex = std::copy(std::begin(quad), std::end(quad), vertex);
+        pen.x += glyph->advance * scale;
+    }
+}
@@ -0,0 +1,353 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifdef MINKO_PLUGIN_TTF_FREETYPE
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/file/Loader.hpp"
+#include "minko/file/Options.hpp"
+#include "minko/log/Logger.hpp"
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/GlyphAtlas.hpp"
+#include "minko/render/RectangleTexture.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+struct GlyphAtlas::FontFace
+{
+#ifdef MINKO_PLUGIN_TTF_FREETYPE
+    FT_Library                  library;
+    FT_Face                     face;
+    std::vector<unsigned char>  data;
+
+    FontFace() :
+        library(nullptr),
+        face(nullptr),
+        data()
+    {
+    }
+
+    ~FontFace()
+    {
+        if (face)
+            FT_Done_Face(face);
+        if (library)
+            FT_Done_FreeType(library);
+    }
+#endif
+};
+
+GlyphAtlas::GlyphAtlas(AbstractContext::Ptr context,
+                       uint                 pixelSize,
+                       uint                 spread,
+                       uint                 width,
+                       uint                 maxHeight) :
+    _context(context),
+    _face(),
+    _pixelSize(pixelSize),
+    _spread(spread),
+    _cellSize(pixelSize + 2 * spread),
+    _width(width),
+    _height(0),
+    _maxHeight(std::max(maxHeight, pixelSize + 2 * spread)),
+    _texture(),
+    _dirty(false),
+    _glyphs(),
+    _lru(),
+    _freeCells(),
+    _numCells(0),
+    _version(0),
+    _numEvictedGlyphs(0)
+{
+}
+
+void
+GlyphAtlas::initialize()
+{
+    if (_cellSize > _width)
+        throw std::invalid_argument("width");
+
+    _texture = RectangleTexture::create(_context, _width, _cellSize, TextureFormat::RGBA, "glyph-atlas");
+
+    // start small: most texts only use a few dozen different glyphs
+    _height = 0;
+    grow();
+    while (_height < _width / 4 && _height < _maxHeight)
+        grow();
+
+    _version = 0;
+}
+
+#ifdef MINKO_PLUGIN_TTF_FREETYPE
+void
+GlyphAtlas::loadFont(const std::string& fontFilename)
+{
+    auto loader = file::Loader::create();
+    auto fontLoaded = false;
+
+    loader->options()->assetLibrary(file::AssetLibrary::create(_context));
+    loader->options()
+        ->loadAsynchronously(false)
+        ->storeDataIfNotParsed(true);
+
+    auto errorSlot = loader->error()->connect([](file::Loader::Ptr loader, const file::Error& error)
+    {
+        LOG_ERROR(error.type() << ": " << error.what());
+    });
+
+    auto completeSlot = loader->complete()->connect([&](file::Loader::Ptr loader)
+    {
+        fontLoaded = true;
+    });
+
+    loader->queue(fontFilename)->load();
+
+    auto face = std::make_shared<FontFace>();
+
+    if (fontLoaded)
+        face->data = loader->options()->assetLibrary()->blob(fontFilename);
+
+    if (!fontLoaded
+        || FT_Init_FreeType(&face->library)
+        || FT_New_Memory_Face(face->library, face->data.data(), static_cast<FT_Long>(face->data.size()), 0, &face->face)
+        || FT_Set_Pixel_Sizes(face->face, 0, _pixelSize))
+    {
+        const auto error = std::string("Failed to load font: " + fontFilename);
+
+        LOG_ERROR(error);
+
+        throw std::runtime_error(error);
+    }
+
+    _face = face;
+}
+#endif
+
+const GlyphAtlas::Glyph*
+GlyphAtlas::glyph(unsigned long codepoint)
+{
+    auto glyphIt = _glyphs.find(codepoint);
+
+    if (glyphIt != _glyphs.end())
+    {
+        _lru.splice(_lru.begin(), _lru, glyphIt->second.second);
+
+        return &glyphIt->second.first;
+    }
+
+#ifdef MINKO_PLUGIN_TTF_FREETYPE
+    if (_face && !FT_Load_Char(_face->face, codepoint, FT_LOAD_RENDER))
+    {
+        const auto& slot = *_face->face->glyph;
+        const auto& bitmap = slot.bitmap;
+        auto coverage = std::vector<unsigned char>(bitmap.width * bitmap.rows);
+
+        for (auto y = 0u; y < bitmap.rows; ++y)
+            std::copy(
+                bitmap.buffer + y * bitmap.pitch,
+                bitmap.buffer + y * bitmap.pitch + bitmap.width,
+                coverage.begin() + y * bitmap.width
+            );
+
+        return addGlyph(
+            codepoint,
+            coverage.data(),
+            bitmap.width,
+            bitmap.rows,
+            math::ivec2(slot.bitmap_left, slot.bitmap_top),
+            slot.advance.x / 64.f
+        );
+    }
+#endif
+
+    return nullptr;
+}
+
+const GlyphAtlas::Glyph*
+GlyphAtlas::addGlyph(unsigned long          codepoint,
+                     const unsigned char*   coverage,
+                     uint                   width,
+                     uint                   height,
+                     const math::ivec2&     bearing,
+                     float                  advance)
+{
+    auto glyphIt = _glyphs.find(codepoint);
+    auto cell = 0u;
+
+    if (glyphIt != _glyphs.end())
+    {
+        cell = glyphIt->second.first.cell;
+        _lru.splice(_lru.begin(), _lru, glyphIt->second.second);
+    }
+    else
+    {
+        if (!allocateCell(cell))
+            return nullptr;
+
+        _lru.push_front(codepoint);
+        glyphIt = _glyphs.emplace(codepoint, CachedGlyph(Glyph(), _lru.begin())).first;
+    }
+
+    // glyphs bigger than the nominal pixel size are clipped to their cell
+    width = std::min(width, _cellSize - 2 * _spread);
+    height = std::min(height, _cellSize - 2 * _spread);
+
+    writeDistanceField(cell, coverage, width, height);
+
+    auto& glyph = glyphIt->second.first;
+
+    glyph.codepoint = codepoint;
+    glyph.cell = cell;
+    glyph.offset = math::vec2(bearing.x - static_cast<int>(_spread), bearing.y + static_cast<int>(_spread));
+    glyph.size = math::vec2(width + 2 * _spread, height + 2 * _spread);
+    glyph.advance = advance;
+
+    return &glyph;
+}
+
+math::vec4
+GlyphAtlas::uv(const Glyph& glyph) const
+{
+    const auto numColumns = _width / _cellSize;
+    const auto x = static_cast<float>((glyph.cell % numColumns) * _cellSize);
+    const auto y = static_cast<float>((glyph.cell / numColumns) * _cellSize);
+
+    return math::vec4(
+        x / _width,
+        y / _height,
+        (x + glyph.size.x) / _width,
+        (y + glyph.size.y) / _height
+    );
+}
+
+void
+GlyphAtlas::upload()
+{
+    if (!_dirty)
+        return;
+
+    _texture->upload();
+    _dirty = false;
+}
+
+bool
+GlyphAtlas::allocateCell(uint& cell)
+{
+    if (_freeCells.empty() && _height + _cellSize <= _maxHeight)
+        grow();
+
+    if (!_freeCells.empty())
+    {
+        cell = _freeCells.back();
+        _freeCells.pop_back();
+
+        return true;
+    }
+
+    if (_lru.empty())
+        return false;
+
+    // evict the least recently used glyph and reuse its cell: the texts using it must be rebuilt
+    auto evictedGlyphIt = _glyphs.find(_lru.back());
+
+    cell = evictedGlyphIt->second.first.cell;
+    _glyphs.erase(evictedGlyphIt);
+    _lru.pop_back();
+
+    ++_numEvictedGlyphs;
+    ++_version;
+
+    return true;
+}
+
+void
+GlyphAtlas::grow()
+{
+    const auto numColumns = _width / _cellSize;
+    const auto height = std::min(std::max(_height * 2, _cellSize), _maxHeight);
+    const auto numCells = numColumns * (height / _cellSize);
+
+    if (numCells == _numCells)
+        return;
+
+    // rows are appended at the bottom: existing cells keep their texels but not their UVs
+    auto data = std::vector<unsigned char>(_width * height * 4, 0);
+
+    std::copy(_texture->data().begin(), _texture->data().end(), data.begin());
+
+    _texture->dispose();
+    _texture->data(data.data(), _width, height);
+
+    for (auto cell = numCells; cell > _numCells; --cell)
+        _freeCells.push_back(cell - 1);
+
+    _height = height;
+    _numCells = numCells;
+    _dirty = true;
+
+    ++_version;
+}
+
+void
+GlyphAtlas::writeDistanceField(uint cell, const unsigned char* coverage, uint width, uint height)
+{
+    const auto numColumns = _width / _cellSize;
+    const auto cellX = (cell % numColumns) * _cellSize;
+    const auto cellY = (cell / numColumns) * _cellSize;
+    const auto spread = static_cast<int>(_spread);
+    const auto w = static_cast<int>(width);
+    const auto h = static_cast<int>(height);
+    auto& data = _texture->data();
+
+    auto inside = [&](int x, int y)
+    {
+        return x >= 0 && y >= 0 && x < w && y < h && coverage[y * w + x] >= 128;
+    };
+
+    for (auto y = 0u; y < _cellSize; ++y)
+    {
+        for (auto x = 0u; x < _cellSize; ++x)
+        {
+            const auto sx = static_cast<int>(x) - spread;
+            const auto sy = static_cast<int>(y) - spread;
+            const auto isInside = inside(sx, sy);
+            auto minDistance2 = (spread + 1) * (spread + 1);
+
+            // brute force search of the closest texel on the other side of the edge: glyph cells are
+            // small enough for this to be cheaper than a full distance transform
+            for (auto dy = -spread; dy <= spread; ++dy)
+                for (auto dx = -spread; dx <= spread; ++dx)
+                    if (dx * dx + dy * dy < minDistance2 && inside(sx + dx, sy + dy) != isInside)
+                        minDistance2 = dx * dx + dy * dy;
+
+            const auto distance = std::min(std::sqrt(static_cast<float>(minDistance2)) - .5f, static_cast<float>(spread));
+            const auto value = .5f + (isInside ? distance : -distance) / (2.f * spread);
+            const auto offset = ((cellY + y) * _width + cellX + x) * 4;
+
+            data[offset] = data[offset + 1] = data[offset + 2] = 255;
+            data[offset + 3] = static_cast<unsigned char>(math::clamp(value, 0.f, 1.f) * 255.f);
+        }
+    }
+
+    _dirty = true;
+}
@@ -23,6 +23,11 @@ newoption {
 	description = 'Disable tests.'
 }
 
+newoption {
+	trigger	= 'no-benchmark',
+	description = 'Disable the offscreen benchmark.'
+}
+
 newoption {
 	trigger = 'dist-dir',
 	description = 'Output folder for the redistributable SDK built with the \'dist\' action.'
@@ -91,6 +96,7 @@ solution "minko"
 			['assimp']				= true,
 			['audio']				= true,
 			['benchmark-cube']		= true,
+			['benchmark-physics']	= true,
 			['blending']			= true,
 			['cel-shading']         = true,
 			['clone']				= false,
@@ -185,6 +191,11 @@ solution "minko"
 		include 'test'
 	end
 
+	-- benchmark
+	if _OPTIONS['with-offscreen'] and not _OPTIONS['no-benchmark'] then
+		include 'benchmark'
+	end
+
 newaction {
 	trigger		= 'dist',
 	description	= 'Generate the distributable version of the Minko SDK.',
@@ -16,6 +16,8 @@ minko.project.application "minko-test"
 	minko.plugin.enable("websocket")
 	minko.plugin.enable("http-loader")
     minko.plugin.enable("ssl")
+	minko.plugin.enable("bullet")
+	minko.plugin.enable("ttf")
     if _OPTIONS['with-offscreen'] then
 		minko.plugin.enable("offscreen")
 	end
@@ -97,3 +97,24 @@ TEST_F(AbstractScriptTest, RequireAsset)
     ASSERT_TRUE(script->ready());
     ASSERT_TRUE(script->started());
 }
+
+TEST_F(AbstractScriptTest, FixedUpdateIsCalledAtEachTick)
+{
+    auto sceneManager = SceneManager::create(MinkoTests::canvas());
+    auto root = scene::Node::create()->addComponent(sceneManager);
+    auto script = std::make_shared<FixedUpdateScript>();
+
+    sceneManager->fixedTimestep(10.f);
+    root->addComponent(script);
+
+    // the script starts at the first frame, after that frame's ticks
+    sceneManager->nextFrame(5.f, 5.f);
+
+    ASSERT_TRUE(script->started());
+    ASSERT_TRUE(script->fixedUpdateTimes.empty());
+
+    sceneManager->nextFrame(30.f, 25.f);
+
+    ASSERT_EQ(script->fixedUpdateTimes, std::vector<float>({ 10.f, 20.f, 30.f }));
+    ASSERT_FLOAT_EQ(script->updateTime, 30.f);
+}
@@ -41,6 +41,25 @@ namespace minko
                 stop(scene::Node::Ptr target) override;
             };
 
+            class FixedUpdateScript : public AbstractScript
+            {
+            public:
+                std::vector<float> fixedUpdateTimes;
+                float updateTime = 0.f;
+
+                void
+                update(scene::Node::Ptr target) override
+                {
+                    updateTime = time();
+                }
+
+                void
+                fixedUpdate(scene::Node::Ptr target) override
+                {
+                    fixedUpdateTimes.push_back(time());
+                }
+            };
+
             class RequireAssetScript : public AbstractScript
             {
             public:
@@ -675,18 +675,26 @@ TEST_F(DirectionalLightTest, ShadowMappingEffect)
     auto fx = MinkoTests::loadEffect("effect/ShadowMap.effect", assets);
 
     ASSERT_NE(fx, nullptr);
-    ASSERT_EQ(fx->techniques().size(), 8);
+    // per cascade: the default, ESM, dynamic casters and static shadows copy techniques
+    ASSERT_EQ(fx->techniques().size(), 16);
 
     for (int i = 0; i < 4; ++i)
     {
-        const auto& technique = fx->techniques().at("shadow-map-cascade" + std::to_string(i));
-
-        ASSERT_EQ(technique.size(), 1);
-        ASSERT_TRUE(technique[0]->macroBindings().defaultValues.hasProperty("SHADOW_CASCADE_INDEX"));
-        ASSERT_TRUE(technique[0]->macroBindings().types.count("SHADOW_CASCADE_INDEX") != 0);
-        ASSERT_EQ(technique[0]->macroBindings().types["SHADOW_CASCADE_INDEX"], data::MacroBindingMap::MacroType::INT);
-        ASSERT_EQ(technique[0]->macroBindings().defaultValues.get<int>("SHADOW_CASCADE_INDEX"), i);
-        ASSERT_EQ(technique[0]->states().priority(), render::States::DEFAULT_PRIORITY);
+        for (const auto& suffix : { "", "-dynamic", "-static-copy" })
+        {
+            const auto& technique = fx->techniques().at("shadow-map-cascade" + std::to_string(i) + suffix);
+
+            ASSERT_EQ(technique.size(), 1);
+            ASSERT_TRUE(technique[0]->macroBindings().defaultValues.hasProperty("SHADOW_CASCADE_INDEX"));
+            ASSERT_TRUE(technique[0]->macroBindings().types.count("SHADOW_CASCADE_INDEX") != 0);
+            ASSERT_EQ(technique[0]->macroBindings().types["SHADOW_CASCADE_INDEX"], data::MacroBindingMap::MacroType::INT);
+            ASSERT_EQ(technique[0]->macroBindings().defaultValues.get<int>("SHADOW_CASCADE_INDEX"), i);
+        }
+
+        ASSERT_EQ(
+            fx->techniques().at("shadow-map-cascade" + std::to_string(i))[0]->states().priority(),
+            render::States::DEFAULT_PRIORITY
+        );
     }
 }
 
@@ -732,3 +740,47 @@ TEST_F(DirectionalLightTest, RenderersAndDrawCalls)
         ++rendererIndex;
     }
 }
+
+TEST_F(DirectionalLightTest, ShadowCastersCulledPerCascade)
+{
+    auto fx = MinkoTests::loadEffect("effect/Phong.effect");
+    auto root = scene::Node::create("root")
+        ->addComponent(Camera::create(math::perspective(.785f, 1.f, 0.1f, 1000.f)))
+        ->addComponent(SceneManager::create(MinkoTests::canvas()))
+        ->addComponent(Renderer::create());
+
+    auto light = DirectionalLight::create();
+    auto lightNode = scene::Node::create()->addComponent(light);
+
+    light->enableShadowMapping(256, 4);
+    root->addChild(lightNode);
+
+    auto material = material::BasicMaterial::create();
+    material->diffuseColor(math::vec4(1.f));
+
+    auto geom = geometry::CubeGeometry::create(MinkoTests::canvas()->context());
+    auto createCaster = [&](const math::vec3& position)
+    {
+        auto node = scene::Node::create("caster", scene::BuiltinLayout::DEFAULT | scene::BuiltinLayout::CAST_SHADOW)
+            ->addComponent(Transform::create(math::translate(position)))
+            ->addComponent(Surface::create(geom, material, fx))
+            ->addComponent(BoundingBox::create());
+
+        root->addChild(node);
+    };
+
+    // the first one only fits in the nearest cascade, the second one in the farthest
+    createCaster(math::vec3(0.f, 0.f, -2.f));
+    createCaster(math::vec3(0.f, 0.f, -800.f));
+
+    light->computeShadowProjection(math::mat4(1.f), math::perspective(.785f, 1.f, 0.1f, 1000.f), true);
+    root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+    auto renderers = lightNode->components<Renderer>();
+
+    ASSERT_EQ(renderers.size(), 4u);
+    ASSERT_EQ(renderers[0]->numDrawCalls(), 1);
+    ASSERT_EQ(renderers[1]->numDrawCalls(), 0);
+    ASSERT_EQ(renderers[2]->numDrawCalls(), 0);
+    ASSERT_EQ(renderers[3]->numDrawCalls(), 1);
+}
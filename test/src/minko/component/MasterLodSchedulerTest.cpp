@@ -0,0 +1,271 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MasterLodSchedulerTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+#include "minko/component/MasterLodScheduler.hpp"
+#include "minko/file/AbstractStreamedAssetParser.hpp"
+#include "minko/file/LinkedAsset.hpp"
+#include "minko/file/StreamingOptions.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::file;
+
+namespace
+{
+    // streams one LOD per request, each resident LOD weighs LOD_GPU_MEMORY bytes
+    class StreamedAssetParser :
+        public AbstractStreamedAssetParser
+    {
+    public:
+        typedef std::shared_ptr<StreamedAssetParser> Ptr;
+
+        static const int    MAX_LOD = 4;
+        static const int    LOD_SIZE = 16;
+        static const uint   LOD_GPU_MEMORY = 1000u;
+
+    public:
+        inline
+        static
+        Ptr
+        create()
+        {
+            return Ptr(new StreamedAssetParser());
+        }
+
+        void
+        fetchAllLods()
+        {
+            while (priority() > 0.f)
+            {
+                lodRequestFetchingBegin();
+                lodRequestFetchingComplete(std::vector<unsigned char>(LOD_SIZE, 0u));
+            }
+        }
+
+        static
+        std::vector<unsigned char>
+        header()
+        {
+            auto data = std::vector<unsigned char>(MINKO_SCENE_HEADER_SIZE + LOD_SIZE, 0u);
+            const auto magicNumber = MINKO_SCENE_MAGIC_NUMBER + ASSET_EXTENSION;
+
+            data[0] = (magicNumber >> 24) & 0xFF;
+            data[1] = (magicNumber >> 16) & 0xFF;
+            data[2] = (magicNumber >> 8) & 0xFF;
+            data[3] = magicNumber & 0xFF;
+            data[4] = MINKO_SCENE_VERSION_MAJOR;
+            data[6] = MINKO_SCENE_VERSION_MINOR;
+            data[7] = MINKO_SCENE_VERSION_PATCH;
+
+            return data;
+        }
+
+    protected:
+        bool
+        useDescriptor(const std::string&                filename,
+                      Options::Ptr                      options,
+                      const std::vector<unsigned char>& data,
+                      AssetLibrary::Ptr                 assetLibrary) override
+        {
+            return false;
+        }
+
+        void
+        parsed(const std::string&                filename,
+               const std::string&                resolvedFilename,
+               Options::Ptr                      options,
+               const std::vector<unsigned char>& data,
+               AssetLibrary::Ptr                 assetLibrary) override
+        {
+        }
+
+        void
+        headerParsed(const std::vector<unsigned char>&   data,
+                     Options::Ptr                        options,
+                     unsigned int&                       linkedAssetId) override
+        {
+        }
+
+        void
+        lodParsed(int                                previousLod,
+                  int                                currentLod,
+                  const std::vector<unsigned char>&  data,
+                  Options::Ptr                       options) override
+        {
+            residentLod(currentLod);
+        }
+
+        bool
+        complete(int currentLod) override
+        {
+            return currentLod == MAX_LOD;
+        }
+
+        int
+        lodEvicted(int residentLod, int lod) override
+        {
+            this->residentLod(lod);
+
+            return lod;
+        }
+
+        void
+        completed() override
+        {
+        }
+
+        void
+        lodRangeFetchingBound(int  currentLod,
+                              int  requiredLod,
+                              int& lodRangeMinSize,
+                              int& lodRangeMaxSize,
+                              int& lodRangeRequestMinSize,
+                              int& lodRangeRequestMaxSize) override
+        {
+            lodRangeMinSize = 0;
+            lodRangeMaxSize = 1;
+        }
+
+        void
+        lodRangeRequestByteRange(int lowerLod, int upperLod, int& offset, int& size) const override
+        {
+            offset = lowerLod * LOD_SIZE;
+            size = (upperLod - lowerLod + 1) * LOD_SIZE;
+        }
+
+        int
+        lodLowerBound(int lod) const override
+        {
+            return lod;
+        }
+
+        int
+        maxLod() const override
+        {
+            return MAX_LOD;
+        }
+
+    private:
+        static const int ASSET_EXTENSION = 0x00000057;
+
+        StreamedAssetParser() :
+            AbstractStreamedAssetParser()
+        {
+            assetExtension(ASSET_EXTENSION);
+        }
+
+        void
+        residentLod(int lod)
+        {
+            data()->set("maxAvailableLod", lod);
+            data()->set("residentGpuMemory", (lod + 1) * LOD_GPU_MEMORY);
+        }
+    };
+
+    const int StreamedAssetParser::MAX_LOD;
+    const int StreamedAssetParser::LOD_SIZE;
+    const uint StreamedAssetParser::LOD_GPU_MEMORY;
+
+    StreamedAssetParser::Ptr
+    createStreamedAsset(MasterLodScheduler::Ptr masterLodScheduler, data::Provider::Ptr data)
+    {
+        auto assetLibrary = AssetLibrary::create(MinkoTests::canvas()->context());
+        auto parser = StreamedAssetParser::create();
+
+        parser->data(data);
+        parser->streamingOptions(masterLodScheduler->streamingOptions());
+        parser->linkedAsset(LinkedAsset::create());
+
+        masterLodScheduler->registerLodEviction(
+            data,
+            std::bind(&AbstractStreamedAssetParser::evict, parser, std::placeholders::_1)
+        );
+
+        parser->parse("asset", "asset", assetLibrary->loader()->options(), StreamedAssetParser::header(), assetLibrary);
+
+        data->set("requiredLod", StreamedAssetParser::MAX_LOD);
+        data->set("priority", 1.f);
+
+        parser->fetchAllLods();
+
+        return parser;
+    }
+}
+
+TEST_F(MasterLodSchedulerTest, EnforceMemoryBudget)
+{
+    auto masterLodScheduler = MasterLodScheduler::create();
+
+    masterLodScheduler->memoryBudget(0u, 3u * StreamedAssetParser::LOD_GPU_MEMORY);
+
+    auto data = data::Provider::create();
+    auto parser = createStreamedAsset(masterLodScheduler, data);
+
+    ASSERT_EQ(data->get<int>("maxAvailableLod"), StreamedAssetParser::MAX_LOD);
+    ASSERT_EQ(masterLodScheduler->residentGpuMemory(), 5u * StreamedAssetParser::LOD_GPU_MEMORY);
+
+    // nothing is evicted while all the LODs are required
+    masterLodScheduler->enforceMemoryBudget();
+
+    ASSERT_EQ(masterLodScheduler->numLodEvictions(), 0u);
+    ASSERT_EQ(data->get<int>("maxAvailableLod"), StreamedAssetParser::MAX_LOD);
+
+    data->set("requiredLod", 1);
+
+    masterLodScheduler->enforceMemoryBudget();
+
+    ASSERT_EQ(masterLodScheduler->numLodEvictions(), 1u);
+    ASSERT_EQ(data->get<int>("maxAvailableLod"), 1);
+    ASSERT_EQ(masterLodScheduler->residentGpuMemory(), 2u * StreamedAssetParser::LOD_GPU_MEMORY);
+}
+
+TEST_F(MasterLodSchedulerTest, EvictedLodsAreFetchedAgain)
+{
+    auto masterLodScheduler = MasterLodScheduler::create();
+
+    masterLodScheduler->memoryBudget(0u, 3u * StreamedAssetParser::LOD_GPU_MEMORY);
+
+    auto data = data::Provider::create();
+    auto parser = createStreamedAsset(masterLodScheduler, data);
+
+    data->set("requiredLod", 1);
+
+    masterLodScheduler->enforceMemoryBudget();
+
+    ASSERT_EQ(data->get<int>("maxAvailableLod"), 1);
+    ASSERT_GT(parser->priority(), 0.f);
+
+    auto lodRequestOffset = 0;
+    auto lodRequestSize = 0;
+
+    parser->getNextLodRequestInfo(lodRequestOffset, lodRequestSize);
+
+    ASSERT_EQ(lodRequestOffset, 2 * StreamedAssetParser::LOD_SIZE);
+
+    data->set("requiredLod", StreamedAssetParser::MAX_LOD);
+
+    parser->fetchAllLods();
+
+    ASSERT_EQ(data->get<int>("maxAvailableLod"), StreamedAssetParser::MAX_LOD);
+    ASSERT_EQ(parser->priority(), 0.f);
+    ASSERT_EQ(masterLodScheduler->residentGpuMemory(), 5u * StreamedAssetParser::LOD_GPU_MEMORY);
+}
@@ -0,0 +1,273 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "POPGeometryLodSchedulerTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+#include "minko/StreamingCommon.hpp"
+#include "minko/component/MasterLodScheduler.hpp"
+#include "minko/component/POPGeometryLodScheduler.hpp"
+#include "minko/file/StreamingOptions.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+namespace
+{
+    const int MAX_LOD = 8;
+    const int LOD_INDEX_COUNT = 3;
+
+    void
+    loadLods(data::Provider::Ptr data, int lod)
+    {
+        auto availableLods = data->get<std::map<int, ProgressiveOrderedMeshLodInfo>>("availableLods");
+
+        for (auto level = 0; level <= lod; ++level)
+            availableLods[level] = ProgressiveOrderedMeshLodInfo(level, level, level * LOD_INDEX_COUNT, LOD_INDEX_COUNT);
+
+        data->set("availableLods", availableLods);
+        data->set("maxAvailableLod", lod);
+    }
+
+    struct POPGeometryScene
+    {
+        SceneManager::Ptr               sceneManager;
+        MasterLodScheduler::Ptr         masterLodScheduler;
+        POPGeometryLodScheduler::Ptr    popGeometryLodScheduler;
+        Camera::Ptr                     cameraComponent;
+        scene::Node::Ptr                camera;
+        scene::Node::Ptr                mesh;
+        data::Provider::Ptr             data;
+        float                           time;
+
+        void
+        nextFrame()
+        {
+            sceneManager->nextFrame(time, 1.f);
+
+            time += 1.f;
+        }
+
+        void
+        eye(const math::mat4& cameraMatrix)
+        {
+            camera->component<Transform>()->matrix(cameraMatrix);
+
+            nextFrame();
+        }
+    };
+
+    // a POP geometry cube at the origin, seen by a camera at z = 200, with only its first LOD loaded
+    POPGeometryScene
+    createPOPGeometryScene(float prefetchTime)
+    {
+        auto scene = POPGeometryScene();
+
+        scene.sceneManager = SceneManager::create(MinkoTests::canvas());
+        scene.masterLodScheduler = MasterLodScheduler::create();
+        scene.popGeometryLodScheduler = POPGeometryLodScheduler::create();
+        scene.time = 0.f;
+
+        scene.masterLodScheduler->streamingOptions()->popGeometryPrefetchTime(prefetchTime);
+
+        auto root = scene::Node::create("root")
+            ->addComponent(scene.sceneManager)
+            ->addComponent(scene.masterLodScheduler)
+            ->addComponent(scene.popGeometryLodScheduler);
+
+        scene.cameraComponent = Camera::create(math::perspective(.785f, 1.f, .1f, 1000.f));
+
+        // the LOD schedulers read the projection parameters along with the camera matrices
+        scene.cameraComponent->data()
+            ->set("fov", .785f)
+            ->set("aspectRatio", 1.f)
+            ->set("zNear", .1f)
+            ->set("zFar", 1000.f);
+
+        scene.camera = scene::Node::create("camera")
+            ->addComponent(Renderer::create())
+            ->addComponent(Transform::create(math::translate(math::vec3(0.f, 0.f, 200.f))))
+            ->addComponent(scene.cameraComponent);
+
+        root->addChild(scene.camera);
+
+        auto geometry = geometry::CubeGeometry::create(MinkoTests::canvas()->context());
+
+        scene.data = data::Provider::create();
+
+        geometry->data()
+            ->set("popFullPrecisionLod", float(MAX_LOD))
+            ->set("popMinBound", math::vec3(-.5f))
+            ->set("popMaxBound", math::vec3(.5f));
+
+        auto availableLods = std::map<int, ProgressiveOrderedMeshLodInfo>();
+
+        for (auto level = 0; level <= MAX_LOD; ++level)
+            availableLods[level] = ProgressiveOrderedMeshLodInfo(level, level);
+
+        scene.data->set("availableLods", availableLods);
+
+        loadLods(scene.data, 0);
+
+        scene.masterLodScheduler->registerGeometry(geometry, scene.data);
+
+        scene.mesh = scene::Node::create("mesh")
+            ->addComponent(Transform::create())
+            ->addComponent(Surface::create(
+                geometry,
+                material::BasicMaterial::create(),
+                MinkoTests::loadEffect("effect/Basic.effect")
+            ))
+            ->addComponent(BoundingBox::create());
+
+        // the eye is only positioned once the transforms are updated
+        scene.nextFrame();
+
+        root->addChild(scene.mesh);
+
+        return scene;
+    }
+
+    // moves the eye toward a POP geometry streamed by loadLodFunction until it reaches it
+    POPGeometryLodScheduler::Ptr
+    approachPOPGeometry(std::function<void(data::Provider::Ptr)> loadLodFunction)
+    {
+        auto scene = createPOPGeometryScene(20.f);
+
+        // the approach stops before the predicted eye reaches the geometry and withdraws the prediction
+        for (auto z = 200.f; z > 60.f; z -= 2.f)
+        {
+            scene.eye(math::translate(math::vec3(0.f, 0.f, z)));
+
+            loadLodFunction(scene.data);
+        }
+
+        return scene.popGeometryLodScheduler;
+    }
+
+    // a POP geometry with all its LODs loaded, seen from z = 100 without prefetching: once
+    // evaluated, it is only reevaluated when the eye travel can change its required LOD
+    POPGeometryScene
+    createSettledPOPGeometryScene()
+    {
+        auto scene = createPOPGeometryScene(0.f);
+
+        loadLods(scene.data, MAX_LOD);
+
+        for (auto i = 0; i < 3; ++i)
+            scene.eye(math::translate(math::vec3(0.f, 0.f, 100.f)));
+
+        return scene;
+    }
+}
+
+TEST_F(POPGeometryLodSchedulerTest, PrefetchAvailableWhenRequiredIsHit)
+{
+    auto popGeometryLodScheduler = approachPOPGeometry([](data::Provider::Ptr data)
+    {
+        if (data->hasProperty("requiredLod") && data->get<int>("requiredLod") > data->get<int>("maxAvailableLod"))
+            loadLods(data, data->get<int>("requiredLod"));
+    });
+
+    ASSERT_GT(popGeometryLodScheduler->numPrefetches(), 0);
+    ASSERT_GT(popGeometryLodScheduler->numPrefetchHits(), 0);
+    ASSERT_EQ(popGeometryLodScheduler->numPrefetchMisses(), 0);
+    ASSERT_FLOAT_EQ(popGeometryLodScheduler->prefetchHitRate(), 1.f);
+}
+
+TEST_F(POPGeometryLodSchedulerTest, PrefetchNotAvailableWhenRequiredIsMissed)
+{
+    // only the LODs actually required are loaded, the prefetched ones never arrive in time
+    auto popGeometryLodScheduler = approachPOPGeometry([](data::Provider::Ptr data)
+    {
+        if (!data->hasProperty("requiredLod") || data->get<int>("requiredLod") <= data->get<int>("maxAvailableLod"))
+            return;
+
+        if (data->get<float>("priority") > file::StreamingOptions::create()->popGeometryPrefetchPriority())
+            loadLods(data, data->get<int>("requiredLod"));
+    });
+
+    ASSERT_GT(popGeometryLodScheduler->numPrefetches(), 0);
+    ASSERT_EQ(popGeometryLodScheduler->numPrefetchHits(), 0);
+    ASSERT_GT(popGeometryLodScheduler->numPrefetchMisses(), 0);
+    ASSERT_FLOAT_EQ(popGeometryLodScheduler->prefetchHitRate(), 0.f);
+}
+
+TEST_F(POPGeometryLodSchedulerTest, EyeRotationDoesNotReevaluate)
+{
+    auto scene = createSettledPOPGeometryScene();
+    const auto numLodEvaluations = scene.popGeometryLodScheduler->numLodEvaluations();
+
+    for (auto angle = .1f; angle < 1.f; angle += .1f)
+        scene.eye(math::translate(math::vec3(0.f, 0.f, 100.f)) * math::rotate(angle, math::vec3(0.f, 1.f, 0.f)));
+
+    ASSERT_EQ(scene.popGeometryLodScheduler->numLodEvaluations(), numLodEvaluations);
+}
+
+TEST_F(POPGeometryLodSchedulerTest, EyeTravelBelowSlackDoesNotReevaluate)
+{
+    auto scene = createSettledPOPGeometryScene();
+    const auto numLodEvaluations = scene.popGeometryLodScheduler->numLodEvaluations();
+
+    scene.eye(math::translate(math::vec3(0.f, 0.f, 100.001f)));
+    scene.eye(math::translate(math::vec3(.001f, 0.f, 100.001f)));
+
+    ASSERT_EQ(scene.popGeometryLodScheduler->numLodEvaluations(), numLodEvaluations);
+}
+
+TEST_F(POPGeometryLodSchedulerTest, EyeTravelPastSlackReevaluates)
+{
+    auto scene = createSettledPOPGeometryScene();
+    const auto numLodEvaluations = scene.popGeometryLodScheduler->numLodEvaluations();
+    auto numFrames = 0u;
+
+    // the required LOD of the cube changes at least once when its distance is divided by 4
+    for (auto z = 99.5f; z >= 25.f; z -= .5f, ++numFrames)
+        scene.eye(math::translate(math::vec3(0.f, 0.f, z)));
+
+    const auto numReevaluations = scene.popGeometryLodScheduler->numLodEvaluations() - numLodEvaluations;
+
+    ASSERT_GT(numReevaluations, 0u);
+    ASSERT_LT(numReevaluations, numFrames);
+}
+
+TEST_F(POPGeometryLodSchedulerTest, SurfaceMoveReevaluates)
+{
+    auto scene = createSettledPOPGeometryScene();
+    const auto numLodEvaluations = scene.popGeometryLodScheduler->numLodEvaluations();
+
+    scene.mesh->component<Transform>()->matrix(math::translate(math::vec3(0.f, 0.f, .001f)));
+    // the world matrices are only updated when rendering begins, after the schedulers were updated
+    scene.nextFrame();
+    scene.nextFrame();
+
+    ASSERT_GT(scene.popGeometryLodScheduler->numLodEvaluations(), numLodEvaluations);
+}
+
+TEST_F(POPGeometryLodSchedulerTest, ProjectionChangeReevaluates)
+{
+    auto scene = createSettledPOPGeometryScene();
+    const auto numLodEvaluations = scene.popGeometryLodScheduler->numLodEvaluations();
+
+    scene.cameraComponent->data()->set("fov", .5f);
+    scene.cameraComponent->projectionMatrix(math::perspective(.5f, 1.f, .1f, 1000.f));
+    scene.nextFrame();
+
+    ASSERT_GT(scene.popGeometryLodScheduler->numLodEvaluations(), numLodEvaluations);
+}
@@ -419,4 +419,39 @@ TEST_F(RendererTest, RenderAfterMultipleRemovalTest)
     root->removeChild(node1);
     node2->removeComponent(node2->component<Surface>());
     renderer->render(context);
-}
\ No newline at end of file
+}
+TEST_F(RendererTest, SurfaceFilter)
+{
+    auto fx = MinkoTests::loadEffect("effect/Basic.effect");
+    auto renderer = Renderer::create();
+    auto root = scene::Node::create()
+        ->addComponent(SceneManager::create(MinkoTests::canvas()))
+        ->addComponent(Camera::create(math::perspective(.785f, 1.f, 0.1f, 1000.f)))
+        ->addComponent(renderer);
+
+    auto material = material::BasicMaterial::create();
+    material->diffuseColor(math::vec4(1.f));
+
+    auto s1 = Surface::create(geometry::CubeGeometry::create(MinkoTests::canvas()->context()), material, fx);
+    auto s2 = Surface::create(geometry::CubeGeometry::create(MinkoTests::canvas()->context()), material, fx);
+    auto s3 = Surface::create(geometry::CubeGeometry::create(MinkoTests::canvas()->context()), material, fx);
+
+    root->addComponent(s1);
+    root->addComponent(s2);
+    root->addComponent(s3);
+
+    renderer->render(MinkoTests::canvas()->context());
+    ASSERT_EQ(renderer->numDrawCalls(), 3);
+
+    renderer->surfaceFilter([=](Surface::Ptr surface) { return surface != s2; });
+    renderer->render(MinkoTests::canvas()->context());
+    ASSERT_EQ(renderer->numDrawCalls(), 2);
+
+    renderer->surfaceFilter([](Surface::Ptr surface) { return false; });
+    renderer->render(MinkoTests::canvas()->context());
+    ASSERT_EQ(renderer->numDrawCalls(), 0);
+
+    renderer->surfaceFilter(nullptr);
+    renderer->render(MinkoTests::canvas()->context());
+    ASSERT_EQ(renderer->numDrawCalls(), 3);
+}
@@ -0,0 +1,251 @@
+/*
+Copyright (c) 2016 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "SceneManagerTest.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+TEST_F(SceneManagerTest, NoTickWithoutFixedTimestep)
+{
+    auto sceneManager = SceneManager::create(MinkoTests::canvas());
+    auto root = scene::Node::create()->addComponent(sceneManager);
+    auto numTicks = 0u;
+
+    auto _ = sceneManager->tick()->connect([&](SceneManager::Ptr, float, float) { ++numTicks; });
+
+    sceneManager->nextFrame(0.f, 100.f, false);
+
+    ASSERT_EQ(numTicks, 0u);
+    ASSERT_EQ(sceneManager->numTicksLastFrame(), 0u);
+}
+
+TEST_F(SceneManagerTest, TicksAtFixedTimestep)
+{
+    auto sceneManager = SceneManager::create(MinkoTests::canvas());
+    auto root = scene::Node::create()->addComponent(sceneManager);
+    auto tickTimes = std::vector<float>();
+
+    sceneManager->fixedTimestep(10.f);
+
+    auto _ = sceneManager->tick()->connect([&](SceneManager::Ptr, float time, float deltaTime)
+    {
+        ASSERT_FLOAT_EQ(deltaTime, 10.f);
+
+        tickTimes.push_back(time);
+    });
+
+    sceneManager->nextFrame(0.f, 4.f, false);
+
+    ASSERT_TRUE(tickTimes.empty());
+    ASSERT_FLOAT_EQ(sceneManager->tickInterpolationFactor(), .4f);
+
+    sceneManager->nextFrame(0.f, 17.f, false);
+
+    ASSERT_EQ(tickTimes, std::vector<float>({ 10.f, 20.f }));
+    ASSERT_EQ(sceneManager->numTicksLastFrame(), 2u);
+    ASSERT_NEAR(sceneManager->tickInterpolationFactor(), .1f, 1e-4f);
+}
+
+TEST_F(SceneManagerTest, TicksBeyondMaxNumTicksPerFrameAreDropped)
+{
+    auto sceneManager = SceneManager::create(MinkoTests::canvas());
+    auto root = scene::Node::create()->addComponent(sceneManager);
+    auto numTicks = 0u;
+
+    sceneManager->fixedTimestep(10.f);
+    sceneManager->maxNumTicksPerFrame(3u);
+
+    auto _ = sceneManager->tick()->connect([&](SceneManager::Ptr, float, float) { ++numTicks; });
+
+    sceneManager->nextFrame(0.f, 105.f, false);
+
+    ASSERT_EQ(numTicks, 3u);
+    ASSERT_EQ(sceneManager->numDroppedTicks(), 7u);
+    ASSERT_NEAR(sceneManager->tickInterpolationFactor(), .5f, 1e-4f);
+}
+
+TEST_F(SceneManagerTest, UnlimitedTicksRunFasterThanRealTime)
+{
+    auto sceneManager = SceneManager::create(MinkoTests::canvas());
+    auto root = scene::Node::create()->addComponent(sceneManager);
+    auto numTicks = 0u;
+
+    sceneManager->fixedTimestep(1000.f / 60.f);
+    sceneManager->maxNumTicksPerFrame(0u);
+
+    auto _ = sceneManager->tick()->connect([&](SceneManager::Ptr, float, float) { ++numTicks; });
+
+    // simulate one minute in a single headless frame
+    sceneManager->nextFrame(0.f, 60000.f, false);
+
+    ASSERT_NEAR(numTicks, 3600u, 1u);
+    ASSERT_EQ(sceneManager->numDroppedTicks(), 0u);
+}
+
+TEST_F(SceneManagerTest, SurfacesAddedOncePerFrame)
+{
+    auto sceneManager = SceneManager::create(MinkoTests::canvas());
+    auto root = scene::Node::create()->addComponent(sceneManager);
+    std::vector<std::vector<Surface::Ptr>> addedBatches;
+
+    auto _ = sceneManager->surfacesAdded()->connect(
+        [&](SceneManager::Ptr, const std::vector<Surface::Ptr>& surfaces)
+        {
+            addedBatches.push_back(surfaces);
+        }
+    );
+
+    auto removed = scene::Node::create();
+
+    for (auto i = 0u; i < 3u; ++i)
+    {
+        auto node = scene::Node::create()
+            ->addComponent(Surface::create(geometry::Geometry::create(), material::Material::create(), nullptr));
+
+        root->addChild(node);
+        removed->addChild(scene::Node::create());
+    }
+
+    // added and removed before the frame begins: never reported
+    root->addChild(removed);
+    removed->addComponent(Surface::create(geometry::Geometry::create(), material::Material::create(), nullptr));
+    root->removeChild(removed);
+
+    ASSERT_TRUE(addedBatches.empty());
+
+    sceneManager->nextFrame(0.f, 0.f, false);
+
+    ASSERT_EQ(addedBatches.size(), 1u);
+    ASSERT_EQ(addedBatches[0].size(), 3u);
+
+    sceneManager->nextFrame(0.f, 0.f, false);
+
+    ASSERT_EQ(addedBatches.size(), 1u);
+}
+
+TEST_F(SceneManagerTest, SurfacesRemovedWithTheirSubtree)
+{
+    auto sceneManager = SceneManager::create(MinkoTests::canvas());
+    auto root = scene::Node::create()->addComponent(sceneManager);
+    auto subtree = scene::Node::create();
+    auto surface = Surface::create(geometry::Geometry::create(), material::Material::create(), nullptr);
+    std::vector<std::vector<Surface::Ptr>> removedBatches;
+
+    subtree
+        ->addComponent(Surface::create(geometry::Geometry::create(), material::Material::create(), nullptr))
+        ->addChild(scene::Node::create()->addComponent(surface));
+    root->addChild(subtree);
+    sceneManager->nextFrame(0.f, 0.f, false);
+
+    auto _ = sceneManager->surfacesRemoved()->connect(
+        [&](SceneManager::Ptr, const std::vector<Surface::Ptr>& surfaces)
+        {
+            // the surfaces still have their target when they are reported
+            for (auto surface : surfaces)
+                ASSERT_NE(surface->target(), nullptr);
+
+            removedBatches.push_back(surfaces);
+        }
+    );
+
+    surface->target()->removeComponent(surface);
+
+    ASSERT_EQ(removedBatches.size(), 1u);
+    ASSERT_EQ(removedBatches[0].size(), 1u);
+    ASSERT_EQ(removedBatches[0][0], surface);
+
+    root->removeChild(subtree);
+
+    ASSERT_EQ(removedBatches.size(), 2u);
+    ASSERT_EQ(removedBatches[1].size(), 1u);
+}
+
+TEST_F(SceneManagerTest, RecordedRenderersAreDrawnInPriorityOrder)
+{
+    auto sceneManager = SceneManager::create(MinkoTests::canvas());
+    auto root = scene::Node::create()->addComponent(sceneManager);
+    auto first = Renderer::create(0xff0000ff, nullptr, nullptr, "default", 1.f);
+    auto second = Renderer::create(0x00ff00ff, nullptr, nullptr, "default", 0.f);
+    auto events = std::vector<std::string>();
+
+    sceneManager->numRecordingThreads(2);
+    root
+        ->addComponent(first)
+        ->addComponent(second);
+
+    auto firstBegin = first->renderingBegin()->connect([&](Renderer::Ptr) { events.push_back("first begin"); });
+    auto firstEnd = first->renderingEnd()->connect([&](Renderer::Ptr) { events.push_back("first end"); });
+    auto secondBegin = second->renderingBegin()->connect([&](Renderer::Ptr) { events.push_back("second begin"); });
+    auto secondEnd = second->renderingEnd()->connect([&](Renderer::Ptr) { events.push_back("second end"); });
+
+    sceneManager->nextFrame(0.f, 0.f);
+
+    ASSERT_EQ(events, std::vector<std::string>({ "first begin", "second begin", "first end", "second end" }));
+    ASSERT_GT(first->commandList()->numCommands(), 0u);
+    ASSERT_GT(second->commandList()->numCommands(), 0u);
+}
+
+TEST_F(SceneManagerTest, RecordingThreadsAreKeptAcrossFrames)
+{
+    auto sceneManager = SceneManager::create(MinkoTests::canvas());
+    auto root = scene::Node::create()->addComponent(sceneManager);
+    auto renderers = std::vector<Renderer::Ptr>();
+    auto numRenderings = 0u;
+    auto slots = std::vector<Signal<Renderer::Ptr>::Slot>();
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        auto renderer = Renderer::create(0xff0000ff, nullptr, nullptr, "default", float(i));
+
+        slots.push_back(renderer->renderingEnd()->connect([&](Renderer::Ptr) { ++numRenderings; }));
+        renderers.push_back(renderer);
+        root->addComponent(renderer);
+    }
+
+    // the workers started for 3 threads stay alive when a frame needs fewer of them
+    for (auto numThreads : { 3u, 3u, 2u, 1u, 3u })
+    {
+        sceneManager->numRecordingThreads(numThreads);
+        sceneManager->nextFrame(0.f, 0.f);
+
+        for (const auto& renderer : renderers)
+            ASSERT_GT(renderer->commandList()->numCommands(), 0u);
+    }
+
+    ASSERT_EQ(numRenderings, 15u);
+}
+
+TEST_F(SceneManagerTest, RenderersRenderRightAwayByDefault)
+{
+    auto sceneManager = SceneManager::create(MinkoTests::canvas());
+    auto root = scene::Node::create()->addComponent(sceneManager);
+    auto renderer = Renderer::create();
+    auto events = std::vector<std::string>();
+
+    root->addComponent(renderer);
+
+    auto begin = renderer->renderingBegin()->connect([&](Renderer::Ptr) { events.push_back("begin"); });
+    auto end = renderer->renderingEnd()->connect([&](Renderer::Ptr) { events.push_back("end"); });
+
+    sceneManager->nextFrame(0.f, 0.f);
+
+    ASSERT_EQ(sceneManager->numRecordingThreads(), 0u);
+    ASSERT_EQ(events, std::vector<std::string>({ "begin", "end" }));
+    ASSERT_EQ(renderer->commandList()->numCommands(), 0u);
+}
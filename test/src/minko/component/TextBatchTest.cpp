@@ -0,0 +1,120 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextBatchTest.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+void
+TextBatchTest::SetUp()
+{
+    _context = render::RecordingContext::create();
+    // 40x40 cells: 2 columns, 1 row at first and at most 4 rows
+    _atlas = render::GlyphAtlas::create(_context, 32, 4, 80, 160);
+    _batch = TextBatch::create(_atlas, material::Material::create(), nullptr);
+
+    addGlyph('a');
+    addGlyph('b');
+
+    // out of a scene, flush() uploads the dirty ranges right away
+    scene::Node::create()->addComponent(_batch);
+}
+
+void
+TextBatchTest::addGlyph(unsigned long codepoint)
+{
+    static const auto box = std::vector<unsigned char>(16 * 16, 255);
+
+    _atlas->addGlyph(codepoint, box.data(), 16, 16, math::ivec2(0, 16), 18.f);
+}
+
+const std::vector<float>&
+TextBatchTest::vertexData()
+{
+    return _batch->target()->component<Surface>()->geometry()->vertexBuffer("uv")->data();
+}
+
+TEST_F(TextBatchTest, MergeContiguousDirtyRanges)
+{
+    // each label holds 8 glyphs: label i uses the glyphs [8 * i, 8 * i + 8)
+    auto label0 = _batch->addLabel("ab", math::vec3(), 1.f);
+    auto label1 = _batch->addLabel("ab", math::vec3(), 1.f);
+    auto label2 = _batch->addLabel("ab", math::vec3(), 1.f);
+
+    _batch->flush();
+
+    ASSERT_EQ(_batch->numUploadedGlyphsLastFlush(), 24u);
+
+    _batch->text(label0, "ba");
+    _batch->text(label1, "ba");
+    _context->resetCounters();
+    _batch->flush();
+
+    ASSERT_EQ(_batch->numUploadedGlyphsLastFlush(), 16u);
+    ASSERT_EQ(_context->counters().numCommands, 1u);
+
+    _batch->text(label0, "ab");
+    _batch->text(label2, "ba");
+    _context->resetCounters();
+    _batch->flush();
+
+    ASSERT_EQ(_batch->numUploadedGlyphsLastFlush(), 16u);
+    ASSERT_EQ(_context->counters().numCommands, 2u);
+
+    // the range of a removed label is cleared along with its neighbours
+    _batch->removeLabel(label1);
+    _batch->position(label2, math::vec3(1.f, 0.f, 0.f));
+    _context->resetCounters();
+    _batch->flush();
+
+    ASSERT_EQ(_batch->numUploadedGlyphsLastFlush(), 16u);
+    ASSERT_EQ(_context->counters().numCommands, 1u);
+}
+
+TEST_F(TextBatchTest, RewriteEveryLabelWhenTheAtlasGrows)
+{
+    auto label0 = _batch->addLabel("ab", math::vec3(), 1.f);
+
+    _batch->addLabel("ba", math::vec3(), 1.f);
+    _batch->flush();
+
+    const auto version = _atlas->version();
+    const auto oldUv = _atlas->uv(*_atlas->glyph('a'));
+
+    // the atlas is full: the new glyph grows it and moves the UVs of the cached ones
+    addGlyph('c');
+
+    ASSERT_GT(_atlas->version(), version);
+
+    _batch->text(label0, "abc");
+    _batch->flush();
+
+    const auto uv = _atlas->uv(*_atlas->glyph('a'));
+
+    ASSERT_NE(uv, oldUv);
+    ASSERT_EQ(_batch->numUploadedGlyphsLastFlush(), 16u);
+
+    // the second label, left unchanged, uses the new UVs: its first quad is 'b', then 'a'
+    const auto& data = vertexData();
+    const auto secondQuadOfLabel1 = (8 + 1) * 4 * 5;
+
+    ASSERT_FLOAT_EQ(data[secondQuadOfLabel1 + 3], uv.x);
+    ASSERT_FLOAT_EQ(data[secondQuadOfLabel1 + 4], uv.w);
+}
@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2016 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "TransformInterpolationTest.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+TEST_F(TransformInterpolationTest, Interpolate)
+{
+    auto from = math::translate(math::vec3(0.f, 0.f, 0.f));
+    auto to = math::translate(math::vec3(10.f, 0.f, 0.f)) * math::rotate(math::half_pi<float>(), math::vec3(0.f, 1.f, 0.f));
+
+    auto matrix = TransformInterpolation::interpolate(from, to, .5f);
+
+    ASSERT_NEAR(matrix[3].x, 5.f, 1e-4f);
+    ASSERT_NEAR(math::length(math::vec3(matrix[0])), 1.f, 1e-4f);
+    ASSERT_NEAR(
+        math::dot(math::vec3(matrix[0]), math::vec3(1.f, 0.f, 0.f)),
+        std::cos(math::quarter_pi<float>()),
+        1e-4f
+    );
+}
+
+TEST_F(TransformInterpolationTest, InterpolatesBetweenLastTwoTicks)
+{
+    auto sceneManager = SceneManager::create(MinkoTests::canvas());
+    auto root = scene::Node::create()->addComponent(sceneManager);
+    auto node = scene::Node::create()
+        ->addComponent(Transform::create())
+        ->addComponent(TransformInterpolation::create());
+
+    root->addChild(node);
+
+    sceneManager->fixedTimestep(10.f);
+
+    auto position = 0.f;
+    auto simulatedPositions = std::vector<float>();
+
+    auto _ = sceneManager->tick()->connect([&](SceneManager::Ptr, float, float)
+    {
+        auto transform = node->component<Transform>();
+
+        simulatedPositions.push_back(transform->matrix()[3].x);
+
+        position += 1.f;
+        transform->matrix(math::translate(math::vec3(position, 0.f, 0.f)));
+    });
+
+    sceneManager->nextFrame(0.f, 20.f, false);
+
+    // rendering lags one tick behind the simulation
+    ASSERT_FLOAT_EQ(node->component<Transform>()->matrix()[3].x, 1.f);
+
+    sceneManager->nextFrame(0.f, 5.f, false);
+
+    // halfway between the ticks at x = 1 and x = 2
+    ASSERT_NEAR(node->component<Transform>()->matrix()[3].x, 1.5f, 1e-4f);
+
+    sceneManager->nextFrame(0.f, 5.f, false);
+
+    // simulation code only ever sees the simulated values
+    ASSERT_EQ(simulatedPositions, std::vector<float>({ 0.f, 1.f, 2.f }));
+    ASSERT_NEAR(node->component<Transform>()->matrix()[3].x, 2.f, 1e-4f);
+}
+
+TEST_F(TransformInterpolationTest, ChangeOutsideOfTicksIsNotInterpolated)
+{
+    auto sceneManager = SceneManager::create(MinkoTests::canvas());
+    auto root = scene::Node::create()->addComponent(sceneManager);
+    auto node = scene::Node::create()
+        ->addComponent(Transform::create())
+        ->addComponent(TransformInterpolation::create());
+
+    root->addChild(node);
+
+    sceneManager->fixedTimestep(10.f);
+
+    auto _ = sceneManager->tick()->connect([&](SceneManager::Ptr, float, float)
+    {
+        auto transform = node->component<Transform>();
+
+        transform->matrix(math::translate(math::vec3(1.f, 0.f, 0.f)) * transform->matrix());
+    });
+
+    sceneManager->nextFrame(0.f, 15.f, false);
+
+    node->component<Transform>()->matrix(math::translate(math::vec3(100.f, 0.f, 0.f)));
+
+    sceneManager->nextFrame(0.f, 0.f, false);
+
+    ASSERT_FLOAT_EQ(node->component<Transform>()->matrix()[3].x, 100.f);
+
+    sceneManager->nextFrame(0.f, 10.f, false);
+
+    // one tick later: halfway between 100 and 101
+    ASSERT_NEAR(node->component<Transform>()->matrix()[3].x, 100.5f, 1e-4f);
+}
@@ -0,0 +1,148 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PhysicsWorldTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::component::bullet;
+
+void
+bullet::PhysicsWorldTest::SetUp()
+{
+    _sceneManager = SceneManager::create(MinkoTests::canvas());
+    _root = scene::Node::create("root")
+        ->addComponent(_sceneManager)
+        ->addComponent(PhysicsWorld::create());
+
+    // a static 20x1x20 slab whose top face lies at y = 0
+    _ground = Collider::create(ColliderData::create(0.f, BoxShape::create(10.f, .5f, 10.f)));
+
+    _root->addChild(scene::Node::create("ground")
+        ->addComponent(Transform::create(math::translate(math::vec3(0.f, -.5f, 0.f))))
+        ->addComponent(_ground)
+    );
+}
+
+bullet::Collider::Ptr
+bullet::PhysicsWorldTest::addBall(const math::vec3& position)
+{
+    auto ball = Collider::create(ColliderData::create(1.f, SphereShape::create(.5f)));
+
+    _root->addChild(scene::Node::create("ball")
+        ->addComponent(Transform::create(math::translate(position)))
+        ->addComponent(ball)
+    );
+
+    return ball;
+}
+
+void
+bullet::PhysicsWorldTest::nextFrames(uint numFrames)
+{
+    for (auto i = 0u; i < numFrames; ++i)
+        _sceneManager->nextFrame(i * 1000.f / 60.f, 1000.f / 60.f, false);
+}
+
+TEST_F(PhysicsWorldTest, CollisionStartedAndEnded)
+{
+    auto ball = addBall(math::vec3(0.f, 1.f, 0.f));
+    auto numStarted = 0;
+    auto numEnded = 0;
+
+    ball->triggerCollisions(true);
+
+    auto startedSlot = ball->collisionStarted()->connect([&](Collider::Ptr collider, Collider::Ptr other)
+    {
+        if (collider == ball && other == _ground)
+            ++numStarted;
+    });
+    auto endedSlot = ball->collisionEnded()->connect([&](Collider::Ptr collider, Collider::Ptr other)
+    {
+        if (collider == ball && other == _ground)
+            ++numEnded;
+    });
+
+    nextFrames(60);
+
+    ASSERT_EQ(numStarted, 1);
+    ASSERT_EQ(numEnded, 0);
+
+    ball->target()->component<Transform>()->matrix(math::translate(math::vec3(0.f, 50.f, 0.f)));
+    ball->synchronizePhysicsWithGraphics(true);
+    nextFrames(1);
+
+    ASSERT_EQ(numStarted, 1);
+    ASSERT_EQ(numEnded, 1);
+}
+
+TEST_F(PhysicsWorldTest, StaticBodyTransformIsNotWritten)
+{
+    auto ball = addBall(math::vec3(0.f, 3.f, 0.f));
+
+    // colliders join the world, and write their initial transform, on the first frame
+    nextFrames(1);
+
+    auto numGroundChanges = 0;
+    auto numBallChanges = 0;
+
+    auto groundSlot = _ground->physicsTransformChanged()->connect([&](Collider::Ptr, math::mat4)
+    {
+        ++numGroundChanges;
+    });
+    auto ballSlot = ball->physicsTransformChanged()->connect([&](Collider::Ptr, math::mat4)
+    {
+        ++numBallChanges;
+    });
+
+    nextFrames(30);
+
+    ASSERT_EQ(numGroundChanges, 0);
+    ASSERT_EQ(numBallChanges, 30);
+    ASSERT_EQ(_ground->target()->component<Transform>()->matrix(), math::translate(math::vec3(0.f, -.5f, 0.f)));
+}
+
+TEST_F(PhysicsWorldTest, SleepingBodyMovedFromTheSceneFallsAgain)
+{
+    auto ball = addBall(math::vec3(0.f, .5f, 0.f));
+    auto transform = ball->target()->component<Transform>();
+
+    ball->canSleep(true);
+
+    // resting bodies are put to sleep after 2 seconds
+    nextFrames(180);
+
+    auto numBallChanges = 0;
+    auto ballSlot = ball->physicsTransformChanged()->connect([&](Collider::Ptr, math::mat4)
+    {
+        ++numBallChanges;
+    });
+
+    nextFrames(10);
+
+    ASSERT_EQ(numBallChanges, 0);
+
+    transform->matrix(math::translate(math::vec3(0.f, 10.f, 0.f)));
+    ball->synchronizePhysicsWithGraphics(true);
+    nextFrames(10);
+
+    ASSERT_LT(transform->matrix()[3].y, 10.f);
+}
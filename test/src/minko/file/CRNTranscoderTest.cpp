@@ -0,0 +1,118 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "gtest/gtest.h"
+
+#include "minko/file/CRNTranscoder.hpp"
+#include "minko/file/CRNTranscoderTest.hpp"
+#include "minko/file/WriterOptions.hpp"
+#include "minko/render/TextureFormatInfo.hpp"
+
+using namespace minko;
+using namespace minko::file;
+using namespace minko::render;
+
+namespace
+{
+    Texture::Ptr
+    createTexture(uint size)
+    {
+        auto texture = Texture::create(nullptr, size, size, false, false, false, TextureFormat::RGBA);
+
+        auto data = std::vector<unsigned char>(size * size * 4u);
+
+        for (auto y = 0u; y < size; ++y)
+            for (auto x = 0u; x < size; ++x)
+            {
+                auto pixel = data.data() + (x + y * size) * 4u;
+
+                pixel[0] = static_cast<unsigned char>(x * 255u / size);
+                pixel[1] = static_cast<unsigned char>(y * 255u / size);
+                pixel[2] = static_cast<unsigned char>((x ^ y) & 0xff);
+                pixel[3] = static_cast<unsigned char>(x < size / 2u ? 255u : 128u);
+            }
+
+        texture->data(data.data());
+
+        return texture;
+    }
+
+    uint
+    mipChainSize(TextureFormat format, uint size)
+    {
+        auto result = 0u;
+
+        for (auto i = 0u; i < AbstractTexture::numMipMaps(size, size); ++i)
+            result += TextureFormatInfo::textureSize(format, std::max(size >> i, 1u), std::max(size >> i, 1u));
+
+        return result;
+    }
+}
+
+TEST_F(CRNTranscoderTest, SupportsDXTFormatsOnly)
+{
+    ASSERT_TRUE(CRNTranscoder::supportsFormat(TextureFormat::RGB_DXT1));
+    ASSERT_TRUE(CRNTranscoder::supportsFormat(TextureFormat::RGBA_DXT1));
+    ASSERT_TRUE(CRNTranscoder::supportsFormat(TextureFormat::RGBA_DXT3));
+    ASSERT_TRUE(CRNTranscoder::supportsFormat(TextureFormat::RGBA_DXT5));
+    ASSERT_FALSE(CRNTranscoder::supportsFormat(TextureFormat::RGBA));
+    ASSERT_FALSE(CRNTranscoder::supportsFormat(TextureFormat::RGB_ETC1));
+}
+
+TEST_F(CRNTranscoderTest, ConcurrentTranscodeMatchesSequentialTranscode)
+{
+    auto texture = createTexture(64u);
+    auto writerOptions = WriterOptions::create()->numTranscodingThreads(4u);
+
+    const auto formats = std::vector<TextureFormat>{ TextureFormat::RGB_DXT1, TextureFormat::RGBA_DXT3, TextureFormat::RGBA_DXT5 };
+
+    auto out = std::vector<std::vector<unsigned char>>();
+
+    ASSERT_TRUE(CRNTranscoder::transcode(texture, "", writerOptions, formats, out));
+    ASSERT_EQ(out.size(), formats.size());
+
+    for (auto i = 0u; i < formats.size(); ++i)
+    {
+        auto expected = std::vector<unsigned char>();
+
+        ASSERT_TRUE(CRNTranscoder::transcode(texture, "", writerOptions->numTranscodingThreads(1u), formats[i], expected));
+        ASSERT_EQ(out[i].size(), mipChainSize(formats[i], 64u));
+        ASSERT_EQ(out[i], expected);
+    }
+}
+
+TEST_F(CRNTranscoderTest, CachedTranscodeMatchesTranscode)
+{
+    auto texture = createTexture(32u);
+    auto writerOptions = WriterOptions::create();
+
+    auto expected = std::vector<unsigned char>();
+
+    ASSERT_TRUE(CRNTranscoder::transcode(texture, "", writerOptions, TextureFormat::RGBA_DXT5, expected));
+
+    writerOptions->transcodedTextureCacheDirectory(".");
+
+    auto transcoded = std::vector<unsigned char>();
+    auto cached = std::vector<unsigned char>();
+
+    ASSERT_TRUE(CRNTranscoder::transcode(texture, "", writerOptions, TextureFormat::RGBA_DXT5, transcoded));
+    ASSERT_TRUE(CRNTranscoder::transcode(texture, "", writerOptions, TextureFormat::RGBA_DXT5, cached));
+
+    ASSERT_EQ(transcoded, expected);
+    ASSERT_EQ(cached, expected);
+}
@@ -2525,3 +2525,78 @@ TEST_F(EffectParserTest, ExtendedPassOverridesMacroDefault)
     ASSERT_EQ(fx->techniques().at("default")[1]->macroBindings().types["FOO"], data::MacroBindingMap::MacroType::INT);
     ASSERT_EQ(fx->techniques().at("default")[1]->macroBindings().defaultValues.get<int>("FOO"), 23);
 }
+
+TEST_F(EffectParserTest, ExtendedPassRemovesMacro)
+{
+    auto fx = MinkoTests::loadEffect("effect/pass/extends/RemoveMacro.effect");
+
+    ASSERT_NE(fx, nullptr);
+    ASSERT_EQ(fx->techniques().at("default").size(), 1);
+
+    auto& macroBindings = fx->techniques().at("default")[0]->macroBindings();
+
+    ASSERT_FALSE(macroBindings.defaultValues.hasProperty("FOO"));
+    ASSERT_EQ(macroBindings.types.count("FOO"), 0);
+    ASSERT_EQ(macroBindings.bindings.count("BAR"), 0);
+    ASSERT_EQ(macroBindings.types.count("BAR"), 0);
+    ASSERT_EQ(macroBindings.bindings.count("BAZ"), 1);
+}
+
+TEST_F(EffectParserTest, TransientTargetsAreCulledAndAliased)
+{
+    auto fx = MinkoTests::loadEffect("effect/target/TransientTargets.effect");
+
+    ASSERT_NE(fx, nullptr);
+
+    const auto& passes = fx->techniques().at("default");
+
+    ASSERT_EQ(passes.size(), 4);
+    ASSERT_EQ(passes[1]->name(), "blur horizontal");
+    ASSERT_NE(fx->renderGraph("default"), nullptr);
+    ASSERT_EQ(fx->renderGraph("default")->numPhysicalTargets(), 2);
+    ASSERT_FALSE(fx->data()->hasProperty("unused"));
+
+    auto threshold = fx->data()->get<render::TextureSampler>("threshold");
+    auto blurH = fx->data()->get<render::TextureSampler>("blur-h");
+    auto blurV = fx->data()->get<render::TextureSampler>("blur-v");
+
+    ASSERT_EQ(threshold.id, blurV.id);
+    ASSERT_NE(threshold.id, blurH.id);
+    ASSERT_EQ(passes[0]->states().target().id, threshold.id);
+    ASSERT_EQ(passes[2]->states().target().id, blurV.id);
+}
+
+TEST_F(EffectParserTest, TransientTargetsReferencedOtherwiseAreNotCulled)
+{
+    auto fx = MinkoTests::loadEffect("effect/target/TransientTargetsOtherReferences.effect");
+
+    ASSERT_NE(fx, nullptr);
+
+    // "mask" is bound without the effect scope and "luminance" only defines a macro: their passes are kept
+    const auto& passes = fx->techniques().at("default");
+
+    ASSERT_EQ(passes.size(), 4);
+    ASSERT_EQ(passes[1]->name(), "mask");
+    ASSERT_EQ(passes[2]->name(), "luminance");
+    ASSERT_TRUE(fx->data()->hasProperty("mask"));
+    ASSERT_TRUE(fx->data()->hasProperty("luminance"));
+    ASSERT_NE(fx->data()->get<render::TextureSampler>("mask").id, fx->data()->get<render::TextureSampler>("threshold").id);
+    ASSERT_NE(fx->data()->get<render::TextureSampler>("luminance").id, fx->data()->get<render::TextureSampler>("threshold").id);
+}
+
+TEST_F(EffectParserTest, TransientTargetsPassesInExecutionOrder)
+{
+    auto fx = MinkoTests::loadEffect("effect/target/TransientTargetsPriority.effect");
+
+    ASSERT_NE(fx, nullptr);
+
+    // passes are declared in the reverse order of their priorities
+    const auto& passes = fx->techniques().at("default");
+
+    ASSERT_EQ(passes.size(), 3);
+    ASSERT_EQ(passes[0]->name(), "threshold");
+    ASSERT_EQ(passes[1]->name(), "blur");
+    ASSERT_EQ(passes[2]->name(), "composite");
+    ASSERT_NE(fx->data()->get<render::TextureSampler>("threshold").id, nullptr);
+    ASSERT_NE(fx->data()->get<render::TextureSampler>("blur").id, nullptr);
+}
@@ -156,3 +156,39 @@ TEST_F(MeshPartitionerTest, PreservedVertexPositionsWhenMerging)
         ASSERT_TRUE(epsilonEqual.x && epsilonEqual.y && epsilonEqual.z);
     }
 }
+
+TEST_F(MeshPartitionerTest, PreservedTrianglesWhenProcessingOutOfCore)
+{
+    auto scene = createScene();
+
+    auto numSourceTriangles = 0u;
+
+    for (auto sourceNode : scene->children())
+        numSourceTriangles += sourceNode->component<component::Surface>()->geometry()->indices()->numIndices() / 3u;
+
+    auto options = MeshPartitioner::Options();
+
+    options.flags = MeshPartitioner::Options::mergeSurfaces |
+                    MeshPartitioner::Options::applyCrackFreePolicy |
+                    MeshPartitioner::Options::createOneNodePerSurface |
+                    MeshPartitioner::Options::outOfCore;
+    options.outOfCoreMemoryBudget = 4096u;
+    options.outOfCoreMaxCellDepth = 2;
+
+    auto meshPartitioner = MeshPartitioner::create(options, StreamingOptions::create());
+
+    meshPartitioner->process(scene, scene->component<component::SceneManager>()->assets());
+
+    auto destinationSurfaceNodes = scene::NodeSet::create(scene->children()[2u])
+        ->descendants(true)
+        ->where([](scene::Node::Ptr descendant) { return descendant->hasComponent<component::Surface>(); });
+
+    auto numDestinationTriangles = 0u;
+
+    for (auto destinationSurfaceNode : destinationSurfaceNodes->nodes())
+        for (auto surface : destinationSurfaceNode->components<component::Surface>())
+            numDestinationTriangles += surface->geometry()->indices()->numIndices() / 3u;
+
+    ASSERT_GT(destinationSurfaceNodes->nodes().size(), 1u);
+    ASSERT_EQ(numSourceTriangles, numDestinationTriangles);
+}
@@ -0,0 +1,172 @@
+/*
+Copyright (c) 2015 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "gtest/gtest.h"
+
+#include "minko/MinkoTests.hpp"
+
+#include "minko/file/MeshSimplifier.hpp"
+#include "minko/file/MeshSimplifierTest.hpp"
+
+using namespace minko;
+using namespace minko::file;
+
+void
+MeshSimplifierTest::createGrid(unsigned int                 numColumns,
+                               unsigned int                 numRows,
+                               std::vector<unsigned int>&   indices,
+                               std::vector<float>&          vertices)
+{
+    for (auto y = 0u; y <= numRows; ++y)
+    {
+        for (auto x = 0u; x <= numColumns; ++x)
+        {
+            const auto u = float(x) / numColumns;
+            const auto v = float(y) / numRows;
+
+            vertices.push_back(u);
+            vertices.push_back(0.1f * std::sin(u * 3.f) * std::cos(v * 3.f));
+            vertices.push_back(v);
+        }
+    }
+
+    for (auto y = 0u; y < numRows; ++y)
+    {
+        for (auto x = 0u; x < numColumns; ++x)
+        {
+            const auto i = y * (numColumns + 1u) + x;
+
+            indices.insert(indices.end(), { i, i + numColumns + 1u, i + 1u });
+            indices.insert(indices.end(), { i + 1u, i + numColumns + 1u, i + numColumns + 2u });
+        }
+    }
+}
+
+TEST_F(MeshSimplifierTest, Create)
+{
+    try
+    {
+        auto simplifier = MeshSimplifier::create();
+    }
+    catch (...)
+    {
+        ASSERT_TRUE(false);
+    }
+}
+
+TEST_F(MeshSimplifierTest, DecreasingTriangleCountPerLod)
+{
+    auto indices = std::vector<unsigned int>();
+    auto vertices = std::vector<float>();
+
+    createGrid(16u, 16u, indices, vertices);
+
+    const auto numVertices = vertices.size() / 3u;
+
+    auto options = MeshSimplifier::Options();
+
+    options.numLods = 3;
+    options.minNumTriangles = 8u;
+
+    auto lods = std::vector<MeshSimplifier::Lod>();
+
+    MeshSimplifier::create(options)->buildLods(
+        indices,
+        vertices,
+        3u,
+        0u,
+        std::vector<bool>(numVertices, false),
+        lods
+    );
+
+    ASSERT_FALSE(lods.empty());
+
+    auto previousNumIndices = indices.size();
+    auto previousError = 0.f;
+
+    for (const auto& lod : lods)
+    {
+        ASSERT_LT(lod.indices.size(), previousNumIndices);
+        ASSERT_EQ(lod.indices.size() % 3u, 0u);
+        ASSERT_GE(lod.error, previousError);
+
+        for (auto index : lod.indices)
+            ASSERT_LT(index, numVertices);
+
+        previousNumIndices = lod.indices.size();
+        previousError = lod.error;
+    }
+}
+
+TEST_F(MeshSimplifierTest, LockedVerticesAreNotCollapsed)
+{
+    auto indices = std::vector<unsigned int>();
+    auto vertices = std::vector<float>();
+
+    createGrid(4u, 4u, indices, vertices);
+
+    const auto numVertices = vertices.size() / 3u;
+
+    auto lods = std::vector<MeshSimplifier::Lod>();
+
+    MeshSimplifier::create()->buildLods(
+        indices,
+        vertices,
+        3u,
+        0u,
+        std::vector<bool>(numVertices, true),
+        lods
+    );
+
+    ASSERT_TRUE(lods.empty());
+}
+
+TEST_F(MeshSimplifierTest, FlatSurfaceHasNoGeometricError)
+{
+    auto indices = std::vector<unsigned int>();
+    auto vertices = std::vector<float>();
+
+    createGrid(8u, 8u, indices, vertices);
+
+    for (auto i = 1u; i < vertices.size(); i += 3u)
+        vertices[i] = 0.f;
+
+    const auto numVertices = vertices.size() / 3u;
+
+    auto options = MeshSimplifier::Options();
+
+    options.numLods = 2;
+
+    auto lods = std::vector<MeshSimplifier::Lod>();
+
+    MeshSimplifier::create(options)->buildLods(
+        indices,
+        vertices,
+        3u,
+        0u,
+        std::vector<bool>(numVertices, false),
+        lods
+    );
+
+    ASSERT_FALSE(lods.empty());
+
+    // border collapses are penalized but do not move the surface
+    for (const auto& lod : lods)
+        ASSERT_NEAR(lod.error, 0.f, 1e-3f);
+}
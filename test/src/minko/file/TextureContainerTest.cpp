@@ -0,0 +1,198 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "gtest/gtest.h"
+
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/file/Options.hpp"
+#include "minko/file/TextureContainer.hpp"
+#include "minko/file/TextureContainerParser.hpp"
+#include "minko/file/TextureContainerTest.hpp"
+#include "minko/render/CubeTexture.hpp"
+#include "minko/render/RecordingContext.hpp"
+#include "minko/render/TextureFormatInfo.hpp"
+#include "minko/render/TextureUploadQueue.hpp"
+
+using namespace minko;
+using namespace minko::file;
+using namespace minko::render;
+
+namespace
+{
+    std::vector<unsigned char>
+    createMipChain(TextureFormat format, uint width, uint height, uint numMipLevels, uint numFaces = 1u)
+    {
+        auto mipChain = std::vector<unsigned char>();
+
+        for (auto level = 0u; level < numMipLevels; ++level)
+            for (auto face = 0u; face < numFaces; ++face)
+            {
+                const auto size = TextureFormatInfo::textureSize(format, std::max(width >> level, 1u), std::max(height >> level, 1u));
+
+                // each level/face is filled with its own value so that misplaced levels are detected
+                mipChain.insert(mipChain.end(), size, static_cast<unsigned char>(level * numFaces + face + 1u));
+            }
+
+        return mipChain;
+    }
+}
+
+TEST_F(TextureContainerTest, WriteAndRead)
+{
+    auto out = std::vector<unsigned char>();
+
+    TextureContainer::write(
+        64, 32, 1, 7,
+        {
+            { TextureFormat::RGBA, createMipChain(TextureFormat::RGBA, 64, 32, 7) },
+            { TextureFormat::RGBA_DXT5, createMipChain(TextureFormat::RGBA_DXT5, 64, 32, 7) }
+        },
+        out
+    );
+
+    auto container = TextureContainer::read(out.data(), out.size());
+
+    ASSERT_NE(container, nullptr);
+    ASSERT_EQ(container->width(), 64u);
+    ASSERT_EQ(container->height(), 32u);
+    ASSERT_EQ(container->numFaces(), 1u);
+    ASSERT_EQ(container->numMipLevels(), 7u);
+    ASSERT_EQ(container->formats(), std::vector<TextureFormat>({ TextureFormat::RGBA, TextureFormat::RGBA_DXT5 }));
+    ASSERT_FALSE(container->hasFormat(TextureFormat::RGB_ETC1));
+
+    for (auto format : container->formats())
+        for (auto level = 0u; level < 7u; ++level)
+        {
+            const auto& mipLevel = container->mipLevel(format, level);
+
+            ASSERT_EQ(mipLevel.offset % TextureContainer::ALIGNMENT, 0u);
+            ASSERT_EQ(mipLevel.size, TextureFormatInfo::textureSize(format, std::max(64u >> level, 1u), std::max(32u >> level, 1u)));
+            ASSERT_LE(mipLevel.offset + mipLevel.size, out.size());
+            ASSERT_EQ(out[mipLevel.offset], level + 1u);
+            ASSERT_EQ(out[mipLevel.offset + mipLevel.size - 1u], level + 1u);
+        }
+}
+
+TEST_F(TextureContainerTest, CubeFacesAreStoredPerLevel)
+{
+    auto out = std::vector<unsigned char>();
+
+    TextureContainer::write(16, 16, 6, 5, { { TextureFormat::RGBA, createMipChain(TextureFormat::RGBA, 16, 16, 5, 6) } }, out);
+
+    auto container = TextureContainer::read(out.data(), out.size());
+
+    ASSERT_NE(container, nullptr);
+
+    for (auto level = 0u; level < 5u; ++level)
+        for (auto face = 0u; face < 6u; ++face)
+            ASSERT_EQ(out[container->mipLevel(TextureFormat::RGBA, level, face).offset], level * 6u + face + 1u);
+}
+
+TEST_F(TextureContainerTest, TableOfContentsIsReadFromHeader)
+{
+    auto out = std::vector<unsigned char>();
+
+    TextureContainer::write(
+        32, 32, 1, 6,
+        {
+            { TextureFormat::RGBA, createMipChain(TextureFormat::RGBA, 32, 32, 6) },
+            { TextureFormat::RGB_ETC1, createMipChain(TextureFormat::RGB_ETC1, 32, 32, 6) }
+        },
+        out
+    );
+
+    const auto tableOfContentsSize = TextureContainer::tableOfContentsSize(out.data(), TextureContainer::HEADER_SIZE);
+
+    ASSERT_EQ(tableOfContentsSize, TextureContainer::HEADER_SIZE + 2u * (4u + 6u * 8u));
+    ASSERT_EQ(TextureContainer::read(out.data(), tableOfContentsSize - 1u), nullptr);
+    ASSERT_NE(TextureContainer::read(out.data(), tableOfContentsSize), nullptr);
+}
+
+TEST_F(TextureContainerTest, MipLevelsRangeIsContiguous)
+{
+    auto out = std::vector<unsigned char>();
+
+    TextureContainer::write(
+        32, 32, 1, 6,
+        {
+            { TextureFormat::RGBA, createMipChain(TextureFormat::RGBA, 32, 32, 6) },
+            { TextureFormat::RGBA_DXT1, createMipChain(TextureFormat::RGBA_DXT1, 32, 32, 6) }
+        },
+        out
+    );
+
+    auto container = TextureContainer::read(out.data(), out.size());
+
+    auto offset = 0u;
+    auto size = 0u;
+
+    container->mipLevelsRange(TextureFormat::RGBA_DXT1, 2u, 5u, offset, size);
+
+    ASSERT_EQ(offset, container->mipLevel(TextureFormat::RGBA_DXT1, 2u).offset);
+    ASSERT_EQ(offset + size, container->mipLevel(TextureFormat::RGBA_DXT1, 5u).offset + container->mipLevel(TextureFormat::RGBA_DXT1, 5u).size);
+
+    container->formatRange(TextureFormat::RGBA, offset, size);
+
+    ASSERT_EQ(offset, container->mipLevel(TextureFormat::RGBA, 0u).offset);
+    ASSERT_LE(offset + size, container->mipLevel(TextureFormat::RGBA_DXT1, 0u).offset);
+}
+
+TEST_F(TextureContainerTest, InvalidHeaderIsRejected)
+{
+    auto data = std::vector<unsigned char>(64, 0);
+
+    ASSERT_EQ(TextureContainer::tableOfContentsSize(data.data(), data.size()), 0u);
+    ASSERT_EQ(TextureContainer::read(data.data(), data.size()), nullptr);
+}
+
+TEST_F(TextureContainerTest, TruncatedMipChainThrows)
+{
+    auto out = std::vector<unsigned char>();
+    auto mipChain = createMipChain(TextureFormat::RGBA, 32, 32, 6);
+
+    mipChain.resize(mipChain.size() - 1u);
+
+    ASSERT_THROW(TextureContainer::write(32, 32, 1, 6, { { TextureFormat::RGBA, mipChain } }, out), std::invalid_argument);
+}
+
+TEST_F(TextureContainerTest, AsynchronousCubeTextureUploadIsQueued)
+{
+    auto out = std::vector<unsigned char>();
+
+    TextureContainer::write(16, 16, 6, 5, { { TextureFormat::RGBA, createMipChain(TextureFormat::RGBA, 16, 16, 5, 6) } }, out);
+
+    auto context = RecordingContext::create();
+    auto assets = AssetLibrary::create(context);
+    auto options = Options::create(context)
+        ->loadTexturesAsynchronously(true)
+        ->generateMipmaps(true);
+
+    TextureContainerParser::create()->parse("cube.texture", "cube.texture", options, out, assets);
+
+    auto texture = assets->cubeTexture("cube.texture");
+
+    ASSERT_NE(texture, nullptr);
+    ASSERT_EQ(context->counters().numUploadedBytes, 0u);
+    ASSERT_EQ(assets->textureUploadQueue()->numPendingUploads(), 1u);
+
+    assets->textureUploadQueue()->flush();
+
+    ASSERT_NE(texture->id(), -1);
+    ASSERT_EQ(context->counters().numUploadedBytes, createMipChain(TextureFormat::RGBA, 16, 16, 5, 6).size());
+}
@@ -0,0 +1,148 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "gtest/gtest.h"
+
+#include "minko/MinkoTests.hpp"
+
+#include "minko/component/Surface.hpp"
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/file/VertexCacheOptimizer.hpp"
+#include "minko/file/VertexCacheOptimizerTest.hpp"
+#include "minko/geometry/SphereGeometry.hpp"
+#include "minko/material/Material.hpp"
+#include "minko/scene/Node.hpp"
+
+using namespace minko;
+using namespace minko::file;
+
+scene::Node::Ptr
+VertexCacheOptimizerTest::createScene()
+{
+    auto root = scene::Node::create("root")
+        ->addComponent(component::SceneManager::create(MinkoTests::canvas()));
+
+    auto assetLibrary = root->component<component::SceneManager>()->assets();
+
+    auto meshGeometry = geometry::SphereGeometry::create(assetLibrary->context(), 32u);
+
+    auto mesh = scene::Node::create("mesh")
+        ->addComponent(component::Surface::create(
+            meshGeometry,
+            material::Material::create(),
+            nullptr
+        ));
+
+    root->addChild(mesh);
+
+    return root;
+}
+
+void
+VertexCacheOptimizerTest::getTriangles(geometry::Geometry::Ptr geometry, std::vector<std::vector<float>>& triangles)
+{
+    const auto& indices = geometry->indices()->data();
+
+    auto positionVertexBuffer = geometry->vertexBuffer("position");
+    const auto& positionAttribute = positionVertexBuffer->attribute("position");
+    const auto& vertices = positionVertexBuffer->data();
+
+    for (auto i = 0u; i < indices.size(); i += 3u)
+    {
+        auto triangle = std::vector<float>();
+
+        for (auto j = 0u; j < 3u; ++j)
+        {
+            const auto offset = indices[i + j] * positionVertexBuffer->vertexSize() + positionAttribute.offset;
+
+            triangle.insert(triangle.end(), vertices.begin() + offset, vertices.begin() + offset + 3u);
+        }
+
+        triangles.push_back(triangle);
+    }
+
+    std::sort(triangles.begin(), triangles.end());
+}
+
+TEST_F(VertexCacheOptimizerTest, Create)
+{
+    auto vertexCacheOptimizer = VertexCacheOptimizer::create();
+}
+
+TEST_F(VertexCacheOptimizerTest, Process)
+{
+    auto scene = createScene();
+
+    auto vertexCacheOptimizer = VertexCacheOptimizer::create();
+
+    vertexCacheOptimizer->process(scene, scene->component<component::SceneManager>()->assets());
+}
+
+TEST_F(VertexCacheOptimizerTest, PreservedTriangles)
+{
+    auto scene = createScene();
+
+    auto geometry = scene->children()[0u]->component<component::Surface>()->geometry();
+
+    auto sourceTriangles = std::vector<std::vector<float>>();
+    getTriangles(geometry, sourceTriangles);
+
+    auto vertexCacheOptimizer = VertexCacheOptimizer::create();
+
+    vertexCacheOptimizer->process(scene, scene->component<component::SceneManager>()->assets());
+
+    auto destinationTriangles = std::vector<std::vector<float>>();
+    getTriangles(geometry, destinationTriangles);
+
+    ASSERT_EQ(sourceTriangles, destinationTriangles);
+}
+
+TEST_F(VertexCacheOptimizerTest, TransformedVertexCountNotIncreased)
+{
+    auto scene = createScene();
+
+    auto vertexCacheOptimizer = VertexCacheOptimizer::create();
+
+    vertexCacheOptimizer->process(scene, scene->component<component::SceneManager>()->assets());
+
+    const auto& statistics = vertexCacheOptimizer->statistics();
+
+    ASSERT_GT(statistics.numTriangles, 0u);
+    ASSERT_LE(statistics.acmrAfter(), statistics.acmrBefore());
+    ASSERT_GE(statistics.atvrAfter(), 1.f);
+}
+
+TEST_F(VertexCacheOptimizerTest, PreservedAttributeFormats)
+{
+    auto scene = createScene();
+
+    auto geometry = scene->children()[0u]->component<component::Surface>()->geometry();
+
+    geometry->vertexBuffer("normal")->attributeFormat("normal", render::VertexAttribute::Format::SHORT_NORMALIZED);
+
+    auto vertexCacheOptimizer = VertexCacheOptimizer::create();
+
+    vertexCacheOptimizer->process(scene, scene->component<component::SceneManager>()->assets());
+
+    auto normalVertexBuffer = geometry->vertexBuffer("normal");
+
+    ASSERT_TRUE(normalVertexBuffer->isPacked());
+    ASSERT_EQ(normalVertexBuffer->attribute("normal").format, render::VertexAttribute::Format::SHORT_NORMALIZED);
+    ASSERT_EQ(normalVertexBuffer->attribute("position").format, render::VertexAttribute::Format::FLOAT);
+}
@@ -426,3 +426,44 @@ TEST_F(GeometryTest, ComputeExistingNormals)
     ASSERT_EQ(normalData.size(), expectedNormalData.size());
     ASSERT_TRUE(std::equal(normalData.begin(), normalData.end(), expectedNormalData.begin()));
 }
+
+TEST_F(GeometryTest, CastWithUnsignedIntIndices)
+{
+    auto context = MinkoTests::canvas()->context();
+
+    // OES_element_index_uint is optional on OpenGL ES 2
+    if (!context->supportsUnsignedIntIndices())
+        return;
+
+    std::vector<float> geometryData = {
+        -1.f, -1.f, 0.f,    0.f, 0.f,
+        1.f, -1.f, 0.f,     1.f, 0.f,
+        0.f, 1.f, 0.f,      0.5f, 1.f
+    };
+
+    std::vector<unsigned int> i = { 0, 1, 2 };
+
+    auto geometry = Geometry::create();
+
+    auto vertexBuffer = VertexBuffer::create(context, std::begin(geometryData), std::end(geometryData));
+
+    vertexBuffer->addAttribute("position", 3, 0);
+    vertexBuffer->addAttribute("uv", 2, 3);
+
+    geometry->addVertexBuffer(vertexBuffer);
+
+    geometry->indices(IndexBuffer::create(context, i));
+
+    ASSERT_EQ(geometry->indices()->indexSize(), sizeof(unsigned int));
+
+    auto ray = math::Ray::create(math::vec3(0.f, 0.f, 1.f), math::vec3(0.f, 0.f, -1.f));
+    auto distance = 0.f;
+    auto triangle = 0u;
+    auto hitUv = math::vec2();
+
+    ASSERT_TRUE(geometry->cast(ray, distance, triangle, nullptr, &hitUv));
+    ASSERT_FLOAT_EQ(distance, 1.f);
+    ASSERT_EQ(triangle, 0u);
+    ASSERT_NEAR(hitUv.x, 0.5f, 1e-5f);
+    ASSERT_NEAR(hitUv.y, 0.5f, 1e-5f);
+}
@@ -0,0 +1,188 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BufferUploadQueueTest.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+    VertexBuffer::Ptr
+    createVertexBuffer(RecordingContext::Ptr context, uint numVertices)
+    {
+        // not uploaded yet, unlike the buffers created with their data
+        auto vertexBuffer = VertexBuffer::create(context);
+
+        vertexBuffer->data().resize(numVertices * 3, 0.f);
+        vertexBuffer->addAttribute("position", 3, 0);
+
+        return vertexBuffer;
+    }
+}
+
+TEST_F(BufferUploadQueueTest, Create)
+{
+    try
+    {
+        auto queue = BufferUploadQueue::create();
+
+        ASSERT_EQ(queue->orphanRatio(), .5f);
+        ASSERT_EQ(queue->numPendingUploads(), 0u);
+    }
+    catch (std::exception& e)
+    {
+        ASSERT_TRUE(false);
+    }
+}
+
+TEST_F(BufferUploadQueueTest, FirstUploadIsFull)
+{
+    auto context = RecordingContext::create();
+    auto queue = BufferUploadQueue::create();
+    auto vertexBuffer = createVertexBuffer(context, 100);
+
+    queue->upload(vertexBuffer, 10, 5);
+    queue->update();
+
+    ASSERT_TRUE(vertexBuffer->isReady());
+    ASSERT_EQ(queue->numUploadsLastFrame(), 1u);
+    ASSERT_EQ(queue->numOrphanedBuffersLastFrame(), 0u);
+    ASSERT_EQ(queue->numUploadedBytesLastFrame(), 100 * 3 * sizeof(float));
+    ASSERT_EQ(context->counters().numUploadedBytes, 100 * 3 * sizeof(float));
+}
+
+TEST_F(BufferUploadQueueTest, MergeRanges)
+{
+    auto context = RecordingContext::create();
+    auto queue = BufferUploadQueue::create();
+    auto vertexBuffer = createVertexBuffer(context, 100);
+
+    vertexBuffer->upload();
+
+    queue->upload(vertexBuffer, 10, 5);
+    queue->upload(vertexBuffer, 12, 8);
+    queue->upload(vertexBuffer, 20, 2);
+    queue->upload(vertexBuffer, 40, 1);
+
+    ASSERT_EQ(queue->numPendingUploads(), 1u);
+
+    context->resetCounters();
+    queue->update();
+
+    ASSERT_EQ(queue->numPendingUploads(), 0u);
+    ASSERT_EQ(queue->numUploadsLastFrame(), 2u);
+    ASSERT_EQ(queue->numOrphanedBuffersLastFrame(), 0u);
+    ASSERT_EQ(queue->numUploadedBytesLastFrame(), 13 * 3 * sizeof(float));
+    ASSERT_EQ(context->counters().numUploadedBytes, 13 * 3 * sizeof(float));
+}
+
+TEST_F(BufferUploadQueueTest, OrphanRewrittenBuffer)
+{
+    auto context = RecordingContext::create();
+    auto queue = BufferUploadQueue::create();
+    auto vertexBuffer = createVertexBuffer(context, 100);
+
+    vertexBuffer->upload();
+
+    queue->upload(vertexBuffer, 0, 30);
+    queue->upload(vertexBuffer, 30, 30);
+
+    context->resetCounters();
+    queue->update();
+
+    ASSERT_EQ(queue->numUploadsLastFrame(), 1u);
+    ASSERT_EQ(queue->numOrphanedBuffersLastFrame(), 1u);
+    ASSERT_EQ(context->counters().numUploadedBytes, 100 * 3 * sizeof(float));
+}
+
+TEST_F(BufferUploadQueueTest, NeverOrphanAboveOne)
+{
+    auto context = RecordingContext::create();
+    auto queue = BufferUploadQueue::create()->orphanRatio(2.f);
+    auto vertexBuffer = createVertexBuffer(context, 100);
+
+    vertexBuffer->upload();
+
+    queue->upload(vertexBuffer);
+    queue->update();
+
+    ASSERT_EQ(queue->numUploadsLastFrame(), 1u);
+    ASSERT_EQ(queue->numOrphanedBuffersLastFrame(), 0u);
+    ASSERT_EQ(queue->numUploadedBytesLastFrame(), 100 * 3 * sizeof(float));
+}
+
+TEST_F(BufferUploadQueueTest, NumUploadedBytes)
+{
+    auto context = RecordingContext::create();
+    auto queue = BufferUploadQueue::create();
+    auto vertexBuffer = createVertexBuffer(context, 100);
+
+    vertexBuffer->upload();
+
+    queue->upload(vertexBuffer, 0, 10);
+    queue->update();
+    queue->upload(vertexBuffer, 50, 10);
+    queue->update();
+    queue->update();
+
+    ASSERT_EQ(queue->numUploadsLastFrame(), 0u);
+    ASSERT_EQ(queue->numUploadedBytesLastFrame(), 0u);
+    ASSERT_EQ(queue->numUploadedBytes(), 20 * 3 * sizeof(float));
+}
+
+TEST_F(BufferUploadQueueTest, Cancel)
+{
+    auto context = RecordingContext::create();
+    auto queue = BufferUploadQueue::create();
+    auto vertexBuffer = createVertexBuffer(context, 100);
+    auto indexBuffer = IndexBuffer::create(context, std::vector<unsigned short>(30, 0));
+
+    queue->upload(vertexBuffer);
+    queue->upload(indexBuffer);
+    queue->cancel(vertexBuffer);
+    queue->cancel(indexBuffer);
+
+    ASSERT_EQ(queue->numPendingUploads(), 0u);
+
+    queue->update();
+
+    ASSERT_FALSE(vertexBuffer->isReady());
+    ASSERT_EQ(queue->numUploadsLastFrame(), 0u);
+}
+
+TEST_F(BufferUploadQueueTest, OrphanIndexBuffer)
+{
+    auto context = RecordingContext::create();
+    auto queue = BufferUploadQueue::create();
+    auto indexBuffer = IndexBuffer::create(context, std::vector<unsigned short>(30, 0));
+
+    queue->upload(indexBuffer);
+    queue->upload(indexBuffer);
+
+    ASSERT_EQ(queue->numPendingUploads(), 1u);
+
+    context->resetCounters();
+    queue->update();
+
+    ASSERT_EQ(queue->numUploadsLastFrame(), 1u);
+    ASSERT_EQ(queue->numOrphanedBuffersLastFrame(), 1u);
+    ASSERT_EQ(queue->numUploadedBytesLastFrame(), 30 * sizeof(unsigned short));
+    ASSERT_EQ(context->counters().numUploadedBytes, 30 * sizeof(unsigned short));
+}
@@ -0,0 +1,164 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CommandListTest.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+    void
+    recordDrawCall(CommandList& commandList, const math::vec4& color)
+    {
+        commandList.setProgram(1);
+        commandList.setVertexBufferAt(0, 2, 3, 3, 0, VertexAttribute::Format::FLOAT);
+        commandList.setUniformFloat4(0, 1, math::value_ptr(color));
+        commandList.setDepthTest(true, CompareMode::LESS);
+        commandList.drawTriangles(0, 1);
+    }
+}
+
+TEST_F(CommandListTest, Create)
+{
+    try
+    {
+        auto commandList = CommandList::create();
+    }
+    catch (std::exception& e)
+    {
+        ASSERT_TRUE(false);
+    }
+}
+
+TEST_F(CommandListTest, SubmitExecutesRecordedCommands)
+{
+    auto commandList = CommandList::create();
+    auto context = RecordingContext::create();
+
+    recordDrawCall(*commandList, math::vec4(1.f));
+    commandList->drawTriangles(3, 0, 2);
+
+    ASSERT_EQ(commandList->numCommands(), 6u);
+    ASSERT_EQ(context->counters().numCommands, 0u);
+
+    commandList->submit(*context);
+
+    const auto& counters = context->counters();
+
+    ASSERT_EQ(counters.numCommands, 6u);
+    ASSERT_EQ(counters.numDrawCalls, 2u);
+    ASSERT_EQ(counters.numTriangles, 3u);
+    ASSERT_EQ(counters.numProgramChanges, 1u);
+    ASSERT_EQ(counters.numVertexBufferBinds, 1u);
+    ASSERT_EQ(counters.numUniformUpdates, 1u);
+    ASSERT_EQ(counters.numStateChanges, 1u);
+}
+
+TEST_F(CommandListTest, UniformValuesAreCopied)
+{
+    auto commandList = CommandList::create();
+    auto context = RecordingContext::create();
+    auto color = math::vec4(1.f, 0.f, 0.f, 1.f);
+
+    commandList->setUniformFloat4(0, 1, math::value_ptr(color));
+    color = math::vec4(0.f, 1.f, 0.f, 1.f);
+    commandList->setUniformFloat4(0, 1, math::value_ptr(color));
+    commandList->setUniformFloat4(0, 1, math::value_ptr(color));
+    commandList->submit(*context);
+
+    ASSERT_EQ(context->counters().numUniformUpdates, 3u);
+    ASSERT_EQ(context->counters().numRedundantUniformUpdates, 1u);
+}
+
+TEST_F(CommandListTest, TracksRenderTarget)
+{
+    auto commandList = CommandList::create();
+
+    ASSERT_EQ(commandList->renderTarget(), 0u);
+
+    commandList->setRenderToTexture(42, true);
+
+    ASSERT_EQ(commandList->renderTarget(), 42u);
+
+    commandList->setRenderToBackBuffer();
+
+    ASSERT_EQ(commandList->renderTarget(), 0u);
+}
+
+TEST_F(CommandListTest, ResetEmptiesTheList)
+{
+    auto commandList = CommandList::create();
+    auto context = RecordingContext::create();
+
+    recordDrawCall(*commandList, math::vec4(1.f));
+    commandList->setRenderToTexture(42, true);
+    commandList->reset();
+
+    ASSERT_EQ(commandList->numCommands(), 0u);
+    ASSERT_EQ(commandList->size(), 0u);
+    ASSERT_EQ(commandList->renderTarget(), 0u);
+
+    commandList->submit(*context);
+
+    ASSERT_EQ(context->counters().numCommands, 0u);
+}
+
+TEST_F(CommandListTest, SubmitIsRepeatable)
+{
+    auto commandList = CommandList::create();
+    auto context = RecordingContext::create();
+
+    recordDrawCall(*commandList, math::vec4(1.f));
+    commandList->submit(*context);
+    commandList->submit(*context);
+
+    ASSERT_EQ(context->counters().numDrawCalls, 2u);
+    ASSERT_EQ(context->counters().numRedundantUniformUpdates, 1u);
+}
+
+TEST_F(CommandListTest, RecordOnWorkerThreads)
+{
+    const auto numLists = 4u;
+    const auto numDrawCalls = 1000u;
+
+    std::vector<CommandList::Ptr> commandLists;
+    std::vector<std::thread> threads;
+
+    for (auto i = 0u; i < numLists; ++i)
+        commandLists.push_back(CommandList::create());
+
+    for (auto i = 0u; i < numLists; ++i)
+        threads.push_back(std::thread([&, i]()
+        {
+            for (auto j = 0u; j < numDrawCalls; ++j)
+                recordDrawCall(*commandLists[i], math::vec4(static_cast<float>(j)));
+        }));
+    for (auto& thread : threads)
+        thread.join();
+
+    auto context = RecordingContext::create();
+
+    for (const auto& commandList : commandLists)
+        commandList->submit(*context);
+
+    ASSERT_EQ(context->counters().numDrawCalls, numLists * numDrawCalls);
+    ASSERT_EQ(context->counters().numUniformUpdates, numLists * numDrawCalls);
+    ASSERT_EQ(context->counters().numRedundantUniformUpdates, 0u);
+}
@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "DrawCallPoolTest.hpp"
 
 #include "minko/Hash.hpp"
+#include "minko/render/DrawCallTemplate.hpp"
 
 using namespace minko;
 using namespace minko::render;
@@ -140,6 +141,127 @@ TEST_F(DrawCallPoolTest, UniformBindingToDefaultSwap)
     );
 }
 
+TEST_F(DrawCallPoolTest, DrawCallTemplateSharedBySameVariables)
+{
+    auto fx = MinkoTests::loadEffect("effect/uniform/binding/OneUniformBindingAndDefault.effect");
+    DrawCallPool pool;
+    data::Store rootData;
+    data::Store rendererData;
+    data::Store targetData1;
+    data::Store targetData2;
+    auto geom1 = geometry::QuadGeometry::create(MinkoTests::canvas()->context());
+    auto geom2 = geometry::QuadGeometry::create(MinkoTests::canvas()->context());
+    render::EffectVariables variables1 = { { "geometryUuid", geom1->uuid() } };
+    render::EffectVariables variables2 = { { "geometryUuid", geom2->uuid() } };
+    auto p1 = data::Provider::create();
+    auto p2 = data::Provider::create();
+
+    p1->set("diffuseColor", math::vec4(1.f));
+    p2->set("diffuseColor", math::vec4(.5f));
+    targetData1.addProvider(geom1->data(), component::Surface::GEOMETRY_COLLECTION_NAME);
+    targetData1.addProvider(p1);
+    targetData2.addProvider(geom2->data(), component::Surface::GEOMETRY_COLLECTION_NAME);
+    targetData2.addProvider(p2);
+
+    pool.addDrawCalls(fx, "default", variables1, rootData, rendererData, targetData1);
+    pool.addDrawCalls(fx, "default", variables2, rootData, rendererData, targetData2);
+
+    auto& drawCalls = pool.drawCalls().begin()->second.at(0u);
+
+    ASSERT_EQ(drawCalls.size(), 2);
+    ASSERT_EQ(pool.numDrawCallTemplates(), 1);
+    ASSERT_EQ(drawCalls.front()->drawCallTemplate(), drawCalls.back()->drawCallTemplate());
+    ASSERT_EQ(drawCalls.front()->drawCallTemplate()->numDrawCalls(), 2);
+    ASSERT_EQ(
+        drawCalls.front()->boundFloatUniforms()[0].data,
+        math::value_ptr(targetData1.get<math::vec4>("diffuseColor"))
+    );
+    ASSERT_EQ(
+        drawCalls.back()->boundFloatUniforms()[0].data,
+        math::value_ptr(targetData2.get<math::vec4>("diffuseColor"))
+    );
+}
+
+TEST_F(DrawCallPoolTest, DrawCallTemplateReleasedWithLastDrawCall)
+{
+    auto fx = MinkoTests::loadEffect("effect/uniform/binding/OneUniformBindingAndDefault.effect");
+    DrawCallPool pool;
+    data::Store rootData;
+    data::Store rendererData;
+    data::Store targetData1;
+    data::Store targetData2;
+    auto geom1 = geometry::QuadGeometry::create(MinkoTests::canvas()->context());
+    auto geom2 = geometry::QuadGeometry::create(MinkoTests::canvas()->context());
+    render::EffectVariables variables1 = { { "geometryUuid", geom1->uuid() } };
+    render::EffectVariables variables2 = { { "geometryUuid", geom2->uuid() } };
+
+    targetData1.addProvider(geom1->data(), component::Surface::GEOMETRY_COLLECTION_NAME);
+    targetData2.addProvider(geom2->data(), component::Surface::GEOMETRY_COLLECTION_NAME);
+
+    auto batchId1 = pool.addDrawCalls(fx, "default", variables1, rootData, rendererData, targetData1);
+    auto batchId2 = pool.addDrawCalls(fx, "default", variables2, rootData, rendererData, targetData2);
+    auto drawCallTemplate = pool.drawCalls().begin()->second.at(0u).front()->drawCallTemplate();
+
+    ASSERT_EQ(pool.numDrawCallTemplates(), 1);
+    ASSERT_EQ(drawCallTemplate->numDrawCalls(), 2);
+
+    pool.removeDrawCalls(batchId1);
+
+    ASSERT_EQ(pool.numDrawCallTemplates(), 1);
+    ASSERT_EQ(drawCallTemplate->numDrawCalls(), 1);
+
+    pool.removeDrawCalls(batchId2);
+
+    ASSERT_EQ(pool.numDrawCallTemplates(), 0);
+    ASSERT_EQ(drawCallTemplate->numDrawCalls(), 0);
+    // the pool no longer keeps the pass alive through the template
+    ASSERT_EQ(drawCallTemplate.use_count(), 1);
+}
+
+TEST_F(DrawCallPoolTest, SortDrawCallByPriorityBoundThroughOtherVariable)
+{
+    auto fx = MinkoTests::loadEffect("effect/state/binding/no-default-value/StatesBindingPriorityOtherVariable.effect");
+    DrawCallPool pool;
+    data::Store rootData;
+    data::Store rendererData;
+    data::Store targetData;
+    auto material = material::Material::create();
+    auto geom = geometry::QuadGeometry::create(MinkoTests::canvas()->context());
+
+    targetData.addProvider(material->data(), component::Surface::MATERIAL_COLLECTION_NAME);
+    targetData.addProvider(geom->data(), component::Surface::GEOMETRY_COLLECTION_NAME);
+    material->data()->set(States::PROPERTY_PRIORITY, 10.f);
+
+    // the binding does not use ${materialUuid} but resolves to the same property
+    render::EffectVariables variables{
+        { "materialUuid", material->uuid() },
+        { "geometryUuid", geom->uuid() },
+        { "surfaceMaterialUuid", material->uuid() }
+    };
+
+    pool.addDrawCalls(fx, "default", variables, rootData, rendererData, targetData);
+
+    auto drawCall = pool.drawCalls().begin()->second.at(0u).front();
+    // the sorted buckets are left in place when they are emptied
+    auto bucketPriority = [&]()
+    {
+        for (const auto& sortPropertiesToDrawCalls : pool.drawCalls())
+            for (const auto& drawCalls : sortPropertiesToDrawCalls.second)
+                if (std::find(drawCalls.begin(), drawCalls.end(), drawCall) != drawCalls.end())
+                    return std::get<0>(sortPropertiesToDrawCalls.first);
+
+        return -1.f;
+    };
+
+    ASSERT_FLOAT_EQ(bucketPriority(), 10.f);
+
+    material->data()->set(States::PROPERTY_PRIORITY, 42.f);
+    pool.update();
+
+    ASSERT_FLOAT_EQ(drawCall->priority(), 42.f);
+    ASSERT_FLOAT_EQ(bucketPriority(), 42.f);
+}
+
 TEST_F(DrawCallPoolTest, WatchAndDefineIntMacro)
 {
     auto fx = MinkoTests::loadEffect("effect/macro/binding/OneIntMacroBinding.effect");
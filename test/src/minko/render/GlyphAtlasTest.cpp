@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GlyphAtlasTest.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+    // 32 pixel glyphs with a spread of 4 use 40x40 cells
+    const uint CELL_SIZE = 40;
+
+    const GlyphAtlas::Glyph*
+    addBox(GlyphAtlas::Ptr atlas, unsigned long codepoint)
+    {
+        static const auto box = std::vector<unsigned char>(16 * 16, 255);
+
+        return atlas->addGlyph(codepoint, box.data(), 16, 16, math::ivec2(0, 16), 18.f);
+    }
+}
+
+TEST_F(GlyphAtlasTest, EvictLeastRecentlyUsedGlyphs)
+{
+    // 2 columns and at most 2 rows
+    auto atlas = GlyphAtlas::create(RecordingContext::create(), 32, 4, 2 * CELL_SIZE, 2 * CELL_SIZE);
+
+    for (auto codepoint : { 'a', 'b', 'c', 'd' })
+        addBox(atlas, codepoint);
+
+    ASSERT_EQ(atlas->numGlyphs(), 4u);
+    ASSERT_EQ(atlas->numEvictedGlyphs(), 0u);
+
+    const auto aCell = atlas->glyph('a')->cell;
+    const auto bCell = atlas->glyph('b')->cell;
+    const auto cCell = atlas->glyph('c')->cell;
+    const auto dCell = atlas->glyph('d')->cell;
+
+    // from the most to the least recently used: b, a, d, c
+    atlas->glyph('d');
+    atlas->glyph('a');
+    atlas->glyph('b');
+
+    const auto version = atlas->version();
+
+    ASSERT_EQ(addBox(atlas, 'e')->cell, cCell);
+    ASSERT_EQ(addBox(atlas, 'f')->cell, dCell);
+    ASSERT_EQ(atlas->numEvictedGlyphs(), 2u);
+    ASSERT_EQ(atlas->numGlyphs(), 4u);
+    ASSERT_GT(atlas->version(), version);
+    ASSERT_EQ(atlas->glyph('c'), nullptr);
+    ASSERT_EQ(atlas->glyph('d'), nullptr);
+    ASSERT_EQ(atlas->glyph('a')->cell, aCell);
+    ASSERT_EQ(atlas->glyph('b')->cell, bCell);
+}
+
+TEST_F(GlyphAtlasTest, GrowAndKeepCachedGlyphs)
+{
+    // 2 columns, 1 row at first and at most 2 rows
+    auto atlas = GlyphAtlas::create(RecordingContext::create(), 32, 4, 2 * CELL_SIZE, 2 * CELL_SIZE);
+
+    ASSERT_EQ(atlas->texture()->height(), CELL_SIZE);
+
+    addBox(atlas, 'a');
+    addBox(atlas, 'b');
+
+    const auto version = atlas->version();
+    const auto a = *atlas->glyph('a');
+    const auto aUv = atlas->uv(a);
+    const auto texels = std::vector<unsigned char>(
+        atlas->texture()->data().begin(),
+        atlas->texture()->data().end()
+    );
+
+    auto c = addBox(atlas, 'c');
+
+    ASSERT_EQ(atlas->texture()->height(), 2 * CELL_SIZE);
+    ASSERT_GT(atlas->version(), version);
+    ASSERT_EQ(atlas->numEvictedGlyphs(), 0u);
+    ASSERT_EQ(c->cell, 2u);
+
+    // the first row is left untouched but its UVs are scaled to the new height
+    ASSERT_EQ(atlas->glyph('a')->cell, a.cell);
+    ASSERT_TRUE(std::equal(texels.begin(), texels.end(), atlas->texture()->data().begin()));
+
+    const auto newAUv = atlas->uv(*atlas->glyph('a'));
+
+    ASSERT_FLOAT_EQ(newAUv.x, aUv.x);
+    ASSERT_FLOAT_EQ(newAUv.z, aUv.z);
+    ASSERT_FLOAT_EQ(newAUv.y, aUv.y * .5f);
+    ASSERT_FLOAT_EQ(newAUv.w, aUv.w * .5f);
+}
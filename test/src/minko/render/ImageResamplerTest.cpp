@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ImageResamplerTest.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+    std::vector<unsigned char>
+    randomImage(unsigned int width, unsigned int height)
+    {
+        std::vector<unsigned char> image(width * height * 4);
+
+        std::srand(42);
+        for (auto& component : image)
+            component = static_cast<unsigned char>(std::rand() % 256);
+
+        return image;
+    }
+}
+
+TEST_F(ImageResamplerTest, SameSizeIsCopied)
+{
+    auto image = randomImage(13, 7);
+    std::vector<unsigned char> result(image.size());
+
+    ImageResampler::resample(image.data(), 13, 7, result.data(), 13, 7, ImageResampler::Filter::LANCZOS);
+
+    ASSERT_EQ(image, result);
+}
+
+TEST_F(ImageResamplerTest, BoxDownsampleAverages)
+{
+    std::vector<unsigned char> image = {
+        0, 0, 0, 0,         100, 100, 100, 100,
+        200, 200, 200, 200, 100, 100, 100, 100
+    };
+    std::vector<unsigned char> result(4);
+
+    ImageResampler::resample(image.data(), 2, 2, result.data(), 1, 1, ImageResampler::Filter::BOX);
+
+    ASSERT_EQ(result, std::vector<unsigned char>({ 100, 100, 100, 100 }));
+}
+
+TEST_F(ImageResamplerTest, UniformColorIsPreserved)
+{
+    const std::vector<ImageResampler::Filter> filters = {
+        ImageResampler::Filter::NEAREST,
+        ImageResampler::Filter::BILINEAR,
+        ImageResampler::Filter::BOX,
+        ImageResampler::Filter::LANCZOS,
+        ImageResampler::Filter::KAISER
+    };
+
+    std::vector<unsigned char> image(37 * 23 * 4);
+    for (auto i = 0u; i < image.size(); i += 4)
+    {
+        image[i] = 10;
+        image[i + 1] = 120;
+        image[i + 2] = 250;
+        image[i + 3] = 128;
+    }
+
+    for (auto filter : filters)
+    {
+        std::vector<unsigned char> downsampled(16 * 8 * 4);
+        std::vector<unsigned char> upsampled(64 * 64 * 4);
+
+        ImageResampler::resample(image.data(), 37, 23, downsampled.data(), 16, 8, filter, 2.2f);
+        ImageResampler::resample(image.data(), 37, 23, upsampled.data(), 64, 64, filter, 2.2f);
+
+        for (auto i = 0u; i < downsampled.size(); ++i)
+            ASSERT_NEAR(downsampled[i], image[i % 4], 1);
+        for (auto i = 0u; i < upsampled.size(); ++i)
+            ASSERT_NEAR(upsampled[i], image[i % 4], 1);
+    }
+}
+
+TEST_F(ImageResamplerTest, GammaCorrectDownsample)
+{
+    std::vector<unsigned char> image = { 0, 0, 0, 0, 255, 255, 255, 255 };
+    std::vector<unsigned char> linear(4);
+    std::vector<unsigned char> gammaCorrect(4);
+
+    ImageResampler::resample(image.data(), 2, 1, linear.data(), 1, 1, ImageResampler::Filter::BOX);
+    ImageResampler::resample(image.data(), 2, 1, gammaCorrect.data(), 1, 1, ImageResampler::Filter::BOX, 2.2f);
+
+    ASSERT_NEAR(linear[0], 128, 1);
+    // (0.5 ^ (1 / 2.2)) * 255
+    ASSERT_NEAR(gammaCorrect[0], 186, 1);
+    // alpha is never gamma corrected
+    ASSERT_NEAR(gammaCorrect[3], 128, 1);
+}
+
+TEST_F(ImageResamplerTest, NearestUpsampleReplicatesPixels)
+{
+    std::vector<unsigned char> image = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    std::vector<unsigned char> result(4 * 4);
+
+    ImageResampler::resample(image.data(), 2, 1, result.data(), 4, 1, ImageResampler::Filter::NEAREST);
+
+    ASSERT_EQ(result, std::vector<unsigned char>({ 1, 2, 3, 4, 1, 2, 3, 4, 5, 6, 7, 8, 5, 6, 7, 8 }));
+}
+
+TEST_F(ImageResamplerTest, MultithreadedMatchesSingleThreaded)
+{
+    auto image = randomImage(1024, 512);
+    std::vector<unsigned char> singleThreaded(700 * 300 * 4);
+    std::vector<unsigned char> multithreaded(700 * 300 * 4);
+
+    ImageResampler::resample(image.data(), 1024, 512, singleThreaded.data(), 700, 300, ImageResampler::Filter::LANCZOS, 2.2f, 1);
+    ImageResampler::resample(image.data(), 1024, 512, multithreaded.data(), 700, 300, ImageResampler::Filter::LANCZOS, 2.2f, 4);
+
+    ASSERT_EQ(singleThreaded, multithreaded);
+}
+
+TEST_F(ImageResamplerTest, MipMapChain)
+{
+    auto image = randomImage(8, 4);
+    std::vector<unsigned char> chain;
+
+    ImageResampler::mipMapChain(image.data(), 8, 4, chain);
+
+    // 8x4 + 4x2 + 2x1 + 1x1
+    ASSERT_EQ(chain.size(), (32 + 8 + 2 + 1) * 4);
+    ASSERT_TRUE(std::equal(image.begin(), image.end(), chain.begin()));
+
+    // the first texel of the 4x2 level is the average of the top left 2x2 block
+    for (auto k = 0u; k < 4; ++k)
+    {
+        auto average = (image[k] + image[4 + k] + image[32 + k] + image[36 + k]) / 4.f;
+
+        ASSERT_NEAR(chain[32 * 4 + k], average, 1.f);
+    }
+}
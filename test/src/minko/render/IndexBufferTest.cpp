@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "IndexBufferTest.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+    // the data of an upload is the last argument of the command, thus the end of the log
+    template <typename T>
+    std::vector<T>
+    lastUploadedIndices(RecordingContext::Ptr context, uint numIndices)
+    {
+        const auto& log = context->log();
+        auto data = reinterpret_cast<const T*>(&log[log.size() - numIndices * sizeof(T)]);
+
+        return std::vector<T>(data, data + numIndices);
+    }
+}
+
+TEST_F(IndexBufferTest, UploadRangeOfData)
+{
+    auto context = RecordingContext::create();
+    auto indexBuffer = IndexBuffer::create(context, std::vector<unsigned short>({ 0, 1, 2, 3, 4, 5, 6, 7 }));
+
+    indexBuffer->upload(4, 2);
+
+    ASSERT_EQ(lastUploadedIndices<unsigned short>(context, 2), std::vector<unsigned short>({ 4, 5 }));
+}
+
+TEST_F(IndexBufferTest, UploadShortVectorAtOffset)
+{
+    auto context = RecordingContext::create();
+    auto indexBuffer = IndexBuffer::create(context, std::vector<unsigned short>(8, 0));
+
+    // offset is the destination in the buffer, the vector only holds the uploaded indices
+    indexBuffer->upload(6, 2, std::vector<unsigned short>({ 7, 9 }));
+
+    ASSERT_EQ(lastUploadedIndices<unsigned short>(context, 2), std::vector<unsigned short>({ 7, 9 }));
+}
+
+TEST_F(IndexBufferTest, UploadShortUnsignedIntVectorAtOffset)
+{
+    auto context = RecordingContext::create();
+    auto indexBuffer = IndexBuffer::create(context, std::vector<unsigned int>(8, 0));
+
+    indexBuffer->upload();
+    indexBuffer->upload(6, 2, std::vector<unsigned int>({ 70000, 9 }));
+
+    ASSERT_EQ(lastUploadedIndices<unsigned int>(context, 2), std::vector<unsigned int>({ 70000, 9 }));
+}
@@ -0,0 +1,209 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LightClusterGridTest.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+    std::vector<math::vec4>
+    randomSpheres(uint numSpheres, float zNear, float zFar)
+    {
+        std::vector<math::vec4> spheres;
+        std::srand(42);
+
+        for (auto i = 0u; i < numSpheres; ++i)
+        {
+            auto depth = zNear + (zFar - zNear) * (float(std::rand()) / RAND_MAX) * .5f;
+
+            spheres.push_back(math::vec4(
+                (float(std::rand()) / RAND_MAX - .5f) * depth,
+                (float(std::rand()) / RAND_MAX - .5f) * depth,
+                -depth,
+                .5f + (float(std::rand()) / RAND_MAX) * 10.f
+            ));
+        }
+
+        return spheres;
+    }
+
+    bool
+    sphereIntersectsBox(const math::vec4& sphere, const math::vec3& min, const math::vec3& max)
+    {
+        auto closest = math::clamp(math::vec3(sphere), min, max);
+        auto delta = closest - math::vec3(sphere);
+
+        return math::dot(delta, delta) <= sphere.w * sphere.w;
+    }
+}
+
+TEST_F(LightClusterGridTest, Create)
+{
+    auto grid = LightClusterGrid::create(4, 3, 2);
+
+    ASSERT_EQ(grid->numClusters(), 24u);
+    ASSERT_EQ(grid->clusterIndex(3, 2, 1), 23u);
+    ASSERT_EQ(grid->clusterCounts().size(), 24u);
+}
+
+TEST_F(LightClusterGridTest, ProjectionDepthRange)
+{
+    auto grid = LightClusterGrid::create(16, 8, 24)
+        ->projection(math::perspective(1.f, 16.f / 9.f, 0.5f, 200.f));
+
+    ASSERT_NEAR(grid->zNear(), 0.5f, 1e-3f);
+    ASSERT_NEAR(grid->zFar(), 200.f, 1e-1f);
+    ASSERT_EQ(grid->slice(0.1f), 0u);
+    ASSERT_EQ(grid->slice(0.51f), 0u);
+    ASSERT_EQ(grid->slice(199.f), 23u);
+    ASSERT_EQ(grid->slice(1000.f), 23u);
+
+    for (auto z = 1u; z < 24u; ++z)
+    {
+        math::vec3 previousMin, previousMax, min, max;
+
+        grid->clusterBounds(0, 0, z - 1, previousMin, previousMax);
+        grid->clusterBounds(0, 0, z, min, max);
+
+        ASSERT_NEAR(previousMin.z, max.z, 1e-3f);
+        ASSERT_EQ(grid->slice(-(min.z + max.z) * .5f), z);
+    }
+}
+
+TEST_F(LightClusterGridTest, BinMatchesBruteForce)
+{
+    auto grid = LightClusterGrid::create(16, 8, 24)
+        ->projection(math::perspective(1.f, 1.5f, 0.1f, 100.f))
+        ->maxLightsPerCluster(1024)
+        ->numThreads(1);
+    auto spheres = randomSpheres(200, 0.1f, 100.f);
+
+    grid->bin(spheres);
+
+    ASSERT_EQ(grid->numDroppedLights(), 0u);
+
+    for (auto z = 0u; z < grid->numClustersZ(); ++z)
+        for (auto y = 0u; y < grid->numClustersY(); ++y)
+            for (auto x = 0u; x < grid->numClustersX(); ++x)
+            {
+                math::vec3 min, max;
+                std::vector<uint> expected;
+
+                grid->clusterBounds(x, y, z, min, max);
+                for (auto i = 0u; i < spheres.size(); ++i)
+                    if (sphereIntersectsBox(spheres[i], min, max))
+                        expected.push_back(i);
+
+                auto cluster = grid->clusterIndex(x, y, z);
+                auto begin = grid->lightIndices().begin() + grid->clusterOffsets()[cluster];
+                std::vector<uint> actual(begin, begin + grid->clusterCounts()[cluster]);
+
+                ASSERT_EQ(actual, expected);
+            }
+}
+
+TEST_F(LightClusterGridTest, LightInFrontOfCameraIsBinned)
+{
+    auto grid = LightClusterGrid::create(16, 8, 24)
+        ->projection(math::perspective(1.f, 1.f, 0.1f, 100.f));
+
+    math::vec3 min, max;
+
+    grid->clusterBounds(5, 3, 10, min, max);
+    grid->bin({ math::vec4((min + max) * .5f, .001f) });
+
+    auto cluster = grid->clusterIndex(5, 3, 10);
+
+    ASSERT_EQ(grid->clusterCounts()[cluster], 1u);
+    ASSERT_EQ(grid->clusterCounts()[grid->clusterIndex(0, 0, 10)], 0u);
+    ASSERT_EQ(grid->clusterCounts()[grid->clusterIndex(5, 3, 0)], 0u);
+    ASSERT_EQ(grid->lightIndices()[grid->clusterOffsets()[cluster]], 0u);
+}
+
+TEST_F(LightClusterGridTest, LightBehindCameraIsIgnored)
+{
+    auto grid = LightClusterGrid::create()
+        ->projection(math::perspective(1.f, 1.f, 0.1f, 100.f));
+
+    grid->bin({ math::vec4(0.f, 0.f, 10.f, 1.f) });
+
+    ASSERT_TRUE(grid->lightIndices().empty());
+}
+
+TEST_F(LightClusterGridTest, MultithreadedBinningIsDeterministic)
+{
+    auto spheres = randomSpheres(1024, 0.1f, 100.f);
+    auto singleThreaded = LightClusterGrid::create()
+        ->projection(math::perspective(1.f, 1.5f, 0.1f, 100.f))
+        ->numThreads(1);
+    auto multithreaded = LightClusterGrid::create()
+        ->projection(math::perspective(1.f, 1.5f, 0.1f, 100.f))
+        ->numThreads(4);
+
+    singleThreaded->bin(spheres);
+    multithreaded->bin(spheres);
+
+    ASSERT_EQ(singleThreaded->clusterOffsets(), multithreaded->clusterOffsets());
+    ASSERT_EQ(singleThreaded->clusterCounts(), multithreaded->clusterCounts());
+    ASSERT_EQ(singleThreaded->lightIndices(), multithreaded->lightIndices());
+    ASSERT_EQ(singleThreaded->numDroppedLights(), multithreaded->numDroppedLights());
+}
+
+TEST_F(LightClusterGridTest, MultithreadedBinningAcrossFrames)
+{
+    auto singleThreaded = LightClusterGrid::create()
+        ->projection(math::perspective(1.f, 1.5f, 0.1f, 100.f))
+        ->numThreads(1);
+    auto multithreaded = LightClusterGrid::create()
+        ->projection(math::perspective(1.f, 1.5f, 0.1f, 100.f))
+        ->numThreads(4);
+
+    // the workers are reused from one bin() to the next, including with fewer threads or lights
+    for (auto frame = 0u; frame < 10u; ++frame)
+    {
+        auto spheres = randomSpheres(frame % 3 == 2 ? 16 : 512, 0.1f, 100.f);
+
+        multithreaded->numThreads(frame % 2 == 0 ? 4 : 2);
+        singleThreaded->bin(spheres);
+        multithreaded->bin(spheres);
+
+        ASSERT_EQ(singleThreaded->clusterOffsets(), multithreaded->clusterOffsets());
+        ASSERT_EQ(singleThreaded->lightIndices(), multithreaded->lightIndices());
+        ASSERT_EQ(singleThreaded->numDroppedLights(), multithreaded->numDroppedLights());
+    }
+}
+
+TEST_F(LightClusterGridTest, MaxLightsPerCluster)
+{
+    auto grid = LightClusterGrid::create(1, 1, 1)
+        ->projection(math::perspective(1.f, 1.f, 0.1f, 100.f))
+        ->maxLightsPerCluster(2);
+
+    grid->bin({
+        math::vec4(0.f, 0.f, -10.f, 1.f),
+        math::vec4(0.f, 0.f, -20.f, 1.f),
+        math::vec4(0.f, 0.f, -30.f, 1.f)
+    });
+
+    ASSERT_EQ(grid->clusterCounts()[0], 2u);
+    ASSERT_EQ(grid->numDroppedLights(), 1u);
+    ASSERT_EQ(grid->lightIndices(), std::vector<uint>({ 0u, 1u }));
+}
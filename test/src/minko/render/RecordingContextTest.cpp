@@ -0,0 +1,257 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RecordingContextTest.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+    const std::string VERTEX_SHADER =
+        "#define SKINNING_NUM_BONES 4\n"
+        "attribute vec3 aPosition;\n"
+        "attribute vec2 aUV;\n"
+        "uniform mat4 uModelToWorldMatrix;\n"
+        "uniform mat4 uBoneMatrices[SKINNING_NUM_BONES * 2];\n"
+        "#ifdef VERTEX_UV\n"
+        "varying vec2 vUV;\n"
+        "#endif\n"
+        "void main()\n"
+        "{\n"
+        "    // uUnusedInComment\n"
+        "    gl_Position = uModelToWorldMatrix * uBoneMatrices[0] * vec4(aPosition, 1.0);\n"
+        "#if defined(VERTEX_UV) && SKINNING_NUM_BONES > 2\n"
+        "    vUV = aUV;\n"
+        "#endif\n"
+        "}\n";
+
+    const std::string FRAGMENT_SHADER =
+        "#define DIFFUSE_MAP\n"
+        "uniform vec4 uDiffuseColor;\n"
+        "#if NUM_LIGHTS > 0\n"
+        "uniform vec3 uLightColor;\n"
+        "#endif\n"
+        "uniform float uShadowBias;\n"
+        "#ifdef DIFFUSE_MAP\n"
+        "uniform sampler2D uDiffuseMap;\n"
+        "#else\n"
+        "uniform sampler2D uAlphaMap;\n"
+        "#endif\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = uDiffuseColor;\n"
+        "#ifdef DIFFUSE_MAP\n"
+        "    gl_FragColor *= texture2D(uDiffuseMap, vec2(0.0));\n"
+        "#endif\n"
+        "#ifdef SHADOW_MAP\n"
+        "    gl_FragColor *= uShadowBias;\n"
+        "#endif\n"
+        "}\n";
+
+    const ProgramInputs::UniformInput*
+    findUniform(const ProgramInputs& inputs, const std::string& name)
+    {
+        for (const auto& uniform : inputs.uniforms())
+            if (uniform.name == name)
+                return &uniform;
+
+        return nullptr;
+    }
+
+    Program::Ptr
+    createProgram(AbstractContext::Ptr context)
+    {
+        auto vertexShader = Shader::create(context, Shader::Type::VERTEX_SHADER, VERTEX_SHADER);
+        auto fragmentShader = Shader::create(context, Shader::Type::FRAGMENT_SHADER, FRAGMENT_SHADER);
+
+        vertexShader->upload();
+        fragmentShader->upload();
+
+        auto program = Program::create("program", context, vertexShader, fragmentShader);
+
+        program->upload();
+
+        return program;
+    }
+
+    void
+    recordFrame(RecordingContext::Ptr context, Program::Ptr program, uint vertexBuffer)
+    {
+        auto color = math::vec4(1.f, 0.f, 0.f, 1.f);
+
+        context->setProgram(program->id());
+        context->setVertexBufferAt(0, vertexBuffer, 3, 3, 0);
+        context->setUniformFloat4(findUniform(program->inputs(), "uDiffuseColor")->location, 1, math::value_ptr(color));
+        context->setDepthTest(true, CompareMode::LESS);
+        context->drawTriangles(0, 1);
+    }
+}
+
+TEST_F(RecordingContextTest, Create)
+{
+    try
+    {
+        auto context = RecordingContext::create();
+    }
+    catch (std::exception& e)
+    {
+        ASSERT_TRUE(false);
+    }
+}
+
+TEST_F(RecordingContextTest, ScanProgramInputsFollowsPreprocessor)
+{
+    auto inputs = RecordingContext::scanProgramInputs(VERTEX_SHADER, FRAGMENT_SHADER);
+
+    ASSERT_NE(findUniform(inputs, "uModelToWorldMatrix"), nullptr);
+    ASSERT_NE(findUniform(inputs, "uDiffuseColor"), nullptr);
+    ASSERT_NE(findUniform(inputs, "uDiffuseMap"), nullptr);
+    ASSERT_EQ(findUniform(inputs, "uDiffuseMap")->type, ProgramInputs::Type::sampler2d);
+    ASSERT_EQ(findUniform(inputs, "uLightColor"), nullptr);
+    ASSERT_EQ(findUniform(inputs, "uAlphaMap"), nullptr);
+}
+
+TEST_F(RecordingContextTest, ScanProgramInputsSkipsUnusedInputs)
+{
+    auto inputs = RecordingContext::scanProgramInputs(VERTEX_SHADER, FRAGMENT_SHADER);
+
+    ASSERT_EQ(findUniform(inputs, "uShadowBias"), nullptr);
+    ASSERT_EQ(inputs.attributes().size(), 1u);
+    ASSERT_EQ(inputs.attributes()[0].name, "aPosition");
+}
+
+TEST_F(RecordingContextTest, ScanProgramInputsEvaluatesArraySizes)
+{
+    auto inputs = RecordingContext::scanProgramInputs(VERTEX_SHADER, FRAGMENT_SHADER);
+    auto bones = findUniform(inputs, "uBoneMatrices[0]");
+
+    ASSERT_NE(bones, nullptr);
+    ASSERT_EQ(bones->size, 8);
+    ASSERT_EQ(bones->type, ProgramInputs::Type::float16);
+}
+
+TEST_F(RecordingContextTest, ProgramUsesScannedInputs)
+{
+    auto context = RecordingContext::create();
+    auto program = createProgram(context);
+
+    ASSERT_NE(findUniform(program->inputs(), "uDiffuseColor"), nullptr);
+    ASSERT_EQ(findUniform(program->inputs(), "uShadowBias"), nullptr);
+}
+
+TEST_F(RecordingContextTest, CountsDrawCallsAndUploads)
+{
+    auto context = RecordingContext::create();
+    auto vertexBuffer = VertexBuffer::create(context, std::vector<float>(9, 0.f));
+
+    vertexBuffer->addAttribute("position", 3, 0);
+    vertexBuffer->upload();
+
+    auto program = createProgram(context);
+
+    context->resetCounters();
+    recordFrame(context, program, vertexBuffer->id());
+
+    ASSERT_EQ(context->counters().numDrawCalls, 1u);
+    ASSERT_EQ(context->counters().numTriangles, 1u);
+    ASSERT_EQ(context->counters().numUploadedBytes, 0u);
+
+    vertexBuffer->upload();
+
+    ASSERT_EQ(context->counters().numUploadedBytes, 9 * sizeof(float));
+}
+
+TEST_F(RecordingContextTest, CountsRedundantCalls)
+{
+    auto context = RecordingContext::create();
+    auto vertexBuffer = context->createVertexBuffer(9);
+    auto program = createProgram(context);
+
+    context->resetCounters();
+    recordFrame(context, program, vertexBuffer);
+    recordFrame(context, program, vertexBuffer);
+
+    const auto& counters = context->counters();
+
+    ASSERT_EQ(counters.numProgramChanges, 2u);
+    ASSERT_EQ(counters.numRedundantProgramChanges, 1u);
+    ASSERT_EQ(counters.numVertexBufferBinds, 2u);
+    ASSERT_EQ(counters.numRedundantVertexBufferBinds, 1u);
+    ASSERT_EQ(counters.numUniformUpdates, 2u);
+    ASSERT_EQ(counters.numRedundantUniformUpdates, 1u);
+    ASSERT_EQ(counters.numStateChanges, 2u);
+    ASSERT_EQ(counters.numRedundantStateChanges, 1u);
+}
+
+TEST_F(RecordingContextTest, PausedRecordingStillCounts)
+{
+    auto context = RecordingContext::create();
+    auto logSize = context->log().size();
+
+    context->recording(false);
+    context->drawTriangles(0, 2);
+
+    ASSERT_EQ(context->log().size(), logSize);
+    ASSERT_EQ(context->counters().numTriangles, 2u);
+}
+
+TEST_F(RecordingContextTest, ReplayReproducesCommands)
+{
+    auto recorder = RecordingContext::create();
+    auto data = std::vector<float>(9, 1.f);
+    auto vertexBuffer = recorder->createVertexBuffer(9);
+
+    recorder->uploadVertexBufferData(vertexBuffer, 0, 9, data.data());
+
+    auto program = createProgram(recorder);
+
+    recordFrame(recorder, program, vertexBuffer);
+    recordFrame(recorder, program, vertexBuffer);
+
+    auto target = RecordingContext::create();
+
+    RecordingContext::replay(recorder->log(), target);
+
+    ASSERT_EQ(target->counters().numDrawCalls, recorder->counters().numDrawCalls);
+    ASSERT_EQ(target->counters().numTriangles, recorder->counters().numTriangles);
+    ASSERT_EQ(target->counters().numUploadedBytes, recorder->counters().numUploadedBytes);
+    ASSERT_EQ(target->counters().numUniformUpdates, recorder->counters().numUniformUpdates);
+    ASSERT_EQ(target->counters().numVertexBufferBinds, recorder->counters().numVertexBufferBinds);
+}
+
+TEST_F(RecordingContextTest, ReplayRejectsInvalidLog)
+{
+    auto log = std::vector<unsigned char>(8, 0);
+
+    ASSERT_THROW(RecordingContext::replay(log, RecordingContext::create()), std::invalid_argument);
+}
+
+TEST_F(RecordingContextTest, ForwardsToContext)
+{
+    auto target = RecordingContext::create();
+    auto context = RecordingContext::create(target);
+    auto vertexBuffer = context->createVertexBuffer(9);
+
+    context->drawTriangles(0, 3);
+
+    ASSERT_EQ(target->counters().numTriangles, 3u);
+    ASSERT_EQ(target->log().size() > 8, true);
+    ASSERT_NE(vertexBuffer, 0u);
+}
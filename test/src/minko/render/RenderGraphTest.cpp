@@ -0,0 +1,210 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderGraphTest.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(RenderGraphTest, Create)
+{
+    try
+    {
+        auto graph = RenderGraph::create();
+    }
+    catch (std::exception& e)
+    {
+        ASSERT_TRUE(false);
+    }
+}
+
+TEST_F(RenderGraphTest, ChainKeepsDeclarationOrder)
+{
+    auto graph = RenderGraph::create()
+        ->target("a", 256, 256)
+        ->target("b", 256, 256)
+        ->pass("first", { }, "a")
+        ->pass("second", { "a" }, "b")
+        ->pass("third", { "b" });
+
+    graph->compile();
+
+    ASSERT_EQ(graph->order(), std::vector<uint>({ 0, 1, 2 }));
+}
+
+TEST_F(RenderGraphTest, UnreadPassIsCulled)
+{
+    auto graph = RenderGraph::create()
+        ->target("a", 256, 256)
+        ->target("unused", 256, 256)
+        ->pass("first", { }, "a")
+        ->pass("dead", { "a" }, "unused")
+        ->pass("composite", { "a" });
+
+    graph->compile();
+
+    ASSERT_FALSE(graph->culled(0));
+    ASSERT_TRUE(graph->culled(1));
+    ASSERT_FALSE(graph->culled(2));
+    ASSERT_EQ(graph->order(), std::vector<uint>({ 0, 2 }));
+    ASSERT_EQ(graph->physicalTarget("unused"), -1);
+}
+
+TEST_F(RenderGraphTest, PassOnlyFeedingCulledPassIsCulled)
+{
+    auto graph = RenderGraph::create()
+        ->target("a", 256, 256)
+        ->target("b", 256, 256)
+        ->pass("first", { }, "a")
+        ->pass("second", { "a" }, "b")
+        ->pass("composite", { });
+
+    graph->compile();
+
+    ASSERT_TRUE(graph->culled(0));
+    ASSERT_TRUE(graph->culled(1));
+    ASSERT_EQ(graph->order(), std::vector<uint>({ 2 }));
+    ASSERT_EQ(graph->numPhysicalTargets(), 0u);
+}
+
+TEST_F(RenderGraphTest, DisjointLifetimesAreAliased)
+{
+    auto graph = RenderGraph::create()
+        ->target("threshold", 256, 256)
+        ->target("blurH", 256, 256)
+        ->target("blurV", 256, 256)
+        ->pass("threshold", { }, "threshold")
+        ->pass("blur horizontal", { "threshold" }, "blurH")
+        ->pass("blur vertical", { "blurH" }, "blurV")
+        ->pass("composite", { "blurV" });
+
+    graph->compile();
+
+    ASSERT_EQ(graph->numPhysicalTargets(), 2u);
+    ASSERT_EQ(graph->physicalTarget("threshold"), graph->physicalTarget("blurV"));
+    ASSERT_NE(graph->physicalTarget("threshold"), graph->physicalTarget("blurH"));
+    ASSERT_EQ(graph->transientMemory(), 3u * 256u * 256u * 4u);
+    ASSERT_EQ(graph->allocatedMemory(), 2u * 256u * 256u * 4u);
+}
+
+TEST_F(RenderGraphTest, PingPongTargetsAreNotAliased)
+{
+    auto graph = RenderGraph::create()
+        ->target("a", 256, 256)
+        ->target("b", 256, 256)
+        ->pass("first", { }, "a")
+        ->pass("second", { "a" }, "b")
+        ->pass("composite", { "a", "b" });
+
+    graph->compile();
+
+    ASSERT_EQ(graph->numPhysicalTargets(), 2u);
+    ASSERT_NE(graph->physicalTarget("a"), graph->physicalTarget("b"));
+}
+
+TEST_F(RenderGraphTest, DifferentSizesAreNotAliased)
+{
+    auto graph = RenderGraph::create()
+        ->target("a", 256, 256)
+        ->target("b", 128, 128)
+        ->target("c", 128, 128)
+        ->pass("first", { }, "a")
+        ->pass("second", { "a" }, "b")
+        ->pass("third", { "b" }, "c")
+        ->pass("composite", { "c" });
+
+    graph->compile();
+
+    ASSERT_EQ(graph->numPhysicalTargets(), 3u);
+    ASSERT_NE(graph->physicalTarget("a"), graph->physicalTarget("c"));
+}
+
+TEST_F(RenderGraphTest, OutputIsNeverCulledNorAliased)
+{
+    auto graph = RenderGraph::create()
+        ->target("a", 256, 256)
+        ->target("b", 256, 256)
+        ->target("result", 256, 256)
+        ->output("result")
+        ->pass("first", { }, "result")
+        ->pass("second", { }, "a")
+        ->pass("third", { "a" }, "b")
+        ->pass("composite", { "b" });
+
+    graph->compile();
+
+    ASSERT_FALSE(graph->culled(0));
+    ASSERT_EQ(graph->numPhysicalTargets(), 3u);
+    ASSERT_NE(graph->physicalTarget("result"), graph->physicalTarget("b"));
+}
+
+TEST_F(RenderGraphTest, TargetReadBeforeWriteIsNotAliased)
+{
+    auto graph = RenderGraph::create()
+        ->target("history", 256, 256)
+        ->target("a", 256, 256)
+        ->target("b", 256, 256)
+        ->pass("first", { "history" }, "a")
+        ->pass("second", { "a" }, "history")
+        ->pass("third", { }, "b")
+        ->pass("composite", { "a", "b" });
+
+    graph->compile();
+
+    ASSERT_FALSE(graph->culled(1));
+    ASSERT_EQ(graph->numPhysicalTargets(), 3u);
+    ASSERT_NE(graph->physicalTarget("history"), graph->physicalTarget("b"));
+}
+
+TEST_F(RenderGraphTest, ReadResolvesToLastWriter)
+{
+    // downsample -> features -> blur -> features -> composite
+    auto graph = RenderGraph::create()
+        ->target("downsample", 256, 256)
+        ->target("features", 256, 256)
+        ->target("blur", 256, 256)
+        ->pass("downsample", { }, "downsample")
+        ->pass("features", { "downsample" }, "features")
+        ->pass("blur horizontal", { "features" }, "blur")
+        ->pass("blur vertical", { "blur" }, "features")
+        ->pass("composite", { "features" });
+
+    graph->compile();
+
+    ASSERT_EQ(graph->order(), std::vector<uint>({ 0, 1, 2, 3, 4 }));
+    ASSERT_EQ(graph->numPhysicalTargets(), 2u);
+    ASSERT_EQ(graph->physicalTarget("downsample"), graph->physicalTarget("blur"));
+}
+
+TEST_F(RenderGraphTest, ConsumerRunsAfterProducer)
+{
+    auto graph = RenderGraph::create()
+        ->target("a", 256, 256)
+        ->pass("producer", { }, "a")
+        ->pass("unrelated", { })
+        ->pass("consumer", { "a" });
+
+    graph->compile();
+
+    ASSERT_EQ(graph->order().size(), 3u);
+    ASSERT_LT(
+        std::find(graph->order().begin(), graph->order().end(), 0) - graph->order().begin(),
+        std::find(graph->order().begin(), graph->order().end(), 2) - graph->order().begin()
+    );
+}
@@ -0,0 +1,210 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureUploadQueueTest.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+    Texture::Ptr
+    createTexture()
+    {
+        return Texture::create(nullptr, 16, 16, false, false, false, TextureFormat::RGBA);
+    }
+}
+
+TEST_F(TextureUploadQueueTest, Create)
+{
+    try
+    {
+        auto queue = TextureUploadQueue::create();
+    }
+    catch (std::exception& e)
+    {
+        ASSERT_TRUE(false);
+    }
+}
+
+TEST_F(TextureUploadQueueTest, UploadsFollowPriority)
+{
+    auto queue = TextureUploadQueue::create(0);
+    auto order = std::vector<int>();
+    auto textures = std::vector<Texture::Ptr> { createTexture(), createTexture(), createTexture() };
+
+    for (auto i = 0; i < 3; ++i)
+        queue->upload(textures[i], 10, [&order, i]() { order.push_back(i); });
+
+    queue->priority(textures[1], 2.f);
+    queue->priority(textures[2], 1.f);
+    queue->update();
+
+    ASSERT_EQ(order, std::vector<int>({ 1, 2, 0 }));
+}
+
+TEST_F(TextureUploadQueueTest, EqualPrioritiesKeepQueueOrder)
+{
+    auto queue = TextureUploadQueue::create(0);
+    auto order = std::vector<int>();
+
+    for (auto i = 0; i < 4; ++i)
+        queue->upload(createTexture(), 10, [&order, i]() { order.push_back(i); });
+
+    queue->update();
+
+    ASSERT_EQ(order, std::vector<int>({ 0, 1, 2, 3 }));
+}
+
+TEST_F(TextureUploadQueueTest, PriorityAppliesToFutureUploads)
+{
+    auto queue = TextureUploadQueue::create(0);
+    auto order = std::vector<int>();
+    auto texture = createTexture();
+
+    queue->priority(texture, 1.f);
+    queue->upload(createTexture(), 10, [&order]() { order.push_back(0); });
+    queue->upload(texture, 10, [&order]() { order.push_back(1); });
+    queue->update();
+
+    ASSERT_EQ(order, std::vector<int>({ 1, 0 }));
+}
+
+TEST_F(TextureUploadQueueTest, ByteBudgetSpreadsUploadsOverFrames)
+{
+    auto queue = TextureUploadQueue::create(0)->maxUploadedBytesPerFrame(100);
+    auto numUploads = 0;
+
+    for (auto i = 0; i < 5; ++i)
+        queue->upload(createTexture(), 40, [&numUploads]() { ++numUploads; });
+
+    queue->update();
+    ASSERT_EQ(numUploads, 2);
+    ASSERT_EQ(queue->numUploadedBytesLastFrame(), 80u);
+    ASSERT_EQ(queue->numPendingUploads(), 3u);
+
+    queue->update();
+    ASSERT_EQ(numUploads, 4);
+
+    queue->update();
+    ASSERT_EQ(numUploads, 5);
+    ASSERT_EQ(queue->numUploadedTextures(), 5u);
+    ASSERT_EQ(queue->numUploadedBytes(), 200u);
+}
+
+TEST_F(TextureUploadQueueTest, OversizedUploadIsNotStarved)
+{
+    auto queue = TextureUploadQueue::create(0)->maxUploadedBytesPerFrame(100);
+    auto numUploads = 0;
+
+    queue->upload(createTexture(), 1000, [&numUploads]() { ++numUploads; });
+    queue->upload(createTexture(), 10, [&numUploads]() { ++numUploads; });
+    queue->update();
+
+    ASSERT_EQ(numUploads, 1);
+
+    queue->update();
+
+    ASSERT_EQ(numUploads, 2);
+}
+
+TEST_F(TextureUploadQueueTest, CancelDropsPendingUploads)
+{
+    auto queue = TextureUploadQueue::create(0);
+    auto texture = createTexture();
+    auto numUploads = 0;
+
+    queue->upload(texture, 10, [&numUploads]() { ++numUploads; });
+    queue->upload(texture, 10, [&numUploads]() { ++numUploads; });
+    queue->cancel(texture);
+    queue->update();
+
+    ASSERT_EQ(numUploads, 0);
+    ASSERT_EQ(queue->numPendingUploads(), 0u);
+}
+
+TEST_F(TextureUploadQueueTest, DecodedCallbacksRunOnCallingThread)
+{
+    auto queue = TextureUploadQueue::create(2);
+    auto mainThreadId = std::this_thread::get_id();
+    auto numDecoded = 0;
+    auto decodedOnMainThread = true;
+
+    for (auto i = 0; i < 8; ++i)
+        queue->decode(
+            []() -> uint { return 64u; },
+            [&]()
+            {
+                decodedOnMainThread = decodedOnMainThread && std::this_thread::get_id() == mainThreadId;
+                ++numDecoded;
+            }
+        );
+
+    queue->flush();
+
+    ASSERT_EQ(numDecoded, 8);
+    ASSERT_TRUE(decodedOnMainThread);
+    ASSERT_EQ(queue->numPendingDecodes(), 0u);
+    ASSERT_EQ(queue->numDecodedTextures(), 8u);
+    ASSERT_EQ(queue->numDecodedBytes(), 512u);
+}
+
+TEST_F(TextureUploadQueueTest, FlushUploadsWhatDecodingQueued)
+{
+    auto queue = TextureUploadQueue::create(1)->maxUploadedBytesPerFrame(1);
+    auto texture = createTexture();
+    auto uploaded = false;
+
+    queue->decode(
+        []() -> uint { return 16u * 16u * 4u; },
+        [&]()
+        {
+            queue->upload(texture, TextureUploadQueue::textureMemory(texture), [&]() { uploaded = true; });
+        }
+    );
+
+    queue->flush();
+
+    ASSERT_TRUE(uploaded);
+    ASSERT_EQ(queue->numUploadedBytes(), 16u * 16u * 4u);
+}
+
+TEST_F(TextureUploadQueueTest, DestroyedQueueFailsPendingDecodes)
+{
+    auto numDecoded = 0;
+    auto numFailed = 0;
+
+    for (auto numThreads : { 0u, 2u })
+    {
+        auto queue = TextureUploadQueue::create(numThreads);
+
+        for (auto i = 0; i < 8; ++i)
+            queue->decode(
+                []() -> uint { return 64u; },
+                [&]() { ++numDecoded; },
+                [&]() { ++numFailed; }
+            );
+
+        // the decoded callbacks only run during update() or flush()
+        queue = nullptr;
+    }
+
+    ASSERT_EQ(numDecoded, 0);
+    ASSERT_EQ(numFailed, 16);
+}
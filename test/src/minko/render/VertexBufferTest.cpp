@@ -0,0 +1,137 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VertexBufferTest.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(VertexBufferTest, PackedVertexSize)
+{
+    auto vertexBuffer = VertexBuffer::create(nullptr);
+
+    vertexBuffer->addAttribute("position", 3, 0);
+    vertexBuffer->addAttribute("normal", 3, 3, VertexAttribute::Format::SHORT_NORMALIZED);
+    vertexBuffer->addAttribute("uv", 2, 6, VertexAttribute::Format::HALF_FLOAT);
+    vertexBuffer->addAttribute("color", 4, 8, VertexAttribute::Format::UNSIGNED_BYTE_NORMALIZED);
+
+    ASSERT_TRUE(vertexBuffer->isPacked());
+    ASSERT_EQ(vertexBuffer->vertexSize(), 12u);
+    // 3 floats + 3 shorts (padded to 2 words) + 2 halves + 4 bytes
+    ASSERT_EQ(vertexBuffer->packedVertexSize(), 7u);
+}
+
+TEST_F(VertexBufferTest, FloatLayoutIsNotPacked)
+{
+    auto vertexBuffer = VertexBuffer::create(nullptr);
+
+    vertexBuffer->addAttribute("position", 3, 0);
+    vertexBuffer->addAttribute("uv", 2, 3);
+
+    ASSERT_FALSE(vertexBuffer->isPacked());
+    ASSERT_EQ(vertexBuffer->packedVertexSize(), vertexBuffer->vertexSize());
+}
+
+TEST_F(VertexBufferTest, PackUnpackRoundTrip)
+{
+    auto vertexBuffer = VertexBuffer::create(nullptr);
+
+    vertexBuffer->addAttribute("position", 3, 0);
+    vertexBuffer->addAttribute("normal", 3, 3, VertexAttribute::Format::SHORT_NORMALIZED);
+    vertexBuffer->addAttribute("uv", 2, 6, VertexAttribute::Format::UNSIGNED_SHORT_NORMALIZED);
+    vertexBuffer->addAttribute("boneIds", 2, 8, VertexAttribute::Format::UNSIGNED_BYTE);
+
+    std::vector<float> vertices = {
+        1.5f, -2.f, 3.25f,      0.f, 0.6f, -0.8f,   0.25f, 0.75f,   3.f, 12.f,
+        -4.f, 5.f, 0.125f,      1.f, 0.f, 0.f,      1.f, 0.f,       0.f, 255.f
+    };
+    std::vector<unsigned char> packed;
+
+    vertexBuffer->pack(vertices.data(), 2, packed);
+
+    ASSERT_EQ(packed.size(), 2u * vertexBuffer->packedVertexSize() * 4u);
+
+    std::vector<float> unpacked(vertices.size());
+
+    vertexBuffer->unpack(packed.data(), 2, unpacked.data());
+
+    for (auto i = 0u; i < vertices.size(); ++i)
+        ASSERT_NEAR(unpacked[i], vertices[i], 1e-4f);
+}
+
+TEST_F(VertexBufferTest, HalfFloatRoundTrip)
+{
+    auto vertexBuffer = VertexBuffer::create(nullptr);
+
+    vertexBuffer->addAttribute("uv", 2, 0, VertexAttribute::Format::HALF_FLOAT);
+
+    std::vector<float> vertices = { 0.5f, -3.75f, 1024.f, 0.f };
+    std::vector<unsigned char> packed;
+
+    vertexBuffer->pack(vertices.data(), 2, packed);
+
+    std::vector<float> unpacked(vertices.size());
+
+    vertexBuffer->unpack(packed.data(), 2, unpacked.data());
+
+    ASSERT_EQ(unpacked, vertices);
+}
+
+TEST_F(VertexBufferTest, HalfFloatRoundsToNearestEven)
+{
+    auto vertexBuffer = VertexBuffer::create(nullptr);
+
+    vertexBuffer->addAttribute("uv", 2, 0, VertexAttribute::Format::HALF_FLOAT);
+
+    // 2049 and 2051 are halfway between two halves, 65520 rounds up to infinity
+    std::vector<float> vertices = { 2049.f, 2051.f, 1.f + 1.f / 4096.f, 65520.f };
+    std::vector<unsigned char> packed;
+
+    vertexBuffer->pack(vertices.data(), 2, packed);
+
+    std::vector<float> unpacked(vertices.size());
+
+    vertexBuffer->unpack(packed.data(), 2, unpacked.data());
+
+    ASSERT_EQ(unpacked[0], 2048.f);
+    ASSERT_EQ(unpacked[1], 2052.f);
+    ASSERT_EQ(unpacked[2], 1.f);
+    ASSERT_EQ(unpacked[3], std::numeric_limits<float>::infinity());
+}
+
+TEST_F(VertexBufferTest, HalfFloatKeepsSubnormals)
+{
+    auto vertexBuffer = VertexBuffer::create(nullptr);
+
+    vertexBuffer->addAttribute("uv", 2, 0, VertexAttribute::Format::HALF_FLOAT);
+
+    // smallest subnormal, largest subnormal, below half of the smallest subnormal
+    std::vector<float> vertices = { std::ldexp(1.f, -24), -std::ldexp(1023.f, -24), std::ldexp(1.f, -26), 0.f };
+    std::vector<unsigned char> packed;
+
+    vertexBuffer->pack(vertices.data(), 2, packed);
+
+    std::vector<float> unpacked(vertices.size());
+
+    vertexBuffer->unpack(packed.data(), 2, unpacked.data());
+
+    ASSERT_EQ(unpacked[0], vertices[0]);
+    ASSERT_EQ(unpacked[1], vertices[1]);
+    ASSERT_EQ(unpacked[2], 0.f);
+}
@@ -24,6 +24,23 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace minko::scene;
 
+namespace
+{
+    // a distinct type per N, so that each test resolves types no other test queried before
+    template <int N>
+    class QueriedComponent :
+        public component::AbstractComponent
+    {
+    public:
+        static
+        std::shared_ptr<QueriedComponent>
+        create()
+        {
+            return std::shared_ptr<QueriedComponent>(new QueriedComponent());
+        }
+    };
+}
+
 TEST_F(NodeTest, Create)
 {
     try
@@ -175,3 +192,116 @@ TEST_F(NodeTest, LayoutChanged)
 
     ASSERT_TRUE(changed);
 }
+
+TEST_F(NodeTest, ComponentByBaseType)
+{
+    auto root = Node::create();
+    auto node = Node::create();
+    auto transform = component::Transform::create();
+    auto animation = component::MasterAnimation::create();
+
+    // the RootTransform is added to the root, not to node
+    root->addChild(node);
+    node->addComponent(transform);
+    node->addComponent(animation);
+
+    ASSERT_TRUE(node->hasComponent<component::Transform>());
+    ASSERT_TRUE(node->hasComponent<component::AbstractAnimation>());
+    ASSERT_FALSE(node->hasComponent<component::Surface>());
+    ASSERT_EQ(node->component<component::Transform>(), transform);
+    // AbstractAnimation inherits AbstractComponent virtually
+    ASSERT_EQ(node->component<component::AbstractAnimation>(), std::static_pointer_cast<component::AbstractAnimation>(animation));
+    ASSERT_EQ(node->component<component::AbstractComponent>(0), transform);
+    ASSERT_EQ(node->component<component::AbstractComponent>(1), animation);
+    ASSERT_EQ(node->components<component::AbstractComponent>().size(), 2);
+
+    node->removeComponent(transform);
+
+    ASSERT_FALSE(node->hasComponent<component::Transform>());
+    ASSERT_EQ(node->component<component::Transform>(), nullptr);
+    ASSERT_EQ(node->component<component::AbstractComponent>(), animation);
+}
+
+TEST_F(NodeTest, DescendantComponents)
+{
+    auto root = Node::create("root");
+    auto a = Node::create("a");
+    auto b = Node::create("b");
+    auto ta = component::Transform::create();
+    auto tb = component::Transform::create();
+    auto tc = component::Transform::create();
+
+    a->addComponent(ta);
+    b->addComponent(tb);
+    a->addChild(b);
+
+    ASSERT_EQ(a->descendantComponents<component::Transform>().size(), 2);
+    ASSERT_EQ(b->descendantComponents<component::Transform>().size(), 1);
+
+    root->addChild(a);
+    root->addComponent(tc);
+
+    auto transforms = root->descendantComponents<component::Transform>();
+
+    ASSERT_EQ(transforms.size(), 3);
+    ASSERT_NE(std::find(transforms.begin(), transforms.end(), ta), transforms.end());
+    ASSERT_NE(std::find(transforms.begin(), transforms.end(), tb), transforms.end());
+    ASSERT_NE(std::find(transforms.begin(), transforms.end(), tc), transforms.end());
+    ASSERT_EQ(root->descendantComponents<component::AbstractAnimation>().size(), 0);
+    ASSERT_EQ(root->descendantComponents<component::Surface>().size(), 0);
+
+    a->removeChild(b);
+
+    ASSERT_EQ(root->descendantComponents<component::Transform>().size(), 2);
+    ASSERT_EQ(b->descendantComponents<component::Transform>().size(), 1);
+
+    root->removeChild(a);
+    a->removeComponent(ta);
+
+    ASSERT_EQ(root->descendantComponents<component::Transform>().size(), 1);
+    ASSERT_EQ(root->descendantComponents<component::Transform>().front(), tc);
+    ASSERT_EQ(a->descendantComponents<component::Transform>().size(), 0);
+}
+
+TEST_F(NodeTest, ComponentQueriesFromSeveralThreads)
+{
+    static const auto numThreads = 8;
+
+    auto nodes = std::vector<Node::Ptr>();
+
+    for (auto i = 0; i < 64; ++i)
+    {
+        auto node = Node::create();
+
+        if (i % 2 == 0)
+            node->addComponent(QueriedComponent<0>::create());
+        else
+            node->addComponent(QueriedComponent<1>::create());
+        node->addComponent(QueriedComponent<2>::create());
+
+        nodes.push_back(node);
+    }
+
+    // the type caches of QueriedComponent<0> and <1> are resolved concurrently by the first queries
+    std::atomic<int> numMismatches(0);
+    auto threads = std::vector<std::thread>();
+
+    for (auto t = 0; t < numThreads; ++t)
+        threads.push_back(std::thread([&]()
+        {
+            for (auto i = 0u; i < nodes.size(); ++i)
+            {
+                const auto even = i % 2 == 0;
+
+                if (nodes[i]->hasComponent<QueriedComponent<0>>() != even
+                    || (nodes[i]->component<QueriedComponent<1>>() != nullptr) == even
+                    || nodes[i]->component<QueriedComponent<2>>() == nullptr)
+                    ++numMismatches;
+            }
+        }));
+
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(numMismatches, 0);
+}